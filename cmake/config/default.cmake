@@ -24,6 +24,7 @@ include(${bsl_SOURCE_DIR}/cmake/function/bf_add_config.cmake)
 option(MICROV_BUILD_HYPERCALL "Turns on/off building the hypercall library" ON)
 option(MICROV_BUILD_SHIM "Turns on/off building the shim" ON)
 option(MICROV_BUILD_VMM "Turns on/off building the vmm" ON)
+option(MICROV_IGNORE_UNKNOWN_MSRS "Turns on/off ignoring guest accesses to unknown MSRs instead of injecting a #GP" OFF)
 
 bf_add_config(
     CONFIG_NAME MICROV_MAX_PP_MAPS
@@ -72,3 +73,43 @@ bf_add_config(
     DESCRIPTION "Defines the size of a VS interrupt queue"
     SKIP_VALIDATION
 )
+
+bf_add_config(
+    CONFIG_NAME MICROV_DIRTY_RING_SIZE
+    CONFIG_TYPE STRING
+    DEFAULT_VAL "512"
+    DESCRIPTION "Defines the size of a VS dirty ring"
+    SKIP_VALIDATION
+)
+
+bf_add_config(
+    CONFIG_NAME MICROV_PLE_GAP
+    CONFIG_TYPE STRING
+    DEFAULT_VAL "128"
+    DESCRIPTION "Defines the max TSC ticks between two PAUSEs of the same loop (Intel PLE_Gap)"
+    SKIP_VALIDATION
+)
+
+bf_add_config(
+    CONFIG_NAME MICROV_PLE_WINDOW
+    CONFIG_TYPE STRING
+    DEFAULT_VAL "4096"
+    DESCRIPTION "Defines the TSC ticks a VS can spin in a PAUSE loop before exiting (Intel PLE_Window)"
+    SKIP_VALIDATION
+)
+
+bf_add_config(
+    CONFIG_NAME MICROV_PAUSE_FILTER_COUNT
+    CONFIG_TYPE STRING
+    DEFAULT_VAL "3000"
+    DESCRIPTION "Defines the number of PAUSEs a VS can execute in a loop before exiting (AMD)"
+    SKIP_VALIDATION
+)
+
+bf_add_config(
+    CONFIG_NAME MICROV_PAUSE_FILTER_THRESHOLD
+    CONFIG_TYPE STRING
+    DEFAULT_VAL "128"
+    DESCRIPTION "Defines the max cycles between two PAUSEs of the same loop (AMD)"
+    SKIP_VALIDATION
+)
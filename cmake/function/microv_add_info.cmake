@@ -68,6 +68,18 @@ macro(microv_add_info)
         )
     endif()
 
+    if(MICROV_IGNORE_UNKNOWN_MSRS)
+        add_custom_command(TARGET info
+            COMMAND ${CMAKE_COMMAND} -E echo "${BF_COLOR_YLW}   MICROV_IGNORE_UNKNOWN_MSRS     ${BF_COLOR_GRN}enabled${BF_COLOR_RST}"
+            VERBATIM
+        )
+    else()
+        add_custom_command(TARGET info
+            COMMAND ${CMAKE_COMMAND} -E echo "${BF_COLOR_YLW}   MICROV_IGNORE_UNKNOWN_MSRS     ${BF_COLOR_RED}disabled${BF_COLOR_RST}"
+            VERBATIM
+        )
+    endif()
+
     add_custom_command(TARGET info
         COMMAND ${CMAKE_COMMAND} -E echo "${BF_COLOR_YLW}   MICROV_MAX_PP_MAPS             ${BF_COLOR_CYN}${MICROV_MAX_PP_MAPS}${BF_COLOR_RST}"
         VERBATIM
@@ -98,6 +110,31 @@ macro(microv_add_info)
         VERBATIM
     )
 
+    add_custom_command(TARGET info
+        COMMAND ${CMAKE_COMMAND} -E echo "${BF_COLOR_YLW}   MICROV_DIRTY_RING_SIZE         ${BF_COLOR_CYN}${MICROV_DIRTY_RING_SIZE}${BF_COLOR_RST}"
+        VERBATIM
+    )
+
+    add_custom_command(TARGET info
+        COMMAND ${CMAKE_COMMAND} -E echo "${BF_COLOR_YLW}   MICROV_PLE_GAP                 ${BF_COLOR_CYN}${MICROV_PLE_GAP}${BF_COLOR_RST}"
+        VERBATIM
+    )
+
+    add_custom_command(TARGET info
+        COMMAND ${CMAKE_COMMAND} -E echo "${BF_COLOR_YLW}   MICROV_PLE_WINDOW              ${BF_COLOR_CYN}${MICROV_PLE_WINDOW}${BF_COLOR_RST}"
+        VERBATIM
+    )
+
+    add_custom_command(TARGET info
+        COMMAND ${CMAKE_COMMAND} -E echo "${BF_COLOR_YLW}   MICROV_PAUSE_FILTER_COUNT      ${BF_COLOR_CYN}${MICROV_PAUSE_FILTER_COUNT}${BF_COLOR_RST}"
+        VERBATIM
+    )
+
+    add_custom_command(TARGET info
+        COMMAND ${CMAKE_COMMAND} -E echo "${BF_COLOR_YLW}   MICROV_PAUSE_FILTER_THRESHOLD  ${BF_COLOR_CYN}${MICROV_PAUSE_FILTER_THRESHOLD}${BF_COLOR_RST}"
+        VERBATIM
+    )
+
     add_custom_command(TARGET info
         COMMAND ${CMAKE_COMMAND} -E echo " "
         VERBATIM
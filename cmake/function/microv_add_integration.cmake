@@ -54,6 +54,12 @@ macro(microv_add_vmm_integration NAME HEADERS)
         MICROV_MAX_GPA_SIZE=${MICROV_MAX_GPA_SIZE}_umx
         MICROV_MAX_SLOTS=${MICROV_MAX_SLOTS}_umx
         MICROV_INTERRUPT_QUEUE_SIZE=${MICROV_INTERRUPT_QUEUE_SIZE}_umx
+        MICROV_DIRTY_RING_SIZE=${MICROV_DIRTY_RING_SIZE}_umx
+        MICROV_PLE_GAP=${MICROV_PLE_GAP}_umx
+        MICROV_PLE_WINDOW=${MICROV_PLE_WINDOW}_umx
+        MICROV_PAUSE_FILTER_COUNT=${MICROV_PAUSE_FILTER_COUNT}_umx
+        MICROV_PAUSE_FILTER_THRESHOLD=${MICROV_PAUSE_FILTER_THRESHOLD}_umx
+        MICROV_IGNORE_UNKNOWN_MSRS=$<IF:$<BOOL:${MICROV_IGNORE_UNKNOWN_MSRS}>,true,false>
     )
 
     target_compile_options(integration_${NAME} PRIVATE -Wframe-larger-than=4294967295)
@@ -125,6 +131,12 @@ macro(microv_add_shim_integration NAME HEADERS)
         MICROV_MAX_GPA_SIZE=${MICROV_MAX_GPA_SIZE}_umx
         MICROV_MAX_SLOTS=${MICROV_MAX_SLOTS}_umx
         MICROV_INTERRUPT_QUEUE_SIZE=${MICROV_INTERRUPT_QUEUE_SIZE}_umx
+        MICROV_DIRTY_RING_SIZE=${MICROV_DIRTY_RING_SIZE}_umx
+        MICROV_PLE_GAP=${MICROV_PLE_GAP}_umx
+        MICROV_PLE_WINDOW=${MICROV_PLE_WINDOW}_umx
+        MICROV_PAUSE_FILTER_COUNT=${MICROV_PAUSE_FILTER_COUNT}_umx
+        MICROV_PAUSE_FILTER_THRESHOLD=${MICROV_PAUSE_FILTER_THRESHOLD}_umx
+        MICROV_IGNORE_UNKNOWN_MSRS=$<IF:$<BOOL:${MICROV_IGNORE_UNKNOWN_MSRS}>,true,false>
     )
 
     target_compile_options(integration_${NAME} PRIVATE -Wframe-larger-than=4294967295)
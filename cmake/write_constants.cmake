@@ -37,6 +37,7 @@ if(EXISTS ${CMAKE_BINARY_DIR}/include/constants.h)
     file(APPEND ${HYPERVISOR_CONSTANTS} "#define MICROV_MAX_GPA_SIZE ((uint64_t)(${MICROV_MAX_GPA_SIZE}))\n")
     file(APPEND ${HYPERVISOR_CONSTANTS} "#define MICROV_MAX_SLOTS ((uint64_t)(${MICROV_MAX_SLOTS}))\n")
     file(APPEND ${HYPERVISOR_CONSTANTS} "#define MICROV_INTERRUPT_QUEUE_SIZE ((uint64_t)(${MICROV_INTERRUPT_QUEUE_SIZE}))\n")
+    file(APPEND ${HYPERVISOR_CONSTANTS} "#define MICROV_DIRTY_RING_SIZE ((uint64_t)(${MICROV_DIRTY_RING_SIZE}))\n")
     file(APPEND ${HYPERVISOR_CONSTANTS} "\n")
 
     file(APPEND ${HYPERVISOR_CONSTANTS} "#endif\n")
@@ -132,6 +132,17 @@ NODISCARD static inline int
 /** @brief Indicates the map is mapped as WP */
 #define MV_MAP_FLAG_WRITE_PROTECTED ((uint64_t)0x8000000000000000)
 
+/* -------------------------------------------------------------------------- */
+/* IO Intercept Types                                                         */
+/* -------------------------------------------------------------------------- */
+
+/** @brief Indicates port accesses exit to software using mv_vs_op_run */
+#define MV_IO_INTERCEPT_EXIT ((uint64_t)0x0000000000000000)
+/** @brief Indicates port accesses are ignored by MicroV */
+#define MV_IO_INTERCEPT_IGNORE ((uint64_t)0x0000000000000001)
+/** @brief Indicates port accesses are passed through to hardware */
+#define MV_IO_INTERCEPT_PASSTHROUGH ((uint64_t)0x0000000000000002)
+
 /* -------------------------------------------------------------------------- */
 /* Special IDs                                                                */
 /* -------------------------------------------------------------------------- */
@@ -459,6 +470,28 @@ NODISCARD static inline int
 #define MV_VM_OP_MMIO_MAP_IDX_VAL ((uint64_t)0x0000000000000003)
 /** @brief Defines the index for mv_vm_op_mmio_unmap */
 #define MV_VM_OP_MMIO_UNMAP_IDX_VAL ((uint64_t)0x0000000000000004)
+/** @brief Defines the index for mv_vm_op_dirty_log_enable */
+#define MV_VM_OP_DIRTY_LOG_ENABLE_IDX_VAL ((uint64_t)0x0000000000000005)
+/** @brief Defines the index for mv_vm_op_dirty_log_disable */
+#define MV_VM_OP_DIRTY_LOG_DISABLE_IDX_VAL ((uint64_t)0x0000000000000006)
+/** @brief Defines the index for mv_vm_op_dirty_log_get */
+#define MV_VM_OP_DIRTY_LOG_GET_IDX_VAL ((uint64_t)0x0000000000000007)
+/** @brief Defines the index for mv_vm_op_dirty_log_clear */
+#define MV_VM_OP_DIRTY_LOG_CLEAR_IDX_VAL ((uint64_t)0x0000000000000008)
+/** @brief Defines the index for mv_vm_op_dirty_ring_reset */
+#define MV_VM_OP_DIRTY_RING_RESET_IDX_VAL ((uint64_t)0x0000000000000009)
+/** @brief Defines the index for mv_vm_op_fork_vm */
+#define MV_VM_OP_FORK_VM_IDX_VAL ((uint64_t)0x000000000000000A)
+/** @brief Defines the index for mv_vm_op_msr_intercept */
+#define MV_VM_OP_MSR_INTERCEPT_IDX_VAL ((uint64_t)0x000000000000000B)
+/** @brief Defines the index for mv_vm_op_io_intercept */
+#define MV_VM_OP_IO_INTERCEPT_IDX_VAL ((uint64_t)0x000000000000000C)
+/** @brief Defines the index for mv_vm_op_msr_filter */
+#define MV_VM_OP_MSR_FILTER_IDX_VAL ((uint64_t)0x000000000000000D)
+/** @brief Defines the index for mv_vm_op_clock_get */
+#define MV_VM_OP_CLOCK_GET_IDX_VAL ((uint64_t)0x000000000000000E)
+/** @brief Defines the index for mv_vm_op_clock_set */
+#define MV_VM_OP_CLOCK_SET_IDX_VAL ((uint64_t)0x000000000000000F)
 
 /** @brief Defines the index for mv_vp_op_create_vp */
 #define MV_VP_OP_CREATE_VP_IDX_VAL ((uint64_t)0x0000000000000000)
@@ -491,10 +524,10 @@ NODISCARD static inline int
 #define MV_VS_OP_CPUID_GET_IDX_VAL ((uint64_t)0x0000000000000009)
 /** @brief Defines the index for mv_vs_op_cpuid_set */
 #define MV_VS_OP_CPUID_SET_IDX_VAL ((uint64_t)0x000000000000000A)
-/** @brief Defines the index for mv_vs_op_cpuid_get_all */
-#define MV_VS_OP_CPUID_GET_ALL_IDX_VAL ((uint64_t)0x000000000000000B)
-/** @brief Defines the index for mv_vs_op_cpuid_set_all */
-#define MV_VS_OP_CPUID_SET_ALL_IDX_VAL ((uint64_t)0x000000000000000C)
+/** @brief Defines the index for mv_vs_op_cpuid_get_list */
+#define MV_VS_OP_CPUID_GET_LIST_IDX_VAL ((uint64_t)0x000000000000000B)
+/** @brief Defines the index for mv_vs_op_cpuid_set_list */
+#define MV_VS_OP_CPUID_SET_LIST_IDX_VAL ((uint64_t)0x000000000000000C)
 /** @brief Defines the index for mv_vs_op_reg_get */
 #define MV_VS_OP_REG_GET_IDX_VAL ((uint64_t)0x000000000000000D)
 /** @brief Defines the index for mv_vs_op_reg_set */
@@ -535,6 +568,12 @@ NODISCARD static inline int
 #define MV_VS_OP_INJECT_EXCEPTION_IDX_VAL ((uint64_t)0x0000000000000025)
 /** @brief Defines the index for mv_vs_op_queue_interrupt */
 #define MV_VS_OP_QUEUE_INTERRUPT_IDX_VAL ((uint64_t)0x0000000000000026)
+/** @brief Defines the index for mv_vs_op_dirty_ring_get */
+#define MV_VS_OP_DIRTY_RING_GET_IDX_VAL ((uint64_t)0x0000000000000027)
+/** @brief Defines the index for mv_vs_op_tsc_set_khz */
+#define MV_VS_OP_TSC_SET_KHZ_IDX_VAL ((uint64_t)0x0000000000000028)
+/** @brief Defines the index for mv_vs_op_tsc_set_offset */
+#define MV_VS_OP_TSC_SET_OFFSET_IDX_VAL ((uint64_t)0x0000000000000029)
 
 #ifdef __cplusplus
 }
@@ -123,6 +123,17 @@ namespace hypercall
     /// @brief Indicates the map is mapped as WP
     constexpr auto MV_MAP_FLAG_WRITE_PROTECTED{0x8000000000000000_u64};
 
+    // -------------------------------------------------------------------------
+    // IO Intercept Types
+    // -------------------------------------------------------------------------
+
+    /// @brief Indicates port accesses exit to software using mv_vs_op_run
+    constexpr auto MV_IO_INTERCEPT_EXIT{0x0000000000000000_u64};
+    /// @brief Indicates port accesses are ignored by MicroV
+    constexpr auto MV_IO_INTERCEPT_IGNORE{0x0000000000000001_u64};
+    /// @brief Indicates port accesses are passed through to hardware
+    constexpr auto MV_IO_INTERCEPT_PASSTHROUGH{0x0000000000000002_u64};
+
     // -------------------------------------------------------------------------
     // Special IDs
     // -------------------------------------------------------------------------
@@ -446,6 +457,28 @@ namespace hypercall
     constexpr auto MV_VM_OP_MMIO_MAP_IDX_VAL{0x0000000000000003_u64};
     /// @brief Defines the index for mv_vm_op_mmio_unmap
     constexpr auto MV_VM_OP_MMIO_UNMAP_IDX_VAL{0x0000000000000004_u64};
+    /// @brief Defines the index for mv_vm_op_dirty_log_enable
+    constexpr auto MV_VM_OP_DIRTY_LOG_ENABLE_IDX_VAL{0x0000000000000005_u64};
+    /// @brief Defines the index for mv_vm_op_dirty_log_disable
+    constexpr auto MV_VM_OP_DIRTY_LOG_DISABLE_IDX_VAL{0x0000000000000006_u64};
+    /// @brief Defines the index for mv_vm_op_dirty_log_get
+    constexpr auto MV_VM_OP_DIRTY_LOG_GET_IDX_VAL{0x0000000000000007_u64};
+    /// @brief Defines the index for mv_vm_op_dirty_log_clear
+    constexpr auto MV_VM_OP_DIRTY_LOG_CLEAR_IDX_VAL{0x0000000000000008_u64};
+    /// @brief Defines the index for mv_vm_op_dirty_ring_reset
+    constexpr auto MV_VM_OP_DIRTY_RING_RESET_IDX_VAL{0x0000000000000009_u64};
+    /// @brief Defines the index for mv_vm_op_fork_vm
+    constexpr auto MV_VM_OP_FORK_VM_IDX_VAL{0x000000000000000A_u64};
+    /// @brief Defines the index for mv_vm_op_msr_intercept
+    constexpr auto MV_VM_OP_MSR_INTERCEPT_IDX_VAL{0x000000000000000B_u64};
+    /// @brief Defines the index for mv_vm_op_io_intercept
+    constexpr auto MV_VM_OP_IO_INTERCEPT_IDX_VAL{0x000000000000000C_u64};
+    /// @brief Defines the index for mv_vm_op_msr_filter
+    constexpr auto MV_VM_OP_MSR_FILTER_IDX_VAL{0x000000000000000D_u64};
+    /// @brief Defines the index for mv_vm_op_clock_get
+    constexpr auto MV_VM_OP_CLOCK_GET_IDX_VAL{0x000000000000000E_u64};
+    /// @brief Defines the index for mv_vm_op_clock_set
+    constexpr auto MV_VM_OP_CLOCK_SET_IDX_VAL{0x000000000000000F_u64};
 
     /// @brief Defines the index for mv_vp_op_create_vp
     constexpr auto MV_VP_OP_CREATE_VP_IDX_VAL{0x0000000000000000_u64};
@@ -478,10 +511,10 @@ namespace hypercall
     constexpr auto MV_VS_OP_CPUID_GET_IDX_VAL{0x0000000000000009_u64};
     /// @brief Defines the index for mv_vs_op_cpuid_set
     constexpr auto MV_VS_OP_CPUID_SET_IDX_VAL{0x000000000000000A_u64};
-    /// @brief Defines the index for mv_vs_op_cpuid_get_all
-    constexpr auto MV_VS_OP_CPUID_GET_ALL_IDX_VAL{0x000000000000000B_u64};
-    /// @brief Defines the index for mv_vs_op_cpuid_set_all
-    constexpr auto MV_VS_OP_CPUID_SET_ALL_IDX_VAL{0x000000000000000C_u64};
+    /// @brief Defines the index for mv_vs_op_cpuid_get_list
+    constexpr auto MV_VS_OP_CPUID_GET_LIST_IDX_VAL{0x000000000000000B_u64};
+    /// @brief Defines the index for mv_vs_op_cpuid_set_list
+    constexpr auto MV_VS_OP_CPUID_SET_LIST_IDX_VAL{0x000000000000000C_u64};
     /// @brief Defines the index for mv_vs_op_reg_get
     constexpr auto MV_VS_OP_REG_GET_IDX_VAL{0x000000000000000D_u64};
     /// @brief Defines the index for mv_vs_op_reg_set
@@ -522,6 +555,12 @@ namespace hypercall
     constexpr auto MV_VS_OP_INJECT_EXCEPTION_IDX_VAL{0x0000000000000025_u64};
     /// @brief Defines the index for mv_vs_op_queue_interrupt
     constexpr auto MV_VS_OP_QUEUE_INTERRUPT_IDX_VAL{0x0000000000000026_u64};
+    /// @brief Defines the index for mv_vs_op_dirty_ring_get
+    constexpr auto MV_VS_OP_DIRTY_RING_GET_IDX_VAL{0x0000000000000027_u64};
+    /// @brief Defines the index for mv_vs_op_tsc_set_khz
+    constexpr auto MV_VS_OP_TSC_SET_KHZ_IDX_VAL{0x0000000000000028_u64};
+    /// @brief Defines the index for mv_vs_op_tsc_set_offset
+    constexpr auto MV_VS_OP_TSC_SET_OFFSET_IDX_VAL{0x0000000000000029_u64};
 }
 
 #endif
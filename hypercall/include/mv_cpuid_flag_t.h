@@ -27,6 +27,8 @@
 #ifndef MV_CPUID_FLAG_T_H
 #define MV_CPUID_FLAG_T_H
 
+#include <stdint.h>
+
 #ifdef __cplusplus
 extern "C"
 {
@@ -37,27 +39,25 @@ extern "C"
      * <!-- description -->
      *   @brief Defines CPUID flags
      */
-    enum mv_cpuid_flag : int32_t
+    enum mv_cpuid_flag_t : int32_t
 #else
 /**
      * <!-- description -->
      *   @brief Defines CPUID flags
      */
-enum mv_cpuid_flag
+enum mv_cpuid_flag_t
 #endif
     {
         /** @brief reserved */
-        mv_cpuid_flag_reserved = 0,
+        mv_cpuid_flag_t_reserved = 0,
+        /** @brief the idx field selects a subleaf of the CPUID leaf */
+        mv_cpuid_flag_t_significant_index = 1,
     };
 
-/** @brief integer version of mv_bit_size_t_8 */
-#define BIT_SIZE_8 ((int32_t)mv_bit_size_t_8)
-/** @brief integer version of mv_bit_size_t_16 */
-#define BIT_SIZE_16 ((int32_t)mv_bit_size_t_16)
-/** @brief integer version of mv_bit_size_t_32 */
-#define BIT_SIZE_32 ((int32_t)mv_bit_size_t_32)
-/** @brief integer version of mv_bit_size_t_64 */
-#define BIT_SIZE_64 ((int32_t)mv_bit_size_t_64)
+/** @brief integer version of mv_cpuid_flag_t_reserved */
+#define CPUID_FLAG_RESERVED ((int32_t)mv_cpuid_flag_t_reserved)
+/** @brief integer version of mv_cpuid_flag_t_significant_index */
+#define CPUID_FLAG_SIGNIFICANT_INDEX ((int32_t)mv_cpuid_flag_t_significant_index)
 
 #ifdef __cplusplus
 }
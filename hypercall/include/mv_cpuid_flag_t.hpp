@@ -37,6 +37,8 @@ namespace hypercall
     {
         /// @brief reserved
         mv_cpuid_flag_t_reserved = 0,
+        /// @brief the idx field selects a subleaf of the CPUID leaf
+        mv_cpuid_flag_t_significant_index = 1,
     };
 
     /// <!-- description -->
@@ -54,6 +56,9 @@ namespace hypercall
 
     /// @brief integer version of mv_cpuid_flag_t_reserved
     constexpr auto CPUID_FLAG_RESERVED{to_i32(mv_cpuid_flag_t::mv_cpuid_flag_t_reserved)};
+    /// @brief integer version of mv_cpuid_flag_t_significant_index
+    constexpr auto CPUID_FLAG_SIGNIFICANT_INDEX{
+        to_i32(mv_cpuid_flag_t::mv_cpuid_flag_t_significant_index)};
 }
 
 #endif
@@ -0,0 +1,65 @@
+/**
+ * @copyright
+ * Copyright (C) 2020 Assured Information Security, Inc.
+ *
+ * @copyright
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * @copyright
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * @copyright
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef MV_DIRTY_BITMAP_T_H
+#define MV_DIRTY_BITMAP_T_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#pragma pack(push, 1)
+
+/** @brief defines the max number of entires in the dirty bitmap */
+#define MV_DIRTY_BITMAP_MAX_ENTRIES ((uint64_t)512)
+/** @brief defines the max number of pages described by the dirty bitmap */
+#define MV_DIRTY_BITMAP_MAX_PAGES ((uint64_t)32768)
+
+    /**
+     * <!-- description -->
+     *   @brief A dirty bitmap describes which pages in a range of a dirty
+     *     logged slot have been written to. Bit N of entry M refers to page
+     *     (first_page + (M * 64) + N) of the slot, where first_page is
+     *     provided to the ABI using the dirty bitmap. Like all structures
+     *     used in this ABI, the dirty bitmap must be placed inside the
+     *     shared page.
+     */
+    struct mv_dirty_bitmap_t
+    {
+        /** @brief stores each entry in the dirty bitmap */
+        uint64_t entries[MV_DIRTY_BITMAP_MAX_ENTRIES];
+    };
+
+#pragma pack(pop)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,58 @@
+/// @copyright
+/// Copyright (C) 2020 Assured Information Security, Inc.
+///
+/// @copyright
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// @copyright
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// @copyright
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+
+#ifndef MV_DIRTY_BITMAP_T_HPP
+#define MV_DIRTY_BITMAP_T_HPP
+
+#include <bsl/array.hpp>
+#include <bsl/convert.hpp>
+#include <bsl/safe_integral.hpp>
+
+#pragma pack(push, 1)
+
+namespace hypercall
+{
+    /// @brief defines the max number of entires in the dirty bitmap
+    constexpr auto MV_DIRTY_BITMAP_MAX_ENTRIES{512_u64};
+    /// @brief defines the max number of pages described by the dirty bitmap
+    constexpr auto MV_DIRTY_BITMAP_MAX_PAGES{32768_u64};
+
+    /// <!-- description -->
+    ///   @brief A dirty bitmap describes which pages in a range of a dirty
+    ///     logged slot have been written to. Bit N of entry M refers to page
+    ///     (first_page + (M * 64) + N) of the slot, where first_page is
+    ///     provided to the ABI using the dirty bitmap. Like all structures
+    ///     used in this ABI, the dirty bitmap must be placed inside the
+    ///     shared page.
+    ///
+    struct mv_dirty_bitmap_t final
+    {
+        /// @brief stores each entry in the dirty bitmap
+        bsl::array<bsl::uint64, MV_DIRTY_BITMAP_MAX_ENTRIES.get()> entries;
+    };
+}
+
+#pragma pack(pop)
+
+#endif
@@ -0,0 +1,87 @@
+/**
+ * @copyright
+ * Copyright (C) 2020 Assured Information Security, Inc.
+ *
+ * @copyright
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * @copyright
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * @copyright
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef MV_DIRTY_RING_T_H
+#define MV_DIRTY_RING_T_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#pragma pack(push, 1)
+
+/** @brief defines the max number of entires in the dirty ring */
+#define MV_DIRTY_RING_MAX_ENTRIES ((uint64_t)255)
+
+/** @brief the page described by a dirty gfn was written to */
+#define MV_DIRTY_GFN_FLAG_DIRTY ((uint32_t)0x00000001)
+/** @brief the page described by a dirty gfn should be re-protected */
+#define MV_DIRTY_GFN_FLAG_RESET ((uint32_t)0x00000002)
+
+    /**
+     * <!-- description -->
+     *   @brief A dirty gfn describes a single page of a dirty logged slot
+     *     that was written to. The layout matches the layout of a
+     *     kvm_dirty_gfn so that entries can be copied as is.
+     */
+    struct mv_dirty_gfn_t
+    {
+        /** @brief stores the MV_DIRTY_GFN_FLAG_XXX flags */
+        uint32_t flags;
+        /** @brief stores the slot the dirty page belongs to */
+        uint32_t slot;
+        /** @brief stores the page offset of the dirty page in the slot */
+        uint64_t offset;
+    };
+
+    /**
+     * <!-- description -->
+     *   @brief A dirty ring is a list of dirty gfns that is used to move
+     *     entries from the dirty ring of a VS to software, and to return
+     *     harvested entries to MicroV so that the pages can be write
+     *     protected again. Like all structures used in this ABI, the dirty
+     *     ring must be placed inside the shared page.
+     */
+    struct mv_dirty_ring_t
+    {
+        /** @brief stores the number of entries in the dirty ring */
+        uint64_t num_entries;
+        /** @brief reserved */
+        uint64_t reserved;
+        /** @brief stores each entry in the dirty ring */
+        struct mv_dirty_gfn_t entries[MV_DIRTY_RING_MAX_ENTRIES];
+    };
+
+#pragma pack(pop)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -27,6 +27,7 @@
 #ifndef MV_EXIT_MSR_T_HPP
 #define MV_EXIT_MSR_T_HPP
 
+#include <mv_rdl_entry_t.h>
 #include <stdint.h>
 
 #ifdef __cplusplus
@@ -36,22 +37,22 @@ extern "C"
 
 #pragma pack(push, 1)
 
-/** @brief The mv_exit_mmio_t defines a read access */
-#define MV_EXIT_MMIO_READ ((uint64_t)0x0000000000000001)
-/** @brief The mv_exit_mmio_t defines a write access */
-#define MV_EXIT_MMIO_WRITE ((uint64_t)0x0000000000000002)
-/** @brief The mv_exit_mmio_t defines an execute access */
-#define MV_EXIT_MMIO_EXECUTE ((uint64_t)0x0000000000000004)
+/** @brief The mv_exit_msr_t defines a read access */
+#define MV_EXIT_MSR_READ ((uint64_t)0x0000000000000001)
+/** @brief The mv_exit_msr_t defines a write access */
+#define MV_EXIT_MSR_WRITE ((uint64_t)0x0000000000000002)
+/** @brief Set by software to tell MicroV that the access failed (#GP) */
+#define MV_EXIT_MSR_ERROR ((uint64_t)0x0000000000000004)
 
     /**
      * <!-- description -->
      *   @brief See mv_vs_op_run for more details
      */
-    struct mv_exit_mmio_t
+    struct mv_exit_msr_t
     {
-        /** @brief stores the GPA of the MMIO access */
-        uint64_t gpa;
-        /** @brief stores the MV_EXIT_MMIO flags */
+        /** @brief stores the MSR and its value */
+        struct mv_rdl_entry_t msr;
+        /** @brief stores the MV_EXIT_MSR flags */
         uint64_t flags;
     };
 
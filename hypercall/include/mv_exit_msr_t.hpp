@@ -22,8 +22,10 @@
 /// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 /// SOFTWARE.
 
-#ifndef MV_EXIT_MMIO_T_HPP
-#define MV_EXIT_MMIO_T_HPP
+#ifndef MV_EXIT_MSR_T_HPP
+#define MV_EXIT_MSR_T_HPP
+
+#include <mv_rdl_entry_t.hpp>
 
 #include <bsl/convert.hpp>
 #include <bsl/safe_integral.hpp>
@@ -32,21 +34,21 @@
 
 namespace hypercall
 {
-    /// @brief mv_exit_mmio_t defines a read access
-    constexpr auto MV_EXIT_MMIO_READ{0x0000000000000001_u64};
-    /// @brief mv_exit_mmio_t defines a write access
-    constexpr auto MV_EXIT_MMIO_WRITE{0x0000000000000002_u64};
-    /// @brief mv_exit_mmio_t defines an execute access
-    constexpr auto MV_EXIT_MMIO_EXECUTE{0x0000000000000004_u64};
+    /// @brief mv_exit_msr_t defines a read access
+    constexpr auto MV_EXIT_MSR_READ{0x0000000000000001_u64};
+    /// @brief mv_exit_msr_t defines a write access
+    constexpr auto MV_EXIT_MSR_WRITE{0x0000000000000002_u64};
+    /// @brief set by software to tell MicroV that the access failed (#GP)
+    constexpr auto MV_EXIT_MSR_ERROR{0x0000000000000004_u64};
 
     /// <!-- description -->
     ///   @brief See mv_vs_op_run for more details
     ///
-    struct mv_exit_mmio_t final
+    struct mv_exit_msr_t final
     {
-        /// @brief stores the GPA of the MMIO access
-        bsl::uint64 gpa;
-        /// @brief stores the MV_EXIT_MMIO flags
+        /// @brief stores the MSR and its value
+        mv_rdl_entry_t msr;
+        /// @brief stores the MV_EXIT_MSR flags
         bsl::uint64 flags;
     };
 }
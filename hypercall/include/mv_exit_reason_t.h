@@ -62,6 +62,12 @@ enum mv_exit_reason_t
         mv_exit_reason_t_interrupt = 6,
         /** @brief an nmi event has occurred */
         mv_exit_reason_t_nmi = 7,
+        /** @brief the dirty ring of the VS is full */
+        mv_exit_reason_t_dirty_ring_full = 8,
+        /** @brief the VS kicked another VS out of a halt */
+        mv_exit_reason_t_kick = 9,
+        /** @brief the VS is spinning in a PAUSE loop */
+        mv_exit_reason_t_pause = 10,
     };
 
 /** @brief integer version of mv_exit_reason_t_failure */
@@ -80,6 +86,12 @@ enum mv_exit_reason_t
 #define EXIT_REASON_INTERRUPT ((int32_t)mv_exit_reason_t_interrupt)
 /** @brief integer version of mv_exit_reason_t_nmi */
 #define EXIT_REASON_NMI ((int32_t)mv_exit_reason_t_nmi)
+/** @brief integer version of mv_exit_reason_t_dirty_ring_full */
+#define EXIT_REASON_DIRTY_RING_FULL ((int32_t)mv_exit_reason_t_dirty_ring_full)
+/** @brief integer version of mv_exit_reason_t_kick */
+#define EXIT_REASON_KICK ((int32_t)mv_exit_reason_t_kick)
+/** @brief integer version of mv_exit_reason_t_pause */
+#define EXIT_REASON_PAUSE ((int32_t)mv_exit_reason_t_pause)
 
 #ifdef __cplusplus
 }
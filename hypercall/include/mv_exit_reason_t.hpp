@@ -51,6 +51,12 @@ namespace hypercall
         mv_exit_reason_t_interrupt = 6,
         /// @brief an nmi event has occurred
         mv_exit_reason_t_nmi = 7,
+        /// @brief the dirty ring of the VS is full
+        mv_exit_reason_t_dirty_ring_full = 8,
+        /// @brief the VS kicked another VS out of a halt
+        mv_exit_reason_t_kick = 9,
+        /// @brief the VS is spinning in a PAUSE loop
+        mv_exit_reason_t_pause = 10,
     };
 
     /// <!-- description -->
@@ -82,6 +88,13 @@ namespace hypercall
     constexpr auto EXIT_REASON_INTERRUPT{to_i32(mv_exit_reason_t::mv_exit_reason_t_interrupt)};
     /// @brief integer version of mv_exit_reason_t_nmi
     constexpr auto EXIT_REASON_NMI{to_i32(mv_exit_reason_t::mv_exit_reason_t_nmi)};
+    /// @brief integer version of mv_exit_reason_t_dirty_ring_full
+    constexpr auto EXIT_REASON_DIRTY_RING_FULL{
+        to_i32(mv_exit_reason_t::mv_exit_reason_t_dirty_ring_full)};
+    /// @brief integer version of mv_exit_reason_t_kick
+    constexpr auto EXIT_REASON_KICK{to_i32(mv_exit_reason_t::mv_exit_reason_t_kick)};
+    /// @brief integer version of mv_exit_reason_t_pause
+    constexpr auto EXIT_REASON_PAUSE{to_i32(mv_exit_reason_t::mv_exit_reason_t_pause)};
 }
 
 #endif
@@ -83,19 +83,34 @@ if(HYPERVISOR_TARGET_ARCH STREQUAL "AuthenticAMD" OR HYPERVISOR_TARGET_ARCH STRE
         microv_target_source(hypercall src/linux/x64/amd/mv_handle_op_open_handle_impl.S ${HEADERS})
         microv_target_source(hypercall src/linux/x64/amd/mv_id_op_version_impl.S ${HEADERS})
         microv_target_source(hypercall src/linux/x64/amd/mv_pp_op_clr_shared_page_gpa_impl.S ${HEADERS})
+        microv_target_source(hypercall src/linux/x64/amd/mv_pp_op_cpuid_get_supported_list_impl.S ${HEADERS})
         microv_target_source(hypercall src/linux/x64/amd/mv_pp_op_ppid_impl.S ${HEADERS})
+        microv_target_source(hypercall src/linux/x64/amd/mv_pp_op_tsc_get_khz_impl.S ${HEADERS})
         microv_target_source(hypercall src/linux/x64/amd/mv_pp_op_set_shared_page_gpa_impl.S ${HEADERS})
+        microv_target_source(hypercall src/linux/x64/amd/mv_vm_op_clock_get_impl.S ${HEADERS})
+        microv_target_source(hypercall src/linux/x64/amd/mv_vm_op_clock_set_impl.S ${HEADERS})
         microv_target_source(hypercall src/linux/x64/amd/mv_vm_op_create_vm_impl.S ${HEADERS})
         microv_target_source(hypercall src/linux/x64/amd/mv_vm_op_destroy_vm_impl.S ${HEADERS})
+        microv_target_source(hypercall src/linux/x64/amd/mv_vm_op_dirty_log_clear_impl.S ${HEADERS})
+        microv_target_source(hypercall src/linux/x64/amd/mv_vm_op_dirty_log_disable_impl.S ${HEADERS})
+        microv_target_source(hypercall src/linux/x64/amd/mv_vm_op_dirty_log_enable_impl.S ${HEADERS})
+        microv_target_source(hypercall src/linux/x64/amd/mv_vm_op_dirty_log_get_impl.S ${HEADERS})
+        microv_target_source(hypercall src/linux/x64/amd/mv_vm_op_dirty_ring_reset_impl.S ${HEADERS})
+        microv_target_source(hypercall src/linux/x64/amd/mv_vm_op_fork_vm_impl.S ${HEADERS})
+        microv_target_source(hypercall src/linux/x64/amd/mv_vm_op_io_intercept_impl.S ${HEADERS})
         microv_target_source(hypercall src/linux/x64/amd/mv_vm_op_mmio_map_impl.S ${HEADERS})
         microv_target_source(hypercall src/linux/x64/amd/mv_vm_op_mmio_unmap_impl.S ${HEADERS})
+        microv_target_source(hypercall src/linux/x64/amd/mv_vm_op_msr_filter_impl.S ${HEADERS})
+        microv_target_source(hypercall src/linux/x64/amd/mv_vm_op_msr_intercept_impl.S ${HEADERS})
         microv_target_source(hypercall src/linux/x64/amd/mv_vm_op_vmid_impl.S ${HEADERS})
         microv_target_source(hypercall src/linux/x64/amd/mv_vp_op_create_vp_impl.S ${HEADERS})
         microv_target_source(hypercall src/linux/x64/amd/mv_vp_op_destroy_vp_impl.S ${HEADERS})
         microv_target_source(hypercall src/linux/x64/amd/mv_vp_op_vmid_impl.S ${HEADERS})
         microv_target_source(hypercall src/linux/x64/amd/mv_vp_op_vpid_impl.S ${HEADERS})
+        microv_target_source(hypercall src/linux/x64/amd/mv_vs_op_cpuid_set_list_impl.S ${HEADERS})
         microv_target_source(hypercall src/linux/x64/amd/mv_vs_op_create_vs_impl.S ${HEADERS})
         microv_target_source(hypercall src/linux/x64/amd/mv_vs_op_destroy_vs_impl.S ${HEADERS})
+        microv_target_source(hypercall src/linux/x64/amd/mv_vs_op_dirty_ring_get_impl.S ${HEADERS})
         microv_target_source(hypercall src/linux/x64/amd/mv_vs_op_fpu_get_all_impl.S ${HEADERS})
         microv_target_source(hypercall src/linux/x64/amd/mv_vs_op_fpu_set_all_impl.S ${HEADERS})
         microv_target_source(hypercall src/linux/x64/amd/mv_vs_op_gla_to_gpa_impl.S ${HEADERS})
@@ -108,6 +123,8 @@ if(HYPERVISOR_TARGET_ARCH STREQUAL "AuthenticAMD" OR HYPERVISOR_TARGET_ARCH STRE
         microv_target_source(hypercall src/linux/x64/amd/mv_vs_op_reg_set_impl.S ${HEADERS})
         microv_target_source(hypercall src/linux/x64/amd/mv_vs_op_reg_set_list_impl.S ${HEADERS})
         microv_target_source(hypercall src/linux/x64/amd/mv_vs_op_run_impl.S ${HEADERS})
+        microv_target_source(hypercall src/linux/x64/amd/mv_vs_op_tsc_set_khz_impl.S ${HEADERS})
+        microv_target_source(hypercall src/linux/x64/amd/mv_vs_op_tsc_set_offset_impl.S ${HEADERS})
         microv_target_source(hypercall src/linux/x64/amd/mv_vs_op_vmid_impl.S ${HEADERS})
         microv_target_source(hypercall src/linux/x64/amd/mv_vs_op_vpid_impl.S ${HEADERS})
         microv_target_source(hypercall src/linux/x64/amd/mv_vs_op_vsid_impl.S ${HEADERS})
@@ -119,19 +136,34 @@ if(HYPERVISOR_TARGET_ARCH STREQUAL "AuthenticAMD" OR HYPERVISOR_TARGET_ARCH STRE
         microv_target_source(hypercall src/linux/x64/intel/mv_handle_op_open_handle_impl.S ${HEADERS})
         microv_target_source(hypercall src/linux/x64/intel/mv_id_op_version_impl.S ${HEADERS})
         microv_target_source(hypercall src/linux/x64/intel/mv_pp_op_clr_shared_page_gpa_impl.S ${HEADERS})
+        microv_target_source(hypercall src/linux/x64/intel/mv_pp_op_cpuid_get_supported_list_impl.S ${HEADERS})
         microv_target_source(hypercall src/linux/x64/intel/mv_pp_op_ppid_impl.S ${HEADERS})
+        microv_target_source(hypercall src/linux/x64/intel/mv_pp_op_tsc_get_khz_impl.S ${HEADERS})
         microv_target_source(hypercall src/linux/x64/intel/mv_pp_op_set_shared_page_gpa_impl.S ${HEADERS})
+        microv_target_source(hypercall src/linux/x64/intel/mv_vm_op_clock_get_impl.S ${HEADERS})
+        microv_target_source(hypercall src/linux/x64/intel/mv_vm_op_clock_set_impl.S ${HEADERS})
         microv_target_source(hypercall src/linux/x64/intel/mv_vm_op_create_vm_impl.S ${HEADERS})
         microv_target_source(hypercall src/linux/x64/intel/mv_vm_op_destroy_vm_impl.S ${HEADERS})
+        microv_target_source(hypercall src/linux/x64/intel/mv_vm_op_dirty_log_clear_impl.S ${HEADERS})
+        microv_target_source(hypercall src/linux/x64/intel/mv_vm_op_dirty_log_disable_impl.S ${HEADERS})
+        microv_target_source(hypercall src/linux/x64/intel/mv_vm_op_dirty_log_enable_impl.S ${HEADERS})
+        microv_target_source(hypercall src/linux/x64/intel/mv_vm_op_dirty_log_get_impl.S ${HEADERS})
+        microv_target_source(hypercall src/linux/x64/intel/mv_vm_op_dirty_ring_reset_impl.S ${HEADERS})
+        microv_target_source(hypercall src/linux/x64/intel/mv_vm_op_fork_vm_impl.S ${HEADERS})
+        microv_target_source(hypercall src/linux/x64/intel/mv_vm_op_io_intercept_impl.S ${HEADERS})
         microv_target_source(hypercall src/linux/x64/intel/mv_vm_op_mmio_map_impl.S ${HEADERS})
         microv_target_source(hypercall src/linux/x64/intel/mv_vm_op_mmio_unmap_impl.S ${HEADERS})
+        microv_target_source(hypercall src/linux/x64/intel/mv_vm_op_msr_filter_impl.S ${HEADERS})
+        microv_target_source(hypercall src/linux/x64/intel/mv_vm_op_msr_intercept_impl.S ${HEADERS})
         microv_target_source(hypercall src/linux/x64/intel/mv_vm_op_vmid_impl.S ${HEADERS})
         microv_target_source(hypercall src/linux/x64/intel/mv_vp_op_create_vp_impl.S ${HEADERS})
         microv_target_source(hypercall src/linux/x64/intel/mv_vp_op_destroy_vp_impl.S ${HEADERS})
         microv_target_source(hypercall src/linux/x64/intel/mv_vp_op_vmid_impl.S ${HEADERS})
         microv_target_source(hypercall src/linux/x64/intel/mv_vp_op_vpid_impl.S ${HEADERS})
+        microv_target_source(hypercall src/linux/x64/intel/mv_vs_op_cpuid_set_list_impl.S ${HEADERS})
         microv_target_source(hypercall src/linux/x64/intel/mv_vs_op_create_vs_impl.S ${HEADERS})
         microv_target_source(hypercall src/linux/x64/intel/mv_vs_op_destroy_vs_impl.S ${HEADERS})
+        microv_target_source(hypercall src/linux/x64/intel/mv_vs_op_dirty_ring_get_impl.S ${HEADERS})
         microv_target_source(hypercall src/linux/x64/intel/mv_vs_op_fpu_get_all_impl.S ${HEADERS})
         microv_target_source(hypercall src/linux/x64/intel/mv_vs_op_fpu_set_all_impl.S ${HEADERS})
         microv_target_source(hypercall src/linux/x64/intel/mv_vs_op_gla_to_gpa_impl.S ${HEADERS})
@@ -144,6 +176,8 @@ if(HYPERVISOR_TARGET_ARCH STREQUAL "AuthenticAMD" OR HYPERVISOR_TARGET_ARCH STRE
         microv_target_source(hypercall src/linux/x64/intel/mv_vs_op_reg_set_impl.S ${HEADERS})
         microv_target_source(hypercall src/linux/x64/intel/mv_vs_op_reg_set_list_impl.S ${HEADERS})
         microv_target_source(hypercall src/linux/x64/intel/mv_vs_op_run_impl.S ${HEADERS})
+        microv_target_source(hypercall src/linux/x64/intel/mv_vs_op_tsc_set_khz_impl.S ${HEADERS})
+        microv_target_source(hypercall src/linux/x64/intel/mv_vs_op_tsc_set_offset_impl.S ${HEADERS})
         microv_target_source(hypercall src/linux/x64/intel/mv_vs_op_vmid_impl.S ${HEADERS})
         microv_target_source(hypercall src/linux/x64/intel/mv_vs_op_vpid_impl.S ${HEADERS})
         microv_target_source(hypercall src/linux/x64/intel/mv_vs_op_vsid_impl.S ${HEADERS})
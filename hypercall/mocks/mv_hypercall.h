@@ -27,8 +27,13 @@
 #ifndef MOCKS_MV_HYPERCALL_H
 #define MOCKS_MV_HYPERCALL_H
 
+#include <mv_cdl_t.h>
 #include <mv_constants.h>
+#include <mv_dirty_ring_t.h>
 #include <mv_exit_io_t.h>
+#include <mv_exit_kick_t.h>
+#include <mv_exit_mmio_t.h>
+#include <mv_exit_msr_t.h>
 #include <mv_exit_reason_t.h>
 #include <mv_rdl_t.h>
 #include <mv_reg_t.h>
@@ -136,6 +141,10 @@ extern "C"
     extern mv_status_t g_mut_mv_pp_op_clr_shared_page_gpa;
     /** @brief stores the return value for mv_pp_op_set_shared_page_gpa */
     extern mv_status_t g_mut_mv_pp_op_set_shared_page_gpa;
+    /** @brief stores the return value for mv_pp_op_cpuid_get_supported_list */
+    extern mv_status_t g_mut_mv_pp_op_cpuid_get_supported_list;
+    /** @brief stores the return value for mv_pp_op_tsc_get_khz */
+    extern mv_status_t g_mut_mv_pp_op_tsc_get_khz;
 
     /**
      * <!-- description -->
@@ -211,6 +220,96 @@ extern "C"
         return g_mut_mv_pp_op_set_shared_page_gpa;
     }
 
+    /**
+     * <!-- description -->
+     *   @brief Given the shared page cast as a mv_cdl_t, with each
+     *     entry's fun and idx fields set to the requested CPUID leaf, the
+     *     same entries are returned in the shared page with the eax, ebx,
+     *     ecx and edx fields set with all supported CPU features set to 1.
+     *     If num_entries is 0, the shared page is instead filled with every
+     *     CPUID leaf that MicroV supports, and num_entries is set to the
+     *     number of entries that were returned.
+     *
+     * <!-- inputs/outputs -->
+     *   @param hndl Set to the result of mv_handle_op_open_handle
+     *   @return Returns MV_STATUS_SUCCESS on success, MV_STATUS_FAILURE_UNKNOWN
+     *     and friends on failure.
+     */
+    NODISCARD static inline mv_status_t
+    mv_pp_op_cpuid_get_supported_list(uint64_t const hndl) NOEXCEPT
+    {
+        uint64_t mut_i;
+
+#ifdef __cplusplus
+        bsl::expects(MV_INVALID_HANDLE != hndl);
+        bsl::expects(hndl > ((uint64_t)0));
+#else
+    platform_expects(MV_INVALID_HANDLE != hndl);
+    platform_expects(hndl > ((uint64_t)0));
+#endif
+
+        struct mv_cdl_t *const pmut_cdl = (struct mv_cdl_t *)g_mut_shared_pages[0];
+
+#ifdef __cplusplus
+        bsl::expects(nullptr != pmut_cdl);
+#else
+    platform_expects(NULL != pmut_cdl);
+#endif
+
+        pmut_cdl->num_entries = g_mut_val;
+        for (mut_i = ((uint64_t)0); mut_i < pmut_cdl->num_entries; ++mut_i) {
+            if (mut_i >= MV_CDL_MAX_ENTRIES) {
+                break;
+            }
+
+            pmut_cdl->entries[mut_i].fun = (uint32_t)mut_i;
+            pmut_cdl->entries[mut_i].idx = (uint32_t)mut_i;
+            pmut_cdl->entries[mut_i].eax = (uint32_t)mut_i;
+            pmut_cdl->entries[mut_i].ebx = (uint32_t)mut_i;
+            pmut_cdl->entries[mut_i].ecx = (uint32_t)mut_i;
+            pmut_cdl->entries[mut_i].edx = (uint32_t)mut_i;
+
+            if (((uint64_t)0) == mut_i) {
+                pmut_cdl->entries[mut_i].flags = mv_cpuid_flag_t_reserved;
+            }
+            else {
+                pmut_cdl->entries[mut_i].flags = mv_cpuid_flag_t_significant_index;
+            }
+        }
+
+        return g_mut_mv_pp_op_cpuid_get_supported_list;
+    }
+
+    /**
+     * <!-- description -->
+     *   @brief This hypercall returns the frequency of the PP's TSC in KHz.
+     *     The frequency is measured once by MicroV when the PP is started,
+     *     so calling this hypercall does not require MicroV to query the
+     *     hardware.
+     *
+     * <!-- inputs/outputs -->
+     *   @param hndl Set to the result of mv_handle_op_open_handle
+     *   @param pmut_freq Where to return the TSC frequency in KHz
+     *   @return Returns MV_STATUS_SUCCESS on success, MV_STATUS_FAILURE_UNKNOWN
+     *     and friends on failure.
+     */
+    NODISCARD static inline mv_status_t
+    mv_pp_op_tsc_get_khz(uint64_t const hndl, uint64_t *const pmut_freq) NOEXCEPT
+    {
+#ifdef __cplusplus
+        bsl::expects(MV_INVALID_HANDLE != hndl);
+        bsl::expects(hndl > ((uint64_t)0));
+        bsl::expects(NULLPTR != pmut_freq);
+#else
+    platform_expects(MV_INVALID_HANDLE != hndl);
+    platform_expects(hndl > ((uint64_t)0));
+    platform_expects(NULLPTR != pmut_freq);
+#endif
+
+        *pmut_freq = g_mut_val;
+        return g_mut_mv_pp_op_tsc_get_khz;
+    }
+
     /* -------------------------------------------------------------------------- */
     /* mv_vm_ops                                                                  */
     /* -------------------------------------------------------------------------- */
@@ -225,6 +324,28 @@ extern "C"
     extern mv_status_t g_mut_mv_vm_op_mmio_map;
     /** @brief stores the return value for mv_vm_op_mmio_unmap */
     extern mv_status_t g_mut_mv_vm_op_mmio_unmap;
+    /** @brief stores the return value for mv_vm_op_dirty_log_enable */
+    extern mv_status_t g_mut_mv_vm_op_dirty_log_enable;
+    /** @brief stores the return value for mv_vm_op_dirty_log_disable */
+    extern mv_status_t g_mut_mv_vm_op_dirty_log_disable;
+    /** @brief stores the return value for mv_vm_op_dirty_log_get */
+    extern mv_status_t g_mut_mv_vm_op_dirty_log_get;
+    /** @brief stores the return value for mv_vm_op_dirty_log_clear */
+    extern mv_status_t g_mut_mv_vm_op_dirty_log_clear;
+    /** @brief stores the return value for mv_vm_op_dirty_ring_reset */
+    extern mv_status_t g_mut_mv_vm_op_dirty_ring_reset;
+    /** @brief stores the return value for mv_vm_op_fork_vm */
+    extern uint16_t g_mut_mv_vm_op_fork_vm;
+    /** @brief stores the return value for mv_vm_op_msr_intercept */
+    extern mv_status_t g_mut_mv_vm_op_msr_intercept;
+    /** @brief stores the return value for mv_vm_op_io_intercept */
+    extern mv_status_t g_mut_mv_vm_op_io_intercept;
+    /** @brief stores the return value for mv_vm_op_msr_filter */
+    extern mv_status_t g_mut_mv_vm_op_msr_filter;
+    /** @brief stores the return value for mv_vm_op_clock_get */
+    extern mv_status_t g_mut_mv_vm_op_clock_get;
+    /** @brief stores the return value for mv_vm_op_clock_set */
+    extern mv_status_t g_mut_mv_vm_op_clock_set;
 
     /**
      * <!-- description -->
@@ -410,6 +531,399 @@ extern "C"
         return MV_STATUS_SUCCESS;
     }
 
+    /**
+     * <!-- description -->
+     *   @brief This hypercall tells MicroV to start logging writes to a
+     *     region of guest physical memory that was previously mapped into a
+     *     VM using mv_vm_op_mmio_map. For this ABI, the shared page must
+     *     contain an mv_mdl_t with a single entry. The dst field of this
+     *     entry refers to the GPA of the region and the bytes field refers
+     *     to the size of the region, which must be page aligned. The src
+     *     and flags fields are ignored. Each page in the region is write
+     *     protected, and the first write to a page marks it as dirty in
+     *     the dirty log of the slot and restores write access to it.
+     *
+     * <!-- inputs/outputs -->
+     *   @param hndl Set to the result of mv_handle_op_open_handle
+     *   @param vmid The ID of the VM to enable dirty logging for
+     *   @param slot The slot to store the dirty log of the region in
+     *   @return Returns MV_STATUS_SUCCESS on success, MV_STATUS_FAILURE_UNKNOWN
+     *     and friends on failure.
+     */
+    NODISCARD static inline mv_status_t
+    mv_vm_op_dirty_log_enable(
+        uint64_t const hndl, uint16_t const vmid, uint64_t const slot) NOEXCEPT
+    {
+#ifdef __cplusplus
+        bsl::expects(MV_INVALID_HANDLE != hndl);
+        bsl::expects(hndl > ((uint64_t)0));
+        bsl::expects((int32_t)MV_INVALID_ID != (int32_t)vmid);
+#else
+    platform_expects(MV_INVALID_HANDLE != hndl);
+    platform_expects(hndl > ((uint64_t)0));
+    platform_expects((int32_t)MV_INVALID_ID != (int32_t)vmid);
+#endif
+
+        return g_mut_mv_vm_op_dirty_log_enable;
+    }
+
+    /**
+     * <!-- description -->
+     *   @brief This hypercall tells MicroV to stop logging writes to the
+     *     region of guest physical memory associated with the provided slot
+     *     and to release the dirty log of the slot. Write access is restored
+     *     to any page in the region that is still write protected.
+     *
+     * <!-- inputs/outputs -->
+     *   @param hndl Set to the result of mv_handle_op_open_handle
+     *   @param vmid The ID of the VM to disable dirty logging for
+     *   @param slot The slot to disable dirty logging for
+     *   @return Returns MV_STATUS_SUCCESS on success, MV_STATUS_FAILURE_UNKNOWN
+     *     and friends on failure.
+     */
+    NODISCARD static inline mv_status_t
+    mv_vm_op_dirty_log_disable(
+        uint64_t const hndl, uint16_t const vmid, uint64_t const slot) NOEXCEPT
+    {
+#ifdef __cplusplus
+        bsl::expects(MV_INVALID_HANDLE != hndl);
+        bsl::expects(hndl > ((uint64_t)0));
+        bsl::expects((int32_t)MV_INVALID_ID != (int32_t)vmid);
+#else
+    platform_expects(MV_INVALID_HANDLE != hndl);
+    platform_expects(hndl > ((uint64_t)0));
+    platform_expects((int32_t)MV_INVALID_ID != (int32_t)vmid);
+#endif
+
+        return g_mut_mv_vm_op_dirty_log_disable;
+    }
+
+    /**
+     * <!-- description -->
+     *   @brief This hypercall tells MicroV to copy the dirty log of the
+     *     provided slot into an mv_dirty_bitmap_t in the shared page. The
+     *     first bit in the mv_dirty_bitmap_t refers to first_page, and each
+     *     call returns at most MV_DIRTY_BITMAP_MAX_PAGES pages. first_page
+     *     must be a multiple of 64. Bits past the end of the slot are 0. The
+     *     dirty log itself is not modified (see mv_vm_op_dirty_log_clear).
+     *
+     * <!-- inputs/outputs -->
+     *   @param hndl Set to the result of mv_handle_op_open_handle
+     *   @param vmid The ID of the VM to query
+     *   @param slot The slot to query
+     *   @param first_page The index of the first page in the slot to query
+     *   @return Returns MV_STATUS_SUCCESS on success, MV_STATUS_FAILURE_UNKNOWN
+     *     and friends on failure.
+     */
+    NODISCARD static inline mv_status_t
+    mv_vm_op_dirty_log_get(
+        uint64_t const hndl,
+        uint16_t const vmid,
+        uint64_t const slot,
+        uint64_t const first_page) NOEXCEPT
+    {
+#ifdef __cplusplus
+        bsl::expects(MV_INVALID_HANDLE != hndl);
+        bsl::expects(hndl > ((uint64_t)0));
+        bsl::expects((int32_t)MV_INVALID_ID != (int32_t)vmid);
+#else
+    platform_expects(MV_INVALID_HANDLE != hndl);
+    platform_expects(hndl > ((uint64_t)0));
+    platform_expects((int32_t)MV_INVALID_ID != (int32_t)vmid);
+#endif
+
+        return g_mut_mv_vm_op_dirty_log_get;
+    }
+
+    /**
+     * <!-- description -->
+     *   @brief This hypercall tells MicroV to clear the pages described
+     *     by the mv_dirty_bitmap_t in the shared page from the dirty log of
+     *     the provided slot. The first bit in the mv_dirty_bitmap_t refers
+     *     to first_page, which must be a multiple of 64. Only pages that are
+     *     both set in the mv_dirty_bitmap_t and dirty are write protected
+     *     again, and the TLB is flushed once if any pages were cleared.
+     *
+     * <!-- inputs/outputs -->
+     *   @param hndl Set to the result of mv_handle_op_open_handle
+     *   @param vmid The ID of the VM to modify
+     *   @param slot The slot to modify
+     *   @param first_page The index of the first page in the slot to clear
+     *   @return Returns MV_STATUS_SUCCESS on success, MV_STATUS_FAILURE_UNKNOWN
+     *     and friends on failure.
+     */
+    NODISCARD static inline mv_status_t
+    mv_vm_op_dirty_log_clear(
+        uint64_t const hndl,
+        uint16_t const vmid,
+        uint64_t const slot,
+        uint64_t const first_page) NOEXCEPT
+    {
+#ifdef __cplusplus
+        bsl::expects(MV_INVALID_HANDLE != hndl);
+        bsl::expects(hndl > ((uint64_t)0));
+        bsl::expects((int32_t)MV_INVALID_ID != (int32_t)vmid);
+#else
+    platform_expects(MV_INVALID_HANDLE != hndl);
+    platform_expects(hndl > ((uint64_t)0));
+    platform_expects((int32_t)MV_INVALID_ID != (int32_t)vmid);
+#endif
+
+        return g_mut_mv_vm_op_dirty_log_clear;
+    }
+
+    /**
+     * <!-- description -->
+     *   @brief This hypercall tells MicroV to clear the pages described
+     *     by the mv_dirty_ring_t in the shared page from the dirty log of
+     *     the VM. These are the entries that software harvested from the
+     *     dirty rings of the VM's VSs. Each page that was dirty is write
+     *     protected again, and the TLB is flushed once if any pages were
+     *     cleared.
+     *
+     * <!-- inputs/outputs -->
+     *   @param hndl Set to the result of mv_handle_op_open_handle
+     *   @param vmid The ID of the VM to modify
+     *   @return Returns MV_STATUS_SUCCESS on success, MV_STATUS_FAILURE_UNKNOWN
+     *     and friends on failure.
+     */
+    NODISCARD static inline mv_status_t
+    mv_vm_op_dirty_ring_reset(uint64_t const hndl, uint16_t const vmid) NOEXCEPT
+    {
+#ifdef __cplusplus
+        bsl::expects(MV_INVALID_HANDLE != hndl);
+        bsl::expects(hndl > ((uint64_t)0));
+        bsl::expects((int32_t)MV_INVALID_ID != (int32_t)vmid);
+#else
+    platform_expects(MV_INVALID_HANDLE != hndl);
+    platform_expects(hndl > ((uint64_t)0));
+    platform_expects((int32_t)MV_INVALID_ID != (int32_t)vmid);
+#endif
+
+        return g_mut_mv_vm_op_dirty_ring_reset;
+    }
+
+    /**
+     * <!-- description -->
+     *   @brief This hypercall tells MicroV to create a VM that is a
+     *     copy-on-write fork of the provided parent VM. For this ABI, the
+     *     shared page must contain an mv_mdl_t whose entries describe the
+     *     ranges of guest physical memory to share. The dst and bytes
+     *     fields of each entry refer to the GPA and size of a range, and
+     *     the src and flags fields are ignored. Each page in these ranges
+     *     that is mapped into the parent VM is mapped into the new VM at
+     *     the same GPA as read/execute only, and the first write to any of
+     *     these pages is returned to the root VM as an MMIO exit so that
+     *     it can map a private copy of the page in its place. The parent
+     *     VM must not run while it has children. Upon success, this
+     *     hypercall returns the ID of the newly created VM.
+     *
+     * <!-- inputs/outputs -->
+     *   @param hndl Set to the result of mv_handle_op_open_handle
+     *   @param parent_vmid The ID of the VM to fork
+     *   @return Returns the resulting VMID of the newly created VM
+     */
+    NODISCARD static inline uint16_t
+    mv_vm_op_fork_vm(uint64_t const hndl, uint16_t const parent_vmid) NOEXCEPT
+    {
+#ifdef __cplusplus
+        bsl::expects(MV_INVALID_HANDLE != hndl);
+        bsl::expects(hndl > ((uint64_t)0));
+        bsl::expects((int32_t)MV_INVALID_ID != (int32_t)parent_vmid);
+#else
+    platform_expects(MV_INVALID_HANDLE != hndl);
+    platform_expects(hndl > ((uint64_t)0));
+    platform_expects((int32_t)MV_INVALID_ID != (int32_t)parent_vmid);
+#endif
+
+        return g_mut_mv_vm_op_fork_vm;
+    }
+
+    /**
+     * <!-- description -->
+     *   @brief This hypercall tells MicroV to intercept the provided
+     *     accesses to the provided MSR for every VS assigned to the
+     *     provided VM and to pass through the rest. Accesses are
+     *     described using MV_PERM_READ and MV_PERM_WRITE. Only MSRs that
+     *     are context switched with the VS can be passed through, and
+     *     by default, every other MSR is intercepted.
+     *
+     * <!-- inputs/outputs -->
+     *   @param hndl Set to the result of mv_handle_op_open_handle
+     *   @param vmid The ID of the VM to modify
+     *   @param msr The MSR to modify
+     *   @param perms The accesses to intercept
+     *   @return Returns MV_STATUS_SUCCESS on success, MV_STATUS_FAILURE_UNKNOWN
+     *     and friends on failure.
+     */
+    NODISCARD static inline mv_status_t
+    mv_vm_op_msr_intercept(
+        uint64_t const hndl, uint16_t const vmid, uint32_t const msr, uint64_t const perms) NOEXCEPT
+    {
+#ifdef __cplusplus
+        bsl::expects(MV_INVALID_HANDLE != hndl);
+        bsl::expects(hndl > ((uint64_t)0));
+        bsl::expects((int32_t)MV_INVALID_ID != (int32_t)vmid);
+#else
+    platform_expects(MV_INVALID_HANDLE != hndl);
+    platform_expects(hndl > ((uint64_t)0));
+    platform_expects((int32_t)MV_INVALID_ID != (int32_t)vmid);
+#endif
+
+        return g_mut_mv_vm_op_msr_intercept;
+    }
+
+    /**
+     * <!-- description -->
+     *   @brief This hypercall tells MicroV how to handle accesses to a
+     *     range of ports for every VS assigned to the provided VM. Bits
+     *     15:0 of ports contain the first port of the range and bits
+     *     31:16 contain the last port of the range (inclusive). The
+     *     remaining bits are reserved and must be 0. The type is one of
+     *     the MV_IO_INTERCEPT_xxx values. By default, every port exits
+     *     except for the POST code port (0x80), which is ignored, and
+     *     only the POST code port can be passed through.
+     *
+     * <!-- inputs/outputs -->
+     *   @param hndl Set to the result of mv_handle_op_open_handle
+     *   @param vmid The ID of the VM to modify
+     *   @param ports The range of ports to modify
+     *   @param type The MV_IO_INTERCEPT_xxx type to use
+     *   @return Returns MV_STATUS_SUCCESS on success, MV_STATUS_FAILURE_UNKNOWN
+     *     and friends on failure.
+     */
+    NODISCARD static inline mv_status_t
+    mv_vm_op_io_intercept(
+        uint64_t const hndl,
+        uint16_t const vmid,
+        uint64_t const ports,
+        uint64_t const type) NOEXCEPT
+    {
+#ifdef __cplusplus
+        bsl::expects(MV_INVALID_HANDLE != hndl);
+        bsl::expects(hndl > ((uint64_t)0));
+        bsl::expects((int32_t)MV_INVALID_ID != (int32_t)vmid);
+#else
+    platform_expects(MV_INVALID_HANDLE != hndl);
+    platform_expects(hndl > ((uint64_t)0));
+    platform_expects((int32_t)MV_INVALID_ID != (int32_t)vmid);
+#endif
+
+        return g_mut_mv_vm_op_io_intercept;
+    }
+
+    /**
+     * <!-- description -->
+     *   @brief This hypercall tells MicroV to return the provided
+     *     accesses to a range of MSRs to software for every VS assigned
+     *     to the provided VM. Bits 31:0 of msrs contain the first MSR of
+     *     the range and bits 63:32 contain the last MSR of the range
+     *     (inclusive). Accesses are described using MV_PERM_READ and
+     *     MV_PERM_WRITE, and accesses that are not provided are removed
+     *     from the filter. Filtered accesses return mv_exit_reason_t_msr
+     *     from mv_vs_op_run. Only MSRs covered by the MSR permissions
+     *     map can be filtered.
+     *
+     * <!-- inputs/outputs -->
+     *   @param hndl Set to the result of mv_handle_op_open_handle
+     *   @param vmid The ID of the VM to modify
+     *   @param msrs The range of MSRs to modify
+     *   @param perms The accesses to return to software
+     *   @return Returns MV_STATUS_SUCCESS on success, MV_STATUS_FAILURE_UNKNOWN
+     *     and friends on failure.
+     */
+    NODISCARD static inline mv_status_t
+    mv_vm_op_msr_filter(
+        uint64_t const hndl,
+        uint16_t const vmid,
+        uint64_t const msrs,
+        uint64_t const perms) NOEXCEPT
+    {
+#ifdef __cplusplus
+        bsl::expects(MV_INVALID_HANDLE != hndl);
+        bsl::expects(hndl > ((uint64_t)0));
+        bsl::expects((int32_t)MV_INVALID_ID != (int32_t)vmid);
+#else
+    platform_expects(MV_INVALID_HANDLE != hndl);
+    platform_expects(hndl > ((uint64_t)0));
+    platform_expects((int32_t)MV_INVALID_ID != (int32_t)vmid);
+#endif
+
+        return g_mut_mv_vm_op_msr_filter;
+    }
+
+    /**
+     * <!-- description -->
+     *   @brief This hypercall tells MicroV to return the current value
+     *     of the VM's kvmclock in nanoseconds. This is the clock that
+     *     each VS of the VM reads using its pvclock structure (see
+     *     MSR_KVM_SYSTEM_TIME_NEW).
+     *
+     * <!-- inputs/outputs -->
+     *   @param hndl Set to the result of mv_handle_op_open_handle
+     *   @param vmid The ID of the VM to query
+     *   @param pmut_clock Where to return the kvmclock in nanoseconds
+     *   @return Returns MV_STATUS_SUCCESS on success, MV_STATUS_FAILURE_UNKNOWN
+     *     and friends on failure.
+     */
+    NODISCARD static inline mv_status_t
+    mv_vm_op_clock_get(
+        uint64_t const hndl, uint16_t const vmid, uint64_t *const pmut_clock) NOEXCEPT
+    {
+#ifdef __cplusplus
+        bsl::expects(MV_INVALID_HANDLE != hndl);
+        bsl::expects(hndl > ((uint64_t)0));
+        bsl::expects((int32_t)MV_INVALID_ID != (int32_t)vmid);
+        bsl::expects(NULLPTR != pmut_clock);
+#else
+    platform_expects(MV_INVALID_HANDLE != hndl);
+    platform_expects(hndl > ((uint64_t)0));
+    platform_expects((int32_t)MV_INVALID_ID != (int32_t)vmid);
+    platform_expects(NULLPTR != pmut_clock);
+#endif
+
+        *pmut_clock = g_mut_val;
+        return g_mut_mv_vm_op_clock_get;
+    }
+
+    /**
+     * <!-- description -->
+     *   @brief This hypercall tells MicroV to set the VM's kvmclock
+     *     so that it currently reads the provided value in nanoseconds.
+     *     The provided wall clock time is used to compute the wall
+     *     clock time at which the kvmclock read 0, which is reported to
+     *     each VS using MSR_KVM_WALL_CLOCK_NEW. The pvclock structure of
+     *     each VS is updated the next time the VS is run.
+     *
+     * <!-- inputs/outputs -->
+     *   @param hndl Set to the result of mv_handle_op_open_handle
+     *   @param vmid The ID of the VM to set
+     *   @param clock The value the kvmclock should read in nanoseconds
+     *   @param realtime The current wall clock time in nanoseconds since
+     *       the epoch, or 0 if unknown
+     *   @return Returns MV_STATUS_SUCCESS on success, MV_STATUS_FAILURE_UNKNOWN
+     *     and friends on failure.
+     */
+    NODISCARD static inline mv_status_t
+    mv_vm_op_clock_set(
+        uint64_t const hndl,
+        uint16_t const vmid,
+        uint64_t const clock,
+        uint64_t const realtime) NOEXCEPT
+    {
+#ifdef __cplusplus
+        bsl::expects(MV_INVALID_HANDLE != hndl);
+        bsl::expects(hndl > ((uint64_t)0));
+        bsl::expects((int32_t)MV_INVALID_ID != (int32_t)vmid);
+#else
+    platform_expects(MV_INVALID_HANDLE != hndl);
+    platform_expects(hndl > ((uint64_t)0));
+    platform_expects((int32_t)MV_INVALID_ID != (int32_t)vmid);
+#endif
+
+        return g_mut_mv_vm_op_clock_set;
+    }
+
     /* -------------------------------------------------------------------------- */
     /* mv_vp_ops                                                                  */
     /* -------------------------------------------------------------------------- */
@@ -552,8 +1066,16 @@ extern "C"
     extern struct mv_translation_t g_mut_mv_vs_op_gla_to_gpa;
     /** @brief stores the return value for mv_vs_op_run */
     extern enum mv_exit_reason_t g_mut_mv_vs_op_run;
+    /** @brief stores the return value for mv_vs_op_cpuid_set_list */
+    extern mv_status_t g_mut_mv_vs_op_cpuid_set_list;
     /** @brief stores the return value for mv_vs_op_run */
     extern struct mv_exit_io_t g_mut_mv_vs_op_run_io;
+    /** @brief stores the return value for mv_vs_op_run */
+    extern struct mv_exit_mmio_t g_mut_mv_vs_op_run_mmio;
+    /** @brief stores the return value for mv_vs_op_run */
+    extern struct mv_exit_msr_t g_mut_mv_vs_op_run_msr;
+    /** @brief stores the return value for mv_vs_op_run */
+    extern struct mv_exit_kick_t g_mut_mv_vs_op_run_kick;
     /** @brief stores the return value for mv_vs_op_reg_get */
     extern mv_status_t g_mut_mv_vs_op_reg_get;
     /** @brief stores the return value for mv_vs_op_reg_set */
@@ -574,6 +1096,14 @@ extern "C"
     extern mv_status_t g_mut_mv_vs_op_fpu_get_all;
     /** @brief stores the return value for mv_vs_op_fpu_set_all */
     extern mv_status_t g_mut_mv_vs_op_fpu_set_all;
+    /** @brief stores the return value for mv_vs_op_dirty_ring_get */
+    extern mv_status_t g_mut_mv_vs_op_dirty_ring_get;
+    /** @brief stores the return value for mv_vs_op_tsc_set_khz */
+    extern mv_status_t g_mut_mv_vs_op_tsc_set_khz;
+    /** @brief stores the return value for mv_vs_op_tsc_set_offset */
+    extern mv_status_t g_mut_mv_vs_op_tsc_set_offset;
+    /** @brief stores the number of entries in the dirty ring for mv_vs_op_dirty_ring_get */
+    extern uint64_t g_mut_mv_vs_op_dirty_ring_get_num_entries;
 
     /**
      * <!-- description -->
@@ -789,12 +1319,31 @@ extern "C"
 #endif
 
         switch ((int32_t)g_mut_mv_vs_op_run) {
+            case mv_exit_reason_t_hlt: {
+                g_mut_mv_vs_op_run = (enum mv_exit_reason_t)mv_exit_reason_t_failure;
+                return (enum mv_exit_reason_t)mv_exit_reason_t_hlt;
+            }
+
             case mv_exit_reason_t_io: {
                 struct mv_exit_io_t *const pmut_out = (struct mv_exit_io_t *)g_mut_shared_pages[0];
                 *pmut_out = g_mut_mv_vs_op_run_io;
                 break;
             }
 
+            case mv_exit_reason_t_mmio: {
+                struct mv_exit_mmio_t *const pmut_out = (struct mv_exit_mmio_t *)g_mut_shared_pages[0];
+                *pmut_out = g_mut_mv_vs_op_run_mmio;
+                g_mut_mv_vs_op_run = (enum mv_exit_reason_t)mv_exit_reason_t_failure;
+                return (enum mv_exit_reason_t)mv_exit_reason_t_mmio;
+            }
+
+            case mv_exit_reason_t_msr: {
+                struct mv_exit_msr_t *const pmut_out = (struct mv_exit_msr_t *)g_mut_shared_pages[0];
+                *pmut_out = g_mut_mv_vs_op_run_msr;
+                g_mut_mv_vs_op_run = (enum mv_exit_reason_t)mv_exit_reason_t_failure;
+                return (enum mv_exit_reason_t)mv_exit_reason_t_msr;
+            }
+
             case mv_exit_reason_t_interrupt: {
                 g_mut_mv_vs_op_run = (enum mv_exit_reason_t)mv_exit_reason_t_failure;
                 return (enum mv_exit_reason_t)mv_exit_reason_t_interrupt;
@@ -805,6 +1354,23 @@ extern "C"
                 return (enum mv_exit_reason_t)mv_exit_reason_t_nmi;
             }
 
+            case mv_exit_reason_t_dirty_ring_full: {
+                g_mut_mv_vs_op_run = (enum mv_exit_reason_t)mv_exit_reason_t_failure;
+                return (enum mv_exit_reason_t)mv_exit_reason_t_dirty_ring_full;
+            }
+
+            case mv_exit_reason_t_kick: {
+                struct mv_exit_kick_t *const pmut_out = (struct mv_exit_kick_t *)g_mut_shared_pages[0];
+                *pmut_out = g_mut_mv_vs_op_run_kick;
+                g_mut_mv_vs_op_run = (enum mv_exit_reason_t)mv_exit_reason_t_failure;
+                return (enum mv_exit_reason_t)mv_exit_reason_t_kick;
+            }
+
+            case mv_exit_reason_t_pause: {
+                g_mut_mv_vs_op_run = (enum mv_exit_reason_t)mv_exit_reason_t_failure;
+                return (enum mv_exit_reason_t)mv_exit_reason_t_pause;
+            }
+
             default: {
                 break;
             }
@@ -813,6 +1379,42 @@ extern "C"
         return g_mut_mv_vs_op_run;
     }
 
+    /**
+     * <!-- description -->
+     *   @brief This hypercall tells MicroV to set the CPUID leaves seen
+     *     by the VS using a CPUID Descriptor List (CDL) in the shared page.
+     *     The fun and idx fields of each mv_cdl_entry_t refer to the CPUID
+     *     leaf and the eax, ebx, ecx and edx fields refer to the values the
+     *     VS will see when it executes CPUID for that leaf. If the flags
+     *     field is set to mv_cpuid_flag_t_significant_index, the idx field
+     *     selects a subleaf, otherwise it is ignored. If reg0 in the
+     *     mv_cdl_t is 0, the CPUID leaves of the VS are cleared before the
+     *     entries are added, otherwise the entries are added to the
+     *     existing leaves, which allows more than MV_CDL_MAX_ENTRIES to be
+     *     set using more than one call.
+     *
+     * <!-- inputs/outputs -->
+     *   @param hndl Set to the result of mv_handle_op_open_handle
+     *   @param vsid The ID of the VS to set
+     *   @return Returns MV_STATUS_SUCCESS on success, MV_STATUS_FAILURE_UNKNOWN
+     *     and friends on failure.
+     */
+    NODISCARD static inline mv_status_t
+    mv_vs_op_cpuid_set_list(uint64_t const hndl, uint16_t const vsid) NOEXCEPT
+    {
+#ifdef __cplusplus
+        bsl::expects(MV_INVALID_HANDLE != hndl);
+        bsl::expects(hndl > ((uint64_t)0));
+        bsl::expects((int32_t)MV_INVALID_ID != (int32_t)vsid);
+#else
+    platform_expects(MV_INVALID_HANDLE != hndl);
+    platform_expects(hndl > ((uint64_t)0));
+    platform_expects((int32_t)MV_INVALID_ID != (int32_t)vsid);
+#endif
+
+        return g_mut_mv_vs_op_cpuid_set_list;
+    }
+
     /**
      * <!-- description -->
      *   @brief This hypercall tells MicroV to return the value of a requested
@@ -1207,6 +1809,116 @@ extern "C"
         return g_mut_mv_vs_op_fpu_set_all;
     }
 
+    /**
+     * <!-- description -->
+     *   @brief This hypercall tells MicroV to move entries from the dirty
+     *     ring of the provided VS into the mv_dirty_ring_t in the shared
+     *     page. On input, num_entries is the max number of entries to move.
+     *     On output, num_entries is the number of entries that were moved.
+     *     Entries are moved in the order that the pages were dirtied.
+     *
+     * <!-- inputs/outputs -->
+     *   @param hndl Set to the result of mv_handle_op_open_handle
+     *   @param vsid The ID of the VS to query
+     *   @return Returns MV_STATUS_SUCCESS on success, MV_STATUS_FAILURE_UNKNOWN
+     *     and friends on failure.
+     */
+    NODISCARD static inline mv_status_t
+    mv_vs_op_dirty_ring_get(uint64_t const hndl, uint16_t const vsid) NOEXCEPT
+    {
+#ifdef __cplusplus
+        bsl::expects(MV_INVALID_HANDLE != hndl);
+        bsl::expects(hndl > ((uint64_t)0));
+        bsl::expects((int32_t)MV_INVALID_ID != (int32_t)vsid);
+#else
+    platform_expects(MV_INVALID_HANDLE != hndl);
+    platform_expects(hndl > ((uint64_t)0));
+    platform_expects((int32_t)MV_INVALID_ID != (int32_t)vsid);
+#endif
+
+        struct mv_dirty_ring_t *const pmut_ring = (struct mv_dirty_ring_t *)g_mut_shared_pages[0];
+        uint64_t mut_i;
+
+        if (NULLPTR == pmut_ring) {
+            return g_mut_mv_vs_op_dirty_ring_get;
+        }
+
+        if (pmut_ring->num_entries > g_mut_mv_vs_op_dirty_ring_get_num_entries) {
+            pmut_ring->num_entries = g_mut_mv_vs_op_dirty_ring_get_num_entries;
+        }
+
+        g_mut_mv_vs_op_dirty_ring_get_num_entries -= pmut_ring->num_entries;
+        for (mut_i = ((uint64_t)0); mut_i < pmut_ring->num_entries; ++mut_i) {
+            pmut_ring->entries[mut_i].flags = MV_DIRTY_GFN_FLAG_DIRTY;
+            pmut_ring->entries[mut_i].slot = ((uint32_t)0);
+            pmut_ring->entries[mut_i].offset = mut_i;
+        }
+
+        return g_mut_mv_vs_op_dirty_ring_get;
+    }
+
+    /**
+     * <!-- description -->
+     *   @brief This hypercall tells MicroV to set the frequency of the
+     *     TSC seen by the VS. If the frequency does not match the
+     *     frequency of the PP the VS is assigned to, the TSC of the VS is
+     *     scaled, which requires TSC scaling support from the CPU. The
+     *     frequency is also reported to the VS using CPUID leaves 0x15
+     *     and 0x40000010.
+     *
+     * <!-- inputs/outputs -->
+     *   @param hndl Set to the result of mv_handle_op_open_handle
+     *   @param vsid The ID of the VS to set
+     *   @param khz The frequency of the TSC in KHz
+     *   @return Returns MV_STATUS_SUCCESS on success, MV_STATUS_FAILURE_UNKNOWN
+     *     and friends on failure.
+     */
+    NODISCARD static inline mv_status_t
+    mv_vs_op_tsc_set_khz(uint64_t const hndl, uint16_t const vsid, uint64_t const khz) NOEXCEPT
+    {
+#ifdef __cplusplus
+        bsl::expects(MV_INVALID_HANDLE != hndl);
+        bsl::expects(hndl > ((uint64_t)0));
+        bsl::expects((int32_t)MV_INVALID_ID != (int32_t)vsid);
+#else
+    platform_expects(MV_INVALID_HANDLE != hndl);
+    platform_expects(hndl > ((uint64_t)0));
+    platform_expects((int32_t)MV_INVALID_ID != (int32_t)vsid);
+#endif
+
+        return g_mut_mv_vs_op_tsc_set_khz;
+    }
+
+    /**
+     * <!-- description -->
+     *   @brief This hypercall tells MicroV to set the value that is
+     *     added to the (possibly scaled) TSC of the PP when the VS reads
+     *     its TSC.
+     *
+     * <!-- inputs/outputs -->
+     *   @param hndl Set to the result of mv_handle_op_open_handle
+     *   @param vsid The ID of the VS to set
+     *   @param offset The TSC offset to use
+     *   @return Returns MV_STATUS_SUCCESS on success, MV_STATUS_FAILURE_UNKNOWN
+     *     and friends on failure.
+     */
+    NODISCARD static inline mv_status_t
+    mv_vs_op_tsc_set_offset(
+        uint64_t const hndl, uint16_t const vsid, uint64_t const offset) NOEXCEPT
+    {
+#ifdef __cplusplus
+        bsl::expects(MV_INVALID_HANDLE != hndl);
+        bsl::expects(hndl > ((uint64_t)0));
+        bsl::expects((int32_t)MV_INVALID_ID != (int32_t)vsid);
+#else
+    platform_expects(MV_INVALID_HANDLE != hndl);
+    platform_expects(hndl > ((uint64_t)0));
+    platform_expects((int32_t)MV_INVALID_ID != (int32_t)vsid);
+#endif
+
+        return g_mut_mv_vs_op_tsc_set_offset;
+    }
+
 #ifdef __cplusplus
 }
 #endif
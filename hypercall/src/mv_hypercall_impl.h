@@ -128,6 +128,29 @@ extern "C"
     NODISCARD mv_status_t
     mv_pp_op_set_shared_page_gpa_impl(uint64_t const reg0_in, int64_t const reg1_in) NOEXCEPT;
 
+    /**
+     * <!-- description -->
+     *   @brief Implements the ABI for mv_pp_op_cpuid_get_supported_list.
+     *
+     * <!-- inputs/outputs -->
+     *   @param reg0_in n/a
+     *   @return n/a
+     */
+    NODISCARD mv_status_t
+    mv_pp_op_cpuid_get_supported_list_impl(uint64_t const reg0_in) NOEXCEPT;
+
+    /**
+     * <!-- description -->
+     *   @brief Implements the ABI for mv_pp_op_tsc_get_khz.
+     *
+     * <!-- inputs/outputs -->
+     *   @param reg0_in n/a
+     *   @param pmut_reg0_out n/a
+     *   @return n/a
+     */
+    NODISCARD mv_status_t
+    mv_pp_op_tsc_get_khz_impl(uint64_t const reg0_in, uint64_t *const pmut_reg0_out) NOEXCEPT;
+
     /* ---------------------------------------------------------------------- */
     /* mv_vm_ops                                                              */
     /* ---------------------------------------------------------------------- */
@@ -193,6 +216,172 @@ extern "C"
     NODISCARD mv_status_t
     mv_vm_op_mmio_unmap_impl(uint64_t const reg0_in, uint16_t const reg1_in) NOEXCEPT;
 
+    /**
+     * <!-- description -->
+     *   @brief Implements the ABI for mv_vm_op_dirty_log_enable.
+     *
+     * <!-- inputs/outputs -->
+     *   @param reg0_in n/a
+     *   @param reg1_in n/a
+     *   @param reg2_in n/a
+     *   @return n/a
+     */
+    NODISCARD mv_status_t mv_vm_op_dirty_log_enable_impl(
+        uint64_t const reg0_in, uint16_t const reg1_in, uint64_t const reg2_in) NOEXCEPT;
+
+    /**
+     * <!-- description -->
+     *   @brief Implements the ABI for mv_vm_op_dirty_log_disable.
+     *
+     * <!-- inputs/outputs -->
+     *   @param reg0_in n/a
+     *   @param reg1_in n/a
+     *   @param reg2_in n/a
+     *   @return n/a
+     */
+    NODISCARD mv_status_t mv_vm_op_dirty_log_disable_impl(
+        uint64_t const reg0_in, uint16_t const reg1_in, uint64_t const reg2_in) NOEXCEPT;
+
+    /**
+     * <!-- description -->
+     *   @brief Implements the ABI for mv_vm_op_dirty_log_get.
+     *
+     * <!-- inputs/outputs -->
+     *   @param reg0_in n/a
+     *   @param reg1_in n/a
+     *   @param reg2_in n/a
+     *   @param reg3_in n/a
+     *   @return n/a
+     */
+    NODISCARD mv_status_t mv_vm_op_dirty_log_get_impl(
+        uint64_t const reg0_in,
+        uint16_t const reg1_in,
+        uint64_t const reg2_in,
+        uint64_t const reg3_in) NOEXCEPT;
+
+    /**
+     * <!-- description -->
+     *   @brief Implements the ABI for mv_vm_op_dirty_log_clear.
+     *
+     * <!-- inputs/outputs -->
+     *   @param reg0_in n/a
+     *   @param reg1_in n/a
+     *   @param reg2_in n/a
+     *   @param reg3_in n/a
+     *   @return n/a
+     */
+    NODISCARD mv_status_t mv_vm_op_dirty_log_clear_impl(
+        uint64_t const reg0_in,
+        uint16_t const reg1_in,
+        uint64_t const reg2_in,
+        uint64_t const reg3_in) NOEXCEPT;
+
+    /**
+     * <!-- description -->
+     *   @brief Implements the ABI for mv_vm_op_dirty_ring_reset.
+     *
+     * <!-- inputs/outputs -->
+     *   @param reg0_in n/a
+     *   @param reg1_in n/a
+     *   @return n/a
+     */
+    NODISCARD mv_status_t
+    mv_vm_op_dirty_ring_reset_impl(uint64_t const reg0_in, uint16_t const reg1_in) NOEXCEPT;
+
+    /**
+     * <!-- description -->
+     *   @brief Implements the ABI for mv_vm_op_fork_vm.
+     *
+     * <!-- inputs/outputs -->
+     *   @param reg0_in n/a
+     *   @param reg1_in n/a
+     *   @param pmut_reg0_out n/a
+     *   @return n/a
+     */
+    NODISCARD mv_status_t mv_vm_op_fork_vm_impl(
+        uint64_t const reg0_in, uint16_t const reg1_in, uint16_t *const pmut_reg0_out) NOEXCEPT;
+
+    /**
+     * <!-- description -->
+     *   @brief Implements the ABI for mv_vm_op_msr_intercept.
+     *
+     * <!-- inputs/outputs -->
+     *   @param reg0_in n/a
+     *   @param reg1_in n/a
+     *   @param reg2_in n/a
+     *   @param reg3_in n/a
+     *   @return n/a
+     */
+    NODISCARD mv_status_t mv_vm_op_msr_intercept_impl(
+        uint64_t const reg0_in,
+        uint16_t const reg1_in,
+        uint32_t const reg2_in,
+        uint64_t const reg3_in) NOEXCEPT;
+
+    /**
+     * <!-- description -->
+     *   @brief Implements the ABI for mv_vm_op_io_intercept.
+     *
+     * <!-- inputs/outputs -->
+     *   @param reg0_in n/a
+     *   @param reg1_in n/a
+     *   @param reg2_in n/a
+     *   @param reg3_in n/a
+     *   @return n/a
+     */
+    NODISCARD mv_status_t mv_vm_op_io_intercept_impl(
+        uint64_t const reg0_in,
+        uint16_t const reg1_in,
+        uint64_t const reg2_in,
+        uint64_t const reg3_in) NOEXCEPT;
+
+    /**
+     * <!-- description -->
+     *   @brief Implements the ABI for mv_vm_op_msr_filter.
+     *
+     * <!-- inputs/outputs -->
+     *   @param reg0_in n/a
+     *   @param reg1_in n/a
+     *   @param reg2_in n/a
+     *   @param reg3_in n/a
+     *   @return n/a
+     */
+    NODISCARD mv_status_t mv_vm_op_msr_filter_impl(
+        uint64_t const reg0_in,
+        uint16_t const reg1_in,
+        uint64_t const reg2_in,
+        uint64_t const reg3_in) NOEXCEPT;
+
+    /**
+     * <!-- description -->
+     *   @brief Implements the ABI for mv_vm_op_clock_get.
+     *
+     * <!-- inputs/outputs -->
+     *   @param reg0_in n/a
+     *   @param reg1_in n/a
+     *   @param pmut_reg0_out n/a
+     *   @return n/a
+     */
+    NODISCARD mv_status_t mv_vm_op_clock_get_impl(
+        uint64_t const reg0_in, uint16_t const reg1_in, uint64_t *const pmut_reg0_out) NOEXCEPT;
+
+    /**
+     * <!-- description -->
+     *   @brief Implements the ABI for mv_vm_op_clock_set.
+     *
+     * <!-- inputs/outputs -->
+     *   @param reg0_in n/a
+     *   @param reg1_in n/a
+     *   @param reg2_in n/a
+     *   @param reg3_in n/a
+     *   @return n/a
+     */
+    NODISCARD mv_status_t mv_vm_op_clock_set_impl(
+        uint64_t const reg0_in,
+        uint16_t const reg1_in,
+        uint64_t const reg2_in,
+        uint64_t const reg3_in) NOEXCEPT;
+
     /* ---------------------------------------------------------------------- */
     /* mv_vp_ops                                                              */
     /* ---------------------------------------------------------------------- */
@@ -346,6 +535,18 @@ extern "C"
         uint16_t const reg1_in,
         enum mv_exit_reason_t *const pmut_reg0_out) NOEXCEPT;
 
+    /**
+     * <!-- description -->
+     *   @brief Implements the ABI for mv_vs_op_cpuid_set_list.
+     *
+     * <!-- inputs/outputs -->
+     *   @param reg0_in n/a
+     *   @param reg1_in n/a
+     *   @return n/a
+     */
+    NODISCARD mv_status_t
+    mv_vs_op_cpuid_set_list_impl(uint64_t const reg0_in, uint16_t const reg1_in) NOEXCEPT;
+
     /**
      * <!-- description -->
      *   @brief Implements the ABI for mv_vs_op_reg_get.
@@ -486,6 +687,44 @@ extern "C"
     NODISCARD mv_status_t
     mv_vs_op_fpu_set_all_impl(uint64_t const reg0_in, uint16_t const reg1_in) NOEXCEPT;
 
+    /**
+     * <!-- description -->
+     *   @brief Implements the ABI for mv_vs_op_dirty_ring_get.
+     *
+     * <!-- inputs/outputs -->
+     *   @param reg0_in n/a
+     *   @param reg1_in n/a
+     *   @return n/a
+     */
+    NODISCARD mv_status_t
+    mv_vs_op_dirty_ring_get_impl(uint64_t const reg0_in, uint16_t const reg1_in) NOEXCEPT;
+
+    /**
+     * <!-- description -->
+     *   @brief Implements the ABI for mv_vs_op_tsc_set_khz.
+     *
+     * <!-- inputs/outputs -->
+     *   @param reg0_in n/a
+     *   @param reg1_in n/a
+     *   @param reg2_in n/a
+     *   @return n/a
+     */
+    NODISCARD mv_status_t mv_vs_op_tsc_set_khz_impl(
+        uint64_t const reg0_in, uint16_t const reg1_in, uint64_t const reg2_in) NOEXCEPT;
+
+    /**
+     * <!-- description -->
+     *   @brief Implements the ABI for mv_vs_op_tsc_set_offset.
+     *
+     * <!-- inputs/outputs -->
+     *   @param reg0_in n/a
+     *   @param reg1_in n/a
+     *   @param reg2_in n/a
+     *   @return n/a
+     */
+    NODISCARD mv_status_t mv_vs_op_tsc_set_offset_impl(
+        uint64_t const reg0_in, uint16_t const reg1_in, uint64_t const reg2_in) NOEXCEPT;
+
 #ifdef __cplusplus
 }
 #endif
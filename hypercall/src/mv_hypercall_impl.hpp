@@ -126,6 +126,29 @@ namespace hypercall
     mv_pp_op_set_shared_page_gpa_impl(bsl::uint64 const reg0_in, bsl::uint64 const reg1_in) noexcept
         -> mv_status_t::value_type;
 
+    /// <!-- description -->
+    ///   @brief Implements the ABI for mv_pp_op_cpuid_get_supported_list.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param reg0_in n/a
+    ///   @return n/a
+    ///
+    extern "C" [[nodiscard]] auto
+    mv_pp_op_cpuid_get_supported_list_impl(bsl::uint64 const reg0_in) noexcept
+        -> mv_status_t::value_type;
+
+    /// <!-- description -->
+    ///   @brief Implements the ABI for mv_pp_op_tsc_get_khz.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param reg0_in n/a
+    ///   @param pmut_reg0_out n/a
+    ///   @return n/a
+    ///
+    extern "C" [[nodiscard]] auto
+    mv_pp_op_tsc_get_khz_impl(bsl::uint64 const reg0_in, bsl::uint64 *const pmut_reg0_out) noexcept
+        -> mv_status_t::value_type;
+
     // -------------------------------------------------------------------------
     // mv_vm_ops
     // -------------------------------------------------------------------------
@@ -191,6 +214,168 @@ namespace hypercall
     mv_vm_op_mmio_unmap_impl(bsl::uint64 const reg0_in, bsl::uint16 const reg1_in) noexcept
         -> mv_status_t::value_type;
 
+    /// <!-- description -->
+    ///   @brief Implements the ABI for mv_vm_op_dirty_log_enable.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param reg0_in n/a
+    ///   @param reg1_in n/a
+    ///   @param reg2_in n/a
+    ///   @return n/a
+    ///
+    extern "C" [[nodiscard]] auto mv_vm_op_dirty_log_enable_impl(
+        bsl::uint64 const reg0_in, bsl::uint16 const reg1_in, bsl::uint64 const reg2_in) noexcept
+        -> mv_status_t::value_type;
+
+    /// <!-- description -->
+    ///   @brief Implements the ABI for mv_vm_op_dirty_log_disable.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param reg0_in n/a
+    ///   @param reg1_in n/a
+    ///   @param reg2_in n/a
+    ///   @return n/a
+    ///
+    extern "C" [[nodiscard]] auto mv_vm_op_dirty_log_disable_impl(
+        bsl::uint64 const reg0_in, bsl::uint16 const reg1_in, bsl::uint64 const reg2_in) noexcept
+        -> mv_status_t::value_type;
+
+    /// <!-- description -->
+    ///   @brief Implements the ABI for mv_vm_op_dirty_log_get.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param reg0_in n/a
+    ///   @param reg1_in n/a
+    ///   @param reg2_in n/a
+    ///   @param reg3_in n/a
+    ///   @return n/a
+    ///
+    extern "C" [[nodiscard]] auto mv_vm_op_dirty_log_get_impl(
+        bsl::uint64 const reg0_in,
+        bsl::uint16 const reg1_in,
+        bsl::uint64 const reg2_in,
+        bsl::uint64 const reg3_in) noexcept -> mv_status_t::value_type;
+
+    /// <!-- description -->
+    ///   @brief Implements the ABI for mv_vm_op_dirty_log_clear.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param reg0_in n/a
+    ///   @param reg1_in n/a
+    ///   @param reg2_in n/a
+    ///   @param reg3_in n/a
+    ///   @return n/a
+    ///
+    extern "C" [[nodiscard]] auto mv_vm_op_dirty_log_clear_impl(
+        bsl::uint64 const reg0_in,
+        bsl::uint16 const reg1_in,
+        bsl::uint64 const reg2_in,
+        bsl::uint64 const reg3_in) noexcept -> mv_status_t::value_type;
+
+    /// <!-- description -->
+    ///   @brief Implements the ABI for mv_vm_op_dirty_ring_reset.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param reg0_in n/a
+    ///   @param reg1_in n/a
+    ///   @return n/a
+    ///
+    extern "C" [[nodiscard]] auto
+    mv_vm_op_dirty_ring_reset_impl(bsl::uint64 const reg0_in, bsl::uint16 const reg1_in) noexcept
+        -> mv_status_t::value_type;
+
+    /// <!-- description -->
+    ///   @brief Implements the ABI for mv_vm_op_fork_vm.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param reg0_in n/a
+    ///   @param reg1_in n/a
+    ///   @param pmut_reg0_out n/a
+    ///   @return n/a
+    ///
+    extern "C" [[nodiscard]] auto mv_vm_op_fork_vm_impl(
+        bsl::uint64 const reg0_in,
+        bsl::uint16 const reg1_in,
+        bsl::uint16 *const pmut_reg0_out) noexcept -> mv_status_t::value_type;
+
+    /// <!-- description -->
+    ///   @brief Implements the ABI for mv_vm_op_msr_intercept.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param reg0_in n/a
+    ///   @param reg1_in n/a
+    ///   @param reg2_in n/a
+    ///   @param reg3_in n/a
+    ///   @return n/a
+    ///
+    extern "C" [[nodiscard]] auto mv_vm_op_msr_intercept_impl(
+        bsl::uint64 const reg0_in,
+        bsl::uint16 const reg1_in,
+        bsl::uint32 const reg2_in,
+        bsl::uint64 const reg3_in) noexcept -> mv_status_t::value_type;
+
+    /// <!-- description -->
+    ///   @brief Implements the ABI for mv_vm_op_io_intercept.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param reg0_in n/a
+    ///   @param reg1_in n/a
+    ///   @param reg2_in n/a
+    ///   @param reg3_in n/a
+    ///   @return n/a
+    ///
+    extern "C" [[nodiscard]] auto mv_vm_op_io_intercept_impl(
+        bsl::uint64 const reg0_in,
+        bsl::uint16 const reg1_in,
+        bsl::uint64 const reg2_in,
+        bsl::uint64 const reg3_in) noexcept -> mv_status_t::value_type;
+
+    /// <!-- description -->
+    ///   @brief Implements the ABI for mv_vm_op_msr_filter.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param reg0_in n/a
+    ///   @param reg1_in n/a
+    ///   @param reg2_in n/a
+    ///   @param reg3_in n/a
+    ///   @return n/a
+    ///
+    extern "C" [[nodiscard]] auto mv_vm_op_msr_filter_impl(
+        bsl::uint64 const reg0_in,
+        bsl::uint16 const reg1_in,
+        bsl::uint64 const reg2_in,
+        bsl::uint64 const reg3_in) noexcept -> mv_status_t::value_type;
+
+    /// <!-- description -->
+    ///   @brief Implements the ABI for mv_vm_op_clock_get.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param reg0_in n/a
+    ///   @param reg1_in n/a
+    ///   @param pmut_reg0_out n/a
+    ///   @return n/a
+    ///
+    extern "C" [[nodiscard]] auto mv_vm_op_clock_get_impl(
+        bsl::uint64 const reg0_in,
+        bsl::uint16 const reg1_in,
+        bsl::uint64 *const pmut_reg0_out) noexcept -> mv_status_t::value_type;
+
+    /// <!-- description -->
+    ///   @brief Implements the ABI for mv_vm_op_clock_set.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param reg0_in n/a
+    ///   @param reg1_in n/a
+    ///   @param reg2_in n/a
+    ///   @param reg3_in n/a
+    ///   @return n/a
+    ///
+    extern "C" [[nodiscard]] auto mv_vm_op_clock_set_impl(
+        bsl::uint64 const reg0_in,
+        bsl::uint16 const reg1_in,
+        bsl::uint64 const reg2_in,
+        bsl::uint64 const reg3_in) noexcept -> mv_status_t::value_type;
+
     // -------------------------------------------------------------------------
     // mv_vp_ops
     // -------------------------------------------------------------------------
@@ -347,6 +532,18 @@ namespace hypercall
         bsl::uint16 const reg1_in,
         mv_exit_reason_t *const pmut_reg0_out) noexcept -> mv_status_t::value_type;
 
+    /// <!-- description -->
+    ///   @brief Implements the ABI for mv_vs_op_cpuid_set_list.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param reg0_in n/a
+    ///   @param reg1_in n/a
+    ///   @return n/a
+    ///
+    extern "C" [[nodiscard]] auto
+    mv_vs_op_cpuid_set_list_impl(bsl::uint64 const reg0_in, bsl::uint16 const reg1_in) noexcept
+        -> mv_status_t::value_type;
+
     /// <!-- description -->
     ///   @brief Implements the ABI for mv_vs_op_reg_get.
     ///
@@ -482,6 +679,44 @@ namespace hypercall
     extern "C" [[nodiscard]] auto
     mv_vs_op_fpu_set_all_impl(bsl::uint64 const reg0_in, bsl::uint16 const reg1_in) noexcept
         -> mv_status_t::value_type;
+
+    /// <!-- description -->
+    ///   @brief Implements the ABI for mv_vs_op_dirty_ring_get.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param reg0_in n/a
+    ///   @param reg1_in n/a
+    ///   @return n/a
+    ///
+    extern "C" [[nodiscard]] auto
+    mv_vs_op_dirty_ring_get_impl(bsl::uint64 const reg0_in, bsl::uint16 const reg1_in) noexcept
+        -> mv_status_t::value_type;
+
+    /// <!-- description -->
+    ///   @brief Implements the ABI for mv_vs_op_tsc_set_khz.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param reg0_in n/a
+    ///   @param reg1_in n/a
+    ///   @param reg2_in n/a
+    ///   @return n/a
+    ///
+    extern "C" [[nodiscard]] auto mv_vs_op_tsc_set_khz_impl(
+        bsl::uint64 const reg0_in, bsl::uint16 const reg1_in, bsl::uint64 const reg2_in) noexcept
+        -> mv_status_t::value_type;
+
+    /// <!-- description -->
+    ///   @brief Implements the ABI for mv_vs_op_tsc_set_offset.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param reg0_in n/a
+    ///   @param reg1_in n/a
+    ///   @param reg2_in n/a
+    ///   @return n/a
+    ///
+    extern "C" [[nodiscard]] auto mv_vs_op_tsc_set_offset_impl(
+        bsl::uint64 const reg0_in, bsl::uint16 const reg1_in, bsl::uint64 const reg2_in) noexcept
+        -> mv_status_t::value_type;
 }
 
 #endif
@@ -230,6 +230,63 @@ namespace hypercall
             return bsl::errc_success;
         }
 
+        /// <!-- description -->
+        ///   @brief Given the shared page cast as a mv_cdl_t, with each
+        ///     entry's fun and idx fields set to the requested CPUID leaf, the
+        ///     same entries are returned in the shared page with the eax, ebx,
+        ///     ecx and edx fields set with all supported CPU features set to 1.
+        ///     If num_entries is 0, the shared page is instead filled with every
+        ///     CPUID leaf that MicroV supports, and num_entries is set to the
+        ///     number of entries that were returned.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @return Returns MV_STATUS_SUCCESS on success, MV_STATUS_FAILURE_UNKNOWN
+        ///     and friends on failure.
+        ///
+        [[nodiscard]] constexpr auto
+        mv_pp_op_cpuid_get_supported_list() noexcept -> bsl::errc_type
+        {
+            mv_status_t const ret{mv_pp_op_cpuid_get_supported_list_impl(m_hndl.get())};
+            if (bsl::unlikely(ret != MV_STATUS_SUCCESS)) {
+                bsl::error() << "mv_pp_op_cpuid_get_supported_list failed with status "    // --
+                             << bsl::hex(ret)                                              // --
+                             << bsl::endl                                                  // --
+                             << bsl::here();                                               // --
+
+                return bsl::errc_failure;
+            }
+
+            return bsl::errc_success;
+        }
+
+        /// <!-- description -->
+        ///   @brief This hypercall returns the frequency of the PP's TSC in
+        ///     KHz. The frequency is measured once by MicroV when the PP is
+        ///     started, so calling this hypercall does not require MicroV to
+        ///     query the hardware.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @return Returns the frequency of the PP's TSC in KHz on success,
+        ///     or bsl::safe_u64::failure() on failure.
+        ///
+        [[nodiscard]] constexpr auto
+        mv_pp_op_tsc_get_khz() noexcept -> bsl::safe_u64
+        {
+            bsl::safe_u64 mut_freq;
+
+            mv_status_t const ret{mv_pp_op_tsc_get_khz_impl(m_hndl.get(), mut_freq.data())};
+            if (bsl::unlikely(ret != MV_STATUS_SUCCESS)) {
+                bsl::error() << "mv_pp_op_tsc_get_khz failed with status "    // --
+                             << bsl::hex(ret)                                 // --
+                             << bsl::endl                                     // --
+                             << bsl::here();                                  // --
+
+                return bsl::safe_u64::failure();
+            }
+
+            return mut_freq;
+        }
+
         // ---------------------------------------------------------------------
         // mv_vm_ops
         // ---------------------------------------------------------------------
@@ -449,6 +506,451 @@ namespace hypercall
             return bsl::errc_success;
         }
 
+        /// <!-- description -->
+        ///   @brief This hypercall tells MicroV to start logging writes to a
+        ///     region of guest physical memory that was previously mapped into a
+        ///     VM using mv_vm_op_mmio_map. For this ABI, the shared page must
+        ///     contain an mv_mdl_t with a single entry. The dst field of this
+        ///     entry refers to the GPA of the region and the bytes field refers
+        ///     to the size of the region, which must be page aligned. The src
+        ///     and flags fields are ignored. Each page in the region is write
+        ///     protected, and the first write to a page marks it as dirty in
+        ///     the dirty log of the slot and restores write access to it.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param vmid The ID of the VM to enable dirty logging for
+        ///   @param slot The slot to store the dirty log of the region in
+        ///   @return Returns MV_STATUS_SUCCESS on success, MV_STATUS_FAILURE_UNKNOWN
+        ///     and friends on failure.
+        ///
+        [[nodiscard]] constexpr auto
+        mv_vm_op_dirty_log_enable(
+            bsl::safe_u16 const &vmid, bsl::safe_u64 const &slot) noexcept -> bsl::errc_type
+        {
+            bsl::expects(vmid.is_valid_and_checked());
+            bsl::expects(vmid != MV_INVALID_ID);
+            bsl::expects(slot.is_valid_and_checked());
+
+            mv_status_t const ret{
+                mv_vm_op_dirty_log_enable_impl(m_hndl.get(), vmid.get(), slot.get())};
+            if (bsl::unlikely(ret != MV_STATUS_SUCCESS)) {
+                bsl::error() << "mv_vm_op_dirty_log_enable failed with status "    // --
+                             << bsl::hex(ret)                                      // --
+                             << bsl::endl                                          // --
+                             << bsl::here();                                       // --
+
+                return bsl::errc_failure;
+            }
+
+            return bsl::errc_success;
+        }
+
+        /// <!-- description -->
+        ///   @brief This hypercall tells MicroV to stop logging writes to the
+        ///     region of guest physical memory associated with the provided slot
+        ///     and to release the dirty log of the slot. Write access is restored
+        ///     to any page in the region that is still write protected.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param vmid The ID of the VM to disable dirty logging for
+        ///   @param slot The slot to disable dirty logging for
+        ///   @return Returns MV_STATUS_SUCCESS on success, MV_STATUS_FAILURE_UNKNOWN
+        ///     and friends on failure.
+        ///
+        [[nodiscard]] constexpr auto
+        mv_vm_op_dirty_log_disable(
+            bsl::safe_u16 const &vmid, bsl::safe_u64 const &slot) noexcept -> bsl::errc_type
+        {
+            bsl::expects(vmid.is_valid_and_checked());
+            bsl::expects(vmid != MV_INVALID_ID);
+            bsl::expects(slot.is_valid_and_checked());
+
+            mv_status_t const ret{
+                mv_vm_op_dirty_log_disable_impl(m_hndl.get(), vmid.get(), slot.get())};
+            if (bsl::unlikely(ret != MV_STATUS_SUCCESS)) {
+                bsl::error() << "mv_vm_op_dirty_log_disable failed with status "    // --
+                             << bsl::hex(ret)                                       // --
+                             << bsl::endl                                           // --
+                             << bsl::here();                                        // --
+
+                return bsl::errc_failure;
+            }
+
+            return bsl::errc_success;
+        }
+
+        /// <!-- description -->
+        ///   @brief This hypercall tells MicroV to copy the dirty log of the
+        ///     provided slot into an mv_dirty_bitmap_t in the shared page. The
+        ///     first bit in the mv_dirty_bitmap_t refers to first_page, and each
+        ///     call returns at most MV_DIRTY_BITMAP_MAX_PAGES pages. first_page
+        ///     must be a multiple of 64. Bits past the end of the slot are 0. The
+        ///     dirty log itself is not modified (see mv_vm_op_dirty_log_clear).
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param vmid The ID of the VM to query
+        ///   @param slot The slot to query
+        ///   @param first_page The index of the first page in the slot to query
+        ///   @return Returns MV_STATUS_SUCCESS on success, MV_STATUS_FAILURE_UNKNOWN
+        ///     and friends on failure.
+        ///
+        [[nodiscard]] constexpr auto
+        mv_vm_op_dirty_log_get(
+            bsl::safe_u16 const &vmid,
+            bsl::safe_u64 const &slot,
+            bsl::safe_u64 const &first_page) noexcept -> bsl::errc_type
+        {
+            bsl::expects(vmid.is_valid_and_checked());
+            bsl::expects(vmid != MV_INVALID_ID);
+            bsl::expects(slot.is_valid_and_checked());
+            bsl::expects(first_page.is_valid_and_checked());
+
+            mv_status_t const ret{mv_vm_op_dirty_log_get_impl(
+                m_hndl.get(), vmid.get(), slot.get(), first_page.get())};
+            if (bsl::unlikely(ret != MV_STATUS_SUCCESS)) {
+                bsl::error() << "mv_vm_op_dirty_log_get failed with status "    // --
+                             << bsl::hex(ret)                                   // --
+                             << bsl::endl                                       // --
+                             << bsl::here();                                    // --
+
+                return bsl::errc_failure;
+            }
+
+            return bsl::errc_success;
+        }
+
+        /// <!-- description -->
+        ///   @brief This hypercall tells MicroV to clear the pages described
+        ///     by the mv_dirty_bitmap_t in the shared page from the dirty log of
+        ///     the provided slot. The first bit in the mv_dirty_bitmap_t refers
+        ///     to first_page, which must be a multiple of 64. Only pages that are
+        ///     both set in the mv_dirty_bitmap_t and dirty are write protected
+        ///     again, and the TLB is flushed once if any pages were cleared.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param vmid The ID of the VM to modify
+        ///   @param slot The slot to modify
+        ///   @param first_page The index of the first page in the slot to clear
+        ///   @return Returns MV_STATUS_SUCCESS on success, MV_STATUS_FAILURE_UNKNOWN
+        ///     and friends on failure.
+        ///
+        [[nodiscard]] constexpr auto
+        mv_vm_op_dirty_log_clear(
+            bsl::safe_u16 const &vmid,
+            bsl::safe_u64 const &slot,
+            bsl::safe_u64 const &first_page) noexcept -> bsl::errc_type
+        {
+            bsl::expects(vmid.is_valid_and_checked());
+            bsl::expects(vmid != MV_INVALID_ID);
+            bsl::expects(slot.is_valid_and_checked());
+            bsl::expects(first_page.is_valid_and_checked());
+
+            mv_status_t const ret{mv_vm_op_dirty_log_clear_impl(
+                m_hndl.get(), vmid.get(), slot.get(), first_page.get())};
+            if (bsl::unlikely(ret != MV_STATUS_SUCCESS)) {
+                bsl::error() << "mv_vm_op_dirty_log_clear failed with status "    // --
+                             << bsl::hex(ret)                                     // --
+                             << bsl::endl                                         // --
+                             << bsl::here();                                      // --
+
+                return bsl::errc_failure;
+            }
+
+            return bsl::errc_success;
+        }
+
+        /// <!-- description -->
+        ///   @brief This hypercall tells MicroV to clear the pages described
+        ///     by the mv_dirty_ring_t in the shared page from the dirty log of
+        ///     the VM. These are the entries that software harvested from the
+        ///     dirty rings of the VM's VSs. Each page that was dirty is write
+        ///     protected again, and the TLB is flushed once if any pages were
+        ///     cleared.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param vmid The ID of the VM to modify
+        ///   @return Returns MV_STATUS_SUCCESS on success, MV_STATUS_FAILURE_UNKNOWN
+        ///     and friends on failure.
+        ///
+        [[nodiscard]] constexpr auto
+        mv_vm_op_dirty_ring_reset(bsl::safe_u16 const &vmid) noexcept -> bsl::errc_type
+        {
+            bsl::expects(vmid.is_valid_and_checked());
+            bsl::expects(vmid != MV_INVALID_ID);
+
+            mv_status_t const ret{mv_vm_op_dirty_ring_reset_impl(m_hndl.get(), vmid.get())};
+            if (bsl::unlikely(ret != MV_STATUS_SUCCESS)) {
+                bsl::error() << "mv_vm_op_dirty_ring_reset failed with status "    // --
+                             << bsl::hex(ret)                                      // --
+                             << bsl::endl                                          // --
+                             << bsl::here();                                       // --
+
+                return bsl::errc_failure;
+            }
+
+            return bsl::errc_success;
+        }
+
+        /// <!-- description -->
+        ///   @brief This hypercall tells MicroV to create a VM that is a
+        ///     copy-on-write fork of the provided parent VM. For this ABI, the
+        ///     shared page must contain an mv_mdl_t whose entries describe the
+        ///     ranges of guest physical memory to share. The dst and bytes
+        ///     fields of each entry refer to the GPA and size of a range, and
+        ///     the src and flags fields are ignored. Each page in these ranges
+        ///     that is mapped into the parent VM is mapped into the new VM at
+        ///     the same GPA as read/execute only, and the first write to any of
+        ///     these pages is returned to the root VM as an MMIO exit so that
+        ///     it can map a private copy of the page in its place. The parent
+        ///     VM must not run while it has children. Upon success, this
+        ///     hypercall returns the ID of the newly created VM.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param parent_vmid The ID of the VM to fork
+        ///   @return Returns the resulting ID, or bsl::safe_u16::failure()
+        ///     on failure.
+        ///
+        [[nodiscard]] constexpr auto
+        mv_vm_op_fork_vm(bsl::safe_u16 const &parent_vmid) noexcept -> bsl::safe_u16
+        {
+            bsl::expects(parent_vmid.is_valid_and_checked());
+            bsl::expects(parent_vmid != MV_INVALID_ID);
+
+            bsl::safe_u16 mut_vmid{};
+
+            mv_status_t const ret{
+                mv_vm_op_fork_vm_impl(m_hndl.get(), parent_vmid.get(), mut_vmid.data())};
+            if (bsl::unlikely(ret != MV_STATUS_SUCCESS)) {
+                bsl::error() << "mv_vm_op_fork_vm failed with status "    // --
+                             << bsl::hex(ret)                             // --
+                             << bsl::endl                                 // --
+                             << bsl::here();                              // --
+
+                return bsl::safe_u16::failure();
+            }
+
+            if (bsl::unlikely(mut_vmid == MV_INVALID_ID)) {
+                bsl::error() << "the VMID "                                   // --
+                             << bsl::hex(mut_vmid)                            // --
+                             << " returned by mv_vm_op_fork_vm is invalid"    // --
+                             << bsl::endl                                     // --
+                             << bsl::here();                                  // --
+
+                return bsl::safe_u16::failure();
+            }
+
+            if (bsl::unlikely(bsl::to_umx(mut_vmid) >= HYPERVISOR_MAX_VMS)) {
+                bsl::error() << "the VMID "                                        // --
+                             << bsl::hex(mut_vmid)                                 // --
+                             << " returned by mv_vm_op_fork_vm is out of range"    // --
+                             << bsl::endl                                          // --
+                             << bsl::here();                                       // --
+
+                return bsl::safe_u16::failure();
+            }
+
+            return mut_vmid;
+        }
+
+        /// <!-- description -->
+        ///   @brief This hypercall tells MicroV to intercept the provided
+        ///     accesses to the provided MSR for every VS assigned to the
+        ///     provided VM and to pass through the rest. Accesses are
+        ///     described using MV_PERM_READ and MV_PERM_WRITE. Only MSRs that
+        ///     are context switched with the VS can be passed through, and
+        ///     by default, every other MSR is intercepted.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param vmid The ID of the VM to modify
+        ///   @param msr The MSR to modify
+        ///   @param perms The accesses to intercept
+        ///   @return Returns MV_STATUS_SUCCESS on success, MV_STATUS_FAILURE_UNKNOWN
+        ///     and friends on failure.
+        ///
+        [[nodiscard]] constexpr auto
+        mv_vm_op_msr_intercept(
+            bsl::safe_u16 const &vmid,
+            bsl::safe_u32 const &msr,
+            bsl::safe_u64 const &perms) noexcept -> bsl::errc_type
+        {
+            bsl::expects(vmid.is_valid_and_checked());
+            bsl::expects(vmid != MV_INVALID_ID);
+            bsl::expects(msr.is_valid_and_checked());
+            bsl::expects(perms.is_valid_and_checked());
+
+            mv_status_t const ret{
+                mv_vm_op_msr_intercept_impl(m_hndl.get(), vmid.get(), msr.get(), perms.get())};
+            if (bsl::unlikely(ret != MV_STATUS_SUCCESS)) {
+                bsl::error() << "mv_vm_op_msr_intercept failed with status "    // --
+                             << bsl::hex(ret)                                   // --
+                             << bsl::endl                                       // --
+                             << bsl::here();                                    // --
+
+                return bsl::errc_failure;
+            }
+
+            return bsl::errc_success;
+        }
+
+        /// <!-- description -->
+        ///   @brief This hypercall tells MicroV how to handle accesses to a
+        ///     range of ports for every VS assigned to the provided VM. Bits
+        ///     15:0 of ports contain the first port of the range and bits
+        ///     31:16 contain the last port of the range (inclusive). The
+        ///     remaining bits are reserved and must be 0. The type is one of
+        ///     the MV_IO_INTERCEPT_xxx values. By default, every port exits
+        ///     except for the POST code port (0x80), which is ignored, and
+        ///     only the POST code port can be passed through.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param vmid The ID of the VM to modify
+        ///   @param ports The range of ports to modify
+        ///   @param type The MV_IO_INTERCEPT_xxx type to use
+        ///   @return Returns MV_STATUS_SUCCESS on success, MV_STATUS_FAILURE_UNKNOWN
+        ///     and friends on failure.
+        ///
+        [[nodiscard]] constexpr auto
+        mv_vm_op_io_intercept(
+            bsl::safe_u16 const &vmid,
+            bsl::safe_u64 const &ports,
+            bsl::safe_u64 const &type) noexcept -> bsl::errc_type
+        {
+            bsl::expects(vmid.is_valid_and_checked());
+            bsl::expects(vmid != MV_INVALID_ID);
+            bsl::expects(ports.is_valid_and_checked());
+            bsl::expects(type.is_valid_and_checked());
+
+            mv_status_t const ret{
+                mv_vm_op_io_intercept_impl(m_hndl.get(), vmid.get(), ports.get(), type.get())};
+            if (bsl::unlikely(ret != MV_STATUS_SUCCESS)) {
+                bsl::error() << "mv_vm_op_io_intercept failed with status "    // --
+                             << bsl::hex(ret)                                  // --
+                             << bsl::endl                                      // --
+                             << bsl::here();                                   // --
+
+                return bsl::errc_failure;
+            }
+
+            return bsl::errc_success;
+        }
+
+        /// <!-- description -->
+        ///   @brief This hypercall tells MicroV to return the provided
+        ///     accesses to a range of MSRs to software for every VS assigned
+        ///     to the provided VM. Bits 31:0 of msrs contain the first MSR of
+        ///     the range and bits 63:32 contain the last MSR of the range
+        ///     (inclusive). Accesses are described using MV_PERM_READ and
+        ///     MV_PERM_WRITE, and accesses that are not provided are removed
+        ///     from the filter. Filtered accesses return mv_exit_reason_t_msr
+        ///     from mv_vs_op_run. Only MSRs covered by the MSR permissions
+        ///     map can be filtered.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param vmid The ID of the VM to modify
+        ///   @param msrs The range of MSRs to modify
+        ///   @param perms The accesses to return to software
+        ///   @return Returns MV_STATUS_SUCCESS on success, MV_STATUS_FAILURE_UNKNOWN
+        ///     and friends on failure.
+        ///
+        [[nodiscard]] constexpr auto
+        mv_vm_op_msr_filter(
+            bsl::safe_u16 const &vmid,
+            bsl::safe_u64 const &msrs,
+            bsl::safe_u64 const &perms) noexcept -> bsl::errc_type
+        {
+            bsl::expects(vmid.is_valid_and_checked());
+            bsl::expects(vmid != MV_INVALID_ID);
+            bsl::expects(msrs.is_valid_and_checked());
+            bsl::expects(perms.is_valid_and_checked());
+
+            mv_status_t const ret{
+                mv_vm_op_msr_filter_impl(m_hndl.get(), vmid.get(), msrs.get(), perms.get())};
+            if (bsl::unlikely(ret != MV_STATUS_SUCCESS)) {
+                bsl::error() << "mv_vm_op_msr_filter failed with status "    // --
+                             << bsl::hex(ret)                                // --
+                             << bsl::endl                                    // --
+                             << bsl::here();                                 // --
+
+                return bsl::errc_failure;
+            }
+
+            return bsl::errc_success;
+        }
+
+        /// <!-- description -->
+        ///   @brief This hypercall tells MicroV to return the current value
+        ///     of the VM's kvmclock in nanoseconds. This is the clock that
+        ///     each VS of the VM reads using its pvclock structure (see
+        ///     MSR_KVM_SYSTEM_TIME_NEW).
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param vmid The ID of the VM to query
+        ///   @return Returns the kvmclock of the VM in nanoseconds on
+        ///     success, or bsl::safe_u64::failure() on failure.
+        ///
+        [[nodiscard]] constexpr auto
+        mv_vm_op_clock_get(bsl::safe_u16 const &vmid) noexcept -> bsl::safe_u64
+        {
+            bsl::expects(vmid.is_valid_and_checked());
+            bsl::expects(vmid != MV_INVALID_ID);
+
+            bsl::safe_u64 mut_clock;
+
+            mv_status_t const ret{
+                mv_vm_op_clock_get_impl(m_hndl.get(), vmid.get(), mut_clock.data())};
+            if (bsl::unlikely(ret != MV_STATUS_SUCCESS)) {
+                bsl::error() << "mv_vm_op_clock_get failed with status "    // --
+                             << bsl::hex(ret)                               // --
+                             << bsl::endl                                   // --
+                             << bsl::here();                                // --
+
+                return bsl::safe_u64::failure();
+            }
+
+            return mut_clock;
+        }
+
+        /// <!-- description -->
+        ///   @brief This hypercall tells MicroV to set the VM's kvmclock
+        ///     so that it currently reads the provided value in nanoseconds.
+        ///     The provided wall clock time is used to compute the wall
+        ///     clock time at which the kvmclock read 0, which is reported to
+        ///     each VS using MSR_KVM_WALL_CLOCK_NEW. The pvclock structure of
+        ///     each VS is updated the next time the VS is run.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param vmid The ID of the VM to set
+        ///   @param clock The value the kvmclock should read in nanoseconds
+        ///   @param realtime The current wall clock time in nanoseconds since
+        ///       the epoch, or 0 if unknown
+        ///   @return Returns MV_STATUS_SUCCESS on success, MV_STATUS_FAILURE_UNKNOWN
+        ///     and friends on failure.
+        ///
+        [[nodiscard]] constexpr auto
+        mv_vm_op_clock_set(
+            bsl::safe_u16 const &vmid,
+            bsl::safe_u64 const &clock,
+            bsl::safe_u64 const &realtime) noexcept -> bsl::errc_type
+        {
+            bsl::expects(vmid.is_valid_and_checked());
+            bsl::expects(vmid != MV_INVALID_ID);
+            bsl::expects(clock.is_valid_and_checked());
+            bsl::expects(realtime.is_valid_and_checked());
+
+            mv_status_t const ret{
+                mv_vm_op_clock_set_impl(m_hndl.get(), vmid.get(), clock.get(), realtime.get())};
+            if (bsl::unlikely(ret != MV_STATUS_SUCCESS)) {
+                bsl::error() << "mv_vm_op_clock_set failed with status "    // --
+                             << bsl::hex(ret)                               // --
+                             << bsl::endl                                   // --
+                             << bsl::here();                                // --
+
+                return bsl::errc_failure;
+            }
+
+            return bsl::errc_success;
+        }
+
         // ---------------------------------------------------------------------
         // mv_vp_ops
         // ---------------------------------------------------------------------
@@ -989,6 +1491,43 @@ namespace hypercall
             return mut_exit_reason;
         }
 
+        /// <!-- description -->
+        ///   @brief This hypercall tells MicroV to set the CPUID leaves seen
+        ///     by the VS using a CPUID Descriptor List (CDL) in the shared page.
+        ///     The fun and idx fields of each mv_cdl_entry_t refer to the CPUID
+        ///     leaf and the eax, ebx, ecx and edx fields refer to the values the
+        ///     VS will see when it executes CPUID for that leaf. If the flags
+        ///     field is set to mv_cpuid_flag_t_significant_index, the idx field
+        ///     selects a subleaf, otherwise it is ignored. If reg0 in the
+        ///     mv_cdl_t is 0, the CPUID leaves of the VS are cleared before the
+        ///     entries are added, otherwise the entries are added to the
+        ///     existing leaves, which allows more than MV_CDL_MAX_ENTRIES to be
+        ///     set using more than one call.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param vsid The ID of the VS to set
+        ///   @return Returns MV_STATUS_SUCCESS on success, MV_STATUS_FAILURE_UNKNOWN
+        ///     and friends on failure.
+        ///
+        [[nodiscard]] constexpr auto
+        mv_vs_op_cpuid_set_list(bsl::safe_u16 const &vsid) noexcept -> bsl::errc_type
+        {
+            bsl::expects(vsid.is_valid_and_checked());
+            bsl::expects(vsid != MV_INVALID_ID);
+
+            mv_status_t const ret{mv_vs_op_cpuid_set_list_impl(m_hndl.get(), vsid.get())};
+            if (bsl::unlikely(ret != MV_STATUS_SUCCESS)) {
+                bsl::error() << "mv_vs_op_cpuid_set_list failed with status "    // --
+                             << bsl::hex(ret)                                    // --
+                             << bsl::endl                                        // --
+                             << bsl::here();                                     // --
+
+                return bsl::errc_failure;
+            }
+
+            return bsl::errc_success;
+        }
+
         /// <!-- description -->
         ///   @brief This hypercall tells MicroV to return the value of a requested
         ///     register. Not all registers values require 64 bits. Any unused bits
@@ -1312,6 +1851,105 @@ namespace hypercall
 
             return bsl::errc_success;
         }
+
+        /// <!-- description -->
+        ///   @brief This hypercall tells MicroV to move entries from the dirty
+        ///     ring of the provided VS into the mv_dirty_ring_t in the shared
+        ///     page. On input, num_entries is the max number of entries to move.
+        ///     On output, num_entries is the number of entries that were moved.
+        ///     Entries are moved in the order that the pages were dirtied.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param vsid The ID of the VS to query
+        ///   @return Returns MV_STATUS_SUCCESS on success, MV_STATUS_FAILURE_UNKNOWN
+        ///     and friends on failure.
+        ///
+        [[nodiscard]] constexpr auto
+        mv_vs_op_dirty_ring_get(bsl::safe_u16 const &vsid) noexcept -> bsl::errc_type
+        {
+            bsl::expects(vsid.is_valid_and_checked());
+            bsl::expects(vsid != MV_INVALID_ID);
+
+            mv_status_t const ret{mv_vs_op_dirty_ring_get_impl(m_hndl.get(), vsid.get())};
+            if (bsl::unlikely(ret != MV_STATUS_SUCCESS)) {
+                bsl::error() << "mv_vs_op_dirty_ring_get failed with status "    // --
+                             << bsl::hex(ret)                                    // --
+                             << bsl::endl                                        // --
+                             << bsl::here();                                     // --
+
+                return bsl::errc_failure;
+            }
+
+            return bsl::errc_success;
+        }
+
+        /// <!-- description -->
+        ///   @brief This hypercall tells MicroV to set the frequency of the
+        ///     TSC seen by the VS. If the frequency does not match the
+        ///     frequency of the PP the VS is assigned to, the TSC of the VS is
+        ///     scaled, which requires TSC scaling support from the CPU. The
+        ///     frequency is also reported to the VS using CPUID leaves 0x15
+        ///     and 0x40000010.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param vsid The ID of the VS to set
+        ///   @param khz The frequency of the TSC in KHz
+        ///   @return Returns MV_STATUS_SUCCESS on success, MV_STATUS_FAILURE_UNKNOWN
+        ///     and friends on failure.
+        ///
+        [[nodiscard]] constexpr auto
+        mv_vs_op_tsc_set_khz(
+            bsl::safe_u16 const &vsid, bsl::safe_u64 const &khz) noexcept -> bsl::errc_type
+        {
+            bsl::expects(vsid.is_valid_and_checked());
+            bsl::expects(vsid != MV_INVALID_ID);
+            bsl::expects(khz.is_valid_and_checked());
+
+            mv_status_t const ret{mv_vs_op_tsc_set_khz_impl(m_hndl.get(), vsid.get(), khz.get())};
+            if (bsl::unlikely(ret != MV_STATUS_SUCCESS)) {
+                bsl::error() << "mv_vs_op_tsc_set_khz failed with status "    // --
+                             << bsl::hex(ret)                                 // --
+                             << bsl::endl                                     // --
+                             << bsl::here();                                  // --
+
+                return bsl::errc_failure;
+            }
+
+            return bsl::errc_success;
+        }
+
+        /// <!-- description -->
+        ///   @brief This hypercall tells MicroV to set the value that is
+        ///     added to the (possibly scaled) TSC of the PP when the VS reads
+        ///     its TSC.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param vsid The ID of the VS to set
+        ///   @param offset The TSC offset to use
+        ///   @return Returns MV_STATUS_SUCCESS on success, MV_STATUS_FAILURE_UNKNOWN
+        ///     and friends on failure.
+        ///
+        [[nodiscard]] constexpr auto
+        mv_vs_op_tsc_set_offset(
+            bsl::safe_u16 const &vsid, bsl::safe_u64 const &offset) noexcept -> bsl::errc_type
+        {
+            bsl::expects(vsid.is_valid_and_checked());
+            bsl::expects(vsid != MV_INVALID_ID);
+            bsl::expects(offset.is_valid_and_checked());
+
+            mv_status_t const ret{
+                mv_vs_op_tsc_set_offset_impl(m_hndl.get(), vsid.get(), offset.get())};
+            if (bsl::unlikely(ret != MV_STATUS_SUCCESS)) {
+                bsl::error() << "mv_vs_op_tsc_set_offset failed with status "    // --
+                             << bsl::hex(ret)                                    // --
+                             << bsl::endl                                        // --
+                             << bsl::here();                                     // --
+
+                return bsl::errc_failure;
+            }
+
+            return bsl::errc_success;
+        }
     };
 }
 
@@ -24,8 +24,13 @@
 
 #include "../../mocks/mv_hypercall.h"
 
+#include <mv_cdl_t.h>
 #include <mv_constants.h>
+#include <mv_cpuid_flag_t.h>
 #include <mv_exit_io_t.h>
+#include <mv_exit_kick_t.h>
+#include <mv_exit_mmio_t.h>
+#include <mv_exit_msr_t.h>
 #include <mv_exit_reason_t.h>
 #include <mv_rdl_t.h>
 #include <mv_reg_t.h>
@@ -51,12 +56,25 @@ namespace shim
         constinit bsl::uint16 g_mut_mv_pp_op_ppid{};
         constinit mv_status_t g_mut_mv_pp_op_clr_shared_page_gpa{};
         constinit mv_status_t g_mut_mv_pp_op_set_shared_page_gpa{};
+        constinit mv_status_t g_mut_mv_pp_op_cpuid_get_supported_list{};
+        constinit mv_status_t g_mut_mv_pp_op_tsc_get_khz{};
 
         constinit bsl::uint16 g_mut_mv_vm_op_create_vm{};
         constinit mv_status_t g_mut_mv_vm_op_destroy_vm{};
         constinit bsl::uint16 g_mut_mv_vm_op_vmid{};
         constinit mv_status_t g_mut_mv_vm_op_mmio_map{};
         constinit mv_status_t g_mut_mv_vm_op_mmio_unmap{};
+        constinit mv_status_t g_mut_mv_vm_op_dirty_log_enable{};
+        constinit mv_status_t g_mut_mv_vm_op_dirty_log_disable{};
+        constinit mv_status_t g_mut_mv_vm_op_dirty_log_get{};
+        constinit mv_status_t g_mut_mv_vm_op_dirty_log_clear{};
+        constinit mv_status_t g_mut_mv_vm_op_dirty_ring_reset{};
+        constinit bsl::uint16 g_mut_mv_vm_op_fork_vm{};
+        constinit mv_status_t g_mut_mv_vm_op_msr_intercept{};
+        constinit mv_status_t g_mut_mv_vm_op_io_intercept{};
+        constinit mv_status_t g_mut_mv_vm_op_msr_filter{};
+        constinit mv_status_t g_mut_mv_vm_op_clock_get{};
+        constinit mv_status_t g_mut_mv_vm_op_clock_set{};
 
         constinit bsl::uint16 g_mut_mv_vp_op_create_vp{};
         constinit mv_status_t g_mut_mv_vp_op_destroy_vp{};
@@ -70,7 +88,11 @@ namespace shim
         constinit bsl::uint16 g_mut_mv_vs_op_vsid{};
         constinit mv_translation_t g_mut_mv_vs_op_gla_to_gpa{};
         constinit mv_exit_reason_t g_mut_mv_vs_op_run{};
+        constinit mv_status_t g_mut_mv_vs_op_cpuid_set_list{};
         constinit mv_exit_io_t g_mut_mv_vs_op_run_io{};
+        constinit mv_exit_mmio_t g_mut_mv_vs_op_run_mmio{};
+        constinit mv_exit_msr_t g_mut_mv_vs_op_run_msr{};
+        constinit mv_exit_kick_t g_mut_mv_vs_op_run_kick{};
         constinit mv_status_t g_mut_mv_vs_op_reg_get{};
         constinit mv_status_t g_mut_mv_vs_op_reg_set{};
         constinit mv_status_t g_mut_mv_vs_op_reg_get_list{};
@@ -81,6 +103,10 @@ namespace shim
         constinit mv_status_t g_mut_mv_vs_op_msr_set_list{};
         constinit mv_status_t g_mut_mv_vs_op_fpu_get_all{};
         constinit mv_status_t g_mut_mv_vs_op_fpu_set_all{};
+        constinit mv_status_t g_mut_mv_vs_op_dirty_ring_get{};
+        constinit mv_status_t g_mut_mv_vs_op_tsc_set_khz{};
+        constinit mv_status_t g_mut_mv_vs_op_tsc_set_offset{};
+        constinit bsl::uint64 g_mut_mv_vs_op_dirty_ring_get_num_entries{};
 
         extern bool g_mut_hypervisor_detected;
         extern bool g_mut_platform_alloc_fails;
@@ -183,6 +209,43 @@ namespace shim
             };
         };
 
+        bsl::ut_scenario{"mv_pp_op_cpuid_get_supported_list"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                constexpr auto hypercall{&mv_pp_op_cpuid_get_supported_list};
+                constexpr auto expected{42_u64};
+                mv_cdl_t mut_cdl{};
+                bsl::ut_when{} = [&]() noexcept {
+                    g_mut_shared_pages[0] = &mut_cdl;
+                    g_mut_val = bsl::safe_u64::magic_2().get();
+                    g_mut_mv_pp_op_cpuid_get_supported_list = expected.get();
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(expected == hypercall(hndl));
+                        bsl::ut_check(bsl::safe_u64::magic_2() == mut_cdl.num_entries);
+                        bsl::ut_check(mv_cpuid_flag_t_reserved == mut_cdl.entries[0].flags);
+                        bsl::ut_check(
+                            mv_cpuid_flag_t_significant_index == mut_cdl.entries[1].flags);
+                        bsl::ut_check(bsl::safe_u32::magic_1() == mut_cdl.entries[1].eax);
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"mv_pp_op_tsc_get_khz"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                constexpr auto hypercall{&mv_pp_op_tsc_get_khz};
+                constexpr auto expected{42_u64};
+                bsl::safe_u64 mut_freq{};
+                bsl::ut_when{} = [&]() noexcept {
+                    g_mut_val = expected.get();
+                    g_mut_mv_pp_op_tsc_get_khz = expected.get();
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(expected == hypercall(hndl, mut_freq.data()));
+                        bsl::ut_check(expected == mut_freq);
+                    };
+                };
+            };
+        };
+
         bsl::ut_scenario{"mv_vm_op_create_vm"} = []() noexcept {
             bsl::ut_given{} = [&]() noexcept {
                 constexpr auto hypercall{&mv_vm_op_create_vm};
@@ -252,6 +315,152 @@ namespace shim
             };
         };
 
+        bsl::ut_scenario{"mv_vm_op_dirty_log_enable"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                constexpr auto hypercall{&mv_vm_op_dirty_log_enable};
+                constexpr auto expected{42_u64};
+                bsl::ut_when{} = [&]() noexcept {
+                    g_mut_mv_vm_op_dirty_log_enable = expected.get();
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(expected == hypercall(hndl, {}, {}));
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"mv_vm_op_dirty_log_disable"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                constexpr auto hypercall{&mv_vm_op_dirty_log_disable};
+                constexpr auto expected{42_u64};
+                bsl::ut_when{} = [&]() noexcept {
+                    g_mut_mv_vm_op_dirty_log_disable = expected.get();
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(expected == hypercall(hndl, {}, {}));
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"mv_vm_op_dirty_log_get"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                constexpr auto hypercall{&mv_vm_op_dirty_log_get};
+                constexpr auto expected{42_u64};
+                bsl::ut_when{} = [&]() noexcept {
+                    g_mut_mv_vm_op_dirty_log_get = expected.get();
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(expected == hypercall(hndl, {}, {}, {}));
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"mv_vm_op_dirty_log_clear"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                constexpr auto hypercall{&mv_vm_op_dirty_log_clear};
+                constexpr auto expected{42_u64};
+                bsl::ut_when{} = [&]() noexcept {
+                    g_mut_mv_vm_op_dirty_log_clear = expected.get();
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(expected == hypercall(hndl, {}, {}, {}));
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"mv_vm_op_dirty_ring_reset"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                constexpr auto hypercall{&mv_vm_op_dirty_ring_reset};
+                constexpr auto expected{42_u64};
+                bsl::ut_when{} = [&]() noexcept {
+                    g_mut_mv_vm_op_dirty_ring_reset = expected.get();
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(expected == hypercall(hndl, {}));
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"mv_vm_op_fork_vm"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                constexpr auto hypercall{&mv_vm_op_fork_vm};
+                constexpr auto expected{42_u16};
+                bsl::ut_when{} = [&]() noexcept {
+                    g_mut_mv_vm_op_fork_vm = expected.get();
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(expected == hypercall(hndl, {}));
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"mv_vm_op_msr_intercept"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                constexpr auto hypercall{&mv_vm_op_msr_intercept};
+                constexpr auto expected{42_u64};
+                bsl::ut_when{} = [&]() noexcept {
+                    g_mut_mv_vm_op_msr_intercept = expected.get();
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(expected == hypercall(hndl, {}, {}, {}));
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"mv_vm_op_io_intercept"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                constexpr auto hypercall{&mv_vm_op_io_intercept};
+                constexpr auto expected{42_u64};
+                bsl::ut_when{} = [&]() noexcept {
+                    g_mut_mv_vm_op_io_intercept = expected.get();
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(expected == hypercall(hndl, {}, {}, {}));
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"mv_vm_op_msr_filter"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                constexpr auto hypercall{&mv_vm_op_msr_filter};
+                constexpr auto expected{42_u64};
+                bsl::ut_when{} = [&]() noexcept {
+                    g_mut_mv_vm_op_msr_filter = expected.get();
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(expected == hypercall(hndl, {}, {}, {}));
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"mv_vm_op_clock_get"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                constexpr auto hypercall{&mv_vm_op_clock_get};
+                constexpr auto expected{42_u64};
+                bsl::safe_u64 mut_clock{};
+                bsl::ut_when{} = [&]() noexcept {
+                    g_mut_val = expected.get();
+                    g_mut_mv_vm_op_clock_get = expected.get();
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(expected == hypercall(hndl, {}, mut_clock.data()));
+                        bsl::ut_check(expected == mut_clock);
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"mv_vm_op_clock_set"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                constexpr auto hypercall{&mv_vm_op_clock_set};
+                constexpr auto expected{42_u64};
+                bsl::ut_when{} = [&]() noexcept {
+                    g_mut_mv_vm_op_clock_set = expected.get();
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(expected == hypercall(hndl, {}, {}, {}));
+                    };
+                };
+            };
+        };
+
         bsl::ut_scenario{"mv_vp_op_create_vp"} = []() noexcept {
             bsl::ut_given{} = [&]() noexcept {
                 constexpr auto hypercall{&mv_vp_op_create_vp};
@@ -402,6 +611,19 @@ namespace shim
             };
         };
 
+        bsl::ut_scenario{"mv_vs_op_cpuid_set_list"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                constexpr auto hypercall{&mv_vs_op_cpuid_set_list};
+                constexpr auto expected{42_u64};
+                bsl::ut_when{} = [&]() noexcept {
+                    g_mut_mv_vs_op_cpuid_set_list = expected.get();
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(expected == hypercall(hndl, {}));
+                    };
+                };
+            };
+        };
+
         bsl::ut_scenario{"mv_vs_op_run"} = []() noexcept {
             bsl::ut_given{} = [&]() noexcept {
                 constexpr auto hypercall{&mv_vs_op_run};
@@ -447,7 +669,9 @@ namespace shim
             bsl::ut_given{} = [&]() noexcept {
                 constexpr auto hypercall{&mv_vs_op_run};
                 constexpr mv_exit_reason_t expected{mv_exit_reason_t_mmio};
+                mv_exit_mmio_t mut_exit_mmio{};
                 bsl::ut_when{} = [&]() noexcept {
+                    g_mut_shared_pages[0] = &mut_exit_mmio;
                     g_mut_mv_vs_op_run = expected;
                     bsl::ut_then{} = [&]() noexcept {
                         bsl::ut_check(expected == hypercall(hndl, {}));
@@ -608,6 +832,45 @@ namespace shim
             };
         };
 
+        bsl::ut_scenario{"mv_vs_op_dirty_ring_get"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                constexpr auto hypercall{&mv_vs_op_dirty_ring_get};
+                constexpr auto expected{42_u64};
+                bsl::ut_when{} = [&]() noexcept {
+                    g_mut_mv_vs_op_dirty_ring_get = expected.get();
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(expected == hypercall(hndl, {}));
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"mv_vs_op_tsc_set_khz"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                constexpr auto hypercall{&mv_vs_op_tsc_set_khz};
+                constexpr auto expected{42_u64};
+                bsl::ut_when{} = [&]() noexcept {
+                    g_mut_mv_vs_op_tsc_set_khz = expected.get();
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(expected == hypercall(hndl, {}, {}));
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"mv_vs_op_tsc_set_offset"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                constexpr auto hypercall{&mv_vs_op_tsc_set_offset};
+                constexpr auto expected{42_u64};
+                bsl::ut_when{} = [&]() noexcept {
+                    g_mut_mv_vs_op_tsc_set_offset = expected.get();
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(expected == hypercall(hndl, {}, {}));
+                    };
+                };
+            };
+        };
+
         return bsl::ut_success();
     }
 }
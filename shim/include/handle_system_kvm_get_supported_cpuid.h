@@ -28,6 +28,7 @@
 #define HANDLE_SYSTEM_KVM_GET_SUPPORTED_CPUID_H
 
 #include <kvm_cpuid2.h>
+#include <kvm_cpuid_entry2.h>
 #include <mv_types.h>
 
 #ifdef __cplusplus
@@ -37,14 +38,20 @@ extern "C"
 
     /**
      * <!-- description -->
-     *   @brief Handles the execution of kvm_check_extension.
+     *   @brief Handles the execution of kvm_get_supported_cpuid. MicroV
+     *     caches the supported CPUID leaves of each PP, so all of them are
+     *     returned using a single call to mv_pp_op_cpuid_get_supported_list.
      *
      * <!-- inputs/outputs -->
-     *   @param pmut_ioctl_args the arguments provided by userspace
-     *   @return SHIM_SUCCESS on success, SHIM_FAILURE on failure.
+     *   @param pmut_args the arguments provided by userspace. On success,
+     *     pmut_args->nent is set to the number of entries returned.
+     *   @param pmut_entries where to return the entries. Must be able to
+     *     hold pmut_args->nent entries.
+     *   @return SHIM_SUCCESS on success, SHIM_2BIG if pmut_args->nent is
+     *     too small, SHIM_FAILURE on failure.
      */
-    NODISCARD int64_t
-    handle_system_kvm_get_supported_cpuid(struct kvm_cpuid2 *const pmut_ioctl_args) NOEXCEPT;
+    NODISCARD int64_t handle_system_kvm_get_supported_cpuid(
+        struct kvm_cpuid2 *const pmut_args, struct kvm_cpuid_entry2 *const pmut_entries) NOEXCEPT;
 
 #ifdef __cplusplus
 }
@@ -28,6 +28,7 @@
 #define HANDLE_VCPU_KVM_GET_TSC_KHZ_H
 
 #include <mv_types.h>
+#include <shim_vcpu_t.h>
 
 #ifdef __cplusplus
 extern "C"
@@ -36,12 +37,18 @@ extern "C"
 
     /**
      * <!-- description -->
-     *   @brief Handles the execution of kvm_get_tsc_khz.
+     *   @brief Handles the execution of kvm_get_tsc_khz. If the TSC frequency
+     *     of the VCPU was set using kvm_set_tsc_khz, that frequency is
+     *     returned. Otherwise, the VCPU runs at the frequency of the PP, which
+     *     MicroV measured when it was started.
      *
      * <!-- inputs/outputs -->
+     *   @param vcpu the VCPU to get the TSC frequency of
+     *   @param pmut_freq where to return the TSC frequency in KHz
      *   @return SHIM_SUCCESS on success, SHIM_FAILURE on failure.
      */
-    NODISCARD int64_t handle_vcpu_kvm_get_tsc_khz(void) NOEXCEPT;
+    NODISCARD int64_t handle_vcpu_kvm_get_tsc_khz(
+        struct shim_vcpu_t const *const vcpu, uint64_t *const pmut_freq) NOEXCEPT;
 
 #ifdef __cplusplus
 }
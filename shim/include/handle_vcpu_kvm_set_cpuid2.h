@@ -28,7 +28,9 @@
 #define HANDLE_VCPU_KVM_SET_CPUID2_H
 
 #include <kvm_cpuid2.h>
+#include <kvm_cpuid_entry2.h>
 #include <mv_types.h>
+#include <shim_vcpu_t.h>
 
 #ifdef __cplusplus
 extern "C"
@@ -40,10 +42,15 @@ extern "C"
      *   @brief Handles the execution of kvm_set_cpuid2.
      *
      * <!-- inputs/outputs -->
-     *   @param pmut_ioctl_args the arguments provided by userspace
+     *   @param vcpu to get vsid value to pass to hypercall
+     *   @param args the arguments provided by userspace
+     *   @param entries the args->nent entries provided by userspace
      *   @return SHIM_SUCCESS on success, SHIM_FAILURE on failure.
      */
-    NODISCARD int64_t handle_vcpu_kvm_set_cpuid2(struct kvm_cpuid2 *const pmut_ioctl_args) NOEXCEPT;
+    NODISCARD int64_t handle_vcpu_kvm_set_cpuid2(
+        struct shim_vcpu_t const *const vcpu,
+        struct kvm_cpuid2 const *const args,
+        struct kvm_cpuid_entry2 const *const entries) NOEXCEPT;
 
 #ifdef __cplusplus
 }
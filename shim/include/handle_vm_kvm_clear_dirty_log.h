@@ -29,6 +29,7 @@
 
 #include <kvm_clear_dirty_log.h>
 #include <mv_types.h>
+#include <shim_vm_t.h>
 
 #ifdef __cplusplus
 extern "C"
@@ -40,11 +41,12 @@ extern "C"
      *   @brief Handles the execution of kvm_clear_dirty_log.
      *
      * <!-- inputs/outputs -->
-     *   @param pmut_ioctl_args the arguments provided by userspace
+     *   @param args the arguments provided by userspace
+     *   @param pmut_vm the VM to query
      *   @return SHIM_SUCCESS on success, SHIM_FAILURE on failure.
      */
-    NODISCARD int64_t
-    handle_vm_kvm_clear_dirty_log(struct kvm_clear_dirty_log *const pmut_ioctl_args) NOEXCEPT;
+    NODISCARD int64_t handle_vm_kvm_clear_dirty_log(
+        struct kvm_clear_dirty_log const *const args, struct shim_vm_t *const pmut_vm) NOEXCEPT;
 
 #ifdef __cplusplus
 }
@@ -42,11 +42,15 @@ extern "C"
      *
      * <!-- inputs/outputs -->
      *   @param pmut_vm the VM to add the VCPU to
+     *   @param apic_id the ID given to KVM_CREATE_VCPU, which KVM uses as
+     *     the APIC ID of the VCPU
      *   @param pmut_vcpu returns the resulting VCPU
      *   @return SHIM_SUCCESS on success, SHIM_FAILURE on failure.
      */
     NODISCARD int64_t handle_vm_kvm_create_vcpu(
-        struct shim_vm_t *const pmut_vm, struct shim_vcpu_t **const pmut_vcpu) NOEXCEPT;
+        struct shim_vm_t *const pmut_vm,
+        uint32_t const apic_id,
+        struct shim_vcpu_t **const pmut_vcpu) NOEXCEPT;
 
 #ifdef __cplusplus
 }
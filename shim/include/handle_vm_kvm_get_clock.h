@@ -29,6 +29,7 @@
 
 #include <kvm_clock_data.h>
 #include <mv_types.h>
+#include <shim_vm_t.h>
 
 #ifdef __cplusplus
 extern "C"
@@ -40,11 +41,12 @@ extern "C"
      *   @brief Handles the execution of kvm_get_clock.
      *
      * <!-- inputs/outputs -->
-     *   @param pmut_ioctl_args the arguments provided by userspace
+     *   @param vm the VM to query
+     *   @param pmut_args the arguments provided by userspace
      *   @return SHIM_SUCCESS on success, SHIM_FAILURE on failure.
      */
-    NODISCARD int64_t
-    handle_vm_kvm_get_clock(struct kvm_clock_data *const pmut_ioctl_args) NOEXCEPT;
+    NODISCARD int64_t handle_vm_kvm_get_clock(
+        struct shim_vm_t const *const vm, struct kvm_clock_data *const pmut_args) NOEXCEPT;
 
 #ifdef __cplusplus
 }
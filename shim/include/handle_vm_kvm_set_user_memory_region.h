@@ -35,7 +35,7 @@ extern "C"
 {
 #endif
 
-/** @brief TBD */
+/** @brief enables dirty page logging for a slot */
 #define KVM_MEM_LOG_DIRTY_PAGES (((uint64_t)1) << ((uint64_t)0))
 /** @brief allows a slot to be read-only */
 #define KVM_MEM_READONLY (((uint64_t)1) << ((uint64_t)1))
@@ -44,8 +44,14 @@ extern "C"
      */
     struct kvm_clear_dirty_log
     {
-        /** @brief replace me with contents from KVM API */
-        int32_t dummy;
+        /** @brief the guest physical memory slot to clear the dirty log of */
+        uint32_t slot;
+        /** @brief the number of pages described by dirty_bitmap */
+        uint32_t num_pages;
+        /** @brief the index of the first page in the slot to clear */
+        uint64_t first_page;
+        /** @brief the userspace address of the bitmap of pages to clear */
+        uint64_t dirty_bitmap;
     };
 
 #pragma pack(pop)
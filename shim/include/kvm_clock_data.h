@@ -36,6 +36,18 @@ extern "C"
 
 #pragma pack(push, 1)
 
+/** @brief the kvmclock is stable across all VCPUs */
+#define KVM_CLOCK_TSC_STABLE ((uint32_t)0x00000002)
+/** @brief kvm_clock_data.realtime is valid */
+#define KVM_CLOCK_REALTIME ((uint32_t)0x00000004)
+/** @brief kvm_clock_data.host_tsc is valid */
+#define KVM_CLOCK_HOST_TSC ((uint32_t)0x00000008)
+/** @brief defines the flags that kvm_set_clock accepts */
+#define KVM_CLOCK_VALID_FLAGS (KVM_CLOCK_TSC_STABLE | KVM_CLOCK_REALTIME | KVM_CLOCK_HOST_TSC)
+
+/** @brief defines the size of kvm_clock_data.pad */
+#define KVM_CLOCK_DATA_PAD_SIZE 4
+
     /**
      * @struct kvm_clock_data
      *
@@ -44,8 +56,18 @@ extern "C"
      */
     struct kvm_clock_data
     {
-        /** @brief replace me with contents from KVM API */
-        int32_t dummy;
+        /** @brief the kvmclock of the VM in nanoseconds */
+        uint64_t clock;
+        /** @brief KVM_CLOCK_TSC_STABLE, KVM_CLOCK_REALTIME and friends */
+        uint32_t flags;
+        /** @brief reserved (natural alignment of realtime) */
+        uint32_t pad0;
+        /** @brief the wall clock time in nanoseconds that clock was sampled at */
+        uint64_t realtime;
+        /** @brief the host TSC that clock was sampled at */
+        uint64_t host_tsc;
+        /** @brief reserved */
+        uint32_t pad[KVM_CLOCK_DATA_PAD_SIZE];
     };
 
 #pragma pack(pop)
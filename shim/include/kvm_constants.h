@@ -54,16 +54,40 @@ extern "C"
 #define KVM_CAP_JOIN_MEMORY_REGIONS_WORKS 30
 /** @brief defines KVM_CAP_MCE for check extension */
 #define KVM_CAP_MCE 31
+/** @brief defines KVM_CAP_ADJUST_CLOCK for check extension */
+#define KVM_CAP_ADJUST_CLOCK 39
+/** @brief defines KVM_CAP_TSC_CONTROL for check extension */
+#define KVM_CAP_TSC_CONTROL 60
 /** @brief defines KVM_CAP_GET_TSC_KHZ for check extension */
 #define KVM_CAP_GET_TSC_KHZ 61
 /** @brief defines KVM_CAP_MAX_VCPUS for check extension */
 #define KVM_CAP_MAX_VCPUS 66
 /** @brief defines KVM_CAP_TSC_DEADLINE_TIMER for check extension */
 #define KVM_CAP_TSC_DEADLINE_TIMER 72
+/** @brief defines KVM_CAP_SYNC_REGS for check extension */
+#define KVM_CAP_SYNC_REGS 74
+/** @brief defines KVM_CAP_VCPU_ATTRIBUTES for check extension */
+#define KVM_CAP_VCPU_ATTRIBUTES 127
 /** @brief defines KVM_CAP_MAX_VCPU_ID for check extension */
 #define KVM_CAP_MAX_VCPU_ID 128
 /** @brief defines KVM_CAP_IMMEDIATE_EXIT for check extension */
 #define KVM_CAP_IMMEDIATE_EXIT 136
+/** @brief defines KVM_CAP_X86_USER_SPACE_MSR for check extension */
+#define KVM_CAP_X86_USER_SPACE_MSR 188
+/** @brief defines KVM_CAP_X86_MSR_FILTER for check extension */
+#define KVM_CAP_X86_MSR_FILTER 189
+/** @brief defines KVM_CAP_DIRTY_LOG_RING for check extension */
+#define KVM_CAP_DIRTY_LOG_RING 192
+/** @brief defines the MicroV specific KVM_CAP_MICROV_FORK for enable cap */
+#define KVM_CAP_MICROV_FORK 0x4D56
+/** @brief defines the max size in bytes of a dirty ring */
+#define KVM_DIRTY_RING_MAX_SIZE 0x100000
+/** @brief defines the page offset of the dirty ring in the VCPU mmap */
+#define KVM_DIRTY_LOG_PAGE_OFFSET 64
+/** @brief defines the max number of entries in a kvm_cpuid2 */
+#define KVM_MAX_CPUID_ENTRIES 256
+/** @brief defines KVM_CPUID_FLAG_SIGNIFCANT_INDEX for kvm_cpuid_entry2 */
+#define KVM_CPUID_FLAG_SIGNIFCANT_INDEX 1
 /** @brief defines MICROV_MAX_MCE_BANKS  */
 #define MICROV_MAX_MCE_BANKS 32
 
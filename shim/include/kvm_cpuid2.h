@@ -41,11 +41,16 @@ extern "C"
      *
      * <!-- description -->
      *   @brief see /include/uapi/linux/kvm.h in Linux for more details.
+     *     Like KVM, the nent kvm_cpuid_entry2 entries immediately follow
+     *     this structure in memory. They are not declared here so that the
+     *     size of this structure (and therefore the IOCTL number) matches.
      */
     struct kvm_cpuid2
     {
-        /** @brief replace me with contents from KVM API */
-        int32_t dummy;
+        /** @brief stores the number of entries */
+        uint32_t nent;
+        /** @brief padding */
+        uint32_t padding;
     };
 
 #pragma pack(pop)
@@ -36,6 +36,11 @@ extern "C"
 
 #pragma pack(push, 1)
 
+/** @brief defines the VCPU attribute group used to control the TSC */
+#define KVM_VCPU_TSC_CTRL ((uint32_t)0)
+/** @brief defines the KVM_VCPU_TSC_CTRL attribute that stores the TSC offset */
+#define KVM_VCPU_TSC_OFFSET ((uint64_t)0)
+
     /**
      * @struct kvm_device_attr
      *
@@ -44,8 +49,14 @@ extern "C"
      */
     struct kvm_device_attr
     {
-        /** @brief replace me with contents from KVM API */
-        int32_t dummy;
+        /** @brief no flags are currently defined */
+        uint32_t flags;
+        /** @brief the group the attribute belongs to */
+        uint32_t group;
+        /** @brief the attribute within the group */
+        uint64_t attr;
+        /** @brief the userspace address of the attribute's value */
+        uint64_t addr;
     };
 
 #pragma pack(pop)
@@ -0,0 +1,68 @@
+/**
+ * @copyright
+ * Copyright (C) 2020 Assured Information Security, Inc.
+ *
+ * @copyright
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * @copyright
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * @copyright
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef KVM_DIRTY_GFN_H
+#define KVM_DIRTY_GFN_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#pragma pack(push, 1)
+
+/** @brief the page described by a kvm_dirty_gfn was written to */
+#define KVM_DIRTY_GFN_F_DIRTY ((uint32_t)0x00000001)
+/** @brief the page described by a kvm_dirty_gfn was harvested */
+#define KVM_DIRTY_GFN_F_RESET ((uint32_t)0x00000002)
+/** @brief the mask of all kvm_dirty_gfn flags */
+#define KVM_DIRTY_GFN_F_MASK ((uint32_t)0x00000003)
+
+    /**
+     * @struct kvm_dirty_gfn
+     *
+     * <!-- description -->
+     *   @brief see /include/uapi/linux/kvm.h in Linux for more details.
+     */
+    struct kvm_dirty_gfn
+    {
+        /** @brief stores the KVM_DIRTY_GFN_F_XXX flags */
+        uint32_t flags;
+        /** @brief stores the slot the dirty page belongs to */
+        uint32_t slot;
+        /** @brief stores the page offset of the dirty page in the slot */
+        uint64_t offset;
+    };
+
+#pragma pack(pop)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
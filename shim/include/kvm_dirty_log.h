@@ -44,8 +44,12 @@ extern "C"
      */
     struct kvm_dirty_log
     {
-        /** @brief replace me with contents from KVM API */
-        int32_t dummy;
+        /** @brief the guest physical memory slot to get the dirty log of */
+        uint32_t slot;
+        /** @brief unused, reserved for alignment */
+        uint32_t padding1;
+        /** @brief the userspace address of the bitmap to fill in */
+        uint64_t dirty_bitmap;
     };
 
 #pragma pack(pop)
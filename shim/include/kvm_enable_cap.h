@@ -44,8 +44,14 @@ extern "C"
      */
     struct kvm_enable_cap
     {
-        /** @brief replace me with contents from KVM API */
-        int32_t dummy;
+        /** @brief the capability to enable */
+        uint32_t cap;
+        /** @brief the flags for the capability, must be 0 */
+        uint32_t flags;
+        /** @brief the arguments for the capability */
+        uint64_t args[4];
+        /** @brief reserved */
+        uint8_t pad[64];
     };
 
 #pragma pack(pop)
@@ -0,0 +1,96 @@
+/**
+ * @copyright
+ * Copyright (C) 2020 Assured Information Security, Inc.
+ *
+ * @copyright
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * @copyright
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * @copyright
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef KVM_MSR_FILTER_H
+#define KVM_MSR_FILTER_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#pragma pack(push, 1)
+
+/** @brief defines the max number of ranges in a kvm_msr_filter */
+#define KVM_MSR_FILTER_MAX_RANGES 16
+/** @brief defines the max size in bytes of the bitmap of a range */
+#define KVM_MSR_FILTER_MAX_BITMAP_SIZE 0x600
+/** @brief the range applies to RDMSR */
+#define KVM_MSR_FILTER_READ ((uint32_t)0x00000001)
+/** @brief the range applies to WRMSR */
+#define KVM_MSR_FILTER_WRITE ((uint32_t)0x00000002)
+/** @brief defines the valid bits of kvm_msr_filter_range.flags */
+#define KVM_MSR_FILTER_RANGE_VALID_MASK (KVM_MSR_FILTER_READ | KVM_MSR_FILTER_WRITE)
+/** @brief MSRs not covered by a range are allowed */
+#define KVM_MSR_FILTER_DEFAULT_ALLOW ((uint32_t)0x00000000)
+/** @brief MSRs not covered by a range are denied (unsupported) */
+#define KVM_MSR_FILTER_DEFAULT_DENY ((uint32_t)0x00000001)
+
+    /**
+     * @struct kvm_msr_filter_range
+     *
+     * <!-- description -->
+     *   @brief see /include/uapi/linux/kvm.h in Linux for more details.
+     */
+    struct kvm_msr_filter_range
+    {
+        /** @brief the accesses the range applies to (KVM_MSR_FILTER_READ/WRITE) */
+        uint32_t flags;
+        /** @brief the number of MSRs described by bitmap */
+        uint32_t nmsrs;
+        /** @brief the first MSR described by bitmap */
+        uint32_t base;
+        /** @brief reserved (natural alignment of bitmap) */
+        uint32_t reserved;
+        /** @brief the userspace address of the bitmap (1 = allow, 0 = deny) */
+        uint64_t bitmap;
+    };
+
+    /**
+     * @struct kvm_msr_filter
+     *
+     * <!-- description -->
+     *   @brief see /include/uapi/linux/kvm.h in Linux for more details.
+     */
+    struct kvm_msr_filter
+    {
+        /** @brief KVM_MSR_FILTER_DEFAULT_ALLOW or KVM_MSR_FILTER_DEFAULT_DENY */
+        uint32_t flags;
+        /** @brief reserved (natural alignment of ranges) */
+        uint32_t reserved;
+        /** @brief the ranges of MSRs to filter */
+        struct kvm_msr_filter_range ranges[KVM_MSR_FILTER_MAX_RANGES];
+    };
+
+#pragma pack(pop)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
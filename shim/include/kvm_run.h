@@ -32,8 +32,10 @@
 #include <kvm_run_hw.h>
 #include <kvm_run_io.h>
 #include <kvm_run_mmio.h>
+#include <kvm_run_msr.h>
 #include <kvm_run_system_event.h>
 #include <kvm_run_tpr_access.h>
+#include <kvm_sync_regs.h>
 #include <mv_types.h>
 #include <stdint.h>
 
@@ -48,7 +50,7 @@ extern "C"
 #define KVM_RUN_PADDING1_SIZE ((uint64_t)6)
 /** @brief defines the size of the padding2 field */
 #define KVM_RUN_PADDING2_SIZE ((uint64_t)256)
-/** @brief defines the size of the padding3 field */
+/** @brief defines the size of the padding field of kvm_run.s */
 #define KVM_RUN_PADDING3_SIZE ((uint64_t)2048)
 
 /** @brief defines KVM_EXIT_UNKNOWN kvm_run.exit_reason */
@@ -65,6 +67,12 @@ extern "C"
 #define KVM_EXIT_FAIL_ENTRY 9
 /** @brief defines KVM_EXIT_INTR kvm_run.exit_reason */
 #define KVM_EXIT_INTR 10
+/** @brief defines KVM_EXIT_X86_RDMSR kvm_run.exit_reason */
+#define KVM_EXIT_X86_RDMSR 29
+/** @brief defines KVM_EXIT_X86_WRMSR kvm_run.exit_reason */
+#define KVM_EXIT_X86_WRMSR 30
+/** @brief defines KVM_EXIT_DIRTY_RING_FULL kvm_run.exit_reason */
+#define KVM_EXIT_DIRTY_RING_FULL 31
 
     /**
      * @struct kvm_run
@@ -112,6 +120,8 @@ extern "C"
             struct kvm_run_io io;
             /** @brief TODO */
             struct kvm_run_mmio mmio;
+            /** @brief stores the MSR access for KVM_EXIT_X86_RDMSR/WRMSR */
+            struct kvm_run_msr msr;
             /** @brief TODO */
             struct kvm_run_tpr_access tpr_access;
             /** @brief TODO */
@@ -126,8 +136,19 @@ extern "C"
         /** @brief TODO */
         uint64_t kvm_dirty_regs;
 
-        /** @brief TODO */
-        char padding3[KVM_RUN_PADDING3_SIZE];
+        /**
+         * <!-- description -->
+         *   @brief stores the registers synced with userspace as requested
+         *     by kvm_valid_regs and kvm_dirty_regs (KVM_CAP_SYNC_REGS)
+         */
+        // NOLINTNEXTLINE(bsl-decl-forbidden)
+        union
+        {
+            /** @brief stores the synced registers */
+            struct kvm_sync_regs regs;
+            /** @brief reserves the size of the union */
+            char padding[KVM_RUN_PADDING3_SIZE];
+        } s;
     };
 
 #pragma pack(pop)
@@ -30,6 +30,7 @@
 #include <kvm_run_hw.hpp>
 #include <kvm_run_io.hpp>
 #include <kvm_run_mmio.hpp>
+#include <kvm_run_msr.hpp>
 #include <kvm_run_system_event.hpp>
 #include <kvm_run_tpr_access.hpp>
 
@@ -92,6 +93,8 @@ namespace shim
             struct kvm_run_io io;
             /// @brief TODO
             struct kvm_run_mmio mmio;
+            /// @brief stores the MSR access for KVM_EXIT_X86_RDMSR/WRMSR
+            struct kvm_run_msr msr;
             /// @brief TODO
             struct kvm_run_tpr_access tpr_access;
             /// @brief TODO
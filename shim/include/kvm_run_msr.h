@@ -0,0 +1,73 @@
+/**
+ * @copyright
+ * Copyright (C) 2020 Assured Information Security, Inc.
+ *
+ * @copyright
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * @copyright
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * @copyright
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef KVM_RUN_MSR_H
+#define KVM_RUN_MSR_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#pragma pack(push, 1)
+
+/** @brief defines the size of the pad field of kvm_run_msr */
+#define KVM_RUN_MSR_PAD_SIZE ((uint64_t)7)
+
+/** @brief the MSR access was invalid (unsupported) */
+#define KVM_MSR_EXIT_REASON_INVAL ((uint32_t)0x00000001)
+/** @brief the MSR is unknown to the kernel (unsupported) */
+#define KVM_MSR_EXIT_REASON_UNKNOWN ((uint32_t)0x00000002)
+/** @brief the MSR access was denied by KVM_X86_SET_MSR_FILTER */
+#define KVM_MSR_EXIT_REASON_FILTER ((uint32_t)0x00000004)
+
+    /**
+     * <!-- description -->
+     *   @brief see /include/uapi/linux/kvm.h in Linux for more details.
+     */
+    struct kvm_run_msr
+    {
+        /** @brief set by userspace to inject a #GP instead of completing the access */
+        uint8_t error;
+        /** @brief reserved */
+        uint8_t pad[KVM_RUN_MSR_PAD_SIZE];
+        /** @brief stores why the access exited (KVM_MSR_EXIT_REASON_xxx) */
+        uint32_t reason;
+        /** @brief stores the MSR that was accessed */
+        uint32_t index;
+        /** @brief stores the value written, or the value to read set by userspace */
+        uint64_t data;
+    };
+
+#pragma pack(pop)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
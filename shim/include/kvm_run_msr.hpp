@@ -0,0 +1,66 @@
+/// @copyright
+/// Copyright (C) 2020 Assured Information Security, Inc.
+///
+/// @copyright
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// @copyright
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// @copyright
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+
+#ifndef KVM_RUN_MSR_HPP
+#define KVM_RUN_MSR_HPP
+
+#include <bsl/array.hpp>
+#include <bsl/convert.hpp>
+#include <bsl/safe_integral.hpp>
+
+#pragma pack(push, 1)
+
+namespace shim
+{
+    /// @brief defines the size of the pad field of kvm_run_msr
+    constexpr auto KVM_RUN_MSR_PAD_SIZE{7_umx};
+
+    /// @brief the MSR access was invalid (unsupported)
+    constexpr auto KVM_MSR_EXIT_REASON_INVAL{0x00000001_u32};
+    /// @brief the MSR is unknown to the kernel (unsupported)
+    constexpr auto KVM_MSR_EXIT_REASON_UNKNOWN{0x00000002_u32};
+    /// @brief the MSR access was denied by KVM_X86_SET_MSR_FILTER
+    constexpr auto KVM_MSR_EXIT_REASON_FILTER{0x00000004_u32};
+
+    /// <!-- description -->
+    ///   @brief see /include/uapi/linux/kvm.h in Linux for more details.
+    ///
+    struct kvm_run_msr final
+    {
+        /// @brief set by userspace to inject a #GP instead of completing the access
+        bsl::uint8 error;
+        /// @brief reserved
+        bsl::array<bsl::uint8, KVM_RUN_MSR_PAD_SIZE.get()> pad;
+        /// @brief stores why the access exited (KVM_MSR_EXIT_REASON_xxx)
+        bsl::uint32 reason;
+        /// @brief stores the MSR that was accessed
+        bsl::uint32 index;
+        /// @brief stores the value written, or the value to read set by userspace
+        bsl::uint64 data;
+    };
+}
+
+#pragma pack(pop)
+
+#endif
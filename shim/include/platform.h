@@ -32,11 +32,23 @@
 #if defined(WINDOWS_KERNEL)
 #include <wdm.h>
 typedef FAST_MUTEX platform_mutex;
+typedef KEVENT platform_event;
+typedef PKTHREAD platform_thread;
+typedef uint64_t platform_mmu_notifier;
 #elif defined(LINUX_KERNEL)
+#include <linux/completion.h>
+#include <linux/mmu_notifier.h>
 #include <linux/mutex.h>
+#include <linux/sched.h>
 typedef struct mutex platform_mutex;
+typedef struct completion platform_event;
+typedef struct task_struct *platform_thread;
+typedef struct mmu_notifier platform_mmu_notifier;
 #else
 typedef uint64_t platform_mutex;
+typedef uint64_t platform_event;
+typedef uint64_t platform_thread;
+typedef uint64_t platform_mmu_notifier;
 #endif
 
 #ifdef __cplusplus
@@ -126,7 +138,10 @@ namespace shim
          * <!-- description -->
          *   @brief Given a virtual address, this function returns the virtual
          *     address's physical address. Only works on memory owned by userspace.
-         *     Returns ((void *)0) if the conversion failed.
+         *     Returns ((void *)0) if the conversion failed. Note that the
+         *     page is faulted in if needed, but it is not pinned, meaning
+         *     the result is only valid until the host invalidates the page
+         *     (see shim_vm_invalidate_range_start).
          *
          * <!-- inputs/outputs -->
          *   @param virt the virtual address to convert to a physical address
@@ -234,6 +249,17 @@ namespace shim
          */
         NODISCARD uint32_t platform_current_cpu(void) NOEXCEPT;
 
+        /**
+         * <!-- description -->
+         *   @brief Returns the current wall clock time in nanoseconds since
+         *     the epoch.
+         *
+         * <!-- inputs/outputs -->
+         *   @return Returns the current wall clock time in nanoseconds since
+         *     the epoch.
+         */
+        NODISCARD uint64_t platform_realtime_ns(void) NOEXCEPT;
+
         /**
          * @brief The callback signature for platform_on_each_cpu
          */
@@ -296,6 +322,91 @@ namespace shim
          */
         void platform_mutex_unlock(platform_mutex *const pmut_mutex) NOEXCEPT;
 
+        /**
+         * <!-- description -->
+         *   @brief Initializes an event. This must be called before an
+         *     event can be used. Events start out cleared.
+         *
+         * <!-- inputs/outputs -->
+         *   @param pmut_event the event to initialize
+         */
+        void platform_event_init(platform_event *const pmut_event) NOEXCEPT;
+
+        /**
+         * <!-- description -->
+         *   @brief Puts the current thread to sleep until the event is
+         *     signaled, and then clears the event. If the event was
+         *     signaled before this function was called, it returns right
+         *     away. Returns SHIM_INTERRUPTED if the current process was
+         *     interrupted while it was waiting.
+         *
+         * <!-- inputs/outputs -->
+         *   @param pmut_event the event to wait on
+         *   @return Returns SHIM_SUCCESS once the event is signaled, or
+         *     SHIM_INTERRUPTED if the current process was interrupted.
+         */
+        NODISCARD int64_t platform_event_wait(platform_event *const pmut_event) NOEXCEPT;
+
+        /**
+         * <!-- description -->
+         *   @brief Signals an event, waking up the thread that is waiting
+         *     on it (if any). This can be called from any thread.
+         *
+         * <!-- inputs/outputs -->
+         *   @param pmut_event the event to signal
+         */
+        void platform_event_signal(platform_event *const pmut_event) NOEXCEPT;
+
+        /**
+         * <!-- description -->
+         *   @brief Returns the thread that is currently executing.
+         *
+         * <!-- inputs/outputs -->
+         *   @return Returns the thread that is currently executing.
+         */
+        NODISCARD platform_thread platform_current_thread(void) NOEXCEPT;
+
+        /**
+         * <!-- description -->
+         *   @brief Takes a reference to the provided thread so that it
+         *     cannot be freed (even if it exits) until platform_thread_put
+         *     is called.
+         *
+         * <!-- inputs/outputs -->
+         *   @param thread the thread to take a reference to
+         */
+        void platform_thread_get(platform_thread const thread) NOEXCEPT;
+
+        /**
+         * <!-- description -->
+         *   @brief Releases a reference to the provided thread that was
+         *     taken using platform_thread_get.
+         *
+         * <!-- inputs/outputs -->
+         *   @param thread the thread to release the reference to
+         */
+        void platform_thread_put(platform_thread const thread) NOEXCEPT;
+
+        /**
+         * <!-- description -->
+         *   @brief Gives the rest of the current thread's time slice to the
+         *     provided thread. This only works if the provided thread is
+         *     runnable, but is not running. The caller must hold a
+         *     reference to the provided thread (see platform_thread_get).
+         *
+         * <!-- inputs/outputs -->
+         *   @param thread the thread to give the time slice to
+         *   @return Returns SHIM_SUCCESS if the time slice was given to the
+         *     provided thread, SHIM_FAILURE otherwise.
+         */
+        NODISCARD int64_t platform_yield_to(platform_thread const thread) NOEXCEPT;
+
+        /**
+         * <!-- description -->
+         *   @brief Gives up the rest of the current thread's time slice.
+         */
+        void platform_yield(void) NOEXCEPT;
+
         /**
          * <!-- description -->
          *   @brief Returns SHIM_INTERRUPTED if the current process has NOT
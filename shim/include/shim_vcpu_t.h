@@ -27,8 +27,10 @@
 #ifndef SHIM_VCPU_T_H
 #define SHIM_VCPU_T_H
 
+#include <kvm_dirty_gfn.h>
 #include <kvm_run.h>
 #include <mv_types.h>
+#include <platform.h>
 #include <stdint.h>
 
 #ifdef __cplusplus
@@ -53,6 +55,8 @@ extern "C"
     {
         /** @brief stores the ID of this VCPU */
         uint16_t id;
+        /** @brief stores the APIC ID of this VCPU (the ID given to KVM_CREATE_VCPU) */
+        uint32_t apic_id;
         /** @brief stores file descriptor for this VCPU */
         uint64_t fd;
 
@@ -64,6 +68,28 @@ extern "C"
         /** @brief stores the kvm_run struct associated with this VCPU */
         struct kvm_run *run;
 
+        /** @brief stores the dirty ring associated with this VCPU (or NULL) */
+        struct kvm_dirty_gfn *dirty_ring;
+        /** @brief stores the index of the next dirty ring entry to publish */
+        uint64_t dirty_index;
+        /** @brief stores the index of the next dirty ring entry to reset */
+        uint64_t reset_index;
+
+        /** @brief stores the MV_EXIT_MSR_xxx of the MSR access given to userspace (0 if none) */
+        uint64_t msr_exit_flags;
+        /** @brief stores the MSR of the MSR access given to userspace */
+        uint32_t msr_exit_index;
+
+        /** @brief stores the TSC frequency set by KVM_SET_TSC_KHZ (0 if never set) */
+        uint64_t tsc_khz;
+        /** @brief stores the TSC offset set by KVM_VCPU_TSC_OFFSET */
+        uint64_t tsc_offset;
+
+        /** @brief signaled when another VCPU kicks this VCPU, stays signaled until waited on */
+        platform_event unhalt;
+        /** @brief stores the thread of this VCPU if preempted (0 otherwise), see vm->mutex */
+        platform_thread preempted_thread;
+
         /** @brief stores a pointer to the parent VM */
         struct shim_vm_t *vm;
     };
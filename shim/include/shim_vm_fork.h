@@ -0,0 +1,81 @@
+/**
+ * @copyright
+ * Copyright (C) 2020 Assured Information Security, Inc.
+ *
+ * @copyright
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * @copyright
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * @copyright
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef SHIM_VM_FORK_H
+#define SHIM_VM_FORK_H
+
+#include <mv_types.h>
+#include <shim_vm_t.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    /**
+     * <!-- description -->
+     *   @brief Turns the provided VM into a copy-on-write fork of the
+     *     provided parent VM (see KVM_CAP_MICROV_FORK). Every region of
+     *     the parent's slots that is mapped into MicroV is shared with the
+     *     VM read-only, so the cost of a fork is proportional to the
+     *     memory the parent has touched and not the size of its slots.
+     *     The first write to a shared page gives the VM its own copy of
+     *     that page (see handle_vcpu_kvm_run).
+     *
+     *   @note The VM must have the same slots as the parent, each of which
+     *     must be a private mapping of the memory that backs the parent's
+     *     slot, and it must not have any VCPUs yet. VCPU state is cloned
+     *     by userspace using the existing register IOCTLs. The parent
+     *     must not run while it has children.
+     *
+     * <!-- inputs/outputs -->
+     *   @param pmut_vm the VM to fork into
+     *   @param pmut_parent the VM to fork
+     *   @return SHIM_SUCCESS on success, SHIM_FAILURE on failure.
+     */
+    NODISCARD int64_t
+    shim_vm_fork(struct shim_vm_t *const pmut_vm, struct shim_vm_t *const pmut_parent) NOEXCEPT;
+
+    /**
+     * <!-- description -->
+     *   @brief Removes the provided VM from the children of the VM it was
+     *     forked from. This must be called before a forked VM is destroyed.
+     *     If the VM was not forked, this function does nothing.
+     *
+     * <!-- inputs/outputs -->
+     *   @param pmut_vm the VM to remove
+     *   @return Returns 1 if the VM was the last child of a parent that
+     *     userspace has already released, in which case the caller must
+     *     release the parent. Returns 0 otherwise.
+     */
+    NODISCARD int shim_vm_unfork(struct shim_vm_t *const pmut_vm) NOEXCEPT;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
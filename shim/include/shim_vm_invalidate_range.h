@@ -0,0 +1,73 @@
+/**
+ * @copyright
+ * Copyright (C) 2020 Assured Information Security, Inc.
+ *
+ * @copyright
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * @copyright
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * @copyright
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef SHIM_VM_INVALIDATE_RANGE_H
+#define SHIM_VM_INVALIDATE_RANGE_H
+
+#include <mv_types.h>
+#include <shim_vm_t.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    /**
+     * <!-- description -->
+     *   @brief Tells the shim that the host is about to change its
+     *     mappings of the userspace addresses [start, end), for example
+     *     because the pages are being swapped out, migrated or merged.
+     *     Every region of a slot that overlaps this range and has been
+     *     mapped into MicroV is unmapped, and until the matching call to
+     *     shim_vm_invalidate_range_end, no new regions are mapped. The
+     *     regions are mapped again the next time the guest touches them.
+     *
+     * <!-- inputs/outputs -->
+     *   @param pmut_vm the VM whose memory is being invalidated
+     *   @param start the first userspace address being invalidated
+     *   @param end the userspace address after the last address being
+     *     invalidated
+     *   @return SHIM_SUCCESS on success, SHIM_FAILURE on failure.
+     */
+    NODISCARD int64_t shim_vm_invalidate_range_start(
+        struct shim_vm_t *const pmut_vm, uint64_t const start, uint64_t const end) NOEXCEPT;
+
+    /**
+     * <!-- description -->
+     *   @brief Tells the shim that the host has finished changing the
+     *     mappings that were provided to shim_vm_invalidate_range_start.
+     *
+     * <!-- inputs/outputs -->
+     *   @param pmut_vm the VM whose memory was invalidated
+     */
+    void shim_vm_invalidate_range_end(struct shim_vm_t *const pmut_vm) NOEXCEPT;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -27,6 +27,7 @@
 #ifndef SHIM_VM_T_H
 #define SHIM_VM_T_H
 
+#include <kvm_msr_filter.h>
 #include <kvm_userspace_memory_region.h>
 #include <mv_constants.h>
 #include <mv_types.h>
@@ -39,6 +40,13 @@ extern "C"
 {
 #endif
 
+/**
+ * @brief defines the size in bytes of the region of a slot that is mapped
+ *   into MicroV each time the guest touches memory in that slot that has
+ *   not been mapped yet
+ */
+#define SHIM_VM_POPULATE_SIZE ((uint64_t)0x200000)
+
 #pragma pack(push, 1)
 
     /**
@@ -66,10 +74,82 @@ extern "C"
 
         /** @brief stores the memory slots associated with this VM */
         struct kvm_userspace_memory_region slots[MICROV_MAX_SLOTS];
+        /** @brief stores a bitmap of the regions of each slot that have been mapped */
+        uint64_t *populated[MICROV_MAX_SLOTS];
+        /** @brief stores a bitmap of the populated regions of each slot shared with a parent VM */
+        uint64_t *shared[MICROV_MAX_SLOTS];
+        /** @brief stores the number of host invalidations that are in progress */
+        uint64_t invalidate_in_progress;
+        /** @brief incremented each time the host starts an invalidation */
+        uint64_t invalidate_seq;
+        /** @brief stores the notifier used to learn about host invalidations */
+        platform_mmu_notifier mmu_notifier;
+
+        /** @brief stores the VM this VM was forked from (NULL if not forked) */
+        struct shim_vm_t *parent;
+        /** @brief stores the first VM that was forked from this VM */
+        struct shim_vm_t *children;
+        /** @brief stores the next VM that was forked from the same parent */
+        struct shim_vm_t *sibling;
+
+        /** @brief stores the size in bytes of each VCPU's dirty ring (0 if disabled) */
+        uint64_t dirty_ring_size;
+
+        /** @brief stores the KVM_MSR_EXIT_REASON_xxx enabled by KVM_CAP_X86_USER_SPACE_MSR */
+        uint64_t msr_exit_reasons;
+        /** @brief stores the filter set by KVM_X86_SET_MSR_FILTER */
+        struct kvm_msr_filter msr_filter;
+        /** @brief stores the shim's copy of the bitmap of each range of msr_filter */
+        uint8_t *msr_filter_bitmaps[KVM_MSR_FILTER_MAX_RANGES];
+
+        /** @brief stores the index of the VCPU last yielded to on a PAUSE exit */
+        uint64_t last_boosted;
     };
 
 #pragma pack(pop)
 
+    /**
+     * <!-- description -->
+     *   @brief Returns the size in bytes of the bitmap needed to track
+     *     which SHIM_VM_POPULATE_SIZE regions of the provided slot have
+     *     been mapped. Regions are aligned to SHIM_VM_POPULATE_SIZE in the
+     *     guest physical address space, and each region is a single bit.
+     *
+     * <!-- inputs/outputs -->
+     *   @param slot the slot to query
+     *   @return Returns the size in bytes of the bitmap needed to track
+     *     which regions of the provided slot have been mapped.
+     */
+    NODISCARD static inline uint64_t
+    shim_vm_populated_size(struct kvm_userspace_memory_region const *const slot) NOEXCEPT
+    {
+        uint64_t const one = ((uint64_t)1);
+        uint64_t const bits = ((uint64_t)64);
+        uint64_t const mask = ~(SHIM_VM_POPULATE_SIZE - one);
+        uint64_t const first = slot->guest_phys_addr & mask;
+        uint64_t const last = (slot->guest_phys_addr + slot->memory_size - one) & mask;
+        uint64_t const regions = ((last - first) / SHIM_VM_POPULATE_SIZE) + one;
+
+        return ((regions + bits - one) / bits) * sizeof(uint64_t);
+    }
+
+    /**
+     * <!-- description -->
+     *   @brief Returns the size in bytes of the bitmap of the provided
+     *     kvm_msr_filter_range, where each MSR of the range is a single bit.
+     *
+     * <!-- inputs/outputs -->
+     *   @param range the range to query
+     *   @return Returns the size in bytes of the bitmap of the provided
+     *     kvm_msr_filter_range.
+     */
+    NODISCARD static inline uint64_t
+    shim_vm_msr_filter_bitmap_size(struct kvm_msr_filter_range const *const range) NOEXCEPT
+    {
+        uint64_t const bits = ((uint64_t)8);
+        return ((uint64_t)range->nmsrs + bits - ((uint64_t)1)) / bits;
+    }
+
 #ifdef __cplusplus
 }
 #endif
@@ -52,6 +52,7 @@
 #include <kvm_lapic_state.h>
 #include <kvm_mp_state.h>
 #include <kvm_msi.h>
+#include <kvm_msr_filter.h>
 #include <kvm_msr_list.h>
 #include <kvm_msrs.h>
 #include <kvm_nested_state.h>
@@ -244,5 +245,9 @@
 #define KVM_GET_SUPPORTED_HV_CPUID _IOWR(SHIMIO, 0xc1, struct kvm_cpuid2)
 /** @brief defines KVM's KVM_SET_PMU_EVENT_FILTER IOCTL */
 #define KVM_SET_PMU_EVENT_FILTER _IOW(SHIMIO, 0xb2, struct kvm_pmu_event_filter)
+/** @brief defines KVM's KVM_X86_SET_MSR_FILTER IOCTL */
+#define KVM_X86_SET_MSR_FILTER _IOW(SHIMIO, 0xc6, struct kvm_msr_filter)
+/** @brief defines KVM's KVM_RESET_DIRTY_RINGS IOCTL */
+#define KVM_RESET_DIRTY_RINGS _IO(SHIMIO, 0xc7)
 
 #endif
@@ -50,4 +50,10 @@
  */
 #define SHIM_INTERRUPTED ((int64_t)-EINTR)
 
+/**
+ * @brief Returned by a shim function when a buffer provided by the
+ *   caller is too small.
+ */
+#define SHIM_2BIG ((int64_t)-E2BIG)
+
 #endif
@@ -31,19 +31,36 @@
 #include <handle_system_kvm_create_vm.h>
 #include <handle_system_kvm_destroy_vm.h>
 #include <handle_system_kvm_get_api_version.h>
+#include <handle_system_kvm_get_supported_cpuid.h>
 #include <handle_system_kvm_get_vcpu_mmap_size.h>
+#include <handle_vcpu_kvm_get_device_attr.h>
 #include <handle_vcpu_kvm_get_regs.h>
 #include <handle_vcpu_kvm_get_sregs.h>
+#include <handle_vcpu_kvm_get_tsc_khz.h>
+#include <handle_vcpu_kvm_has_device_attr.h>
 #include <handle_vcpu_kvm_run.h>
+#include <handle_vcpu_kvm_set_cpuid2.h>
+#include <handle_vcpu_kvm_set_device_attr.h>
 #include <handle_vcpu_kvm_set_regs.h>
 #include <handle_vcpu_kvm_set_sregs.h>
+#include <handle_vcpu_kvm_set_tsc_khz.h>
 #include <handle_vm_kvm_check_extension.h>
+#include <handle_vm_kvm_clear_dirty_log.h>
 #include <handle_vm_kvm_create_vcpu.h>
 #include <handle_vm_kvm_destroy_vcpu.h>
+#include <handle_vm_kvm_enable_cap.h>
+#include <handle_vm_kvm_get_clock.h>
+#include <handle_vm_kvm_get_dirty_log.h>
+#include <handle_vm_kvm_reset_dirty_rings.h>
+#include <handle_vm_kvm_set_clock.h>
 #include <handle_vm_kvm_set_user_memory_region.h>
+#include <handle_vm_kvm_x86_set_msr_filter.h>
+#include <kvm_constants.h>
 #include <linux/anon_inodes.h>
+#include <linux/file.h>
 #include <linux/kernel.h>
 #include <linux/miscdevice.h>
+#include <linux/mmu_notifier.h>
 #include <linux/module.h>
 #include <linux/notifier.h>
 #include <linux/reboot.h>
@@ -55,6 +72,8 @@
 #include <shim_fini.h>
 #include <shim_init.h>
 #include <shim_platform_interface.h>
+#include <shim_vm_fork.h>
+#include <shim_vm_invalidate_range.h>
 #include <shim_vm_t.h>
 
 static int
@@ -79,9 +98,23 @@ static int
 vm_release_impl(struct shim_vm_t *const pmut_vm)
 {
     uint64_t mut_i;
+    struct shim_vm_t *pmut_mut_parent;
+    struct shim_vm_t *pmut_mut_children;
+    int mut_release_parent;
 
     platform_expects(NULL != pmut_vm);
+
+    /// NOTE:
+    /// - The fd is cleared while holding the lock so that a child that is
+    ///   being released at the same time (see shim_vm_unfork) either sees
+    ///   that we still have an fd, or we see that it is no longer one of
+    ///   our children, but never both.
+    ///
+
+    platform_mutex_lock(&pmut_vm->mutex);
     pmut_vm->fd = 0;
+    pmut_mut_children = pmut_vm->children;
+    platform_mutex_unlock(&pmut_vm->mutex);
 
     for (mut_i = ((uint64_t)0); mut_i < MICROV_MAX_VCPUS; ++mut_i) {
         if (0 != (int32_t)pmut_vm->vcpus[mut_i].fd) {
@@ -89,11 +122,28 @@ vm_release_impl(struct shim_vm_t *const pmut_vm)
         }
     }
 
+    /// NOTE:
+    /// - A VM that was forked still has its memory mapped into its
+    ///   children, so it is released by its last child instead.
+    ///
+
+    if (NULL != pmut_mut_children) {
+        return 0;
+    }
+
+    pmut_mut_parent = pmut_vm->parent;
+    mut_release_parent = shim_vm_unfork(pmut_vm);
+
+    mmu_notifier_unregister(&pmut_vm->mmu_notifier, pmut_vm->mmu_notifier.mm);
     handle_system_kvm_destroy_vm(pmut_vm);
 
     platform_mutex_destroy(&pmut_vm->mutex);
     vfree(pmut_vm);
 
+    if (0 != mut_release_parent) {
+        vm_release_impl(pmut_mut_parent);
+    }
+
     return 0;
 }
 
@@ -114,6 +164,11 @@ vcpu_release_impl(struct shim_vcpu_t *const pmut_vcpu)
 
     handle_vm_kvm_destroy_vcpu(pmut_vcpu);
 
+    vfree(pmut_vcpu->dirty_ring);
+    pmut_vcpu->dirty_ring = NULL;
+    pmut_vcpu->dirty_index = ((uint64_t)0);
+    pmut_vcpu->reset_index = ((uint64_t)0);
+
     platform_expects(NULL != pmut_vcpu->vm);
     if (0 == (int32_t)pmut_vcpu->vm->fd) {
         vm_release_impl(pmut_vcpu->vm);
@@ -144,6 +199,67 @@ static struct file_operations fops_vm;
 static struct file_operations fops_vcpu;
 static struct file_operations fops_device;
 
+/* -------------------------------------------------------------------------- */
+/* MMU Notifiers                                                              */
+/* -------------------------------------------------------------------------- */
+
+static int
+vm_invalidate_range_start(
+    struct mmu_notifier *const mn, struct mmu_notifier_range const *const range)
+{
+    struct shim_vm_t *const pmut_vm = container_of(mn, struct shim_vm_t, mmu_notifier);
+
+    /// NOTE:
+    /// - The VM's mutex might sleep, so if the caller cannot block (i.e.,
+    ///   the OOM reaper), it is told to try again later. In this case,
+    ///   vm_invalidate_range_end is not called.
+    ///
+
+    if (!mmu_notifier_range_blockable(range)) {
+        return -EAGAIN;
+    }
+
+    if (shim_vm_invalidate_range_start(pmut_vm, range->start, range->end)) {
+        bferror("shim_vm_invalidate_range_start failed");
+    }
+
+    return 0;
+}
+
+static void
+vm_invalidate_range_end(
+    struct mmu_notifier *const mn, struct mmu_notifier_range const *const range)
+{
+    struct shim_vm_t *const pmut_vm = container_of(mn, struct shim_vm_t, mmu_notifier);
+    (void)range;
+
+    shim_vm_invalidate_range_end(pmut_vm);
+}
+
+static void
+vm_mmu_release(struct mmu_notifier *const mn, struct mm_struct *const mm)
+{
+    struct shim_vm_t *const pmut_vm = container_of(mn, struct shim_vm_t, mmu_notifier);
+    (void)mm;
+
+    /// NOTE:
+    /// - The address space is going away, so everything that was mapped
+    ///   into MicroV has to be unmapped before the pages are freed.
+    ///
+
+    if (shim_vm_invalidate_range_start(pmut_vm, ((uint64_t)0), ULONG_MAX)) {
+        bferror("shim_vm_invalidate_range_start failed");
+    }
+
+    shim_vm_invalidate_range_end(pmut_vm);
+}
+
+static struct mmu_notifier_ops const vm_mmu_notifier_ops = {
+    .invalidate_range_start = vm_invalidate_range_start,
+    .invalidate_range_end = vm_invalidate_range_end,
+    .release = vm_mmu_release,
+};
+
 /* -------------------------------------------------------------------------- */
 /* System IOCTLs                                                              */
 /* -------------------------------------------------------------------------- */
@@ -180,16 +296,25 @@ dispatch_system_kvm_create_vm(void)
         goto vmalloc_failed;
     }
 
+    pmut_vm->mmu_notifier.ops = &vm_mmu_notifier_ops;
+    if (mmu_notifier_register(&pmut_vm->mmu_notifier, current->mm)) {
+        bferror("mmu_notifier_register failed");
+        goto handle_system_kvm_create_vm_failed;
+    }
+
     snprintf(name, sizeof(name), "kvm-vm:%d", pmut_vm->id);
 
     pmut_vm->fd = anon_inode_getfd(name, &fops_vm, pmut_vm, O_RDWR | O_CLOEXEC);
     if ((int32_t)pmut_vm->fd < 0) {
         bferror("anon_inode_getfd failed");
-        goto handle_system_kvm_create_vm_failed;
+        goto mmu_notifier_register_failed;
     }
 
     return (long)pmut_vm->fd;
 
+mmu_notifier_register_failed:
+    mmu_notifier_unregister(&pmut_vm->mmu_notifier, current->mm);
+
 handle_system_kvm_create_vm_failed:
     handle_system_kvm_destroy_vm(pmut_vm);
 
@@ -237,9 +362,62 @@ dispatch_system_kvm_get_msrs(struct kvm_msrs *const ioctl_args)
 }
 
 static long
-dispatch_system_kvm_get_supported_cpuid(struct kvm_cpuid2 *const ioctl_args)
+dispatch_system_kvm_get_supported_cpuid(struct kvm_cpuid2 *const user_args)
 {
-    (void)ioctl_args;
+    int64_t mut_ret;
+    struct kvm_cpuid2 mut_args;
+    struct kvm_cpuid_entry2 *pmut_mut_entries;
+    uint64_t mut_size = sizeof(mut_args);
+
+    if (platform_copy_from_user(&mut_args, user_args, mut_size)) {
+        bferror("platform_copy_from_user failed");
+        return -EINVAL;
+    }
+
+    if (mut_args.nent < ((uint32_t)1)) {
+        bferror("kvm_cpuid2.nent is too small");
+        return -E2BIG;
+    }
+
+    if (mut_args.nent > (uint32_t)KVM_MAX_CPUID_ENTRIES) {
+        mut_args.nent = (uint32_t)KVM_MAX_CPUID_ENTRIES;
+    }
+
+    mut_size = sizeof(struct kvm_cpuid_entry2) * (uint64_t)mut_args.nent;
+    pmut_mut_entries = vmalloc(mut_size);
+    if (NULL == pmut_mut_entries) {
+        bferror("vmalloc failed");
+        return -ENOMEM;
+    }
+
+    mut_ret = handle_system_kvm_get_supported_cpuid(&mut_args, pmut_mut_entries);
+    if (SHIM_2BIG == mut_ret) {
+        vfree(pmut_mut_entries);
+        return -E2BIG;
+    }
+
+    if (mut_ret) {
+        bferror("handle_system_kvm_get_supported_cpuid failed");
+        goto handle_system_kvm_get_supported_cpuid_failed;
+    }
+
+    mut_size = sizeof(struct kvm_cpuid_entry2) * (uint64_t)mut_args.nent;
+    if (platform_copy_to_user(user_args + 1, pmut_mut_entries, mut_size)) {
+        bferror("platform_copy_to_user failed");
+        goto handle_system_kvm_get_supported_cpuid_failed;
+    }
+
+    if (platform_copy_to_user(user_args, &mut_args, sizeof(mut_args))) {
+        bferror("platform_copy_to_user failed");
+        goto handle_system_kvm_get_supported_cpuid_failed;
+    }
+
+    vfree(pmut_mut_entries);
+    return 0;
+
+handle_system_kvm_get_supported_cpuid_failed:
+    vfree(pmut_mut_entries);
+
     return -EINVAL;
 }
 
@@ -381,10 +559,24 @@ dispatch_vm_kvm_check_extension(
 }
 
 static long
-dispatch_vm_kvm_clear_dirty_log(struct kvm_clear_dirty_log *const ioctl_args)
+dispatch_vm_kvm_clear_dirty_log(
+    struct kvm_clear_dirty_log const *const user_args,
+    struct shim_vm_t *const pmut_vm)
 {
-    (void)ioctl_args;
-    return -EINVAL;
+    struct kvm_clear_dirty_log mut_args;
+    uint64_t const size = sizeof(mut_args);
+
+    if (platform_copy_from_user(&mut_args, user_args, size)) {
+        bferror("platform_copy_from_user failed");
+        return -EINVAL;
+    }
+
+    if (handle_vm_kvm_clear_dirty_log(&mut_args, pmut_vm)) {
+        bferror("handle_vm_kvm_clear_dirty_log failed");
+        return -EINVAL;
+    }
+
+    return 0;
 }
 
 static long
@@ -410,12 +602,12 @@ dispatch_vm_kvm_create_pit2(struct kvm_pit_config *const ioctl_args)
 }
 
 static long
-dispatch_vm_kvm_create_vcpu(struct shim_vm_t *const pmut_vm)
+dispatch_vm_kvm_create_vcpu(struct shim_vm_t *const pmut_vm, unsigned long const apic_id)
 {
     char name[24];
     struct shim_vcpu_t *pmut_mut_vcpu;
 
-    if (handle_vm_kvm_create_vcpu(pmut_vm, &pmut_mut_vcpu)) {
+    if (handle_vm_kvm_create_vcpu(pmut_vm, (uint32_t)apic_id, &pmut_mut_vcpu)) {
         bferror("handle_vm_kvm_create_vcpu failed");
         return -EINVAL;
     }
@@ -423,6 +615,17 @@ dispatch_vm_kvm_create_vcpu(struct shim_vm_t *const pmut_vm)
     pmut_mut_vcpu->run = vmalloc_user(sizeof(struct kvm_run));
     platform_expects(NULL != pmut_mut_vcpu->run);
 
+    if (((uint64_t)0) != pmut_vm->dirty_ring_size) {
+        pmut_mut_vcpu->dirty_ring = vmalloc_user(pmut_vm->dirty_ring_size);
+        if (NULL == pmut_mut_vcpu->dirty_ring) {
+            bferror("vmalloc_user failed");
+            goto handle_vm_kvm_create_vcpu_failed;
+        }
+
+        pmut_mut_vcpu->dirty_index = ((uint64_t)0);
+        pmut_mut_vcpu->reset_index = ((uint64_t)0);
+    }
+
     platform_expects(NULL != pmut_mut_vcpu);
     snprintf(name, sizeof(name), "kvm-vcpu:%d", pmut_mut_vcpu->id);
 
@@ -438,16 +641,93 @@ dispatch_vm_kvm_create_vcpu(struct shim_vm_t *const pmut_vm)
     return (long)pmut_mut_vcpu->fd;
 
 handle_vm_kvm_create_vcpu_failed:
+    vfree(pmut_mut_vcpu->dirty_ring);
+    pmut_mut_vcpu->dirty_ring = NULL;
+
     handle_vm_kvm_destroy_vcpu(pmut_mut_vcpu);
 
     return -EINVAL;
 }
 
 static long
-dispatch_vm_kvm_get_clock(struct kvm_clock_data *const ioctl_args)
+dispatch_vm_kvm_enable_cap_microv_fork(
+    struct kvm_enable_cap const *const args, struct shim_vm_t *const pmut_vm)
 {
-    (void)ioctl_args;
-    return -EINVAL;
+    struct file *pmut_mut_parent;
+    long mut_ret = 0;
+
+    if (((uint32_t)0) != args->flags) {
+        bferror_x64("args->flags is invalid", (uint64_t)args->flags);
+        return -EINVAL;
+    }
+
+    pmut_mut_parent = fget((unsigned int)args->args[0]);
+    if (NULL == pmut_mut_parent) {
+        bferror("args->args[0] is not a file descriptor");
+        return -EBADF;
+    }
+
+    if (&fops_vm != pmut_mut_parent->f_op) {
+        bferror("args->args[0] is not a VM");
+        fput(pmut_mut_parent);
+        return -EINVAL;
+    }
+
+    if (shim_vm_fork(pmut_vm, (struct shim_vm_t *)pmut_mut_parent->private_data)) {
+        bferror("shim_vm_fork failed");
+        mut_ret = -EINVAL;
+    }
+
+    fput(pmut_mut_parent);
+    return mut_ret;
+}
+
+static long
+dispatch_vm_kvm_enable_cap(
+    struct kvm_enable_cap const *const user_args, struct shim_vm_t *const pmut_vm)
+{
+    struct kvm_enable_cap mut_args;
+    uint64_t const size = sizeof(mut_args);
+
+    if (platform_copy_from_user(&mut_args, user_args, size)) {
+        bferror("platform_copy_from_user failed");
+        return -EINVAL;
+    }
+
+    /// NOTE:
+    /// - KVM_CAP_MICROV_FORK takes the file descriptor of the parent VM,
+    ///   which can only be resolved here.
+    ///
+
+    if (KVM_CAP_MICROV_FORK == mut_args.cap) {
+        return dispatch_vm_kvm_enable_cap_microv_fork(&mut_args, pmut_vm);
+    }
+
+    if (handle_vm_kvm_enable_cap(&mut_args, pmut_vm)) {
+        bferror("handle_vm_kvm_enable_cap failed");
+        return -EINVAL;
+    }
+
+    return 0;
+}
+
+static long
+dispatch_vm_kvm_get_clock(
+    struct kvm_clock_data *const user_args, struct shim_vm_t const *const vm)
+{
+    struct kvm_clock_data mut_args;
+
+    if (handle_vm_kvm_get_clock(vm, &mut_args)) {
+        bferror("handle_vm_kvm_get_clock failed");
+        return -EINVAL;
+    }
+
+    if (platform_copy_to_user(user_args, &mut_args, sizeof(mut_args))) {
+        bferror("platform_copy_to_user failed");
+        return -EINVAL;
+    }
+
+    return 0;
 }
 
 static long
@@ -465,10 +745,24 @@ dispatch_vm_kvm_get_device_attr(struct kvm_device_attr *const ioctl_args)
 }
 
 static long
-dispatch_vm_kvm_get_dirty_log(struct kvm_dirty_log *const ioctl_args)
+dispatch_vm_kvm_get_dirty_log(
+    struct kvm_dirty_log const *const user_args,
+    struct shim_vm_t *const pmut_vm)
 {
-    (void)ioctl_args;
-    return -EINVAL;
+    struct kvm_dirty_log mut_args;
+    uint64_t const size = sizeof(mut_args);
+
+    if (platform_copy_from_user(&mut_args, user_args, size)) {
+        bferror("platform_copy_from_user failed");
+        return -EINVAL;
+    }
+
+    if (handle_vm_kvm_get_dirty_log(&mut_args, pmut_vm)) {
+        bferror("handle_vm_kvm_get_dirty_log failed");
+        return -EINVAL;
+    }
+
+    return 0;
 }
 
 static long
@@ -534,6 +828,19 @@ dispatch_vm_kvm_reinject_control(void)
     return -EINVAL;
 }
 
+static long
+dispatch_vm_kvm_reset_dirty_rings(struct shim_vm_t *const pmut_vm)
+{
+    uint32_t mut_ret;
+
+    if (handle_vm_kvm_reset_dirty_rings(pmut_vm, &mut_ret)) {
+        bferror("handle_vm_kvm_reset_dirty_rings failed");
+        return -EINVAL;
+    }
+
+    return (long)mut_ret;
+}
+
 static long
 dispatch_vm_kvm_set_boot_cpu_id(void)
 {
@@ -541,10 +848,23 @@ dispatch_vm_kvm_set_boot_cpu_id(void)
 }
 
 static long
-dispatch_vm_kvm_set_clock(struct kvm_clock_data *const ioctl_args)
+dispatch_vm_kvm_set_clock(
+    struct kvm_clock_data const *const user_args, struct shim_vm_t const *const vm)
 {
-    (void)ioctl_args;
-    return -EINVAL;
+    struct kvm_clock_data mut_args;
+    uint64_t const size = sizeof(mut_args);
+
+    if (platform_copy_from_user(&mut_args, user_args, size)) {
+        bferror("platform_copy_from_user failed");
+        return -EINVAL;
+    }
+
+    if (handle_vm_kvm_set_clock(&mut_args, vm)) {
+        bferror("handle_vm_kvm_set_clock failed");
+        return -EINVAL;
+    }
+
+    return 0;
 }
 
 static long
@@ -639,6 +959,27 @@ dispatch_vm_kvm_unregister_coalesced_mmio(
     return -EINVAL;
 }
 
+static long
+dispatch_vm_kvm_x86_set_msr_filter(
+    struct kvm_msr_filter const *const user_args,
+    struct shim_vm_t *const pmut_vm)
+{
+    struct kvm_msr_filter mut_args;
+    uint64_t const size = sizeof(mut_args);
+
+    if (platform_copy_from_user(&mut_args, user_args, size)) {
+        bferror("platform_copy_from_user failed");
+        return -EINVAL;
+    }
+
+    if (handle_vm_kvm_x86_set_msr_filter(&mut_args, pmut_vm)) {
+        bferror("handle_vm_kvm_x86_set_msr_filter failed");
+        return -EINVAL;
+    }
+
+    return 0;
+}
+
 static long
 dispatch_vm_kvm_xen_hvm_config(struct kvm_xen_hvm_config *const ioctl_args)
 {
@@ -664,7 +1005,7 @@ dev_unlocked_ioctl_vm(
 
         case KVM_CLEAR_DIRTY_LOG: {
             return dispatch_vm_kvm_clear_dirty_log(
-                (struct kvm_clear_dirty_log *)ioctl_args);
+                (struct kvm_clear_dirty_log const *)ioctl_args, pmut_mut_vm);
         }
 
         case KVM_CREATE_DEVICE: {
@@ -682,12 +1023,17 @@ dev_unlocked_ioctl_vm(
         }
 
         case KVM_CREATE_VCPU: {
-            return dispatch_vm_kvm_create_vcpu(pmut_mut_vm);
+            return dispatch_vm_kvm_create_vcpu(pmut_mut_vm, ioctl_args);
+        }
+
+        case KVM_ENABLE_CAP: {
+            return dispatch_vm_kvm_enable_cap(
+                (struct kvm_enable_cap const *)ioctl_args, pmut_mut_vm);
         }
 
         case KVM_GET_CLOCK: {
             return dispatch_vm_kvm_get_clock(
-                (struct kvm_clock_data *)ioctl_args);
+                (struct kvm_clock_data *)ioctl_args, pmut_mut_vm);
         }
 
         case KVM_GET_DEBUGREGS: {
@@ -702,7 +1048,7 @@ dev_unlocked_ioctl_vm(
 
         case KVM_GET_DIRTY_LOG: {
             return dispatch_vm_kvm_get_dirty_log(
-                (struct kvm_dirty_log *)ioctl_args);
+                (struct kvm_dirty_log const *)ioctl_args, pmut_mut_vm);
         }
 
         case KVM_GET_IRQCHIP: {
@@ -747,13 +1093,17 @@ dev_unlocked_ioctl_vm(
             return dispatch_vm_kvm_reinject_control();
         }
 
+        case KVM_RESET_DIRTY_RINGS: {
+            return dispatch_vm_kvm_reset_dirty_rings(pmut_mut_vm);
+        }
+
         case KVM_SET_BOOT_CPU_ID: {
             return dispatch_vm_kvm_set_boot_cpu_id();
         }
 
         case KVM_SET_CLOCK: {
             return dispatch_vm_kvm_set_clock(
-                (struct kvm_clock_data *)ioctl_args);
+                (struct kvm_clock_data const *)ioctl_args, pmut_mut_vm);
         }
 
         case KVM_SET_DEBUGREGS: {
@@ -810,6 +1160,11 @@ dev_unlocked_ioctl_vm(
                 (struct kvm_coalesced_mmio_zone *)ioctl_args);
         }
 
+        case KVM_X86_SET_MSR_FILTER: {
+            return dispatch_vm_kvm_x86_set_msr_filter(
+                (struct kvm_msr_filter const *)ioctl_args, pmut_mut_vm);
+        }
+
         case KVM_XEN_HVM_CONFIG: {
             return dispatch_vm_kvm_xen_hvm_config(
                 (struct kvm_xen_hvm_config *)ioctl_args);
@@ -842,6 +1197,32 @@ dispatch_vcpu_kvm_get_cpuid2(struct kvm_cpuid2 *const ioctl_args)
     return -EINVAL;
 }
 
+static long
+dispatch_vcpu_kvm_get_device_attr(
+    struct shim_vcpu_t const *const vcpu, struct kvm_device_attr *const user_args)
+{
+    struct kvm_device_attr mut_args;
+    uint64_t mut_val;
+    uint64_t const size = sizeof(mut_args);
+
+    if (platform_copy_from_user(&mut_args, user_args, size)) {
+        bferror("platform_copy_from_user failed");
+        return -EINVAL;
+    }
+
+    if (handle_vcpu_kvm_get_device_attr(vcpu, &mut_args, &mut_val)) {
+        bferror("handle_vcpu_kvm_get_device_attr failed");
+        return -EINVAL;
+    }
+
+    if (platform_copy_to_user((void *)mut_args.addr, &mut_val, sizeof(mut_val))) {
+        bferror("platform_copy_to_user failed");
+        return -EINVAL;
+    }
+
+    return 0;
+}
+
 static long
 dispatch_vcpu_kvm_get_fpu(struct kvm_fpu *const ioctl_args)
 {
@@ -932,9 +1313,34 @@ dispatch_vcpu_kvm_get_supported_hv_cpuid(struct kvm_cpuid2 *const ioctl_args)
 }
 
 static long
-dispatch_vcpu_kvm_get_tsc_khz(void)
+dispatch_vcpu_kvm_get_tsc_khz(struct shim_vcpu_t const *const vcpu)
 {
-    return -EINVAL;
+    uint64_t mut_freq;
+
+    if (handle_vcpu_kvm_get_tsc_khz(vcpu, &mut_freq)) {
+        bferror("handle_vcpu_kvm_get_tsc_khz failed");
+        return -EINVAL;
+    }
+
+    return (long)mut_freq;
+}
+
+static long
+dispatch_vcpu_kvm_has_device_attr(struct kvm_device_attr *const user_args)
+{
+    struct kvm_device_attr mut_args;
+    uint64_t const size = sizeof(mut_args);
+
+    if (platform_copy_from_user(&mut_args, user_args, size)) {
+        bferror("platform_copy_from_user failed");
+        return -EINVAL;
+    }
+
+    if (handle_vcpu_kvm_has_device_attr(&mut_args)) {
+        return -EINVAL;
+    }
+
+    return 0;
 }
 
 static long
@@ -996,12 +1402,75 @@ dispatch_vcpu_kvm_set_cpuid(struct kvm_cpuid *const ioctl_args)
 }
 
 static long
-dispatch_vcpu_kvm_set_cpuid2(struct kvm_cpuid2 *const ioctl_args)
+dispatch_vcpu_kvm_set_cpuid2(
+    struct shim_vcpu_t const *const vcpu, struct kvm_cpuid2 *const user_args)
 {
-    (void)ioctl_args;
+    struct kvm_cpuid2 mut_args;
+    struct kvm_cpuid_entry2 *pmut_mut_entries;
+    uint64_t mut_size = sizeof(mut_args);
+
+    if (platform_copy_from_user(&mut_args, user_args, mut_size)) {
+        bferror("platform_copy_from_user failed");
+        return -EINVAL;
+    }
+
+    if (mut_args.nent > (uint32_t)KVM_MAX_CPUID_ENTRIES) {
+        bferror("kvm_cpuid2.nent is too large");
+        return -E2BIG;
+    }
+
+    mut_size = sizeof(struct kvm_cpuid_entry2) * (uint64_t)mut_args.nent;
+    pmut_mut_entries = vmalloc(mut_size + sizeof(struct kvm_cpuid_entry2));
+    if (NULL == pmut_mut_entries) {
+        bferror("vmalloc failed");
+        return -ENOMEM;
+    }
+
+    if (platform_copy_from_user(pmut_mut_entries, user_args + 1, mut_size)) {
+        bferror("platform_copy_from_user failed");
+        goto platform_copy_from_user_failed;
+    }
+
+    if (handle_vcpu_kvm_set_cpuid2(vcpu, &mut_args, pmut_mut_entries)) {
+        bferror("handle_vcpu_kvm_set_cpuid2 failed");
+        goto platform_copy_from_user_failed;
+    }
+
+    vfree(pmut_mut_entries);
+    return 0;
+
+platform_copy_from_user_failed:
+    vfree(pmut_mut_entries);
+
     return -EINVAL;
 }
 
+static long
+dispatch_vcpu_kvm_set_device_attr(
+    struct shim_vcpu_t *const pmut_vcpu, struct kvm_device_attr *const user_args)
+{
+    struct kvm_device_attr mut_args;
+    uint64_t mut_val;
+    uint64_t const size = sizeof(mut_args);
+
+    if (platform_copy_from_user(&mut_args, user_args, size)) {
+        bferror("platform_copy_from_user failed");
+        return -EINVAL;
+    }
+
+    if (platform_copy_from_user(&mut_val, (void *)mut_args.addr, sizeof(mut_val))) {
+        bferror("platform_copy_from_user failed");
+        return -EINVAL;
+    }
+
+    if (handle_vcpu_kvm_set_device_attr(pmut_vcpu, &mut_args, mut_val)) {
+        bferror("handle_vcpu_kvm_set_device_attr failed");
+        return -EINVAL;
+    }
+
+    return 0;
+}
+
 static long
 dispatch_vcpu_kvm_set_fpu(struct kvm_fpu *const ioctl_args)
 {
@@ -1099,9 +1568,15 @@ dispatch_vcpu_kvm_set_sregs(
 }
 
 static long
-dispatch_vcpu_kvm_set_tsc_khz(void)
+dispatch_vcpu_kvm_set_tsc_khz(
+    struct shim_vcpu_t *const pmut_vcpu, uint64_t const freq)
 {
-    return -EINVAL;
+    if (handle_vcpu_kvm_set_tsc_khz(pmut_vcpu, freq)) {
+        bferror("handle_vcpu_kvm_set_tsc_khz failed");
+        return -EINVAL;
+    }
+
+    return 0;
 }
 
 static long
@@ -1174,6 +1649,11 @@ dev_unlocked_ioctl_vcpu(
                 (struct kvm_cpuid2 *)ioctl_args);
         }
 
+        case KVM_GET_DEVICE_ATTR: {
+            return dispatch_vcpu_kvm_get_device_attr(
+                pmut_mut_vcpu, (struct kvm_device_attr *)ioctl_args);
+        }
+
         case KVM_GET_FPU: {
             return dispatch_vcpu_kvm_get_fpu((struct kvm_fpu *)ioctl_args);
         }
@@ -1218,7 +1698,7 @@ dev_unlocked_ioctl_vcpu(
         }
 
         case KVM_GET_TSC_KHZ: {
-            return dispatch_vcpu_kvm_get_tsc_khz();
+            return dispatch_vcpu_kvm_get_tsc_khz(pmut_mut_vcpu);
         }
 
         case KVM_GET_VCPU_EVENTS: {
@@ -1234,6 +1714,11 @@ dev_unlocked_ioctl_vcpu(
             return dispatch_vcpu_kvm_get_xsave((struct kvm_xsave *)ioctl_args);
         }
 
+        case KVM_HAS_DEVICE_ATTR: {
+            return dispatch_vcpu_kvm_has_device_attr(
+                (struct kvm_device_attr *)ioctl_args);
+        }
+
         case KVM_INTERRUPT: {
             return dispatch_vcpu_kvm_interrupt(
                 (struct kvm_interrupt *)ioctl_args);
@@ -1257,7 +1742,12 @@ dev_unlocked_ioctl_vcpu(
 
         case KVM_SET_CPUID2: {
             return dispatch_vcpu_kvm_set_cpuid2(
-                (struct kvm_cpuid2 *)ioctl_args);
+                pmut_mut_vcpu, (struct kvm_cpuid2 *)ioctl_args);
+        }
+
+        case KVM_SET_DEVICE_ATTR: {
+            return dispatch_vcpu_kvm_set_device_attr(
+                pmut_mut_vcpu, (struct kvm_device_attr *)ioctl_args);
         }
 
         case KVM_SET_FPU: {
@@ -1309,7 +1799,8 @@ dev_unlocked_ioctl_vcpu(
         }
 
         case KVM_SET_TSC_KHZ: {
-            return dispatch_vcpu_kvm_set_tsc_khz();
+            return dispatch_vcpu_kvm_set_tsc_khz(
+                pmut_mut_vcpu, (uint64_t)ioctl_args);
         }
 
         case KVM_SET_VCPU_EVENTS: {
@@ -1412,18 +1903,38 @@ static vm_fault_t
 dispatch_vcpu_mmap_fault(struct vm_fault *vmf)
 {
     struct shim_vcpu_t *pmut_mut_vcpu;
+    uint64_t mut_page;
 
     platform_expects(NULL != vmf);
 
-    if (vmf->pgoff != 0) {
-        bferror("a page offset of 0 is currently not supported");
-        return -EINVAL;
-    }
-
     pmut_mut_vcpu = (struct shim_vcpu_t *)vmf->vma->vm_file->private_data;
     platform_expects(NULL != pmut_mut_vcpu);
 
-    vmf->page = vmalloc_to_page(pmut_mut_vcpu->run);
+    if (((uint64_t)0) == vmf->pgoff) {
+        vmf->page = vmalloc_to_page(pmut_mut_vcpu->run);
+        get_page(vmf->page);
+
+        return 0;
+    }
+
+    if (NULL == pmut_mut_vcpu->dirty_ring) {
+        bferror("a page offset of 0 is the only one supported without a dirty ring");
+        return VM_FAULT_SIGBUS;
+    }
+
+    if (vmf->pgoff < KVM_DIRTY_LOG_PAGE_OFFSET) {
+        bferror("the page offset is not supported");
+        return VM_FAULT_SIGBUS;
+    }
+
+    mut_page = vmf->pgoff - KVM_DIRTY_LOG_PAGE_OFFSET;
+    if (mut_page >= (pmut_mut_vcpu->vm->dirty_ring_size / HYPERVISOR_PAGE_SIZE)) {
+        bferror("the page offset is outside of the dirty ring");
+        return VM_FAULT_SIGBUS;
+    }
+
+    vmf->page = vmalloc_to_page(
+        (uint8_t *)pmut_mut_vcpu->dirty_ring + (mut_page * HYPERVISOR_PAGE_SIZE));
     get_page(vmf->page);
 
     return 0;
@@ -30,6 +30,7 @@
 #include <asm/pgtable.h>
 #include <asm/pgtable_types.h>
 #include <debug.h>
+#include <linux/completion.h>
 #include <linux/cpu.h>
 #include <linux/mm.h>
 #include <linux/sched/mm.h>
@@ -37,6 +38,7 @@
 #include <linux/sched/task.h>
 #include <linux/slab.h>
 #include <linux/smp.h>
+#include <linux/timekeeping.h>
 #include <linux/unistd.h>
 #include <linux/vmalloc.h>
 #include <mv_types.h>
@@ -155,7 +157,10 @@ platform_virt_to_phys(void const *const virt) NOEXCEPT
  * <!-- description -->
  *   @brief Given a virtual address, this function returns the virtual
  *     address's physical address. Only works on memory owned by userspace.
- *     Returns ((void *)0) if the conversion failed.
+ *     Returns ((void *)0) if the conversion failed. Note that the
+ *     page is faulted in if needed, but it is not pinned, meaning
+ *     the result is only valid until the host invalidates the page
+ *     (see shim_vm_invalidate_range_start).
  *
  * <!-- inputs/outputs -->
  *   @param virt the virtual address to convert to a physical address
@@ -169,62 +174,21 @@ platform_virt_to_phys_user(uintptr_t const virt) NOEXCEPT
     uintptr_t phys;
     struct page *page[1];
 
-    pgd_t *pgd;
-    p4d_t *p4d;
-    pud_t *pud;
-    pmd_t *pmd;
-    pte_t *pte;
-
-    struct mm_struct *mm = current->mm;
-
-    /// QUESTION:
-    /// - This states that it pins the memory. Does this mean that there
-    ///   is no need to run mlock? Or does pin mean something else?
-    ///
-    /// - get_user_pages_fast was needed because if the memory was mapped
-    ///   using mmap using MAP_ANONYMOUS, pte_offset_map would fail.
-    ///   It would run great for mmapped files, and memory allocated using
-    ///   malloc and friends. It was only mmap using MAP_ANONYMOUS that
-    ///   seemed to have an issue.
+    /// NOTE:
+    /// - get_user_pages_fast faults the page in if needed and takes a
+    ///   reference to it, which is dropped right away. Guest memory is
+    ///   not pinned. Instead, each VM registers an mmu_notifier, and any
+    ///   page that the host invalidates is unmapped from MicroV before
+    ///   the host is allowed to reuse it (see entry.c).
     ///
 
-    if (get_user_pages_fast(virt, 1, 1, page) == 0) {
+    if (get_user_pages_fast(virt, 1, 1, page) != 1) {
         bferror_x64("get_user_pages_fast failed", virt);
         return ((uintptr_t)0);
     }
 
-    pgd = pgd_offset(mm, virt);
-    if (pgd_none(*pgd) || pgd_bad(*pgd)) {
-        bferror_x64("pgd_offset failed", virt);
-        return ((uintptr_t)0);
-    }
-
-    p4d = p4d_offset(pgd, virt);
-    if (p4d_none(*p4d) || p4d_bad(*p4d)) {
-        bferror_x64("p4d_offset failed", virt);
-        return ((uintptr_t)0);
-    }
-
-    pud = pud_offset(p4d, virt);
-    if (pud_none(*pud) || pud_bad(*pud)) {
-        bferror_x64("pud_offset failed", virt);
-        return ((uintptr_t)0);
-    }
-
-    pmd = pmd_offset(pud, virt);
-    if (pmd_none(*pmd) || pmd_bad(*pmd)) {
-        bferror_x64("pmd_offset failed", virt);
-        return ((uintptr_t)0);
-    }
-
-    pte = pte_offset_map(pmd, virt);
-    if (pte_none(*pte)) {
-        bferror_x64("pte_offset_map failed", virt);
-        return ((uintptr_t)0);
-    }
-
-    phys = page_to_phys(pte_page(*pte));
-    pte_unmap(pte);
+    phys = page_to_phys(page[0]);
+    put_page(page[0]);
 
     return phys;
 }
@@ -412,6 +376,21 @@ platform_current_cpu(void) NOEXCEPT
     return (uint32_t)raw_smp_processor_id();
 }
 
+/**
+ * <!-- description -->
+ *   @brief Returns the current wall clock time in nanoseconds since
+ *     the epoch.
+ *
+ * <!-- inputs/outputs -->
+ *   @return Returns the current wall clock time in nanoseconds since
+ *     the epoch.
+ */
+NODISCARD uint64_t
+platform_realtime_ns(void) NOEXCEPT
+{
+    return (uint64_t)ktime_get_real_ns();
+}
+
 /**
  * <!-- description -->
  *   @brief This function is called when the user calls platform_on_each_cpu.
@@ -593,6 +572,139 @@ platform_mutex_unlock(platform_mutex *const pmut_mutex) NOEXCEPT
     mutex_unlock(pmut_mutex);
 }
 
+/**
+ * <!-- description -->
+ *   @brief Initializes an event. This must be called before an
+ *     event can be used. Events start out cleared.
+ *
+ * <!-- inputs/outputs -->
+ *   @param pmut_event the event to initialize
+ */
+void
+platform_event_init(platform_event *const pmut_event) NOEXCEPT
+{
+    init_completion(pmut_event);
+}
+
+/**
+ * <!-- description -->
+ *   @brief Puts the current thread to sleep until the event is
+ *     signaled, and then clears the event. If the event was
+ *     signaled before this function was called, it returns right
+ *     away. Returns SHIM_INTERRUPTED if the current process was
+ *     interrupted while it was waiting.
+ *
+ * <!-- inputs/outputs -->
+ *   @param pmut_event the event to wait on
+ *   @return Returns SHIM_SUCCESS once the event is signaled, or
+ *     SHIM_INTERRUPTED if the current process was interrupted.
+ */
+NODISCARD int64_t
+platform_event_wait(platform_event *const pmut_event) NOEXCEPT
+{
+    if (wait_for_completion_interruptible(pmut_event)) {
+        return SHIM_INTERRUPTED;
+    }
+
+    /// NOTE:
+    /// - A completion counts how many times it was completed, but an
+    ///   event is either signaled or not, so any signals that arrived
+    ///   while this thread was waking up are dropped here as well.
+    ///
+
+    reinit_completion(pmut_event);
+
+    return SHIM_SUCCESS;
+}
+
+/**
+ * <!-- description -->
+ *   @brief Signals an event, waking up the thread that is waiting
+ *     on it (if any). This can be called from any thread.
+ *
+ * <!-- inputs/outputs -->
+ *   @param pmut_event the event to signal
+ */
+void
+platform_event_signal(platform_event *const pmut_event) NOEXCEPT
+{
+    complete(pmut_event);
+}
+
+/**
+ * <!-- description -->
+ *   @brief Returns the thread that is currently executing.
+ *
+ * <!-- inputs/outputs -->
+ *   @return Returns the thread that is currently executing.
+ */
+NODISCARD platform_thread
+platform_current_thread(void) NOEXCEPT
+{
+    return current;
+}
+
+/**
+ * <!-- description -->
+ *   @brief Takes a reference to the provided thread so that it
+ *     cannot be freed (even if it exits) until platform_thread_put
+ *     is called.
+ *
+ * <!-- inputs/outputs -->
+ *   @param thread the thread to take a reference to
+ */
+void
+platform_thread_get(platform_thread const thread) NOEXCEPT
+{
+    get_task_struct(thread);
+}
+
+/**
+ * <!-- description -->
+ *   @brief Releases a reference to the provided thread that was
+ *     taken using platform_thread_get.
+ *
+ * <!-- inputs/outputs -->
+ *   @param thread the thread to release the reference to
+ */
+void
+platform_thread_put(platform_thread const thread) NOEXCEPT
+{
+    put_task_struct(thread);
+}
+
+/**
+ * <!-- description -->
+ *   @brief Gives the rest of the current thread's time slice to the
+ *     provided thread. This only works if the provided thread is
+ *     runnable, but is not running. The caller must hold a
+ *     reference to the provided thread (see platform_thread_get).
+ *
+ * <!-- inputs/outputs -->
+ *   @param thread the thread to give the time slice to
+ *   @return Returns SHIM_SUCCESS if the time slice was given to the
+ *     provided thread, SHIM_FAILURE otherwise.
+ */
+NODISCARD int64_t
+platform_yield_to(platform_thread const thread) NOEXCEPT
+{
+    if (yield_to(thread, true) > 0) {
+        return SHIM_SUCCESS;
+    }
+
+    return SHIM_FAILURE;
+}
+
+/**
+ * <!-- description -->
+ *   @brief Gives up the rest of the current thread's time slice.
+ */
+void
+platform_yield(void) NOEXCEPT
+{
+    yield();
+}
+
 /**
  * <!-- description -->
  *   @brief Returns SHIM_SUCCESS if the current process has NOT been
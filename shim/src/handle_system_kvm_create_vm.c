@@ -32,10 +32,12 @@
 #include <mv_types.h>
 #include <platform.h>
 #include <shim_vm_t.h>
+#include <touch.h>
 
 /**
  * <!-- description -->
- *   @brief Handles the execution of kvm_create_vm.
+ *   @brief Handles the execution of kvm_create_vm. Like KVM, the kvmclock
+ *     of the new VM starts at 0, and its wall clock is the current time.
  *
  * <!-- inputs/outputs -->
  *   @param pmut_vm returns the resulting VM
@@ -61,6 +63,19 @@ handle_system_kvm_create_vm(struct shim_vm_t *const pmut_vm) NOEXCEPT
         return SHIM_FAILURE;
     }
 
+    if (mv_vm_op_clock_set(g_mut_hndl, pmut_vm->vmid, ((uint64_t)0), platform_realtime_ns())) {
+        bferror("mv_vm_op_clock_set failed");
+
+        if (mv_vm_op_destroy_vm(g_mut_hndl, pmut_vm->vmid)) {
+            bferror("mv_vm_op_destroy_vm failed");
+        }
+        else {
+            touch();
+        }
+
+        return SHIM_FAILURE;
+    }
+
     pmut_vm->id = pmut_vm->vmid;
     return SHIM_SUCCESS;
 }
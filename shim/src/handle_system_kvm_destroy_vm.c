@@ -26,11 +26,13 @@
 
 #include <detect_hypervisor.h>
 #include <g_mut_hndl.h>
+#include <kvm_msr_filter.h>
 #include <mv_constants.h>
 #include <mv_hypercall.h>
 #include <mv_types.h>
 #include <platform.h>
 #include <shim_vm_t.h>
+#include <touch.h>
 
 /**
  * <!-- description -->
@@ -43,10 +45,42 @@ void
 handle_system_kvm_destroy_vm(struct shim_vm_t *const pmut_vm) NOEXCEPT
 {
     mv_status_t mut_ret;
+    uint64_t mut_i;
 
     platform_expects(MV_INVALID_HANDLE != g_mut_hndl);
     platform_expects(NULL != pmut_vm);
 
+    for (mut_i = ((uint64_t)0); mut_i < MICROV_MAX_SLOTS; ++mut_i) {
+        if (NULL != pmut_vm->populated[mut_i]) {
+            platform_free(
+                pmut_vm->populated[mut_i], shim_vm_populated_size(&pmut_vm->slots[mut_i]));
+            pmut_vm->populated[mut_i] = NULL;
+        }
+        else {
+            touch();
+        }
+
+        if (NULL != pmut_vm->shared[mut_i]) {
+            platform_free(pmut_vm->shared[mut_i], shim_vm_populated_size(&pmut_vm->slots[mut_i]));
+            pmut_vm->shared[mut_i] = NULL;
+        }
+        else {
+            touch();
+        }
+    }
+
+    for (mut_i = ((uint64_t)0); mut_i < ((uint64_t)KVM_MSR_FILTER_MAX_RANGES); ++mut_i) {
+        if (NULL != pmut_vm->msr_filter_bitmaps[mut_i]) {
+            platform_free(
+                pmut_vm->msr_filter_bitmaps[mut_i],
+                shim_vm_msr_filter_bitmap_size(&pmut_vm->msr_filter.ranges[mut_i]));
+            pmut_vm->msr_filter_bitmaps[mut_i] = NULL;
+        }
+        else {
+            touch();
+        }
+    }
+
     if (detect_hypervisor()) {
         return;
     }
@@ -24,20 +24,89 @@
  * SOFTWARE.
  */
 
+#include <debug.h>
+#include <detect_hypervisor.h>
+#include <g_mut_hndl.h>
+#include <kvm_constants.h>
 #include <kvm_cpuid2.h>
+#include <kvm_cpuid_entry2.h>
+#include <mv_cdl_t.h>
+#include <mv_constants.h>
+#include <mv_cpuid_flag_t.h>
+#include <mv_hypercall.h>
 #include <mv_types.h>
+#include <platform.h>
+#include <shared_page_for_current_pp.h>
 
 /**
  * <!-- description -->
- *   @brief Handles the execution of kvm_check_extension.
+ *   @brief Handles the execution of kvm_get_supported_cpuid. MicroV
+ *     caches the supported CPUID leaves of each PP, so all of them are
+ *     returned using a single call to mv_pp_op_cpuid_get_supported_list.
  *
  * <!-- inputs/outputs -->
- *   @param pmut_ioctl_args the arguments provided by userspace
- *   @return SHIM_SUCCESS on success, SHIM_FAILURE on failure.
+ *   @param pmut_args the arguments provided by userspace. On success,
+ *     pmut_args->nent is set to the number of entries returned.
+ *   @param pmut_entries where to return the entries. Must be able to
+ *     hold pmut_args->nent entries.
+ *   @return SHIM_SUCCESS on success, SHIM_2BIG if pmut_args->nent is
+ *     too small, SHIM_FAILURE on failure.
  */
 NODISCARD int64_t
-handle_system_kvm_get_supported_cpuid(struct kvm_cpuid2 *const pmut_ioctl_args) NOEXCEPT
+handle_system_kvm_get_supported_cpuid(
+    struct kvm_cpuid2 *const pmut_args, struct kvm_cpuid_entry2 *const pmut_entries) NOEXCEPT
 {
-    (void)pmut_ioctl_args;
+    uint64_t mut_i;
+    struct mv_cdl_t *pmut_mut_cdl;
+    struct mv_cdl_entry_t const *mut_src_entry;
+    struct kvm_cpuid_entry2 *pmut_mut_dst_entry;
+
+    platform_expects(MV_INVALID_HANDLE != g_mut_hndl);
+    platform_expects(NULL != pmut_args);
+    platform_expects(NULL != pmut_entries);
+
+    if (detect_hypervisor()) {
+        bferror("The shim is not running in a VM. Did you forget to start MicroV?");
+        return SHIM_FAILURE;
+    }
+
+    pmut_mut_cdl = (struct mv_cdl_t *)shared_page_for_current_pp();
+    platform_expects(NULL != pmut_mut_cdl);
+
+    pmut_mut_cdl->num_entries = ((uint64_t)0);
+    if (mv_pp_op_cpuid_get_supported_list(g_mut_hndl)) {
+        bferror("mv_pp_op_cpuid_get_supported_list failed");
+        return SHIM_FAILURE;
+    }
+
+    if (pmut_mut_cdl->num_entries > MV_CDL_MAX_ENTRIES) {
+        bferror_x64("mv_cdl_t.num_entries is out of range", pmut_mut_cdl->num_entries);
+        return SHIM_FAILURE;
+    }
+
+    if (pmut_mut_cdl->num_entries > (uint64_t)pmut_args->nent) {
+        bferror_d32("kvm_cpuid2.nent is too small", pmut_args->nent);
+        return SHIM_2BIG;
+    }
+
+    for (mut_i = ((uint64_t)0); mut_i < pmut_mut_cdl->num_entries; ++mut_i) {
+        mut_src_entry = &pmut_mut_cdl->entries[mut_i];
+        pmut_mut_dst_entry = &pmut_entries[mut_i];
+
+        platform_memset(pmut_mut_dst_entry, ((uint8_t)0), sizeof(struct kvm_cpuid_entry2));
+
+        pmut_mut_dst_entry->function = mut_src_entry->fun;
+        pmut_mut_dst_entry->index = mut_src_entry->idx;
+        pmut_mut_dst_entry->eax = mut_src_entry->eax;
+        pmut_mut_dst_entry->ebx = mut_src_entry->ebx;
+        pmut_mut_dst_entry->ecx = mut_src_entry->ecx;
+        pmut_mut_dst_entry->edx = mut_src_entry->edx;
+
+        if (mv_cpuid_flag_t_significant_index == mut_src_entry->flags) {
+            pmut_mut_dst_entry->flags = (uint32_t)KVM_CPUID_FLAG_SIGNIFCANT_INDEX;
+        }
+    }
+
+    pmut_args->nent = (uint32_t)pmut_mut_cdl->num_entries;
     return SHIM_SUCCESS;
 }
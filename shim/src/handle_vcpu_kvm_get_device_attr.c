@@ -0,0 +1,69 @@
+/**
+ * @copyright
+ * Copyright (C) 2020 Assured Information Security, Inc.
+ *
+ * @copyright
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * @copyright
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * @copyright
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <debug.h>
+#include <detect_hypervisor.h>
+#include <kvm_device_attr.h>
+#include <mv_types.h>
+#include <platform.h>
+#include <shim_vcpu_t.h>
+
+/**
+ * <!-- description -->
+ *   @brief Handles the execution of kvm_get_device_attr for a VCPU. The
+ *     only attribute that is supported is KVM_VCPU_TSC_OFFSET in the
+ *     KVM_VCPU_TSC_CTRL group, which returns the TSC offset that was last
+ *     set by userspace.
+ *
+ * <!-- inputs/outputs -->
+ *   @param vcpu the VCPU to get the attribute from
+ *   @param args the arguments provided by userspace
+ *   @param pmut_val returns the value of the attribute
+ *   @return SHIM_SUCCESS on success, SHIM_FAILURE on failure.
+ */
+NODISCARD int64_t
+handle_vcpu_kvm_get_device_attr(
+    struct shim_vcpu_t const *const vcpu,
+    struct kvm_device_attr const *const args,
+    uint64_t *const pmut_val) NOEXCEPT
+{
+    platform_expects(NULL != vcpu);
+    platform_expects(NULL != args);
+    platform_expects(NULL != pmut_val);
+
+    if (detect_hypervisor()) {
+        bferror("The shim is not running in a VM. Did you forget to start MicroV?");
+        return SHIM_FAILURE;
+    }
+
+    if (KVM_VCPU_TSC_CTRL != args->group || KVM_VCPU_TSC_OFFSET != args->attr) {
+        bferror("unsupported vcpu device attribute");
+        return SHIM_FAILURE;
+    }
+
+    *pmut_val = vcpu->tsc_offset;
+    return SHIM_SUCCESS;
+}
@@ -24,17 +24,49 @@
  * SOFTWARE.
  */
 
+#include <debug.h>
+#include <detect_hypervisor.h>
+#include <g_mut_hndl.h>
+#include <mv_constants.h>
+#include <mv_hypercall.h>
 #include <mv_types.h>
+#include <platform.h>
+#include <shim_vcpu_t.h>
 
 /**
  * <!-- description -->
- *   @brief Handles the execution of kvm_get_tsc_khz.
+ *   @brief Handles the execution of kvm_get_tsc_khz. If the TSC frequency
+ *     of the VCPU was set using kvm_set_tsc_khz, that frequency is
+ *     returned. Otherwise, the VCPU runs at the frequency of the PP, which
+ *     MicroV measured when it was started.
  *
  * <!-- inputs/outputs -->
+ *   @param vcpu the VCPU to get the TSC frequency of
+ *   @param pmut_freq where to return the TSC frequency in KHz
  *   @return SHIM_SUCCESS on success, SHIM_FAILURE on failure.
  */
 NODISCARD int64_t
-handle_vcpu_kvm_get_tsc_khz(void) NOEXCEPT
+handle_vcpu_kvm_get_tsc_khz(
+    struct shim_vcpu_t const *const vcpu, uint64_t *const pmut_freq) NOEXCEPT
 {
+    platform_expects(MV_INVALID_HANDLE != g_mut_hndl);
+    platform_expects(NULL != vcpu);
+    platform_expects(NULL != pmut_freq);
+
+    if (detect_hypervisor()) {
+        bferror("The shim is not running in a VM. Did you forget to start MicroV?");
+        return SHIM_FAILURE;
+    }
+
+    if (((uint64_t)0) != vcpu->tsc_khz) {
+        *pmut_freq = vcpu->tsc_khz;
+        return SHIM_SUCCESS;
+    }
+
+    if (mv_pp_op_tsc_get_khz(g_mut_hndl, pmut_freq)) {
+        bferror("mv_pp_op_tsc_get_khz failed");
+        return SHIM_FAILURE;
+    }
+
     return SHIM_SUCCESS;
 }
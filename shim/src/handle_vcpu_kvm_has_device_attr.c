@@ -0,0 +1,55 @@
+/**
+ * @copyright
+ * Copyright (C) 2020 Assured Information Security, Inc.
+ *
+ * @copyright
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * @copyright
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * @copyright
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <kvm_device_attr.h>
+#include <mv_types.h>
+#include <platform.h>
+
+/**
+ * <!-- description -->
+ *   @brief Handles the execution of kvm_has_device_attr for a VCPU.
+ *     Returns SHIM_SUCCESS if the attribute is supported, otherwise
+ *     returns SHIM_FAILURE.
+ *
+ * <!-- inputs/outputs -->
+ *   @param args the arguments provided by userspace
+ *   @return SHIM_SUCCESS on success, SHIM_FAILURE on failure.
+ */
+NODISCARD int64_t
+handle_vcpu_kvm_has_device_attr(struct kvm_device_attr const *const args) NOEXCEPT
+{
+    platform_expects(NULL != args);
+
+    if (KVM_VCPU_TSC_CTRL != args->group) {
+        return SHIM_FAILURE;
+    }
+
+    if (KVM_VCPU_TSC_OFFSET != args->attr) {
+        return SHIM_FAILURE;
+    }
+
+    return SHIM_SUCCESS;
+}
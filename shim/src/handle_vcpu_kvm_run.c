@@ -27,16 +27,36 @@
 #include <debug.h>
 #include <detect_hypervisor.h>
 #include <g_mut_hndl.h>
+#include <handle_vcpu_kvm_get_regs.h>
+#include <handle_vcpu_kvm_get_sregs.h>
+#include <handle_vcpu_kvm_set_regs.h>
+#include <handle_vcpu_kvm_set_sregs.h>
+#include <kvm_dirty_gfn.h>
 #include <kvm_run.h>
 #include <kvm_run_io.h>
+#include <kvm_run_msr.h>
+#include <kvm_sync_regs.h>
+#include <kvm_userspace_memory_region.h>
 #include <mv_bit_size_t.h>
+#include <mv_constants.h>
+#include <mv_dirty_ring_t.h>
 #include <mv_exit_io_t.h>
+#include <mv_exit_kick_t.h>
+#include <mv_exit_mmio_t.h>
+#include <mv_exit_msr_t.h>
 #include <mv_exit_reason_t.h>
 #include <mv_hypercall.h>
+#include <mv_mdl_t.h>
+#include <mv_reg_t.h>
 #include <mv_types.h>
 #include <platform.h>
 #include <shared_page_for_current_pp.h>
 #include <shim_vcpu_t.h>
+#include <shim_vm_t.h>
+#include <touch.h>
+
+/** @brief defines the interrupt enable flag of RFLAGS */
+#define SHIM_RFLAGS_IF ((uint64_t)0x200)
 
 /**
  * <!-- description -->
@@ -69,6 +89,119 @@ get_offset(struct shim_vcpu_t const *const vcpu, void const *const ptr) NOEXCEPT
     return (uint64_t)((uint8_t const *)ptr - (uint8_t const *)vcpu->run);
 }
 
+/**
+ * <!-- description -->
+ *   @brief Returns the number of free entries in the VCPU's dirty ring.
+ *
+ * <!-- inputs/outputs -->
+ *   @param vcpu the VCPU associated with the IOCTL
+ *   @return Returns the number of free entries in the VCPU's dirty ring.
+ */
+NODISCARD static uint64_t
+dirty_ring_free(struct shim_vcpu_t const *const vcpu) NOEXCEPT
+{
+    uint64_t const entries = vcpu->vm->dirty_ring_size / sizeof(struct kvm_dirty_gfn);
+    return entries - (vcpu->dirty_index - vcpu->reset_index);
+}
+
+/**
+ * <!-- description -->
+ *   @brief Moves the dirty pages collected by MicroV for this VCPU into
+ *     the VCPU's dirty ring until either MicroV has nothing left to give
+ *     or the ring is full. If the VCPU does not have a dirty ring, this
+ *     function does nothing.
+ *
+ * <!-- inputs/outputs -->
+ *   @param pmut_vcpu the VCPU associated with the IOCTL
+ *   @return SHIM_SUCCESS on success, SHIM_FAILURE on failure.
+ */
+NODISCARD static int64_t
+harvest_dirty_ring(struct shim_vcpu_t *const pmut_vcpu) NOEXCEPT
+{
+    struct mv_dirty_ring_t *pmut_mut_ring;
+    struct kvm_dirty_gfn *pmut_mut_gfn;
+
+    uint64_t mut_i;
+    uint64_t mut_free;
+    uint64_t mut_requested;
+    uint64_t mut_mask;
+
+    if (NULL == pmut_vcpu->dirty_ring) {
+        return SHIM_SUCCESS;
+    }
+
+    platform_expects(NULL != pmut_vcpu->vm);
+    mut_mask = (pmut_vcpu->vm->dirty_ring_size / sizeof(struct kvm_dirty_gfn)) - ((uint64_t)1);
+
+    pmut_mut_ring = (struct mv_dirty_ring_t *)shared_page_for_current_pp();
+    platform_expects(NULL != pmut_mut_ring);
+
+    mut_free = dirty_ring_free(pmut_vcpu);
+    while (((uint64_t)0) != mut_free) {
+        mut_requested = mut_free;
+        if (mut_requested > MV_DIRTY_RING_MAX_ENTRIES) {
+            mut_requested = MV_DIRTY_RING_MAX_ENTRIES;
+        }
+        else {
+            touch();
+        }
+
+        pmut_mut_ring->num_entries = mut_requested;
+        if (mv_vs_op_dirty_ring_get(g_mut_hndl, pmut_vcpu->vsid)) {
+            bferror("mv_vs_op_dirty_ring_get failed");
+            return SHIM_FAILURE;
+        }
+
+        if (pmut_mut_ring->num_entries > mut_requested) {
+            bferror_x64("num_entries is out of bounds", pmut_mut_ring->num_entries);
+            return SHIM_FAILURE;
+        }
+
+        for (mut_i = ((uint64_t)0); mut_i < pmut_mut_ring->num_entries; ++mut_i) {
+            pmut_mut_gfn = &pmut_vcpu->dirty_ring[pmut_vcpu->dirty_index & mut_mask];
+
+            /// NOTE:
+            /// - Userspace polls the flags to know when an entry is ready,
+            ///   so they have to be written last.
+            ///
+
+            pmut_mut_gfn->slot = pmut_mut_ring->entries[mut_i].slot;
+            pmut_mut_gfn->offset = pmut_mut_ring->entries[mut_i].offset;
+            pmut_mut_gfn->flags = KVM_DIRTY_GFN_F_DIRTY;
+
+            ++pmut_vcpu->dirty_index;
+        }
+
+        if (pmut_mut_ring->num_entries < mut_requested) {
+            break;
+        }
+
+        mut_free -= mut_requested;
+    }
+
+    return SHIM_SUCCESS;
+}
+
+/**
+ * <!-- description -->
+ *   @brief Returns 1 if the VCPU has a dirty ring and it is full, meaning
+ *     userspace has to harvest and reset it before the VCPU can run
+ *     again. Returns 0 otherwise.
+ *
+ * <!-- inputs/outputs -->
+ *   @param vcpu the VCPU associated with the IOCTL
+ *   @return Returns 1 if the VCPU's dirty ring is full, 0 otherwise.
+ */
+NODISCARD static int
+dirty_ring_full(struct shim_vcpu_t const *const vcpu) NOEXCEPT
+{
+    if (NULL == vcpu->dirty_ring) {
+        return 0;
+    }
+
+    return (int)(((uint64_t)0) == dirty_ring_free(vcpu));
+}
+
 /**
  * <!-- description -->
  *   @brief Handles mv_exit_reason_t_failure
@@ -203,29 +336,795 @@ handle_vcpu_kvm_run_io(struct shim_vcpu_t *const pmut_vcpu) NOEXCEPT
 
 /**
  * <!-- description -->
- *   @brief Handles the execution of kvm_run.
+ *   @brief Handles mv_exit_reason_t_msr. MicroV only returns MSR accesses
+ *     that were filtered using KVM_X86_SET_MSR_FILTER. If userspace asked
+ *     for KVM_MSR_EXIT_REASON_FILTER, the access is returned to userspace
+ *     and completed by the next call to kvm_run, otherwise a #GP is
+ *     injected like KVM does for denied MSRs and the VCPU keeps running.
  *
  * <!-- inputs/outputs -->
  *   @param pmut_vcpu the VCPU associated with the IOCTL
+ *   @param pmut_exit where to return whether to return to userspace
  *   @return SHIM_SUCCESS on success, SHIM_FAILURE on failure.
  */
-NODISCARD int64_t
-handle_vcpu_kvm_run(struct shim_vcpu_t *const pmut_vcpu) NOEXCEPT
+NODISCARD static int64_t
+handle_vcpu_kvm_run_msr(struct shim_vcpu_t *const pmut_vcpu, int *const pmut_exit) NOEXCEPT
 {
-    enum mv_exit_reason_t mut_exit_reason;
-    platform_expects(NULL != pmut_vcpu);
-    platform_expects(NULL != pmut_vcpu->run);
+    uint64_t mut_reasons;
+    struct mv_exit_msr_t mut_exit_msr;
 
-    if (detect_hypervisor()) {
-        bferror("The shim is not running in a VM. Did you forget to start MicroV?");
+    struct mv_exit_msr_t const *const exit_msr =
+        (struct mv_exit_msr_t const *)shared_page_for_current_pp();
+    platform_expects(NULL != exit_msr);
+    platform_expects(NULL != pmut_vcpu->vm);
+
+    /// NOTE:
+    /// - The exit is copied out of the shared page before the VM's mutex
+    ///   is taken. Taking the mutex might sleep, after which this thread
+    ///   might be running on another PP, whose shared page belongs to
+    ///   whatever VCPU ran there last.
+    ///
+
+    mut_exit_msr = *exit_msr;
+
+    platform_mutex_lock(&pmut_vcpu->vm->mutex);
+    mut_reasons = pmut_vcpu->vm->msr_exit_reasons;
+    platform_mutex_unlock(&pmut_vcpu->vm->mutex);
+
+    switch (mut_exit_msr.flags) {
+        case MV_EXIT_MSR_READ: {
+            pmut_vcpu->run->exit_reason = KVM_EXIT_X86_RDMSR;
+            pmut_vcpu->run->msr.data = ((uint64_t)0);
+            break;
+        }
+
+        case MV_EXIT_MSR_WRITE: {
+            pmut_vcpu->run->exit_reason = KVM_EXIT_X86_WRMSR;
+            pmut_vcpu->run->msr.data = mut_exit_msr.msr.val;
+            break;
+        }
+
+        default: {
+            bferror_x64("flags is invalid/unsupported", mut_exit_msr.flags);
+            return return_failure(pmut_vcpu);
+        }
+    }
+
+    pmut_vcpu->run->msr.error = ((uint8_t)0);
+    pmut_vcpu->run->msr.reason = KVM_MSR_EXIT_REASON_FILTER;
+    pmut_vcpu->run->msr.index = (uint32_t)mut_exit_msr.msr.reg;
+
+    pmut_vcpu->msr_exit_flags = mut_exit_msr.flags;
+    pmut_vcpu->msr_exit_index = (uint32_t)mut_exit_msr.msr.reg;
+
+    /// NOTE:
+    /// - Either way, the access is completed by complete_msr_exit before
+    ///   the next mv_vs_op_run, as the shared page might be used for
+    ///   something else before then.
+    ///
+
+    if (((uint64_t)0) == (mut_reasons & (uint64_t)KVM_MSR_EXIT_REASON_FILTER)) {
+        pmut_vcpu->run->msr.error = ((uint8_t)1);
+        *pmut_exit = 0;
+    }
+    else {
+        *pmut_exit = 1;
+    }
+
+    return SHIM_SUCCESS;
+}
+
+/**
+ * <!-- description -->
+ *   @brief Handles mv_exit_reason_t_hlt. Interrupts are delivered by
+ *     userspace, so a VCPU that halted with interrupts enabled is
+ *     returned to userspace as KVM_EXIT_HLT, and runs again once
+ *     userspace has an interrupt for it. A VCPU that halted with
+ *     interrupts disabled cannot be woken by an interrupt. This is how
+ *     a paravirtual spinlock waits for the lock holder to kick it, so
+ *     the calling thread sleeps until another VCPU of the same VM kicks
+ *     it (see handle_vcpu_kvm_run_kick), or until the thread is
+ *     interrupted, in which case the exit is returned to userspace as
+ *     KVM_EXIT_INTR like any other signal.
+ *
+ * <!-- notes -->
+ *   @note Like KVM's pv_unhalted, a kick is remembered until the VCPU
+ *     waits for one, and waiting consumes it. A kick that arrives before
+ *     the VCPU halts (the lock was released between the guest deciding
+ *     to wait and executing HLT) is therefore not lost. A kick that is
+ *     never waited for (e.g. the VCPU halted with interrupts enabled)
+ *     makes the next wait return right away, which the guest handles
+ *     like any other spurious wake up by checking the lock again.
+ *
+ * <!-- inputs/outputs -->
+ *   @param pmut_vcpu the VCPU associated with the IOCTL
+ *   @param pmut_exit set to 1 if the exit must be returned to userspace,
+ *     0 otherwise.
+ *   @return SHIM_SUCCESS on success, SHIM_INTERRUPTED if the calling
+ *     thread was interrupted, SHIM_FAILURE on failure.
+ */
+NODISCARD static int64_t
+handle_vcpu_kvm_run_hlt(struct shim_vcpu_t *const pmut_vcpu, int *const pmut_exit) NOEXCEPT
+{
+    uint64_t mut_rflags;
+
+    if (mv_vs_op_reg_get(g_mut_hndl, pmut_vcpu->vsid, mv_reg_t_rflags, &mut_rflags)) {
+        bferror("mv_vs_op_reg_get failed");
         return return_failure(pmut_vcpu);
     }
 
+    if (((uint64_t)0) != (mut_rflags & SHIM_RFLAGS_IF)) {
+        pmut_vcpu->run->exit_reason = KVM_EXIT_HLT;
+        *pmut_exit = 1;
+        return SHIM_SUCCESS;
+    }
+
+    *pmut_exit = 0;
+    if (platform_event_wait(&pmut_vcpu->unhalt)) {
+        pmut_vcpu->run->exit_reason = KVM_EXIT_INTR;
+        return SHIM_INTERRUPTED;
+    }
+
+    return SHIM_SUCCESS;
+}
+
+/**
+ * <!-- description -->
+ *   @brief Handles mv_exit_reason_t_kick. The VCPU executed
+ *     KVM_HC_KICK_CPU to wake up the VCPU with the provided APIC ID,
+ *     which is halted waiting on a paravirtual spinlock. The kick is
+ *     delivered here without returning to userspace. Like KVM, kicking
+ *     an APIC ID that does not belong to a VCPU of the VM does nothing.
+ *
+ * <!-- inputs/outputs -->
+ *   @param pmut_vcpu the VCPU associated with the IOCTL
+ */
+static void
+handle_vcpu_kvm_run_kick(struct shim_vcpu_t *const pmut_vcpu) NOEXCEPT
+{
+    uint64_t mut_i;
+    uint64_t mut_apic_id;
+    struct shim_vm_t *pmut_mut_vm;
+    struct shim_vcpu_t *pmut_mut_target;
+
+    struct mv_exit_kick_t const *const exit_kick =
+        (struct mv_exit_kick_t const *)shared_page_for_current_pp();
+    platform_expects(NULL != exit_kick);
+
+    pmut_mut_vm = pmut_vcpu->vm;
+    platform_expects(NULL != pmut_mut_vm);
+
+    /// NOTE:
+    /// - Like handle_vcpu_kvm_run_msr, the APIC ID is read before the
+    ///   VM's mutex is taken, as this thread might migrate to another PP
+    ///   while it sleeps on the mutex.
+    ///
+
+    mut_apic_id = exit_kick->apic_id;
+
+    platform_mutex_lock(&pmut_mut_vm->mutex);
+    for (mut_i = ((uint64_t)0); mut_i < MICROV_MAX_VCPUS; ++mut_i) {
+        pmut_mut_target = &pmut_mut_vm->vcpus[mut_i];
+        if (((uint64_t)0) == pmut_mut_target->fd) {
+            continue;
+        }
+
+        if (mut_apic_id != (uint64_t)pmut_mut_target->apic_id) {
+            continue;
+        }
+
+        platform_event_signal(&pmut_mut_target->unhalt);
+        break;
+    }
+    platform_mutex_unlock(&pmut_mut_vm->mutex);
+}
+
+/**
+ * <!-- description -->
+ *   @brief Sets the VCPU's preempted_thread, which is the thread that
+ *     handle_vcpu_kvm_run_pause yields to. Only the thread running the
+ *     VCPU sets its preempted_thread, but it is read by the other VCPUs
+ *     of the VM, so it is only changed while holding the VM's mutex.
+ *
+ * <!-- inputs/outputs -->
+ *   @param pmut_vcpu the VCPU associated with the IOCTL
+ *   @param thread the thread to set preempted_thread to
+ */
+static void
+set_preempted_thread(struct shim_vcpu_t *const pmut_vcpu, platform_thread const thread) NOEXCEPT
+{
+    if (thread == pmut_vcpu->preempted_thread) {
+        return;
+    }
+
+    platform_mutex_lock(&pmut_vcpu->vm->mutex);
+    pmut_vcpu->preempted_thread = thread;
+    platform_mutex_unlock(&pmut_vcpu->vm->mutex);
+}
+
+/**
+ * <!-- description -->
+ *   @brief Returns the preempted_thread of the next VCPU of the VM that
+ *     can be yielded to, starting *pmut_i VCPUs after the one that was
+ *     given a time slice last. A reference is taken to the returned
+ *     thread, which the caller must release using platform_thread_put.
+ *     On return, *pmut_i and *pmut_idx are set to the offset and index
+ *     of the selected VCPU. If no VCPU can be yielded to, 0 is returned.
+ *
+ * <!-- inputs/outputs -->
+ *   @param pmut_vcpu the VCPU associated with the IOCTL
+ *   @param pmut_i the offset from last_boosted to start the search at
+ *   @param pmut_idx returns the index of the selected VCPU
+ *   @return Returns the (referenced) thread to yield to, or 0 if no
+ *     VCPU can be yielded to.
+ */
+NODISCARD static platform_thread
+get_preempted_thread(
+    struct shim_vcpu_t *const pmut_vcpu, uint64_t *const pmut_i, uint64_t *const pmut_idx) NOEXCEPT
+{
+    struct shim_vm_t *const pmut_vm = pmut_vcpu->vm;
+    struct shim_vcpu_t *pmut_mut_target;
+    platform_thread mut_thread = ((platform_thread)0);
+
+    platform_mutex_lock(&pmut_vm->mutex);
+    for (; *pmut_i <= MICROV_MAX_VCPUS; ++*pmut_i) {
+        *pmut_idx = (pmut_vm->last_boosted + *pmut_i) % MICROV_MAX_VCPUS;
+        pmut_mut_target = &pmut_vm->vcpus[*pmut_idx];
+        if (((uint64_t)0) == pmut_mut_target->fd) {
+            continue;
+        }
+
+        if (pmut_mut_target == pmut_vcpu) {
+            continue;
+        }
+
+        if (((platform_thread)0) == pmut_mut_target->preempted_thread) {
+            continue;
+        }
+
+        mut_thread = pmut_mut_target->preempted_thread;
+        platform_thread_get(mut_thread);
+        break;
+    }
+    platform_mutex_unlock(&pmut_vm->mutex);
+
+    return mut_thread;
+}
+
+/**
+ * <!-- description -->
+ *   @brief Handles mv_exit_reason_t_pause. The VCPU is spinning in a
+ *     PAUSE loop, most likely waiting on a lock held by another VCPU of
+ *     the same VM that was preempted. Like KVM, the rest of the calling
+ *     thread's time slice is given to a preempted VCPU, starting with
+ *     the VCPU after the one that was given a time slice last so that
+ *     every preempted VCPU gets a turn. If no preempted VCPU can be
+ *     given the time slice, the calling thread simply yields.
+ *
+ * <!-- inputs/outputs -->
+ *   @param pmut_vcpu the VCPU associated with the IOCTL
+ */
+static void
+handle_vcpu_kvm_run_pause(struct shim_vcpu_t *const pmut_vcpu) NOEXCEPT
+{
+    uint64_t mut_i;
+    uint64_t mut_idx;
+    platform_thread mut_thread;
+    int64_t mut_ret;
+
+    platform_expects(NULL != pmut_vcpu->vm);
+
+    /// NOTE:
+    /// - The VM's mutex is only held while a target is selected. The
+    ///   selected thread is pinned with a reference instead, so it
+    ///   cannot be freed while it is being yielded to, even if it leaves
+    ///   the shim and exits in the meantime. Like KVM, yielding to a
+    ///   thread that is no longer preempted simply fails, in which case
+    ///   the next preempted VCPU is tried.
+    ///
+
+    for (mut_i = ((uint64_t)1); mut_i <= MICROV_MAX_VCPUS; ++mut_i) {
+        mut_thread = get_preempted_thread(pmut_vcpu, &mut_i, &mut_idx);
+        if (((platform_thread)0) == mut_thread) {
+            break;
+        }
+
+        mut_ret = platform_yield_to(mut_thread);
+        platform_thread_put(mut_thread);
+
+        if (SHIM_SUCCESS == mut_ret) {
+            platform_mutex_lock(&pmut_vcpu->vm->mutex);
+            pmut_vcpu->vm->last_boosted = mut_idx;
+            platform_mutex_unlock(&pmut_vcpu->vm->mutex);
+            return;
+        }
+    }
+
+    platform_yield();
+}
+
+/**
+ * <!-- description -->
+ *   @brief If the last kvm_run returned an MSR access to userspace, this
+ *     gives MicroV the result that userspace stored in kvm_run.msr so that
+ *     the access is completed by the next mv_vs_op_run.
+ *
+ * <!-- inputs/outputs -->
+ *   @param pmut_vcpu the VCPU associated with the IOCTL
+ */
+static void
+complete_msr_exit(struct shim_vcpu_t *const pmut_vcpu) NOEXCEPT
+{
+    struct mv_exit_msr_t *pmut_mut_exit_msr;
+
+    if (((uint64_t)0) == pmut_vcpu->msr_exit_flags) {
+        return;
+    }
+
+    pmut_mut_exit_msr = (struct mv_exit_msr_t *)shared_page_for_current_pp();
+    platform_expects(NULL != pmut_mut_exit_msr);
+
+    pmut_mut_exit_msr->msr.reg = (uint64_t)pmut_vcpu->msr_exit_index;
+    pmut_mut_exit_msr->msr.val = pmut_vcpu->run->msr.data;
+    pmut_mut_exit_msr->flags = pmut_vcpu->msr_exit_flags;
+
+    if (((uint8_t)0) != pmut_vcpu->run->msr.error) {
+        pmut_mut_exit_msr->flags |= MV_EXIT_MSR_ERROR;
+    }
+    else {
+        touch();
+    }
+
+    pmut_vcpu->msr_exit_flags = ((uint64_t)0);
+}
+
+/**
+ * <!-- description -->
+ *   @brief Returns the slot that contains the provided GPA, or NULL if
+ *     the GPA is not in any of the VM's slots.
+ *
+ * <!-- inputs/outputs -->
+ *   @param vm the VM to query
+ *   @param gpa the GPA to look for
+ *   @param pmut_idx where to return the index of the slot
+ *   @return Returns the slot that contains the provided GPA, or NULL if
+ *     the GPA is not in any of the VM's slots.
+ */
+NODISCARD static struct kvm_userspace_memory_region const *
+find_slot(struct shim_vm_t const *const vm, uint64_t const gpa, uint64_t *const pmut_idx) NOEXCEPT
+{
+    uint64_t mut_i;
+    struct kvm_userspace_memory_region const *mut_slot;
+
+    for (mut_i = ((uint64_t)0); mut_i < MICROV_MAX_SLOTS; ++mut_i) {
+        mut_slot = &vm->slots[mut_i];
+        if (((uint64_t)0) == mut_slot->memory_size) {
+            continue;
+        }
+
+        if (gpa < mut_slot->guest_phys_addr) {
+            continue;
+        }
+
+        if ((mv_page_aligned(gpa) - mut_slot->guest_phys_addr) >= mut_slot->memory_size) {
+            continue;
+        }
+
+        *pmut_idx = mut_i;
+        return mut_slot;
+    }
+
+    return NULL;
+}
+
+/**
+ * <!-- description -->
+ *   @brief Returns the index of the SHIM_VM_POPULATE_SIZE region of the
+ *     provided slot that contains the provided GPA.
+ *
+ * <!-- inputs/outputs -->
+ *   @param slot the slot that contains the GPA
+ *   @param gpa the GPA to get the region for
+ *   @return Returns the index of the region of the slot containing gpa
+ */
+NODISCARD static uint64_t
+region_of(struct kvm_userspace_memory_region const *const slot, uint64_t const gpa) NOEXCEPT
+{
+    uint64_t const mask = ~(SHIM_VM_POPULATE_SIZE - ((uint64_t)1));
+    return ((gpa & mask) - (slot->guest_phys_addr & mask)) / SHIM_VM_POPULATE_SIZE;
+}
+
+/**
+ * <!-- description -->
+ *   @brief Returns 1 if the provided region of the provided slot has
+ *     already been mapped into MicroV. Returns 0 otherwise.
+ *
+ * <!-- inputs/outputs -->
+ *   @param vm the VM that owns the slot
+ *   @param idx the index of the slot
+ *   @param region the index of the region within the slot
+ *   @return Returns 1 if the region is mapped, 0 otherwise.
+ */
+NODISCARD static int
+region_populated(struct shim_vm_t const *const vm, uint64_t const idx, uint64_t const region)
+    NOEXCEPT
+{
+    uint64_t const bits = ((uint64_t)64);
+    uint64_t const bit = ((uint64_t)1) << (region % bits);
+
+    if (NULL == vm->populated[idx]) {
+        return 0;
+    }
+
+    return (int)(((uint64_t)0) != (vm->populated[idx][region / bits] & bit));
+}
+
+/**
+ * <!-- description -->
+ *   @brief Returns 1 if the provided region of the provided slot is
+ *     mapped into MicroV using memory that is shared copy-on-write with
+ *     the VM this VM was forked from. Returns 0 otherwise.
+ *
+ * <!-- inputs/outputs -->
+ *   @param vm the VM that owns the slot
+ *   @param idx the index of the slot
+ *   @param region the index of the region within the slot
+ *   @return Returns 1 if the region is shared, 0 otherwise.
+ */
+NODISCARD static int
+region_shared(struct shim_vm_t const *const vm, uint64_t const idx, uint64_t const region)
+    NOEXCEPT
+{
+    uint64_t const bits = ((uint64_t)64);
+    uint64_t const bit = ((uint64_t)1) << (region % bits);
+
+    if (NULL == vm->shared[idx]) {
+        return 0;
+    }
+
+    return (int)(((uint64_t)0) != (vm->shared[idx][region / bits] & bit));
+}
+
+/**
+ * <!-- description -->
+ *   @brief Gives the guest its own copy of the page that contains the
+ *     provided GPA, which is in a region that is shared copy-on-write
+ *     with the VM this VM was forked from (see shim_vm_fork). The slot
+ *     is expected to be a private mapping of the memory of the parent
+ *     VM, so looking up the page for write makes the host copy it into
+ *     memory owned by this VM. The shared page is then unmapped from
+ *     MicroV and the copy is mapped in its place.
+ *
+ * <!-- inputs/outputs -->
+ *   @param pmut_vm the VM that generated the exit
+ *   @param idx the index of the slot that contains the GPA
+ *   @param gpa the GPA that was accessed
+ *   @return SHIM_SUCCESS on success, SHIM_FAILURE on failure.
+ */
+NODISCARD static int64_t
+copy_on_write(struct shim_vm_t *const pmut_vm, uint64_t const idx, uint64_t const gpa) NOEXCEPT
+{
+    struct mv_mdl_t *pmut_mut_mdl;
+    struct kvm_userspace_memory_region const *const slot = &pmut_vm->slots[idx];
+
+    uint64_t mut_seq;
+    uint64_t mut_spa;
+
+    uint64_t const page = mv_page_aligned(gpa);
+    uint64_t const region = region_of(slot, gpa);
+    uint64_t const hva = slot->userspace_addr + (page - slot->guest_phys_addr);
+
+    platform_mutex_lock(&pmut_vm->mutex);
+
+    if (((uint64_t)0) != pmut_vm->invalidate_in_progress) {
+        platform_mutex_unlock(&pmut_vm->mutex);
+        return SHIM_SUCCESS;
+    }
+
+    mut_seq = pmut_vm->invalidate_seq;
+    platform_mutex_unlock(&pmut_vm->mutex);
+
+    mut_spa = platform_virt_to_phys_user(hva);
+    if (((uint64_t)0) == mut_spa) {
+        bferror("platform_virt_to_phys_user failed");
+        return SHIM_FAILURE;
+    }
+
+    platform_mutex_lock(&pmut_vm->mutex);
+
+    if (((uint64_t)0) != pmut_vm->invalidate_in_progress) {
+        goto retry;
+    }
+
+    if (mut_seq != pmut_vm->invalidate_seq) {
+        goto retry;
+    }
+
+    if (!region_shared(pmut_vm, idx, region)) {
+        goto retry;
+    }
+
+    pmut_mut_mdl = (struct mv_mdl_t *)shared_page_for_current_pp();
+    platform_expects(NULL != pmut_mut_mdl);
+
+    pmut_mut_mdl->num_entries = ((uint64_t)1);
+    pmut_mut_mdl->entries[0].dst = page;
+    pmut_mut_mdl->entries[0].src = ((uint64_t)0);
+    pmut_mut_mdl->entries[0].bytes = HYPERVISOR_PAGE_SIZE;
+
+    if (mv_vm_op_mmio_unmap(g_mut_hndl, pmut_vm->id)) {
+        bferror("mv_vm_op_mmio_unmap failed");
+        goto failure;
+    }
+
+    pmut_mut_mdl->num_entries = ((uint64_t)1);
+    pmut_mut_mdl->entries[0].dst = page;
+    pmut_mut_mdl->entries[0].src = mut_spa;
+    pmut_mut_mdl->entries[0].bytes = HYPERVISOR_PAGE_SIZE;
+
+    if (mv_vm_op_mmio_map(g_mut_hndl, pmut_vm->id, MV_SELF_ID)) {
+        bferror("mv_vm_op_mmio_map failed");
+        goto failure;
+    }
+
+retry:
+
+    platform_mutex_unlock(&pmut_vm->mutex);
+    return SHIM_SUCCESS;
+
+failure:
+
+    platform_mutex_unlock(&pmut_vm->mutex);
+    return SHIM_FAILURE;
+}
+
+/**
+ * <!-- description -->
+ *   @brief Handles mv_exit_reason_t_mmio. Memory slots are not mapped
+ *     into MicroV when they are created. Instead, the first access to
+ *     each SHIM_VM_POPULATE_SIZE region of a slot generates an MMIO exit,
+ *     and the region (clamped to the slot) is mapped here so that the
+ *     VCPU can be resumed. MMIO exits for GPAs that are not in a slot are
+ *     not supported.
+ *
+ *   @note Guest memory is not pinned. The host pages are looked up
+ *     without holding the VM's mutex, as doing so might fault them in,
+ *     which in turn might need the host to invalidate other pages of
+ *     this VM (see shim_vm_invalidate_range_start). If an invalidation
+ *     started while the pages were being looked up, they might be stale,
+ *     so nothing is mapped, and the guest simply faults again.
+ *
+ * <!-- inputs/outputs -->
+ *   @param pmut_vcpu the VCPU associated with the IOCTL
+ *   @return SHIM_SUCCESS on success, SHIM_FAILURE on failure.
+ */
+NODISCARD static int64_t
+handle_vcpu_kvm_run_mmio(struct shim_vcpu_t *const pmut_vcpu) NOEXCEPT
+{
+    struct shim_vm_t *pmut_mut_vm;
+    struct mv_mdl_t *pmut_mut_mdl;
+    struct kvm_userspace_memory_region const *mut_slot;
+
+    uint64_t *pmut_mut_spas = NULL;
+    uint64_t *pmut_mut_populated = NULL;
+
+    uint64_t mut_idx;
+    uint64_t mut_gpa;
+    uint64_t mut_end;
+    uint64_t mut_slot_end;
+    uint64_t mut_region;
+    uint64_t mut_hva;
+    uint64_t mut_seq;
+    uint64_t mut_bytes;
+    uint64_t mut_i;
+    uint64_t mut_num;
+
+    uint64_t const one = ((uint64_t)1);
+    uint64_t const bits = ((uint64_t)64);
+    uint64_t const mask = ~(SHIM_VM_POPULATE_SIZE - one);
+    uint64_t const spas_size = (SHIM_VM_POPULATE_SIZE / HYPERVISOR_PAGE_SIZE) * sizeof(uint64_t);
+
+    pmut_mut_vm = pmut_vcpu->vm;
+    platform_expects(NULL != pmut_mut_vm);
+
+    pmut_mut_mdl = (struct mv_mdl_t *)shared_page_for_current_pp();
+    platform_expects(NULL != pmut_mut_mdl);
+
+    mut_gpa = ((struct mv_exit_mmio_t const *)pmut_mut_mdl)->gpa;
+
+    platform_mutex_lock(&pmut_mut_vm->mutex);
+
+    mut_slot = find_slot(pmut_mut_vm, mut_gpa, &mut_idx);
+    if (NULL == mut_slot) {
+        bferror_x64("mv_exit_reason_t_mmio currently not implemented", mut_gpa);
+        platform_mutex_unlock(&pmut_mut_vm->mutex);
+        return SHIM_FAILURE;
+    }
+
+    /// NOTE:
+    /// - If another VCPU already mapped this region, or if the host is in
+    ///   the middle of invalidating memory, there is nothing to do, and the
+    ///   guest can simply retry the access.
+    ///
+    /// - The only faults in a region that is mapped and shared with a
+    ///   parent VM are writes to pages that are still shared (or pages
+    ///   that a failed copy left unmapped), so these get their own copy.
+    ///
+
+    mut_region = region_of(mut_slot, mut_gpa);
+    if (region_populated(pmut_mut_vm, mut_idx, mut_region)) {
+        if (region_shared(pmut_mut_vm, mut_idx, mut_region)) {
+            platform_mutex_unlock(&pmut_mut_vm->mutex);
+            return copy_on_write(pmut_mut_vm, mut_idx, mut_gpa);
+        }
+
+        platform_mutex_unlock(&pmut_mut_vm->mutex);
+        return SHIM_SUCCESS;
+    }
+
+    if (((uint64_t)0) != pmut_mut_vm->invalidate_in_progress) {
+        platform_mutex_unlock(&pmut_mut_vm->mutex);
+        return SHIM_SUCCESS;
+    }
+
+    mut_end = (mut_gpa & mask) + SHIM_VM_POPULATE_SIZE;
+    mut_slot_end = mv_page_aligned(
+        mut_slot->guest_phys_addr + mut_slot->memory_size + (HYPERVISOR_PAGE_SIZE - one));
+
+    if (mut_end > mut_slot_end) {
+        mut_end = mut_slot_end;
+    }
+    else {
+        touch();
+    }
+
+    mut_gpa &= mask;
+    if (mut_gpa < mut_slot->guest_phys_addr) {
+        mut_gpa = mut_slot->guest_phys_addr;
+    }
+    else {
+        touch();
+    }
+
+    mut_num = (mut_end - mut_gpa) / HYPERVISOR_PAGE_SIZE;
+    mut_hva = mut_slot->userspace_addr + (mut_gpa - mut_slot->guest_phys_addr);
+    mut_bytes = shim_vm_populated_size(mut_slot);
+    mut_seq = pmut_mut_vm->invalidate_seq;
+
+    platform_mutex_unlock(&pmut_mut_vm->mutex);
+
+    pmut_mut_spas = (uint64_t *)platform_alloc(spas_size);
+    if (NULL == pmut_mut_spas) {
+        bferror("platform_alloc failed");
+        goto failure;
+    }
+
+    pmut_mut_populated = (uint64_t *)platform_alloc(mut_bytes);
+    if (NULL == pmut_mut_populated) {
+        bferror("platform_alloc failed");
+        goto failure;
+    }
+
+    for (mut_i = ((uint64_t)0); mut_i < mut_num; ++mut_i) {
+        pmut_mut_spas[mut_i] = platform_virt_to_phys_user(mut_hva + (mut_i * HYPERVISOR_PAGE_SIZE));
+        if (((uint64_t)0) == pmut_mut_spas[mut_i]) {
+            bferror("platform_virt_to_phys_user failed");
+            goto failure;
+        }
+
+        touch();
+    }
+
+    platform_mutex_lock(&pmut_mut_vm->mutex);
+
+    if (((uint64_t)0) != pmut_mut_vm->invalidate_in_progress) {
+        goto retry;
+    }
+
+    if (mut_seq != pmut_mut_vm->invalidate_seq) {
+        goto retry;
+    }
+
+    if (region_populated(pmut_mut_vm, mut_idx, mut_region)) {
+        goto retry;
+    }
+
+    if (NULL == pmut_mut_vm->populated[mut_idx]) {
+        pmut_mut_vm->populated[mut_idx] = pmut_mut_populated;
+        pmut_mut_populated = NULL;
+    }
+    else {
+        touch();
+    }
+
+    /// NOTE:
+    /// - We might have been moved to another PP while the pages were
+    ///   being looked up, so the shared page has to be looked up again.
+    ///
+
+    pmut_mut_mdl = (struct mv_mdl_t *)shared_page_for_current_pp();
+    platform_expects(NULL != pmut_mut_mdl);
+
+    pmut_mut_mdl->num_entries = ((uint64_t)0);
+    for (mut_i = ((uint64_t)0); mut_i < mut_num; ++mut_i) {
+        pmut_mut_mdl->entries[pmut_mut_mdl->num_entries].dst =
+            mut_gpa + (mut_i * HYPERVISOR_PAGE_SIZE);
+        pmut_mut_mdl->entries[pmut_mut_mdl->num_entries].src = pmut_mut_spas[mut_i];
+        pmut_mut_mdl->entries[pmut_mut_mdl->num_entries].bytes = HYPERVISOR_PAGE_SIZE;
+        ++pmut_mut_mdl->num_entries;
+
+        if (pmut_mut_mdl->num_entries >= MV_MDL_MAX_ENTRIES) {
+            if (mv_vm_op_mmio_map(g_mut_hndl, pmut_mut_vm->id, MV_SELF_ID)) {
+                bferror("mv_vm_op_mmio_map failed");
+                goto failure_locked;
+            }
+
+            pmut_mut_mdl->num_entries = ((uint64_t)0);
+        }
+        else {
+            touch();
+        }
+    }
+
+    if (((uint64_t)0) != pmut_mut_mdl->num_entries) {
+        if (mv_vm_op_mmio_map(g_mut_hndl, pmut_mut_vm->id, MV_SELF_ID)) {
+            bferror("mv_vm_op_mmio_map failed");
+            goto failure_locked;
+        }
+
+        touch();
+    }
+    else {
+        touch();
+    }
+
+    pmut_mut_vm->populated[mut_idx][mut_region / bits] |= one << (mut_region % bits);
+
+retry:
+
+    platform_mutex_unlock(&pmut_mut_vm->mutex);
+    platform_free(pmut_mut_populated, mut_bytes);
+    platform_free(pmut_mut_spas, spas_size);
+    return SHIM_SUCCESS;
+
+failure_locked:
+
+    platform_mutex_unlock(&pmut_mut_vm->mutex);
+
+failure:
+
+    platform_free(pmut_mut_populated, mut_bytes);
+    platform_free(pmut_mut_spas, spas_size);
+    return SHIM_FAILURE;
+}
+
+/**
+ * <!-- description -->
+ *   @brief Runs the VCPU until an exit has to be handled by userspace.
+ *
+ * <!-- inputs/outputs -->
+ *   @param pmut_vcpu the VCPU associated with the IOCTL
+ *   @return SHIM_SUCCESS on success, SHIM_FAILURE on failure.
+ */
+NODISCARD static int64_t
+handle_vcpu_kvm_run_loop(struct shim_vcpu_t *const pmut_vcpu) NOEXCEPT
+{
+    enum mv_exit_reason_t mut_exit_reason;
+    int64_t mut_ret;
+    int mut_exit;
+
+    if (dirty_ring_full(pmut_vcpu)) {
+        pmut_vcpu->run->exit_reason = KVM_EXIT_DIRTY_RING_FULL;
+        return SHIM_SUCCESS;
+    }
+
     while (0 == (int32_t)pmut_vcpu->run->immediate_exit) {
         if (platform_interrupted()) {
             break;
         }
 
+        complete_msr_exit(pmut_vcpu);
+        set_preempted_thread(pmut_vcpu, ((platform_thread)0));
         mut_exit_reason = mv_vs_op_run(g_mut_hndl, pmut_vcpu->vsid);
         switch ((int32_t)mut_exit_reason) {
             case mv_exit_reason_t_failure: {
@@ -237,8 +1136,16 @@ handle_vcpu_kvm_run(struct shim_vcpu_t *const pmut_vcpu) NOEXCEPT
             }
 
             case mv_exit_reason_t_hlt: {
-                bferror("mv_exit_reason_t_hlt currently not implemented\n");
-                return return_failure(pmut_vcpu);
+                mut_ret = handle_vcpu_kvm_run_hlt(pmut_vcpu, &mut_exit);
+                if (SHIM_SUCCESS != mut_ret) {
+                    return mut_ret;
+                }
+
+                if (mut_exit) {
+                    return SHIM_SUCCESS;
+                }
+
+                continue;
             }
 
             case mv_exit_reason_t_io: {
@@ -246,16 +1153,27 @@ handle_vcpu_kvm_run(struct shim_vcpu_t *const pmut_vcpu) NOEXCEPT
             }
 
             case mv_exit_reason_t_mmio: {
-                bferror("mv_exit_reason_t_mmio currently not implemented\n");
-                return return_failure(pmut_vcpu);
+                if (handle_vcpu_kvm_run_mmio(pmut_vcpu)) {
+                    return return_failure(pmut_vcpu);
+                }
+
+                continue;
             }
 
             case mv_exit_reason_t_msr: {
-                bferror("mv_exit_reason_t_msr currently not implemented\n");
-                return return_failure(pmut_vcpu);
+                if (handle_vcpu_kvm_run_msr(pmut_vcpu, &mut_exit)) {
+                    return SHIM_FAILURE;
+                }
+
+                if (mut_exit) {
+                    return SHIM_SUCCESS;
+                }
+
+                continue;
             }
 
             case mv_exit_reason_t_interrupt: {
+                set_preempted_thread(pmut_vcpu, platform_current_thread());
                 continue;
             }
 
@@ -263,6 +1181,29 @@ handle_vcpu_kvm_run(struct shim_vcpu_t *const pmut_vcpu) NOEXCEPT
                 continue;
             }
 
+            case mv_exit_reason_t_dirty_ring_full: {
+                if (harvest_dirty_ring(pmut_vcpu)) {
+                    return return_failure(pmut_vcpu);
+                }
+
+                if (dirty_ring_full(pmut_vcpu)) {
+                    pmut_vcpu->run->exit_reason = KVM_EXIT_DIRTY_RING_FULL;
+                    return SHIM_SUCCESS;
+                }
+
+                continue;
+            }
+
+            case mv_exit_reason_t_kick: {
+                handle_vcpu_kvm_run_kick(pmut_vcpu);
+                continue;
+            }
+
+            case mv_exit_reason_t_pause: {
+                handle_vcpu_kvm_run_pause(pmut_vcpu);
+                continue;
+            }
+
             default: {
                 break;
             }
@@ -275,3 +1216,140 @@ handle_vcpu_kvm_run(struct shim_vcpu_t *const pmut_vcpu) NOEXCEPT
     pmut_vcpu->run->exit_reason = KVM_EXIT_INTR;
     return SHIM_INTERRUPTED;
 }
+
+/**
+ * <!-- description -->
+ *   @brief Writes the register groups that userspace marked as dirty in
+ *     kvm_run.s.regs to MicroV (KVM_CAP_SYNC_REGS). The writes only update
+ *     MicroV's register cache for the VS, and are applied by mv_vs_op_run
+ *     just before the VS executes.
+ *
+ * <!-- inputs/outputs -->
+ *   @param pmut_vcpu the VCPU associated with the IOCTL
+ *   @return SHIM_SUCCESS on success, SHIM_FAILURE on failure.
+ */
+NODISCARD static int64_t
+sync_regs_to_microv(struct shim_vcpu_t *const pmut_vcpu) NOEXCEPT
+{
+    uint64_t const dirty = pmut_vcpu->run->kvm_dirty_regs;
+
+    if (((uint64_t)0) != (dirty & KVM_SYNC_X86_REGS)) {
+        if (handle_vcpu_kvm_set_regs(pmut_vcpu, &pmut_vcpu->run->s.regs.regs)) {
+            bferror("handle_vcpu_kvm_set_regs failed");
+            return SHIM_FAILURE;
+        }
+    }
+    else {
+        touch();
+    }
+
+    if (((uint64_t)0) != (dirty & KVM_SYNC_X86_SREGS)) {
+        if (handle_vcpu_kvm_set_sregs(pmut_vcpu, &pmut_vcpu->run->s.regs.sregs)) {
+            bferror("handle_vcpu_kvm_set_sregs failed");
+            return SHIM_FAILURE;
+        }
+    }
+    else {
+        touch();
+    }
+
+    pmut_vcpu->run->kvm_dirty_regs = ((uint64_t)0);
+    return SHIM_SUCCESS;
+}
+
+/**
+ * <!-- description -->
+ *   @brief Reads the register groups that userspace asked for using
+ *     kvm_run.kvm_valid_regs into kvm_run.s.regs (KVM_CAP_SYNC_REGS), so
+ *     that userspace does not need KVM_GET_REGS/KVM_GET_SREGS on exit.
+ *
+ * <!-- inputs/outputs -->
+ *   @param pmut_vcpu the VCPU associated with the IOCTL
+ *   @return SHIM_SUCCESS on success, SHIM_FAILURE on failure.
+ */
+NODISCARD static int64_t
+sync_regs_from_microv(struct shim_vcpu_t *const pmut_vcpu) NOEXCEPT
+{
+    uint64_t const valid = pmut_vcpu->run->kvm_valid_regs;
+
+    if (((uint64_t)0) != (valid & KVM_SYNC_X86_REGS)) {
+        if (handle_vcpu_kvm_get_regs(pmut_vcpu, &pmut_vcpu->run->s.regs.regs)) {
+            bferror("handle_vcpu_kvm_get_regs failed");
+            return SHIM_FAILURE;
+        }
+    }
+    else {
+        touch();
+    }
+
+    if (((uint64_t)0) != (valid & KVM_SYNC_X86_SREGS)) {
+        if (handle_vcpu_kvm_get_sregs(pmut_vcpu, &pmut_vcpu->run->s.regs.sregs)) {
+            bferror("handle_vcpu_kvm_get_sregs failed");
+            return SHIM_FAILURE;
+        }
+    }
+    else {
+        touch();
+    }
+
+    return SHIM_SUCCESS;
+}
+
+/**
+ * <!-- description -->
+ *   @brief Handles the execution of kvm_run.
+ *
+ * <!-- inputs/outputs -->
+ *   @param pmut_vcpu the VCPU associated with the IOCTL
+ *   @return SHIM_SUCCESS on success, SHIM_FAILURE on failure.
+ */
+NODISCARD int64_t
+handle_vcpu_kvm_run(struct shim_vcpu_t *const pmut_vcpu) NOEXCEPT
+{
+    int64_t mut_ret;
+
+    platform_expects(NULL != pmut_vcpu);
+    platform_expects(NULL != pmut_vcpu->run);
+
+    if (detect_hypervisor()) {
+        bferror("The shim is not running in a VM. Did you forget to start MicroV?");
+        return return_failure(pmut_vcpu);
+    }
+
+    if (((uint64_t)0) != (pmut_vcpu->run->kvm_valid_regs & ~KVM_SYNC_X86_VALID_FIELDS)) {
+        bferror_x64("kvm_valid_regs is unsupported", pmut_vcpu->run->kvm_valid_regs);
+        return SHIM_FAILURE;
+    }
+
+    if (((uint64_t)0) != (pmut_vcpu->run->kvm_dirty_regs & ~KVM_SYNC_X86_VALID_FIELDS)) {
+        bferror_x64("kvm_dirty_regs is unsupported", pmut_vcpu->run->kvm_dirty_regs);
+        return SHIM_FAILURE;
+    }
+
+    if (sync_regs_to_microv(pmut_vcpu)) {
+        return return_failure(pmut_vcpu);
+    }
+
+    mut_ret = handle_vcpu_kvm_run_loop(pmut_vcpu);
+    set_preempted_thread(pmut_vcpu, ((platform_thread)0));
+
+    if (SHIM_FAILURE == mut_ret) {
+        return mut_ret;
+    }
+
+    /// NOTE:
+    /// - Anything MicroV logged while the VCPU was running is moved into
+    ///   the dirty ring before returning so that userspace sees every
+    ///   page that was dirtied up to this exit.
+    ///
+
+    if (harvest_dirty_ring(pmut_vcpu)) {
+        return return_failure(pmut_vcpu);
+    }
+
+    if (sync_regs_from_microv(pmut_vcpu)) {
+        return return_failure(pmut_vcpu);
+    }
+
+    return mut_ret;
+}
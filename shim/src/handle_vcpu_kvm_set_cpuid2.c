@@ -24,20 +24,104 @@
  * SOFTWARE.
  */
 
+#include <debug.h>
+#include <detect_hypervisor.h>
+#include <g_mut_hndl.h>
+#include <kvm_constants.h>
 #include <kvm_cpuid2.h>
+#include <kvm_cpuid_entry2.h>
+#include <mv_cdl_t.h>
+#include <mv_constants.h>
+#include <mv_cpuid_flag_t.h>
+#include <mv_hypercall.h>
 #include <mv_types.h>
+#include <platform.h>
+#include <shared_page_for_current_pp.h>
+#include <shim_vcpu_t.h>
 
 /**
  * <!-- description -->
- *   @brief Handles the execution of kvm_set_cpuid2.
+ *   @brief Handles the execution of kvm_set_cpuid2. KVM allows more
+ *     entries than fit in a single CDL, so the entries are sent to MicroV
+ *     using as many calls to mv_vs_op_cpuid_set_list as needed. Only the
+ *     first call clears the CPUID leaves that were previously set.
  *
  * <!-- inputs/outputs -->
- *   @param pmut_ioctl_args the arguments provided by userspace
+ *   @param vcpu to get vsid value to pass to hypercall
+ *   @param args the arguments provided by userspace
+ *   @param entries the args->nent entries provided by userspace
  *   @return SHIM_SUCCESS on success, SHIM_FAILURE on failure.
  */
 NODISCARD int64_t
-handle_vcpu_kvm_set_cpuid2(struct kvm_cpuid2 *const pmut_ioctl_args) NOEXCEPT
+handle_vcpu_kvm_set_cpuid2(
+    struct shim_vcpu_t const *const vcpu,
+    struct kvm_cpuid2 const *const args,
+    struct kvm_cpuid_entry2 const *const entries) NOEXCEPT
 {
-    (void)pmut_ioctl_args;
+    uint64_t mut_i;
+    struct mv_cdl_t *pmut_mut_cdl;
+    struct kvm_cpuid_entry2 const *mut_src_entry;
+    struct mv_cdl_entry_t *pmut_mut_dst_entry;
+
+    platform_expects(MV_INVALID_HANDLE != g_mut_hndl);
+    platform_expects(NULL != vcpu);
+    platform_expects(NULL != args);
+    platform_expects(NULL != entries);
+
+    if (detect_hypervisor()) {
+        bferror("The shim is not running in a VM. Did you forget to start MicroV?");
+        return SHIM_FAILURE;
+    }
+
+    if (args->nent > (uint32_t)KVM_MAX_CPUID_ENTRIES) {
+        bferror_d32("kvm_cpuid2.nent is too large", args->nent);
+        return SHIM_FAILURE;
+    }
+
+    pmut_mut_cdl = (struct mv_cdl_t *)shared_page_for_current_pp();
+    platform_expects(NULL != pmut_mut_cdl);
+
+    mut_i = ((uint64_t)0);
+    while (1) {
+        pmut_mut_cdl->reg0 = mut_i;
+        pmut_mut_cdl->num_entries = ((uint64_t)0);
+
+        while (mut_i < (uint64_t)args->nent) {
+            if (pmut_mut_cdl->num_entries >= MV_CDL_MAX_ENTRIES) {
+                break;
+            }
+
+            mut_src_entry = &entries[mut_i];
+            pmut_mut_dst_entry = &pmut_mut_cdl->entries[pmut_mut_cdl->num_entries];
+
+            pmut_mut_dst_entry->fun = mut_src_entry->function;
+            pmut_mut_dst_entry->idx = mut_src_entry->index;
+            pmut_mut_dst_entry->eax = mut_src_entry->eax;
+            pmut_mut_dst_entry->ebx = mut_src_entry->ebx;
+            pmut_mut_dst_entry->ecx = mut_src_entry->ecx;
+            pmut_mut_dst_entry->edx = mut_src_entry->edx;
+            pmut_mut_dst_entry->reserved = ((uint32_t)0);
+
+            if (mut_src_entry->flags & ((uint32_t)KVM_CPUID_FLAG_SIGNIFCANT_INDEX)) {
+                pmut_mut_dst_entry->flags = mv_cpuid_flag_t_significant_index;
+            }
+            else {
+                pmut_mut_dst_entry->flags = mv_cpuid_flag_t_reserved;
+            }
+
+            ++pmut_mut_cdl->num_entries;
+            ++mut_i;
+        }
+
+        if (mv_vs_op_cpuid_set_list(g_mut_hndl, vcpu->vsid)) {
+            bferror("mv_vs_op_cpuid_set_list failed");
+            return SHIM_FAILURE;
+        }
+
+        if (mut_i >= (uint64_t)args->nent) {
+            break;
+        }
+    }
+
     return SHIM_SUCCESS;
 }
@@ -24,17 +24,45 @@
  * SOFTWARE.
  */
 
+#include <debug.h>
+#include <detect_hypervisor.h>
+#include <g_mut_hndl.h>
+#include <mv_constants.h>
+#include <mv_hypercall.h>
 #include <mv_types.h>
+#include <platform.h>
+#include <shim_vcpu_t.h>
 
 /**
  * <!-- description -->
  *   @brief Handles the execution of kvm_set_tsc_khz.
  *
  * <!-- inputs/outputs -->
+ *   @param pmut_vcpu the VCPU to set the TSC frequency of
+ *   @param freq the TSC frequency in KHz provided by userspace
  *   @return SHIM_SUCCESS on success, SHIM_FAILURE on failure.
  */
 NODISCARD int64_t
-handle_vcpu_kvm_set_tsc_khz(void) NOEXCEPT
+handle_vcpu_kvm_set_tsc_khz(struct shim_vcpu_t *const pmut_vcpu, uint64_t const freq) NOEXCEPT
 {
+    platform_expects(MV_INVALID_HANDLE != g_mut_hndl);
+    platform_expects(NULL != pmut_vcpu);
+
+    if (detect_hypervisor()) {
+        bferror("The shim is not running in a VM. Did you forget to start MicroV?");
+        return SHIM_FAILURE;
+    }
+
+    if (((uint64_t)0) == freq) {
+        bferror("the TSC frequency cannot be 0");
+        return SHIM_FAILURE;
+    }
+
+    if (mv_vs_op_tsc_set_khz(g_mut_hndl, pmut_vcpu->vsid, freq)) {
+        bferror("mv_vs_op_tsc_set_khz failed");
+        return SHIM_FAILURE;
+    }
+
+    pmut_vcpu->tsc_khz = freq;
     return SHIM_SUCCESS;
 }
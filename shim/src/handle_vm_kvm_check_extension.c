@@ -25,7 +25,10 @@
  */
 #include <debug.h>
 #include <g_mut_hndl.h>
+#include <kvm_clock_data.h>
 #include <kvm_constants.h>
+#include <kvm_run_msr.h>
+#include <kvm_sync_regs.h>
 #include <mv_constants.h>
 #include <mv_types.h>
 #include <platform.h>
@@ -55,6 +58,14 @@ handle_vm_kvm_check_extension(unsigned long mut_userargs, uint32_t *const pmut_r
             touch();
             FALLTHROUGH;
         }
+        case KVM_CAP_TSC_CONTROL: {
+            touch();
+            FALLTHROUGH;
+        }
+        case KVM_CAP_VCPU_ATTRIBUTES: {
+            touch();
+            FALLTHROUGH;
+        }
         case KVM_CAP_TSC_DEADLINE_TIMER: {
             touch();
             FALLTHROUGH;
@@ -79,6 +90,10 @@ handle_vm_kvm_check_extension(unsigned long mut_userargs, uint32_t *const pmut_r
             touch();
             FALLTHROUGH;
         }
+        case KVM_CAP_MICROV_FORK: {
+            touch();
+            FALLTHROUGH;
+        }
         case KVM_CAP_IMMEDIATE_EXIT: {
             *pmut_ret = (uint32_t)1;
             break;
@@ -103,6 +118,26 @@ handle_vm_kvm_check_extension(unsigned long mut_userargs, uint32_t *const pmut_r
             *pmut_ret = (uint32_t)MICROV_MAX_MCE_BANKS;
             break;
         }
+        case KVM_CAP_DIRTY_LOG_RING: {
+            *pmut_ret = (uint32_t)KVM_DIRTY_RING_MAX_SIZE;
+            break;
+        }
+        case KVM_CAP_X86_USER_SPACE_MSR: {
+            *pmut_ret = (uint32_t)KVM_MSR_EXIT_REASON_FILTER;
+            break;
+        }
+        case KVM_CAP_ADJUST_CLOCK: {
+            *pmut_ret = KVM_CLOCK_TSC_STABLE | KVM_CLOCK_REALTIME;
+            break;
+        }
+        case KVM_CAP_X86_MSR_FILTER: {
+            *pmut_ret = (uint32_t)1;
+            break;
+        }
+        case KVM_CAP_SYNC_REGS: {
+            *pmut_ret = (uint32_t)KVM_SYNC_X86_VALID_FIELDS;
+            break;
+        }
         default: {
             bfdebug_x64("Unsupported Extension userargs", mut_userargs);
             *pmut_ret = (uint32_t)0;
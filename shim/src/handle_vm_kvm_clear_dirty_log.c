@@ -24,20 +24,143 @@
  * SOFTWARE.
  */
 
+#include <debug.h>
+#include <detect_hypervisor.h>
+#include <g_mut_hndl.h>
+#include <handle_vm_kvm_set_user_memory_region.h>
 #include <kvm_clear_dirty_log.h>
+#include <mv_constants.h>
+#include <mv_dirty_bitmap_t.h>
+#include <mv_hypercall.h>
 #include <mv_types.h>
+#include <platform.h>
+#include <shared_page_for_current_pp.h>
+#include <shim_vm_t.h>
+#include <touch.h>
 
 /**
  * <!-- description -->
- *   @brief Handles the execution of kvm_clear_dirty_log.
+ *   @brief Handles the execution of kvm_clear_dirty_log. The bitmap
+ *     provided by userspace is handed to MicroV one mv_dirty_bitmap_t
+ *     at a time, and every page with its bit set is cleared from the
+ *     dirty log and write protected again.
  *
  * <!-- inputs/outputs -->
- *   @param pmut_ioctl_args the arguments provided by userspace
+ *   @param args the arguments provided by userspace
+ *   @param pmut_vm the VM to modify
  *   @return SHIM_SUCCESS on success, SHIM_FAILURE on failure.
  */
 NODISCARD int64_t
-handle_vm_kvm_clear_dirty_log(struct kvm_clear_dirty_log *const pmut_ioctl_args) NOEXCEPT
+handle_vm_kvm_clear_dirty_log(
+    struct kvm_clear_dirty_log const *const args, struct shim_vm_t *const pmut_vm) NOEXCEPT
 {
-    (void)pmut_ioctl_args;
+    struct mv_dirty_bitmap_t *pmut_mut_bitmap;
+
+    uint32_t mut_slot_id;
+    uint64_t mut_page;
+    uint64_t mut_slot_pages;
+    uint64_t mut_pages;
+    uint64_t mut_bytes;
+
+    uint64_t const bits_per_entry = ((uint64_t)64);
+    uint64_t const bits_per_byte = ((uint64_t)8);
+    uint64_t const entry_mask = bits_per_entry - ((uint64_t)1);
+
+    platform_expects(NULL != args);
+    platform_expects(NULL != pmut_vm);
+
+    if (detect_hypervisor()) {
+        bferror("The shim is not running in a VM. Did you forget to start MicroV?");
+        return SHIM_FAILURE;
+    }
+
+    mut_slot_id = args->slot;
+    if ((uint64_t)mut_slot_id >= MICROV_MAX_SLOTS) {
+        bferror("args->slot is out of bounds");
+        return SHIM_FAILURE;
+    }
+
+    if (((uint64_t)0) != (args->first_page & entry_mask)) {
+        bferror("args->first_page is not 64 page aligned");
+        return SHIM_FAILURE;
+    }
+
+    if (((uint64_t)0) == args->dirty_bitmap) {
+        bferror("args->dirty_bitmap is NULL");
+        return SHIM_FAILURE;
+    }
+
+    pmut_mut_bitmap = (struct mv_dirty_bitmap_t *)shared_page_for_current_pp();
+    platform_expects(NULL != pmut_mut_bitmap);
+
+    platform_mutex_lock(&pmut_vm->mutex);
+
+    if (((uint64_t)0) == (pmut_vm->slots[mut_slot_id].flags & KVM_MEM_LOG_DIRTY_PAGES)) {
+        bferror("args->slot is not dirty logged");
+        goto dirty_log_failed;
+    }
+
+    mut_slot_pages = pmut_vm->slots[mut_slot_id].memory_size;
+    mut_slot_pages += (HYPERVISOR_PAGE_SIZE - ((uint64_t)1));
+    mut_slot_pages /= HYPERVISOR_PAGE_SIZE;
+
+    if (args->first_page >= mut_slot_pages) {
+        bferror("args->first_page is out of bounds");
+        goto dirty_log_failed;
+    }
+
+    if ((uint64_t)args->num_pages > (mut_slot_pages - args->first_page)) {
+        bferror("args->num_pages is out of bounds");
+        goto dirty_log_failed;
+    }
+
+    for (mut_page = ((uint64_t)0); mut_page < (uint64_t)args->num_pages; mut_page += mut_pages) {
+        mut_pages = (uint64_t)args->num_pages - mut_page;
+        if (mut_pages > MV_DIRTY_BITMAP_MAX_PAGES) {
+            mut_pages = MV_DIRTY_BITMAP_MAX_PAGES;
+        }
+        else {
+            touch();
+        }
+
+        /// NOTE:
+        /// - MicroV clears the entire range described by the bitmap,
+        ///   so anything past the pages provided by userspace has to be
+        ///   zero, including the unused bits of a partial entry.
+        ///
+
+        mut_bytes = (mut_pages + entry_mask) / bits_per_entry;
+        mut_bytes *= sizeof(uint64_t);
+
+        platform_memset(pmut_mut_bitmap, ((uint8_t)0), sizeof(struct mv_dirty_bitmap_t));
+        if (platform_copy_from_user(
+                pmut_mut_bitmap->entries,
+                (void const *)(args->dirty_bitmap + (mut_page / bits_per_byte)),
+                mut_bytes)) {
+            bferror("platform_copy_from_user failed");
+            goto dirty_log_failed;
+        }
+
+        if (((uint64_t)0) != (mut_pages & entry_mask)) {
+            pmut_mut_bitmap->entries[mut_pages / bits_per_entry] &=
+                ((((uint64_t)1) << (mut_pages & entry_mask)) - ((uint64_t)1));
+        }
+        else {
+            touch();
+        }
+
+        if (mv_vm_op_dirty_log_clear(
+                g_mut_hndl, pmut_vm->id, (uint64_t)mut_slot_id, args->first_page + mut_page)) {
+            bferror("mv_vm_op_dirty_log_clear failed");
+            goto dirty_log_failed;
+        }
+    }
+
+    platform_mutex_unlock(&pmut_vm->mutex);
     return SHIM_SUCCESS;
+
+dirty_log_failed:
+
+    platform_mutex_unlock(&pmut_vm->mutex);
+    return SHIM_FAILURE;
 }
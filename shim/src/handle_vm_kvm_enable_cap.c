@@ -0,0 +1,165 @@
+/**
+ * @copyright
+ * Copyright (C) 2020 Assured Information Security, Inc.
+ *
+ * @copyright
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * @copyright
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * @copyright
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <debug.h>
+#include <detect_hypervisor.h>
+#include <kvm_constants.h>
+#include <kvm_dirty_gfn.h>
+#include <kvm_enable_cap.h>
+#include <kvm_run_msr.h>
+#include <mv_constants.h>
+#include <mv_types.h>
+#include <platform.h>
+#include <shim_vm_t.h>
+#include <touch.h>
+
+/**
+ * <!-- description -->
+ *   @brief Enables KVM_CAP_DIRTY_LOG_RING. The size of the ring is stored
+ *     in the VM and each VCPU allocates its own ring when it is created,
+ *     which is why this has to happen before any VCPU exists.
+ *
+ * <!-- inputs/outputs -->
+ *   @param size the size of each VCPU's dirty ring in bytes
+ *   @param pmut_vm the VM to modify
+ *   @return SHIM_SUCCESS on success, SHIM_FAILURE on failure.
+ */
+NODISCARD static int64_t
+enable_dirty_log_ring(uint64_t const size, struct shim_vm_t *const pmut_vm) NOEXCEPT
+{
+    uint64_t mut_i;
+
+    if (size < HYPERVISOR_PAGE_SIZE) {
+        bferror_x64("dirty ring size is too small", size);
+        return SHIM_FAILURE;
+    }
+
+    if (size > KVM_DIRTY_RING_MAX_SIZE) {
+        bferror_x64("dirty ring size is too large", size);
+        return SHIM_FAILURE;
+    }
+
+    if (((uint64_t)0) != (size & (size - ((uint64_t)1)))) {
+        bferror_x64("dirty ring size is not a power of 2", size);
+        return SHIM_FAILURE;
+    }
+
+    platform_mutex_lock(&pmut_vm->mutex);
+
+    if (((uint64_t)0) != pmut_vm->dirty_ring_size) {
+        bferror("dirty ring is already enabled");
+        goto enable_dirty_log_ring_failed;
+    }
+
+    for (mut_i = ((uint64_t)0); mut_i < MICROV_MAX_VCPUS; ++mut_i) {
+        if (((uint64_t)0) != pmut_vm->vcpus[mut_i].fd) {
+            bferror("dirty ring must be enabled before any vcpu is created");
+            goto enable_dirty_log_ring_failed;
+        }
+
+        touch();
+    }
+
+    pmut_vm->dirty_ring_size = size;
+
+    platform_mutex_unlock(&pmut_vm->mutex);
+    return SHIM_SUCCESS;
+
+enable_dirty_log_ring_failed:
+
+    platform_mutex_unlock(&pmut_vm->mutex);
+    return SHIM_FAILURE;
+}
+
+/**
+ * <!-- description -->
+ *   @brief Enables KVM_CAP_X86_USER_SPACE_MSR. Only
+ *     KVM_MSR_EXIT_REASON_FILTER is supported, as MicroV handles (or
+ *     injects a #GP for) every MSR access that is not filtered.
+ *
+ * <!-- inputs/outputs -->
+ *   @param reasons the KVM_MSR_EXIT_REASON_xxx to exit to userspace for
+ *   @param pmut_vm the VM to modify
+ *   @return SHIM_SUCCESS on success, SHIM_FAILURE on failure.
+ */
+NODISCARD static int64_t
+enable_user_space_msr(uint64_t const reasons, struct shim_vm_t *const pmut_vm) NOEXCEPT
+{
+    if (((uint64_t)0) != (reasons & ~((uint64_t)KVM_MSR_EXIT_REASON_FILTER))) {
+        bferror_x64("msr exit reasons are unsupported", reasons);
+        return SHIM_FAILURE;
+    }
+
+    platform_mutex_lock(&pmut_vm->mutex);
+    pmut_vm->msr_exit_reasons = reasons;
+    platform_mutex_unlock(&pmut_vm->mutex);
+
+    return SHIM_SUCCESS;
+}
+
+/**
+ * <!-- description -->
+ *   @brief Handles the execution of kvm_enable_cap.
+ *
+ * <!-- inputs/outputs -->
+ *   @param args the arguments provided by userspace
+ *   @param pmut_vm the VM to modify
+ *   @return SHIM_SUCCESS on success, SHIM_FAILURE on failure.
+ */
+NODISCARD int64_t
+handle_vm_kvm_enable_cap(
+    struct kvm_enable_cap const *const args, struct shim_vm_t *const pmut_vm) NOEXCEPT
+{
+    platform_expects(NULL != args);
+    platform_expects(NULL != pmut_vm);
+
+    if (detect_hypervisor()) {
+        bferror("The shim is not running in a VM. Did you forget to start MicroV?");
+        return SHIM_FAILURE;
+    }
+
+    if (((uint32_t)0) != args->flags) {
+        bferror_x64("args->flags is invalid", (uint64_t)args->flags);
+        return SHIM_FAILURE;
+    }
+
+    switch (args->cap) {
+        case KVM_CAP_DIRTY_LOG_RING: {
+            return enable_dirty_log_ring(args->args[0], pmut_vm);
+        }
+
+        case KVM_CAP_X86_USER_SPACE_MSR: {
+            return enable_user_space_msr(args->args[0], pmut_vm);
+        }
+
+        default: {
+            break;
+        }
+    }
+
+    bferror_x64("args->cap is unsupported", (uint64_t)args->cap);
+    return SHIM_FAILURE;
+}
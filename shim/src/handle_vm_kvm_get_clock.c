@@ -24,20 +24,50 @@
  * SOFTWARE.
  */
 
+#include <debug.h>
+#include <detect_hypervisor.h>
+#include <g_mut_hndl.h>
 #include <kvm_clock_data.h>
+#include <mv_constants.h>
+#include <mv_hypercall.h>
 #include <mv_types.h>
+#include <platform.h>
+#include <shim_vm_t.h>
 
 /**
  * <!-- description -->
- *   @brief Handles the execution of kvm_get_clock.
+ *   @brief Handles the execution of kvm_get_clock. The kvmclock of a VM is
+ *     maintained by MicroV, and is derived from the TSC, which MicroV
+ *     assumes is synchronized across PPs, so the clock is always reported
+ *     as stable. The host TSC is not reported.
  *
  * <!-- inputs/outputs -->
- *   @param pmut_ioctl_args the arguments provided by userspace
+ *   @param vm the VM to query
+ *   @param pmut_args the arguments provided by userspace
  *   @return SHIM_SUCCESS on success, SHIM_FAILURE on failure.
  */
 NODISCARD int64_t
-handle_vm_kvm_get_clock(struct kvm_clock_data *const pmut_ioctl_args) NOEXCEPT
+handle_vm_kvm_get_clock(
+    struct shim_vm_t const *const vm, struct kvm_clock_data *const pmut_args) NOEXCEPT
 {
-    (void)pmut_ioctl_args;
+    platform_expects(MV_INVALID_HANDLE != g_mut_hndl);
+    platform_expects(NULL != vm);
+    platform_expects(NULL != pmut_args);
+
+    if (detect_hypervisor()) {
+        bferror("The shim is not running in a VM. Did you forget to start MicroV?");
+        return SHIM_FAILURE;
+    }
+
+    platform_memset(pmut_args, ((uint8_t)0), sizeof(struct kvm_clock_data));
+
+    if (mv_vm_op_clock_get(g_mut_hndl, vm->vmid, &pmut_args->clock)) {
+        bferror("mv_vm_op_clock_get failed");
+        return SHIM_FAILURE;
+    }
+
+    pmut_args->realtime = platform_realtime_ns();
+    pmut_args->flags = KVM_CLOCK_TSC_STABLE | KVM_CLOCK_REALTIME;
+
     return SHIM_SUCCESS;
 }
@@ -24,20 +24,121 @@
  * SOFTWARE.
  */
 
+#include <debug.h>
+#include <detect_hypervisor.h>
+#include <g_mut_hndl.h>
+#include <handle_vm_kvm_set_user_memory_region.h>
 #include <kvm_dirty_log.h>
+#include <mv_constants.h>
+#include <mv_dirty_bitmap_t.h>
+#include <mv_hypercall.h>
 #include <mv_types.h>
+#include <platform.h>
+#include <shared_page_for_current_pp.h>
+#include <shim_vm_t.h>
+#include <touch.h>
 
 /**
  * <!-- description -->
- *   @brief Handles the execution of kvm_get_dirty_log.
+ *   @brief Handles the execution of kvm_get_dirty_log. The dirty log of
+ *     the slot is harvested from MicroV one mv_dirty_bitmap_t at a time.
+ *     Each chunk is copied to userspace and then cleared (and as a result
+ *     write protected again) using the same bitmap, so only the pages that
+ *     were reported to userspace are cleared.
  *
  * <!-- inputs/outputs -->
- *   @param pmut_ioctl_args the arguments provided by userspace
+ *   @param args the arguments provided by userspace
+ *   @param pmut_vm the VM to query
  *   @return SHIM_SUCCESS on success, SHIM_FAILURE on failure.
  */
 NODISCARD int64_t
-handle_vm_kvm_get_dirty_log(struct kvm_dirty_log *const pmut_ioctl_args) NOEXCEPT
+handle_vm_kvm_get_dirty_log(
+    struct kvm_dirty_log const *const args, struct shim_vm_t *const pmut_vm) NOEXCEPT
 {
-    (void)pmut_ioctl_args;
+    struct mv_dirty_bitmap_t *pmut_mut_bitmap;
+
+    uint32_t mut_slot_id;
+    uint64_t mut_page;
+    uint64_t mut_num_pages;
+    uint64_t mut_pages;
+    uint64_t mut_bytes;
+
+    uint64_t const bits_per_entry = ((uint64_t)64);
+    uint64_t const bits_per_byte = ((uint64_t)8);
+
+    platform_expects(NULL != args);
+    platform_expects(NULL != pmut_vm);
+
+    if (detect_hypervisor()) {
+        bferror("The shim is not running in a VM. Did you forget to start MicroV?");
+        return SHIM_FAILURE;
+    }
+
+    mut_slot_id = args->slot;
+    if ((uint64_t)mut_slot_id >= MICROV_MAX_SLOTS) {
+        bferror("args->slot is out of bounds");
+        return SHIM_FAILURE;
+    }
+
+    if (((uint64_t)0) == args->dirty_bitmap) {
+        bferror("args->dirty_bitmap is NULL");
+        return SHIM_FAILURE;
+    }
+
+    pmut_mut_bitmap = (struct mv_dirty_bitmap_t *)shared_page_for_current_pp();
+    platform_expects(NULL != pmut_mut_bitmap);
+
+    platform_mutex_lock(&pmut_vm->mutex);
+
+    if (((uint64_t)0) == (pmut_vm->slots[mut_slot_id].flags & KVM_MEM_LOG_DIRTY_PAGES)) {
+        bferror("args->slot is not dirty logged");
+        goto dirty_log_failed;
+    }
+
+    mut_num_pages = pmut_vm->slots[mut_slot_id].memory_size;
+    mut_num_pages += (HYPERVISOR_PAGE_SIZE - ((uint64_t)1));
+    mut_num_pages /= HYPERVISOR_PAGE_SIZE;
+    for (mut_page = ((uint64_t)0); mut_page < mut_num_pages; mut_page += mut_pages) {
+        mut_pages = mut_num_pages - mut_page;
+        if (mut_pages > MV_DIRTY_BITMAP_MAX_PAGES) {
+            mut_pages = MV_DIRTY_BITMAP_MAX_PAGES;
+        }
+        else {
+            touch();
+        }
+
+        /// NOTE:
+        /// - KVM sizes the dirty bitmap in longs, which is why the number
+        ///   of bytes copied is rounded up to a whole entry.
+        ///
+
+        mut_bytes = (mut_pages + (bits_per_entry - ((uint64_t)1))) / bits_per_entry;
+        mut_bytes *= sizeof(uint64_t);
+
+        if (mv_vm_op_dirty_log_get(g_mut_hndl, pmut_vm->id, (uint64_t)mut_slot_id, mut_page)) {
+            bferror("mv_vm_op_dirty_log_get failed");
+            goto dirty_log_failed;
+        }
+
+        if (platform_copy_to_user(
+                (void *)(args->dirty_bitmap + (mut_page / bits_per_byte)),
+                pmut_mut_bitmap->entries,
+                mut_bytes)) {
+            bferror("platform_copy_to_user failed");
+            goto dirty_log_failed;
+        }
+
+        if (mv_vm_op_dirty_log_clear(g_mut_hndl, pmut_vm->id, (uint64_t)mut_slot_id, mut_page)) {
+            bferror("mv_vm_op_dirty_log_clear failed");
+            goto dirty_log_failed;
+        }
+    }
+
+    platform_mutex_unlock(&pmut_vm->mutex);
     return SHIM_SUCCESS;
+
+dirty_log_failed:
+
+    platform_mutex_unlock(&pmut_vm->mutex);
+    return SHIM_FAILURE;
 }
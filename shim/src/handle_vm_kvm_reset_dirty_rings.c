@@ -0,0 +1,164 @@
+/**
+ * @copyright
+ * Copyright (C) 2020 Assured Information Security, Inc.
+ *
+ * @copyright
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * @copyright
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * @copyright
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <debug.h>
+#include <detect_hypervisor.h>
+#include <g_mut_hndl.h>
+#include <kvm_dirty_gfn.h>
+#include <mv_constants.h>
+#include <mv_dirty_ring_t.h>
+#include <mv_hypercall.h>
+#include <mv_types.h>
+#include <platform.h>
+#include <shared_page_for_current_pp.h>
+#include <shim_vcpu_t.h>
+#include <shim_vm_t.h>
+#include <touch.h>
+
+/**
+ * <!-- description -->
+ *   @brief Resets every entry in a VCPU's dirty ring that userspace has
+ *     marked as harvested, handing the pages to MicroV so that they are
+ *     write protected again. Entries are reset in order, and the first
+ *     entry that has not been harvested stops the reset.
+ *
+ * <!-- inputs/outputs -->
+ *   @param pmut_vm the VM the VCPU belongs to
+ *   @param pmut_vcpu the VCPU whose dirty ring should be reset
+ *   @param pmut_ring the shared page used to talk to MicroV
+ *   @param pmut_count incremented by the number of entries reset
+ *   @return SHIM_SUCCESS on success, SHIM_FAILURE on failure.
+ */
+NODISCARD static int64_t
+reset_dirty_ring(
+    struct shim_vm_t *const pmut_vm,
+    struct shim_vcpu_t *const pmut_vcpu,
+    struct mv_dirty_ring_t *const pmut_ring,
+    uint64_t *const pmut_count) NOEXCEPT
+{
+    struct kvm_dirty_gfn *pmut_mut_gfn;
+    uint64_t const mask = (pmut_vm->dirty_ring_size / sizeof(struct kvm_dirty_gfn)) - ((uint64_t)1);
+
+    pmut_ring->num_entries = ((uint64_t)0);
+    while (pmut_vcpu->reset_index != pmut_vcpu->dirty_index) {
+        pmut_mut_gfn = &pmut_vcpu->dirty_ring[pmut_vcpu->reset_index & mask];
+        if (((uint32_t)0) == (pmut_mut_gfn->flags & KVM_DIRTY_GFN_F_RESET)) {
+            break;
+        }
+
+        pmut_ring->entries[pmut_ring->num_entries].slot = pmut_mut_gfn->slot;
+        pmut_ring->entries[pmut_ring->num_entries].offset = pmut_mut_gfn->offset;
+        pmut_ring->entries[pmut_ring->num_entries].flags = MV_DIRTY_GFN_FLAG_RESET;
+        ++pmut_ring->num_entries;
+
+        pmut_mut_gfn->flags = ((uint32_t)0);
+        ++pmut_vcpu->reset_index;
+        ++(*pmut_count);
+
+        if (MV_DIRTY_RING_MAX_ENTRIES == pmut_ring->num_entries) {
+            if (mv_vm_op_dirty_ring_reset(g_mut_hndl, pmut_vm->id)) {
+                bferror("mv_vm_op_dirty_ring_reset failed");
+                return SHIM_FAILURE;
+            }
+
+            pmut_ring->num_entries = ((uint64_t)0);
+        }
+        else {
+            touch();
+        }
+    }
+
+    if (((uint64_t)0) == pmut_ring->num_entries) {
+        return SHIM_SUCCESS;
+    }
+
+    if (mv_vm_op_dirty_ring_reset(g_mut_hndl, pmut_vm->id)) {
+        bferror("mv_vm_op_dirty_ring_reset failed");
+        return SHIM_FAILURE;
+    }
+
+    return SHIM_SUCCESS;
+}
+
+/**
+ * <!-- description -->
+ *   @brief Handles the execution of kvm_reset_dirty_rings.
+ *
+ * <!-- inputs/outputs -->
+ *   @param pmut_vm the VM to modify
+ *   @param pmut_ret returns the number of dirty ring entries that were reset
+ *   @return SHIM_SUCCESS on success, SHIM_FAILURE on failure.
+ */
+NODISCARD int64_t
+handle_vm_kvm_reset_dirty_rings(
+    struct shim_vm_t *const pmut_vm, uint32_t *const pmut_ret) NOEXCEPT
+{
+    struct mv_dirty_ring_t *pmut_mut_ring;
+
+    uint64_t mut_i;
+    uint64_t mut_count;
+
+    platform_expects(NULL != pmut_vm);
+    platform_expects(NULL != pmut_ret);
+
+    if (detect_hypervisor()) {
+        bferror("The shim is not running in a VM. Did you forget to start MicroV?");
+        return SHIM_FAILURE;
+    }
+
+    if (((uint64_t)0) == pmut_vm->dirty_ring_size) {
+        bferror("dirty ring is not enabled");
+        return SHIM_FAILURE;
+    }
+
+    pmut_mut_ring = (struct mv_dirty_ring_t *)shared_page_for_current_pp();
+    platform_expects(NULL != pmut_mut_ring);
+
+    mut_count = ((uint64_t)0);
+    platform_mutex_lock(&pmut_vm->mutex);
+
+    for (mut_i = ((uint64_t)0); mut_i < MICROV_MAX_VCPUS; ++mut_i) {
+        if (NULL == pmut_vm->vcpus[mut_i].dirty_ring) {
+            touch();
+        }
+        else if (reset_dirty_ring(pmut_vm, &pmut_vm->vcpus[mut_i], pmut_mut_ring, &mut_count)) {
+            goto reset_dirty_rings_failed;
+        }
+        else {
+            touch();
+        }
+    }
+
+    platform_mutex_unlock(&pmut_vm->mutex);
+
+    *pmut_ret = (uint32_t)mut_count;
+    return SHIM_SUCCESS;
+
+reset_dirty_rings_failed:
+
+    platform_mutex_unlock(&pmut_vm->mutex);
+    return SHIM_FAILURE;
+}
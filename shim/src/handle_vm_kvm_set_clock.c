@@ -24,20 +24,65 @@
  * SOFTWARE.
  */
 
+#include <debug.h>
+#include <detect_hypervisor.h>
+#include <g_mut_hndl.h>
 #include <kvm_clock_data.h>
+#include <mv_constants.h>
+#include <mv_hypercall.h>
 #include <mv_types.h>
+#include <platform.h>
+#include <shim_vm_t.h>
+#include <touch.h>
 
 /**
  * <!-- description -->
- *   @brief Handles the execution of kvm_set_clock.
+ *   @brief Handles the execution of kvm_set_clock. Like KVM, if
+ *     KVM_CLOCK_REALTIME is set, the time that has passed since realtime
+ *     was sampled is added to the provided clock, so that the clock of a
+ *     migrated VM does not fall behind. The wall clock time is also given
+ *     to MicroV so that it can keep the wall clock of the VM up to date.
  *
  * <!-- inputs/outputs -->
- *   @param pmut_ioctl_args the arguments provided by userspace
+ *   @param args the arguments provided by userspace
+ *   @param vm the VM to modify
  *   @return SHIM_SUCCESS on success, SHIM_FAILURE on failure.
  */
 NODISCARD int64_t
-handle_vm_kvm_set_clock(struct kvm_clock_data *const pmut_ioctl_args) NOEXCEPT
+handle_vm_kvm_set_clock(
+    struct kvm_clock_data const *const args, struct shim_vm_t const *const vm) NOEXCEPT
 {
-    (void)pmut_ioctl_args;
+    uint64_t mut_clock;
+    uint64_t mut_realtime;
+
+    platform_expects(MV_INVALID_HANDLE != g_mut_hndl);
+    platform_expects(NULL != args);
+    platform_expects(NULL != vm);
+
+    if (detect_hypervisor()) {
+        bferror("The shim is not running in a VM. Did you forget to start MicroV?");
+        return SHIM_FAILURE;
+    }
+
+    if (((uint32_t)0) != (args->flags & ~KVM_CLOCK_VALID_FLAGS)) {
+        bferror_x64("clock flags are invalid", (uint64_t)args->flags);
+        return SHIM_FAILURE;
+    }
+
+    mut_clock = args->clock;
+    mut_realtime = platform_realtime_ns();
+
+    if ((((uint32_t)0) != (args->flags & KVM_CLOCK_REALTIME)) && (mut_realtime > args->realtime)) {
+        mut_clock += mut_realtime - args->realtime;
+    }
+    else {
+        touch();
+    }
+
+    if (mv_vm_op_clock_set(g_mut_hndl, vm->vmid, mut_clock, mut_realtime)) {
+        bferror("mv_vm_op_clock_set failed");
+        return SHIM_FAILURE;
+    }
+
     return SHIM_SUCCESS;
 }
@@ -27,6 +27,7 @@
 #include <debug.h>
 #include <detect_hypervisor.h>
 #include <g_mut_hndl.h>
+#include <handle_vm_kvm_set_user_memory_region.h>
 #include <kvm_userspace_memory_region.h>
 #include <mv_constants.h>
 #include <mv_hypercall.h>
@@ -86,13 +87,11 @@ handle_vm_kvm_set_user_memory_region(
 {
     struct mv_mdl_t *pmut_mut_mdl;
 
-    int64_t mut_i;
     int64_t mut_size;
 
     uint32_t mut_slot_id;
     uint32_t mut_slot_as;
     uint64_t mut_dst;
-    uint64_t mut_src;
 
     platform_expects(NULL != args);
     platform_expects(NULL != pmut_vm);
@@ -108,7 +107,6 @@ handle_vm_kvm_set_user_memory_region(
     mut_slot_id = get_slot_id(args->slot);
     mut_slot_as = get_slot_as(args->slot);
     mut_dst = args->guest_phys_addr;
-    mut_src = args->userspace_addr;
     mut_size = (int64_t)args->memory_size;
 
     if (!mv_is_page_aligned(args->memory_size)) {
@@ -156,7 +154,8 @@ handle_vm_kvm_set_user_memory_region(
 
     /// TODO:
     /// - Check to make sure that the provided flags are supported by MicroV
-    ///   and then construct the MicroV flags as required.
+    ///   and then construct the MicroV flags as required. The only flag
+    ///   that is currently honored is KVM_MEM_LOG_DIRTY_PAGES.
     ///
 
     /// TODO:
@@ -212,62 +211,27 @@ handle_vm_kvm_set_user_memory_region(
         return SHIM_FAILURE;
     }
 
-    pmut_vm->slots[mut_slot_id] = *args;
-
-    if (platform_mlock((void *)mut_src, args->memory_size)) {
-        bferror("platform_mlock failed");
-        goto platform_mlock_failed;
-    }
-
-    pmut_mut_mdl->num_entries = ((uint64_t)0);
-    for (mut_i = ((int64_t)0); mut_i < mut_size; mut_i += (int64_t)HYPERVISOR_PAGE_SIZE) {
-        uint64_t const dst = mut_dst + (uint64_t)mut_i;
-        uint64_t const src = platform_virt_to_phys_user(mut_src + (uint64_t)mut_i);
-
-        if (((uint64_t)0) == src) {
-            bferror("platform_virt_to_phys_user failed");
-            goto mv_vm_op_mmio_map_failed;
-        }
-
-        pmut_mut_mdl->entries[pmut_mut_mdl->num_entries].dst = dst;
-        pmut_mut_mdl->entries[pmut_mut_mdl->num_entries].src = src;
-        pmut_mut_mdl->entries[pmut_mut_mdl->num_entries].bytes = HYPERVISOR_PAGE_SIZE;
-        ++pmut_mut_mdl->num_entries;
-
-        /// TODO:
-        /// - Need to add support for memory flags. Right now, MicroV ignores
-        ///   the flags field and always sets the memory to RWE. This needs
-        ///   to be fixed, and then we will need to translate the KVM flags
-        ///   to MicroV flags here and send them up properly.
-        ///
+    /// NOTE:
+    /// - The slot is only recorded here. No memory is pinned or mapped
+    ///   into MicroV until the guest actually touches it. The first
+    ///   access to each region of the slot generates an MMIO exit, which
+    ///   is handled by KVM_RUN by mapping the region that was touched
+    ///   (see SHIM_VM_POPULATE_SIZE). This keeps this IOCTL O(1) with
+    ///   respect to the size of the slot, and memory that the guest never
+    ///   touches is never pinned.
+    ///
 
-        /// TODO:
-        /// - Right now MicroV assumes that every entry is 4k in size.
-        ///   Instead, it should be modified to handle any page aligned
-        ///   size. This code should then look to see if the previous
-        ///   entry is contiguous with this one. If it is, all we need
-        ///   to do is increment the previous entry's total bytes by a
-        ///   page size. Contiguous memory is HIGHLY likely, and will
-        ///   dramatically reduce how often this code has to hypercall
-        ///   up to MicroV by "compressing" the entires.
-        ///
-        if (pmut_mut_mdl->num_entries >= MV_MDL_MAX_ENTRIES) {
-            if (mv_vm_op_mmio_map(g_mut_hndl, pmut_vm->id, MV_SELF_ID)) {
-                bferror("mv_vm_op_mmio_map failed");
-                goto mv_vm_op_mmio_map_failed;
-            }
+    pmut_vm->slots[mut_slot_id] = *args;
 
-            pmut_mut_mdl->num_entries = ((uint64_t)0);
-        }
-        else {
-            touch();
-        }
-    }
+    if (((uint64_t)0) != (args->flags & KVM_MEM_LOG_DIRTY_PAGES)) {
+        pmut_mut_mdl->num_entries = ((uint64_t)1);
+        pmut_mut_mdl->entries[0].dst = mut_dst;
+        pmut_mut_mdl->entries[0].src = ((uint64_t)0);
+        pmut_mut_mdl->entries[0].bytes = (uint64_t)mut_size;
 
-    if (((uint64_t)0) != pmut_mut_mdl->num_entries) {
-        if (mv_vm_op_mmio_map(g_mut_hndl, pmut_vm->id, MV_SELF_ID)) {
-            bferror("mv_vm_op_mmio_map failed");
-            goto mv_vm_op_mmio_map_failed;
+        if (mv_vm_op_dirty_log_enable(g_mut_hndl, pmut_vm->id, (uint64_t)mut_slot_id)) {
+            bferror("mv_vm_op_dirty_log_enable failed");
+            goto mv_vm_op_dirty_log_enable_failed;
         }
 
         touch();
@@ -279,60 +243,9 @@ handle_vm_kvm_set_user_memory_region(
     platform_mutex_unlock(&pmut_vm->mutex);
     return SHIM_SUCCESS;
 
-mv_vm_op_mmio_map_failed:
-
-    /// NOTE:
-    /// - If an error occurs, we need to undo what we have already started.
-    ///   For example, MicroV might run out of pages and throw an error. Or
-    ///   userspace might attempt to provide overlapping slots, which is not
-    ///   supported.
-    ///
-    /// - To undo what we stared above, we need to perform the operations
-    ///   above in reverse. When we add SMP support, we need to be careful
-    ///   here. Any modifications here that the guest on a remote PP can
-    ///   pull into it's TLB need to also be reversed, so a TLB flush on
-    ///   every single hypercall would be needed to ensure consistency. If
-    ///   the other PP's are paused until this entire IOCTL is complete,
-    ///   there would be no issue, but that is a really bad idea, as the MMIO
-    ///   hypercalls are slow, and likely will require continuations in the
-    ///   future, meaning pausing a guest's VPs is likely very expensive.
-    ///
-    /// - With any luck, this IOCTL is only used on startup, in which case
-    ///   these issues are only really a problem if we ever attempt to
-    ///   support migration.
-    ///
-
-    pmut_mut_mdl->num_entries = ((uint64_t)0);
-    for (; mut_i >= ((int64_t)0); mut_i -= HYPERVISOR_PAGE_SIZE) {
-        uint64_t const dst = mut_dst + (uint64_t)mut_i;
-        uint64_t const src = platform_virt_to_phys((void *)(mut_src + (uint64_t)mut_i));
-
-        pmut_mut_mdl->entries[pmut_mut_mdl->num_entries].dst = dst;
-        pmut_mut_mdl->entries[pmut_mut_mdl->num_entries].src = src;
-        pmut_mut_mdl->entries[pmut_mut_mdl->num_entries].bytes = HYPERVISOR_PAGE_SIZE;
-        ++pmut_mut_mdl->num_entries;
-
-        if (pmut_mut_mdl->num_entries >= MV_MDL_MAX_ENTRIES) {
-            (void)mv_vm_op_mmio_unmap(g_mut_hndl, pmut_vm->id);
-
-            pmut_mut_mdl->num_entries = ((uint64_t)0);
-        }
-        else {
-            touch();
-        }
-    }
-
-    if (((uint64_t)0) != pmut_mut_mdl->num_entries) {
-        (void)mv_vm_op_mmio_unmap(g_mut_hndl, pmut_vm->id);
-
-        touch();
-    }
-    else {
-        touch();
-    }
+mv_vm_op_dirty_log_enable_failed:
 
-    platform_expects(SHIM_SUCCESS == platform_munlock((void *)mut_src, args->memory_size));
-platform_mlock_failed:
+    platform_memset(&pmut_vm->slots[mut_slot_id], ((uint8_t)0), sizeof(pmut_vm->slots[mut_slot_id]));
 
     platform_mutex_unlock(&pmut_vm->mutex);
     return SHIM_FAILURE;
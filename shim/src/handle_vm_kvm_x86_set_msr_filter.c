@@ -0,0 +1,358 @@
+/**
+ * @copyright
+ * Copyright (C) 2020 Assured Information Security, Inc.
+ *
+ * @copyright
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * @copyright
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * @copyright
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <debug.h>
+#include <detect_hypervisor.h>
+#include <g_mut_hndl.h>
+#include <kvm_msr_filter.h>
+#include <mv_constants.h>
+#include <mv_hypercall.h>
+#include <mv_types.h>
+#include <platform.h>
+#include <shim_vm_t.h>
+#include <touch.h>
+
+/** @brief defines the number of MSRs in each range of MicroV's MSR permissions map */
+#define SHIM_MSR_FILTER_WINDOW ((uint64_t)0x2000)
+
+/**
+ * <!-- description -->
+ *   @brief Returns the accesses (MV_PERM_READ/MV_PERM_WRITE) to the
+ *     provided MSR that are denied by the provided filter. Like KVM, for
+ *     each access, the first range that covers the MSR and applies to the
+ *     access decides, and MSRs that no range applies to are allowed.
+ *
+ * <!-- inputs/outputs -->
+ *   @param filter the filter to query
+ *   @param bitmaps the shim's copy of the bitmap of each range of filter
+ *   @param msr the MSR to query
+ *   @return Returns the accesses to the provided MSR that are denied.
+ */
+NODISCARD static uint64_t
+msr_filter_denied(
+    struct kvm_msr_filter const *const filter,
+    uint8_t *const *const bitmaps,
+    uint64_t const msr) NOEXCEPT
+{
+    uint64_t mut_i;
+    uint64_t mut_idx;
+    uint64_t mut_byte;
+    uint64_t mut_decided = ((uint64_t)0);
+    uint64_t mut_denied = ((uint64_t)0);
+
+    uint64_t const bits = ((uint64_t)8);
+    uint64_t const one = ((uint64_t)1);
+
+    for (mut_i = ((uint64_t)0); mut_i < ((uint64_t)KVM_MSR_FILTER_MAX_RANGES); ++mut_i) {
+        struct kvm_msr_filter_range const *const range = &filter->ranges[mut_i];
+        uint64_t const perms = ((uint64_t)range->flags) & ~mut_decided;
+
+        if ((NULL == bitmaps[mut_i]) || (((uint64_t)0) == perms)) {
+            touch();
+        }
+        else if ((msr < (uint64_t)range->base) || ((msr - range->base) >= range->nmsrs)) {
+            touch();
+        }
+        else {
+            mut_idx = msr - (uint64_t)range->base;
+            mut_byte = (uint64_t)bitmaps[mut_i][mut_idx / bits];
+            mut_decided |= perms;
+
+            if (((uint64_t)0) == ((mut_byte >> (mut_idx % bits)) & one)) {
+                mut_denied |= perms;
+            }
+            else {
+                touch();
+            }
+        }
+    }
+
+    /// NOTE:
+    /// - KVM_MSR_FILTER_READ/WRITE have the same values as MV_PERM_READ
+    ///   and MV_PERM_WRITE.
+    ///
+
+    return mut_denied;
+}
+
+/**
+ * <!-- description -->
+ *   @brief Tells MicroV which MSRs the provided filter denies. MicroV is
+ *     given one run of MSRs with the same denied accesses at a time, and
+ *     runs never span more than one range of MicroV's MSR permissions map.
+ *     If clear is set, the denied MSRs are removed from MicroV's filter
+ *     instead, which is how a previous filter is replaced.
+ *
+ * <!-- inputs/outputs -->
+ *   @param vm the VM to modify
+ *   @param filter the filter to apply
+ *   @param bitmaps the shim's copy of the bitmap of each range of filter
+ *   @param clear if set, the denied MSRs are removed from MicroV's filter
+ *   @return SHIM_SUCCESS on success, SHIM_FAILURE on failure.
+ */
+NODISCARD static int64_t
+msr_filter_apply(
+    struct shim_vm_t const *const vm,
+    struct kvm_msr_filter const *const filter,
+    uint8_t *const *const bitmaps,
+    int const clear) NOEXCEPT
+{
+    uint64_t mut_i;
+    uint64_t mut_msr;
+    uint64_t mut_first;
+    uint64_t mut_perms;
+    uint64_t mut_run_perms;
+
+    uint64_t const window_mask = ~(SHIM_MSR_FILTER_WINDOW - ((uint64_t)1));
+    uint64_t const last_shft = ((uint64_t)32);
+
+    for (mut_i = ((uint64_t)0); mut_i < ((uint64_t)KVM_MSR_FILTER_MAX_RANGES); ++mut_i) {
+        struct kvm_msr_filter_range const *const range = &filter->ranges[mut_i];
+        uint64_t const end = (uint64_t)range->base + (uint64_t)range->nmsrs;
+
+        if (NULL == bitmaps[mut_i]) {
+            continue;
+        }
+
+        mut_first = (uint64_t)range->base;
+        mut_run_perms = msr_filter_denied(filter, bitmaps, mut_first);
+
+        for (mut_msr = mut_first + ((uint64_t)1); mut_msr <= end; ++mut_msr) {
+            if (mut_msr < end) {
+                mut_perms = msr_filter_denied(filter, bitmaps, mut_msr);
+                if ((mut_perms == mut_run_perms) &&
+                    ((mut_msr & window_mask) == (mut_first & window_mask))) {
+                    continue;
+                }
+            }
+            else {
+                mut_perms = ((uint64_t)0);
+            }
+
+            if (((uint64_t)0) != mut_run_perms) {
+                if (mv_vm_op_msr_filter(
+                        g_mut_hndl,
+                        vm->vmid,
+                        mut_first | ((mut_msr - ((uint64_t)1)) << last_shft),
+                        clear ? ((uint64_t)0) : mut_run_perms)) {
+                    bferror_x64("mv_vm_op_msr_filter failed", mut_first);
+                    return SHIM_FAILURE;
+                }
+            }
+            else {
+                touch();
+            }
+
+            mut_first = mut_msr;
+            mut_run_perms = mut_perms;
+        }
+    }
+
+    return SHIM_SUCCESS;
+}
+
+/**
+ * <!-- description -->
+ *   @brief Frees the provided bitmaps of the provided filter.
+ *
+ * <!-- inputs/outputs -->
+ *   @param filter the filter the bitmaps belong to
+ *   @param pmut_bitmaps the bitmaps to free
+ */
+static void
+msr_filter_free(
+    struct kvm_msr_filter const *const filter, uint8_t **const pmut_bitmaps) NOEXCEPT
+{
+    uint64_t mut_i;
+
+    for (mut_i = ((uint64_t)0); mut_i < ((uint64_t)KVM_MSR_FILTER_MAX_RANGES); ++mut_i) {
+        if (NULL != pmut_bitmaps[mut_i]) {
+            platform_free(
+                pmut_bitmaps[mut_i], shim_vm_msr_filter_bitmap_size(&filter->ranges[mut_i]));
+            pmut_bitmaps[mut_i] = NULL;
+        }
+        else {
+            touch();
+        }
+    }
+}
+
+/**
+ * <!-- description -->
+ *   @brief Validates the provided range and copies its bitmap from
+ *     userspace. Empty ranges are ignored and leave the bitmap NULL.
+ *
+ * <!-- inputs/outputs -->
+ *   @param range the range to copy
+ *   @param pmut_bitmap where to return the shim's copy of the bitmap
+ *   @return SHIM_SUCCESS on success, SHIM_FAILURE on failure.
+ */
+NODISCARD static int64_t
+msr_filter_copy_range(
+    struct kvm_msr_filter_range const *const range, uint8_t **const pmut_bitmap) NOEXCEPT
+{
+    uint64_t const max_nmsrs = ((uint64_t)KVM_MSR_FILTER_MAX_BITMAP_SIZE) * ((uint64_t)8);
+    uint64_t const max_msr = ((uint64_t)1) << ((uint64_t)32);
+
+    *pmut_bitmap = NULL;
+
+    if (((uint32_t)0) == range->nmsrs) {
+        return SHIM_SUCCESS;
+    }
+
+    if (((uint32_t)0) != (range->flags & ~KVM_MSR_FILTER_RANGE_VALID_MASK)) {
+        bferror_x64("range flags are invalid", (uint64_t)range->flags);
+        return SHIM_FAILURE;
+    }
+
+    if (((uint32_t)0) == range->flags) {
+        bferror("range flags are missing");
+        return SHIM_FAILURE;
+    }
+
+    if ((uint64_t)range->nmsrs > max_nmsrs) {
+        bferror_x64("range nmsrs is too large", (uint64_t)range->nmsrs);
+        return SHIM_FAILURE;
+    }
+
+    if (((uint64_t)range->base + (uint64_t)range->nmsrs) > max_msr) {
+        bferror_x64("range is out of bounds", (uint64_t)range->base);
+        return SHIM_FAILURE;
+    }
+
+    if (((uint64_t)0) == range->bitmap) {
+        bferror("range bitmap is NULL");
+        return SHIM_FAILURE;
+    }
+
+    *pmut_bitmap = (uint8_t *)platform_alloc(shim_vm_msr_filter_bitmap_size(range));
+    if (NULL == *pmut_bitmap) {
+        bferror("platform_alloc failed");
+        return SHIM_FAILURE;
+    }
+
+    if (platform_copy_from_user(
+            *pmut_bitmap, (void const *)range->bitmap, shim_vm_msr_filter_bitmap_size(range))) {
+        bferror("platform_copy_from_user failed");
+        return SHIM_FAILURE;
+    }
+
+    return SHIM_SUCCESS;
+}
+
+/**
+ * <!-- description -->
+ *   @brief Handles the execution of kvm_x86_set_msr_filter. The MSRs
+ *     denied by the previous filter are removed from MicroV's filter and
+ *     the MSRs denied by the new filter are added, so that denied accesses
+ *     return KVM_EXIT_X86_RDMSR/WRMSR to userspace once
+ *     KVM_CAP_X86_USER_SPACE_MSR is enabled with KVM_MSR_EXIT_REASON_FILTER.
+ *     If this fails, the VM is left without a filter.
+ *
+ * <!-- inputs/outputs -->
+ *   @param args the arguments provided by userspace
+ *   @param pmut_vm the VM to modify
+ *   @return SHIM_SUCCESS on success, SHIM_FAILURE on failure.
+ */
+NODISCARD int64_t
+handle_vm_kvm_x86_set_msr_filter(
+    struct kvm_msr_filter const *const args, struct shim_vm_t *const pmut_vm) NOEXCEPT
+{
+    uint64_t mut_i;
+    uint8_t *pmut_mut_bitmaps[KVM_MSR_FILTER_MAX_RANGES];
+
+    platform_expects(NULL != args);
+    platform_expects(NULL != pmut_vm);
+
+    if (detect_hypervisor()) {
+        bferror("The shim is not running in a VM. Did you forget to start MicroV?");
+        return SHIM_FAILURE;
+    }
+
+    /// TODO:
+    /// - KVM_MSR_FILTER_DEFAULT_DENY would need MicroV to filter every
+    ///   MSR, including the ones that are not covered by the MSR
+    ///   permissions map, which it cannot do.
+    ///
+
+    if (KVM_MSR_FILTER_DEFAULT_ALLOW != args->flags) {
+        bferror_x64("args->flags is invalid/unsupported", (uint64_t)args->flags);
+        return SHIM_FAILURE;
+    }
+
+    platform_memset(pmut_mut_bitmaps, ((uint8_t)0), sizeof(pmut_mut_bitmaps));
+    for (mut_i = ((uint64_t)0); mut_i < ((uint64_t)KVM_MSR_FILTER_MAX_RANGES); ++mut_i) {
+        if (msr_filter_copy_range(&args->ranges[mut_i], &pmut_mut_bitmaps[mut_i])) {
+            bferror("msr_filter_copy_range failed");
+            msr_filter_free(args, pmut_mut_bitmaps);
+            return SHIM_FAILURE;
+        }
+    }
+
+    platform_mutex_lock(&pmut_vm->mutex);
+
+    if (msr_filter_apply(pmut_vm, &pmut_vm->msr_filter, pmut_vm->msr_filter_bitmaps, 1)) {
+        bferror("msr_filter_apply failed");
+        goto msr_filter_failed;
+    }
+
+    msr_filter_free(&pmut_vm->msr_filter, pmut_vm->msr_filter_bitmaps);
+    platform_memset(&pmut_vm->msr_filter, ((uint8_t)0), sizeof(pmut_vm->msr_filter));
+
+    if (msr_filter_apply(pmut_vm, args, pmut_mut_bitmaps, 0)) {
+        bferror("msr_filter_apply failed");
+        goto msr_filter_failed;
+    }
+
+    pmut_vm->msr_filter = *args;
+    for (mut_i = ((uint64_t)0); mut_i < ((uint64_t)KVM_MSR_FILTER_MAX_RANGES); ++mut_i) {
+        pmut_vm->msr_filter_bitmaps[mut_i] = pmut_mut_bitmaps[mut_i];
+    }
+
+    platform_mutex_unlock(&pmut_vm->mutex);
+    return SHIM_SUCCESS;
+
+msr_filter_failed:
+
+    /// NOTE:
+    /// - Whatever part of the new filter made it to MicroV is removed
+    ///   again on a best effort basis.
+    ///
+
+    if (msr_filter_apply(pmut_vm, args, pmut_mut_bitmaps, 1)) {
+        bferror("msr_filter_apply failed");
+    }
+    else {
+        touch();
+    }
+
+    msr_filter_free(args, pmut_mut_bitmaps);
+    msr_filter_free(&pmut_vm->msr_filter, pmut_vm->msr_filter_bitmaps);
+    platform_memset(&pmut_vm->msr_filter, ((uint8_t)0), sizeof(pmut_vm->msr_filter));
+
+    platform_mutex_unlock(&pmut_vm->mutex);
+    return SHIM_FAILURE;
+}
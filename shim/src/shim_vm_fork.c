@@ -0,0 +1,486 @@
+/**
+ * @copyright
+ * Copyright (C) 2020 Assured Information Security, Inc.
+ *
+ * @copyright
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * @copyright
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * @copyright
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <debug.h>
+#include <detect_hypervisor.h>
+#include <g_mut_hndl.h>
+#include <handle_vm_kvm_set_user_memory_region.h>
+#include <kvm_userspace_memory_region.h>
+#include <mv_constants.h>
+#include <mv_hypercall.h>
+#include <mv_mdl_t.h>
+#include <mv_types.h>
+#include <platform.h>
+#include <shared_page_for_current_pp.h>
+#include <shim_vm_fork.h>
+#include <shim_vm_t.h>
+#include <touch.h>
+
+/**
+ * <!-- description -->
+ *   @brief Adds the populated regions of the provided slot to the
+ *     provided MDL. Regions are clamped to the slot, and regions that are
+ *     next to each other are merged into a single entry.
+ *
+ * <!-- inputs/outputs -->
+ *   @param pmut_mdl the MDL to add the regions to
+ *   @param slot the slot that owns the regions
+ *   @param populated the bitmap of the populated regions of the slot
+ *   @return SHIM_SUCCESS on success, SHIM_FAILURE on failure.
+ */
+NODISCARD static int64_t
+add_populated_regions(
+    struct mv_mdl_t *const pmut_mdl,
+    struct kvm_userspace_memory_region const *const slot,
+    uint64_t const *const populated) NOEXCEPT
+{
+    uint64_t mut_region;
+    uint64_t mut_gpa;
+    uint64_t mut_end;
+    struct mv_mdl_entry_t *pmut_mut_last;
+
+    uint64_t const one = ((uint64_t)1);
+    uint64_t const bits = ((uint64_t)64);
+    uint64_t const mask = ~(SHIM_VM_POPULATE_SIZE - one);
+    uint64_t const regions = shim_vm_populated_size(slot) * ((uint64_t)8);
+    uint64_t const slot_end = mv_page_aligned(
+        slot->guest_phys_addr + slot->memory_size + (HYPERVISOR_PAGE_SIZE - one));
+
+    for (mut_region = ((uint64_t)0); mut_region < regions; ++mut_region) {
+        if (((uint64_t)0) == (populated[mut_region / bits] & (one << (mut_region % bits)))) {
+            continue;
+        }
+
+        mut_gpa = (slot->guest_phys_addr & mask) + (mut_region * SHIM_VM_POPULATE_SIZE);
+        mut_end = mut_gpa + SHIM_VM_POPULATE_SIZE;
+
+        if (mut_gpa < slot->guest_phys_addr) {
+            mut_gpa = slot->guest_phys_addr;
+        }
+        else {
+            touch();
+        }
+
+        if (mut_end > slot_end) {
+            mut_end = slot_end;
+        }
+        else {
+            touch();
+        }
+
+        if (((uint64_t)0) != pmut_mdl->num_entries) {
+            pmut_mut_last = &pmut_mdl->entries[pmut_mdl->num_entries - one];
+            if ((pmut_mut_last->dst + pmut_mut_last->bytes) == mut_gpa) {
+                pmut_mut_last->bytes += mut_end - mut_gpa;
+                continue;
+            }
+
+            touch();
+        }
+        else {
+            touch();
+        }
+
+        if (pmut_mdl->num_entries >= MV_MDL_MAX_ENTRIES) {
+            bferror("the parent VM has too many populated regions to fork");
+            return SHIM_FAILURE;
+        }
+
+        pmut_mdl->entries[pmut_mdl->num_entries].dst = mut_gpa;
+        pmut_mdl->entries[pmut_mdl->num_entries].src = ((uint64_t)0);
+        pmut_mdl->entries[pmut_mdl->num_entries].bytes = mut_end - mut_gpa;
+        ++pmut_mdl->num_entries;
+    }
+
+    return SHIM_SUCCESS;
+}
+
+/**
+ * <!-- description -->
+ *   @brief Returns SHIM_SUCCESS if the provided VM can be forked from the
+ *     provided parent VM. The VM cannot have any VCPUs or populated
+ *     regions, and its slots must match the parent's slots.
+ *
+ * <!-- inputs/outputs -->
+ *   @param vm the VM to fork into
+ *   @param parent the VM to fork
+ *   @param sizes the bitmap sizes that were allocated for each slot
+ *   @return SHIM_SUCCESS on success, SHIM_FAILURE on failure.
+ */
+NODISCARD static int64_t
+verify_fork(
+    struct shim_vm_t const *const vm,
+    struct shim_vm_t const *const parent,
+    uint64_t const *const sizes) NOEXCEPT
+{
+    uint64_t mut_i;
+    struct kvm_userspace_memory_region const *mut_slot;
+    struct kvm_userspace_memory_region const *mut_parent_slot;
+
+    if (NULL != vm->parent) {
+        bferror("the VM has already been forked");
+        return SHIM_FAILURE;
+    }
+
+    if (NULL != parent->parent) {
+        bferror("a VM that was forked cannot be forked");
+        return SHIM_FAILURE;
+    }
+
+    for (mut_i = ((uint64_t)0); mut_i < MICROV_MAX_VCPUS; ++mut_i) {
+        if (((uint64_t)0) != vm->vcpus[mut_i].fd) {
+            bferror("a VM must be forked before any vcpu is created");
+            return SHIM_FAILURE;
+        }
+
+        touch();
+    }
+
+    for (mut_i = ((uint64_t)0); mut_i < MICROV_MAX_SLOTS; ++mut_i) {
+        if (NULL != vm->populated[mut_i]) {
+            bferror("a VM cannot be forked once it has been populated");
+            return SHIM_FAILURE;
+        }
+
+        mut_slot = &vm->slots[mut_i];
+        mut_parent_slot = &parent->slots[mut_i];
+
+        if (((uint64_t)0) == mut_parent_slot->memory_size) {
+            continue;
+        }
+
+        if (((uint64_t)0) == sizes[mut_i]) {
+            bferror_d64("the VM is missing a slot of the parent VM", mut_i);
+            return SHIM_FAILURE;
+        }
+
+        if (mut_slot->guest_phys_addr != mut_parent_slot->guest_phys_addr) {
+            bferror_d64("the slot does not match the slot of the parent VM", mut_i);
+            return SHIM_FAILURE;
+        }
+
+        if (mut_slot->memory_size != mut_parent_slot->memory_size) {
+            bferror_d64("the slot does not match the slot of the parent VM", mut_i);
+            return SHIM_FAILURE;
+        }
+
+        touch();
+    }
+
+    return SHIM_SUCCESS;
+}
+
+/**
+ * <!-- description -->
+ *   @brief Enables dirty logging on the new MicroV VM for every slot of
+ *     the provided VM that was created with KVM_MEM_LOG_DIRTY_PAGES.
+ *
+ * <!-- inputs/outputs -->
+ *   @param vm the VM that was forked
+ *   @return SHIM_SUCCESS on success, SHIM_FAILURE on failure.
+ */
+NODISCARD static int64_t
+enable_dirty_logging(struct shim_vm_t const *const vm) NOEXCEPT
+{
+    uint64_t mut_i;
+    struct mv_mdl_t *pmut_mut_mdl;
+    struct kvm_userspace_memory_region const *mut_slot;
+
+    uint64_t const one = ((uint64_t)1);
+
+    pmut_mut_mdl = (struct mv_mdl_t *)shared_page_for_current_pp();
+    platform_expects(NULL != pmut_mut_mdl);
+
+    for (mut_i = ((uint64_t)0); mut_i < MICROV_MAX_SLOTS; ++mut_i) {
+        mut_slot = &vm->slots[mut_i];
+        if (((uint64_t)0) == (mut_slot->flags & KVM_MEM_LOG_DIRTY_PAGES)) {
+            continue;
+        }
+
+        pmut_mut_mdl->num_entries = one;
+        pmut_mut_mdl->entries[0].dst = mut_slot->guest_phys_addr;
+        pmut_mut_mdl->entries[0].src = ((uint64_t)0);
+        pmut_mut_mdl->entries[0].bytes =
+            mv_page_aligned(mut_slot->memory_size + (HYPERVISOR_PAGE_SIZE - one));
+
+        if (mv_vm_op_dirty_log_enable(g_mut_hndl, vm->id, mut_i)) {
+            bferror("mv_vm_op_dirty_log_enable failed");
+            return SHIM_FAILURE;
+        }
+
+        touch();
+    }
+
+    return SHIM_SUCCESS;
+}
+
+/**
+ * <!-- description -->
+ *   @brief Turns the provided VM into a copy-on-write fork of the
+ *     provided parent VM (see KVM_CAP_MICROV_FORK). Every region of
+ *     the parent's slots that is mapped into MicroV is shared with the
+ *     VM read-only, so the cost of a fork is proportional to the
+ *     memory the parent has touched and not the size of its slots.
+ *     The first write to a shared page gives the VM its own copy of
+ *     that page (see handle_vcpu_kvm_run).
+ *
+ *   @note The VM must have the same slots as the parent, each of which
+ *     must be a private mapping of the memory that backs the parent's
+ *     slot, and it must not have any VCPUs yet. VCPU state is cloned
+ *     by userspace using the existing register IOCTLs. The parent
+ *     must not run while it has children.
+ *
+ * <!-- inputs/outputs -->
+ *   @param pmut_vm the VM to fork into
+ *   @param pmut_parent the VM to fork
+ *   @return SHIM_SUCCESS on success, SHIM_FAILURE on failure.
+ */
+NODISCARD int64_t
+shim_vm_fork(struct shim_vm_t *const pmut_vm, struct shim_vm_t *const pmut_parent) NOEXCEPT
+{
+    struct mv_mdl_t *pmut_mut_mdl;
+    uint64_t *pmut_mut_populated[MICROV_MAX_SLOTS];
+    uint64_t *pmut_mut_shared[MICROV_MAX_SLOTS];
+    uint64_t mut_sizes[MICROV_MAX_SLOTS];
+
+    uint64_t mut_i;
+    uint16_t mut_vmid;
+
+    platform_expects(MV_INVALID_HANDLE != g_mut_hndl);
+    platform_expects(NULL != pmut_vm);
+    platform_expects(NULL != pmut_parent);
+
+    if (detect_hypervisor()) {
+        bferror("The shim is not running in a VM. Did you forget to start MicroV?");
+        return SHIM_FAILURE;
+    }
+
+    if (pmut_vm == pmut_parent) {
+        bferror("a VM cannot be forked from itself");
+        return SHIM_FAILURE;
+    }
+
+    /// NOTE:
+    /// - The bitmaps are allocated before any lock is taken as the host
+    ///   might have to reclaim memory to satisfy the allocation, which
+    ///   can invalidate the memory of either VM, which in turn needs
+    ///   their locks (see shim_vm_invalidate_range_start). Slots cannot
+    ///   be modified once they are set, so the sizes stay valid.
+    ///
+
+    platform_mutex_lock(&pmut_vm->mutex);
+    for (mut_i = ((uint64_t)0); mut_i < MICROV_MAX_SLOTS; ++mut_i) {
+        if (((uint64_t)0) != pmut_vm->slots[mut_i].memory_size) {
+            mut_sizes[mut_i] = shim_vm_populated_size(&pmut_vm->slots[mut_i]);
+        }
+        else {
+            mut_sizes[mut_i] = ((uint64_t)0);
+        }
+    }
+    platform_mutex_unlock(&pmut_vm->mutex);
+
+    for (mut_i = ((uint64_t)0); mut_i < MICROV_MAX_SLOTS; ++mut_i) {
+        pmut_mut_populated[mut_i] = NULL;
+        pmut_mut_shared[mut_i] = NULL;
+    }
+
+    for (mut_i = ((uint64_t)0); mut_i < MICROV_MAX_SLOTS; ++mut_i) {
+        if (((uint64_t)0) == mut_sizes[mut_i]) {
+            continue;
+        }
+
+        pmut_mut_populated[mut_i] = (uint64_t *)platform_alloc(mut_sizes[mut_i]);
+        if (NULL == pmut_mut_populated[mut_i]) {
+            bferror("platform_alloc failed");
+            goto failure;
+        }
+
+        pmut_mut_shared[mut_i] = (uint64_t *)platform_alloc(mut_sizes[mut_i]);
+        if (NULL == pmut_mut_shared[mut_i]) {
+            bferror("platform_alloc failed");
+            goto failure;
+        }
+    }
+
+    platform_mutex_lock(&pmut_parent->mutex);
+    platform_mutex_lock(&pmut_vm->mutex);
+
+    if (verify_fork(pmut_vm, pmut_parent, mut_sizes)) {
+        bferror("verify_fork failed");
+        goto failure_locked;
+    }
+
+    pmut_mut_mdl = (struct mv_mdl_t *)shared_page_for_current_pp();
+    platform_expects(NULL != pmut_mut_mdl);
+
+    pmut_mut_mdl->num_entries = ((uint64_t)0);
+    for (mut_i = ((uint64_t)0); mut_i < MICROV_MAX_SLOTS; ++mut_i) {
+        if (NULL == pmut_parent->populated[mut_i]) {
+            continue;
+        }
+
+        if (add_populated_regions(
+                pmut_mut_mdl, &pmut_parent->slots[mut_i], pmut_parent->populated[mut_i])) {
+            bferror("add_populated_regions failed");
+            goto failure_locked;
+        }
+    }
+
+    /// NOTE:
+    /// - If the parent has not touched any of its memory, there is
+    ///   nothing to share, and the VM that we already have is as good
+    ///   as a fork.
+    ///
+
+    if (((uint64_t)0) == pmut_mut_mdl->num_entries) {
+        goto done;
+    }
+
+    mut_vmid = mv_vm_op_fork_vm(g_mut_hndl, pmut_parent->vmid);
+    if (MV_INVALID_ID == (int32_t)mut_vmid) {
+        bferror("mv_vm_op_fork_vm failed");
+        goto failure_locked;
+    }
+
+    if (mv_vm_op_destroy_vm(g_mut_hndl, pmut_vm->vmid)) {
+        bferror("mv_vm_op_destroy_vm failed");
+
+        if (mv_vm_op_destroy_vm(g_mut_hndl, mut_vmid)) {
+            bferror("mv_vm_op_destroy_vm failed");
+        }
+        else {
+            touch();
+        }
+
+        goto failure_locked;
+    }
+
+    pmut_vm->vmid = mut_vmid;
+    pmut_vm->id = mut_vmid;
+
+    if (enable_dirty_logging(pmut_vm)) {
+        bferror("enable_dirty_logging failed");
+        goto failure_locked;
+    }
+
+    for (mut_i = ((uint64_t)0); mut_i < MICROV_MAX_SLOTS; ++mut_i) {
+        if (NULL == pmut_parent->populated[mut_i]) {
+            continue;
+        }
+
+        platform_memcpy(pmut_mut_populated[mut_i], pmut_parent->populated[mut_i], mut_sizes[mut_i]);
+        platform_memcpy(pmut_mut_shared[mut_i], pmut_parent->populated[mut_i], mut_sizes[mut_i]);
+
+        pmut_vm->populated[mut_i] = pmut_mut_populated[mut_i];
+        pmut_vm->shared[mut_i] = pmut_mut_shared[mut_i];
+
+        pmut_mut_populated[mut_i] = NULL;
+        pmut_mut_shared[mut_i] = NULL;
+    }
+
+    /// NOTE:
+    /// - The parent keeps track of its children so that when the host
+    ///   invalidates the parent's memory, the pages that its children
+    ///   share are unmapped as well (see shim_vm_invalidate_range_start).
+    ///
+
+    pmut_vm->parent = pmut_parent;
+    pmut_vm->sibling = pmut_parent->children;
+    pmut_parent->children = pmut_vm;
+
+done:
+
+    platform_mutex_unlock(&pmut_vm->mutex);
+    platform_mutex_unlock(&pmut_parent->mutex);
+
+    for (mut_i = ((uint64_t)0); mut_i < MICROV_MAX_SLOTS; ++mut_i) {
+        platform_free(pmut_mut_populated[mut_i], mut_sizes[mut_i]);
+        platform_free(pmut_mut_shared[mut_i], mut_sizes[mut_i]);
+    }
+
+    return SHIM_SUCCESS;
+
+failure_locked:
+
+    platform_mutex_unlock(&pmut_vm->mutex);
+    platform_mutex_unlock(&pmut_parent->mutex);
+
+failure:
+
+    for (mut_i = ((uint64_t)0); mut_i < MICROV_MAX_SLOTS; ++mut_i) {
+        platform_free(pmut_mut_populated[mut_i], mut_sizes[mut_i]);
+        platform_free(pmut_mut_shared[mut_i], mut_sizes[mut_i]);
+    }
+
+    return SHIM_FAILURE;
+}
+
+/**
+ * <!-- description -->
+ *   @brief Removes the provided VM from the children of the VM it was
+ *     forked from. This must be called before a forked VM is destroyed.
+ *     If the VM was not forked, this function does nothing.
+ *
+ * <!-- inputs/outputs -->
+ *   @param pmut_vm the VM to remove
+ *   @return Returns 1 if the VM was the last child of a parent that
+ *     userspace has already released, in which case the caller must
+ *     release the parent. Returns 0 otherwise.
+ */
+NODISCARD int
+shim_vm_unfork(struct shim_vm_t *const pmut_vm) NOEXCEPT
+{
+    struct shim_vm_t **pmut_mut_link;
+    struct shim_vm_t *pmut_mut_parent;
+    int mut_ret;
+
+    platform_expects(NULL != pmut_vm);
+
+    pmut_mut_parent = pmut_vm->parent;
+    if (NULL == pmut_mut_parent) {
+        return 0;
+    }
+
+    platform_mutex_lock(&pmut_mut_parent->mutex);
+
+    pmut_mut_link = &pmut_mut_parent->children;
+    while (NULL != *pmut_mut_link) {
+        if (pmut_vm == *pmut_mut_link) {
+            *pmut_mut_link = pmut_vm->sibling;
+            break;
+        }
+
+        pmut_mut_link = &(*pmut_mut_link)->sibling;
+    }
+
+    mut_ret = (int)(NULL == pmut_mut_parent->children && 0 == (int32_t)pmut_mut_parent->fd);
+    platform_mutex_unlock(&pmut_mut_parent->mutex);
+
+    pmut_vm->parent = NULL;
+    pmut_vm->sibling = NULL;
+
+    return mut_ret;
+}
@@ -0,0 +1,352 @@
+/**
+ * @copyright
+ * Copyright (C) 2020 Assured Information Security, Inc.
+ *
+ * @copyright
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * @copyright
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * @copyright
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <debug.h>
+#include <g_mut_hndl.h>
+#include <kvm_userspace_memory_region.h>
+#include <mv_constants.h>
+#include <mv_hypercall.h>
+#include <mv_mdl_t.h>
+#include <mv_types.h>
+#include <platform.h>
+#include <shared_page_for_current_pp.h>
+#include <shim_vm_invalidate_range.h>
+#include <shim_vm_t.h>
+#include <touch.h>
+
+/**
+ * <!-- description -->
+ *   @brief Unmaps the pages of the provided SHIM_VM_POPULATE_SIZE region
+ *     of the provided slot from MicroV. The region is clamped to the slot.
+ *
+ * <!-- inputs/outputs -->
+ *   @param vm the VM to unmap the region from
+ *   @param slot the slot that owns the region
+ *   @param region the index of the region within the slot
+ *   @return SHIM_SUCCESS on success, SHIM_FAILURE on failure.
+ */
+NODISCARD static int64_t
+unmap_region(
+    struct shim_vm_t const *const vm,
+    struct kvm_userspace_memory_region const *const slot,
+    uint64_t const region) NOEXCEPT
+{
+    struct mv_mdl_t *pmut_mut_mdl;
+
+    uint64_t mut_gpa;
+    uint64_t mut_end;
+    uint64_t mut_slot_end;
+
+    uint64_t const one = ((uint64_t)1);
+    uint64_t const mask = ~(SHIM_VM_POPULATE_SIZE - one);
+
+    pmut_mut_mdl = (struct mv_mdl_t *)shared_page_for_current_pp();
+    platform_expects(NULL != pmut_mut_mdl);
+
+    mut_gpa = (slot->guest_phys_addr & mask) + (region * SHIM_VM_POPULATE_SIZE);
+    mut_end = mut_gpa + SHIM_VM_POPULATE_SIZE;
+    mut_slot_end = mv_page_aligned(
+        slot->guest_phys_addr + slot->memory_size + (HYPERVISOR_PAGE_SIZE - one));
+
+    if (mut_end > mut_slot_end) {
+        mut_end = mut_slot_end;
+    }
+    else {
+        touch();
+    }
+
+    if (mut_gpa < slot->guest_phys_addr) {
+        mut_gpa = slot->guest_phys_addr;
+    }
+    else {
+        touch();
+    }
+
+    pmut_mut_mdl->num_entries = ((uint64_t)0);
+    for (; mut_gpa < mut_end; mut_gpa += HYPERVISOR_PAGE_SIZE) {
+        pmut_mut_mdl->entries[pmut_mut_mdl->num_entries].dst = mut_gpa;
+        pmut_mut_mdl->entries[pmut_mut_mdl->num_entries].src = ((uint64_t)0);
+        pmut_mut_mdl->entries[pmut_mut_mdl->num_entries].bytes = HYPERVISOR_PAGE_SIZE;
+        ++pmut_mut_mdl->num_entries;
+
+        if (pmut_mut_mdl->num_entries >= MV_MDL_MAX_ENTRIES) {
+            if (mv_vm_op_mmio_unmap(g_mut_hndl, vm->id)) {
+                bferror("mv_vm_op_mmio_unmap failed");
+                return SHIM_FAILURE;
+            }
+
+            pmut_mut_mdl->num_entries = ((uint64_t)0);
+        }
+        else {
+            touch();
+        }
+    }
+
+    if (((uint64_t)0) != pmut_mut_mdl->num_entries) {
+        if (mv_vm_op_mmio_unmap(g_mut_hndl, vm->id)) {
+            bferror("mv_vm_op_mmio_unmap failed");
+            return SHIM_FAILURE;
+        }
+
+        touch();
+    }
+    else {
+        touch();
+    }
+
+    return SHIM_SUCCESS;
+}
+
+/**
+ * <!-- description -->
+ *   @brief Unmaps the provided region from every VM that was forked from
+ *     the provided VM and still shares this region with it. Once the
+ *     region is unmapped, the child populates it from its own memory the
+ *     next time its guest touches it.
+ *
+ * <!-- inputs/outputs -->
+ *   @param vm the VM whose region is being invalidated
+ *   @param idx the index of the slot that owns the region
+ *   @param region the index of the region within the slot
+ *   @return SHIM_SUCCESS on success, SHIM_FAILURE on failure.
+ */
+NODISCARD static int64_t
+invalidate_children(
+    struct shim_vm_t const *const vm, uint64_t const idx, uint64_t const region) NOEXCEPT
+{
+    struct shim_vm_t *pmut_mut_child;
+    uint64_t *pmut_mut_shared;
+
+    uint64_t const bits = ((uint64_t)64);
+    uint64_t const bit = ((uint64_t)1) << (region % bits);
+
+    for (pmut_mut_child = vm->children; NULL != pmut_mut_child;
+         pmut_mut_child = pmut_mut_child->sibling) {
+        platform_mutex_lock(&pmut_mut_child->mutex);
+
+        pmut_mut_shared = pmut_mut_child->shared[idx];
+        if (NULL == pmut_mut_shared || ((uint64_t)0) == (pmut_mut_shared[region / bits] & bit)) {
+            platform_mutex_unlock(&pmut_mut_child->mutex);
+            continue;
+        }
+
+        if (unmap_region(pmut_mut_child, &pmut_mut_child->slots[idx], region)) {
+            bferror("unmap_region failed");
+            platform_mutex_unlock(&pmut_mut_child->mutex);
+            return SHIM_FAILURE;
+        }
+
+        pmut_mut_child->populated[idx][region / bits] &= ~bit;
+        pmut_mut_shared[region / bits] &= ~bit;
+
+        platform_mutex_unlock(&pmut_mut_child->mutex);
+    }
+
+    return SHIM_SUCCESS;
+}
+
+/**
+ * <!-- description -->
+ *   @brief Unmaps every populated region of the provided slot that
+ *     overlaps the userspace addresses [start, end), and marks these
+ *     regions as no longer populated.
+ *
+ * <!-- inputs/outputs -->
+ *   @param pmut_vm the VM that owns the slot
+ *   @param idx the index of the slot
+ *   @param start the first userspace address being invalidated
+ *   @param end the userspace address after the last address being
+ *     invalidated
+ *   @return SHIM_SUCCESS on success, SHIM_FAILURE on failure.
+ */
+NODISCARD static int64_t
+invalidate_slot(
+    struct shim_vm_t *const pmut_vm,
+    uint64_t const idx,
+    uint64_t const start,
+    uint64_t const end) NOEXCEPT
+{
+    struct kvm_userspace_memory_region const *const slot = &pmut_vm->slots[idx];
+    uint64_t *const pmut_populated = pmut_vm->populated[idx];
+
+    uint64_t mut_start;
+    uint64_t mut_end;
+    uint64_t mut_region;
+    uint64_t mut_last;
+    uint64_t mut_bit;
+
+    uint64_t const one = ((uint64_t)1);
+    uint64_t const bits = ((uint64_t)64);
+    uint64_t const mask = ~(SHIM_VM_POPULATE_SIZE - one);
+    uint64_t const slot_end = slot->userspace_addr + slot->memory_size;
+
+    if (end <= slot->userspace_addr) {
+        return SHIM_SUCCESS;
+    }
+
+    if (start >= slot_end) {
+        return SHIM_SUCCESS;
+    }
+
+    mut_start = start;
+    if (mut_start < slot->userspace_addr) {
+        mut_start = slot->userspace_addr;
+    }
+    else {
+        touch();
+    }
+
+    mut_end = end;
+    if (mut_end > slot_end) {
+        mut_end = slot_end;
+    }
+    else {
+        touch();
+    }
+
+    /// NOTE:
+    /// - The regions are aligned in the guest physical address space, so
+    ///   the userspace addresses are converted to GPAs first.
+    ///
+
+    mut_start = slot->guest_phys_addr + (mut_start - slot->userspace_addr);
+    mut_end = slot->guest_phys_addr + (mut_end - slot->userspace_addr);
+
+    mut_region = ((mut_start & mask) - (slot->guest_phys_addr & mask)) / SHIM_VM_POPULATE_SIZE;
+    mut_last = (((mut_end - one) & mask) - (slot->guest_phys_addr & mask)) / SHIM_VM_POPULATE_SIZE;
+
+    for (; mut_region <= mut_last; ++mut_region) {
+        mut_bit = one << (mut_region % bits);
+        if (((uint64_t)0) == (pmut_populated[mut_region / bits] & mut_bit)) {
+            continue;
+        }
+
+        if (unmap_region(pmut_vm, slot, mut_region)) {
+            bferror("unmap_region failed");
+            return SHIM_FAILURE;
+        }
+
+        if (invalidate_children(pmut_vm, idx, mut_region)) {
+            bferror("invalidate_children failed");
+            return SHIM_FAILURE;
+        }
+
+        pmut_populated[mut_region / bits] &= ~mut_bit;
+
+        /// NOTE:
+        /// - Once a region that is shared with a parent VM is unmapped,
+        ///   it is populated from this VM's own memory the next time the
+        ///   guest touches it, so it is no longer shared.
+        ///
+
+        if (NULL != pmut_vm->shared[idx]) {
+            pmut_vm->shared[idx][mut_region / bits] &= ~mut_bit;
+        }
+        else {
+            touch();
+        }
+    }
+
+    return SHIM_SUCCESS;
+}
+
+/**
+ * <!-- description -->
+ *   @brief Tells the shim that the host is about to change its
+ *     mappings of the userspace addresses [start, end), for example
+ *     because the pages are being swapped out, migrated or merged.
+ *     Every region of a slot that overlaps this range and has been
+ *     mapped into MicroV is unmapped, and until the matching call to
+ *     shim_vm_invalidate_range_end, no new regions are mapped. The
+ *     regions are mapped again the next time the guest touches them.
+ *
+ * <!-- inputs/outputs -->
+ *   @param pmut_vm the VM whose memory is being invalidated
+ *   @param start the first userspace address being invalidated
+ *   @param end the userspace address after the last address being
+ *     invalidated
+ *   @return SHIM_SUCCESS on success, SHIM_FAILURE on failure.
+ */
+NODISCARD int64_t
+shim_vm_invalidate_range_start(
+    struct shim_vm_t *const pmut_vm, uint64_t const start, uint64_t const end) NOEXCEPT
+{
+    uint64_t mut_i;
+
+    platform_expects(NULL != pmut_vm);
+    platform_expects(start < end);
+
+    platform_mutex_lock(&pmut_vm->mutex);
+
+    /// NOTE:
+    /// - The counters are updated before anything is unmapped so that a
+    ///   VCPU that resolved a page before the host changed it cannot map
+    ///   the stale page once we release the lock (see handle_vcpu_kvm_run).
+    ///
+
+    ++pmut_vm->invalidate_in_progress;
+    ++pmut_vm->invalidate_seq;
+
+    for (mut_i = ((uint64_t)0); mut_i < MICROV_MAX_SLOTS; ++mut_i) {
+        if (NULL == pmut_vm->populated[mut_i]) {
+            continue;
+        }
+
+        if (invalidate_slot(pmut_vm, mut_i, start, end)) {
+            bferror("invalidate_slot failed");
+            goto failure;
+        }
+    }
+
+    platform_mutex_unlock(&pmut_vm->mutex);
+    return SHIM_SUCCESS;
+
+failure:
+
+    platform_mutex_unlock(&pmut_vm->mutex);
+    return SHIM_FAILURE;
+}
+
+/**
+ * <!-- description -->
+ *   @brief Tells the shim that the host has finished changing the
+ *     mappings that were provided to shim_vm_invalidate_range_start.
+ *
+ * <!-- inputs/outputs -->
+ *   @param pmut_vm the VM whose memory was invalidated
+ */
+void
+shim_vm_invalidate_range_end(struct shim_vm_t *const pmut_vm) NOEXCEPT
+{
+    platform_expects(NULL != pmut_vm);
+
+    platform_mutex_lock(&pmut_vm->mutex);
+
+    platform_expects(((uint64_t)0) != pmut_vm->invalidate_in_progress);
+    --pmut_vm->invalidate_in_progress;
+
+    platform_mutex_unlock(&pmut_vm->mutex);
+}
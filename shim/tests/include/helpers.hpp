@@ -25,6 +25,9 @@
 #include "g_mut_hndl.h"      // IWYU pragma: export
 #include "mv_constants.h"    // IWYU pragma: export
 #include "mv_exit_io_t.h"    // IWYU pragma: export
+#include "mv_exit_kick_t.h"    // IWYU pragma: export
+#include "mv_exit_mmio_t.h"    // IWYU pragma: export
+#include "mv_exit_msr_t.h"     // IWYU pragma: export
 #include "mv_exit_reason_t.h"
 #include "mv_hypercall.h"    // IWYU pragma: export
 #include "mv_translation_t.h"
@@ -60,39 +63,60 @@ namespace shim
         constinit bsl::uint64 g_mut_mv_handle_op_open_handle{};     // NOLINT
         constinit mv_status_t g_mut_mv_handle_op_close_handle{};    // NOLINT
 
-        constinit bsl::uint16 g_mut_mv_pp_op_ppid{};                   // NOLINT
-        constinit mv_status_t g_mut_mv_pp_op_clr_shared_page_gpa{};    // NOLINT
-        constinit mv_status_t g_mut_mv_pp_op_set_shared_page_gpa{};    // NOLINT
-
-        constinit bsl::uint16 g_mut_mv_vm_op_create_vm{};     // NOLINT
-        constinit mv_status_t g_mut_mv_vm_op_destroy_vm{};    // NOLINT
-        constinit bsl::uint16 g_mut_mv_vm_op_vmid{};          // NOLINT
-        constinit mv_status_t g_mut_mv_vm_op_mmio_map{};      // NOLINT
-        constinit mv_status_t g_mut_mv_vm_op_mmio_unmap{};    // NOLINT
+        constinit bsl::uint16 g_mut_mv_pp_op_ppid{};                        // NOLINT
+        constinit mv_status_t g_mut_mv_pp_op_clr_shared_page_gpa{};         // NOLINT
+        constinit mv_status_t g_mut_mv_pp_op_set_shared_page_gpa{};         // NOLINT
+        constinit mv_status_t g_mut_mv_pp_op_cpuid_get_supported_list{};    // NOLINT
+        constinit mv_status_t g_mut_mv_pp_op_tsc_get_khz{};                 // NOLINT
+
+        constinit bsl::uint16 g_mut_mv_vm_op_create_vm{};            // NOLINT
+        constinit mv_status_t g_mut_mv_vm_op_destroy_vm{};           // NOLINT
+        constinit bsl::uint16 g_mut_mv_vm_op_vmid{};                 // NOLINT
+        constinit mv_status_t g_mut_mv_vm_op_mmio_map{};             // NOLINT
+        constinit mv_status_t g_mut_mv_vm_op_mmio_unmap{};           // NOLINT
+        constinit mv_status_t g_mut_mv_vm_op_dirty_log_enable{};     // NOLINT
+        constinit mv_status_t g_mut_mv_vm_op_dirty_log_disable{};    // NOLINT
+        constinit mv_status_t g_mut_mv_vm_op_dirty_log_get{};        // NOLINT
+        constinit mv_status_t g_mut_mv_vm_op_dirty_log_clear{};      // NOLINT
+        constinit mv_status_t g_mut_mv_vm_op_dirty_ring_reset{};     // NOLINT
+        constinit bsl::uint16 g_mut_mv_vm_op_fork_vm{};              // NOLINT
+        constinit mv_status_t g_mut_mv_vm_op_msr_intercept{};        // NOLINT
+        constinit mv_status_t g_mut_mv_vm_op_io_intercept{};         // NOLINT
+        constinit mv_status_t g_mut_mv_vm_op_msr_filter{};           // NOLINT
+        constinit mv_status_t g_mut_mv_vm_op_clock_get{};            // NOLINT
+        constinit mv_status_t g_mut_mv_vm_op_clock_set{};            // NOLINT
 
         constinit bsl::uint16 g_mut_mv_vp_op_create_vp{};     // NOLINT
         constinit mv_status_t g_mut_mv_vp_op_destroy_vp{};    // NOLINT
         constinit bsl::uint16 g_mut_mv_vp_op_vmid{};          // NOLINT
         constinit bsl::uint16 g_mut_mv_vp_op_vpid{};          // NOLINT
 
-        constinit bsl::uint16 g_mut_mv_vs_op_create_vs{};          // NOLINT
-        constinit mv_status_t g_mut_mv_vs_op_destroy_vs{};         // NOLINT
-        constinit bsl::uint16 g_mut_mv_vs_op_vmid{};               // NOLINT
-        constinit bsl::uint16 g_mut_mv_vs_op_vpid{};               // NOLINT
-        constinit bsl::uint16 g_mut_mv_vs_op_vsid{};               // NOLINT
-        constinit mv_translation_t g_mut_mv_vs_op_gla_to_gpa{};    // NOLINT
-        constinit mv_exit_reason_t g_mut_mv_vs_op_run{};           // NOLINT
-        constinit mv_exit_io_t g_mut_mv_vs_op_run_io{};            // NOLINT
-        constinit mv_status_t g_mut_mv_vs_op_reg_get{};            // NOLINT
-        constinit mv_status_t g_mut_mv_vs_op_reg_set{};            // NOLINT
-        constinit mv_status_t g_mut_mv_vs_op_reg_get_list{};       // NOLINT
-        constinit mv_status_t g_mut_mv_vs_op_reg_set_list{};       // NOLINT
-        constinit mv_status_t g_mut_mv_vs_op_msr_get{};            // NOLINT
-        constinit mv_status_t g_mut_mv_vs_op_msr_set{};            // NOLINT
-        constinit mv_status_t g_mut_mv_vs_op_msr_get_list{};       // NOLINT
-        constinit mv_status_t g_mut_mv_vs_op_msr_set_list{};       // NOLINT
-        constinit mv_status_t g_mut_mv_vs_op_fpu_get_all{};        // NOLINT
-        constinit mv_status_t g_mut_mv_vs_op_fpu_set_all{};        // NOLINT
+        constinit bsl::uint16 g_mut_mv_vs_op_create_vs{};                     // NOLINT
+        constinit mv_status_t g_mut_mv_vs_op_destroy_vs{};                    // NOLINT
+        constinit bsl::uint16 g_mut_mv_vs_op_vmid{};                          // NOLINT
+        constinit bsl::uint16 g_mut_mv_vs_op_vpid{};                          // NOLINT
+        constinit bsl::uint16 g_mut_mv_vs_op_vsid{};                          // NOLINT
+        constinit mv_translation_t g_mut_mv_vs_op_gla_to_gpa{};               // NOLINT
+        constinit mv_exit_reason_t g_mut_mv_vs_op_run{};                      // NOLINT
+        constinit mv_exit_io_t g_mut_mv_vs_op_run_io{};                       // NOLINT
+        constinit mv_exit_mmio_t g_mut_mv_vs_op_run_mmio{};                   // NOLINT
+        constinit mv_exit_msr_t g_mut_mv_vs_op_run_msr{};                     // NOLINT
+        constinit mv_exit_kick_t g_mut_mv_vs_op_run_kick{};                   // NOLINT
+        constinit mv_status_t g_mut_mv_vs_op_cpuid_set_list{};                // NOLINT
+        constinit mv_status_t g_mut_mv_vs_op_reg_get{};                       // NOLINT
+        constinit mv_status_t g_mut_mv_vs_op_reg_set{};                       // NOLINT
+        constinit mv_status_t g_mut_mv_vs_op_reg_get_list{};                  // NOLINT
+        constinit mv_status_t g_mut_mv_vs_op_reg_set_list{};                  // NOLINT
+        constinit mv_status_t g_mut_mv_vs_op_msr_get{};                       // NOLINT
+        constinit mv_status_t g_mut_mv_vs_op_msr_set{};                       // NOLINT
+        constinit mv_status_t g_mut_mv_vs_op_msr_get_list{};                  // NOLINT
+        constinit mv_status_t g_mut_mv_vs_op_msr_set_list{};                  // NOLINT
+        constinit mv_status_t g_mut_mv_vs_op_fpu_get_all{};                   // NOLINT
+        constinit mv_status_t g_mut_mv_vs_op_fpu_set_all{};                   // NOLINT
+        constinit mv_status_t g_mut_mv_vs_op_dirty_ring_get{};                // NOLINT
+        constinit mv_status_t g_mut_mv_vs_op_tsc_set_khz{};                   // NOLINT
+        constinit mv_status_t g_mut_mv_vs_op_tsc_set_offset{};                // NOLINT
+        constinit bsl::uint64 g_mut_mv_vs_op_dirty_ring_get_num_entries{};    // NOLINT
 
         extern bool g_mut_hypervisor_detected;
         extern bool g_mut_platform_alloc_fails;
@@ -101,6 +125,14 @@ namespace shim
         extern int64_t g_mut_platform_mlock;
         extern int64_t g_mut_platform_munlock;
         extern bool g_mut_platform_interrupted;
+        extern bsl::uint64 g_mut_platform_realtime_ns;
+        extern int64_t g_mut_platform_event_wait;
+        extern bsl::uint64 g_mut_platform_current_thread;
+        extern int64_t g_mut_platform_yield_to;
+        extern bsl::uint64 g_mut_platform_yielded_to;
+        extern bsl::uint64 g_mut_platform_yield;
+        extern bsl::uint64 g_mut_platform_thread_get;
+        extern bsl::uint64 g_mut_platform_thread_put;
     }
 
     /// <!-- description -->
@@ -49,4 +49,10 @@
  */
 #define SHIM_INTERRUPTED ((int64_t)-2)
 
+/**
+ * @brief Returned by a shim function when a buffer provided by the
+ *   caller is too small.
+ */
+#define SHIM_2BIG ((int64_t)-3)
+
 #endif
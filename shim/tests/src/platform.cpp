@@ -44,6 +44,22 @@ namespace shim
     extern "C" int64_t g_mut_platform_munlock{SHIM_SUCCESS};    // NOLINT
     /// @brief tells platform_interrupted to return interrupted
     extern "C" bool g_mut_platform_interrupted{};    // NOLINT
+    /// @brief return value for platform_realtime_ns
+    extern "C" bsl::uint64 g_mut_platform_realtime_ns{};    // NOLINT
+    /// @brief return value for platform_event_wait
+    extern "C" int64_t g_mut_platform_event_wait{SHIM_SUCCESS};    // NOLINT
+    /// @brief return value for platform_current_thread
+    extern "C" bsl::uint64 g_mut_platform_current_thread{1U};    // NOLINT
+    /// @brief return value for platform_yield_to
+    extern "C" int64_t g_mut_platform_yield_to{SHIM_SUCCESS};    // NOLINT
+    /// @brief stores the thread that platform_yield_to was last given
+    extern "C" bsl::uint64 g_mut_platform_yielded_to{};    // NOLINT
+    /// @brief stores the number of times platform_yield was called
+    extern "C" bsl::uint64 g_mut_platform_yield{};    // NOLINT
+    /// @brief stores the number of references taken using platform_thread_get
+    extern "C" bsl::uint64 g_mut_platform_thread_get{};    // NOLINT
+    /// @brief stores the number of references released using platform_thread_put
+    extern "C" bsl::uint64 g_mut_platform_thread_put{};    // NOLINT
 
     /// <!-- description -->
     ///   @brief If test is false, a contract violation has occurred. This
@@ -297,6 +313,20 @@ namespace shim
         return 0U;
     }
 
+    /// <!-- description -->
+    ///   @brief Returns the current wall clock time in nanoseconds since
+    ///     the epoch.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @return Returns the current wall clock time in nanoseconds since
+    ///     the epoch.
+    ///
+    extern "C" [[nodiscard]] auto
+    platform_realtime_ns(void) noexcept -> bsl::uint64
+    {
+        return g_mut_platform_realtime_ns;
+    }
+
     /// <!-- description -->
     ///   @brief Calls the user provided callback on each CPU. If each callback
     ///     returns 0, this function returns 0, otherwise this function returns
@@ -361,6 +391,119 @@ namespace shim
         (void)pmut_mutex;
     }
 
+    /// <!-- description -->
+    ///   @brief Initializes an event. This must be called before an
+    ///     event can be used. Events start out cleared.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param pmut_event the event to initialize
+    ///
+    extern "C" void
+    platform_event_init(platform_event *const pmut_event) noexcept
+    {
+        *pmut_event = {};
+    }
+
+    /// <!-- description -->
+    ///   @brief Puts the current thread to sleep until the event is
+    ///     signaled, and then clears the event. If the event was
+    ///     signaled before this function was called, it returns right
+    ///     away. Returns SHIM_INTERRUPTED if the current process was
+    ///     interrupted while it was waiting.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param pmut_event the event to wait on
+    ///   @return Returns SHIM_SUCCESS once the event is signaled, or
+    ///     SHIM_INTERRUPTED if the current process was interrupted.
+    ///
+    extern "C" [[nodiscard]] auto
+    platform_event_wait(platform_event *const pmut_event) noexcept -> int64_t
+    {
+        *pmut_event = {};
+        return g_mut_platform_event_wait;
+    }
+
+    /// <!-- description -->
+    ///   @brief Signals an event, waking up the thread that is waiting
+    ///     on it (if any). This can be called from any thread.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param pmut_event the event to signal
+    ///
+    extern "C" void
+    platform_event_signal(platform_event *const pmut_event) noexcept
+    {
+        *pmut_event = 1U;
+    }
+
+    /// <!-- description -->
+    ///   @brief Returns the thread that is currently executing.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @return Returns the thread that is currently executing.
+    ///
+    extern "C" [[nodiscard]] auto
+    platform_current_thread() noexcept -> platform_thread
+    {
+        return g_mut_platform_current_thread;
+    }
+
+    /// <!-- description -->
+    ///   @brief Takes a reference to the provided thread so that it
+    ///     cannot be freed (even if it exits) until platform_thread_put
+    ///     is called.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param thread the thread to take a reference to
+    ///
+    extern "C" void
+    platform_thread_get(platform_thread const thread) noexcept
+    {
+        bsl::expects(platform_thread{} != thread);
+        ++g_mut_platform_thread_get;
+    }
+
+    /// <!-- description -->
+    ///   @brief Releases a reference to the provided thread that was
+    ///     taken using platform_thread_get.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param thread the thread to release the reference to
+    ///
+    extern "C" void
+    platform_thread_put(platform_thread const thread) noexcept
+    {
+        bsl::expects(platform_thread{} != thread);
+        ++g_mut_platform_thread_put;
+    }
+
+    /// <!-- description -->
+    ///   @brief Gives the rest of the current thread's time slice to the
+    ///     provided thread. This only works if the provided thread is
+    ///     runnable, but is not running. The caller must hold a
+    ///     reference to the provided thread (see platform_thread_get).
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param thread the thread to give the time slice to
+    ///   @return Returns SHIM_SUCCESS if the time slice was given to the
+    ///     provided thread, SHIM_FAILURE otherwise.
+    ///
+    extern "C" [[nodiscard]] auto
+    platform_yield_to(platform_thread const thread) noexcept -> int64_t
+    {
+        g_mut_platform_yielded_to = thread;
+        return g_mut_platform_yield_to;
+    }
+
+    /// <!-- description -->
+    ///   @brief Gives up the rest of the current thread's time slice.
+    ///
+    extern "C" void
+    platform_yield() noexcept
+    {
+        ++g_mut_platform_yield;
+    }
+
     /// <!-- description -->
     ///   @brief Returns SHIM_SUCCESS if the current process has NOT been
     ///     interrupted. Returns SHIM_FAILURE otherwise.
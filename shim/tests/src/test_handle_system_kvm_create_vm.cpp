@@ -25,6 +25,7 @@
 #include "../../include/handle_system_kvm_create_vm.h"
 
 #include <helpers.hpp>
+#include <mv_constants.h>
 #include <shim_vm_t.h>
 
 #include <bsl/convert.hpp>
@@ -63,6 +64,42 @@ namespace shim
             };
         };
 
+        bsl::ut_scenario{"mv_vm_op_clock_set fails"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                shim_vm_t mut_vm{};
+                constexpr auto vmid{42_u16};
+                bsl::ut_when{} = [&]() noexcept {
+                    g_mut_mv_vm_op_create_vm = vmid.get();
+                    g_mut_mv_vm_op_clock_set = MV_STATUS_FAILURE_UNKNOWN;
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(SHIM_FAILURE == handle(&mut_vm));
+                    };
+                    bsl::ut_cleanup{} = [&]() noexcept {
+                        g_mut_mv_vm_op_clock_set = {};
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"mv_vm_op_clock_set and mv_vm_op_destroy_vm fail"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                shim_vm_t mut_vm{};
+                constexpr auto vmid{42_u16};
+                bsl::ut_when{} = [&]() noexcept {
+                    g_mut_mv_vm_op_create_vm = vmid.get();
+                    g_mut_mv_vm_op_clock_set = MV_STATUS_FAILURE_UNKNOWN;
+                    g_mut_mv_vm_op_destroy_vm = MV_STATUS_FAILURE_UNKNOWN;
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(SHIM_FAILURE == handle(&mut_vm));
+                    };
+                    bsl::ut_cleanup{} = [&]() noexcept {
+                        g_mut_mv_vm_op_clock_set = {};
+                        g_mut_mv_vm_op_destroy_vm = {};
+                    };
+                };
+            };
+        };
+
         bsl::ut_scenario{"hypervisor not detected"} = []() noexcept {
             bsl::ut_given{} = [&]() noexcept {
                 shim_vm_t mut_vm{};
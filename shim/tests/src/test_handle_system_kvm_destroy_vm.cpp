@@ -25,8 +25,10 @@
 #include "../../include/handle_system_kvm_destroy_vm.h"
 
 #include <helpers.hpp>
+#include <platform.h>
 #include <shim_vm_t.h>
 
+#include <bsl/safe_integral.hpp>
 #include <bsl/ut.hpp>
 
 namespace shim
@@ -55,6 +57,21 @@ namespace shim
             };
         };
 
+        bsl::ut_scenario{"success with populated slots"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                shim_vm_t mut_vm{};
+                constexpr auto size{0x1000_u64};
+                bsl::ut_when{} = [&]() noexcept {
+                    mut_vm.slots[0].memory_size = size.get();
+                    mut_vm.populated[0] = static_cast<bsl::uint64 *>(platform_alloc(size.get()));
+                    bsl::ut_then{} = [&]() noexcept {
+                        handle(&mut_vm);
+                        bsl::ut_check(nullptr == mut_vm.populated[0]);
+                    };
+                };
+            };
+        };
+
         bsl::ut_scenario{"hypervisor not detected"} = []() noexcept {
             bsl::ut_given{} = [&]() noexcept {
                 shim_vm_t mut_vm{};
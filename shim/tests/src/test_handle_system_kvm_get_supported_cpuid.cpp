@@ -24,13 +24,23 @@
 
 #include "../../include/handle_system_kvm_get_supported_cpuid.h"
 
+#include <helpers.hpp>
+#include <kvm_constants.h>
 #include <kvm_cpuid2.h>
+#include <kvm_cpuid_entry2.h>
+#include <mv_cdl_t.h>
 #include <mv_types.h>
 
+#include <bsl/array.hpp>
+#include <bsl/convert.hpp>
+#include <bsl/safe_integral.hpp>
 #include <bsl/ut.hpp>
 
 namespace shim
 {
+    /// @brief defines the number of entries used by the tests
+    constexpr auto NUM_ENTRIES{2_u32};
+
     /// <!-- description -->
     ///   @brief Used to execute the actual checks. We put the checks in this
     ///     function so that we can validate the tests both at compile-time
@@ -43,19 +53,103 @@ namespace shim
     [[nodiscard]] constexpr auto
     tests() noexcept -> bsl::exit_code
     {
-        bsl::ut_scenario{"description"} = []() noexcept {
+        init_tests();
+        constexpr auto handle{&handle_system_kvm_get_supported_cpuid};
+
+        bsl::ut_scenario{"success"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                kvm_cpuid2 mut_args{};
+                bsl::array<kvm_cpuid_entry2, NUM_ENTRIES.get()> mut_entries{};
+                bsl::ut_when{} = [&]() noexcept {
+                    mut_args.nent = NUM_ENTRIES.get();
+                    g_mut_val = bsl::to_u64(NUM_ENTRIES).get();
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(SHIM_SUCCESS == handle(&mut_args, mut_entries.data()));
+                        bsl::ut_check(NUM_ENTRIES == mut_args.nent);
+                        bsl::ut_check(bsl::safe_u32::magic_0() == mut_entries.front().flags);
+                        bsl::ut_check(bsl::safe_u32::magic_1() == mut_entries.back().function);
+                        bsl::ut_check(bsl::safe_u32::magic_1() == mut_entries.back().index);
+                        bsl::ut_check(bsl::safe_u32::magic_1() == mut_entries.back().eax);
+                        bsl::ut_check(bsl::safe_u32::magic_1() == mut_entries.back().ebx);
+                        bsl::ut_check(bsl::safe_u32::magic_1() == mut_entries.back().ecx);
+                        bsl::ut_check(bsl::safe_u32::magic_1() == mut_entries.back().edx);
+                        bsl::ut_check(KVM_CPUID_FLAG_SIGNIFCANT_INDEX == mut_entries.back().flags);
+                    };
+                    bsl::ut_cleanup{} = [&]() noexcept {
+                        g_mut_val = {};
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"nent is too small"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                kvm_cpuid2 mut_args{};
+                bsl::array<kvm_cpuid_entry2, NUM_ENTRIES.get()> mut_entries{};
+                bsl::ut_when{} = [&]() noexcept {
+                    mut_args.nent = bsl::safe_u32::magic_1().get();
+                    g_mut_val = bsl::to_u64(NUM_ENTRIES).get();
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(SHIM_2BIG == handle(&mut_args, mut_entries.data()));
+                        bsl::ut_check(bsl::safe_u32::magic_1() == mut_args.nent);
+                    };
+                    bsl::ut_cleanup{} = [&]() noexcept {
+                        g_mut_val = {};
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"num_entries out of range"} = []() noexcept {
             bsl::ut_given{} = [&]() noexcept {
                 kvm_cpuid2 mut_args{};
+                bsl::array<kvm_cpuid_entry2, NUM_ENTRIES.get()> mut_entries{};
                 bsl::ut_when{} = [&]() noexcept {
+                    mut_args.nent = NUM_ENTRIES.get();
+                    g_mut_val = MV_CDL_MAX_ENTRIES + 1U;
                     bsl::ut_then{} = [&]() noexcept {
-                        bsl::ut_check(
-                            SHIM_SUCCESS == handle_system_kvm_get_supported_cpuid(&mut_args));
+                        bsl::ut_check(SHIM_FAILURE == handle(&mut_args, mut_entries.data()));
+                    };
+                    bsl::ut_cleanup{} = [&]() noexcept {
+                        g_mut_val = {};
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"hypervisor not detected"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                kvm_cpuid2 mut_args{};
+                bsl::array<kvm_cpuid_entry2, NUM_ENTRIES.get()> mut_entries{};
+                bsl::ut_when{} = [&]() noexcept {
+                    g_mut_hypervisor_detected = false;
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(SHIM_FAILURE == handle(&mut_args, mut_entries.data()));
+                    };
+                    bsl::ut_cleanup{} = [&]() noexcept {
+                        g_mut_hypervisor_detected = true;
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"mv_pp_op_cpuid_get_supported_list fails"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                kvm_cpuid2 mut_args{};
+                bsl::array<kvm_cpuid_entry2, NUM_ENTRIES.get()> mut_entries{};
+                bsl::ut_when{} = [&]() noexcept {
+                    g_mut_mv_pp_op_cpuid_get_supported_list = MV_STATUS_FAILURE_UNKNOWN;
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(SHIM_FAILURE == handle(&mut_args, mut_entries.data()));
+                    };
+                    bsl::ut_cleanup{} = [&]() noexcept {
+                        g_mut_mv_pp_op_cpuid_get_supported_list = {};
                     };
                 };
             };
         };
 
-        return bsl::ut_success();
+        return fini_tests();
     }
 }
 
@@ -24,12 +24,22 @@
 
 #include "../../include/handle_vcpu_kvm_get_tsc_khz.h"
 
+#include <helpers.hpp>
+#include <mv_constants.h>
 #include <mv_types.h>
+#include <shim_vcpu_t.h>
 
+#include <bsl/convert.hpp>
+#include <bsl/safe_integral.hpp>
 #include <bsl/ut.hpp>
 
 namespace shim
 {
+    /// @brief the TSC frequency of the PP used by these tests
+    constexpr auto PP_KHZ{2400000_u64};
+    /// @brief the TSC frequency of the VCPU used by these tests
+    constexpr auto VCPU_KHZ{1000000_u64};
+
     /// <!-- description -->
     ///   @brief Used to execute the actual checks. We put the checks in this
     ///     function so that we can validate the tests both at compile-time
@@ -42,17 +52,77 @@ namespace shim
     [[nodiscard]] constexpr auto
     tests() noexcept -> bsl::exit_code
     {
-        bsl::ut_scenario{"description"} = []() noexcept {
+        init_tests();
+        constexpr auto handle{&handle_vcpu_kvm_get_tsc_khz};
+
+        bsl::ut_scenario{"success using the frequency of the pp"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                shim_vcpu_t const vcpu{};
+                bsl::safe_u64 mut_freq{};
+                bsl::ut_when{} = [&]() noexcept {
+                    g_mut_val = PP_KHZ.get();
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(SHIM_SUCCESS == handle(&vcpu, mut_freq.data()));
+                        bsl::ut_check(PP_KHZ == mut_freq);
+                    };
+                    bsl::ut_cleanup{} = [&]() noexcept {
+                        g_mut_val = {};
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"success using the frequency of the vcpu"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                shim_vcpu_t mut_vcpu{};
+                bsl::safe_u64 mut_freq{};
+                bsl::ut_when{} = [&]() noexcept {
+                    g_mut_val = PP_KHZ.get();
+                    mut_vcpu.tsc_khz = VCPU_KHZ.get();
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(SHIM_SUCCESS == handle(&mut_vcpu, mut_freq.data()));
+                        bsl::ut_check(VCPU_KHZ == mut_freq);
+                    };
+                    bsl::ut_cleanup{} = [&]() noexcept {
+                        g_mut_val = {};
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"hypervisor not detected"} = []() noexcept {
             bsl::ut_given{} = [&]() noexcept {
+                shim_vcpu_t const vcpu{};
+                bsl::safe_u64 mut_freq{};
                 bsl::ut_when{} = [&]() noexcept {
+                    g_mut_hypervisor_detected = false;
                     bsl::ut_then{} = [&]() noexcept {
-                        bsl::ut_check(SHIM_SUCCESS == handle_vcpu_kvm_get_tsc_khz());
+                        bsl::ut_check(SHIM_FAILURE == handle(&vcpu, mut_freq.data()));
+                    };
+                    bsl::ut_cleanup{} = [&]() noexcept {
+                        g_mut_hypervisor_detected = true;
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"mv_pp_op_tsc_get_khz fails"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                shim_vcpu_t const vcpu{};
+                bsl::safe_u64 mut_freq{};
+                bsl::ut_when{} = [&]() noexcept {
+                    g_mut_mv_pp_op_tsc_get_khz = MV_STATUS_FAILURE_UNKNOWN;
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(SHIM_FAILURE == handle(&vcpu, mut_freq.data()));
+                    };
+                    bsl::ut_cleanup{} = [&]() noexcept {
+                        g_mut_mv_pp_op_tsc_get_khz = {};
                     };
                 };
             };
         };
 
-        return bsl::ut_success();
+        return fini_tests();
     }
 }
 
@@ -0,0 +1,113 @@
+/// @copyright
+/// Copyright (C) 2020 Assured Information Security, Inc.
+///
+/// @copyright
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// @copyright
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// @copyright
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+
+#include "../../include/handle_vcpu_kvm_has_device_attr.h"
+
+#include <helpers.hpp>
+#include <kvm_device_attr.h>
+#include <mv_types.h>
+
+#include <bsl/convert.hpp>
+#include <bsl/safe_integral.hpp>
+#include <bsl/ut.hpp>
+
+namespace shim
+{
+    /// @brief an attribute group that is not supported
+    constexpr auto BAD_GROUP{1_u32};
+    /// @brief an attribute that is not supported
+    constexpr auto BAD_ATTR{1_u64};
+
+    /// <!-- description -->
+    ///   @brief Used to execute the actual checks. We put the checks in this
+    ///     function so that we can validate the tests both at compile-time
+    ///     and at run-time. If a bsl::ut_check fails, the tests will either
+    ///     fail fast at run-time, or will produce a compile-time error.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @return Always returns bsl::exit_success.
+    ///
+    [[nodiscard]] constexpr auto
+    tests() noexcept -> bsl::exit_code
+    {
+        init_tests();
+        constexpr auto handle{&handle_vcpu_kvm_has_device_attr};
+
+        bsl::ut_scenario{"tsc offset is supported"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                kvm_device_attr mut_args{};
+                bsl::ut_when{} = [&]() noexcept {
+                    mut_args.group = KVM_VCPU_TSC_CTRL;
+                    mut_args.attr = KVM_VCPU_TSC_OFFSET;
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(SHIM_SUCCESS == handle(&mut_args));
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"unsupported group"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                kvm_device_attr mut_args{};
+                bsl::ut_when{} = [&]() noexcept {
+                    mut_args.group = BAD_GROUP.get();
+                    mut_args.attr = KVM_VCPU_TSC_OFFSET;
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(SHIM_FAILURE == handle(&mut_args));
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"unsupported attribute"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                kvm_device_attr mut_args{};
+                bsl::ut_when{} = [&]() noexcept {
+                    mut_args.group = KVM_VCPU_TSC_CTRL;
+                    mut_args.attr = BAD_ATTR.get();
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(SHIM_FAILURE == handle(&mut_args));
+                    };
+                };
+            };
+        };
+
+        return fini_tests();
+    }
+}
+
+/// <!-- description -->
+///   @brief Main function for this unit test. If a call to bsl::ut_check() fails
+///     the application will fast fail. If all calls to bsl::ut_check() pass, this
+///     function will successfully return with bsl::exit_success.
+///
+/// <!-- inputs/outputs -->
+///   @return Always returns bsl::exit_success.
+///
+[[nodiscard]] auto
+main() noexcept -> bsl::exit_code
+{
+    bsl::enable_color();
+    return shim::tests();
+}
@@ -25,17 +25,27 @@
 #include "../../include/handle_vcpu_kvm_run.h"
 
 #include <helpers.hpp>
+#include <kvm_dirty_gfn.h>
 #include <kvm_run.h>
+#include <kvm_run_msr.h>
+#include <kvm_sync_regs.h>
 #include <mv_bit_size_t.h>
+#include <mv_exit_msr_t.h>
 #include <mv_exit_reason_t.h>
+#include <mv_types.h>
+#include <platform.h>
 #include <shim_vcpu_t.h>
+#include <shim_vm_t.h>
 
+#include <bsl/array.hpp>
 #include <bsl/convert.hpp>
 #include <bsl/safe_integral.hpp>
 #include <bsl/ut.hpp>
 
 namespace shim
 {
+    constexpr auto VAL64{42_u64};
+
     /// <!-- description -->
     ///   @brief Used to execute the actual checks. We put the checks in this
     ///     function so that we can validate the tests both at compile-time
@@ -152,6 +162,87 @@ namespace shim
             };
         };
 
+        bsl::ut_scenario{"g_mut_mv_vs_op_run returns hlt and waits for a kick"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                shim_vcpu_t mut_vcpu{};
+                bsl::ut_when{} = [&]() noexcept {
+                    mut_vcpu.run = new kvm_run();    // NOLINT
+                    platform_event_signal(&mut_vcpu.unhalt);
+                    g_mut_mv_vs_op_run = mv_exit_reason_t_hlt;
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(SHIM_FAILURE == handle(&mut_vcpu));
+                        bsl::ut_check(platform_event{} == mut_vcpu.unhalt);
+                    };
+                    bsl::ut_cleanup{} = [&]() noexcept {
+                        delete mut_vcpu.run;    // NOLINT // GRCOV_EXCLUDE_BR
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"g_mut_mv_vs_op_run returns hlt with interrupts enabled"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                shim_vcpu_t mut_vcpu{};
+                constexpr auto rflags_if{0x202_u64};
+                bsl::ut_when{} = [&]() noexcept {
+                    mut_vcpu.run = new kvm_run();    // NOLINT
+                    g_mut_mv_vs_op_run = mv_exit_reason_t_hlt;
+                    g_mut_val = rflags_if.get();
+                    g_mut_platform_event_wait = SHIM_INTERRUPTED;
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(SHIM_SUCCESS == handle(&mut_vcpu));
+                        bsl::ut_check(KVM_EXIT_HLT == mut_vcpu.run->exit_reason);
+                    };
+                    bsl::ut_cleanup{} = [&]() noexcept {
+                        g_mut_mv_vs_op_run = {};
+                        g_mut_val = {};
+                        g_mut_platform_event_wait = SHIM_SUCCESS;
+                        delete mut_vcpu.run;    // NOLINT // GRCOV_EXCLUDE_BR
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"g_mut_mv_vs_op_run returns hlt and reg_get fails"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                shim_vcpu_t mut_vcpu{};
+                bsl::ut_when{} = [&]() noexcept {
+                    mut_vcpu.run = new kvm_run();    // NOLINT
+                    g_mut_mv_vs_op_run = mv_exit_reason_t_hlt;
+                    g_mut_mv_vs_op_reg_get = MV_STATUS_FAILURE_UNKNOWN;
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(SHIM_FAILURE == handle(&mut_vcpu));
+                        bsl::ut_check(KVM_EXIT_FAIL_ENTRY == mut_vcpu.run->exit_reason);
+                    };
+                    bsl::ut_cleanup{} = [&]() noexcept {
+                        g_mut_mv_vs_op_run = {};
+                        g_mut_mv_vs_op_reg_get = {};
+                        delete mut_vcpu.run;    // NOLINT // GRCOV_EXCLUDE_BR
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"g_mut_mv_vs_op_run returns hlt and is interrupted"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                shim_vcpu_t mut_vcpu{};
+                bsl::ut_when{} = [&]() noexcept {
+                    mut_vcpu.run = new kvm_run();    // NOLINT
+                    g_mut_mv_vs_op_run = mv_exit_reason_t_hlt;
+                    g_mut_platform_event_wait = SHIM_INTERRUPTED;
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(SHIM_INTERRUPTED == handle(&mut_vcpu));
+                        bsl::ut_check(KVM_EXIT_INTR == mut_vcpu.run->exit_reason);
+                    };
+                    bsl::ut_cleanup{} = [&]() noexcept {
+                        g_mut_mv_vs_op_run = {};
+                        g_mut_platform_event_wait = SHIM_SUCCESS;
+                        delete mut_vcpu.run;    // NOLINT // GRCOV_EXCLUDE_BR
+                    };
+                };
+            };
+        };
+
         bsl::ut_scenario{"g_mut_mv_vs_op_run returns io in"} = []() noexcept {
             bsl::ut_given{} = [&]() noexcept {
                 shim_vcpu_t mut_vcpu{};
@@ -417,80 +508,993 @@ namespace shim
             };
         };
 
-        bsl::ut_scenario{"g_mut_mv_vs_op_run returns mmio"} = []() noexcept {
+        bsl::ut_scenario{"g_mut_mv_vs_op_run returns mmio outside of a slot"} = []() noexcept {
             bsl::ut_given{} = [&]() noexcept {
+                shim_vm_t mut_vm{};
                 shim_vcpu_t mut_vcpu{};
+                constexpr auto fault{0x1000_u64};
                 bsl::ut_when{} = [&]() noexcept {
                     mut_vcpu.run = new kvm_run();    // NOLINT
+                    mut_vcpu.vm = &mut_vm;
+                    g_mut_mv_vs_op_run_mmio.gpa = fault.get();
                     g_mut_mv_vs_op_run = mv_exit_reason_t_mmio;
                     bsl::ut_then{} = [&]() noexcept {
                         bsl::ut_check(SHIM_FAILURE == handle(&mut_vcpu));
+                        bsl::ut_check(KVM_EXIT_FAIL_ENTRY == mut_vcpu.run->exit_reason);
                     };
                     bsl::ut_cleanup{} = [&]() noexcept {
+                        g_mut_mv_vs_op_run_mmio = {};
                         delete mut_vcpu.run;    // NOLINT // GRCOV_EXCLUDE_BR
                     };
                 };
             };
         };
 
-        bsl::ut_scenario{"g_mut_mv_vs_op_run returns msr"} = []() noexcept {
+        bsl::ut_scenario{"g_mut_mv_vs_op_run returns mmio in a slot"} = []() noexcept {
             bsl::ut_given{} = [&]() noexcept {
+                shim_vm_t mut_vm{};
                 shim_vcpu_t mut_vcpu{};
+                constexpr auto gpa{0x0_u64};
+                constexpr auto size{0x400000_u64};
+                constexpr auto addr{0x1000_u64};
+                constexpr auto fault{0x201000_u64};
                 bsl::ut_when{} = [&]() noexcept {
                     mut_vcpu.run = new kvm_run();    // NOLINT
-                    g_mut_mv_vs_op_run = mv_exit_reason_t_msr;
+                    mut_vcpu.vm = &mut_vm;
+                    mut_vm.slots[0].guest_phys_addr = gpa.get();
+                    mut_vm.slots[0].memory_size = size.get();
+                    mut_vm.slots[0].userspace_addr = addr.get();
+                    g_mut_mv_vs_op_run_mmio.gpa = fault.get();
+                    g_mut_mv_vs_op_run = mv_exit_reason_t_mmio;
                     bsl::ut_then{} = [&]() noexcept {
                         bsl::ut_check(SHIM_FAILURE == handle(&mut_vcpu));
+                        bsl::ut_check(bsl::safe_u64::magic_2() == *mut_vm.populated[0]);
                     };
                     bsl::ut_cleanup{} = [&]() noexcept {
+                        auto const bytes{shim_vm_populated_size(&mut_vm.slots[0])};
+                        platform_free(mut_vm.populated[0], bytes);
+                        g_mut_mv_vs_op_run_mmio = {};
                         delete mut_vcpu.run;    // NOLINT // GRCOV_EXCLUDE_BR
                     };
                 };
             };
         };
 
-        bsl::ut_scenario{"g_mut_mv_vs_op_run returns interrupt"} = []() noexcept {
+        bsl::ut_scenario{"g_mut_mv_vs_op_run returns mmio in a populated region"} = []() noexcept {
             bsl::ut_given{} = [&]() noexcept {
+                shim_vm_t mut_vm{};
                 shim_vcpu_t mut_vcpu{};
+                constexpr auto gpa{0x0_u64};
+                constexpr auto size{0x400000_u64};
+                constexpr auto addr{0x1000_u64};
+                constexpr auto fault{0x201000_u64};
+                bsl::uint64 mut_populated{0x2_u64.get()};
                 bsl::ut_when{} = [&]() noexcept {
                     mut_vcpu.run = new kvm_run();    // NOLINT
-                    g_mut_mv_vs_op_run = mv_exit_reason_t_interrupt;
+                    mut_vcpu.vm = &mut_vm;
+                    mut_vm.slots[0].guest_phys_addr = gpa.get();
+                    mut_vm.slots[0].memory_size = size.get();
+                    mut_vm.slots[0].userspace_addr = addr.get();
+                    mut_vm.populated[0] = &mut_populated;
+                    g_mut_mv_vs_op_run_mmio.gpa = fault.get();
+                    g_mut_mv_vm_op_mmio_map = bsl::safe_u64::magic_1().get();
+                    g_mut_mv_vs_op_run = mv_exit_reason_t_mmio;
                     bsl::ut_then{} = [&]() noexcept {
                         bsl::ut_check(SHIM_FAILURE == handle(&mut_vcpu));
+                        bsl::ut_check(bsl::safe_u64::magic_1() == g_mut_mv_vm_op_mmio_map);
                     };
                     bsl::ut_cleanup{} = [&]() noexcept {
+                        g_mut_mv_vm_op_mmio_map = {};
+                        g_mut_mv_vs_op_run_mmio = {};
                         delete mut_vcpu.run;    // NOLINT // GRCOV_EXCLUDE_BR
                     };
                 };
             };
         };
 
-        bsl::ut_scenario{"g_mut_mv_vs_op_run returns nmi"} = []() noexcept {
+        bsl::ut_scenario{"g_mut_mv_vs_op_run returns mmio in an unaligned slot"} = []() noexcept {
             bsl::ut_given{} = [&]() noexcept {
+                shim_vm_t mut_vm{};
                 shim_vcpu_t mut_vcpu{};
+                constexpr auto gpa{0x0_u64};
+                constexpr auto size{0x2A_u64};
+                constexpr auto addr{0x1000_u64};
+                constexpr auto fault{0x29_u64};
                 bsl::ut_when{} = [&]() noexcept {
                     mut_vcpu.run = new kvm_run();    // NOLINT
-                    g_mut_mv_vs_op_run = mv_exit_reason_t_nmi;
+                    mut_vcpu.vm = &mut_vm;
+                    mut_vm.slots[0].guest_phys_addr = gpa.get();
+                    mut_vm.slots[0].memory_size = size.get();
+                    mut_vm.slots[0].userspace_addr = addr.get();
+                    g_mut_mv_vs_op_run_mmio.gpa = fault.get();
+                    g_mut_mv_vs_op_run = mv_exit_reason_t_mmio;
                     bsl::ut_then{} = [&]() noexcept {
                         bsl::ut_check(SHIM_FAILURE == handle(&mut_vcpu));
+                        bsl::ut_check(bsl::safe_u64::magic_1() == *mut_vm.populated[0]);
                     };
                     bsl::ut_cleanup{} = [&]() noexcept {
+                        auto const bytes{shim_vm_populated_size(&mut_vm.slots[0])};
+                        platform_free(mut_vm.populated[0], bytes);
+                        g_mut_mv_vs_op_run_mmio = {};
                         delete mut_vcpu.run;    // NOLINT // GRCOV_EXCLUDE_BR
                     };
                 };
             };
         };
 
-        bsl::ut_scenario{"g_mut_mv_vs_op_run returns random"} = []() noexcept {
+        bsl::ut_scenario{"mmio in a slot with other populated regions"} = []() noexcept {
             bsl::ut_given{} = [&]() noexcept {
+                shim_vm_t mut_vm{};
                 shim_vcpu_t mut_vcpu{};
+                constexpr auto gpa{0x0_u64};
+                constexpr auto size{0x400000_u64};
+                constexpr auto addr{0x1000_u64};
+                constexpr auto fault{0x201000_u64};
+                bsl::uint64 mut_populated{0x1_u64.get()};
                 bsl::ut_when{} = [&]() noexcept {
                     mut_vcpu.run = new kvm_run();    // NOLINT
-                    g_mut_mv_vs_op_run = static_cast<mv_exit_reason_t>(-42);
+                    mut_vcpu.vm = &mut_vm;
+                    mut_vm.slots[0].guest_phys_addr = gpa.get();
+                    mut_vm.slots[0].memory_size = size.get();
+                    mut_vm.slots[0].userspace_addr = addr.get();
+                    mut_vm.populated[0] = &mut_populated;
+                    g_mut_mv_vs_op_run_mmio.gpa = fault.get();
+                    g_mut_mv_vs_op_run = mv_exit_reason_t_mmio;
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(SHIM_FAILURE == handle(&mut_vcpu));
+                        bsl::ut_check(0x3_u64 == mut_populated);
+                    };
+                    bsl::ut_cleanup{} = [&]() noexcept {
+                        g_mut_mv_vs_op_run_mmio = {};
+                        delete mut_vcpu.run;    // NOLINT // GRCOV_EXCLUDE_BR
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"mmio while an invalidation is in progress"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                shim_vm_t mut_vm{};
+                shim_vcpu_t mut_vcpu{};
+                constexpr auto gpa{0x0_u64};
+                constexpr auto size{0x400000_u64};
+                constexpr auto addr{0x1000_u64};
+                constexpr auto fault{0x201000_u64};
+                bsl::ut_when{} = [&]() noexcept {
+                    mut_vcpu.run = new kvm_run();    // NOLINT
+                    mut_vcpu.vm = &mut_vm;
+                    mut_vm.slots[0].guest_phys_addr = gpa.get();
+                    mut_vm.slots[0].memory_size = size.get();
+                    mut_vm.slots[0].userspace_addr = addr.get();
+                    mut_vm.invalidate_in_progress = bsl::safe_u64::magic_1().get();
+                    g_mut_mv_vs_op_run_mmio.gpa = fault.get();
+                    g_mut_mv_vm_op_mmio_map = bsl::safe_u64::magic_1().get();
+                    g_mut_mv_vs_op_run = mv_exit_reason_t_mmio;
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(SHIM_FAILURE == handle(&mut_vcpu));
+                        bsl::ut_check(bsl::safe_u64::magic_1() == g_mut_mv_vm_op_mmio_map);
+                        bsl::ut_check(nullptr == mut_vm.populated[0]);
+                    };
+                    bsl::ut_cleanup{} = [&]() noexcept {
+                        g_mut_mv_vm_op_mmio_map = {};
+                        g_mut_mv_vs_op_run_mmio = {};
+                        delete mut_vcpu.run;    // NOLINT // GRCOV_EXCLUDE_BR
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"mmio platform_alloc fails"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                shim_vm_t mut_vm{};
+                shim_vcpu_t mut_vcpu{};
+                constexpr auto gpa{0x0_u64};
+                constexpr auto size{0x400000_u64};
+                constexpr auto addr{0x1000_u64};
+                constexpr auto fault{0x201000_u64};
+                bsl::ut_when{} = [&]() noexcept {
+                    mut_vcpu.run = new kvm_run();    // NOLINT
+                    mut_vcpu.vm = &mut_vm;
+                    mut_vm.slots[0].guest_phys_addr = gpa.get();
+                    mut_vm.slots[0].memory_size = size.get();
+                    mut_vm.slots[0].userspace_addr = addr.get();
+                    g_mut_mv_vs_op_run_mmio.gpa = fault.get();
+                    g_mut_platform_alloc_fails = true;
+                    g_mut_mv_vs_op_run = mv_exit_reason_t_mmio;
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(SHIM_FAILURE == handle(&mut_vcpu));
+                        bsl::ut_check(nullptr == mut_vm.populated[0]);
+                    };
+                    bsl::ut_cleanup{} = [&]() noexcept {
+                        g_mut_platform_alloc_fails = false;
+                        g_mut_mv_vs_op_run_mmio = {};
+                        delete mut_vcpu.run;    // NOLINT // GRCOV_EXCLUDE_BR
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"mmio platform_virt_to_phys_user fails"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                shim_vm_t mut_vm{};
+                shim_vcpu_t mut_vcpu{};
+                constexpr auto gpa{0x0_u64};
+                constexpr auto size{0x400000_u64};
+                constexpr auto addr{0x1000_u64};
+                constexpr auto fault{0x201000_u64};
+                bsl::ut_when{} = [&]() noexcept {
+                    mut_vcpu.run = new kvm_run();    // NOLINT
+                    mut_vcpu.vm = &mut_vm;
+                    mut_vm.slots[0].guest_phys_addr = gpa.get();
+                    mut_vm.slots[0].memory_size = size.get();
+                    mut_vm.slots[0].userspace_addr = addr.get();
+                    g_mut_mv_vs_op_run_mmio.gpa = fault.get();
+                    g_mut_platform_virt_to_phys_user_fails = true;
+                    g_mut_mv_vs_op_run = mv_exit_reason_t_mmio;
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(SHIM_FAILURE == handle(&mut_vcpu));
+                        bsl::ut_check(nullptr == mut_vm.populated[0]);
+                    };
+                    bsl::ut_cleanup{} = [&]() noexcept {
+                        g_mut_platform_virt_to_phys_user_fails = false;
+                        g_mut_mv_vs_op_run_mmio = {};
+                        delete mut_vcpu.run;    // NOLINT // GRCOV_EXCLUDE_BR
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"mmio mv_vm_op_mmio_map fails"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                shim_vm_t mut_vm{};
+                shim_vcpu_t mut_vcpu{};
+                constexpr auto gpa{0x0_u64};
+                constexpr auto size{0x400000_u64};
+                constexpr auto addr{0x1000_u64};
+                constexpr auto fault{0x201000_u64};
+                bsl::ut_when{} = [&]() noexcept {
+                    mut_vcpu.run = new kvm_run();    // NOLINT
+                    mut_vcpu.vm = &mut_vm;
+                    mut_vm.slots[0].guest_phys_addr = gpa.get();
+                    mut_vm.slots[0].memory_size = size.get();
+                    mut_vm.slots[0].userspace_addr = addr.get();
+                    g_mut_mv_vs_op_run_mmio.gpa = fault.get();
+                    g_mut_mv_vm_op_mmio_map = bsl::safe_u64::magic_1().get();
+                    g_mut_mv_vs_op_run = mv_exit_reason_t_mmio;
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(SHIM_FAILURE == handle(&mut_vcpu));
+                        bsl::ut_check(bsl::safe_u64::magic_0() == *mut_vm.populated[0]);
+                    };
+                    bsl::ut_cleanup{} = [&]() noexcept {
+                        g_mut_mv_vm_op_mmio_map = {};
+                        auto const bytes{shim_vm_populated_size(&mut_vm.slots[0])};
+                        platform_free(mut_vm.populated[0], bytes);
+                        g_mut_mv_vs_op_run_mmio = {};
+                        delete mut_vcpu.run;    // NOLINT // GRCOV_EXCLUDE_BR
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"mmio mv_vm_op_mmio_map fails on the last mdl"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                shim_vm_t mut_vm{};
+                shim_vcpu_t mut_vcpu{};
+                constexpr auto gpa{0x0_u64};
+                constexpr auto size{0x400000_u64};
+                constexpr auto addr{0x1000_u64};
+                constexpr auto fault{0x201000_u64};
+                bsl::ut_when{} = [&]() noexcept {
+                    mut_vcpu.run = new kvm_run();    // NOLINT
+                    mut_vcpu.vm = &mut_vm;
+                    mut_vm.slots[0].guest_phys_addr = gpa.get();
+                    mut_vm.slots[0].memory_size = size.get();
+                    mut_vm.slots[0].userspace_addr = addr.get();
+                    g_mut_mv_vs_op_run_mmio.gpa = fault.get();
+                    g_mut_mv_vm_op_mmio_map = 5_u64.get();
+                    g_mut_mv_vs_op_run = mv_exit_reason_t_mmio;
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(SHIM_FAILURE == handle(&mut_vcpu));
+                        bsl::ut_check(bsl::safe_u64::magic_0() == *mut_vm.populated[0]);
+                    };
+                    bsl::ut_cleanup{} = [&]() noexcept {
+                        g_mut_mv_vm_op_mmio_map = {};
+                        auto const bytes{shim_vm_populated_size(&mut_vm.slots[0])};
+                        platform_free(mut_vm.populated[0], bytes);
+                        g_mut_mv_vs_op_run_mmio = {};
+                        delete mut_vcpu.run;    // NOLINT // GRCOV_EXCLUDE_BR
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"mmio in a shared region copies the page"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                shim_vm_t mut_vm{};
+                shim_vcpu_t mut_vcpu{};
+                constexpr auto gpa{0x0_u64};
+                constexpr auto size{0x400000_u64};
+                constexpr auto addr{0x1000_u64};
+                constexpr auto fault{0x201000_u64};
+                bsl::uint64 mut_populated{0x2_u64.get()};
+                bsl::uint64 mut_shared{0x2_u64.get()};
+                bsl::ut_when{} = [&]() noexcept {
+                    mut_vcpu.run = new kvm_run();    // NOLINT
+                    mut_vcpu.vm = &mut_vm;
+                    mut_vm.slots[0].guest_phys_addr = gpa.get();
+                    mut_vm.slots[0].memory_size = size.get();
+                    mut_vm.slots[0].userspace_addr = addr.get();
+                    mut_vm.populated[0] = &mut_populated;
+                    mut_vm.shared[0] = &mut_shared;
+                    g_mut_mv_vs_op_run_mmio.gpa = fault.get();
+                    g_mut_mv_vm_op_mmio_map = bsl::safe_u64::magic_2().get();
+                    g_mut_mv_vm_op_mmio_unmap = bsl::safe_u64::magic_2().get();
+                    g_mut_mv_vs_op_run = mv_exit_reason_t_mmio;
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(SHIM_SUCCESS == handle(&mut_vcpu));
+                        bsl::ut_check(bsl::safe_u64::magic_1() == g_mut_mv_vm_op_mmio_map);
+                        bsl::ut_check(bsl::safe_u64::magic_1() == g_mut_mv_vm_op_mmio_unmap);
+                        bsl::ut_check(0x2_u64 == mut_populated);
+                    };
+                    bsl::ut_cleanup{} = [&]() noexcept {
+                        g_mut_mv_vm_op_mmio_map = {};
+                        g_mut_mv_vm_op_mmio_unmap = {};
+                        g_mut_mv_vs_op_run_mmio = {};
+                        delete mut_vcpu.run;    // NOLINT // GRCOV_EXCLUDE_BR
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"mmio in a shared region virt_to_phys fails"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                shim_vm_t mut_vm{};
+                shim_vcpu_t mut_vcpu{};
+                constexpr auto gpa{0x0_u64};
+                constexpr auto size{0x400000_u64};
+                constexpr auto addr{0x1000_u64};
+                constexpr auto fault{0x201000_u64};
+                bsl::uint64 mut_populated{0x2_u64.get()};
+                bsl::uint64 mut_shared{0x2_u64.get()};
+                bsl::ut_when{} = [&]() noexcept {
+                    mut_vcpu.run = new kvm_run();    // NOLINT
+                    mut_vcpu.vm = &mut_vm;
+                    mut_vm.slots[0].guest_phys_addr = gpa.get();
+                    mut_vm.slots[0].memory_size = size.get();
+                    mut_vm.slots[0].userspace_addr = addr.get();
+                    mut_vm.populated[0] = &mut_populated;
+                    mut_vm.shared[0] = &mut_shared;
+                    g_mut_mv_vs_op_run_mmio.gpa = fault.get();
+                    g_mut_platform_virt_to_phys_user_fails = true;
+                    g_mut_mv_vs_op_run = mv_exit_reason_t_mmio;
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(SHIM_FAILURE == handle(&mut_vcpu));
+                    };
+                    bsl::ut_cleanup{} = [&]() noexcept {
+                        g_mut_platform_virt_to_phys_user_fails = {};
+                        g_mut_mv_vs_op_run_mmio = {};
+                        delete mut_vcpu.run;    // NOLINT // GRCOV_EXCLUDE_BR
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"mmio in a shared region mv_vm_op_mmio_unmap fails"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                shim_vm_t mut_vm{};
+                shim_vcpu_t mut_vcpu{};
+                constexpr auto gpa{0x0_u64};
+                constexpr auto size{0x400000_u64};
+                constexpr auto addr{0x1000_u64};
+                constexpr auto fault{0x201000_u64};
+                bsl::uint64 mut_populated{0x2_u64.get()};
+                bsl::uint64 mut_shared{0x2_u64.get()};
+                bsl::ut_when{} = [&]() noexcept {
+                    mut_vcpu.run = new kvm_run();    // NOLINT
+                    mut_vcpu.vm = &mut_vm;
+                    mut_vm.slots[0].guest_phys_addr = gpa.get();
+                    mut_vm.slots[0].memory_size = size.get();
+                    mut_vm.slots[0].userspace_addr = addr.get();
+                    mut_vm.populated[0] = &mut_populated;
+                    mut_vm.shared[0] = &mut_shared;
+                    g_mut_mv_vs_op_run_mmio.gpa = fault.get();
+                    g_mut_mv_vm_op_mmio_unmap = bsl::safe_u64::magic_1().get();
+                    g_mut_mv_vs_op_run = mv_exit_reason_t_mmio;
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(SHIM_FAILURE == handle(&mut_vcpu));
+                    };
+                    bsl::ut_cleanup{} = [&]() noexcept {
+                        g_mut_mv_vm_op_mmio_unmap = {};
+                        g_mut_mv_vs_op_run_mmio = {};
+                        delete mut_vcpu.run;    // NOLINT // GRCOV_EXCLUDE_BR
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"mmio in a shared region mv_vm_op_mmio_map fails"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                shim_vm_t mut_vm{};
+                shim_vcpu_t mut_vcpu{};
+                constexpr auto gpa{0x0_u64};
+                constexpr auto size{0x400000_u64};
+                constexpr auto addr{0x1000_u64};
+                constexpr auto fault{0x201000_u64};
+                bsl::uint64 mut_populated{0x2_u64.get()};
+                bsl::uint64 mut_shared{0x2_u64.get()};
+                bsl::ut_when{} = [&]() noexcept {
+                    mut_vcpu.run = new kvm_run();    // NOLINT
+                    mut_vcpu.vm = &mut_vm;
+                    mut_vm.slots[0].guest_phys_addr = gpa.get();
+                    mut_vm.slots[0].memory_size = size.get();
+                    mut_vm.slots[0].userspace_addr = addr.get();
+                    mut_vm.populated[0] = &mut_populated;
+                    mut_vm.shared[0] = &mut_shared;
+                    g_mut_mv_vs_op_run_mmio.gpa = fault.get();
+                    g_mut_mv_vm_op_mmio_map = bsl::safe_u64::magic_1().get();
+                    g_mut_mv_vs_op_run = mv_exit_reason_t_mmio;
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(SHIM_FAILURE == handle(&mut_vcpu));
+                    };
+                    bsl::ut_cleanup{} = [&]() noexcept {
+                        g_mut_mv_vm_op_mmio_map = {};
+                        g_mut_mv_vs_op_run_mmio = {};
+                        delete mut_vcpu.run;    // NOLINT // GRCOV_EXCLUDE_BR
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"mmio in a region that is no longer shared"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                shim_vm_t mut_vm{};
+                shim_vcpu_t mut_vcpu{};
+                constexpr auto gpa{0x0_u64};
+                constexpr auto size{0x400000_u64};
+                constexpr auto addr{0x1000_u64};
+                constexpr auto fault{0x201000_u64};
+                bsl::uint64 mut_populated{0x2_u64.get()};
+                bsl::uint64 mut_shared{0x1_u64.get()};
+                bsl::ut_when{} = [&]() noexcept {
+                    mut_vcpu.run = new kvm_run();    // NOLINT
+                    mut_vcpu.vm = &mut_vm;
+                    mut_vm.slots[0].guest_phys_addr = gpa.get();
+                    mut_vm.slots[0].memory_size = size.get();
+                    mut_vm.slots[0].userspace_addr = addr.get();
+                    mut_vm.populated[0] = &mut_populated;
+                    mut_vm.shared[0] = &mut_shared;
+                    g_mut_mv_vs_op_run_mmio.gpa = fault.get();
+                    g_mut_mv_vm_op_mmio_map = bsl::safe_u64::magic_1().get();
+                    g_mut_mv_vs_op_run = mv_exit_reason_t_mmio;
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(SHIM_SUCCESS == handle(&mut_vcpu));
+                        bsl::ut_check(bsl::safe_u64::magic_1() == g_mut_mv_vm_op_mmio_map);
+                    };
+                    bsl::ut_cleanup{} = [&]() noexcept {
+                        g_mut_mv_vm_op_mmio_map = {};
+                        g_mut_mv_vs_op_run_mmio = {};
+                        delete mut_vcpu.run;    // NOLINT // GRCOV_EXCLUDE_BR
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"g_mut_mv_vs_op_run returns msr read"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                shim_vm_t mut_vm{};
+                shim_vcpu_t mut_vcpu{};
+                constexpr auto msr{0xC0000080_u64};
+                bsl::ut_when{} = [&]() noexcept {
+                    mut_vcpu.run = new kvm_run();    // NOLINT
+                    mut_vcpu.vm = &mut_vm;
+                    mut_vm.msr_exit_reasons = KVM_MSR_EXIT_REASON_FILTER;
+                    g_mut_mv_vs_op_run = mv_exit_reason_t_msr;
+                    g_mut_mv_vs_op_run_msr.msr.reg = msr.get();
+                    g_mut_mv_vs_op_run_msr.flags = MV_EXIT_MSR_READ;
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(SHIM_SUCCESS == handle(&mut_vcpu));
+                        bsl::ut_check(KVM_EXIT_X86_RDMSR == mut_vcpu.run->exit_reason);
+                        bsl::ut_check(KVM_MSR_EXIT_REASON_FILTER == mut_vcpu.run->msr.reason);
+                        bsl::ut_check(msr == bsl::to_u64(mut_vcpu.run->msr.index));
+                        bsl::ut_check(MV_EXIT_MSR_READ == mut_vcpu.msr_exit_flags);
+                    };
+                    bsl::ut_cleanup{} = [&]() noexcept {
+                        g_mut_mv_vs_op_run_msr = {};
+                        delete mut_vcpu.run;    // NOLINT // GRCOV_EXCLUDE_BR
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"g_mut_mv_vs_op_run returns msr write"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                shim_vm_t mut_vm{};
+                shim_vcpu_t mut_vcpu{};
+                constexpr auto msr{0xC0000080_u64};
+                bsl::ut_when{} = [&]() noexcept {
+                    mut_vcpu.run = new kvm_run();    // NOLINT
+                    mut_vcpu.vm = &mut_vm;
+                    mut_vm.msr_exit_reasons = KVM_MSR_EXIT_REASON_FILTER;
+                    g_mut_mv_vs_op_run = mv_exit_reason_t_msr;
+                    g_mut_mv_vs_op_run_msr.msr.reg = msr.get();
+                    g_mut_mv_vs_op_run_msr.msr.val = VAL64.get();
+                    g_mut_mv_vs_op_run_msr.flags = MV_EXIT_MSR_WRITE;
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(SHIM_SUCCESS == handle(&mut_vcpu));
+                        bsl::ut_check(KVM_EXIT_X86_WRMSR == mut_vcpu.run->exit_reason);
+                        bsl::ut_check(VAL64 == mut_vcpu.run->msr.data);
+                        bsl::ut_check(MV_EXIT_MSR_WRITE == mut_vcpu.msr_exit_flags);
+                    };
+                    bsl::ut_cleanup{} = [&]() noexcept {
+                        g_mut_mv_vs_op_run_msr = {};
+                        delete mut_vcpu.run;    // NOLINT // GRCOV_EXCLUDE_BR
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"g_mut_mv_vs_op_run returns msr invalid flags"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                shim_vm_t mut_vm{};
+                shim_vcpu_t mut_vcpu{};
+                bsl::ut_when{} = [&]() noexcept {
+                    mut_vcpu.run = new kvm_run();    // NOLINT
+                    mut_vcpu.vm = &mut_vm;
+                    mut_vm.msr_exit_reasons = KVM_MSR_EXIT_REASON_FILTER;
+                    g_mut_mv_vs_op_run = mv_exit_reason_t_msr;
+                    g_mut_mv_vs_op_run_msr.flags = MV_EXIT_MSR_ERROR;
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(SHIM_FAILURE == handle(&mut_vcpu));
+                        bsl::ut_check(KVM_EXIT_FAIL_ENTRY == mut_vcpu.run->exit_reason);
+                    };
+                    bsl::ut_cleanup{} = [&]() noexcept {
+                        g_mut_mv_vs_op_run_msr = {};
+                        delete mut_vcpu.run;    // NOLINT // GRCOV_EXCLUDE_BR
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"g_mut_mv_vs_op_run returns msr without user space msr"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                shim_vm_t mut_vm{};
+                shim_vcpu_t mut_vcpu{};
+                bsl::ut_when{} = [&]() noexcept {
+                    mut_vcpu.run = new kvm_run();    // NOLINT
+                    mut_vcpu.vm = &mut_vm;
+                    g_mut_mv_vs_op_run = mv_exit_reason_t_msr;
+                    g_mut_mv_vs_op_run_msr.flags = MV_EXIT_MSR_READ;
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(SHIM_FAILURE == handle(&mut_vcpu));
+                        bsl::ut_check(bsl::safe_u64::magic_0() == mut_vcpu.msr_exit_flags);
+                        bsl::ut_check(
+                            (MV_EXIT_MSR_READ | MV_EXIT_MSR_ERROR) ==
+                            shared_page_as<mv_exit_msr_t>()->flags);
+                    };
+                    bsl::ut_cleanup{} = [&]() noexcept {
+                        g_mut_mv_vs_op_run_msr = {};
+                        delete mut_vcpu.run;    // NOLINT // GRCOV_EXCLUDE_BR
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"pending msr read is completed"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                shim_vcpu_t mut_vcpu{};
+                constexpr auto msr{0xC0000080_u32};
+                bsl::ut_when{} = [&]() noexcept {
+                    mut_vcpu.run = new kvm_run();    // NOLINT
+                    mut_vcpu.msr_exit_flags = MV_EXIT_MSR_READ;
+                    mut_vcpu.msr_exit_index = msr.get();
+                    mut_vcpu.run->msr.data = VAL64.get();
+                    g_mut_mv_vs_op_run = mv_exit_reason_t_failure;
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(SHIM_FAILURE == handle(&mut_vcpu));
+                        bsl::ut_check(bsl::safe_u64::magic_0() == mut_vcpu.msr_exit_flags);
+                        bsl::ut_check(
+                            bsl::to_u64(msr) == shared_page_as<mv_exit_msr_t>()->msr.reg);
+                        bsl::ut_check(VAL64 == shared_page_as<mv_exit_msr_t>()->msr.val);
+                        bsl::ut_check(MV_EXIT_MSR_READ == shared_page_as<mv_exit_msr_t>()->flags);
+                    };
+                    bsl::ut_cleanup{} = [&]() noexcept {
+                        delete mut_vcpu.run;    // NOLINT // GRCOV_EXCLUDE_BR
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"pending msr write is completed with an error"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                shim_vcpu_t mut_vcpu{};
+                bsl::ut_when{} = [&]() noexcept {
+                    mut_vcpu.run = new kvm_run();    // NOLINT
+                    mut_vcpu.msr_exit_flags = MV_EXIT_MSR_WRITE;
+                    mut_vcpu.run->msr.error = 1_u8.get();
+                    g_mut_mv_vs_op_run = mv_exit_reason_t_failure;
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(SHIM_FAILURE == handle(&mut_vcpu));
+                        bsl::ut_check(
+                            (MV_EXIT_MSR_WRITE | MV_EXIT_MSR_ERROR) ==
+                            shared_page_as<mv_exit_msr_t>()->flags);
+                    };
+                    bsl::ut_cleanup{} = [&]() noexcept {
+                        delete mut_vcpu.run;    // NOLINT // GRCOV_EXCLUDE_BR
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"g_mut_mv_vs_op_run returns interrupt"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                shim_vm_t mut_vm{};
+                shim_vcpu_t mut_vcpu{};
+                bsl::ut_when{} = [&]() noexcept {
+                    mut_vcpu.run = new kvm_run();    // NOLINT
+                    mut_vcpu.vm = &mut_vm;
+                    g_mut_mv_vs_op_run = mv_exit_reason_t_interrupt;
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(SHIM_FAILURE == handle(&mut_vcpu));
+                        bsl::ut_check(platform_thread{} == mut_vcpu.preempted_thread);
+                    };
+                    bsl::ut_cleanup{} = [&]() noexcept {
+                        delete mut_vcpu.run;    // NOLINT // GRCOV_EXCLUDE_BR
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"g_mut_mv_vs_op_run returns nmi"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                shim_vcpu_t mut_vcpu{};
+                bsl::ut_when{} = [&]() noexcept {
+                    mut_vcpu.run = new kvm_run();    // NOLINT
+                    g_mut_mv_vs_op_run = mv_exit_reason_t_nmi;
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(SHIM_FAILURE == handle(&mut_vcpu));
+                    };
+                    bsl::ut_cleanup{} = [&]() noexcept {
+                        delete mut_vcpu.run;    // NOLINT // GRCOV_EXCLUDE_BR
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"g_mut_mv_vs_op_run returns kick"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                shim_vm_t mut_vm{};
+                shim_vcpu_t mut_vcpu{};
+                constexpr auto apic_id{3_u32};
+                bsl::ut_when{} = [&]() noexcept {
+                    mut_vcpu.run = new kvm_run();    // NOLINT
+                    mut_vcpu.vm = &mut_vm;
+                    mut_vm.vcpus[1].fd = bsl::safe_u64::magic_1().get();
+                    mut_vm.vcpus[1].apic_id = apic_id.get();
+                    mut_vm.vcpus[2].fd = bsl::safe_u64::magic_1().get();
+                    g_mut_mv_vs_op_run = mv_exit_reason_t_kick;
+                    g_mut_mv_vs_op_run_kick.apic_id = bsl::to_u64(apic_id).get();
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(SHIM_FAILURE == handle(&mut_vcpu));
+                        bsl::ut_check(platform_event{} != mut_vm.vcpus[1].unhalt);
+                        bsl::ut_check(platform_event{} == mut_vm.vcpus[2].unhalt);
+                    };
+                    bsl::ut_cleanup{} = [&]() noexcept {
+                        g_mut_mv_vs_op_run_kick = {};
+                        delete mut_vcpu.run;    // NOLINT // GRCOV_EXCLUDE_BR
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"g_mut_mv_vs_op_run returns kick unknown apic id"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                shim_vm_t mut_vm{};
+                shim_vcpu_t mut_vcpu{};
+                bsl::ut_when{} = [&]() noexcept {
+                    mut_vcpu.run = new kvm_run();    // NOLINT
+                    mut_vcpu.vm = &mut_vm;
+                    mut_vm.vcpus[1].fd = bsl::safe_u64::magic_1().get();
+                    g_mut_mv_vs_op_run = mv_exit_reason_t_kick;
+                    g_mut_mv_vs_op_run_kick.apic_id = VAL64.get();
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(SHIM_FAILURE == handle(&mut_vcpu));
+                        bsl::ut_check(platform_event{} == mut_vm.vcpus[1].unhalt);
+                    };
+                    bsl::ut_cleanup{} = [&]() noexcept {
+                        g_mut_mv_vs_op_run_kick = {};
+                        delete mut_vcpu.run;    // NOLINT // GRCOV_EXCLUDE_BR
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"g_mut_mv_vs_op_run returns pause"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                shim_vm_t mut_vm{};
+                shim_vcpu_t mut_vcpu{};
+                bsl::ut_when{} = [&]() noexcept {
+                    mut_vcpu.run = new kvm_run();    // NOLINT
+                    mut_vcpu.vm = &mut_vm;
+                    mut_vm.vcpus[1].fd = bsl::safe_u64::magic_1().get();
+                    mut_vm.vcpus[2].fd = bsl::safe_u64::magic_1().get();
+                    mut_vm.vcpus[2].preempted_thread = bsl::safe_u64::magic_2().get();
+                    g_mut_mv_vs_op_run = mv_exit_reason_t_pause;
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(SHIM_FAILURE == handle(&mut_vcpu));
+                        bsl::ut_check(bsl::safe_u64::magic_2() == g_mut_platform_yielded_to);
+                        bsl::ut_check(bsl::safe_u64::magic_2() == mut_vm.last_boosted);
+                        bsl::ut_check(bsl::safe_u64::magic_0() == g_mut_platform_yield);
+                        bsl::ut_check(bsl::safe_u64::magic_1() == g_mut_platform_thread_get);
+                        bsl::ut_check(bsl::safe_u64::magic_1() == g_mut_platform_thread_put);
+                    };
+                    bsl::ut_cleanup{} = [&]() noexcept {
+                        g_mut_platform_yielded_to = {};
+                        g_mut_platform_thread_get = {};
+                        g_mut_platform_thread_put = {};
+                        delete mut_vcpu.run;    // NOLINT // GRCOV_EXCLUDE_BR
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"g_mut_mv_vs_op_run returns pause yield_to fails"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                shim_vm_t mut_vm{};
+                shim_vcpu_t mut_vcpu{};
+                constexpr auto thread{3_u64};
+                bsl::ut_when{} = [&]() noexcept {
+                    mut_vcpu.run = new kvm_run();    // NOLINT
+                    mut_vcpu.vm = &mut_vm;
+                    mut_vm.vcpus[1].fd = bsl::safe_u64::magic_1().get();
+                    mut_vm.vcpus[1].preempted_thread = bsl::safe_u64::magic_2().get();
+                    mut_vm.vcpus[2].fd = bsl::safe_u64::magic_1().get();
+                    mut_vm.vcpus[2].preempted_thread = thread.get();
+                    g_mut_mv_vs_op_run = mv_exit_reason_t_pause;
+                    g_mut_platform_yield_to = SHIM_FAILURE;
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(SHIM_FAILURE == handle(&mut_vcpu));
+                        bsl::ut_check(thread == g_mut_platform_yielded_to);
+                        bsl::ut_check(bsl::safe_u64::magic_0() == mut_vm.last_boosted);
+                        bsl::ut_check(bsl::safe_u64::magic_1() == g_mut_platform_yield);
+                        bsl::ut_check(bsl::safe_u64::magic_2() == g_mut_platform_thread_get);
+                        bsl::ut_check(bsl::safe_u64::magic_2() == g_mut_platform_thread_put);
+                    };
+                    bsl::ut_cleanup{} = [&]() noexcept {
+                        g_mut_platform_yield_to = SHIM_SUCCESS;
+                        g_mut_platform_yielded_to = {};
+                        g_mut_platform_yield = {};
+                        g_mut_platform_thread_get = {};
+                        g_mut_platform_thread_put = {};
+                        delete mut_vcpu.run;    // NOLINT // GRCOV_EXCLUDE_BR
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"g_mut_mv_vs_op_run returns pause none preempted"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                shim_vm_t mut_vm{};
+                shim_vcpu_t mut_vcpu{};
+                bsl::ut_when{} = [&]() noexcept {
+                    mut_vcpu.run = new kvm_run();    // NOLINT
+                    mut_vcpu.vm = &mut_vm;
+                    mut_vm.vcpus[1].fd = bsl::safe_u64::magic_1().get();
+                    g_mut_mv_vs_op_run = mv_exit_reason_t_pause;
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(SHIM_FAILURE == handle(&mut_vcpu));
+                        bsl::ut_check(bsl::safe_u64::magic_0() == g_mut_platform_yielded_to);
+                        bsl::ut_check(bsl::safe_u64::magic_1() == g_mut_platform_yield);
+                        bsl::ut_check(bsl::safe_u64::magic_0() == g_mut_platform_thread_get);
+                    };
+                    bsl::ut_cleanup{} = [&]() noexcept {
+                        g_mut_platform_yield = {};
+                        delete mut_vcpu.run;    // NOLINT // GRCOV_EXCLUDE_BR
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"g_mut_mv_vs_op_run returns random"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                shim_vcpu_t mut_vcpu{};
+                bsl::ut_when{} = [&]() noexcept {
+                    mut_vcpu.run = new kvm_run();    // NOLINT
+                    g_mut_mv_vs_op_run = static_cast<mv_exit_reason_t>(-42);
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(SHIM_FAILURE == handle(&mut_vcpu));
+                    };
+                    bsl::ut_cleanup{} = [&]() noexcept {
+                        delete mut_vcpu.run;    // NOLINT // GRCOV_EXCLUDE_BR
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"g_mut_mv_vs_op_run returns dirty ring full without a ring"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                shim_vcpu_t mut_vcpu{};
+                bsl::ut_when{} = [&]() noexcept {
+                    mut_vcpu.run = new kvm_run();    // NOLINT
+                    g_mut_mv_vs_op_run = mv_exit_reason_t_dirty_ring_full;
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(SHIM_FAILURE == handle(&mut_vcpu));
+                    };
+                    bsl::ut_cleanup{} = [&]() noexcept {
+                        delete mut_vcpu.run;    // NOLINT // GRCOV_EXCLUDE_BR
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"g_mut_mv_vs_op_run returns dirty ring full"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                shim_vm_t mut_vm{};
+                shim_vcpu_t mut_vcpu{};
+                bsl::array<kvm_dirty_gfn, 4_umx.get()> mut_ring{};
+                bsl::ut_when{} = [&]() noexcept {
+                    mut_vcpu.run = new kvm_run();    // NOLINT
+                    mut_vcpu.vm = &mut_vm;
+                    mut_vcpu.dirty_ring = mut_ring.data();
+                    mut_vm.dirty_ring_size = mut_ring.size_bytes().get();
+                    g_mut_mv_vs_op_run = mv_exit_reason_t_dirty_ring_full;
+                    g_mut_mv_vs_op_dirty_ring_get_num_entries = mut_ring.size().get();
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(SHIM_SUCCESS == handle(&mut_vcpu));
+                        bsl::ut_check(KVM_EXIT_DIRTY_RING_FULL == mut_vcpu.run->exit_reason);
+                        bsl::ut_check(mut_ring.size() == mut_vcpu.dirty_index);
+                        bsl::ut_check(KVM_DIRTY_GFN_F_DIRTY == mut_ring.back().flags);
+                    };
+                    bsl::ut_cleanup{} = [&]() noexcept {
+                        g_mut_mv_vs_op_dirty_ring_get_num_entries = {};
+                        delete mut_vcpu.run;    // NOLINT // GRCOV_EXCLUDE_BR
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"dirty ring is already full"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                shim_vm_t mut_vm{};
+                shim_vcpu_t mut_vcpu{};
+                bsl::array<kvm_dirty_gfn, 4_umx.get()> mut_ring{};
+                bsl::ut_when{} = [&]() noexcept {
+                    mut_vcpu.run = new kvm_run();    // NOLINT
+                    mut_vcpu.vm = &mut_vm;
+                    mut_vcpu.dirty_ring = mut_ring.data();
+                    mut_vcpu.dirty_index = mut_ring.size().get();
+                    mut_vm.dirty_ring_size = mut_ring.size_bytes().get();
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(SHIM_SUCCESS == handle(&mut_vcpu));
+                        bsl::ut_check(KVM_EXIT_DIRTY_RING_FULL == mut_vcpu.run->exit_reason);
+                    };
+                    bsl::ut_cleanup{} = [&]() noexcept {
+                        delete mut_vcpu.run;    // NOLINT // GRCOV_EXCLUDE_BR
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"mv_vs_op_dirty_ring_get fails"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                shim_vm_t mut_vm{};
+                shim_vcpu_t mut_vcpu{};
+                bsl::array<kvm_dirty_gfn, 4_umx.get()> mut_ring{};
+                bsl::ut_when{} = [&]() noexcept {
+                    mut_vcpu.run = new kvm_run();    // NOLINT
+                    mut_vcpu.vm = &mut_vm;
+                    mut_vcpu.dirty_ring = mut_ring.data();
+                    mut_vm.dirty_ring_size = mut_ring.size_bytes().get();
+                    g_mut_mv_vs_op_run = mv_exit_reason_t_dirty_ring_full;
+                    g_mut_mv_vs_op_dirty_ring_get = MV_STATUS_FAILURE_UNKNOWN;
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(SHIM_FAILURE == handle(&mut_vcpu));
+                    };
+                    bsl::ut_cleanup{} = [&]() noexcept {
+                        g_mut_mv_vs_op_dirty_ring_get = {};
+                        delete mut_vcpu.run;    // NOLINT // GRCOV_EXCLUDE_BR
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"sync regs with unsupported valid regs"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                shim_vcpu_t mut_vcpu{};
+                bsl::ut_when{} = [&]() noexcept {
+                    mut_vcpu.run = new kvm_run();    // NOLINT
+                    mut_vcpu.run->kvm_valid_regs = KVM_SYNC_X86_EVENTS;
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(SHIM_FAILURE == handle(&mut_vcpu));
+                    };
+                    bsl::ut_cleanup{} = [&]() noexcept {
+                        delete mut_vcpu.run;    // NOLINT // GRCOV_EXCLUDE_BR
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"sync regs with unsupported dirty regs"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                shim_vcpu_t mut_vcpu{};
+                bsl::ut_when{} = [&]() noexcept {
+                    mut_vcpu.run = new kvm_run();    // NOLINT
+                    mut_vcpu.run->kvm_dirty_regs = KVM_SYNC_X86_EVENTS;
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(SHIM_FAILURE == handle(&mut_vcpu));
+                    };
+                    bsl::ut_cleanup{} = [&]() noexcept {
+                        delete mut_vcpu.run;    // NOLINT // GRCOV_EXCLUDE_BR
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"sync regs success"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                shim_vm_t mut_vm{};
+                shim_vcpu_t mut_vcpu{};
+                bsl::array<kvm_dirty_gfn, 4_umx.get()> mut_ring{};
+                bsl::ut_when{} = [&]() noexcept {
+                    mut_vcpu.run = new kvm_run();    // NOLINT
+                    mut_vcpu.vm = &mut_vm;
+                    mut_vcpu.dirty_ring = mut_ring.data();
+                    mut_vcpu.dirty_index = mut_ring.size().get();
+                    mut_vm.dirty_ring_size = mut_ring.size_bytes().get();
+                    mut_vcpu.run->kvm_valid_regs = KVM_SYNC_X86_VALID_FIELDS;
+                    mut_vcpu.run->kvm_dirty_regs = KVM_SYNC_X86_VALID_FIELDS;
+                    g_mut_val = VAL64.get();
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(SHIM_SUCCESS == handle(&mut_vcpu));
+                        bsl::ut_check(bsl::safe_u64::magic_0() == mut_vcpu.run->kvm_dirty_regs);
+                        bsl::ut_check(VAL64 == mut_vcpu.run->s.regs.regs.rax);
+                        bsl::ut_check(VAL64 == mut_vcpu.run->s.regs.regs.rip);
+                        bsl::ut_check(VAL64 == mut_vcpu.run->s.regs.sregs.cr0);
+                    };
+                    bsl::ut_cleanup{} = [&]() noexcept {
+                        g_mut_val = {};
+                        delete mut_vcpu.run;    // NOLINT // GRCOV_EXCLUDE_BR
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"sync regs mv_vs_op_reg_set_list fails"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                shim_vcpu_t mut_vcpu{};
+                bsl::ut_when{} = [&]() noexcept {
+                    mut_vcpu.run = new kvm_run();    // NOLINT
+                    mut_vcpu.run->kvm_dirty_regs = KVM_SYNC_X86_REGS;
+                    g_mut_mv_vs_op_reg_set_list = MV_STATUS_FAILURE_UNKNOWN;
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(SHIM_FAILURE == handle(&mut_vcpu));
+                        bsl::ut_check(KVM_EXIT_FAIL_ENTRY == mut_vcpu.run->exit_reason);
+                    };
+                    bsl::ut_cleanup{} = [&]() noexcept {
+                        g_mut_mv_vs_op_reg_set_list = {};
+                        delete mut_vcpu.run;    // NOLINT // GRCOV_EXCLUDE_BR
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"sync regs mv_vs_op_reg_get_list fails"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                shim_vm_t mut_vm{};
+                shim_vcpu_t mut_vcpu{};
+                bsl::array<kvm_dirty_gfn, 4_umx.get()> mut_ring{};
+                bsl::ut_when{} = [&]() noexcept {
+                    mut_vcpu.run = new kvm_run();    // NOLINT
+                    mut_vcpu.vm = &mut_vm;
+                    mut_vcpu.dirty_ring = mut_ring.data();
+                    mut_vcpu.dirty_index = mut_ring.size().get();
+                    mut_vm.dirty_ring_size = mut_ring.size_bytes().get();
+                    mut_vcpu.run->kvm_valid_regs = KVM_SYNC_X86_REGS;
+                    g_mut_mv_vs_op_reg_get_list = MV_STATUS_FAILURE_UNKNOWN;
                     bsl::ut_then{} = [&]() noexcept {
                         bsl::ut_check(SHIM_FAILURE == handle(&mut_vcpu));
                     };
                     bsl::ut_cleanup{} = [&]() noexcept {
+                        g_mut_mv_vs_op_reg_get_list = {};
                         delete mut_vcpu.run;    // NOLINT // GRCOV_EXCLUDE_BR
                     };
                 };
@@ -24,13 +24,30 @@
 
 #include "../../include/handle_vcpu_kvm_set_cpuid2.h"
 
+#include <helpers.hpp>
+#include <kvm_constants.h>
 #include <kvm_cpuid2.h>
+#include <kvm_cpuid_entry2.h>
+#include <mv_cdl_t.h>
+#include <mv_cpuid_flag_t.h>
 #include <mv_types.h>
+#include <shim_vcpu_t.h>
 
+#include <bsl/array.hpp>
+#include <bsl/safe_integral.hpp>
 #include <bsl/ut.hpp>
 
 namespace shim
 {
+    /// @brief defines the number of entries used by the tests
+    constexpr auto NUM_ENTRIES{static_cast<bsl::uint32>(MV_CDL_MAX_ENTRIES + 1U)};
+    /// @brief defines the CPUID function used by the tests
+    constexpr auto FUN{0x0000000D_u32};
+    /// @brief defines the CPUID index used by the tests
+    constexpr auto IDX{0x00000001_u32};
+    /// @brief defines the CPUID register value used by the tests
+    constexpr auto VAL32{42_u32};
+
     /// <!-- description -->
     ///   @brief Used to execute the actual checks. We put the checks in this
     ///     function so that we can validate the tests both at compile-time
@@ -43,18 +60,142 @@ namespace shim
     [[nodiscard]] constexpr auto
     tests() noexcept -> bsl::exit_code
     {
-        bsl::ut_scenario{"description"} = []() noexcept {
+        init_tests();
+        constexpr auto handle{&handle_vcpu_kvm_set_cpuid2};
+
+        bsl::ut_scenario{"success with no entries"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                shim_vcpu_t const vcpu{};
+                kvm_cpuid2 const args{};
+                bsl::array<kvm_cpuid_entry2, NUM_ENTRIES> const entries{};
+                bsl::ut_then{} = [&]() noexcept {
+                    bsl::ut_check(SHIM_SUCCESS == handle(&vcpu, &args, entries.data()));
+                    auto const *const cdl{shared_page_as<mv_cdl_t>()};
+                    bsl::ut_check(bsl::safe_u64::magic_0() == cdl->reg0);
+                    bsl::ut_check(bsl::safe_u64::magic_0() == cdl->num_entries);
+                };
+            };
+        };
+
+        bsl::ut_scenario{"success"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                shim_vcpu_t const vcpu{};
+                kvm_cpuid2 mut_args{};
+                bsl::array<kvm_cpuid_entry2, NUM_ENTRIES> mut_entries{};
+                bsl::ut_when{} = [&]() noexcept {
+                    mut_args.nent = 1U;
+                    mut_entries.front().function = FUN.get();
+                    mut_entries.front().index = IDX.get();
+                    mut_entries.front().eax = VAL32.get();
+                    mut_entries.front().ebx = VAL32.get();
+                    mut_entries.front().ecx = VAL32.get();
+                    mut_entries.front().edx = VAL32.get();
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(
+                            SHIM_SUCCESS == handle(&vcpu, &mut_args, mut_entries.data()));
+                        auto const *const cdl{shared_page_as<mv_cdl_t>()};
+                        bsl::ut_check(bsl::safe_u64::magic_0() == cdl->reg0);
+                        bsl::ut_check(bsl::safe_u64::magic_1() == cdl->num_entries);
+                        bsl::ut_check(FUN == cdl->entries[0].fun);
+                        bsl::ut_check(IDX == cdl->entries[0].idx);
+                        bsl::ut_check(mv_cpuid_flag_t_reserved == cdl->entries[0].flags);
+                        bsl::ut_check(VAL32 == cdl->entries[0].eax);
+                        bsl::ut_check(VAL32 == cdl->entries[0].ebx);
+                        bsl::ut_check(VAL32 == cdl->entries[0].ecx);
+                        bsl::ut_check(VAL32 == cdl->entries[0].edx);
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"success with significant index"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                shim_vcpu_t const vcpu{};
+                kvm_cpuid2 mut_args{};
+                bsl::array<kvm_cpuid_entry2, NUM_ENTRIES> mut_entries{};
+                bsl::ut_when{} = [&]() noexcept {
+                    mut_args.nent = 1U;
+                    mut_entries.front().flags = KVM_CPUID_FLAG_SIGNIFCANT_INDEX;
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(
+                            SHIM_SUCCESS == handle(&vcpu, &mut_args, mut_entries.data()));
+                        auto const *const cdl{shared_page_as<mv_cdl_t>()};
+                        bsl::ut_check(
+                            mv_cpuid_flag_t_significant_index == cdl->entries[0].flags);
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"success with more entries than fit in a cdl"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                shim_vcpu_t const vcpu{};
+                kvm_cpuid2 mut_args{};
+                bsl::array<kvm_cpuid_entry2, NUM_ENTRIES> mut_entries{};
+                bsl::ut_when{} = [&]() noexcept {
+                    mut_args.nent = NUM_ENTRIES;
+                    mut_entries.back().function = FUN.get();
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(
+                            SHIM_SUCCESS == handle(&vcpu, &mut_args, mut_entries.data()));
+                        auto const *const cdl{shared_page_as<mv_cdl_t>()};
+                        bsl::ut_check(MV_CDL_MAX_ENTRIES == cdl->reg0);
+                        bsl::ut_check(bsl::safe_u64::magic_1() == cdl->num_entries);
+                        bsl::ut_check(FUN == cdl->entries[0].fun);
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"too many entries"} = []() noexcept {
             bsl::ut_given{} = [&]() noexcept {
+                shim_vcpu_t const vcpu{};
                 kvm_cpuid2 mut_args{};
+                bsl::array<kvm_cpuid_entry2, NUM_ENTRIES> const entries{};
+                bsl::ut_when{} = [&]() noexcept {
+                    mut_args.nent = KVM_MAX_CPUID_ENTRIES + 1;
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(SHIM_FAILURE == handle(&vcpu, &mut_args, entries.data()));
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"hypervisor not detected"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                shim_vcpu_t const vcpu{};
+                kvm_cpuid2 const args{};
+                bsl::array<kvm_cpuid_entry2, NUM_ENTRIES> const entries{};
                 bsl::ut_when{} = [&]() noexcept {
+                    g_mut_hypervisor_detected = false;
                     bsl::ut_then{} = [&]() noexcept {
-                        bsl::ut_check(SHIM_SUCCESS == handle_vcpu_kvm_set_cpuid2(&mut_args));
+                        bsl::ut_check(SHIM_FAILURE == handle(&vcpu, &args, entries.data()));
+                    };
+                    bsl::ut_cleanup{} = [&]() noexcept {
+                        g_mut_hypervisor_detected = true;
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"mv_vs_op_cpuid_set_list fails"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                shim_vcpu_t const vcpu{};
+                kvm_cpuid2 const args{};
+                bsl::array<kvm_cpuid_entry2, NUM_ENTRIES> const entries{};
+                bsl::ut_when{} = [&]() noexcept {
+                    g_mut_mv_vs_op_cpuid_set_list = MV_STATUS_FAILURE_UNKNOWN;
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(SHIM_FAILURE == handle(&vcpu, &args, entries.data()));
+                    };
+                    bsl::ut_cleanup{} = [&]() noexcept {
+                        g_mut_mv_vs_op_cpuid_set_list = {};
                     };
                 };
             };
         };
 
-        return bsl::ut_success();
+        return fini_tests();
     }
 }
 
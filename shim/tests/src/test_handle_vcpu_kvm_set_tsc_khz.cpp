@@ -24,12 +24,20 @@
 
 #include "../../include/handle_vcpu_kvm_set_tsc_khz.h"
 
+#include <helpers.hpp>
+#include <mv_constants.h>
 #include <mv_types.h>
+#include <shim_vcpu_t.h>
 
+#include <bsl/convert.hpp>
+#include <bsl/safe_integral.hpp>
 #include <bsl/ut.hpp>
 
 namespace shim
 {
+    /// @brief the TSC frequency used by these tests
+    constexpr auto KHZ{1000000_u64};
+
     /// <!-- description -->
     ///   @brief Used to execute the actual checks. We put the checks in this
     ///     function so that we can validate the tests both at compile-time
@@ -42,17 +50,61 @@ namespace shim
     [[nodiscard]] constexpr auto
     tests() noexcept -> bsl::exit_code
     {
-        bsl::ut_scenario{"description"} = []() noexcept {
+        init_tests();
+        constexpr auto handle{&handle_vcpu_kvm_set_tsc_khz};
+
+        bsl::ut_scenario{"success"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                shim_vcpu_t mut_vcpu{};
+                bsl::ut_then{} = [&]() noexcept {
+                    bsl::ut_check(SHIM_SUCCESS == handle(&mut_vcpu, KHZ.get()));
+                    bsl::ut_check(KHZ == mut_vcpu.tsc_khz);
+                };
+            };
+        };
+
+        bsl::ut_scenario{"hypervisor not detected"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                shim_vcpu_t mut_vcpu{};
+                bsl::ut_when{} = [&]() noexcept {
+                    g_mut_hypervisor_detected = false;
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(SHIM_FAILURE == handle(&mut_vcpu, KHZ.get()));
+                        bsl::ut_check(bsl::safe_u64::magic_0() == mut_vcpu.tsc_khz);
+                    };
+                    bsl::ut_cleanup{} = [&]() noexcept {
+                        g_mut_hypervisor_detected = true;
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"frequency of 0"} = []() noexcept {
             bsl::ut_given{} = [&]() noexcept {
+                shim_vcpu_t mut_vcpu{};
+                bsl::ut_then{} = [&]() noexcept {
+                    bsl::ut_check(SHIM_FAILURE == handle(&mut_vcpu, {}));
+                };
+            };
+        };
+
+        bsl::ut_scenario{"mv_vs_op_tsc_set_khz fails"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                shim_vcpu_t mut_vcpu{};
                 bsl::ut_when{} = [&]() noexcept {
+                    g_mut_mv_vs_op_tsc_set_khz = MV_STATUS_FAILURE_UNKNOWN;
                     bsl::ut_then{} = [&]() noexcept {
-                        bsl::ut_check(SHIM_SUCCESS == handle_vcpu_kvm_set_tsc_khz());
+                        bsl::ut_check(SHIM_FAILURE == handle(&mut_vcpu, KHZ.get()));
+                        bsl::ut_check(bsl::safe_u64::magic_0() == mut_vcpu.tsc_khz);
+                    };
+                    bsl::ut_cleanup{} = [&]() noexcept {
+                        g_mut_mv_vs_op_tsc_set_khz = {};
                     };
                 };
             };
         };
 
-        return bsl::ut_success();
+        return fini_tests();
     }
 }
 
@@ -241,6 +241,48 @@ namespace shim
                 };
             };
         };
+        bsl::ut_scenario{"dirtylogring success"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                bsl::safe_u32 mut_checkext{};
+                constexpr auto ret_capdirtylogring{0x100000_u32};
+                constexpr auto capdirtylogring{192_u64};
+                bsl::ut_when{} = [&]() noexcept {
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(
+                            SHIM_SUCCESS == handle(capdirtylogring.get(), mut_checkext.data()));
+                        bsl::ut_check(ret_capdirtylogring == mut_checkext);
+                    };
+                };
+            };
+        };
+        bsl::ut_scenario{"adjustclock success"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                bsl::safe_u32 mut_checkext{};
+                constexpr auto ret_capadjclock{6_u16};
+                constexpr auto capadjclock{39_u64};
+                bsl::ut_when{} = [&]() noexcept {
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(
+                            SHIM_SUCCESS == handle(capadjclock.get(), mut_checkext.data()));
+                        bsl::ut_check(ret_capadjclock == bsl::to_u16(mut_checkext));
+                    };
+                };
+            };
+        };
+        bsl::ut_scenario{"syncregs success"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                bsl::safe_u32 mut_checkext{};
+                constexpr auto ret_capsyncregs{3_u32};
+                constexpr auto capsyncregs{74_u64};
+                bsl::ut_when{} = [&]() noexcept {
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(
+                            SHIM_SUCCESS == handle(capsyncregs.get(), mut_checkext.data()));
+                        bsl::ut_check(ret_capsyncregs == mut_checkext);
+                    };
+                };
+            };
+        };
         bsl::ut_scenario{"unsupported extension"} = []() noexcept {
             bsl::ut_given{} = [&]() noexcept {
                 bsl::safe_u32 mut_checkext{};
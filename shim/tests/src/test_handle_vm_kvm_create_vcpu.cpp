@@ -55,13 +55,16 @@ namespace shim
                 shim_vcpu_t *pmut_mut_vcpu{};
                 constexpr auto vpid{23_u16};
                 constexpr auto vsid{42_u16};
+                constexpr auto apic_id{7_u32};
                 bsl::ut_when{} = [&]() noexcept {
                     g_mut_mv_vp_op_create_vp = vpid.get();
                     g_mut_mv_vs_op_create_vs = vsid.get();
                     bsl::ut_then{} = [&]() noexcept {
-                        bsl::ut_check(SHIM_SUCCESS == handle(&mut_vm, &pmut_mut_vcpu));
+                        bsl::ut_check(
+                            SHIM_SUCCESS == handle(&mut_vm, apic_id.get(), &pmut_mut_vcpu));
                         bsl::ut_check(vpid == pmut_mut_vcpu->vpid);
                         bsl::ut_check(vsid == pmut_mut_vcpu->vsid);
+                        bsl::ut_check(apic_id == pmut_mut_vcpu->apic_id);
                     };
                 };
             };
@@ -74,7 +77,7 @@ namespace shim
                 bsl::ut_when{} = [&]() noexcept {
                     g_mut_hypervisor_detected = false;
                     bsl::ut_then{} = [&]() noexcept {
-                        bsl::ut_check(SHIM_FAILURE == handle(&mut_vm, &pmut_mut_vcpu));
+                        bsl::ut_check(SHIM_FAILURE == handle(&mut_vm, {}, &pmut_mut_vcpu));
                     };
                     bsl::ut_cleanup{} = [&]() noexcept {
                         g_mut_hypervisor_detected = true;
@@ -90,7 +93,7 @@ namespace shim
                 bsl::ut_when{} = [&]() noexcept {
                     g_mut_mv_vp_op_create_vp = MV_INVALID_ID;
                     bsl::ut_then{} = [&]() noexcept {
-                        bsl::ut_check(SHIM_FAILURE == handle(&mut_vm, &pmut_mut_vcpu));
+                        bsl::ut_check(SHIM_FAILURE == handle(&mut_vm, {}, &pmut_mut_vcpu));
                     };
                     bsl::ut_cleanup{} = [&]() noexcept {
                         g_mut_mv_vp_op_create_vp = {};
@@ -106,7 +109,7 @@ namespace shim
                 bsl::ut_when{} = [&]() noexcept {
                     g_mut_mv_vs_op_create_vs = MV_INVALID_ID;
                     bsl::ut_then{} = [&]() noexcept {
-                        bsl::ut_check(SHIM_FAILURE == handle(&mut_vm, &pmut_mut_vcpu));
+                        bsl::ut_check(SHIM_FAILURE == handle(&mut_vm, {}, &pmut_mut_vcpu));
                     };
                     bsl::ut_cleanup{} = [&]() noexcept {
                         g_mut_mv_vs_op_create_vs = {};
@@ -121,9 +124,9 @@ namespace shim
                 shim_vcpu_t *pmut_mut_vcpu{};
                 bsl::ut_when{} = [&]() noexcept {
                     bsl::ut_then{} = [&]() noexcept {
-                        bsl::ut_check(SHIM_SUCCESS == handle(&mut_vm, &pmut_mut_vcpu));
-                        bsl::ut_check(SHIM_SUCCESS == handle(&mut_vm, &pmut_mut_vcpu));
-                        bsl::ut_check(SHIM_FAILURE == handle(&mut_vm, &pmut_mut_vcpu));
+                        bsl::ut_check(SHIM_SUCCESS == handle(&mut_vm, {}, &pmut_mut_vcpu));
+                        bsl::ut_check(SHIM_SUCCESS == handle(&mut_vm, {}, &pmut_mut_vcpu));
+                        bsl::ut_check(SHIM_FAILURE == handle(&mut_vm, {}, &pmut_mut_vcpu));
                     };
                 };
             };
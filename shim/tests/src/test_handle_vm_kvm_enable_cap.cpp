@@ -0,0 +1,210 @@
+/// @copyright
+/// Copyright (C) 2020 Assured Information Security, Inc.
+///
+/// @copyright
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// @copyright
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// @copyright
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+
+#include "../../include/handle_vm_kvm_enable_cap.h"
+
+#include <helpers.hpp>
+#include <kvm_constants.h>
+#include <kvm_enable_cap.h>
+#include <mv_constants.h>
+#include <shim_vm_t.h>
+
+#include <bsl/convert.hpp>
+#include <bsl/safe_integral.hpp>
+#include <bsl/ut.hpp>
+
+namespace shim
+{
+    /// @brief the size of the dirty rings used by these tests
+    constexpr auto RING_SIZE{0x10000_u64};
+
+    /// <!-- description -->
+    ///   @brief Used to execute the actual checks. We put the checks in this
+    ///     function so that we can validate the tests both at compile-time
+    ///     and at run-time. If a bsl::ut_check fails, the tests will either
+    ///     fail fast at run-time, or will produce a compile-time error.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @return Always returns bsl::exit_success.
+    ///
+    [[nodiscard]] constexpr auto
+    tests() noexcept -> bsl::exit_code
+    {
+        init_tests();
+        constexpr auto handle{&handle_vm_kvm_enable_cap};
+
+        bsl::ut_scenario{"success"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                kvm_enable_cap mut_args{};
+                shim_vm_t mut_vm{};
+                bsl::ut_when{} = [&]() noexcept {
+                    mut_args.cap = bsl::to_u32(KVM_CAP_DIRTY_LOG_RING).get();
+                    mut_args.args[0] = RING_SIZE.get();
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(SHIM_SUCCESS == handle(&mut_args, &mut_vm));
+                        bsl::ut_check(RING_SIZE == mut_vm.dirty_ring_size);
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"hypervisor not detected"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                kvm_enable_cap mut_args{};
+                shim_vm_t mut_vm{};
+                bsl::ut_when{} = [&]() noexcept {
+                    mut_args.cap = bsl::to_u32(KVM_CAP_DIRTY_LOG_RING).get();
+                    mut_args.args[0] = RING_SIZE.get();
+                    g_mut_hypervisor_detected = false;
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(SHIM_FAILURE == handle(&mut_args, &mut_vm));
+                    };
+                    bsl::ut_cleanup{} = [&]() noexcept {
+                        g_mut_hypervisor_detected = true;
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"flags is invalid"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                kvm_enable_cap mut_args{};
+                shim_vm_t mut_vm{};
+                bsl::ut_when{} = [&]() noexcept {
+                    mut_args.cap = bsl::to_u32(KVM_CAP_DIRTY_LOG_RING).get();
+                    mut_args.args[0] = RING_SIZE.get();
+                    mut_args.flags = bsl::safe_u32::magic_1().get();
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(SHIM_FAILURE == handle(&mut_args, &mut_vm));
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"cap is unsupported"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                kvm_enable_cap mut_args{};
+                shim_vm_t mut_vm{};
+                bsl::ut_when{} = [&]() noexcept {
+                    mut_args.cap = bsl::safe_u32::max_value().get();
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(SHIM_FAILURE == handle(&mut_args, &mut_vm));
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"ring size is too small"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                kvm_enable_cap mut_args{};
+                shim_vm_t mut_vm{};
+                bsl::ut_when{} = [&]() noexcept {
+                    mut_args.cap = bsl::to_u32(KVM_CAP_DIRTY_LOG_RING).get();
+                    mut_args.args[0] = RING_SIZE.get();
+                    mut_args.args[0] = bsl::safe_u64::magic_1().get();
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(SHIM_FAILURE == handle(&mut_args, &mut_vm));
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"ring size is too large"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                kvm_enable_cap mut_args{};
+                shim_vm_t mut_vm{};
+                bsl::ut_when{} = [&]() noexcept {
+                    mut_args.cap = bsl::to_u32(KVM_CAP_DIRTY_LOG_RING).get();
+                    mut_args.args[0] = RING_SIZE.get();
+                    mut_args.args[0] = (RING_SIZE << 12_u64).get();
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(SHIM_FAILURE == handle(&mut_args, &mut_vm));
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"ring size is not a power of 2"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                kvm_enable_cap mut_args{};
+                shim_vm_t mut_vm{};
+                bsl::ut_when{} = [&]() noexcept {
+                    mut_args.cap = bsl::to_u32(KVM_CAP_DIRTY_LOG_RING).get();
+                    mut_args.args[0] = RING_SIZE.get();
+                    mut_args.args[0] = (RING_SIZE + HYPERVISOR_PAGE_SIZE).get();
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(SHIM_FAILURE == handle(&mut_args, &mut_vm));
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"ring is already enabled"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                kvm_enable_cap mut_args{};
+                shim_vm_t mut_vm{};
+                bsl::ut_when{} = [&]() noexcept {
+                    mut_args.cap = bsl::to_u32(KVM_CAP_DIRTY_LOG_RING).get();
+                    mut_args.args[0] = RING_SIZE.get();
+                    mut_vm.dirty_ring_size = RING_SIZE.get();
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(SHIM_FAILURE == handle(&mut_args, &mut_vm));
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"vcpu already created"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                kvm_enable_cap mut_args{};
+                shim_vm_t mut_vm{};
+                bsl::ut_when{} = [&]() noexcept {
+                    mut_args.cap = bsl::to_u32(KVM_CAP_DIRTY_LOG_RING).get();
+                    mut_args.args[0] = RING_SIZE.get();
+                    mut_vm.vcpus[0].fd = bsl::safe_u64::magic_1().get();
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(SHIM_FAILURE == handle(&mut_args, &mut_vm));
+                    };
+                };
+            };
+        };
+
+        return fini_tests();
+    }
+}
+
+/// <!-- description -->
+///   @brief Main function for this unit test. If a call to bsl::ut_check() fails
+///     the application will fast fail. If all calls to bsl::ut_check() pass, this
+///     function will successfully return with bsl::exit_success.
+///
+/// <!-- inputs/outputs -->
+///   @return Always returns bsl::exit_success.
+///
+[[nodiscard]] auto
+main() noexcept -> bsl::exit_code
+{
+    bsl::enable_color();
+    return shim::tests();
+}
@@ -24,13 +24,23 @@
 
 #include "../../include/handle_vm_kvm_get_clock.h"
 
+#include <helpers.hpp>
 #include <kvm_clock_data.h>
+#include <mv_constants.h>
 #include <mv_types.h>
+#include <shim_vm_t.h>
 
+#include <bsl/convert.hpp>
+#include <bsl/safe_integral.hpp>
 #include <bsl/ut.hpp>
 
 namespace shim
 {
+    /// @brief the kvmclock used by these tests
+    constexpr auto CLOCK{42_u64};
+    /// @brief the wall clock time used by these tests
+    constexpr auto REALTIME{1000_u64};
+
     /// <!-- description -->
     ///   @brief Used to execute the actual checks. We put the checks in this
     ///     function so that we can validate the tests both at compile-time
@@ -43,18 +53,65 @@ namespace shim
     [[nodiscard]] constexpr auto
     tests() noexcept -> bsl::exit_code
     {
-        bsl::ut_scenario{"description"} = []() noexcept {
+        init_tests();
+        constexpr auto handle{&handle_vm_kvm_get_clock};
+
+        bsl::ut_scenario{"success"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                shim_vm_t const vm{};
+                kvm_clock_data mut_args{};
+                bsl::ut_when{} = [&]() noexcept {
+                    g_mut_val = CLOCK.get();
+                    g_mut_platform_realtime_ns = REALTIME.get();
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(SHIM_SUCCESS == handle(&vm, &mut_args));
+                        bsl::ut_check(CLOCK == mut_args.clock);
+                        bsl::ut_check(REALTIME == mut_args.realtime);
+                        bsl::ut_check(
+                            bsl::to_u32(KVM_CLOCK_TSC_STABLE | KVM_CLOCK_REALTIME) ==
+                            mut_args.flags);
+                    };
+                    bsl::ut_cleanup{} = [&]() noexcept {
+                        g_mut_val = {};
+                        g_mut_platform_realtime_ns = {};
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"hypervisor not detected"} = []() noexcept {
             bsl::ut_given{} = [&]() noexcept {
+                shim_vm_t const vm{};
                 kvm_clock_data mut_args{};
                 bsl::ut_when{} = [&]() noexcept {
+                    g_mut_hypervisor_detected = false;
                     bsl::ut_then{} = [&]() noexcept {
-                        bsl::ut_check(SHIM_SUCCESS == handle_vm_kvm_get_clock(&mut_args));
+                        bsl::ut_check(SHIM_FAILURE == handle(&vm, &mut_args));
+                    };
+                    bsl::ut_cleanup{} = [&]() noexcept {
+                        g_mut_hypervisor_detected = true;
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"mv_vm_op_clock_get fails"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                shim_vm_t const vm{};
+                kvm_clock_data mut_args{};
+                bsl::ut_when{} = [&]() noexcept {
+                    g_mut_mv_vm_op_clock_get = MV_STATUS_FAILURE_UNKNOWN;
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(SHIM_FAILURE == handle(&vm, &mut_args));
+                    };
+                    bsl::ut_cleanup{} = [&]() noexcept {
+                        g_mut_mv_vm_op_clock_get = {};
                     };
                 };
             };
         };
 
-        return bsl::ut_success();
+        return fini_tests();
     }
 }
 
@@ -22,15 +22,37 @@
 /// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 /// SOFTWARE.
 
+
 #include "../../include/handle_vm_kvm_get_dirty_log.h"
 
+#include <handle_vm_kvm_set_user_memory_region.h>
+#include <helpers.hpp>
 #include <kvm_dirty_log.h>
-#include <mv_types.h>
+#include <shim_vm_t.h>
 
+#include <bsl/array.hpp>
+#include <bsl/convert.hpp>
+#include <bsl/safe_integral.hpp>
 #include <bsl/ut.hpp>
 
 namespace shim
 {
+    /// @brief the number of entries in the bitmaps used by these tests
+    constexpr auto BITMAP_SIZE{1024_umx};
+
+    /// <!-- description -->
+    ///   @brief Returns the provided pointer as a userspace address.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param pmut_ptr the pointer to convert
+    ///   @return Returns the provided pointer as a userspace address.
+    ///
+    [[nodiscard]] auto
+    to_user(bsl::uint64 *const pmut_ptr) noexcept -> bsl::uint64
+    {
+        return reinterpret_cast<bsl::uint64>(pmut_ptr);    // NOLINT
+    }
+
     /// <!-- description -->
     ///   @brief Used to execute the actual checks. We put the checks in this
     ///     function so that we can validate the tests both at compile-time
@@ -43,18 +65,157 @@ namespace shim
     [[nodiscard]] constexpr auto
     tests() noexcept -> bsl::exit_code
     {
-        bsl::ut_scenario{"description"} = []() noexcept {
+        init_tests();
+        constexpr auto handle{&handle_vm_kvm_get_dirty_log};
+
+        bsl::ut_scenario{"success"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                kvm_dirty_log mut_args{};
+                shim_vm_t mut_vm{};
+                bsl::array<bsl::uint64, BITMAP_SIZE.get()> mut_bitmap{};
+                constexpr auto size{0x1000_u64};
+                bsl::ut_when{} = [&]() noexcept {
+                    mut_args.dirty_bitmap = to_user(mut_bitmap.data());
+                    mut_vm.slots[0].memory_size = size.get();
+                    mut_vm.slots[0].flags = bsl::to_u32(KVM_MEM_LOG_DIRTY_PAGES).get();
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(SHIM_SUCCESS == handle(&mut_args, &mut_vm));
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"success multiple bitmaps"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                kvm_dirty_log mut_args{};
+                shim_vm_t mut_vm{};
+                bsl::array<bsl::uint64, BITMAP_SIZE.get()> mut_bitmap{};
+                constexpr auto size{0x10000000_u64};
+                bsl::ut_when{} = [&]() noexcept {
+                    mut_args.dirty_bitmap = to_user(mut_bitmap.data());
+                    mut_vm.slots[0].memory_size = size.get();
+                    mut_vm.slots[0].flags = bsl::to_u32(KVM_MEM_LOG_DIRTY_PAGES).get();
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(SHIM_SUCCESS == handle(&mut_args, &mut_vm));
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"hypervisor not detected"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                kvm_dirty_log mut_args{};
+                shim_vm_t mut_vm{};
+                bsl::array<bsl::uint64, BITMAP_SIZE.get()> mut_bitmap{};
+                constexpr auto size{0x1000_u64};
+                bsl::ut_when{} = [&]() noexcept {
+                    mut_args.dirty_bitmap = to_user(mut_bitmap.data());
+                    mut_vm.slots[0].memory_size = size.get();
+                    mut_vm.slots[0].flags = bsl::to_u32(KVM_MEM_LOG_DIRTY_PAGES).get();
+                    g_mut_hypervisor_detected = false;
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(SHIM_FAILURE == handle(&mut_args, &mut_vm));
+                    };
+                    bsl::ut_cleanup{} = [&]() noexcept {
+                        g_mut_hypervisor_detected = true;
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"slot out of bounds"} = []() noexcept {
             bsl::ut_given{} = [&]() noexcept {
                 kvm_dirty_log mut_args{};
+                shim_vm_t mut_vm{};
+                bsl::array<bsl::uint64, BITMAP_SIZE.get()> mut_bitmap{};
+                constexpr auto size{0x1000_u64};
                 bsl::ut_when{} = [&]() noexcept {
+                    mut_args.dirty_bitmap = to_user(mut_bitmap.data());
+                    mut_vm.slots[0].memory_size = size.get();
+                    mut_vm.slots[0].flags = bsl::to_u32(KVM_MEM_LOG_DIRTY_PAGES).get();
+                    mut_args.slot = bsl::to_u32(MICROV_MAX_SLOTS).get();
                     bsl::ut_then{} = [&]() noexcept {
-                        bsl::ut_check(SHIM_SUCCESS == handle_vm_kvm_get_dirty_log(&mut_args));
+                        bsl::ut_check(SHIM_FAILURE == handle(&mut_args, &mut_vm));
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"dirty_bitmap is NULL"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                kvm_dirty_log mut_args{};
+                shim_vm_t mut_vm{};
+                bsl::array<bsl::uint64, BITMAP_SIZE.get()> mut_bitmap{};
+                constexpr auto size{0x1000_u64};
+                bsl::ut_when{} = [&]() noexcept {
+                    mut_vm.slots[0].memory_size = size.get();
+                    mut_vm.slots[0].flags = bsl::to_u32(KVM_MEM_LOG_DIRTY_PAGES).get();
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(SHIM_FAILURE == handle(&mut_args, &mut_vm));
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"slot is not dirty logged"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                kvm_dirty_log mut_args{};
+                shim_vm_t mut_vm{};
+                bsl::array<bsl::uint64, BITMAP_SIZE.get()> mut_bitmap{};
+                constexpr auto size{0x1000_u64};
+                bsl::ut_when{} = [&]() noexcept {
+                    mut_args.dirty_bitmap = to_user(mut_bitmap.data());
+                    mut_vm.slots[0].memory_size = size.get();
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(SHIM_FAILURE == handle(&mut_args, &mut_vm));
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"mv_vm_op_dirty_log_get fails"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                kvm_dirty_log mut_args{};
+                shim_vm_t mut_vm{};
+                bsl::array<bsl::uint64, BITMAP_SIZE.get()> mut_bitmap{};
+                constexpr auto size{0x1000_u64};
+                bsl::ut_when{} = [&]() noexcept {
+                    mut_args.dirty_bitmap = to_user(mut_bitmap.data());
+                    mut_vm.slots[0].memory_size = size.get();
+                    mut_vm.slots[0].flags = bsl::to_u32(KVM_MEM_LOG_DIRTY_PAGES).get();
+                    g_mut_mv_vm_op_dirty_log_get = bsl::safe_u64::magic_1().get();
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(SHIM_FAILURE == handle(&mut_args, &mut_vm));
+                    };
+                    bsl::ut_cleanup{} = [&]() noexcept {
+                        g_mut_mv_vm_op_dirty_log_get = {};
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"mv_vm_op_dirty_log_clear fails"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                kvm_dirty_log mut_args{};
+                shim_vm_t mut_vm{};
+                bsl::array<bsl::uint64, BITMAP_SIZE.get()> mut_bitmap{};
+                constexpr auto size{0x1000_u64};
+                bsl::ut_when{} = [&]() noexcept {
+                    mut_args.dirty_bitmap = to_user(mut_bitmap.data());
+                    mut_vm.slots[0].memory_size = size.get();
+                    mut_vm.slots[0].flags = bsl::to_u32(KVM_MEM_LOG_DIRTY_PAGES).get();
+                    g_mut_mv_vm_op_dirty_log_clear = bsl::safe_u64::magic_1().get();
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(SHIM_FAILURE == handle(&mut_args, &mut_vm));
+                    };
+                    bsl::ut_cleanup{} = [&]() noexcept {
+                        g_mut_mv_vm_op_dirty_log_clear = {};
                     };
                 };
             };
         };
 
-        return bsl::ut_success();
+        return fini_tests();
     }
 }
 
@@ -0,0 +1,193 @@
+/// @copyright
+/// Copyright (C) 2020 Assured Information Security, Inc.
+///
+/// @copyright
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// @copyright
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// @copyright
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+
+#include "../../include/handle_vm_kvm_reset_dirty_rings.h"
+
+#include <helpers.hpp>
+#include <kvm_dirty_gfn.h>
+#include <mv_types.h>
+#include <shim_vm_t.h>
+
+#include <bsl/array.hpp>
+#include <bsl/convert.hpp>
+#include <bsl/safe_idx.hpp>
+#include <bsl/safe_integral.hpp>
+#include <bsl/ut.hpp>
+
+namespace shim
+{
+    /// @brief the number of entries in the dirty rings used by these tests
+    constexpr auto RING_ENTRIES{512_umx};
+
+    /// <!-- description -->
+    ///   @brief Marks every entry in the provided dirty ring as harvested.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param mut_ring the dirty ring to mark
+    ///
+    constexpr void
+    mark_harvested(bsl::array<kvm_dirty_gfn, RING_ENTRIES.get()> &mut_ring) noexcept
+    {
+        for (bsl::safe_idx mut_i{}; mut_i < mut_ring.size(); ++mut_i) {
+            mut_ring.at_if(mut_i)->flags = KVM_DIRTY_GFN_F_DIRTY | KVM_DIRTY_GFN_F_RESET;
+        }
+    }
+
+    /// <!-- description -->
+    ///   @brief Used to execute the actual checks. We put the checks in this
+    ///     function so that we can validate the tests both at compile-time
+    ///     and at run-time. If a bsl::ut_check fails, the tests will either
+    ///     fail fast at run-time, or will produce a compile-time error.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @return Always returns bsl::exit_success.
+    ///
+    [[nodiscard]] constexpr auto
+    tests() noexcept -> bsl::exit_code
+    {
+        init_tests();
+        constexpr auto handle{&handle_vm_kvm_reset_dirty_rings};
+
+        bsl::ut_scenario{"success"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                shim_vm_t mut_vm{};
+                bsl::safe_u32 mut_ret{};
+                bsl::array<kvm_dirty_gfn, RING_ENTRIES.get()> mut_ring{};
+                bsl::ut_when{} = [&]() noexcept {
+                    mut_vm.dirty_ring_size = mut_ring.size_bytes().get();
+                    mut_vm.vcpus[0].dirty_ring = mut_ring.data();
+                    mut_vm.vcpus[0].dirty_index = mut_ring.size().get();
+                    mark_harvested(mut_ring);
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(SHIM_SUCCESS == handle(&mut_vm, mut_ret.data()));
+                        bsl::ut_check(bsl::to_u32(RING_ENTRIES) == mut_ret);
+                        bsl::ut_check(mut_ring.size() == mut_vm.vcpus[0].reset_index);
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"success nothing harvested"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                shim_vm_t mut_vm{};
+                bsl::safe_u32 mut_ret{};
+                bsl::array<kvm_dirty_gfn, RING_ENTRIES.get()> mut_ring{};
+                bsl::ut_when{} = [&]() noexcept {
+                    mut_vm.dirty_ring_size = mut_ring.size_bytes().get();
+                    mut_vm.vcpus[0].dirty_ring = mut_ring.data();
+                    mut_vm.vcpus[0].dirty_index = mut_ring.size().get();
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(SHIM_SUCCESS == handle(&mut_vm, mut_ret.data()));
+                        bsl::ut_check(mut_ret.is_zero());
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"success without rings"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                shim_vm_t mut_vm{};
+                bsl::safe_u32 mut_ret{};
+                bsl::array<kvm_dirty_gfn, RING_ENTRIES.get()> mut_ring{};
+                bsl::ut_when{} = [&]() noexcept {
+                    mut_vm.dirty_ring_size = mut_ring.size_bytes().get();
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(SHIM_SUCCESS == handle(&mut_vm, mut_ret.data()));
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"hypervisor not detected"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                shim_vm_t mut_vm{};
+                bsl::safe_u32 mut_ret{};
+                bsl::array<kvm_dirty_gfn, RING_ENTRIES.get()> mut_ring{};
+                bsl::ut_when{} = [&]() noexcept {
+                    mut_vm.dirty_ring_size = mut_ring.size_bytes().get();
+                    mut_vm.vcpus[0].dirty_ring = mut_ring.data();
+                    mut_vm.vcpus[0].dirty_index = mut_ring.size().get();
+                    mark_harvested(mut_ring);
+                    g_mut_hypervisor_detected = false;
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(SHIM_FAILURE == handle(&mut_vm, mut_ret.data()));
+                    };
+                    bsl::ut_cleanup{} = [&]() noexcept {
+                        g_mut_hypervisor_detected = true;
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"dirty ring is not enabled"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                shim_vm_t mut_vm{};
+                bsl::safe_u32 mut_ret{};
+                bsl::ut_when{} = [&]() noexcept {
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(SHIM_FAILURE == handle(&mut_vm, mut_ret.data()));
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"mv_vm_op_dirty_ring_reset fails"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                shim_vm_t mut_vm{};
+                bsl::safe_u32 mut_ret{};
+                bsl::array<kvm_dirty_gfn, RING_ENTRIES.get()> mut_ring{};
+                bsl::ut_when{} = [&]() noexcept {
+                    mut_vm.dirty_ring_size = mut_ring.size_bytes().get();
+                    mut_vm.vcpus[0].dirty_ring = mut_ring.data();
+                    mut_vm.vcpus[0].dirty_index = mut_ring.size().get();
+                    mark_harvested(mut_ring);
+                    g_mut_mv_vm_op_dirty_ring_reset = MV_STATUS_FAILURE_UNKNOWN;
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(SHIM_FAILURE == handle(&mut_vm, mut_ret.data()));
+                    };
+                    bsl::ut_cleanup{} = [&]() noexcept {
+                        g_mut_mv_vm_op_dirty_ring_reset = {};
+                    };
+                };
+            };
+        };
+
+        return fini_tests();
+    }
+}
+
+/// <!-- description -->
+///   @brief Main function for this unit test. If a call to bsl::ut_check() fails
+///     the application will fast fail. If all calls to bsl::ut_check() pass, this
+///     function will successfully return with bsl::exit_success.
+///
+/// <!-- inputs/outputs -->
+///   @return Always returns bsl::exit_success.
+///
+[[nodiscard]] auto
+main() noexcept -> bsl::exit_code
+{
+    bsl::enable_color();
+    return shim::tests();
+}
@@ -24,13 +24,23 @@
 
 #include "../../include/handle_vm_kvm_set_clock.h"
 
+#include <helpers.hpp>
 #include <kvm_clock_data.h>
+#include <mv_constants.h>
 #include <mv_types.h>
+#include <shim_vm_t.h>
 
+#include <bsl/convert.hpp>
+#include <bsl/safe_integral.hpp>
 #include <bsl/ut.hpp>
 
 namespace shim
 {
+    /// @brief the kvmclock used by these tests
+    constexpr auto CLOCK{42_u64};
+    /// @brief the wall clock time used by these tests
+    constexpr auto REALTIME{1000_u64};
+
     /// <!-- description -->
     ///   @brief Used to execute the actual checks. We put the checks in this
     ///     function so that we can validate the tests both at compile-time
@@ -43,18 +53,102 @@ namespace shim
     [[nodiscard]] constexpr auto
     tests() noexcept -> bsl::exit_code
     {
-        bsl::ut_scenario{"description"} = []() noexcept {
+        init_tests();
+        constexpr auto handle{&handle_vm_kvm_set_clock};
+
+        bsl::ut_scenario{"success"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                shim_vm_t const vm{};
+                kvm_clock_data mut_args{};
+                bsl::ut_when{} = [&]() noexcept {
+                    mut_args.clock = CLOCK.get();
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(SHIM_SUCCESS == handle(&mut_args, &vm));
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"success with realtime"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                shim_vm_t const vm{};
+                kvm_clock_data mut_args{};
+                bsl::ut_when{} = [&]() noexcept {
+                    mut_args.clock = CLOCK.get();
+                    mut_args.flags = KVM_CLOCK_REALTIME;
+                    mut_args.realtime = REALTIME.get();
+                    g_mut_platform_realtime_ns = (REALTIME + REALTIME).checked().get();
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(SHIM_SUCCESS == handle(&mut_args, &vm));
+                    };
+                    bsl::ut_cleanup{} = [&]() noexcept {
+                        g_mut_platform_realtime_ns = {};
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"success with realtime in the future"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                shim_vm_t const vm{};
+                kvm_clock_data mut_args{};
+                bsl::ut_when{} = [&]() noexcept {
+                    mut_args.clock = CLOCK.get();
+                    mut_args.flags = KVM_CLOCK_REALTIME;
+                    mut_args.realtime = REALTIME.get();
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(SHIM_SUCCESS == handle(&mut_args, &vm));
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"invalid flags"} = []() noexcept {
             bsl::ut_given{} = [&]() noexcept {
+                shim_vm_t const vm{};
                 kvm_clock_data mut_args{};
                 bsl::ut_when{} = [&]() noexcept {
+                    mut_args.flags = ~KVM_CLOCK_VALID_FLAGS;
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(SHIM_FAILURE == handle(&mut_args, &vm));
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"hypervisor not detected"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                shim_vm_t const vm{};
+                kvm_clock_data const args{};
+                bsl::ut_when{} = [&]() noexcept {
+                    g_mut_hypervisor_detected = false;
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(SHIM_FAILURE == handle(&args, &vm));
+                    };
+                    bsl::ut_cleanup{} = [&]() noexcept {
+                        g_mut_hypervisor_detected = true;
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"mv_vm_op_clock_set fails"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                shim_vm_t const vm{};
+                kvm_clock_data const args{};
+                bsl::ut_when{} = [&]() noexcept {
+                    g_mut_mv_vm_op_clock_set = MV_STATUS_FAILURE_UNKNOWN;
                     bsl::ut_then{} = [&]() noexcept {
-                        bsl::ut_check(SHIM_SUCCESS == handle_vm_kvm_set_clock(&mut_args));
+                        bsl::ut_check(SHIM_FAILURE == handle(&args, &vm));
+                    };
+                    bsl::ut_cleanup{} = [&]() noexcept {
+                        g_mut_mv_vm_op_clock_set = {};
                     };
                 };
             };
         };
 
-        return bsl::ut_success();
+        return fini_tests();
     }
 }
 
@@ -121,6 +121,49 @@ namespace shim
             };
         };
 
+        bsl::ut_scenario{"success with dirty logging"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                kvm_userspace_memory_region mut_args{};
+                shim_vm_t mut_vm{};
+                constexpr auto gpa{0x0_u64};
+                constexpr auto size{0x8000_umx};
+                constexpr auto addr{0x1000_u64};
+                bsl::ut_when{} = [&]() noexcept {
+                    mut_args.guest_phys_addr = gpa.get();
+                    mut_args.memory_size = size.get();
+                    mut_args.userspace_addr = addr.get();
+                    mut_args.flags = bsl::to_u32(KVM_MEM_LOG_DIRTY_PAGES).get();
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(SHIM_SUCCESS == handle(&mut_args, &mut_vm));
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"mv_vm_op_dirty_log_enable fails"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                kvm_userspace_memory_region mut_args{};
+                shim_vm_t mut_vm{};
+                constexpr auto gpa{0x0_u64};
+                constexpr auto size{0x8000_umx};
+                constexpr auto addr{0x1000_u64};
+                bsl::ut_when{} = [&]() noexcept {
+                    mut_args.guest_phys_addr = gpa.get();
+                    mut_args.memory_size = size.get();
+                    mut_args.userspace_addr = addr.get();
+                    mut_args.flags = bsl::to_u32(KVM_MEM_LOG_DIRTY_PAGES).get();
+                    g_mut_mv_vm_op_dirty_log_enable = bsl::safe_u64::magic_1().get();
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(SHIM_FAILURE == handle(&mut_args, &mut_vm));
+                        bsl::ut_check(bsl::safe_u64::magic_0() == mut_vm.slots[0].memory_size);
+                    };
+                    bsl::ut_cleanup{} = [&]() noexcept {
+                        g_mut_mv_vm_op_dirty_log_enable = {};
+                    };
+                };
+            };
+        };
+
         bsl::ut_scenario{"hypervisor not detected"} = []() noexcept {
             bsl::ut_given{} = [&]() noexcept {
                 kvm_userspace_memory_region mut_args{};
@@ -344,126 +387,6 @@ namespace shim
             };
         };
 
-        bsl::ut_scenario{"g_mut_platform_mlock fails"} = []() noexcept {
-            bsl::ut_given{} = [&]() noexcept {
-                kvm_userspace_memory_region mut_args{};
-                shim_vm_t mut_vm{};
-                constexpr auto gpa{0x0_u64};
-                constexpr auto size{0x1000_umx};
-                constexpr auto addr{0x1000_u64};
-                bsl::ut_when{} = [&]() noexcept {
-                    mut_args.guest_phys_addr = gpa.get();
-                    mut_args.memory_size = size.get();
-                    mut_args.userspace_addr = addr.get();
-                    g_mut_platform_mlock = SHIM_FAILURE;
-                    bsl::ut_then{} = [&]() noexcept {
-                        bsl::ut_check(SHIM_FAILURE == handle(&mut_args, &mut_vm));
-                    };
-                    bsl::ut_cleanup{} = [&]() noexcept {
-                        g_mut_platform_mlock = SHIM_SUCCESS;
-                    };
-                };
-            };
-        };
-
-        bsl::ut_scenario{"platform_virt_to_phys_user fails"} = []() noexcept {
-            bsl::ut_given{} = [&]() noexcept {
-                kvm_userspace_memory_region mut_args{};
-                shim_vm_t mut_vm{};
-                constexpr auto gpa{0x0_u64};
-                constexpr auto size{0x80000_umx};
-                constexpr auto addr{0x1000_u64};
-                bsl::ut_when{} = [&]() noexcept {
-                    mut_args.guest_phys_addr = gpa.get();
-                    mut_args.memory_size = size.get();
-                    mut_args.userspace_addr = addr.get();
-                    g_mut_platform_virt_to_phys_user_fails = true;
-                    bsl::ut_then{} = [&]() noexcept {
-                        bsl::ut_check(SHIM_FAILURE == handle(&mut_args, &mut_vm));
-                    };
-                    bsl::ut_cleanup{} = [&]() noexcept {
-                        g_mut_platform_virt_to_phys_user_fails = false;
-                    };
-                };
-            };
-        };
-
-        bsl::ut_scenario{"mv_vm_op_mmio_map fails"} = []() noexcept {
-            bsl::ut_given{} = [&]() noexcept {
-                kvm_userspace_memory_region mut_args{};
-                shim_vm_t mut_vm{};
-                constexpr auto gpa{0x0_u64};
-                constexpr auto size{0x80000_umx};
-                constexpr auto addr{0x1000_u64};
-                bsl::ut_when{} = [&]() noexcept {
-                    mut_args.guest_phys_addr = gpa.get();
-                    mut_args.memory_size = size.get();
-                    mut_args.userspace_addr = addr.get();
-                    g_mut_mv_vm_op_mmio_map = bsl::safe_u64::magic_1().get();
-                    bsl::ut_then{} = [&]() noexcept {
-                        bsl::ut_check(SHIM_FAILURE == handle(&mut_args, &mut_vm));
-                    };
-                };
-            };
-        };
-
-        bsl::ut_scenario{"mv_vm_op_mmio_map fails"} = []() noexcept {
-            bsl::ut_given{} = [&]() noexcept {
-                kvm_userspace_memory_region mut_args{};
-                shim_vm_t mut_vm{};
-                constexpr auto gpa{0x0_u64};
-                constexpr auto size{0x1000_umx};
-                constexpr auto addr{0x1000_u64};
-                bsl::ut_when{} = [&]() noexcept {
-                    mut_args.guest_phys_addr = gpa.get();
-                    mut_args.memory_size = size.get();
-                    mut_args.userspace_addr = addr.get();
-                    g_mut_mv_vm_op_mmio_map = bsl::safe_u64::magic_1().get();
-                    bsl::ut_then{} = [&]() noexcept {
-                        bsl::ut_check(SHIM_FAILURE == handle(&mut_args, &mut_vm));
-                    };
-                };
-            };
-        };
-
-        bsl::ut_scenario{"mv_vm_op_mmio_map fails multiple mdls #1"} = []() noexcept {
-            bsl::ut_given{} = [&]() noexcept {
-                kvm_userspace_memory_region mut_args{};
-                shim_vm_t mut_vm{};
-                constexpr auto gpa{0x0_u64};
-                constexpr auto size{0x7D000_umx};
-                constexpr auto addr{0x1000_u64};
-                bsl::ut_when{} = [&]() noexcept {
-                    mut_args.guest_phys_addr = gpa.get();
-                    mut_args.memory_size = size.get();
-                    mut_args.userspace_addr = addr.get();
-                    g_mut_mv_vm_op_mmio_map = bsl::safe_u64::magic_1().get();
-                    bsl::ut_then{} = [&]() noexcept {
-                        bsl::ut_check(SHIM_FAILURE == handle(&mut_args, &mut_vm));
-                    };
-                };
-            };
-        };
-
-        bsl::ut_scenario{"mv_vm_op_mmio_map fails multiple mdls #2"} = []() noexcept {
-            bsl::ut_given{} = [&]() noexcept {
-                kvm_userspace_memory_region mut_args{};
-                shim_vm_t mut_vm{};
-                constexpr auto gpa{0x0_u64};
-                constexpr auto size{0x80000_umx};
-                constexpr auto addr{0x1000_u64};
-                bsl::ut_when{} = [&]() noexcept {
-                    mut_args.guest_phys_addr = gpa.get();
-                    mut_args.memory_size = size.get();
-                    mut_args.userspace_addr = addr.get();
-                    g_mut_mv_vm_op_mmio_map = bsl::safe_u64::magic_1().get();
-                    bsl::ut_then{} = [&]() noexcept {
-                        bsl::ut_check(SHIM_FAILURE == handle(&mut_args, &mut_vm));
-                    };
-                };
-            };
-        };
-
         return fini_tests();
     }
 }
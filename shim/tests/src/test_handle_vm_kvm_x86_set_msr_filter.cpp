@@ -0,0 +1,275 @@
+/// @copyright
+/// Copyright (C) 2020 Assured Information Security, Inc.
+///
+/// @copyright
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// @copyright
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// @copyright
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+
+#include "../../include/handle_vm_kvm_x86_set_msr_filter.h"
+
+#include <helpers.hpp>
+#include <kvm_msr_filter.h>
+#include <mv_types.h>
+#include <shim_vm_t.h>
+
+#include <bsl/array.hpp>
+#include <bsl/convert.hpp>
+#include <bsl/safe_integral.hpp>
+#include <bsl/ut.hpp>
+
+namespace shim
+{
+    /// @brief the number of MSRs in the ranges used by these tests
+    constexpr auto NMSRS{64_u32};
+    /// @brief the first MSR of the ranges used by these tests
+    constexpr auto BASE{0xC0000080_u32};
+    /// @brief the size of the bitmaps used by these tests
+    constexpr auto BITMAP_SIZE{8_umx};
+
+    /// <!-- description -->
+    ///   @brief Returns a filter with a single range that uses the
+    ///     provided bitmap.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param bitmap the bitmap to use
+    ///   @return Returns a filter with a single range.
+    ///
+    [[nodiscard]] auto
+    make_filter(bsl::array<bsl::uint8, BITMAP_SIZE.get()> const &bitmap) noexcept -> kvm_msr_filter
+    {
+        kvm_msr_filter mut_filter{};
+
+        mut_filter.ranges[0].flags = KVM_MSR_FILTER_READ | KVM_MSR_FILTER_WRITE;
+        mut_filter.ranges[0].nmsrs = NMSRS.get();
+        mut_filter.ranges[0].base = BASE.get();
+        mut_filter.ranges[0].bitmap = reinterpret_cast<bsl::uint64>(bitmap.data());    // NOLINT
+
+        return mut_filter;
+    }
+
+    /// <!-- description -->
+    ///   @brief Used to execute the actual checks. We put the checks in this
+    ///     function so that we can validate the tests both at compile-time
+    ///     and at run-time. If a bsl::ut_check fails, the tests will either
+    ///     fail fast at run-time, or will produce a compile-time error.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @return Always returns bsl::exit_success.
+    ///
+    [[nodiscard]] constexpr auto
+    tests() noexcept -> bsl::exit_code
+    {
+        init_tests();
+        constexpr auto handle{&handle_vm_kvm_x86_set_msr_filter};
+
+        bsl::ut_scenario{"success"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                shim_vm_t mut_vm{};
+                kvm_msr_filter const empty{};
+                bsl::array<bsl::uint8, BITMAP_SIZE.get()> mut_bitmap{};
+                bsl::ut_when{} = [&]() noexcept {
+                    *mut_bitmap.front_if() = 0x0F_u8.get();
+                    auto const filter{make_filter(mut_bitmap)};
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(SHIM_SUCCESS == handle(&filter, &mut_vm));
+                        bsl::ut_check(nullptr != mut_vm.msr_filter_bitmaps[0]);
+                        bsl::ut_check(NMSRS == mut_vm.msr_filter.ranges[0].nmsrs);
+                    };
+                    bsl::ut_cleanup{} = [&]() noexcept {
+                        bsl::ut_check(SHIM_SUCCESS == handle(&empty, &mut_vm));
+                        bsl::ut_check(nullptr == mut_vm.msr_filter_bitmaps[0]);
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"success replacing a filter"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                shim_vm_t mut_vm{};
+                kvm_msr_filter const empty{};
+                bsl::array<bsl::uint8, BITMAP_SIZE.get()> mut_bitmap{};
+                bsl::ut_when{} = [&]() noexcept {
+                    auto const filter{make_filter(mut_bitmap)};
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(SHIM_SUCCESS == handle(&filter, &mut_vm));
+                        bsl::ut_check(SHIM_SUCCESS == handle(&filter, &mut_vm));
+                        bsl::ut_check(nullptr != mut_vm.msr_filter_bitmaps[0]);
+                    };
+                    bsl::ut_cleanup{} = [&]() noexcept {
+                        bsl::ut_check(SHIM_SUCCESS == handle(&empty, &mut_vm));
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"hypervisor not detected"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                shim_vm_t mut_vm{};
+                bsl::array<bsl::uint8, BITMAP_SIZE.get()> mut_bitmap{};
+                bsl::ut_when{} = [&]() noexcept {
+                    auto const filter{make_filter(mut_bitmap)};
+                    g_mut_hypervisor_detected = false;
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(SHIM_FAILURE == handle(&filter, &mut_vm));
+                    };
+                    bsl::ut_cleanup{} = [&]() noexcept {
+                        g_mut_hypervisor_detected = true;
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"default deny is unsupported"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                shim_vm_t mut_vm{};
+                bsl::array<bsl::uint8, BITMAP_SIZE.get()> mut_bitmap{};
+                bsl::ut_when{} = [&]() noexcept {
+                    auto mut_filter{make_filter(mut_bitmap)};
+                    mut_filter.flags = KVM_MSR_FILTER_DEFAULT_DENY;
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(SHIM_FAILURE == handle(&mut_filter, &mut_vm));
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"range flags are invalid"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                shim_vm_t mut_vm{};
+                bsl::array<bsl::uint8, BITMAP_SIZE.get()> mut_bitmap{};
+                bsl::ut_when{} = [&]() noexcept {
+                    auto mut_filter{make_filter(mut_bitmap)};
+                    mut_filter.ranges[0].flags = 0x4_u32.get();
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(SHIM_FAILURE == handle(&mut_filter, &mut_vm));
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"range flags are missing"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                shim_vm_t mut_vm{};
+                bsl::array<bsl::uint8, BITMAP_SIZE.get()> mut_bitmap{};
+                bsl::ut_when{} = [&]() noexcept {
+                    auto mut_filter{make_filter(mut_bitmap)};
+                    mut_filter.ranges[0].flags = {};
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(SHIM_FAILURE == handle(&mut_filter, &mut_vm));
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"range nmsrs is too large"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                shim_vm_t mut_vm{};
+                bsl::array<bsl::uint8, BITMAP_SIZE.get()> mut_bitmap{};
+                bsl::ut_when{} = [&]() noexcept {
+                    auto mut_filter{make_filter(mut_bitmap)};
+                    mut_filter.ranges[0].nmsrs = 0x10000_u32.get();
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(SHIM_FAILURE == handle(&mut_filter, &mut_vm));
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"range is out of bounds"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                shim_vm_t mut_vm{};
+                bsl::array<bsl::uint8, BITMAP_SIZE.get()> mut_bitmap{};
+                bsl::ut_when{} = [&]() noexcept {
+                    auto mut_filter{make_filter(mut_bitmap)};
+                    mut_filter.ranges[0].base = 0xFFFFFFF0_u32.get();
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(SHIM_FAILURE == handle(&mut_filter, &mut_vm));
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"range bitmap is NULL"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                shim_vm_t mut_vm{};
+                bsl::array<bsl::uint8, BITMAP_SIZE.get()> mut_bitmap{};
+                bsl::ut_when{} = [&]() noexcept {
+                    auto mut_filter{make_filter(mut_bitmap)};
+                    mut_filter.ranges[0].bitmap = {};
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(SHIM_FAILURE == handle(&mut_filter, &mut_vm));
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"platform_alloc fails"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                shim_vm_t mut_vm{};
+                bsl::array<bsl::uint8, BITMAP_SIZE.get()> mut_bitmap{};
+                bsl::ut_when{} = [&]() noexcept {
+                    auto const filter{make_filter(mut_bitmap)};
+                    g_mut_platform_alloc_fails = true;
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(SHIM_FAILURE == handle(&filter, &mut_vm));
+                    };
+                    bsl::ut_cleanup{} = [&]() noexcept {
+                        g_mut_platform_alloc_fails = false;
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"mv_vm_op_msr_filter fails"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                shim_vm_t mut_vm{};
+                bsl::array<bsl::uint8, BITMAP_SIZE.get()> mut_bitmap{};
+                bsl::ut_when{} = [&]() noexcept {
+                    auto const filter{make_filter(mut_bitmap)};
+                    g_mut_mv_vm_op_msr_filter = MV_STATUS_FAILURE_UNKNOWN;
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(SHIM_FAILURE == handle(&filter, &mut_vm));
+                        bsl::ut_check(nullptr == mut_vm.msr_filter_bitmaps[0]);
+                    };
+                    bsl::ut_cleanup{} = [&]() noexcept {
+                        g_mut_mv_vm_op_msr_filter = {};
+                    };
+                };
+            };
+        };
+
+        return fini_tests();
+    }
+}
+
+/// <!-- description -->
+///   @brief Main function for this unit test. If a call to bsl::ut_check() fails
+///     the application will fast fail. If all calls to bsl::ut_check() pass, this
+///     function will successfully return with bsl::exit_success.
+///
+/// <!-- inputs/outputs -->
+///   @return Always returns bsl::exit_success.
+///
+[[nodiscard]] auto
+main() noexcept -> bsl::exit_code
+{
+    bsl::enable_color();
+    return shim::tests();
+}
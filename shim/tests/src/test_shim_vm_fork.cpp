@@ -0,0 +1,513 @@
+/// @copyright
+/// Copyright (C) 2020 Assured Information Security, Inc.
+///
+/// @copyright
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// @copyright
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// @copyright
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+
+
+#include "../../include/shim_vm_fork.h"
+
+#include <handle_vm_kvm_set_user_memory_region.h>
+#include <helpers.hpp>
+#include <mv_constants.h>
+#include <mv_types.h>
+#include <platform.h>
+#include <shim_vm_t.h>
+
+#include <bsl/array.hpp>
+#include <bsl/convert.hpp>
+#include <bsl/safe_integral.hpp>
+#include <bsl/ut.hpp>
+
+namespace shim
+{
+    /// @brief the guest physical address of the slot used by the tests
+    constexpr auto SLOT_GPA{0x0_u64};
+    /// @brief the size of the slot used by the tests
+    constexpr auto SLOT_SIZE{0x400000_u64};
+    /// @brief the userspace address of the slot used by the tests
+    constexpr auto SLOT_ADDR{0x1000_u64};
+
+    /// <!-- description -->
+    ///   @brief Gives the provided VM the slot that is used by the tests.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param pmut_vm the VM to give the slot to
+    ///
+    constexpr void
+    init_slot(shim_vm_t *const pmut_vm) noexcept
+    {
+        pmut_vm->slots[0].guest_phys_addr = SLOT_GPA.get();
+        pmut_vm->slots[0].memory_size = SLOT_SIZE.get();
+        pmut_vm->slots[0].userspace_addr = SLOT_ADDR.get();
+    }
+
+    /// <!-- description -->
+    ///   @brief Frees the bitmaps that a successful fork gave the
+    ///     provided VM.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param pmut_vm the VM to free the bitmaps of
+    ///
+    constexpr void
+    free_bitmaps(shim_vm_t *const pmut_vm) noexcept
+    {
+        auto const bytes{shim_vm_populated_size(&pmut_vm->slots[0])};
+        platform_free(pmut_vm->populated[0], bytes);
+        platform_free(pmut_vm->shared[0], bytes);
+    }
+
+    /// <!-- description -->
+    ///   @brief Used to execute the actual checks. We put the checks in this
+    ///     function so that we can validate the tests both at compile-time
+    ///     and at run-time. If a bsl::ut_check fails, the tests will either
+    ///     fail fast at run-time, or will produce a compile-time error.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @return Always returns bsl::exit_success.
+    ///
+    [[nodiscard]] constexpr auto
+    tests() noexcept -> bsl::exit_code
+    {
+        init_tests();
+        constexpr auto handle{&shim_vm_fork};
+
+        bsl::ut_scenario{"hypervisor not detected"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                shim_vm_t mut_vm{};
+                shim_vm_t mut_parent{};
+                bsl::ut_when{} = [&]() noexcept {
+                    g_mut_hypervisor_detected = false;
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(SHIM_FAILURE == handle(&mut_vm, &mut_parent));
+                    };
+                    bsl::ut_cleanup{} = [&]() noexcept {
+                        g_mut_hypervisor_detected = true;
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"fork from itself"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                shim_vm_t mut_vm{};
+                bsl::ut_then{} = [&]() noexcept {
+                    bsl::ut_check(SHIM_FAILURE == handle(&mut_vm, &mut_vm));
+                };
+            };
+        };
+
+        bsl::ut_scenario{"success"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                shim_vm_t mut_vm{};
+                shim_vm_t mut_parent{};
+                constexpr auto vmid{42_u16};
+                bsl::uint64 mut_populated{0x3_u64.get()};
+                bsl::ut_when{} = [&]() noexcept {
+                    init_slot(&mut_vm);
+                    init_slot(&mut_parent);
+                    mut_parent.populated[0] = &mut_populated;
+                    g_mut_mv_vm_op_fork_vm = vmid.get();
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(SHIM_SUCCESS == handle(&mut_vm, &mut_parent));
+                        bsl::ut_check(vmid == mut_vm.vmid);
+                        bsl::ut_check(vmid == mut_vm.id);
+                        bsl::ut_check(0x3_u64 == *mut_vm.populated[0]);
+                        bsl::ut_check(0x3_u64 == *mut_vm.shared[0]);
+                        bsl::ut_check(&mut_parent == mut_vm.parent);
+                        bsl::ut_check(nullptr == mut_vm.sibling);
+                        bsl::ut_check(&mut_vm == mut_parent.children);
+                    };
+                    bsl::ut_cleanup{} = [&]() noexcept {
+                        g_mut_mv_vm_op_fork_vm = {};
+                        free_bitmaps(&mut_vm);
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"success with dirty logging"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                shim_vm_t mut_vm{};
+                shim_vm_t mut_parent{};
+                bsl::uint64 mut_populated{0x2_u64.get()};
+                bsl::ut_when{} = [&]() noexcept {
+                    init_slot(&mut_vm);
+                    init_slot(&mut_parent);
+                    mut_vm.slots[0].flags = bsl::to_u32(KVM_MEM_LOG_DIRTY_PAGES).get();
+                    mut_parent.populated[0] = &mut_populated;
+                    g_mut_mv_vm_op_dirty_log_enable = bsl::safe_u64::magic_2().get();
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(SHIM_SUCCESS == handle(&mut_vm, &mut_parent));
+                        bsl::ut_check(bsl::safe_u64::magic_1() == g_mut_mv_vm_op_dirty_log_enable);
+                        bsl::ut_check(0x2_u64 == *mut_vm.populated[0]);
+                        bsl::ut_check(0x2_u64 == *mut_vm.shared[0]);
+                    };
+                    bsl::ut_cleanup{} = [&]() noexcept {
+                        g_mut_mv_vm_op_dirty_log_enable = {};
+                        free_bitmaps(&mut_vm);
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"success without populated regions"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                shim_vm_t mut_vm{};
+                shim_vm_t mut_parent{};
+                constexpr auto vmid{42_u16};
+                bsl::ut_when{} = [&]() noexcept {
+                    init_slot(&mut_vm);
+                    init_slot(&mut_parent);
+                    g_mut_mv_vm_op_fork_vm = vmid.get();
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(SHIM_SUCCESS == handle(&mut_vm, &mut_parent));
+                        bsl::ut_check(vmid != mut_vm.vmid);
+                        bsl::ut_check(nullptr == mut_vm.populated[0]);
+                        bsl::ut_check(nullptr == mut_vm.shared[0]);
+                        bsl::ut_check(nullptr == mut_vm.parent);
+                        bsl::ut_check(nullptr == mut_parent.children);
+                    };
+                    bsl::ut_cleanup{} = [&]() noexcept {
+                        g_mut_mv_vm_op_fork_vm = {};
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"platform_alloc fails"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                shim_vm_t mut_vm{};
+                shim_vm_t mut_parent{};
+                bsl::uint64 mut_populated{0x3_u64.get()};
+                bsl::ut_when{} = [&]() noexcept {
+                    init_slot(&mut_vm);
+                    init_slot(&mut_parent);
+                    mut_parent.populated[0] = &mut_populated;
+                    g_mut_platform_alloc_fails = true;
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(SHIM_FAILURE == handle(&mut_vm, &mut_parent));
+                        bsl::ut_check(nullptr == mut_vm.populated[0]);
+                        bsl::ut_check(nullptr == mut_vm.parent);
+                    };
+                    bsl::ut_cleanup{} = [&]() noexcept {
+                        g_mut_platform_alloc_fails = {};
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"the VM was already forked"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                shim_vm_t mut_vm{};
+                shim_vm_t mut_parent{};
+                shim_vm_t mut_other{};
+                bsl::uint64 mut_populated{0x3_u64.get()};
+                bsl::ut_when{} = [&]() noexcept {
+                    init_slot(&mut_vm);
+                    init_slot(&mut_parent);
+                    mut_parent.populated[0] = &mut_populated;
+                    mut_vm.parent = &mut_other;
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(SHIM_FAILURE == handle(&mut_vm, &mut_parent));
+                        bsl::ut_check(nullptr == mut_parent.children);
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"the parent was forked"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                shim_vm_t mut_vm{};
+                shim_vm_t mut_parent{};
+                shim_vm_t mut_other{};
+                bsl::uint64 mut_populated{0x3_u64.get()};
+                bsl::ut_when{} = [&]() noexcept {
+                    init_slot(&mut_vm);
+                    init_slot(&mut_parent);
+                    mut_parent.populated[0] = &mut_populated;
+                    mut_parent.parent = &mut_other;
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(SHIM_FAILURE == handle(&mut_vm, &mut_parent));
+                        bsl::ut_check(nullptr == mut_vm.parent);
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"the VM has a vcpu"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                shim_vm_t mut_vm{};
+                shim_vm_t mut_parent{};
+                bsl::uint64 mut_populated{0x3_u64.get()};
+                bsl::ut_when{} = [&]() noexcept {
+                    init_slot(&mut_vm);
+                    init_slot(&mut_parent);
+                    mut_parent.populated[0] = &mut_populated;
+                    mut_vm.vcpus[0].fd = bsl::safe_u64::magic_1().get();
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(SHIM_FAILURE == handle(&mut_vm, &mut_parent));
+                        bsl::ut_check(nullptr == mut_vm.parent);
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"the VM was already populated"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                shim_vm_t mut_vm{};
+                shim_vm_t mut_parent{};
+                bsl::uint64 mut_populated{0x3_u64.get()};
+                bsl::uint64 mut_vm_populated{0x1_u64.get()};
+                bsl::ut_when{} = [&]() noexcept {
+                    init_slot(&mut_vm);
+                    init_slot(&mut_parent);
+                    mut_parent.populated[0] = &mut_populated;
+                    mut_vm.populated[0] = &mut_vm_populated;
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(SHIM_FAILURE == handle(&mut_vm, &mut_parent));
+                        bsl::ut_check(0x1_u64 == mut_vm_populated);
+                        bsl::ut_check(nullptr == mut_vm.parent);
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"the VM is missing a slot"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                shim_vm_t mut_vm{};
+                shim_vm_t mut_parent{};
+                bsl::uint64 mut_populated{0x3_u64.get()};
+                bsl::ut_when{} = [&]() noexcept {
+                    init_slot(&mut_parent);
+                    mut_parent.populated[0] = &mut_populated;
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(SHIM_FAILURE == handle(&mut_vm, &mut_parent));
+                        bsl::ut_check(nullptr == mut_vm.parent);
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"the guest physical address of a slot does not match"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                shim_vm_t mut_vm{};
+                shim_vm_t mut_parent{};
+                constexpr auto gpa{0x200000_u64};
+                bsl::uint64 mut_populated{0x3_u64.get()};
+                bsl::ut_when{} = [&]() noexcept {
+                    init_slot(&mut_vm);
+                    init_slot(&mut_parent);
+                    mut_vm.slots[0].guest_phys_addr = gpa.get();
+                    mut_parent.populated[0] = &mut_populated;
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(SHIM_FAILURE == handle(&mut_vm, &mut_parent));
+                        bsl::ut_check(nullptr == mut_vm.parent);
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"the size of a slot does not match"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                shim_vm_t mut_vm{};
+                shim_vm_t mut_parent{};
+                constexpr auto size{0x200000_u64};
+                bsl::uint64 mut_populated{0x3_u64.get()};
+                bsl::ut_when{} = [&]() noexcept {
+                    init_slot(&mut_vm);
+                    init_slot(&mut_parent);
+                    mut_vm.slots[0].memory_size = size.get();
+                    mut_parent.populated[0] = &mut_populated;
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(SHIM_FAILURE == handle(&mut_vm, &mut_parent));
+                        bsl::ut_check(nullptr == mut_vm.parent);
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"the parent has too many populated regions"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                shim_vm_t mut_vm{};
+                shim_vm_t mut_parent{};
+                constexpr auto size{0x20000000_u64};
+                constexpr auto every_other{0x5555555555555555_u64};
+                bsl::array<bsl::uint64, 4_umx.get()> mut_populated{};
+                bsl::ut_when{} = [&]() noexcept {
+                    init_slot(&mut_vm);
+                    init_slot(&mut_parent);
+                    mut_vm.slots[0].memory_size = size.get();
+                    mut_parent.slots[0].memory_size = size.get();
+                    for (auto &mut_elem : mut_populated) {
+                        mut_elem = every_other.get();
+                    }
+                    mut_parent.populated[0] = mut_populated.data();
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(SHIM_FAILURE == handle(&mut_vm, &mut_parent));
+                        bsl::ut_check(nullptr == mut_vm.parent);
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"mv_vm_op_fork_vm fails"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                shim_vm_t mut_vm{};
+                shim_vm_t mut_parent{};
+                bsl::uint64 mut_populated{0x3_u64.get()};
+                bsl::ut_when{} = [&]() noexcept {
+                    init_slot(&mut_vm);
+                    init_slot(&mut_parent);
+                    mut_parent.populated[0] = &mut_populated;
+                    g_mut_mv_vm_op_fork_vm = MV_INVALID_ID;
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(SHIM_FAILURE == handle(&mut_vm, &mut_parent));
+                        bsl::ut_check(nullptr == mut_vm.populated[0]);
+                        bsl::ut_check(nullptr == mut_vm.parent);
+                    };
+                    bsl::ut_cleanup{} = [&]() noexcept {
+                        g_mut_mv_vm_op_fork_vm = {};
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"mv_vm_op_destroy_vm fails"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                shim_vm_t mut_vm{};
+                shim_vm_t mut_parent{};
+                constexpr auto vmid{42_u16};
+                bsl::uint64 mut_populated{0x3_u64.get()};
+                bsl::ut_when{} = [&]() noexcept {
+                    init_slot(&mut_vm);
+                    init_slot(&mut_parent);
+                    mut_parent.populated[0] = &mut_populated;
+                    g_mut_mv_vm_op_fork_vm = vmid.get();
+                    g_mut_mv_vm_op_destroy_vm = MV_STATUS_FAILURE_UNKNOWN;
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(SHIM_FAILURE == handle(&mut_vm, &mut_parent));
+                        bsl::ut_check(vmid != mut_vm.vmid);
+                        bsl::ut_check(nullptr == mut_vm.populated[0]);
+                        bsl::ut_check(nullptr == mut_vm.parent);
+                    };
+                    bsl::ut_cleanup{} = [&]() noexcept {
+                        g_mut_mv_vm_op_fork_vm = {};
+                        g_mut_mv_vm_op_destroy_vm = {};
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"mv_vm_op_dirty_log_enable fails"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                shim_vm_t mut_vm{};
+                shim_vm_t mut_parent{};
+                bsl::uint64 mut_populated{0x3_u64.get()};
+                bsl::ut_when{} = [&]() noexcept {
+                    init_slot(&mut_vm);
+                    init_slot(&mut_parent);
+                    mut_vm.slots[0].flags = bsl::to_u32(KVM_MEM_LOG_DIRTY_PAGES).get();
+                    mut_parent.populated[0] = &mut_populated;
+                    g_mut_mv_vm_op_dirty_log_enable = bsl::safe_u64::magic_1().get();
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(SHIM_FAILURE == handle(&mut_vm, &mut_parent));
+                        bsl::ut_check(nullptr == mut_vm.populated[0]);
+                        bsl::ut_check(nullptr == mut_vm.parent);
+                    };
+                    bsl::ut_cleanup{} = [&]() noexcept {
+                        g_mut_mv_vm_op_dirty_log_enable = {};
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"unfork a VM that was not forked"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                shim_vm_t mut_vm{};
+                bsl::ut_then{} = [&]() noexcept {
+                    bsl::ut_check(0 == shim_vm_unfork(&mut_vm));
+                };
+            };
+        };
+
+        bsl::ut_scenario{"unfork with a parent that is still open"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                shim_vm_t mut_vm{};
+                shim_vm_t mut_other{};
+                shim_vm_t mut_parent{};
+                bsl::ut_when{} = [&]() noexcept {
+                    mut_parent.fd = bsl::safe_u64::magic_1().get();
+                    mut_parent.children = &mut_other;
+                    mut_other.parent = &mut_parent;
+                    mut_other.sibling = &mut_vm;
+                    mut_vm.parent = &mut_parent;
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(0 == shim_vm_unfork(&mut_vm));
+                        bsl::ut_check(&mut_other == mut_parent.children);
+                        bsl::ut_check(nullptr == mut_other.sibling);
+                        bsl::ut_check(nullptr == mut_vm.parent);
+                        bsl::ut_check(0 == shim_vm_unfork(&mut_other));
+                        bsl::ut_check(nullptr == mut_parent.children);
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"unfork the last child of a released parent"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                shim_vm_t mut_vm{};
+                shim_vm_t mut_other{};
+                shim_vm_t mut_parent{};
+                bsl::ut_when{} = [&]() noexcept {
+                    mut_parent.children = &mut_vm;
+                    mut_vm.parent = &mut_parent;
+                    mut_vm.sibling = &mut_other;
+                    mut_other.parent = &mut_parent;
+                    bsl::ut_then{} = [&]() noexcept {
+                        bsl::ut_check(0 == shim_vm_unfork(&mut_vm));
+                        bsl::ut_check(&mut_other == mut_parent.children);
+                        bsl::ut_check(nullptr == mut_vm.sibling);
+                        bsl::ut_check(1 == shim_vm_unfork(&mut_other));
+                        bsl::ut_check(nullptr == mut_parent.children);
+                    };
+                };
+            };
+        };
+
+        return fini_tests();
+    }
+}
+
+/// <!-- description -->
+///   @brief Main function for this unit test. If a call to bsl::ut_check() fails
+///     the application will fast fail. If all calls to bsl::ut_check() pass, this
+///     function will successfully return with bsl::exit_success.
+///
+/// <!-- inputs/outputs -->
+///   @return Always returns bsl::exit_success.
+///
+[[nodiscard]] auto
+main() noexcept -> bsl::exit_code
+{
+    bsl::enable_color();
+    return shim::tests();
+}
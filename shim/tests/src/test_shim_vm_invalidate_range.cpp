@@ -0,0 +1,356 @@
+/// @copyright
+/// Copyright (C) 2020 Assured Information Security, Inc.
+///
+/// @copyright
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// @copyright
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// @copyright
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+
+#include "../../include/shim_vm_invalidate_range.h"
+
+#include <helpers.hpp>
+#include <mv_types.h>
+#include <shim_vm_t.h>
+
+#include <bsl/safe_integral.hpp>
+#include <bsl/ut.hpp>
+
+namespace shim
+{
+    /// <!-- description -->
+    ///   @brief Used to execute the actual checks. We put the checks in this
+    ///     function so that we can validate the tests both at compile-time
+    ///     and at run-time. If a bsl::ut_check fails, the tests will either
+    ///     fail fast at run-time, or will produce a compile-time error.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @return Always returns bsl::exit_success.
+    ///
+    [[nodiscard]] constexpr auto
+    tests() noexcept -> bsl::exit_code
+    {
+        init_tests();
+
+        bsl::ut_scenario{"success without populated slots"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                shim_vm_t mut_vm{};
+                constexpr auto start{0x1000_u64};
+                constexpr auto end{0x2000_u64};
+                bsl::ut_then{} = [&]() noexcept {
+                    auto const ret{shim_vm_invalidate_range_start(&mut_vm, start.get(), end.get())};
+                    bsl::ut_check(SHIM_SUCCESS == ret);
+                    bsl::ut_check(bsl::safe_u64::magic_1() == mut_vm.invalidate_in_progress);
+                    bsl::ut_check(bsl::safe_u64::magic_1() == mut_vm.invalidate_seq);
+                    shim_vm_invalidate_range_end(&mut_vm);
+                    bsl::ut_check(bsl::safe_u64::magic_0() == mut_vm.invalidate_in_progress);
+                    bsl::ut_check(bsl::safe_u64::magic_1() == mut_vm.invalidate_seq);
+                };
+            };
+        };
+
+        bsl::ut_scenario{"success unmaps overlapping regions"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                shim_vm_t mut_vm{};
+                constexpr auto gpa{0x0_u64};
+                constexpr auto size{0x400000_u64};
+                constexpr auto addr{0x1000_u64};
+                constexpr auto start{0x202000_u64};
+                constexpr auto end{0x203000_u64};
+                bsl::uint64 mut_populated{0x3_u64.get()};
+                bsl::ut_when{} = [&]() noexcept {
+                    mut_vm.slots[0].guest_phys_addr = gpa.get();
+                    mut_vm.slots[0].memory_size = size.get();
+                    mut_vm.slots[0].userspace_addr = addr.get();
+                    mut_vm.populated[0] = &mut_populated;
+                    bsl::ut_then{} = [&]() noexcept {
+                        auto const ret{
+                            shim_vm_invalidate_range_start(&mut_vm, start.get(), end.get())};
+                        bsl::ut_check(SHIM_SUCCESS == ret);
+                        bsl::ut_check(0x1_u64 == mut_populated);
+                        shim_vm_invalidate_range_end(&mut_vm);
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"success unmaps an entire slot"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                shim_vm_t mut_vm{};
+                constexpr auto gpa{0x1000_u64};
+                constexpr auto size{0x400000_u64};
+                constexpr auto addr{0x1000_u64};
+                constexpr auto start{0x0_u64};
+                constexpr auto end{0xFFFFFFFFFFFFF000_u64};
+                bsl::uint64 mut_populated{0x7_u64.get()};
+                bsl::ut_when{} = [&]() noexcept {
+                    mut_vm.slots[0].guest_phys_addr = gpa.get();
+                    mut_vm.slots[0].memory_size = size.get();
+                    mut_vm.slots[0].userspace_addr = addr.get();
+                    mut_vm.populated[0] = &mut_populated;
+                    bsl::ut_then{} = [&]() noexcept {
+                        auto const ret{
+                            shim_vm_invalidate_range_start(&mut_vm, start.get(), end.get())};
+                        bsl::ut_check(SHIM_SUCCESS == ret);
+                        bsl::ut_check(0x0_u64 == mut_populated);
+                        shim_vm_invalidate_range_end(&mut_vm);
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"success unmaps regions shared with children"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                shim_vm_t mut_vm{};
+                shim_vm_t mut_child{};
+                shim_vm_t mut_other{};
+                constexpr auto gpa{0x0_u64};
+                constexpr auto size{0x400000_u64};
+                constexpr auto addr{0x1000_u64};
+                constexpr auto start{0x202000_u64};
+                constexpr auto end{0x203000_u64};
+                bsl::uint64 mut_populated{0x3_u64.get()};
+                bsl::uint64 mut_child_populated{0x3_u64.get()};
+                bsl::uint64 mut_child_shared{0x3_u64.get()};
+                bsl::uint64 mut_other_populated{0x3_u64.get()};
+                bsl::uint64 mut_other_shared{0x1_u64.get()};
+                bsl::ut_when{} = [&]() noexcept {
+                    mut_vm.slots[0].guest_phys_addr = gpa.get();
+                    mut_vm.slots[0].memory_size = size.get();
+                    mut_vm.slots[0].userspace_addr = addr.get();
+                    mut_vm.populated[0] = &mut_populated;
+                    mut_vm.children = &mut_child;
+                    mut_child.slots[0] = mut_vm.slots[0];
+                    mut_child.populated[0] = &mut_child_populated;
+                    mut_child.shared[0] = &mut_child_shared;
+                    mut_child.parent = &mut_vm;
+                    mut_child.sibling = &mut_other;
+                    mut_other.slots[0] = mut_vm.slots[0];
+                    mut_other.populated[0] = &mut_other_populated;
+                    mut_other.shared[0] = &mut_other_shared;
+                    mut_other.parent = &mut_vm;
+                    bsl::ut_then{} = [&]() noexcept {
+                        auto const ret{
+                            shim_vm_invalidate_range_start(&mut_vm, start.get(), end.get())};
+                        bsl::ut_check(SHIM_SUCCESS == ret);
+                        bsl::ut_check(0x1_u64 == mut_populated);
+                        bsl::ut_check(0x1_u64 == mut_child_populated);
+                        bsl::ut_check(0x1_u64 == mut_child_shared);
+                        bsl::ut_check(0x3_u64 == mut_other_populated);
+                        bsl::ut_check(0x1_u64 == mut_other_shared);
+                        shim_vm_invalidate_range_end(&mut_vm);
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"unmapping a region shared with a child fails"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                shim_vm_t mut_vm{};
+                shim_vm_t mut_child{};
+                constexpr auto gpa{0x0_u64};
+                constexpr auto size{0x400000_u64};
+                constexpr auto addr{0x1000_u64};
+                constexpr auto start{0x202000_u64};
+                constexpr auto end{0x203000_u64};
+                bsl::uint64 mut_populated{0x3_u64.get()};
+                bsl::uint64 mut_child_populated{0x3_u64.get()};
+                bsl::uint64 mut_child_shared{0x3_u64.get()};
+                bsl::ut_when{} = [&]() noexcept {
+                    mut_vm.slots[0].guest_phys_addr = gpa.get();
+                    mut_vm.slots[0].memory_size = size.get();
+                    mut_vm.slots[0].userspace_addr = addr.get();
+                    mut_vm.populated[0] = &mut_populated;
+                    mut_vm.children = &mut_child;
+                    mut_child.slots[0] = mut_vm.slots[0];
+                    mut_child.populated[0] = &mut_child_populated;
+                    mut_child.shared[0] = &mut_child_shared;
+                    mut_child.parent = &mut_vm;
+                    g_mut_mv_vm_op_mmio_unmap = 6_u64.get();
+                    bsl::ut_then{} = [&]() noexcept {
+                        auto const ret{
+                            shim_vm_invalidate_range_start(&mut_vm, start.get(), end.get())};
+                        bsl::ut_check(SHIM_FAILURE == ret);
+                        bsl::ut_check(0x3_u64 == mut_populated);
+                        bsl::ut_check(0x3_u64 == mut_child_populated);
+                        bsl::ut_check(0x3_u64 == mut_child_shared);
+                        shim_vm_invalidate_range_end(&mut_vm);
+                    };
+                    bsl::ut_cleanup{} = [&]() noexcept {
+                        g_mut_mv_vm_op_mmio_unmap = {};
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"range before the slot"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                shim_vm_t mut_vm{};
+                constexpr auto gpa{0x0_u64};
+                constexpr auto size{0x400000_u64};
+                constexpr auto addr{0x1000_u64};
+                constexpr auto start{0x0_u64};
+                constexpr auto end{0x1000_u64};
+                bsl::uint64 mut_populated{0x3_u64.get()};
+                bsl::ut_when{} = [&]() noexcept {
+                    mut_vm.slots[0].guest_phys_addr = gpa.get();
+                    mut_vm.slots[0].memory_size = size.get();
+                    mut_vm.slots[0].userspace_addr = addr.get();
+                    mut_vm.populated[0] = &mut_populated;
+                    bsl::ut_then{} = [&]() noexcept {
+                        auto const ret{
+                            shim_vm_invalidate_range_start(&mut_vm, start.get(), end.get())};
+                        bsl::ut_check(SHIM_SUCCESS == ret);
+                        bsl::ut_check(0x3_u64 == mut_populated);
+                        shim_vm_invalidate_range_end(&mut_vm);
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"range after the slot"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                shim_vm_t mut_vm{};
+                constexpr auto gpa{0x0_u64};
+                constexpr auto size{0x400000_u64};
+                constexpr auto addr{0x1000_u64};
+                constexpr auto start{0x401000_u64};
+                constexpr auto end{0x402000_u64};
+                bsl::uint64 mut_populated{0x3_u64.get()};
+                bsl::ut_when{} = [&]() noexcept {
+                    mut_vm.slots[0].guest_phys_addr = gpa.get();
+                    mut_vm.slots[0].memory_size = size.get();
+                    mut_vm.slots[0].userspace_addr = addr.get();
+                    mut_vm.populated[0] = &mut_populated;
+                    bsl::ut_then{} = [&]() noexcept {
+                        auto const ret{
+                            shim_vm_invalidate_range_start(&mut_vm, start.get(), end.get())};
+                        bsl::ut_check(SHIM_SUCCESS == ret);
+                        bsl::ut_check(0x3_u64 == mut_populated);
+                        shim_vm_invalidate_range_end(&mut_vm);
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"region not populated"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                shim_vm_t mut_vm{};
+                constexpr auto gpa{0x0_u64};
+                constexpr auto size{0x400000_u64};
+                constexpr auto addr{0x1000_u64};
+                constexpr auto start{0x202000_u64};
+                constexpr auto end{0x203000_u64};
+                bsl::uint64 mut_populated{0x1_u64.get()};
+                bsl::ut_when{} = [&]() noexcept {
+                    mut_vm.slots[0].guest_phys_addr = gpa.get();
+                    mut_vm.slots[0].memory_size = size.get();
+                    mut_vm.slots[0].userspace_addr = addr.get();
+                    mut_vm.populated[0] = &mut_populated;
+                    g_mut_mv_vm_op_mmio_unmap = bsl::safe_u64::magic_1().get();
+                    bsl::ut_then{} = [&]() noexcept {
+                        auto const ret{
+                            shim_vm_invalidate_range_start(&mut_vm, start.get(), end.get())};
+                        bsl::ut_check(SHIM_SUCCESS == ret);
+                        bsl::ut_check(bsl::safe_u64::magic_1() == g_mut_mv_vm_op_mmio_unmap);
+                        bsl::ut_check(0x1_u64 == mut_populated);
+                        shim_vm_invalidate_range_end(&mut_vm);
+                    };
+                    bsl::ut_cleanup{} = [&]() noexcept {
+                        g_mut_mv_vm_op_mmio_unmap = {};
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"mv_vm_op_mmio_unmap fails"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                shim_vm_t mut_vm{};
+                constexpr auto gpa{0x0_u64};
+                constexpr auto size{0x400000_u64};
+                constexpr auto addr{0x1000_u64};
+                constexpr auto start{0x202000_u64};
+                constexpr auto end{0x203000_u64};
+                bsl::uint64 mut_populated{0x3_u64.get()};
+                bsl::ut_when{} = [&]() noexcept {
+                    mut_vm.slots[0].guest_phys_addr = gpa.get();
+                    mut_vm.slots[0].memory_size = size.get();
+                    mut_vm.slots[0].userspace_addr = addr.get();
+                    mut_vm.populated[0] = &mut_populated;
+                    g_mut_mv_vm_op_mmio_unmap = bsl::safe_u64::magic_1().get();
+                    bsl::ut_then{} = [&]() noexcept {
+                        auto const ret{
+                            shim_vm_invalidate_range_start(&mut_vm, start.get(), end.get())};
+                        bsl::ut_check(SHIM_FAILURE == ret);
+                        bsl::ut_check(0x3_u64 == mut_populated);
+                        shim_vm_invalidate_range_end(&mut_vm);
+                    };
+                    bsl::ut_cleanup{} = [&]() noexcept {
+                        g_mut_mv_vm_op_mmio_unmap = {};
+                    };
+                };
+            };
+        };
+
+        bsl::ut_scenario{"mv_vm_op_mmio_unmap fails on the last mdl"} = []() noexcept {
+            bsl::ut_given{} = [&]() noexcept {
+                shim_vm_t mut_vm{};
+                constexpr auto gpa{0x0_u64};
+                constexpr auto size{0x400000_u64};
+                constexpr auto addr{0x1000_u64};
+                constexpr auto start{0x202000_u64};
+                constexpr auto end{0x203000_u64};
+                bsl::uint64 mut_populated{0x3_u64.get()};
+                bsl::ut_when{} = [&]() noexcept {
+                    mut_vm.slots[0].guest_phys_addr = gpa.get();
+                    mut_vm.slots[0].memory_size = size.get();
+                    mut_vm.slots[0].userspace_addr = addr.get();
+                    mut_vm.populated[0] = &mut_populated;
+                    g_mut_mv_vm_op_mmio_unmap = 5_u64.get();
+                    bsl::ut_then{} = [&]() noexcept {
+                        auto const ret{
+                            shim_vm_invalidate_range_start(&mut_vm, start.get(), end.get())};
+                        bsl::ut_check(SHIM_FAILURE == ret);
+                        bsl::ut_check(0x3_u64 == mut_populated);
+                        shim_vm_invalidate_range_end(&mut_vm);
+                    };
+                    bsl::ut_cleanup{} = [&]() noexcept {
+                        g_mut_mv_vm_op_mmio_unmap = {};
+                    };
+                };
+            };
+        };
+
+        return fini_tests();
+    }
+}
+
+/// <!-- description -->
+///   @brief Main function for this unit test. If a call to bsl::ut_check() fails
+///     the application will fast fail. If all calls to bsl::ut_check() pass, this
+///     function will successfully return with bsl::exit_success.
+///
+/// <!-- inputs/outputs -->
+///   @return Always returns bsl::exit_success.
+///
+[[nodiscard]] auto
+main() noexcept -> bsl::exit_code
+{
+    bsl::enable_color();
+    return shim::tests();
+}
@@ -157,6 +157,30 @@ namespace microv
             return m_head == m_tail;
         }
 
+        /// <!-- description -->
+        ///   @brief Returns true if the queue is full. Returns false
+        ///     otherwise.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @return Returns true if the queue is full. Returns false
+        ///     otherwise.
+        ///
+        [[nodiscard]] constexpr auto
+        full() const noexcept -> bool
+        {
+            auto mut_next{m_head};
+
+            ++mut_next;
+            if (mut_next >= N) {
+                mut_next = {};
+            }
+            else {
+                bsl::touch();
+            }
+
+            return mut_next == m_tail;
+        }
+
         /// <!-- description -->
         ///   @brief Returns the number of elements in the queue
         ///
@@ -58,6 +58,13 @@ namespace microv
 
         /// @brief tells the VMExit handler that we are in a vmcall
         bool handling_vmcall;
+
+        /// @brief stores the state components switched by set_active/set_inactive
+        bsl::safe_u64 xsave_mask;
+        /// @brief stores whether or not this PP supports XSAVEOPT
+        bool xsaveopt_supported;
+        /// @brief stores the XCR0 bits supported by this PP
+        bsl::safe_u64 xcr0_supported;
     };
 
     /// @brief defines the max size supported for the TLS block
@@ -48,20 +48,10 @@ namespace microv
         /// @brief stores the SPA of the IO permissions map for the root VM
         bsl::safe_u64 root_iopm_spa;
 
-        /// @brief stores the IO permissions map for guest VMs
-        bsl::span<bsl::uint8> guest_iopm;
-        /// @brief stores the SPA of the IO permissions map for guest VMs
-        bsl::safe_u64 guest_iopm_spa;
-
         /// @brief stores the MSR permissions map for root the VM
         bsl::span<bsl::uint8> root_msrpm;
         /// @brief stores the SPA of the MSR permissions map for root the VM
         bsl::safe_u64 root_msrpm_spa;
-
-        /// @brief stores the MSR permissions map for guest VMs
-        bsl::span<bsl::uint8> guest_msrpm;
-        /// @brief stores the SPA of the MSR permissions map for guest VMs
-        bsl::safe_u64 guest_msrpm_spa;
     };
 }
 
@@ -70,8 +70,10 @@ namespace microv
         bsl::uint64 alias : static_cast<bsl::uint64>(1);
         /// @brief defines our "require_explicit_unmap" field in the page
         bsl::uint64 require_explicit_unmap : static_cast<bsl::uint64>(1);
+        /// @brief defines our "copy-on-write" field in the page
+        bsl::uint64 cow : static_cast<bsl::uint64>(1);
         /// @brief defines the "available to software" field in the page
-        bsl::uint64 available2 : static_cast<bsl::uint64>(7);
+        bsl::uint64 available2 : static_cast<bsl::uint64>(6);
         /// @brief defines the "no-execute" field in the page
         bsl::uint64 nx : static_cast<bsl::uint64>(1);
     };
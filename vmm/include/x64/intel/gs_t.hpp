@@ -25,11 +25,17 @@
 #ifndef GS_T_HPP
 #define GS_T_HPP
 
+#include <bsl/convert.hpp>
 #include <bsl/safe_integral.hpp>
 #include <bsl/span.hpp>
 
 namespace microv
 {
+    /// @brief stores the size of the IO bitmaps (A and B)
+    constexpr auto IOPM_SIZE{0x2000_umx};
+    /// @brief stores the size of the MSR bitmaps
+    constexpr auto MSRPM_SIZE{0x1000_umx};
+
     /// @class microv::gs_t
     ///
     /// <!-- description -->
@@ -46,24 +52,10 @@ namespace microv
         /// @brief stores the SPA of the IO permissions map B for the root VM
         bsl::safe_u64 root_iopm_b_spa;
 
-        /// @brief stores the IO permissions map A for guest VMs
-        bsl::span<bsl::uint8> guest_iopm_a;
-        /// @brief stores the SPA of the IO permissions map A for guest VMs
-        bsl::safe_u64 guest_iopm_a_spa;
-        /// @brief stores the IO permissions map B for guest VMs
-        bsl::span<bsl::uint8> guest_iopm_b;
-        /// @brief stores the SPA of the IO permissions map B for guest VMs
-        bsl::safe_u64 guest_iopm_b_spa;
-
         /// @brief stores the MSR permissions map for root the VM
         bsl::span<bsl::uint8> root_msrpm;
         /// @brief stores the SPA of the MSR permissions map for root the VM
         bsl::safe_u64 root_msrpm_spa;
-
-        /// @brief stores the MSR permissions map for guest VMs
-        bsl::span<bsl::uint8> guest_msrpm;
-        /// @brief stores the SPA of the MSR permissions map for guest VMs
-        bsl::safe_u64 guest_msrpm_spa;
     };
 }
 
@@ -76,8 +76,8 @@ namespace microv
         bsl::uint64 ignored3 : static_cast<bsl::uint64>(4);
         /// @brief defines the "sub page write permissions" field in the page
         bsl::uint64 sub : static_cast<bsl::uint64>(1);
-        /// @brief defines the "ignored" field in the page
-        bsl::uint64 ignored4 : static_cast<bsl::uint64>(1);
+        /// @brief defines our "copy-on-write" field in the page
+        bsl::uint64 cow : static_cast<bsl::uint64>(1);
         /// @brief defines the "virtualization exception" field in the page
         bsl::uint64 ve : static_cast<bsl::uint64>(1);
     };
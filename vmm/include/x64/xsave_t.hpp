@@ -0,0 +1,106 @@
+/// @copyright
+/// Copyright (C) 2020 Assured Information Security, Inc.
+///
+/// @copyright
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// @copyright
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// @copyright
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+
+
+#ifndef XSAVE_T_HPP
+#define XSAVE_T_HPP
+
+#include <bsl/array.hpp>
+#include <bsl/convert.hpp>
+#include <bsl/cstdint.hpp>
+#include <bsl/safe_integral.hpp>
+
+#pragma pack(push, 1)
+
+namespace microv
+{
+    /// @brief defines the x87 state component bit of XCR0/XSTATE_BV
+    constexpr auto XSAVE_X87{0x1_u64};
+    /// @brief defines the SSE state component bit of XCR0/XSTATE_BV
+    constexpr auto XSAVE_SSE{0x2_u64};
+    /// @brief defines the state components stored in the legacy region
+    constexpr auto XSAVE_LEGACY{0x3_u64};
+    /// @brief defines the AVX state component bit of XCR0/XSTATE_BV
+    constexpr auto XSAVE_AVX{0x4_u64};
+    /// @brief defines the MPX state component bits of XCR0/XSTATE_BV
+    constexpr auto XSAVE_MPX{0x18_u64};
+    /// @brief defines the AVX-512 state component bits of XCR0/XSTATE_BV
+    constexpr auto XSAVE_AVX512{0xE0_u64};
+    /// @brief defines a requested-feature bitmap that selects everything
+    constexpr auto XSAVE_ALL{0xFFFFFFFFFFFFFFFF_u64};
+
+    /// @brief defines the size of the legacy (FXSAVE) region
+    constexpr auto XSAVE_LEGACY_SIZE{512_umx};
+    /// @brief defines the size of the reserved bytes in the XSAVE header
+    constexpr auto XSAVE_HEADER_RSVD_SIZE{48_umx};
+    /// @brief defines the size of the extended region
+    constexpr auto XSAVE_EXTENDED_SIZE{3520_umx};
+
+    /// @brief defines the offset of FCW in the legacy region
+    constexpr auto XSAVE_FCW_OFFSET{0_umx};
+    /// @brief defines the size of FCW in the legacy region
+    constexpr auto XSAVE_FCW_SIZE{2_umx};
+    /// @brief defines the value of FCW when the x87 state is in its init state
+    constexpr auto XSAVE_FCW_INIT{0x037F_u16};
+    /// @brief defines the offset of FSW through FDP in the legacy region
+    constexpr auto XSAVE_X87_ENV_OFFSET{2_umx};
+    /// @brief defines the size of FSW through FDP in the legacy region
+    constexpr auto XSAVE_X87_ENV_SIZE{22_umx};
+    /// @brief defines the offset of ST0-ST7 in the legacy region
+    constexpr auto XSAVE_ST_OFFSET{32_umx};
+    /// @brief defines the size of ST0-ST7 in the legacy region
+    constexpr auto XSAVE_ST_SIZE{128_umx};
+    /// @brief defines the offset of XMM0-XMM15 in the legacy region
+    constexpr auto XSAVE_XMM_OFFSET{160_umx};
+    /// @brief defines the size of XMM0-XMM15 in the legacy region
+    constexpr auto XSAVE_XMM_SIZE{256_umx};
+
+    /// @struct microv::xsave_t
+    ///
+    /// <!-- description -->
+    ///   @brief Defines the layout of the (standard format) XSAVE area
+    ///     that MicroV uses to store a VS's extended state. The area is
+    ///     page sized as it is allocated from the page pool.
+    ///
+    struct xsave_t final
+    {
+        /// @brief stores the legacy (FXSAVE compatible) region
+        bsl::array<bsl::uint8, XSAVE_LEGACY_SIZE.get()> legacy;
+        /// @brief stores which state components are not in their init state
+        bsl::uint64 xstate_bv;
+        /// @brief stores the compaction bitmap (always 0 for this format)
+        bsl::uint64 xcomp_bv;
+        /// @brief reserved
+        bsl::array<bsl::uint8, XSAVE_HEADER_RSVD_SIZE.get()> rsvd;
+        /// @brief stores the extended region
+        bsl::array<bsl::uint8, XSAVE_EXTENDED_SIZE.get()> extended;
+    };
+
+    /// @brief ensure that the xsave_t fits in the page it is allocated from
+    static_assert(!(sizeof(xsave_t) > HYPERVISOR_PAGE_SIZE));
+}
+
+#pragma pack(pop)
+
+#endif
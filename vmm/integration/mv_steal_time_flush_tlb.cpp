@@ -0,0 +1,185 @@
+/// @copyright
+/// Copyright (C) 2020 Assured Information Security, Inc.
+///
+/// @copyright
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// @copyright
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// @copyright
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+
+
+#include <integration_utils.hpp>
+#include <mv_constants.hpp>
+#include <mv_exit_reason_t.hpp>
+#include <mv_hypercall_t.hpp>
+#include <mv_mdl_t.hpp>
+
+#include <bsl/array.hpp>
+#include <bsl/convert.hpp>
+#include <bsl/enable_color.hpp>
+#include <bsl/exit_code.hpp>
+#include <bsl/safe_idx.hpp>
+#include <bsl/safe_integral.hpp>
+
+namespace hypercall
+{
+    /// @brief defines MSR_KVM_STEAL_TIME
+    constexpr auto MSR_KVM_STEAL_TIME{0x4B564D03_u32};
+    /// @brief defines the enable bit of MSR_KVM_STEAL_TIME
+    constexpr auto STEAL_TIME_ENABLE{0x1_u64};
+    /// @brief defines the offset of the preempted field of kvm_steal_time
+    constexpr auto STEAL_TIME_PREEMPTED_IDX{16_idx};
+    /// @brief defines the KVM_VCPU_PREEMPTED flag
+    constexpr auto STEAL_TIME_PREEMPTED{0x01_u8};
+    /// @brief defines the KVM_VCPU_FLUSH_TLB flag
+    constexpr auto STEAL_TIME_FLUSH_TLB{0x02_u8};
+    /// @brief defines the GPA the steal time page is mapped to
+    constexpr auto STEAL_TIME_GPA{0x10000_u64};
+
+    /// @brief defines the page the guest's kvm_steal_time lives in
+    alignas(HYPERVISOR_PAGE_SIZE.get())
+        bsl::array<bsl::uint8, HYPERVISOR_PAGE_SIZE.get()> g_mut_steal_time{};    // NOLINT
+
+    /// <!-- description -->
+    ///   @brief Runs the VS until it leaves the guest because of an
+    ///     interrupt, which is when the VS is reported as preempted.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param vsid the ID of the VS to run
+    ///
+    constexpr void
+    run_until_interrupt_exit(bsl::safe_u16 const &vsid) noexcept
+    {
+        while (true) {
+            auto const exit_reason{mut_hvc.mv_vs_op_run(vsid)};
+            if (exit_reason == mv_exit_reason_t::mv_exit_reason_t_nmi) {
+                continue;
+            }
+
+            integration::verify(exit_reason == mv_exit_reason_t::mv_exit_reason_t_interrupt);
+            return;
+        }
+    }
+
+    /// <!-- description -->
+    ///   @brief Maps g_mut_steal_time into the provided VM at
+    ///     STEAL_TIME_GPA so that the test can play the role of another
+    ///     VS of the guest.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param vmid the ID of the VM to map the steal time page to
+    ///
+    constexpr void
+    map_steal_time(bsl::safe_u16 const &vmid) noexcept
+    {
+        g_mut_steal_time = {};
+
+        auto *const pmut_mdl{to_0<mv_mdl_t>()};
+        auto const src{to_gpa(g_mut_steal_time.data(), core0)};
+
+        pmut_mdl->num_entries = 1_u64.get();
+        pmut_mdl->entries.at_if({})->dst = STEAL_TIME_GPA.get();
+        pmut_mdl->entries.at_if({})->src = src.get();
+        pmut_mdl->entries.at_if({})->bytes = HYPERVISOR_PAGE_SIZE.get();
+
+        integration::verify(mut_hvc.mv_vm_op_mmio_map(vmid, self));
+        pmut_mdl->num_entries = {};
+    }
+
+    /// <!-- description -->
+    ///   @brief Always returns bsl::exit_success. If a failure occurs,
+    ///     this function will exit early.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @return Always returns bsl::exit_success. If a failure occurs,
+    ///     this function will exit early.
+    ///
+    [[nodiscard]] constexpr auto
+    tests() noexcept -> bsl::exit_code
+    {
+        integration::initialize_globals();
+        integration::initialize_shared_pages();
+
+        auto const vm_image{integration::load_vm("vm_cross_compile/bin/16bit_endless_loop_test")};
+
+        // Verify a flush asked for while the VS was preempted is consumed
+        // before the VS re-enters the guest
+        {
+            auto const vmid{mut_hvc.mv_vm_op_create_vm()};
+            auto const vpid{mut_hvc.mv_vp_op_create_vp(vmid)};
+            auto const vsid{mut_hvc.mv_vs_op_create_vs(vpid)};
+
+            integration::verify(vmid.is_valid_and_checked());
+            integration::verify(vpid.is_valid_and_checked());
+            integration::verify(vsid.is_valid_and_checked());
+
+            integration::map_vm(vm_image, {}, vmid);
+            integration::initialize_register_state_for_16bit_vm(vsid);
+
+            map_steal_time(vmid);
+            auto *const pmut_preempted{g_mut_steal_time.at_if(STEAL_TIME_PREEMPTED_IDX)};
+            integration::verify(nullptr != pmut_preempted);
+
+            auto const msr{(STEAL_TIME_GPA | STEAL_TIME_ENABLE).checked()};
+            integration::verify(mut_hvc.mv_vs_op_msr_set(vsid, MSR_KVM_STEAL_TIME, msr));
+
+            run_until_interrupt_exit(vsid);
+            integration::verify(STEAL_TIME_PREEMPTED == bsl::to_u8(*pmut_preempted));
+
+            /// NOTE:
+            /// - This is what another VS of the guest does instead of
+            ///   sending this VS a TLB shootdown IPI. When the VS is run
+            ///   again, the flag must be consumed (and the TLB flushed)
+            ///   before the guest runs. The VS is then preempted again by
+            ///   the next interrupt, which only sets the preempted flag.
+            ///
+
+            *pmut_preempted = (STEAL_TIME_PREEMPTED | STEAL_TIME_FLUSH_TLB).checked().get();
+
+            run_until_interrupt_exit(vsid);
+            integration::verify(STEAL_TIME_PREEMPTED == bsl::to_u8(*pmut_preempted));
+
+            // Disabling steal time stops the VS from being reported
+
+            *pmut_preempted = {};
+            integration::verify(mut_hvc.mv_vs_op_msr_set(vsid, MSR_KVM_STEAL_TIME, {}));
+
+            run_until_interrupt_exit(vsid);
+            integration::verify(bsl::safe_u8::magic_0() == bsl::to_u8(*pmut_preempted));
+
+            integration::verify(mut_hvc.mv_vs_op_destroy_vs(vsid));
+            integration::verify(mut_hvc.mv_vp_op_destroy_vp(vpid));
+            integration::verify(mut_hvc.mv_vm_op_destroy_vm(vmid));
+        }
+
+        return bsl::exit_success;
+    }
+}
+
+/// <!-- description -->
+///   @brief Provides the main entry point for this application.
+///
+/// <!-- inputs/outputs -->
+///   @return bsl::exit_success on success, bsl::exit_failure otherwise.
+///
+[[nodiscard]] auto
+main() noexcept -> bsl::exit_code
+{
+    bsl::enable_color();
+    return hypercall::tests();
+}
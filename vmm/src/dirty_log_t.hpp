@@ -0,0 +1,498 @@
+/// @copyright
+/// Copyright (C) 2020 Assured Information Security, Inc.
+///
+/// @copyright
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// @copyright
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// @copyright
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+
+#ifndef DIRTY_LOG_T_HPP
+#define DIRTY_LOG_T_HPP
+
+#include <bf_syscall_t.hpp>
+#include <mv_dirty_bitmap_t.hpp>
+#include <mv_dirty_ring_t.hpp>
+#include <page_4k_t.hpp>
+#include <page_pool_t.hpp>
+#include <tls_t.hpp>
+
+#include <bsl/array.hpp>
+#include <bsl/convert.hpp>
+#include <bsl/debug.hpp>
+#include <bsl/ensures.hpp>
+#include <bsl/errc_type.hpp>
+#include <bsl/expects.hpp>
+#include <bsl/safe_idx.hpp>
+#include <bsl/safe_integral.hpp>
+#include <bsl/touch.hpp>
+#include <bsl/unlikely.hpp>
+
+namespace microv
+{
+    /// @brief defines the number of pages described by each dirty log entry
+    constexpr auto DIRTY_LOG_PAGES_PER_ENTRY{64_u64};
+    /// @brief defines the max number of dirty log pages a slot can have
+    constexpr auto DIRTY_LOG_MAX_PAGES{512_u64};
+
+    /// @struct microv::dirty_log_page_t
+    ///
+    /// <!-- description -->
+    ///   @brief Defines a single page of a slot's dirty log. Each page
+    ///     has the same layout as a hypercall::mv_dirty_bitmap_t so that
+    ///     harvesting the dirty log is a single copy.
+    ///
+    struct dirty_log_page_t final
+    {
+        /// @brief stores each entry in the dirty log page
+        bsl::array<bsl::uint64, hypercall::MV_DIRTY_BITMAP_MAX_ENTRIES.get()> entries;
+    };
+
+    /// @brief make sure the dirty_log_page_t is a page in size
+    static_assert(sizeof(dirty_log_page_t) == PAGE_4K_T_SIZE);
+
+    /// @struct microv::dirty_log_table_t
+    ///
+    /// <!-- description -->
+    ///   @brief Defines the table of dirty log pages owned by a slot.
+    ///
+    struct dirty_log_table_t final
+    {
+        /// @brief stores each dirty log page owned by the slot
+        bsl::array<dirty_log_page_t *, DIRTY_LOG_MAX_PAGES.get()> pages;
+    };
+
+    /// @brief make sure the dirty_log_table_t is a page in size
+    static_assert(sizeof(dirty_log_table_t) == PAGE_4K_T_SIZE);
+
+    /// @brief defines the max number of pages that a slot can log
+    constexpr auto DIRTY_LOG_MAX_SLOT_PAGES{
+        (DIRTY_LOG_MAX_PAGES * hypercall::MV_DIRTY_BITMAP_MAX_PAGES).checked()};
+
+    /// @struct microv::dirty_log_slot_t
+    ///
+    /// <!-- description -->
+    ///   @brief Defines the state of a single dirty logged slot.
+    ///
+    struct dirty_log_slot_t final
+    {
+        /// @brief stores the GPA of the first page in the slot
+        bsl::safe_u64 gpa;
+        /// @brief stores the total number of pages in the slot
+        bsl::safe_u64 num_pages;
+        /// @brief stores the dirty log pages of the slot
+        dirty_log_table_t *table;
+    };
+
+    /// @class microv::dirty_log_t
+    ///
+    /// <!-- description -->
+    ///   @brief Defines the dirty log of a VM. Each slot that has dirty
+    ///     logging enabled is given a bitmap with one bit per page, which
+    ///     is allocated from the page pool when logging is enabled and
+    ///     returned to the page pool when logging is disabled.
+    ///
+    ///   @note IMPORTANT: This class is a per-VM class and is not
+    ///     synchronized. The owning vm_t is responsible for locking as
+    ///     the dirty log is updated from any PP that runs the VM.
+    ///
+    class dirty_log_t final
+    {
+        /// @brief stores each slot of the dirty log
+        bsl::array<dirty_log_slot_t, MICROV_MAX_SLOTS.get()> m_slots{};
+        /// @brief stores the number of slots with dirty logging enabled
+        bsl::safe_umx m_num_enabled{};
+
+        /// <!-- description -->
+        ///   @brief Returns the requested slot, or a nullptr if the slot
+        ///     does not exist or does not have dirty logging enabled.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param slot the slot to get
+        ///   @return Returns the requested slot, or a nullptr if the slot
+        ///     does not exist or does not have dirty logging enabled.
+        ///
+        [[nodiscard]] constexpr auto
+        get_slot(bsl::safe_u64 const &slot) const noexcept -> dirty_log_slot_t const *
+        {
+            bsl::expects(slot.is_valid_and_checked());
+
+            if (bsl::unlikely(bsl::to_umx(slot) >= m_slots.size())) {
+                bsl::error() << "slot "                // --
+                             << bsl::hex(slot)         // --
+                             << " is out of range "    // --
+                             << bsl::endl              // --
+                             << bsl::here();           // --
+
+                return nullptr;
+            }
+
+            auto const *const slt{m_slots.at_if(bsl::to_idx(slot))};
+            if (bsl::unlikely(nullptr == slt->table)) {
+                bsl::error() << "slot "                                    // --
+                             << bsl::hex(slot)                             // --
+                             << " does not have dirty logging enabled "    // --
+                             << bsl::endl                                  // --
+                             << bsl::here();                               // --
+
+                return nullptr;
+            }
+
+            return slt;
+        }
+
+        /// <!-- description -->
+        ///   @brief Returns the index of the page in the provided slot that
+        ///     the provided GFN refers to. If the provided slot does not
+        ///     have dirty logging enabled, or if the GFN is not in the
+        ///     provided slot, bsl::safe_u64::failure() is returned.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param slt the slot to query
+        ///   @param gfn the GFN to locate
+        ///   @return Returns the index of the page in the provided slot that
+        ///     the provided GFN refers to. If the provided slot does not
+        ///     have dirty logging enabled, or if the GFN is not in the
+        ///     provided slot, bsl::safe_u64::failure() is returned.
+        ///
+        [[nodiscard]] static constexpr auto
+        page_in_slot(dirty_log_slot_t const &slt, bsl::safe_u64 const &gfn) noexcept
+            -> bsl::safe_u64
+        {
+            if (nullptr == slt.table) {
+                return bsl::safe_u64::failure();
+            }
+
+            auto const first_gfn{(slt.gpa >> PAGE_4K_T_SHFT).checked()};
+            if (gfn < first_gfn) {
+                return bsl::safe_u64::failure();
+            }
+
+            auto const page{(gfn - first_gfn).checked()};
+            if (page >= slt.num_pages) {
+                return bsl::safe_u64::failure();
+            }
+
+            return page;
+        }
+
+    public:
+        /// <!-- description -->
+        ///   @brief Releases all of the dirty log pages owned by this
+        ///     dirty_log_t, disabling dirty logging on all slots.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param tls the tls_t to use
+        ///   @param mut_page_pool the page_pool_t to use
+        ///
+        constexpr void
+        release(tls_t const &tls, page_pool_t &mut_page_pool) noexcept
+        {
+            for (bsl::safe_idx mut_i{}; mut_i < m_slots.size(); ++mut_i) {
+                this->disable(tls, mut_page_pool, bsl::to_u64(mut_i));
+            }
+        }
+
+        /// <!-- description -->
+        ///   @brief Enables dirty logging on the provided slot. All of the
+        ///     pages in the slot start out clean.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param tls the tls_t to use
+        ///   @param mut_sys the bf_syscall_t to use
+        ///   @param mut_page_pool the page_pool_t to use
+        ///   @param slot the slot to enable dirty logging on
+        ///   @param gpa the GPA of the first page in the slot
+        ///   @param num_pages the total number of pages in the slot
+        ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+        ///     and friends otherwise
+        ///
+        [[nodiscard]] constexpr auto
+        enable(
+            tls_t const &tls,
+            syscall::bf_syscall_t &mut_sys,
+            page_pool_t &mut_page_pool,
+            bsl::safe_u64 const &slot,
+            bsl::safe_u64 const &gpa,
+            bsl::safe_u64 const &num_pages) noexcept -> bsl::errc_type
+        {
+            bsl::expects(slot.is_valid_and_checked());
+            bsl::expects(gpa.is_valid_and_checked());
+            bsl::expects(num_pages.is_valid_and_checked());
+
+            if (bsl::unlikely(bsl::to_umx(slot) >= m_slots.size())) {
+                bsl::error() << "slot "                // --
+                             << bsl::hex(slot)         // --
+                             << " is out of range "    // --
+                             << bsl::endl              // --
+                             << bsl::here();           // --
+
+                return bsl::errc_failure;
+            }
+
+            if (bsl::unlikely(num_pages.is_zero() || num_pages > DIRTY_LOG_MAX_SLOT_PAGES)) {
+                bsl::error() << "the number of pages "        // --
+                             << bsl::hex(num_pages)           // --
+                             << " cannot be dirty logged "    // --
+                             << bsl::endl                     // --
+                             << bsl::here();                  // --
+
+                return bsl::errc_failure;
+            }
+
+            auto *const pmut_slot{m_slots.at_if(bsl::to_idx(slot))};
+            if (bsl::unlikely(nullptr != pmut_slot->table)) {
+                bsl::error() << "slot "                                  // --
+                             << bsl::hex(slot)                           // --
+                             << " already has dirty logging enabled "    // --
+                             << bsl::endl                                // --
+                             << bsl::here();                             // --
+
+                return bsl::errc_failure;
+            }
+
+            pmut_slot->table = mut_page_pool.allocate<dirty_log_table_t>(tls, mut_sys);
+            if (bsl::unlikely(nullptr == pmut_slot->table)) {
+                bsl::print<bsl::V>() << bsl::here();
+                return bsl::errc_failure;
+            }
+
+            pmut_slot->gpa = gpa;
+            pmut_slot->num_pages = num_pages;
+            ++m_num_enabled;
+
+            auto const max_pages{hypercall::MV_DIRTY_BITMAP_MAX_PAGES};
+            auto const num_log_pages{((num_pages + (max_pages - 1_u64)) / max_pages).checked()};
+
+            for (bsl::safe_idx mut_i{}; mut_i < num_log_pages; ++mut_i) {
+                auto *const pmut_page{mut_page_pool.allocate<dirty_log_page_t>(tls, mut_sys)};
+                if (bsl::unlikely(nullptr == pmut_page)) {
+                    bsl::print<bsl::V>() << bsl::here();
+                    this->disable(tls, mut_page_pool, slot);
+                    return bsl::errc_failure;
+                }
+
+                *pmut_slot->table->pages.at_if(mut_i) = pmut_page;
+            }
+
+            return bsl::errc_success;
+        }
+
+        /// <!-- description -->
+        ///   @brief Disables dirty logging on the provided slot and returns
+        ///     its dirty log pages to the page pool. If dirty logging is not
+        ///     enabled on the provided slot, this function does nothing.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param tls the tls_t to use
+        ///   @param mut_page_pool the page_pool_t to use
+        ///   @param slot the slot to disable dirty logging on
+        ///
+        constexpr void
+        disable(tls_t const &tls, page_pool_t &mut_page_pool, bsl::safe_u64 const &slot) noexcept
+        {
+            bsl::expects(slot.is_valid_and_checked());
+            bsl::expects(bsl::to_umx(slot) < m_slots.size());
+
+            auto *const pmut_slot{m_slots.at_if(bsl::to_idx(slot))};
+            if (nullptr == pmut_slot->table) {
+                return;
+            }
+
+            for (auto *const pmut_page : pmut_slot->table->pages) {
+                if (nullptr != pmut_page) {
+                    mut_page_pool.deallocate(tls, pmut_page);
+                }
+                else {
+                    bsl::touch();
+                }
+            }
+
+            mut_page_pool.deallocate(tls, pmut_slot->table);
+
+            pmut_slot->table = {};
+            pmut_slot->num_pages = {};
+            pmut_slot->gpa = {};
+            --m_num_enabled;
+        }
+
+        /// <!-- description -->
+        ///   @brief Returns the GPA of the first page in the provided slot.
+        ///     If dirty logging is not enabled on the provided slot,
+        ///     bsl::safe_u64::failure() is returned.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param slot the slot to query
+        ///   @return Returns the GPA of the first page in the provided slot.
+        ///     If dirty logging is not enabled on the provided slot,
+        ///     bsl::safe_u64::failure() is returned.
+        ///
+        [[nodiscard]] constexpr auto
+        gpa(bsl::safe_u64 const &slot) const noexcept -> bsl::safe_u64
+        {
+            auto const *const slt{this->get_slot(slot)};
+            if (bsl::unlikely(nullptr == slt)) {
+                bsl::print<bsl::V>() << bsl::here();
+                return bsl::safe_u64::failure();
+            }
+
+            return slt->gpa;
+        }
+
+        /// <!-- description -->
+        ///   @brief Returns the total number of pages in the provided slot.
+        ///     If dirty logging is not enabled on the provided slot,
+        ///     bsl::safe_u64::failure() is returned.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param slot the slot to query
+        ///   @return Returns the total number of pages in the provided slot.
+        ///     If dirty logging is not enabled on the provided slot,
+        ///     bsl::safe_u64::failure() is returned.
+        ///
+        [[nodiscard]] constexpr auto
+        num_pages(bsl::safe_u64 const &slot) const noexcept -> bsl::safe_u64
+        {
+            auto const *const slt{this->get_slot(slot)};
+            if (bsl::unlikely(nullptr == slt)) {
+                bsl::print<bsl::V>() << bsl::here();
+                return bsl::safe_u64::failure();
+            }
+
+            return slt->num_pages;
+        }
+
+        /// <!-- description -->
+        ///   @brief Returns a pointer to the dirty log entry of the provided
+        ///     slot that describes the provided page. Each entry describes
+        ///     DIRTY_LOG_PAGES_PER_ENTRY pages, starting with the first
+        ///     page that is a multiple of DIRTY_LOG_PAGES_PER_ENTRY.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param slot the slot to query
+        ///   @param page the index of the page in the slot to query
+        ///   @return Returns a pointer to the dirty log entry of the provided
+        ///     slot that describes the provided page.
+        ///
+        [[nodiscard]] constexpr auto
+        entry(bsl::safe_u64 const &slot, bsl::safe_u64 const &page) noexcept -> bsl::uint64 *
+        {
+            auto const *const slt{this->get_slot(slot)};
+            bsl::expects(nullptr != slt);
+            bsl::expects(page < slt->num_pages);
+
+            auto const max_pages{hypercall::MV_DIRTY_BITMAP_MAX_PAGES};
+            auto const pg_idx{bsl::to_idx(page / max_pages)};
+            auto const entry_idx{bsl::to_idx((page % max_pages) / DIRTY_LOG_PAGES_PER_ENTRY)};
+
+            auto *const pmut_page{*slt->table->pages.at_if(pg_idx)};
+            bsl::ensures(nullptr != pmut_page);
+
+            return pmut_page->entries.at_if(entry_idx);
+        }
+
+        /// <!-- description -->
+        ///   @brief Marks the page that contains the provided GPA as dirty.
+        ///     If the GPA is not in a slot that has dirty logging enabled,
+        ///     false is returned and nothing is marked. If the page was not
+        ///     already dirty, the provided dirty gfn is filled in with the
+        ///     slot and offset of the page and MV_DIRTY_GFN_FLAG_DIRTY so
+        ///     that the caller can add it to a dirty ring. Otherwise, the
+        ///     flags of the dirty gfn are set to 0.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param gpa the GPA that was written to
+        ///   @param mut_gfn where to return the dirty gfn of the page
+        ///   @return Returns true if the page that contains the provided GPA
+        ///     is dirty logged, false otherwise.
+        ///
+        [[nodiscard]] constexpr auto
+        mark(bsl::safe_u64 const &gpa, hypercall::mv_dirty_gfn_t &mut_gfn) noexcept -> bool
+        {
+            bsl::expects(gpa.is_valid_and_checked());
+
+            mut_gfn = {};
+            if (m_num_enabled.is_zero()) {
+                return false;
+            }
+
+            auto const gfn{(gpa >> PAGE_4K_T_SHFT).checked()};
+            for (bsl::safe_idx mut_i{}; mut_i < m_slots.size(); ++mut_i) {
+                auto const page{page_in_slot(*m_slots.at_if(mut_i), gfn)};
+                if (page.is_valid()) {
+                    auto const mask{1_u64 << (page % DIRTY_LOG_PAGES_PER_ENTRY).checked()};
+                    auto *const pmut_entry{this->entry(bsl::to_u64(mut_i), page)};
+                    auto const old{bsl::safe_u64{*pmut_entry}};
+
+                    if ((old & mask).is_zero()) {
+                        mut_gfn.flags = hypercall::MV_DIRTY_GFN_FLAG_DIRTY.get();
+                        mut_gfn.slot = bsl::to_u32(mut_i.get()).get();
+                        mut_gfn.offset = page.get();
+                    }
+                    else {
+                        bsl::touch();
+                    }
+
+                    *pmut_entry = (old | mask).get();
+                    return true;
+                }
+
+                bsl::touch();
+            }
+
+            return false;
+        }
+
+        /// <!-- description -->
+        ///   @brief Returns true if the page that contains the provided GPA
+        ///     is in a slot that has dirty logging enabled and has not been
+        ///     marked as dirty. Such a page must not be writable, otherwise
+        ///     the first write to it would not be logged.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param gpa the GPA to query
+        ///   @return Returns true if the page that contains the provided GPA
+        ///     is dirty logged and clean, false otherwise.
+        ///
+        [[nodiscard]] constexpr auto
+        clean(bsl::safe_u64 const &gpa) noexcept -> bool
+        {
+            bsl::expects(gpa.is_valid_and_checked());
+
+            if (m_num_enabled.is_zero()) {
+                return false;
+            }
+
+            auto const gfn{(gpa >> PAGE_4K_T_SHFT).checked()};
+            for (bsl::safe_idx mut_i{}; mut_i < m_slots.size(); ++mut_i) {
+                auto const page{page_in_slot(*m_slots.at_if(mut_i), gfn)};
+                if (page.is_valid()) {
+                    auto const mask{1_u64 << (page % DIRTY_LOG_PAGES_PER_ENTRY).checked()};
+                    auto const val{bsl::safe_u64{*this->entry(bsl::to_u64(mut_i), page)}};
+                    return (val & mask).is_zero();
+                }
+
+                bsl::touch();
+            }
+
+            return false;
+        }
+    };
+}
+
+#endif
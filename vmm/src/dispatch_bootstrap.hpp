@@ -103,7 +103,9 @@ namespace microv
             vmid,
             vpid,
             ppid,
-            mut_vm_pool.slpt_spa(vmid))};
+            mut_vm_pool.slpt_spa(vmid),
+            mut_vm_pool.iopm_spa(vmid),
+            mut_vm_pool.msrpm_spa(vmid))};
         if (bsl::unlikely(vsid.is_invalid())) {
             bsl::print<bsl::V>() << bsl::here();
             return bsl::errc_failure;
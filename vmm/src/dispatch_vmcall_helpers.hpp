@@ -27,7 +27,9 @@
 
 #include <bf_syscall_t.hpp>
 #include <dispatch_abi_helpers.hpp>
+#include <mv_cdl_t.hpp>
 #include <mv_reg_t.hpp>
+#include <xsave_t.hpp>
 
 #include <bsl/convert.hpp>
 #include <bsl/debug.hpp>
@@ -161,7 +163,7 @@ namespace microv
             return false;
         }
 
-        auto const vpid{vp_pool.vp_assigned_to_vm(vmid)};
+        auto const vpid{vp_pool.vp_assigned_to_vm(tls, vmid)};
         if (bsl::unlikely(vpid.is_valid())) {
             bsl::error() << "vm "                                 // --
                          << bsl::hex(vmid)                        // --
@@ -182,6 +184,7 @@ namespace microv
     ///     provided vpid is destroyable. Returns false otherwise.
     ///
     /// <!-- inputs/outputs -->
+    ///   @param tls the current TLS block
     ///   @param sys the bf_syscall_t to use
     ///   @param vp_pool the vp_pool_t to use
     ///   @param vs_pool the vs_pool_t to use
@@ -191,6 +194,7 @@ namespace microv
     ///
     [[nodiscard]] constexpr auto
     is_vp_destroyable(
+        tls_t const &tls,
         syscall::bf_syscall_t const &sys,
         vp_pool_t const &vp_pool,
         vs_pool_t const &vs_pool,
@@ -219,7 +223,7 @@ namespace microv
             return false;
         }
 
-        auto const vsid{vs_pool.vs_assigned_to_vp(vpid)};
+        auto const vsid{vs_pool.vs_assigned_to_vp(tls, vpid)};
         if (bsl::unlikely(vsid.is_valid())) {
             bsl::error() << "vp "                                 // --
                          << bsl::hex(vpid)                        // --
@@ -315,6 +319,31 @@ namespace microv
         return true;
     }
 
+    /// <!-- description -->
+    ///   @brief Returns true if the CDL is safe to use. Returns
+    ///     false otherwise.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param cdl the CDL to verify
+    ///   @return Returns true if the CDL is safe to use. Returns
+    ///     false otherwise.
+    ///
+    [[nodiscard]] constexpr auto
+    is_cdl_safe(hypercall::mv_cdl_t const &cdl) noexcept -> bool
+    {
+        if (bsl::unlikely(cdl.num_entries > cdl.entries.size())) {
+            bsl::error() << "cdl.num_entries "           // --
+                         << bsl::hex(cdl.num_entries)    // --
+                         << " is out of range "          // --
+                         << bsl::endl                    // --
+                         << bsl::here();                 // --
+
+            return false;
+        }
+
+        return true;
+    }
+
     /// <!-- description -->
     ///   @brief Returns true if the RDL is safe to use. Returns
     ///     false otherwise.
@@ -1505,6 +1534,41 @@ namespace microv
     /// Run/Switch Functions
     /// ------------------------------------------------------------------------
 
+    /// <!-- description -->
+    ///   @brief Undoes what run_guest did before it failed, making the
+    ///     parent VM, VP and VS active again, just like they were before
+    ///     run_guest was called. The parent VS must still be the active VS
+    ///     from the point of view of the microkernel.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param mut_tls the tls_t to use
+    ///   @param intrinsic the intrinsic_t to use
+    ///   @param mut_vm_pool the vm_pool_t to use
+    ///   @param mut_vp_pool the vp_pool_t to use
+    ///   @param mut_vs_pool the vs_pool_t to use
+    ///   @param vmid the ID of the VM run_guest marked as active
+    ///
+    constexpr void
+    run_guest_undo(
+        tls_t &mut_tls,
+        intrinsic_t const &intrinsic,
+        vm_pool_t &mut_vm_pool,
+        vp_pool_t &mut_vp_pool,
+        vs_pool_t &mut_vs_pool,
+        bsl::safe_u16 const &vmid) noexcept
+    {
+        mut_vm_pool.set_inactive(mut_tls, vmid);
+
+        mut_vm_pool.set_active(mut_tls, mut_tls.parent_vmid);
+        mut_vp_pool.set_active(mut_tls, mut_tls.parent_vpid);
+        mut_vs_pool.set_active(mut_tls, intrinsic, mut_tls.parent_vsid);
+
+        mut_tls.xsave_mask = XSAVE_ALL;
+        mut_tls.parent_vmid = hypercall::MV_INVALID_ID;
+        mut_tls.parent_vpid = hypercall::MV_INVALID_ID;
+        mut_tls.parent_vsid = hypercall::MV_INVALID_ID;
+    }
+
     /// <!-- description -->
     ///   @brief Run's a guest vs_t. When a guest VM is run, it becomes a
     ///     child, and the current VM, VP and VS become parents. The next
@@ -1573,21 +1637,68 @@ namespace microv
             return bsl::errc_failure;
         }
 
+        /// NOTE:
+        /// - Registers set by the root VM while the VS was not active are
+        ///   held in the VS's register cache. They have to be written back
+        ///   before the microkernel loads the VS, which is what makes the
+        ///   values visible to the guest.
+        ///
+
+        auto const reg_ret{mut_vs_pool.reg_flush(mut_sys, vsid)};
+        if (bsl::unlikely(!reg_ret)) {
+            bsl::print<bsl::V>() << bsl::here();
+            return reg_ret;
+        }
+
         mut_tls.parent_vmid = mut_sys.bf_tls_vmid();
         mut_tls.parent_vpid = mut_sys.bf_tls_vpid();
         mut_tls.parent_vsid = mut_sys.bf_tls_vsid();
 
+        /// NOTE:
+        /// - Only the state components that the guest can modify (i.e.,
+        ///   the ones enabled in its XCR0) are switched. The root VS's
+        ///   other components stay in the PP's registers while the guest
+        ///   runs, so a guest that has not enabled AVX-512 (for example)
+        ///   never moves that state. switch_to_root uses the same mask
+        ///   on the way back.
+        /// - The guest cannot change its XCR0 behind our back, as XSETBV
+        ///   always exits. If it enables more components while it runs,
+        ///   they are added to the mask then (see vs_pool_t::xcr0_set).
+        ///
+
+        mut_tls.xsave_mask = mut_vs_pool.xsave_mask(vsid);
+
         mut_vm_pool.set_inactive(mut_tls, mut_tls.parent_vmid);
         mut_vp_pool.set_inactive(mut_tls, mut_tls.parent_vpid);
         mut_vs_pool.set_inactive(mut_tls, intrinsic, mut_tls.parent_vsid);
 
+        /// NOTE:
+        /// - Memory might have been unmapped from the VM while this PP was
+        ///   not running it. If that happened, the flush was deferred to
+        ///   here. The VM has to be marked as active first so that a PP
+        ///   that unmaps memory from here on waits for this PP (see
+        ///   vm_t::tlb_flush_wait).
+        /// - The flush is done before the microkernel switches to the
+        ///   guest VS, so that if anything fails, the parent's state can
+        ///   be fully restored and the error returned to the parent.
+        ///
+
+        mut_vm_pool.set_active(mut_tls, vmid);
+
+        auto const flush_ret{mut_vm_pool.tlb_flush_if_stale(mut_tls, mut_sys, intrinsic, vmid)};
+        if (bsl::unlikely(!flush_ret)) {
+            bsl::print<bsl::V>() << bsl::here();
+            run_guest_undo(mut_tls, intrinsic, mut_vm_pool, mut_vp_pool, mut_vs_pool, vmid);
+            return flush_ret;
+        }
+
         auto const ret{mut_sys.bf_vs_op_set_active(vmid, vpid, vsid)};
         if (bsl::unlikely(!ret)) {
             bsl::print<bsl::V>() << bsl::here();
+            run_guest_undo(mut_tls, intrinsic, mut_vm_pool, mut_vp_pool, mut_vs_pool, vmid);
             return ret;
         }
 
-        mut_vm_pool.set_active(mut_tls, vmid);
         mut_vp_pool.set_active(mut_tls, vpid);
         mut_vs_pool.set_active(mut_tls, intrinsic, vsid);
 
@@ -1682,6 +1793,10 @@ namespace microv
     ///   @param mut_vm_pool the vm_pool_t to use
     ///   @param mut_vp_pool the vp_pool_t to use
     ///   @param mut_vs_pool the vs_pool_t to use
+    ///   @param advance_ip if true, the IP of the guest VS is advanced
+    ///     before the root VS is made active. Exits that are not caused
+    ///     by a completed instruction (e.g., an EPT/NPT fault) must pass
+    ///     false so that the guest retries the instruction when resumed.
     ///
     constexpr void
     switch_to_root(
@@ -1690,7 +1805,8 @@ namespace microv
         intrinsic_t const &intrinsic,
         vm_pool_t &mut_vm_pool,
         vp_pool_t &mut_vp_pool,
-        vs_pool_t &mut_vs_pool) noexcept
+        vs_pool_t &mut_vs_pool,
+        bool const advance_ip = true) noexcept
     {
         bsl::expects(!mut_sys.is_the_active_vm_the_root_vm());
         bsl::expects(mut_tls.parent_vmid != hypercall::MV_INVALID_ID);
@@ -1705,13 +1821,20 @@ namespace microv
         mut_vp_pool.set_inactive(mut_tls, vpid);
         mut_vs_pool.set_inactive(mut_tls, intrinsic, vsid);
 
-        bsl::expects(mut_sys.bf_vs_op_advance_ip_and_set_active(
-            mut_tls.parent_vmid, mut_tls.parent_vpid, mut_tls.parent_vsid));
+        if (advance_ip) {
+            bsl::expects(mut_sys.bf_vs_op_advance_ip_and_set_active(
+                mut_tls.parent_vmid, mut_tls.parent_vpid, mut_tls.parent_vsid));
+        }
+        else {
+            bsl::expects(mut_sys.bf_vs_op_set_active(
+                mut_tls.parent_vmid, mut_tls.parent_vpid, mut_tls.parent_vsid));
+        }
 
         mut_vm_pool.set_active(mut_tls, mut_tls.parent_vmid);
         mut_vp_pool.set_active(mut_tls, mut_tls.parent_vpid);
         mut_vs_pool.set_active(mut_tls, intrinsic, mut_tls.parent_vsid);
 
+        mut_tls.xsave_mask = XSAVE_ALL;
         mut_tls.parent_vmid = hypercall::MV_INVALID_ID;
         mut_tls.parent_vpid = hypercall::MV_INVALID_ID;
         mut_tls.parent_vsid = hypercall::MV_INVALID_ID;
@@ -0,0 +1,191 @@
+/// @copyright
+/// Copyright (C) 2020 Assured Information Security, Inc.
+///
+/// @copyright
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// @copyright
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// @copyright
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+
+
+#ifndef DISPATCH_VMCALL_KVM_HC_HPP
+#define DISPATCH_VMCALL_KVM_HC_HPP
+
+#include <bf_syscall_t.hpp>
+#include <dispatch_abi_helpers.hpp>
+#include <dispatch_vmcall_helpers.hpp>
+#include <errc_types.hpp>
+#include <gs_t.hpp>
+#include <intrinsic_t.hpp>
+#include <mv_constants.hpp>
+#include <mv_exit_kick_t.hpp>
+#include <mv_exit_reason_t.hpp>
+#include <page_pool_t.hpp>
+#include <pp_pool_t.hpp>
+#include <tls_t.hpp>
+#include <vm_pool_t.hpp>
+#include <vp_pool_t.hpp>
+#include <vs_pool_t.hpp>
+
+#include <bsl/convert.hpp>
+#include <bsl/debug.hpp>
+#include <bsl/discard.hpp>
+#include <bsl/errc_type.hpp>
+#include <bsl/expects.hpp>
+#include <bsl/safe_integral.hpp>
+#include <bsl/unlikely.hpp>
+
+namespace microv
+{
+    /// @brief defines the KVM_HC_KICK_CPU hypercall number
+    constexpr auto KVM_HC_KICK_CPU{5_u64};
+    /// @brief defines the value returned for unknown KVM hypercalls (-KVM_ENOSYS)
+    constexpr auto KVM_HC_ENOSYS{0xFFFFFFFFFFFFFC18_u64};
+
+    /// <!-- description -->
+    ///   @brief Implements the KVM_HC_KICK_CPU hypercall. A guest VS that
+    ///     is waiting on a paravirtual spinlock halts, and the VS that
+    ///     releases the lock kicks it using the APIC ID of the waiter. The
+    ///     kick is returned to the root VM using mv_exit_reason_t_kick,
+    ///     which is how the halted VS is made runnable again.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param mut_tls the tls_t to use
+    ///   @param mut_sys the bf_syscall_t to use
+    ///   @param intrinsic the intrinsic_t to use
+    ///   @param mut_pp_pool the pp_pool_t to use
+    ///   @param mut_vm_pool the vm_pool_t to use
+    ///   @param mut_vp_pool the vp_pool_t to use
+    ///   @param mut_vs_pool the vs_pool_t to use
+    ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+    ///     and friends otherwise
+    ///
+    [[nodiscard]] constexpr auto
+    handle_kvm_hc_kick_cpu(
+        tls_t &mut_tls,
+        syscall::bf_syscall_t &mut_sys,
+        intrinsic_t const &intrinsic,
+        pp_pool_t &mut_pp_pool,
+        vm_pool_t &mut_vm_pool,
+        vp_pool_t &mut_vp_pool,
+        vs_pool_t &mut_vs_pool) noexcept -> bsl::errc_type
+    {
+        constexpr auto apic_id_mask{0x00000000FFFFFFFF_u64};
+
+        /// NOTE:
+        /// - RBX holds flags that are reserved and RCX holds the APIC ID
+        ///   of the VS to kick. Like KVM, the kick always succeeds from
+        ///   the point of view of the guest, even if the APIC ID does not
+        ///   belong to a VS, so RAX is set to 0. switch_to_root moves the
+        ///   guest's IP past the VMCALL before returning to the root VM.
+        ///
+
+        auto const apic_id{(mut_sys.bf_tls_rcx() & apic_id_mask).checked()};
+        set_reg_return(mut_sys, bsl::safe_u64::magic_0());
+
+        // ---------------------------------------------------------------------
+        // Context: Change To Root VM
+        // ---------------------------------------------------------------------
+
+        switch_to_root(mut_tls, mut_sys, intrinsic, mut_vm_pool, mut_vp_pool, mut_vs_pool);
+
+        // ---------------------------------------------------------------------
+        // Context: Root VM
+        // ---------------------------------------------------------------------
+
+        auto mut_exit_kick{mut_pp_pool.shared_page<hypercall::mv_exit_kick_t>(mut_sys)};
+        bsl::expects(mut_exit_kick.is_valid());
+
+        mut_exit_kick->apic_id = apic_id.get();
+
+        set_reg_return(mut_sys, hypercall::MV_STATUS_SUCCESS);
+        set_reg0(mut_sys, bsl::to_u64(hypercall::EXIT_REASON_KICK));
+
+        return vmexit_success_advance_ip_and_run;
+    }
+
+    /// <!-- description -->
+    ///   @brief Dispatches KVM hypercalls made by a guest VM. Guests that
+    ///     see the KVM signature in CPUID use the KVM hypercall ABI, with
+    ///     the hypercall number in RAX, its arguments in RBX, RCX, RDX and
+    ///     RSI, and the result returned in RAX. Hypercalls that MicroV does
+    ///     not support return -KVM_ENOSYS, just like KVM.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param gs the gs_t to use
+    ///   @param mut_tls the tls_t to use
+    ///   @param mut_sys the bf_syscall_t to use
+    ///   @param page_pool the page_pool_t to use
+    ///   @param intrinsic the intrinsic_t to use
+    ///   @param mut_pp_pool the pp_pool_t to use
+    ///   @param mut_vm_pool the vm_pool_t to use
+    ///   @param mut_vp_pool the vp_pool_t to use
+    ///   @param mut_vs_pool the vs_pool_t to use
+    ///   @param vsid the ID of the VS that generated the VMExit
+    ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+    ///     and friends otherwise
+    ///
+    [[nodiscard]] constexpr auto
+    dispatch_vmcall_kvm_hc(
+        gs_t const &gs,
+        tls_t &mut_tls,
+        syscall::bf_syscall_t &mut_sys,
+        page_pool_t const &page_pool,
+        intrinsic_t const &intrinsic,
+        pp_pool_t &mut_pp_pool,
+        vm_pool_t &mut_vm_pool,
+        vp_pool_t &mut_vp_pool,
+        vs_pool_t &mut_vs_pool,
+        bsl::safe_u16 const &vsid) noexcept -> bsl::errc_type
+    {
+        bsl::discard(gs);
+        bsl::discard(page_pool);
+        bsl::discard(vsid);
+
+        bsl::expects(!mut_sys.is_the_active_vm_the_root_vm());
+
+        switch (get_reg_hypercall(mut_sys).get()) {
+            case KVM_HC_KICK_CPU.get(): {
+                auto const ret{handle_kvm_hc_kick_cpu(
+                    mut_tls,
+                    mut_sys,
+                    intrinsic,
+                    mut_pp_pool,
+                    mut_vm_pool,
+                    mut_vp_pool,
+                    mut_vs_pool)};
+
+                if (bsl::unlikely(!ret)) {
+                    bsl::print<bsl::V>() << bsl::here();
+                    return ret;
+                }
+
+                return ret;
+            }
+
+            default: {
+                break;
+            }
+        }
+
+        set_reg_return(mut_sys, KVM_HC_ENOSYS);
+        return vmexit_success_advance_ip_and_run;
+    }
+}
+
+#endif
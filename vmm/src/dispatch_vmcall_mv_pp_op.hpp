@@ -30,6 +30,7 @@
 #include <dispatch_vmcall_helpers.hpp>
 #include <gs_t.hpp>
 #include <intrinsic_t.hpp>
+#include <mv_cdl_t.hpp>
 #include <mv_constants.hpp>
 #include <page_pool_t.hpp>
 #include <pp_pool_t.hpp>
@@ -121,6 +122,66 @@ namespace microv
         return vmexit_success_advance_ip_and_run;
     }
 
+    /// <!-- description -->
+    ///   @brief Implements the mv_pp_op_cpuid_get_supported_list hypercall
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param mut_sys the bf_syscall_t to use
+    ///   @param mut_pp_pool the pp_pool_t to use
+    ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+    ///     and friends otherwise
+    ///
+    [[nodiscard]] constexpr auto
+    handle_mv_pp_op_cpuid_get_supported_list(
+        syscall::bf_syscall_t &mut_sys, pp_pool_t &mut_pp_pool) noexcept -> bsl::errc_type
+    {
+        auto mut_cdl{mut_pp_pool.shared_page<hypercall::mv_cdl_t>(mut_sys)};
+        if (bsl::unlikely(mut_cdl.is_invalid())) {
+            bsl::print<bsl::V>() << bsl::here();
+            set_reg_return(mut_sys, hypercall::MV_STATUS_FAILURE_UNKNOWN);
+            return vmexit_failure_advance_ip_and_run;
+        }
+
+        bool const cdl_safe{is_cdl_safe(*mut_cdl)};
+        if (bsl::unlikely(!cdl_safe)) {
+            bsl::print<bsl::V>() << bsl::here();
+            set_reg_return(mut_sys, hypercall::MV_STATUS_FAILURE_UNKNOWN);
+            return vmexit_failure_advance_ip_and_run;
+        }
+
+        mut_pp_pool.cpuid_get_supported_list(*mut_cdl, mut_sys.bf_tls_ppid());
+        return vmexit_success_advance_ip_and_run;
+    }
+
+    /// <!-- description -->
+    ///   @brief Implements the mv_pp_op_tsc_get_khz hypercall
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param mut_sys the bf_syscall_t to use
+    ///   @param pp_pool the pp_pool_t to use
+    ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+    ///     and friends otherwise
+    ///
+    [[nodiscard]] constexpr auto
+    handle_mv_pp_op_tsc_get_khz(syscall::bf_syscall_t &mut_sys, pp_pool_t const &pp_pool) noexcept
+        -> bsl::errc_type
+    {
+        auto const khz{pp_pool.tsc_khz(mut_sys.bf_tls_ppid())};
+        if (bsl::unlikely(khz.is_zero())) {
+            bsl::error() << "the tsc frequency of pp "         // --
+                         << bsl::hex(mut_sys.bf_tls_ppid())    // --
+                         << " is unknown"                      // --
+                         << bsl::endl                          // --
+                         << bsl::here();                       // --
+
+            set_reg_return(mut_sys, hypercall::MV_STATUS_FAILURE_UNKNOWN);
+            return vmexit_failure_advance_ip_and_run;
+        }
+
+        set_reg0(mut_sys, khz);
+        return vmexit_success_advance_ip_and_run;
+    }
+
     /// <!-- description -->
     ///   @brief Dispatches physical processor VMCalls.
     ///
@@ -202,6 +263,26 @@ namespace microv
                 return ret;
             }
 
+            case hypercall::MV_PP_OP_CPUID_GET_SUPPORTED_LIST_IDX_VAL.get(): {
+                auto const ret{handle_mv_pp_op_cpuid_get_supported_list(mut_sys, mut_pp_pool)};
+                if (bsl::unlikely(!ret)) {
+                    bsl::print<bsl::V>() << bsl::here();
+                    return ret;
+                }
+
+                return ret;
+            }
+
+            case hypercall::MV_PP_OP_TSC_GET_KHZ_IDX_VAL.get(): {
+                auto const ret{handle_mv_pp_op_tsc_get_khz(mut_sys, mut_pp_pool)};
+                if (bsl::unlikely(!ret)) {
+                    bsl::print<bsl::V>() << bsl::here();
+                    return ret;
+                }
+
+                return ret;
+            }
+
             default: {
                 break;
             }
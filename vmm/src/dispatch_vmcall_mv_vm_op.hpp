@@ -32,6 +32,8 @@
 #include <gs_t.hpp>
 #include <intrinsic_t.hpp>
 #include <mv_constants.hpp>
+#include <mv_dirty_bitmap_t.hpp>
+#include <mv_dirty_ring_t.hpp>
 #include <mv_types.hpp>
 #include <page_pool_t.hpp>
 #include <pp_pool_t.hpp>
@@ -208,6 +210,7 @@ namespace microv
     ///   @param tls the tls_t to use
     ///   @param mut_sys the bf_syscall_t to use
     ///   @param mut_page_pool the page_pool_t to use
+    ///   @param intrinsic the intrinsic_t to use
     ///   @param mut_pp_pool the pp_pool_t to use
     ///   @param mut_vm_pool the vm_pool_t to use
     ///   @return Returns bsl::errc_success on success, bsl::errc_failure
@@ -218,6 +221,7 @@ namespace microv
         tls_t const &tls,
         syscall::bf_syscall_t &mut_sys,
         page_pool_t &mut_page_pool,
+        intrinsic_t const &intrinsic,
         pp_pool_t &mut_pp_pool,
         vm_pool_t &mut_vm_pool) noexcept -> bsl::errc_type
     {
@@ -247,8 +251,310 @@ namespace microv
             return vmexit_failure_advance_ip_and_run;
         }
 
-        auto const ret{mut_vm_pool.mmio_unmap(tls, mut_sys, mut_page_pool, *mut_mdl, dst_vmid)};
+        auto const ret{
+            mut_vm_pool.mmio_unmap(tls, mut_sys, mut_page_pool, intrinsic, *mut_mdl, dst_vmid)};
+
+        if (bsl::unlikely(!ret)) {
+            bsl::print<bsl::V>() << bsl::here();
+            set_reg_return(mut_sys, hypercall::MV_STATUS_FAILURE_UNKNOWN);
+            return vmexit_failure_advance_ip_and_run;
+        }
+
+        return vmexit_success_advance_ip_and_run;
+    }
+
+    /// <!-- description -->
+    ///   @brief Implements the mv_vm_op_fork_vm hypercall
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param gs the gs_t to use
+    ///   @param tls the tls_t to use
+    ///   @param mut_sys the bf_syscall_t to use
+    ///   @param mut_page_pool the page_pool_t to use
+    ///   @param intrinsic the intrinsic_t to use
+    ///   @param mut_pp_pool the pp_pool_t to use
+    ///   @param mut_vm_pool the vm_pool_t to use
+    ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+    ///     and friends otherwise
+    ///
+    [[nodiscard]] constexpr auto
+    handle_mv_vm_op_fork_vm(
+        gs_t const &gs,
+        tls_t const &tls,
+        syscall::bf_syscall_t &mut_sys,
+        page_pool_t &mut_page_pool,
+        intrinsic_t const &intrinsic,
+        pp_pool_t &mut_pp_pool,
+        vm_pool_t &mut_vm_pool) noexcept -> bsl::errc_type
+    {
+        auto const parent_vmid{get_allocated_guest_vmid(mut_sys, get_reg1(mut_sys), mut_vm_pool)};
+        if (bsl::unlikely(parent_vmid.is_invalid())) {
+            bsl::print<bsl::V>() << bsl::here();
+            set_reg_return(mut_sys, hypercall::MV_STATUS_INVALID_INPUT_REG1);
+            return vmexit_failure_advance_ip_and_run;
+        }
+
+        auto mut_mdl{mut_pp_pool.shared_page<hypercall::mv_mdl_t>(mut_sys)};
+        if (bsl::unlikely(mut_mdl.is_invalid())) {
+            bsl::print<bsl::V>() << bsl::here();
+            set_reg_return(mut_sys, hypercall::MV_STATUS_INVALID_INPUT_REG1);
+            return vmexit_failure_advance_ip_and_run;
+        }
+
+        bool const mdl_safe{is_mdl_safe(*mut_mdl, true)};
+        if (bsl::unlikely(!mdl_safe)) {
+            bsl::print<bsl::V>() << bsl::here();
+            set_reg_return(mut_sys, hypercall::MV_STATUS_INVALID_INPUT_REG1);
+            return vmexit_failure_advance_ip_and_run;
+        }
+
+        auto const vmid{mut_vm_pool.allocate(gs, tls, mut_sys, mut_page_pool, intrinsic)};
+        if (bsl::unlikely(vmid.is_invalid())) {
+            bsl::print<bsl::V>() << bsl::here();
+            set_reg_return(mut_sys, hypercall::MV_STATUS_FAILURE_UNKNOWN);
+            return vmexit_failure_advance_ip_and_run;
+        }
+
+        auto const ret{mut_vm_pool.fork(tls, mut_sys, mut_page_pool, *mut_mdl, vmid, parent_vmid)};
+        if (bsl::unlikely(!ret)) {
+            bsl::print<bsl::V>() << bsl::here();
+            mut_vm_pool.deallocate(gs, tls, mut_sys, mut_page_pool, intrinsic, vmid);
+            set_reg_return(mut_sys, hypercall::MV_STATUS_FAILURE_UNKNOWN);
+            return vmexit_failure_advance_ip_and_run;
+        }
+
+        set_reg0(mut_sys, bsl::merge_umx_with_u16(get_reg0(mut_sys), vmid));
+        return vmexit_success_advance_ip_and_run;
+    }
+
+    /// <!-- description -->
+    ///   @brief Implements the mv_vm_op_dirty_log_enable hypercall
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param tls the tls_t to use
+    ///   @param mut_sys the bf_syscall_t to use
+    ///   @param mut_page_pool the page_pool_t to use
+    ///   @param intrinsic the intrinsic_t to use
+    ///   @param mut_pp_pool the pp_pool_t to use
+    ///   @param mut_vm_pool the vm_pool_t to use
+    ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+    ///     and friends otherwise
+    ///
+    [[nodiscard]] constexpr auto
+    handle_mv_vm_op_dirty_log_enable(
+        tls_t const &tls,
+        syscall::bf_syscall_t &mut_sys,
+        page_pool_t &mut_page_pool,
+        intrinsic_t const &intrinsic,
+        pp_pool_t &mut_pp_pool,
+        vm_pool_t &mut_vm_pool) noexcept -> bsl::errc_type
+    {
+        auto const vmid{get_allocated_guest_vmid(mut_sys, get_reg1(mut_sys), mut_vm_pool)};
+        if (bsl::unlikely(vmid.is_invalid())) {
+            bsl::print<bsl::V>() << bsl::here();
+            set_reg_return(mut_sys, hypercall::MV_STATUS_INVALID_INPUT_REG1);
+            return vmexit_failure_advance_ip_and_run;
+        }
+
+        auto mut_mdl{mut_pp_pool.shared_page<hypercall::mv_mdl_t>(mut_sys)};
+        if (bsl::unlikely(mut_mdl.is_invalid())) {
+            bsl::print<bsl::V>() << bsl::here();
+            set_reg_return(mut_sys, hypercall::MV_STATUS_INVALID_INPUT_REG1);
+            return vmexit_failure_advance_ip_and_run;
+        }
+
+        bool const mdl_safe{is_mdl_safe(*mut_mdl, true)};
+        if (bsl::unlikely(!mdl_safe)) {
+            bsl::print<bsl::V>() << bsl::here();
+            set_reg_return(mut_sys, hypercall::MV_STATUS_INVALID_INPUT_REG1);
+            return vmexit_failure_advance_ip_and_run;
+        }
+
+        auto const ret{mut_vm_pool.dirty_log_enable(
+            tls, mut_sys, mut_page_pool, intrinsic, *mut_mdl, vmid, get_reg2(mut_sys))};
+
+        if (bsl::unlikely(!ret)) {
+            bsl::print<bsl::V>() << bsl::here();
+            set_reg_return(mut_sys, hypercall::MV_STATUS_FAILURE_UNKNOWN);
+            return vmexit_failure_advance_ip_and_run;
+        }
+
+        return vmexit_success_advance_ip_and_run;
+    }
+
+    /// <!-- description -->
+    ///   @brief Implements the mv_vm_op_dirty_log_disable hypercall
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param tls the tls_t to use
+    ///   @param mut_sys the bf_syscall_t to use
+    ///   @param mut_page_pool the page_pool_t to use
+    ///   @param mut_vm_pool the vm_pool_t to use
+    ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+    ///     and friends otherwise
+    ///
+    [[nodiscard]] constexpr auto
+    handle_mv_vm_op_dirty_log_disable(
+        tls_t const &tls,
+        syscall::bf_syscall_t &mut_sys,
+        page_pool_t &mut_page_pool,
+        vm_pool_t &mut_vm_pool) noexcept -> bsl::errc_type
+    {
+        auto const vmid{get_allocated_guest_vmid(mut_sys, get_reg1(mut_sys), mut_vm_pool)};
+        if (bsl::unlikely(vmid.is_invalid())) {
+            bsl::print<bsl::V>() << bsl::here();
+            set_reg_return(mut_sys, hypercall::MV_STATUS_INVALID_INPUT_REG1);
+            return vmexit_failure_advance_ip_and_run;
+        }
+
+        auto const ret{
+            mut_vm_pool.dirty_log_disable(tls, mut_sys, mut_page_pool, vmid, get_reg2(mut_sys))};
+
+        if (bsl::unlikely(!ret)) {
+            bsl::print<bsl::V>() << bsl::here();
+            set_reg_return(mut_sys, hypercall::MV_STATUS_INVALID_INPUT_REG2);
+            return vmexit_failure_advance_ip_and_run;
+        }
+
+        return vmexit_success_advance_ip_and_run;
+    }
+
+    /// <!-- description -->
+    ///   @brief Implements the mv_vm_op_dirty_log_get hypercall
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param tls the tls_t to use
+    ///   @param mut_sys the bf_syscall_t to use
+    ///   @param mut_pp_pool the pp_pool_t to use
+    ///   @param mut_vm_pool the vm_pool_t to use
+    ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+    ///     and friends otherwise
+    ///
+    [[nodiscard]] constexpr auto
+    handle_mv_vm_op_dirty_log_get(
+        tls_t const &tls,
+        syscall::bf_syscall_t &mut_sys,
+        pp_pool_t &mut_pp_pool,
+        vm_pool_t &mut_vm_pool) noexcept -> bsl::errc_type
+    {
+        auto const vmid{get_allocated_guest_vmid(mut_sys, get_reg1(mut_sys), mut_vm_pool)};
+        if (bsl::unlikely(vmid.is_invalid())) {
+            bsl::print<bsl::V>() << bsl::here();
+            set_reg_return(mut_sys, hypercall::MV_STATUS_INVALID_INPUT_REG1);
+            return vmexit_failure_advance_ip_and_run;
+        }
+
+        auto mut_bitmap{mut_pp_pool.shared_page<hypercall::mv_dirty_bitmap_t>(mut_sys)};
+        if (bsl::unlikely(mut_bitmap.is_invalid())) {
+            bsl::print<bsl::V>() << bsl::here();
+            set_reg_return(mut_sys, hypercall::MV_STATUS_INVALID_INPUT_REG1);
+            return vmexit_failure_advance_ip_and_run;
+        }
+
+        auto const ret{mut_vm_pool.dirty_log_get(
+            tls, vmid, get_reg2(mut_sys), get_reg3(mut_sys), *mut_bitmap)};
+
+        if (bsl::unlikely(!ret)) {
+            bsl::print<bsl::V>() << bsl::here();
+            set_reg_return(mut_sys, hypercall::MV_STATUS_INVALID_INPUT_REG3);
+            return vmexit_failure_advance_ip_and_run;
+        }
+
+        return vmexit_success_advance_ip_and_run;
+    }
+
+    /// <!-- description -->
+    ///   @brief Implements the mv_vm_op_dirty_log_clear hypercall
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param tls the tls_t to use
+    ///   @param mut_sys the bf_syscall_t to use
+    ///   @param intrinsic the intrinsic_t to use
+    ///   @param mut_pp_pool the pp_pool_t to use
+    ///   @param mut_vm_pool the vm_pool_t to use
+    ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+    ///     and friends otherwise
+    ///
+    [[nodiscard]] constexpr auto
+    handle_mv_vm_op_dirty_log_clear(
+        tls_t const &tls,
+        syscall::bf_syscall_t &mut_sys,
+        intrinsic_t const &intrinsic,
+        pp_pool_t &mut_pp_pool,
+        vm_pool_t &mut_vm_pool) noexcept -> bsl::errc_type
+    {
+        auto const vmid{get_allocated_guest_vmid(mut_sys, get_reg1(mut_sys), mut_vm_pool)};
+        if (bsl::unlikely(vmid.is_invalid())) {
+            bsl::print<bsl::V>() << bsl::here();
+            set_reg_return(mut_sys, hypercall::MV_STATUS_INVALID_INPUT_REG1);
+            return vmexit_failure_advance_ip_and_run;
+        }
+
+        auto const bitmap{mut_pp_pool.shared_page<hypercall::mv_dirty_bitmap_t>(mut_sys)};
+        if (bsl::unlikely(bitmap.is_invalid())) {
+            bsl::print<bsl::V>() << bsl::here();
+            set_reg_return(mut_sys, hypercall::MV_STATUS_INVALID_INPUT_REG1);
+            return vmexit_failure_advance_ip_and_run;
+        }
+
+        auto const ret{mut_vm_pool.dirty_log_clear(
+            tls, mut_sys, intrinsic, vmid, get_reg2(mut_sys), get_reg3(mut_sys), *bitmap)};
+
+        if (bsl::unlikely(!ret)) {
+            bsl::print<bsl::V>() << bsl::here();
+            set_reg_return(mut_sys, hypercall::MV_STATUS_FAILURE_UNKNOWN);
+            return vmexit_failure_advance_ip_and_run;
+        }
+
+        return vmexit_success_advance_ip_and_run;
+    }
+
+    /// <!-- description -->
+    ///   @brief Implements the mv_vm_op_dirty_ring_reset hypercall
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param tls the tls_t to use
+    ///   @param mut_sys the bf_syscall_t to use
+    ///   @param intrinsic the intrinsic_t to use
+    ///   @param mut_pp_pool the pp_pool_t to use
+    ///   @param mut_vm_pool the vm_pool_t to use
+    ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+    ///     and friends otherwise
+    ///
+    [[nodiscard]] constexpr auto
+    handle_mv_vm_op_dirty_ring_reset(
+        tls_t const &tls,
+        syscall::bf_syscall_t &mut_sys,
+        intrinsic_t const &intrinsic,
+        pp_pool_t &mut_pp_pool,
+        vm_pool_t &mut_vm_pool) noexcept -> bsl::errc_type
+    {
+        auto const vmid{get_allocated_guest_vmid(mut_sys, get_reg1(mut_sys), mut_vm_pool)};
+        if (bsl::unlikely(vmid.is_invalid())) {
+            bsl::print<bsl::V>() << bsl::here();
+            set_reg_return(mut_sys, hypercall::MV_STATUS_INVALID_INPUT_REG1);
+            return vmexit_failure_advance_ip_and_run;
+        }
+
+        auto const ring{mut_pp_pool.shared_page<hypercall::mv_dirty_ring_t>(mut_sys)};
+        if (bsl::unlikely(ring.is_invalid())) {
+            bsl::print<bsl::V>() << bsl::here();
+            set_reg_return(mut_sys, hypercall::MV_STATUS_INVALID_INPUT_REG1);
+            return vmexit_failure_advance_ip_and_run;
+        }
+
+        if (bsl::unlikely(ring->num_entries > ring->entries.size())) {
+            bsl::error() << "the number of dirty ring entries "    // --
+                         << bsl::hex(ring->num_entries)            // --
+                         << " is out of range "                    // --
+                         << bsl::endl                              // --
+                         << bsl::here();                           // --
+
+            set_reg_return(mut_sys, hypercall::MV_STATUS_INVALID_INPUT_REG1);
+            return vmexit_failure_advance_ip_and_run;
+        }
 
+        auto const ret{mut_vm_pool.dirty_ring_reset(tls, mut_sys, intrinsic, vmid, *ring)};
         if (bsl::unlikely(!ret)) {
             bsl::print<bsl::V>() << bsl::here();
             set_reg_return(mut_sys, hypercall::MV_STATUS_FAILURE_UNKNOWN);
@@ -258,6 +564,249 @@ namespace microv
         return vmexit_success_advance_ip_and_run;
     }
 
+    /// <!-- description -->
+    ///   @brief Implements the mv_vm_op_msr_intercept hypercall
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param mut_sys the bf_syscall_t to use
+    ///   @param mut_vm_pool the vm_pool_t to use
+    ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+    ///     and friends otherwise
+    ///
+    [[nodiscard]] constexpr auto
+    handle_mv_vm_op_msr_intercept(
+        syscall::bf_syscall_t &mut_sys, vm_pool_t &mut_vm_pool) noexcept -> bsl::errc_type
+    {
+        constexpr auto all{(hypercall::MV_PERM_READ | hypercall::MV_PERM_WRITE).checked()};
+
+        auto const vmid{get_allocated_guest_vmid(mut_sys, get_reg1(mut_sys), mut_vm_pool)};
+        if (bsl::unlikely(vmid.is_invalid())) {
+            bsl::print<bsl::V>() << bsl::here();
+            set_reg_return(mut_sys, hypercall::MV_STATUS_INVALID_INPUT_REG1);
+            return vmexit_failure_advance_ip_and_run;
+        }
+
+        auto const perms{get_reg3(mut_sys)};
+        if (bsl::unlikely((perms & ~all).is_pos())) {
+            bsl::error() << "invalid msr intercept permissions "    // --
+                         << bsl::hex(perms)                         // --
+                         << bsl::endl                               // --
+                         << bsl::here();                            // --
+
+            set_reg_return(mut_sys, hypercall::MV_STATUS_INVALID_INPUT_REG3);
+            return vmexit_failure_advance_ip_and_run;
+        }
+
+        auto const msr{bsl::to_u32_unsafe(get_reg2(mut_sys))};
+        auto const ret{mut_vm_pool.msr_intercept(vmid, msr, perms)};
+        if (bsl::unlikely(!ret)) {
+            bsl::print<bsl::V>() << bsl::here();
+            set_reg_return(mut_sys, hypercall::MV_STATUS_INVALID_INPUT_REG2);
+            return vmexit_failure_advance_ip_and_run;
+        }
+
+        return vmexit_success_advance_ip_and_run;
+    }
+
+    /// <!-- description -->
+    ///   @brief Implements the mv_vm_op_io_intercept hypercall
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param mut_sys the bf_syscall_t to use
+    ///   @param mut_vm_pool the vm_pool_t to use
+    ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+    ///     and friends otherwise
+    ///
+    [[nodiscard]] constexpr auto
+    handle_mv_vm_op_io_intercept(
+        syscall::bf_syscall_t &mut_sys, vm_pool_t &mut_vm_pool) noexcept -> bsl::errc_type
+    {
+        constexpr auto first_mask{0x000000000000FFFF_u64};
+        constexpr auto last_mask{0x00000000FFFF0000_u64};
+        constexpr auto last_shft{16_u64};
+
+        auto const vmid{get_allocated_guest_vmid(mut_sys, get_reg1(mut_sys), mut_vm_pool)};
+        if (bsl::unlikely(vmid.is_invalid())) {
+            bsl::print<bsl::V>() << bsl::here();
+            set_reg_return(mut_sys, hypercall::MV_STATUS_INVALID_INPUT_REG1);
+            return vmexit_failure_advance_ip_and_run;
+        }
+
+        auto const ports{get_reg2(mut_sys)};
+        if (bsl::unlikely((ports & ~(first_mask | last_mask)).is_pos())) {
+            bsl::error() << "invalid io intercept ports "    // --
+                         << bsl::hex(ports)                  // --
+                         << bsl::endl                        // --
+                         << bsl::here();                     // --
+
+            set_reg_return(mut_sys, hypercall::MV_STATUS_INVALID_INPUT_REG2);
+            return vmexit_failure_advance_ip_and_run;
+        }
+
+        auto const type{get_reg3(mut_sys)};
+        if (bsl::unlikely(type > hypercall::MV_IO_INTERCEPT_PASSTHROUGH)) {
+            bsl::error() << "invalid io intercept type "    // --
+                         << bsl::hex(type)                  // --
+                         << bsl::endl                       // --
+                         << bsl::here();                    // --
+
+            set_reg_return(mut_sys, hypercall::MV_STATUS_INVALID_INPUT_REG3);
+            return vmexit_failure_advance_ip_and_run;
+        }
+
+        auto const first{(ports & first_mask).checked()};
+        auto const last{((ports & last_mask) >> last_shft).checked()};
+
+        auto const ret{mut_vm_pool.io_intercept(vmid, first, last, type)};
+        if (bsl::unlikely(!ret)) {
+            bsl::print<bsl::V>() << bsl::here();
+            set_reg_return(mut_sys, hypercall::MV_STATUS_INVALID_INPUT_REG2);
+            return vmexit_failure_advance_ip_and_run;
+        }
+
+        return vmexit_success_advance_ip_and_run;
+    }
+
+    /// <!-- description -->
+    ///   @brief Implements the mv_vm_op_msr_filter hypercall
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param mut_sys the bf_syscall_t to use
+    ///   @param mut_vm_pool the vm_pool_t to use
+    ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+    ///     and friends otherwise
+    ///
+    [[nodiscard]] constexpr auto
+    handle_mv_vm_op_msr_filter(
+        syscall::bf_syscall_t &mut_sys, vm_pool_t &mut_vm_pool) noexcept -> bsl::errc_type
+    {
+        constexpr auto all{(hypercall::MV_PERM_READ | hypercall::MV_PERM_WRITE).checked()};
+        constexpr auto last_shft{32_u64};
+
+        auto const vmid{get_allocated_guest_vmid(mut_sys, get_reg1(mut_sys), mut_vm_pool)};
+        if (bsl::unlikely(vmid.is_invalid())) {
+            bsl::print<bsl::V>() << bsl::here();
+            set_reg_return(mut_sys, hypercall::MV_STATUS_INVALID_INPUT_REG1);
+            return vmexit_failure_advance_ip_and_run;
+        }
+
+        auto const perms{get_reg3(mut_sys)};
+        if (bsl::unlikely((perms & ~all).is_pos())) {
+            bsl::error() << "invalid msr filter permissions "    // --
+                         << bsl::hex(perms)                      // --
+                         << bsl::endl                            // --
+                         << bsl::here();                         // --
+
+            set_reg_return(mut_sys, hypercall::MV_STATUS_INVALID_INPUT_REG3);
+            return vmexit_failure_advance_ip_and_run;
+        }
+
+        auto const msrs{get_reg2(mut_sys)};
+        auto const first{bsl::to_u32_unsafe(msrs)};
+        auto const last{bsl::to_u32_unsafe((msrs >> last_shft).checked())};
+
+        auto const ret{mut_vm_pool.msr_filter(vmid, first, last, perms)};
+        if (bsl::unlikely(!ret)) {
+            bsl::print<bsl::V>() << bsl::here();
+            set_reg_return(mut_sys, hypercall::MV_STATUS_INVALID_INPUT_REG2);
+            return vmexit_failure_advance_ip_and_run;
+        }
+
+        return vmexit_success_advance_ip_and_run;
+    }
+
+    /// <!-- description -->
+    ///   @brief Returns the current host time in nanoseconds, as measured
+    ///     by the TSC of the PP that executed the VMCall.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param sys the bf_syscall_t to use
+    ///   @param intrinsic the intrinsic_t to use
+    ///   @param pp_pool the pp_pool_t to use
+    ///   @return Returns the current host time in nanoseconds, or
+    ///     bsl::safe_u64::failure() on failure.
+    ///
+    [[nodiscard]] constexpr auto
+    get_host_ns(
+        syscall::bf_syscall_t const &sys,
+        intrinsic_t const &intrinsic,
+        pp_pool_t const &pp_pool) noexcept -> bsl::safe_u64
+    {
+        return pp_pool.tsc_to_ns(intrinsic.rdtsc(), sys.bf_tls_ppid());
+    }
+
+    /// <!-- description -->
+    ///   @brief Implements the mv_vm_op_clock_get hypercall
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param mut_sys the bf_syscall_t to use
+    ///   @param intrinsic the intrinsic_t to use
+    ///   @param pp_pool the pp_pool_t to use
+    ///   @param vm_pool the vm_pool_t to use
+    ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+    ///     and friends otherwise
+    ///
+    [[nodiscard]] constexpr auto
+    handle_mv_vm_op_clock_get(
+        syscall::bf_syscall_t &mut_sys,
+        intrinsic_t const &intrinsic,
+        pp_pool_t const &pp_pool,
+        vm_pool_t const &vm_pool) noexcept -> bsl::errc_type
+    {
+        auto const vmid{get_allocated_guest_vmid(mut_sys, get_reg1(mut_sys), vm_pool)};
+        if (bsl::unlikely(vmid.is_invalid())) {
+            bsl::print<bsl::V>() << bsl::here();
+            set_reg_return(mut_sys, hypercall::MV_STATUS_INVALID_INPUT_REG1);
+            return vmexit_failure_advance_ip_and_run;
+        }
+
+        auto const host_ns{get_host_ns(mut_sys, intrinsic, pp_pool)};
+        if (bsl::unlikely(host_ns.is_invalid())) {
+            bsl::print<bsl::V>() << bsl::here();
+            set_reg_return(mut_sys, hypercall::MV_STATUS_FAILURE_UNKNOWN);
+            return vmexit_failure_advance_ip_and_run;
+        }
+
+        set_reg0(mut_sys, vm_pool.clock_get(host_ns, vmid));
+        return vmexit_success_advance_ip_and_run;
+    }
+
+    /// <!-- description -->
+    ///   @brief Implements the mv_vm_op_clock_set hypercall
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param mut_sys the bf_syscall_t to use
+    ///   @param intrinsic the intrinsic_t to use
+    ///   @param pp_pool the pp_pool_t to use
+    ///   @param mut_vm_pool the vm_pool_t to use
+    ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+    ///     and friends otherwise
+    ///
+    [[nodiscard]] constexpr auto
+    handle_mv_vm_op_clock_set(
+        syscall::bf_syscall_t &mut_sys,
+        intrinsic_t const &intrinsic,
+        pp_pool_t const &pp_pool,
+        vm_pool_t &mut_vm_pool) noexcept -> bsl::errc_type
+    {
+        auto const vmid{get_allocated_guest_vmid(mut_sys, get_reg1(mut_sys), mut_vm_pool)};
+        if (bsl::unlikely(vmid.is_invalid())) {
+            bsl::print<bsl::V>() << bsl::here();
+            set_reg_return(mut_sys, hypercall::MV_STATUS_INVALID_INPUT_REG1);
+            return vmexit_failure_advance_ip_and_run;
+        }
+
+        auto const host_ns{get_host_ns(mut_sys, intrinsic, pp_pool)};
+        if (bsl::unlikely(host_ns.is_invalid())) {
+            bsl::print<bsl::V>() << bsl::here();
+            set_reg_return(mut_sys, hypercall::MV_STATUS_FAILURE_UNKNOWN);
+            return vmexit_failure_advance_ip_and_run;
+        }
+
+        mut_vm_pool.clock_set(host_ns, get_reg2(mut_sys), get_reg3(mut_sys), vmid);
+        return vmexit_success_advance_ip_and_run;
+    }
+
     /// <!-- description -->
     ///   @brief Dispatches virtual machine VMCalls.
     ///
@@ -349,7 +898,125 @@ namespace microv
 
             case hypercall::MV_VM_OP_MMIO_UNMAP_IDX_VAL.get(): {
                 auto const ret{handle_mv_vm_op_mmio_unmap(
-                    tls, mut_sys, mut_page_pool, mut_pp_pool, mut_vm_pool)};
+                    tls, mut_sys, mut_page_pool, intrinsic, mut_pp_pool, mut_vm_pool)};
+                if (bsl::unlikely(!ret)) {
+                    bsl::print<bsl::V>() << bsl::here();
+                    return ret;
+                }
+
+                return ret;
+            }
+
+            case hypercall::MV_VM_OP_DIRTY_LOG_ENABLE_IDX_VAL.get(): {
+                auto const ret{handle_mv_vm_op_dirty_log_enable(
+                    tls, mut_sys, mut_page_pool, intrinsic, mut_pp_pool, mut_vm_pool)};
+                if (bsl::unlikely(!ret)) {
+                    bsl::print<bsl::V>() << bsl::here();
+                    return ret;
+                }
+
+                return ret;
+            }
+
+            case hypercall::MV_VM_OP_DIRTY_LOG_DISABLE_IDX_VAL.get(): {
+                auto const ret{
+                    handle_mv_vm_op_dirty_log_disable(tls, mut_sys, mut_page_pool, mut_vm_pool)};
+                if (bsl::unlikely(!ret)) {
+                    bsl::print<bsl::V>() << bsl::here();
+                    return ret;
+                }
+
+                return ret;
+            }
+
+            case hypercall::MV_VM_OP_DIRTY_LOG_GET_IDX_VAL.get(): {
+                auto const ret{
+                    handle_mv_vm_op_dirty_log_get(tls, mut_sys, mut_pp_pool, mut_vm_pool)};
+                if (bsl::unlikely(!ret)) {
+                    bsl::print<bsl::V>() << bsl::here();
+                    return ret;
+                }
+
+                return ret;
+            }
+
+            case hypercall::MV_VM_OP_DIRTY_LOG_CLEAR_IDX_VAL.get(): {
+                auto const ret{handle_mv_vm_op_dirty_log_clear(
+                    tls, mut_sys, intrinsic, mut_pp_pool, mut_vm_pool)};
+                if (bsl::unlikely(!ret)) {
+                    bsl::print<bsl::V>() << bsl::here();
+                    return ret;
+                }
+
+                return ret;
+            }
+
+            case hypercall::MV_VM_OP_DIRTY_RING_RESET_IDX_VAL.get(): {
+                auto const ret{handle_mv_vm_op_dirty_ring_reset(
+                    tls, mut_sys, intrinsic, mut_pp_pool, mut_vm_pool)};
+                if (bsl::unlikely(!ret)) {
+                    bsl::print<bsl::V>() << bsl::here();
+                    return ret;
+                }
+
+                return ret;
+            }
+
+            case hypercall::MV_VM_OP_FORK_VM_IDX_VAL.get(): {
+                auto const ret{handle_mv_vm_op_fork_vm(
+                    gs, tls, mut_sys, mut_page_pool, intrinsic, mut_pp_pool, mut_vm_pool)};
+                if (bsl::unlikely(!ret)) {
+                    bsl::print<bsl::V>() << bsl::here();
+                    return ret;
+                }
+
+                return ret;
+            }
+
+            case hypercall::MV_VM_OP_MSR_INTERCEPT_IDX_VAL.get(): {
+                auto const ret{handle_mv_vm_op_msr_intercept(mut_sys, mut_vm_pool)};
+                if (bsl::unlikely(!ret)) {
+                    bsl::print<bsl::V>() << bsl::here();
+                    return ret;
+                }
+
+                return ret;
+            }
+
+            case hypercall::MV_VM_OP_IO_INTERCEPT_IDX_VAL.get(): {
+                auto const ret{handle_mv_vm_op_io_intercept(mut_sys, mut_vm_pool)};
+                if (bsl::unlikely(!ret)) {
+                    bsl::print<bsl::V>() << bsl::here();
+                    return ret;
+                }
+
+                return ret;
+            }
+
+            case hypercall::MV_VM_OP_MSR_FILTER_IDX_VAL.get(): {
+                auto const ret{handle_mv_vm_op_msr_filter(mut_sys, mut_vm_pool)};
+                if (bsl::unlikely(!ret)) {
+                    bsl::print<bsl::V>() << bsl::here();
+                    return ret;
+                }
+
+                return ret;
+            }
+
+            case hypercall::MV_VM_OP_CLOCK_GET_IDX_VAL.get(): {
+                auto const ret{
+                    handle_mv_vm_op_clock_get(mut_sys, intrinsic, mut_pp_pool, mut_vm_pool)};
+                if (bsl::unlikely(!ret)) {
+                    bsl::print<bsl::V>() << bsl::here();
+                    return ret;
+                }
+
+                return ret;
+            }
+
+            case hypercall::MV_VM_OP_CLOCK_SET_IDX_VAL.get(): {
+                auto const ret{
+                    handle_mv_vm_op_clock_set(mut_sys, intrinsic, mut_pp_pool, mut_vm_pool)};
                 if (bsl::unlikely(!ret)) {
                     bsl::print<bsl::V>() << bsl::here();
                     return ret;
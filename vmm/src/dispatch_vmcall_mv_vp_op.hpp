@@ -118,7 +118,7 @@ namespace microv
             return vmexit_failure_advance_ip_and_run;
         }
 
-        bool const vp_destroyable{is_vp_destroyable(mut_sys, mut_vp_pool, vs_pool, vpid)};
+        bool const vp_destroyable{is_vp_destroyable(tls, mut_sys, mut_vp_pool, vs_pool, vpid)};
         if (bsl::unlikely(!vp_destroyable)) {
             bsl::print<bsl::V>() << bsl::here();
             set_reg_return(mut_sys, hypercall::MV_STATUS_FAILURE_UNKNOWN);
@@ -31,6 +31,8 @@
 #include <gs_t.hpp>
 #include <intrinsic_t.hpp>
 #include <mv_constants.hpp>
+#include <mv_dirty_ring_t.hpp>
+#include <mv_exit_msr_t.hpp>
 #include <mv_translation_t.hpp>
 #include <page_pool_t.hpp>
 #include <pp_pool_t.hpp>
@@ -55,6 +57,7 @@ namespace microv
     ///   @param mut_sys the bf_syscall_t to use
     ///   @param mut_page_pool the page_pool_t to use
     ///   @param intrinsic the intrinsic_t to use
+    ///   @param pp_pool the pp_pool_t to use
     ///   @param vm_pool the vm_pool_t to use
     ///   @param vp_pool the vp_pool_t to use
     ///   @param mut_vs_pool the vs_pool_t to use
@@ -68,6 +71,7 @@ namespace microv
         syscall::bf_syscall_t &mut_sys,
         page_pool_t &mut_page_pool,
         intrinsic_t const &intrinsic,
+        pp_pool_t const &pp_pool,
         vm_pool_t const &vm_pool,
         vp_pool_t const &vp_pool,
         vs_pool_t &mut_vs_pool) noexcept -> bsl::errc_type
@@ -92,7 +96,9 @@ namespace microv
             vmid,
             vpid,
             tls.ppid,
-            vm_pool.slpt_spa(vmid))};
+            vm_pool.slpt_spa(vmid),
+            vm_pool.iopm_spa(vmid),
+            vm_pool.msrpm_spa(vmid))};
 
         if (bsl::unlikely(vsid.is_invalid())) {
             bsl::print<bsl::V>() << bsl::here();
@@ -100,6 +106,21 @@ namespace microv
             return vmexit_failure_advance_ip_and_run;
         }
 
+        /// NOTE:
+        /// - A new VS runs at the TSC frequency of the PP it was created
+        ///   on, which is also what it reports through CPUID, unless the
+        ///   frequency of the PP is unknown.
+        ///
+
+        auto const host_khz{pp_pool.tsc_khz(tls.ppid)};
+        if (host_khz.is_pos()) {
+            auto const ret{mut_vs_pool.tsc_set_khz(mut_sys, host_khz, host_khz, vsid)};
+            bsl::expects(bsl::errc_success == ret);
+        }
+        else {
+            bsl::touch();
+        }
+
         set_reg0(mut_sys, bsl::merge_umx_with_u16(get_reg0(mut_sys), vsid));
         return vmexit_success_advance_ip_and_run;
     }
@@ -268,6 +289,36 @@ namespace microv
         return vmexit_success_advance_ip_and_run;
     }
 
+    /// <!-- description -->
+    ///   @brief Completes the MSR access that the requested VS returned
+    ///     to software using the mv_exit_msr_t in the shared page. The
+    ///     shared page is released before returning, as run_guest does not
+    ///     return.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param mut_sys the bf_syscall_t to use
+    ///   @param mut_pp_pool the pp_pool_t to use
+    ///   @param mut_vs_pool the vs_pool_t to use
+    ///   @param vsid the ID of the VS to complete
+    ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+    ///     and friends otherwise
+    ///
+    [[nodiscard]] constexpr auto
+    complete_msr_exit(
+        syscall::bf_syscall_t &mut_sys,
+        pp_pool_t &mut_pp_pool,
+        vs_pool_t &mut_vs_pool,
+        bsl::safe_u16 const &vsid) noexcept -> bsl::errc_type
+    {
+        auto const exit{mut_pp_pool.shared_page<hypercall::mv_exit_msr_t>(mut_sys)};
+        if (bsl::unlikely(exit.is_invalid())) {
+            bsl::print<bsl::V>() << bsl::here();
+            return bsl::errc_failure;
+        }
+
+        return mut_vs_pool.msr_exit_complete(mut_sys, *exit, vsid);
+    }
+
     /// <!-- description -->
     ///   @brief Implements the mv_vs_op_run hypercall
     ///
@@ -275,6 +326,7 @@ namespace microv
     ///   @param mut_tls the tls_t to use
     ///   @param mut_sys the bf_syscall_t to use
     ///   @param intrinsic the intrinsic_t to use
+    ///   @param mut_pp_pool the pp_pool_t to use
     ///   @param mut_vm_pool the vm_pool_t to use
     ///   @param mut_vp_pool the vp_pool_t to use
     ///   @param mut_vs_pool the vs_pool_t to use
@@ -286,6 +338,7 @@ namespace microv
         tls_t &mut_tls,
         syscall::bf_syscall_t &mut_sys,
         intrinsic_t const &intrinsic,
+        pp_pool_t &mut_pp_pool,
         vm_pool_t &mut_vm_pool,
         vp_pool_t &mut_vp_pool,
         vs_pool_t &mut_vs_pool) noexcept -> bsl::errc_type
@@ -297,6 +350,56 @@ namespace microv
             return vmexit_failure_advance_ip_and_run;
         }
 
+        /// NOTE:
+        /// - If the last exit returned an MSR access to software, the
+        ///   shared page holds its result, which has to be applied before
+        ///   the VS can continue.
+        ///
+
+        if (mut_vs_pool.msr_exit_pending(vsid)) {
+            auto const msr_ret{complete_msr_exit(mut_sys, mut_pp_pool, mut_vs_pool, vsid)};
+            if (bsl::unlikely(!msr_ret)) {
+                bsl::print<bsl::V>() << bsl::here();
+                set_reg_return(mut_sys, hypercall::MV_STATUS_FAILURE_UNKNOWN);
+                return vmexit_failure_advance_ip_and_run;
+            }
+
+            bsl::touch();
+        }
+        else {
+            bsl::touch();
+        }
+
+        /// NOTE:
+        /// - The kvmclock structures of the VS are out of date if it was
+        ///   migrated to this PP, its TSC was changed, or the VM's clock
+        ///   was set since they were last written. Like KVM, failing to
+        ///   write them does not stop the VS from running.
+        ///
+
+        auto const clock_ret{
+            mut_vs_pool.clock_update(mut_tls, mut_sys, mut_pp_pool, mut_vm_pool, intrinsic, vsid)};
+        if (bsl::unlikely(!clock_ret)) {
+            bsl::print<bsl::V>() << bsl::here();
+        }
+        else {
+            bsl::touch();
+        }
+
+        /// NOTE:
+        /// - If the guest asked for a TLB flush instead of sending this VS
+        ///   an IPI while it was preempted, the flush has to happen before
+        ///   the VS runs, otherwise it could use a stale translation.
+        ///
+
+        auto const steal_ret{mut_vs_pool.steal_time_sync(
+            mut_tls, mut_sys, mut_pp_pool, mut_vm_pool, intrinsic, vsid)};
+        if (bsl::unlikely(!steal_ret)) {
+            bsl::print<bsl::V>() << bsl::here();
+            set_reg_return(mut_sys, hypercall::MV_STATUS_FAILURE_UNKNOWN);
+            return vmexit_failure_advance_ip_and_run;
+        }
+
         auto const ret{
             run_guest(mut_tls, mut_sys, intrinsic, mut_vm_pool, mut_vp_pool, mut_vs_pool, vsid)};
 
@@ -309,6 +412,70 @@ namespace microv
         return bsl::errc_success;
     }
 
+    /// <!-- description -->
+    ///   @brief Implements the mv_vs_op_cpuid_set_list hypercall
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param tls the tls_t to use
+    ///   @param mut_sys the bf_syscall_t to use
+    ///   @param mut_page_pool the page_pool_t to use
+    ///   @param mut_pp_pool the pp_pool_t to use
+    ///   @param mut_vs_pool the vs_pool_t to use
+    ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+    ///     and friends otherwise
+    ///
+    [[nodiscard]] constexpr auto
+    handle_mv_vs_op_cpuid_set_list(
+        tls_t const &tls,
+        syscall::bf_syscall_t &mut_sys,
+        page_pool_t &mut_page_pool,
+        pp_pool_t &mut_pp_pool,
+        vs_pool_t &mut_vs_pool) noexcept -> bsl::errc_type
+    {
+        bsl::errc_type mut_ret{};
+
+        auto const vsid{get_allocated_non_self_vsid(mut_sys, get_reg1(mut_sys), mut_vs_pool)};
+        if (bsl::unlikely(vsid.is_invalid())) {
+            bsl::print<bsl::V>() << bsl::here();
+            set_reg_return(mut_sys, hypercall::MV_STATUS_INVALID_INPUT_REG1);
+            return vmexit_failure_advance_ip_and_run;
+        }
+
+        if (bsl::unlikely(mut_sys.is_vs_a_root_vs(vsid))) {
+            bsl::error() << "the cpuid leaves of root vs "    // --
+                         << bsl::hex(vsid)                    // --
+                         << " cannot be set"                  // --
+                         << bsl::endl                         // --
+                         << bsl::here();                      // --
+
+            set_reg_return(mut_sys, hypercall::MV_STATUS_INVALID_INPUT_REG1);
+            return vmexit_failure_advance_ip_and_run;
+        }
+
+        auto const cdl{mut_pp_pool.shared_page<hypercall::mv_cdl_t>(mut_sys)};
+        if (bsl::unlikely(cdl.is_invalid())) {
+            bsl::print<bsl::V>() << bsl::here();
+            set_reg_return(mut_sys, hypercall::MV_STATUS_FAILURE_UNKNOWN);
+            return vmexit_failure_advance_ip_and_run;
+        }
+
+        bool const cdl_safe{is_cdl_safe(*cdl)};
+        if (bsl::unlikely(!cdl_safe)) {
+            bsl::print<bsl::V>() << bsl::here();
+            set_reg_return(mut_sys, hypercall::MV_STATUS_FAILURE_UNKNOWN);
+            return vmexit_failure_advance_ip_and_run;
+        }
+
+        mut_ret = mut_vs_pool.cpuid_set_list(tls, mut_sys, mut_page_pool, *cdl, vsid);
+        if (bsl::unlikely(!mut_ret)) {
+            bsl::print<bsl::V>() << bsl::here();
+            set_reg_return(mut_sys, hypercall::MV_STATUS_FAILURE_UNKNOWN);
+            return vmexit_failure_advance_ip_and_run;
+        }
+
+        return vmexit_success_advance_ip_and_run;
+    }
+
     /// <!-- description -->
     ///   @brief Implements the mv_vs_op_reg_get hypercall
     ///
@@ -473,15 +640,31 @@ namespace microv
     ///
     /// <!-- inputs/outputs -->
     ///   @param mut_sys the bf_syscall_t to use
+    ///   @param mut_vs_pool the vs_pool_t to use
     ///   @return Returns bsl::errc_success on success, bsl::errc_failure
     ///     and friends otherwise
     ///
     [[nodiscard]] constexpr auto
-    handle_mv_vs_op_msr_get(syscall::bf_syscall_t &mut_sys) noexcept -> bsl::errc_type
+    handle_mv_vs_op_msr_get(syscall::bf_syscall_t &mut_sys, vs_pool_t &mut_vs_pool) noexcept
+        -> bsl::errc_type
     {
-        bsl::error() << "mv_vs_op_msr_get not currently implemented\n";
-        set_reg_return(mut_sys, hypercall::MV_STATUS_FAILURE_UNKNOWN);
-        return vmexit_failure_advance_ip_and_run;
+        auto const vsid{get_allocated_non_self_vsid(mut_sys, get_reg1(mut_sys), mut_vs_pool)};
+        if (bsl::unlikely(vsid.is_invalid())) {
+            bsl::print<bsl::V>() << bsl::here();
+            set_reg_return(mut_sys, hypercall::MV_STATUS_INVALID_INPUT_REG1);
+            return vmexit_failure_advance_ip_and_run;
+        }
+
+        auto const msr{bsl::to_u32_unsafe(get_reg2(mut_sys))};
+        auto const val{mut_vs_pool.msr_get(mut_sys, msr, vsid)};
+        if (bsl::unlikely(val.is_invalid())) {
+            bsl::print<bsl::V>() << bsl::here();
+            set_reg_return(mut_sys, hypercall::MV_STATUS_INVALID_INPUT_REG2);
+            return vmexit_failure_advance_ip_and_run;
+        }
+
+        set_reg0(mut_sys, val);
+        return vmexit_success_advance_ip_and_run;
     }
 
     /// <!-- description -->
@@ -489,15 +672,30 @@ namespace microv
     ///
     /// <!-- inputs/outputs -->
     ///   @param mut_sys the bf_syscall_t to use
+    ///   @param mut_vs_pool the vs_pool_t to use
     ///   @return Returns bsl::errc_success on success, bsl::errc_failure
     ///     and friends otherwise
     ///
     [[nodiscard]] constexpr auto
-    handle_mv_vs_op_msr_set(syscall::bf_syscall_t &mut_sys) noexcept -> bsl::errc_type
+    handle_mv_vs_op_msr_set(syscall::bf_syscall_t &mut_sys, vs_pool_t &mut_vs_pool) noexcept
+        -> bsl::errc_type
     {
-        bsl::error() << "mv_vs_op_msr_set not currently implemented\n";
-        set_reg_return(mut_sys, hypercall::MV_STATUS_FAILURE_UNKNOWN);
-        return vmexit_failure_advance_ip_and_run;
+        auto const vsid{get_allocated_non_self_vsid(mut_sys, get_reg1(mut_sys), mut_vs_pool)};
+        if (bsl::unlikely(vsid.is_invalid())) {
+            bsl::print<bsl::V>() << bsl::here();
+            set_reg_return(mut_sys, hypercall::MV_STATUS_INVALID_INPUT_REG1);
+            return vmexit_failure_advance_ip_and_run;
+        }
+
+        auto const msr{bsl::to_u32_unsafe(get_reg2(mut_sys))};
+        auto const ret{mut_vs_pool.msr_set(mut_sys, msr, get_reg3(mut_sys), vsid)};
+        if (bsl::unlikely(!ret)) {
+            bsl::print<bsl::V>() << bsl::here();
+            set_reg_return(mut_sys, hypercall::MV_STATUS_INVALID_INPUT_REG2);
+            return vmexit_failure_advance_ip_and_run;
+        }
+
+        return vmexit_success_advance_ip_and_run;
     }
 
     /// <!-- description -->
@@ -505,14 +703,44 @@ namespace microv
     ///
     /// <!-- inputs/outputs -->
     ///   @param mut_sys the bf_syscall_t to use
+    ///   @param mut_pp_pool the pp_pool_t to use
+    ///   @param mut_vs_pool the vs_pool_t to use
     ///   @return Returns bsl::errc_success on success, bsl::errc_failure
     ///     and friends otherwise
     ///
     [[nodiscard]] constexpr auto
-    handle_mv_vs_op_msr_get_list(syscall::bf_syscall_t &mut_sys) noexcept -> bsl::errc_type
+    handle_mv_vs_op_msr_get_list(
+        syscall::bf_syscall_t &mut_sys, pp_pool_t &mut_pp_pool, vs_pool_t &mut_vs_pool) noexcept
+        -> bsl::errc_type
     {
-        /// TODO: implement me
-        set_reg_return(mut_sys, hypercall::MV_STATUS_SUCCESS);
+        auto const vsid{get_allocated_non_self_vsid(mut_sys, get_reg1(mut_sys), mut_vs_pool)};
+        if (bsl::unlikely(vsid.is_invalid())) {
+            bsl::print<bsl::V>() << bsl::here();
+            set_reg_return(mut_sys, hypercall::MV_STATUS_INVALID_INPUT_REG1);
+            return vmexit_failure_advance_ip_and_run;
+        }
+
+        auto mut_rdl{mut_pp_pool.shared_page<hypercall::mv_rdl_t>(mut_sys)};
+        if (bsl::unlikely(mut_rdl.is_invalid())) {
+            bsl::print<bsl::V>() << bsl::here();
+            set_reg_return(mut_sys, hypercall::MV_STATUS_FAILURE_UNKNOWN);
+            return vmexit_failure_advance_ip_and_run;
+        }
+
+        bool const rdl_safe{is_rdl_safe(*mut_rdl)};
+        if (bsl::unlikely(!rdl_safe)) {
+            bsl::print<bsl::V>() << bsl::here();
+            set_reg_return(mut_sys, hypercall::MV_STATUS_FAILURE_UNKNOWN);
+            return vmexit_failure_advance_ip_and_run;
+        }
+
+        auto const ret{mut_vs_pool.msr_get_list(mut_sys, *mut_rdl, vsid)};
+        if (bsl::unlikely(!ret)) {
+            bsl::print<bsl::V>() << bsl::here();
+            set_reg_return(mut_sys, hypercall::MV_STATUS_FAILURE_UNKNOWN);
+            return vmexit_failure_advance_ip_and_run;
+        }
+
         return vmexit_success_advance_ip_and_run;
     }
 
@@ -521,14 +749,44 @@ namespace microv
     ///
     /// <!-- inputs/outputs -->
     ///   @param mut_sys the bf_syscall_t to use
+    ///   @param mut_pp_pool the pp_pool_t to use
+    ///   @param mut_vs_pool the vs_pool_t to use
     ///   @return Returns bsl::errc_success on success, bsl::errc_failure
     ///     and friends otherwise
     ///
     [[nodiscard]] constexpr auto
-    handle_mv_vs_op_msr_set_list(syscall::bf_syscall_t &mut_sys) noexcept -> bsl::errc_type
+    handle_mv_vs_op_msr_set_list(
+        syscall::bf_syscall_t &mut_sys, pp_pool_t &mut_pp_pool, vs_pool_t &mut_vs_pool) noexcept
+        -> bsl::errc_type
     {
-        /// TODO: implement me
-        set_reg_return(mut_sys, hypercall::MV_STATUS_SUCCESS);
+        auto const vsid{get_allocated_non_self_vsid(mut_sys, get_reg1(mut_sys), mut_vs_pool)};
+        if (bsl::unlikely(vsid.is_invalid())) {
+            bsl::print<bsl::V>() << bsl::here();
+            set_reg_return(mut_sys, hypercall::MV_STATUS_INVALID_INPUT_REG1);
+            return vmexit_failure_advance_ip_and_run;
+        }
+
+        auto const rdl{mut_pp_pool.shared_page<hypercall::mv_rdl_t>(mut_sys)};
+        if (bsl::unlikely(rdl.is_invalid())) {
+            bsl::print<bsl::V>() << bsl::here();
+            set_reg_return(mut_sys, hypercall::MV_STATUS_FAILURE_UNKNOWN);
+            return vmexit_failure_advance_ip_and_run;
+        }
+
+        bool const rdl_safe{is_rdl_safe(*rdl)};
+        if (bsl::unlikely(!rdl_safe)) {
+            bsl::print<bsl::V>() << bsl::here();
+            set_reg_return(mut_sys, hypercall::MV_STATUS_FAILURE_UNKNOWN);
+            return vmexit_failure_advance_ip_and_run;
+        }
+
+        auto const ret{mut_vs_pool.msr_set_list(mut_sys, *rdl, vsid)};
+        if (bsl::unlikely(!ret)) {
+            bsl::print<bsl::V>() << bsl::here();
+            set_reg_return(mut_sys, hypercall::MV_STATUS_FAILURE_UNKNOWN);
+            return vmexit_failure_advance_ip_and_run;
+        }
+
         return vmexit_success_advance_ip_and_run;
     }
 
@@ -598,6 +856,128 @@ namespace microv
         return vmexit_success_advance_ip_and_run;
     }
 
+    /// <!-- description -->
+    ///   @brief Implements the mv_vs_op_dirty_ring_get hypercall
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param mut_sys the bf_syscall_t to use
+    ///   @param mut_pp_pool the pp_pool_t to use
+    ///   @param mut_vs_pool the vs_pool_t to use
+    ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+    ///     and friends otherwise
+    ///
+    [[nodiscard]] constexpr auto
+    handle_mv_vs_op_dirty_ring_get(
+        syscall::bf_syscall_t &mut_sys, pp_pool_t &mut_pp_pool, vs_pool_t &mut_vs_pool) noexcept
+        -> bsl::errc_type
+    {
+        auto const vsid{get_allocated_non_self_vsid(mut_sys, get_reg1(mut_sys), mut_vs_pool)};
+        if (bsl::unlikely(vsid.is_invalid())) {
+            bsl::print<bsl::V>() << bsl::here();
+            set_reg_return(mut_sys, hypercall::MV_STATUS_INVALID_INPUT_REG1);
+            return vmexit_failure_advance_ip_and_run;
+        }
+
+        auto mut_ring{mut_pp_pool.shared_page<hypercall::mv_dirty_ring_t>(mut_sys)};
+        if (bsl::unlikely(mut_ring.is_invalid())) {
+            bsl::print<bsl::V>() << bsl::here();
+            set_reg_return(mut_sys, hypercall::MV_STATUS_INVALID_INPUT_REG1);
+            return vmexit_failure_advance_ip_and_run;
+        }
+
+        if (bsl::unlikely(mut_ring->num_entries > mut_ring->entries.size())) {
+            bsl::error() << "the number of dirty ring entries "    // --
+                         << bsl::hex(mut_ring->num_entries)        // --
+                         << " is out of range "                    // --
+                         << bsl::endl                              // --
+                         << bsl::here();                           // --
+
+            set_reg_return(mut_sys, hypercall::MV_STATUS_INVALID_INPUT_REG1);
+            return vmexit_failure_advance_ip_and_run;
+        }
+
+        mut_vs_pool.dirty_ring_get(*mut_ring, vsid);
+        return vmexit_success_advance_ip_and_run;
+    }
+
+    /// <!-- description -->
+    ///   @brief Implements the mv_vs_op_tsc_set_khz hypercall
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param mut_sys the bf_syscall_t to use
+    ///   @param pp_pool the pp_pool_t to use
+    ///   @param mut_vs_pool the vs_pool_t to use
+    ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+    ///     and friends otherwise
+    ///
+    [[nodiscard]] constexpr auto
+    handle_mv_vs_op_tsc_set_khz(
+        syscall::bf_syscall_t &mut_sys, pp_pool_t const &pp_pool, vs_pool_t &mut_vs_pool) noexcept
+        -> bsl::errc_type
+    {
+        auto const vsid{get_allocated_non_self_vsid(mut_sys, get_reg1(mut_sys), mut_vs_pool)};
+        if (bsl::unlikely(vsid.is_invalid())) {
+            bsl::print<bsl::V>() << bsl::here();
+            set_reg_return(mut_sys, hypercall::MV_STATUS_INVALID_INPUT_REG1);
+            return vmexit_failure_advance_ip_and_run;
+        }
+
+        auto const khz{get_reg2(mut_sys)};
+        if (bsl::unlikely(khz.is_zero())) {
+            bsl::error() << "the tsc frequency cannot be 0"    // --
+                         << bsl::endl                          // --
+                         << bsl::here();                       // --
+
+            set_reg_return(mut_sys, hypercall::MV_STATUS_INVALID_INPUT_REG2);
+            return vmexit_failure_advance_ip_and_run;
+        }
+
+        auto const host_khz{pp_pool.tsc_khz(mut_sys.bf_tls_ppid())};
+        if (bsl::unlikely(host_khz.is_zero())) {
+            bsl::error() << "the tsc frequency of pp "         // --
+                         << bsl::hex(mut_sys.bf_tls_ppid())    // --
+                         << " is unknown"                      // --
+                         << bsl::endl                          // --
+                         << bsl::here();                       // --
+
+            set_reg_return(mut_sys, hypercall::MV_STATUS_FAILURE_UNKNOWN);
+            return vmexit_failure_advance_ip_and_run;
+        }
+
+        auto const ret{mut_vs_pool.tsc_set_khz(mut_sys, host_khz, khz, vsid)};
+        if (bsl::unlikely(!ret)) {
+            bsl::print<bsl::V>() << bsl::here();
+            set_reg_return(mut_sys, hypercall::MV_STATUS_INVALID_INPUT_REG2);
+            return vmexit_failure_advance_ip_and_run;
+        }
+
+        return vmexit_success_advance_ip_and_run;
+    }
+
+    /// <!-- description -->
+    ///   @brief Implements the mv_vs_op_tsc_set_offset hypercall
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param mut_sys the bf_syscall_t to use
+    ///   @param mut_vs_pool the vs_pool_t to use
+    ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+    ///     and friends otherwise
+    ///
+    [[nodiscard]] constexpr auto
+    handle_mv_vs_op_tsc_set_offset(syscall::bf_syscall_t &mut_sys, vs_pool_t &mut_vs_pool) noexcept
+        -> bsl::errc_type
+    {
+        auto const vsid{get_allocated_non_self_vsid(mut_sys, get_reg1(mut_sys), mut_vs_pool)};
+        if (bsl::unlikely(vsid.is_invalid())) {
+            bsl::print<bsl::V>() << bsl::here();
+            set_reg_return(mut_sys, hypercall::MV_STATUS_INVALID_INPUT_REG1);
+            return vmexit_failure_advance_ip_and_run;
+        }
+
+        mut_vs_pool.tsc_set_offset(mut_sys, get_reg2(mut_sys), vsid);
+        return vmexit_success_advance_ip_and_run;
+    }
+
     /// <!-- description -->
     ///   @brief Dispatches virtual processor state VMCalls.
     ///
@@ -650,6 +1030,7 @@ namespace microv
                     mut_sys,
                     mut_page_pool,
                     intrinsic,
+                    mut_pp_pool,
                     mut_vm_pool,
                     mut_vp_pool,
                     mut_vs_pool)};
@@ -714,7 +1095,24 @@ namespace microv
 
             case hypercall::MV_VS_OP_RUN_IDX_VAL.get(): {
                 auto const ret{handle_mv_vs_op_run(
-                    mut_tls, mut_sys, intrinsic, mut_vm_pool, mut_vp_pool, mut_vs_pool)};
+                    mut_tls,
+                    mut_sys,
+                    intrinsic,
+                    mut_pp_pool,
+                    mut_vm_pool,
+                    mut_vp_pool,
+                    mut_vs_pool)};
+                if (bsl::unlikely(!ret)) {
+                    bsl::print<bsl::V>() << bsl::here();
+                    return ret;
+                }
+
+                return ret;
+            }
+
+            case hypercall::MV_VS_OP_CPUID_SET_LIST_IDX_VAL.get(): {
+                auto const ret{handle_mv_vs_op_cpuid_set_list(
+                    mut_tls, mut_sys, mut_page_pool, mut_pp_pool, mut_vs_pool)};
                 if (bsl::unlikely(!ret)) {
                     bsl::print<bsl::V>() << bsl::here();
                     return ret;
@@ -764,7 +1162,7 @@ namespace microv
             }
 
             case hypercall::MV_VS_OP_MSR_GET_IDX_VAL.get(): {
-                auto const ret{handle_mv_vs_op_msr_get(mut_sys)};
+                auto const ret{handle_mv_vs_op_msr_get(mut_sys, mut_vs_pool)};
                 if (bsl::unlikely(!ret)) {
                     bsl::print<bsl::V>() << bsl::here();
                     return ret;
@@ -774,7 +1172,7 @@ namespace microv
             }
 
             case hypercall::MV_VS_OP_MSR_SET_IDX_VAL.get(): {
-                auto const ret{handle_mv_vs_op_msr_set(mut_sys)};
+                auto const ret{handle_mv_vs_op_msr_set(mut_sys, mut_vs_pool)};
                 if (bsl::unlikely(!ret)) {
                     bsl::print<bsl::V>() << bsl::here();
                     return ret;
@@ -784,7 +1182,7 @@ namespace microv
             }
 
             case hypercall::MV_VS_OP_MSR_GET_LIST_IDX_VAL.get(): {
-                auto const ret{handle_mv_vs_op_msr_get_list(mut_sys)};
+                auto const ret{handle_mv_vs_op_msr_get_list(mut_sys, mut_pp_pool, mut_vs_pool)};
                 if (bsl::unlikely(!ret)) {
                     bsl::print<bsl::V>() << bsl::here();
                     return ret;
@@ -794,7 +1192,7 @@ namespace microv
             }
 
             case hypercall::MV_VS_OP_MSR_SET_LIST_IDX_VAL.get(): {
-                auto const ret{handle_mv_vs_op_msr_set_list(mut_sys)};
+                auto const ret{handle_mv_vs_op_msr_set_list(mut_sys, mut_pp_pool, mut_vs_pool)};
                 if (bsl::unlikely(!ret)) {
                     bsl::print<bsl::V>() << bsl::here();
                     return ret;
@@ -823,6 +1221,36 @@ namespace microv
                 return ret;
             }
 
+            case hypercall::MV_VS_OP_DIRTY_RING_GET_IDX_VAL.get(): {
+                auto const ret{handle_mv_vs_op_dirty_ring_get(mut_sys, mut_pp_pool, mut_vs_pool)};
+                if (bsl::unlikely(!ret)) {
+                    bsl::print<bsl::V>() << bsl::here();
+                    return ret;
+                }
+
+                return ret;
+            }
+
+            case hypercall::MV_VS_OP_TSC_SET_KHZ_IDX_VAL.get(): {
+                auto const ret{handle_mv_vs_op_tsc_set_khz(mut_sys, mut_pp_pool, mut_vs_pool)};
+                if (bsl::unlikely(!ret)) {
+                    bsl::print<bsl::V>() << bsl::here();
+                    return ret;
+                }
+
+                return ret;
+            }
+
+            case hypercall::MV_VS_OP_TSC_SET_OFFSET_IDX_VAL.get(): {
+                auto const ret{handle_mv_vs_op_tsc_set_offset(mut_sys, mut_vs_pool)};
+                if (bsl::unlikely(!ret)) {
+                    bsl::print<bsl::V>() << bsl::here();
+                    return ret;
+                }
+
+                return ret;
+            }
+
             default: {
                 break;
             }
@@ -27,6 +27,7 @@
 
 #include <bf_syscall_t.hpp>
 #include <dispatch_abi_helpers.hpp>
+#include <dispatch_vmcall_kvm_hc.hpp>
 #include <dispatch_vmcall_mv_debug_op.hpp>
 #include <dispatch_vmcall_mv_handle_op.hpp>
 #include <dispatch_vmcall_mv_id_op.hpp>
@@ -52,7 +53,9 @@
 namespace microv
 {
     /// <!-- description -->
-    ///   @brief Dispatches VMCALL VMExits.
+    ///   @brief Dispatches VMCALL VMExits. VMCalls made by a guest VM
+    ///     that are not MicroV hypercalls use the KVM hypercall ABI (see
+    ///     dispatch_vmcall_kvm_hc).
     ///
     /// <!-- inputs/outputs -->
     ///   @param gs the gs_t to use
@@ -243,6 +246,20 @@ namespace microv
             }
         }
 
+        if (!mut_sys.is_the_active_vm_the_root_vm()) {
+            return dispatch_vmcall_kvm_hc(
+                gs,
+                mut_tls,
+                mut_sys,
+                mut_page_pool,
+                intrinsic,
+                mut_pp_pool,
+                mut_vm_pool,
+                mut_vp_pool,
+                mut_vs_pool,
+                vsid);
+        }
+
         return report_hypercall_unknown_unsupported(mut_sys);
     }
 }
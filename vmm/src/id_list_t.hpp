@@ -0,0 +1,166 @@
+/// @copyright
+/// Copyright (C) 2020 Assured Information Security, Inc.
+///
+/// @copyright
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// @copyright
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// @copyright
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+
+#ifndef ID_LIST_T_HPP
+#define ID_LIST_T_HPP
+
+#include <bf_constants.hpp>
+
+#include <bsl/array.hpp>
+#include <bsl/convert.hpp>
+#include <bsl/expects.hpp>
+#include <bsl/safe_integral.hpp>
+#include <bsl/touch.hpp>
+
+namespace microv
+{
+    /// @class microv::id_list_t
+    ///
+    /// <!-- description -->
+    ///   @brief Keeps track of which IDs are assigned to which owners
+    ///     (for example, which VPs are assigned to which VM) using a
+    ///     doubly linked list per owner that is stored in static arrays.
+    ///     Adding an ID, removing an ID and looking up an ID that is
+    ///     assigned to an owner are all constant time. Like the rest of
+    ///     the extension, IDs are stored inverted so that a zero
+    ///     initialized entry means syscall::BF_INVALID_ID. This class
+    ///     does not provide any synchronization.
+    ///
+    /// <!-- template parameters -->
+    ///   @tparam OWNERS the total number of owners. Cannot be 0
+    ///   @tparam N the total number of IDs. Cannot be 0
+    ///
+    template<bsl::uintmx OWNERS, bsl::uintmx N>
+    class id_list_t final
+    {
+        /// @brief stores the first ID assigned to each owner (inverted)
+        bsl::array<bsl::safe_u16, OWNERS> m_head{};
+        /// @brief stores the next ID assigned to the same owner (inverted)
+        bsl::array<bsl::safe_u16, N> m_next{};
+        /// @brief stores the previous ID assigned to the same owner (inverted)
+        bsl::array<bsl::safe_u16, N> m_prev{};
+
+    public:
+        /// <!-- description -->
+        ///   @brief Assigns the provided ID to the provided owner. The ID
+        ///     must not already be assigned to an owner.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param owner the ID of the owner to assign the ID to
+        ///   @param id the ID to assign
+        ///
+        constexpr void
+        push(bsl::safe_u16 const &owner, bsl::safe_u16 const &id) noexcept
+        {
+            bsl::expects(owner.is_valid_and_checked());
+            bsl::expects(owner < bsl::to_u16(OWNERS));
+            bsl::expects(id.is_valid_and_checked());
+            bsl::expects(id < bsl::to_u16(N));
+
+            auto *const pmut_head{m_head.at_if(bsl::to_idx(owner))};
+            auto const head{~*pmut_head};
+
+            *m_prev.at_if(bsl::to_idx(id)) = {};
+            *m_next.at_if(bsl::to_idx(id)) = *pmut_head;
+
+            if (head != syscall::BF_INVALID_ID) {
+                *m_prev.at_if(bsl::to_idx(head)) = ~id;
+            }
+            else {
+                bsl::touch();
+            }
+
+            *pmut_head = ~id;
+        }
+
+        /// <!-- description -->
+        ///   @brief Removes the provided ID from the IDs that are assigned
+        ///     to the provided owner. The ID must have been assigned to the
+        ///     owner using push.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param owner the ID of the owner the ID is assigned to
+        ///   @param id the ID to remove
+        ///
+        constexpr void
+        remove(bsl::safe_u16 const &owner, bsl::safe_u16 const &id) noexcept
+        {
+            bsl::expects(owner.is_valid_and_checked());
+            bsl::expects(owner < bsl::to_u16(OWNERS));
+            bsl::expects(id.is_valid_and_checked());
+            bsl::expects(id < bsl::to_u16(N));
+
+            auto *const pmut_next{m_next.at_if(bsl::to_idx(id))};
+            auto *const pmut_prev{m_prev.at_if(bsl::to_idx(id))};
+
+            auto const next{~*pmut_next};
+            auto const prev{~*pmut_prev};
+
+            if (prev != syscall::BF_INVALID_ID) {
+                *m_next.at_if(bsl::to_idx(prev)) = *pmut_next;
+            }
+            else {
+                bsl::expects(~id == *m_head.at_if(bsl::to_idx(owner)));
+                *m_head.at_if(bsl::to_idx(owner)) = *pmut_next;
+            }
+
+            if (next != syscall::BF_INVALID_ID) {
+                *m_prev.at_if(bsl::to_idx(next)) = *pmut_prev;
+            }
+            else {
+                bsl::touch();
+            }
+
+            *pmut_next = {};
+            *pmut_prev = {};
+        }
+
+        /// <!-- description -->
+        ///   @brief Returns the ID that was most recently assigned to the
+        ///     provided owner. If no IDs are assigned to the owner,
+        ///     bsl::safe_u16::failure() is returned.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param owner the ID of the owner to query
+        ///   @return Returns the ID that was most recently assigned to the
+        ///     provided owner. If no IDs are assigned to the owner,
+        ///     bsl::safe_u16::failure() is returned.
+        ///
+        [[nodiscard]] constexpr auto
+        front(bsl::safe_u16 const &owner) const noexcept -> bsl::safe_u16
+        {
+            bsl::expects(owner.is_valid_and_checked());
+            bsl::expects(owner < bsl::to_u16(OWNERS));
+
+            auto const head{~*m_head.at_if(bsl::to_idx(owner))};
+            if (head == syscall::BF_INVALID_ID) {
+                return bsl::safe_u16::failure();
+            }
+
+            return head;
+        }
+    };
+}
+
+#endif
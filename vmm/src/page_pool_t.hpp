@@ -27,18 +27,325 @@
 
 #include "page_pool_helpers.hpp"
 
-#include <basic_page_pool_t.hpp>
+#include <basic_page_pool_node_t.hpp>
 #include <bf_syscall_t.hpp>
+#include <lock_guard_t.hpp>
+#include <spinlock_t.hpp>
 #include <tls_t.hpp>
 
+#include <bsl/array.hpp>
+#include <bsl/builtin_memset.hpp>
+#include <bsl/convert.hpp>
+#include <bsl/debug.hpp>
+#include <bsl/expects.hpp>
+#include <bsl/safe_idx.hpp>
+#include <bsl/safe_integral.hpp>
+#include <bsl/touch.hpp>
+#include <bsl/unlikely.hpp>
+
 namespace microv
 {
-    /// @brief defines the page_pool_t used by the microkernel
-    using page_pool_t = lib::basic_page_pool_t<
-        tls_t,
-        syscall::bf_syscall_t,
-        HYPERVISOR_EXT_DIRECT_MAP_ADDR.get(),
-        HYPERVISOR_EXT_DIRECT_MAP_SIZE.get()>;
+    /// @brief defines the number of pages moved between a PP's cache and the global pool at once
+    constexpr auto PAGE_POOL_BATCH_SIZE{32_umx};
+    /// @brief defines the max number of pages a PP's cache can hold
+    constexpr auto PAGE_POOL_CACHE_SIZE{64_umx};
+    /// @brief defines the number of pre-zeroed pages each PP tries to keep
+    constexpr auto PAGE_POOL_ZEROED_SIZE{32_umx};
+
+    /// @class microv::page_pool_t
+    ///
+    /// <!-- description -->
+    ///   @brief Defines the extension's page pool. Each PP has its own
+    ///     cache (or magazine) of free pages that it allocates from and
+    ///     frees to without taking a lock. Only when a PP's cache is empty
+    ///     (or full) is the global pool locked, and when it is, pages are
+    ///     moved in batches of PAGE_POOL_BATCH_SIZE so that PPs that
+    ///     allocate and free a lot of memory at the same time (e.g., while
+    ///     creating VMs or mapping guest memory) do not serialize on a
+    ///     single lock.
+    ///
+    ///   @note Each PP also keeps a list of pages that have already been
+    ///     zeroed, which is refilled one page at a time by prezero() when
+    ///     a guest VS halts (i.e., when the PP is idle). allocate() takes
+    ///     from this list first, so that zeroing memory stays off of the
+    ///     critical path (e.g., VM creation). The number of allocations
+    ///     that found this list empty is reported by zeroed_misses(),
+    ///     which is logged each time a VM is destroyed.
+    ///
+    class page_pool_t final
+    {
+        /// @struct microv::page_pool_t::cache_t
+        ///
+        /// <!-- description -->
+        ///   @brief Stores a PP's cache of free pages.
+        ///
+        struct cache_t final
+        {
+            /// @brief stores the head of the list of free pages
+            lib::basic_page_pool_node_t *head;
+            /// @brief stores the number of pages in the list
+            bsl::safe_umx size;
+            /// @brief stores the head of the list of pre-zeroed pages
+            lib::basic_page_pool_node_t *zeroed;
+            /// @brief stores the number of pages in the pre-zeroed list
+            bsl::safe_umx zeroed_size;
+            /// @brief stores the number of allocations that found no pre-zeroed page
+            bsl::safe_u64 zeroed_misses;
+        };
+
+        /// @brief stores the head of the global list of free pages
+        lib::basic_page_pool_node_t *m_head{};
+        /// @brief safe guards operations on the global list.
+        mutable spinlock_t m_lock{};
+        /// @brief stores each PP's cache of free pages
+        bsl::array<cache_t, HYPERVISOR_MAX_PPS.get()> m_caches{};
+
+        /// <!-- description -->
+        ///   @brief Returns the cache associated with the PP that is
+        ///     executing this code.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param tls the tls_t to use
+        ///   @return Returns the cache associated with the current PP
+        ///
+        [[nodiscard]] constexpr auto
+        cache(tls_t const &tls) noexcept -> cache_t *
+        {
+            bsl::expects(tls.ppid.is_valid_and_checked());
+            bsl::expects(bsl::to_umx(tls.ppid) < m_caches.size());
+            return m_caches.at_if(bsl::to_idx(tls.ppid));
+        }
+
+        /// <!-- description -->
+        ///   @brief Moves up to PAGE_POOL_BATCH_SIZE pages from the global
+        ///     list to the provided cache.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param tls the tls_t to use
+        ///   @param mut_cache the cache to refill
+        ///
+        constexpr void
+        refill(tls_t const &tls, cache_t &mut_cache) noexcept
+        {
+            lock_guard_t mut_lock{tls, m_lock};
+
+            while (nullptr != m_head) {
+                if (mut_cache.size >= PAGE_POOL_BATCH_SIZE) {
+                    break;
+                }
+
+                auto *const pmut_node{m_head};
+                m_head = m_head->next;
+
+                pmut_node->next = mut_cache.head;
+                mut_cache.head = pmut_node;
+                ++mut_cache.size;
+            }
+        }
+
+        /// <!-- description -->
+        ///   @brief Moves PAGE_POOL_BATCH_SIZE pages from the provided
+        ///     cache to the global list. The pages are unlinked from the
+        ///     cache before the lock is taken, so that the global list is
+        ///     only locked long enough to splice them in.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param tls the tls_t to use
+        ///   @param mut_cache the cache to drain
+        ///
+        constexpr void
+        drain(tls_t const &tls, cache_t &mut_cache) noexcept
+        {
+            bsl::expects(mut_cache.size >= PAGE_POOL_BATCH_SIZE);
+
+            auto *const pmut_first{mut_cache.head};
+            auto *pmut_mut_last{pmut_first};
+
+            constexpr auto links{PAGE_POOL_BATCH_SIZE - bsl::safe_umx::magic_1()};
+            for (bsl::safe_idx mut_i{}; mut_i < links; ++mut_i) {
+                pmut_mut_last = pmut_mut_last->next;
+            }
+
+            mut_cache.head = pmut_mut_last->next;
+            mut_cache.size -= PAGE_POOL_BATCH_SIZE;
+
+            lock_guard_t mut_lock{tls, m_lock};
+
+            pmut_mut_last->next = m_head;
+            m_head = pmut_first;
+        }
+
+    public:
+        /// <!-- description -->
+        ///   @brief Allocates a zeroed page. If the current PP has a
+        ///     pre-zeroed page, it is returned as is. Otherwise the page
+        ///     comes from the current PP's cache, which is refilled from
+        ///     the global pool if it is empty, and if the global pool is
+        ///     empty too, a page is requested from the microkernel. In
+        ///     this case the page is zeroed before it is returned.
+        ///
+        /// <!-- template parameters -->
+        ///   @tparam T the type of page to allocate
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param tls the tls_t to use
+        ///   @param mut_sys the bf_syscall_t to use
+        ///   @return Returns a pointer to the newly allocated page on
+        ///     success, or a nullptr on failure.
+        ///
+        template<typename T>
+        [[nodiscard]] constexpr auto
+        allocate(tls_t const &tls, syscall::bf_syscall_t &mut_sys) noexcept -> T *
+        {
+            static_assert(!(sizeof(T) > HYPERVISOR_PAGE_SIZE));
+
+            auto *const pmut_cache{this->cache(tls)};
+            if (nullptr != pmut_cache->zeroed) {
+                auto *const pmut_zeroed{pmut_cache->zeroed};
+                pmut_cache->zeroed = pmut_zeroed->next;
+                --pmut_cache->zeroed_size;
+
+                pmut_zeroed->next = {};
+                return static_cast<T *>(static_cast<void *>(pmut_zeroed));
+            }
+
+            ++pmut_cache->zeroed_misses;
+
+            if (nullptr == pmut_cache->head) {
+                this->refill(tls, *pmut_cache);
+            }
+            else {
+                bsl::touch();
+            }
+
+            if (nullptr == pmut_cache->head) {
+                pmut_cache->head = helpers::add_to_page_pool(mut_sys);
+                if (bsl::unlikely(nullptr == pmut_cache->head)) {
+                    bsl::print<bsl::V>() << bsl::here();
+                    return nullptr;
+                }
+
+                pmut_cache->head->next = {};
+                ++pmut_cache->size;
+            }
+            else {
+                bsl::touch();
+            }
+
+            auto *const pmut_node{pmut_cache->head};
+            pmut_cache->head = pmut_node->next;
+            --pmut_cache->size;
+
+            bsl::builtin_memset(pmut_node, '\0', HYPERVISOR_PAGE_SIZE);
+            return static_cast<T *>(static_cast<void *>(pmut_node));
+        }
+
+        /// <!-- description -->
+        ///   @brief Returns a page previously allocated using allocate()
+        ///     to the current PP's cache. If the cache is full, part of it
+        ///     is first returned to the global pool. If a nullptr is
+        ///     provided, this function does nothing.
+        ///
+        /// <!-- template parameters -->
+        ///   @tparam T the type of page to deallocate
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param tls the tls_t to use
+        ///   @param pmut_ptr the page to deallocate
+        ///
+        template<typename T>
+        constexpr void
+        deallocate(tls_t const &tls, T *const pmut_ptr) noexcept
+        {
+            static_assert(!(sizeof(T) > HYPERVISOR_PAGE_SIZE));
+
+            if (nullptr == pmut_ptr) {
+                return;
+            }
+
+            auto *const pmut_cache{this->cache(tls)};
+            if (pmut_cache->size >= PAGE_POOL_CACHE_SIZE) {
+                this->drain(tls, *pmut_cache);
+            }
+            else {
+                bsl::touch();
+            }
+
+            auto *const pmut_node{static_cast<lib::basic_page_pool_node_t *>(
+                static_cast<void *>(pmut_ptr))};
+
+            pmut_node->next = pmut_cache->head;
+            pmut_cache->head = pmut_node;
+            ++pmut_cache->size;
+        }
+
+        /// <!-- description -->
+        ///   @brief Adds a single page to the current PP's list of
+        ///     pre-zeroed pages unless the list already holds
+        ///     PAGE_POOL_ZEROED_SIZE pages. This should only be called
+        ///     when the PP is idle (e.g., on a HLT VMExit), never on a
+        ///     latency sensitive path like a host interrupt. Only one page
+        ///     is zeroed per call, so the list is topped up over many calls.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param tls the tls_t to use
+        ///   @param mut_sys the bf_syscall_t to use
+        ///
+        constexpr void
+        prezero(tls_t const &tls, syscall::bf_syscall_t &mut_sys) noexcept
+        {
+            auto *const pmut_cache{this->cache(tls)};
+            if (pmut_cache->zeroed_size >= PAGE_POOL_ZEROED_SIZE) {
+                return;
+            }
+
+            if (nullptr == pmut_cache->head) {
+                this->refill(tls, *pmut_cache);
+            }
+            else {
+                bsl::touch();
+            }
+
+            auto *pmut_mut_node{pmut_cache->head};
+            if (nullptr != pmut_mut_node) {
+                pmut_cache->head = pmut_mut_node->next;
+                --pmut_cache->size;
+            }
+            else {
+                pmut_mut_node = helpers::add_to_page_pool(mut_sys);
+                if (bsl::unlikely(nullptr == pmut_mut_node)) {
+                    bsl::print<bsl::V>() << bsl::here();
+                    return;
+                }
+            }
+
+            bsl::builtin_memset(pmut_mut_node, '\0', HYPERVISOR_PAGE_SIZE);
+
+            pmut_mut_node->next = pmut_cache->zeroed;
+            pmut_cache->zeroed = pmut_mut_node;
+            ++pmut_cache->zeroed_size;
+        }
+
+        /// <!-- description -->
+        ///   @brief Returns the total number of allocations, across all
+        ///     PPs, that had to zero a page because no pre-zeroed page was
+        ///     available.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @return Returns the total number of allocations that found
+        ///     no pre-zeroed page.
+        ///
+        [[nodiscard]] constexpr auto
+        zeroed_misses() const noexcept -> bsl::safe_u64
+        {
+            bsl::safe_u64 mut_total{};
+            for (bsl::safe_idx mut_i{}; mut_i < m_caches.size(); ++mut_i) {
+                mut_total += m_caches.at_if(mut_i)->zeroed_misses;
+            }
+
+            return mut_total.checked();
+        }
+    };
 }
 
 #endif
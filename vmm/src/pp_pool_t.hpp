@@ -27,6 +27,7 @@
 
 #include <bf_syscall_t.hpp>
 #include <gs_t.hpp>
+#include <mv_cdl_t.hpp>
 #include <page_pool_t.hpp>
 #include <pp_t.hpp>
 #include <tls_t.hpp>
@@ -167,6 +168,54 @@ namespace microv
             return this->get_pp(mut_sys.bf_tls_ppid())->map<T>(mut_sys, spa);
         }
 
+        /// <!-- description -->
+        ///   @brief Fills in the provided CDL using the CPUID leaves
+        ///     supported by the requested pp_t.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param mut_cdl the CDL to fill in
+        ///   @param ppid the ID of the pp_t to get the CPUID leaves from
+        ///
+        constexpr void
+        cpuid_get_supported_list(
+            hypercall::mv_cdl_t &mut_cdl, bsl::safe_u16 const &ppid) const noexcept
+        {
+            this->get_pp(ppid)->cpuid_get_supported_list(mut_cdl);
+        }
+
+        /// <!-- description -->
+        ///   @brief Returns the TSC frequency of the requested pp_t in KHz,
+        ///     or 0 if the frequency is unknown.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param ppid the ID of the pp_t to get the TSC frequency from
+        ///   @return Returns the TSC frequency of the requested pp_t in KHz,
+        ///     or 0 if the frequency is unknown.
+        ///
+        [[nodiscard]] constexpr auto
+        tsc_khz(bsl::safe_u16 const &ppid) const noexcept -> bsl::safe_u64
+        {
+            return this->get_pp(ppid)->tsc_khz();
+        }
+
+        /// <!-- description -->
+        ///   @brief Converts the provided TSC value of the requested pp_t
+        ///     into nanoseconds. If the TSC frequency of the pp_t is
+        ///     unknown, bsl::safe_u64::failure() is returned.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param tsc the TSC value to convert
+        ///   @param ppid the ID of the pp_t the TSC value was read on
+        ///   @return Returns the provided TSC value in nanoseconds, or
+        ///     bsl::safe_u64::failure() if the frequency is unknown.
+        ///
+        [[nodiscard]] constexpr auto
+        tsc_to_ns(bsl::safe_u64 const &tsc, bsl::safe_u16 const &ppid) const noexcept
+            -> bsl::safe_u64
+        {
+            return this->get_pp(ppid)->tsc_to_ns(tsc);
+        }
+
         /// <!-- description -->
         ///   @brief Clears the SPA of the shared page associated with the
         ///     requested pp_t.
@@ -28,6 +28,7 @@
 #include <bf_syscall_t.hpp>
 #include <intrinsic_t.hpp>
 #include <tls_t.hpp>
+#include <xsave_t.hpp>
 
 #include <bsl/debug.hpp>
 #include <bsl/errc_type.hpp>
@@ -53,7 +54,6 @@ namespace microv
         intrinsic_t const &intrinsic) noexcept -> bsl::errc_type
     {
         bsl::discard(page_pool);
-        bsl::discard(intrinsic);
 
         mut_tls.ppid = sys.bf_tls_ppid();
         mut_tls.online_pps = sys.bf_tls_online_pps();
@@ -66,6 +66,32 @@ namespace microv
         mut_tls.parent_vpid = hypercall::MV_INVALID_ID;
         mut_tls.parent_vsid = hypercall::MV_INVALID_ID;
 
+        constexpr auto xsave_leaf{0xD_u64};
+        constexpr auto xsave_subleaf{0x1_u64};
+        constexpr auto xsaveopt_bit{0x1_u64};
+
+        bsl::safe_u64 mut_rax{xsave_leaf};
+        bsl::safe_u64 mut_rbx{};
+        bsl::safe_u64 mut_rcx{xsave_subleaf};
+        bsl::safe_u64 mut_rdx{};
+
+        intrinsic.cpuid(mut_rax, mut_rbx, mut_rcx, mut_rdx);
+
+        mut_tls.xsave_mask = XSAVE_ALL;
+        mut_tls.xsaveopt_supported = (mut_rax & xsaveopt_bit).is_pos();
+
+        constexpr auto xcr0_subleaf{0x0_u64};
+        constexpr auto xcr0_shft{32_u64};
+
+        mut_rax = xsave_leaf;
+        mut_rbx = {};
+        mut_rcx = xcr0_subleaf;
+        mut_rdx = {};
+
+        intrinsic.cpuid(mut_rax, mut_rbx, mut_rcx, mut_rdx);
+
+        mut_tls.xcr0_supported = ((mut_rdx << xcr0_shft) | mut_rax).checked();
+
         return bsl::errc_success;
     }
 }
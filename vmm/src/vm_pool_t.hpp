@@ -29,6 +29,9 @@
 #include <gs_t.hpp>
 #include <intrinsic_t.hpp>
 #include <lock_guard_t.hpp>
+#include <mv_dirty_bitmap_t.hpp>
+#include <mv_dirty_ring_t.hpp>
+#include <mv_mdl_t.hpp>
 #include <mv_translation_t.hpp>
 #include <page_pool_t.hpp>
 #include <spinlock_t.hpp>
@@ -55,8 +58,8 @@ namespace microv
     {
         /// @brief stores the pool of vm_t objects
         bsl::array<vm_t, HYPERVISOR_MAX_VMS.get()> m_pool{};
-        /// @brief safe guards operations on the pool.
-        mutable spinlock_t m_lock{};
+        /// @brief safe guards the allocation of each vm_t in the pool.
+        bsl::array<spinlock_t, HYPERVISOR_MAX_VMS.get()> m_locks{};
 
         /// <!-- description -->
         ///   @brief Returns the vm_t associated with the provided vmid.
@@ -161,15 +164,22 @@ namespace microv
             page_pool_t &mut_page_pool,
             intrinsic_t const &intrinsic) noexcept -> bsl::safe_u16
         {
-            lock_guard_t mut_lock{tls, m_lock};
-
             auto const vmid{mut_sys.bf_vm_op_create_vm()};
             if (bsl::unlikely(vmid.is_invalid())) {
                 bsl::print<bsl::V>() << bsl::here();
                 return bsl::safe_u16::failure();
             }
 
-            return this->get_vm(vmid)->allocate(gs, tls, mut_sys, mut_page_pool, intrinsic);
+            /// NOTE:
+            /// - The microkernel hands out unique IDs, so only the vm_t
+            ///   that was just created needs to be locked, and VMs can be
+            ///   created on different PPs in parallel.
+            ///
+
+            auto *const pmut_vm{this->get_vm(vmid)};
+            lock_guard_t mut_lock{tls, *m_locks.at_if(bsl::to_idx(vmid))};
+
+            return pmut_vm->allocate(gs, tls, mut_sys, mut_page_pool, intrinsic);
         }
 
         /// <!-- description -->
@@ -192,9 +202,9 @@ namespace microv
             intrinsic_t const &intrinsic,
             bsl::safe_u16 const &vmid) noexcept
         {
-            lock_guard_t mut_lock{tls, m_lock};
-
             auto *const pmut_vm{this->get_vm(vmid)};
+            lock_guard_t mut_lock{tls, *m_locks.at_if(bsl::to_idx(vmid))};
+
             if (pmut_vm->is_allocated()) {
                 bsl::expects(mut_sys.bf_vm_op_destroy_vm(vmid));
                 pmut_vm->deallocate(gs, tls, mut_sys, mut_page_pool, intrinsic);
@@ -298,6 +308,30 @@ namespace microv
             return this->get_vm(vmid)->is_active_on_this_pp(tls);
         }
 
+        /// <!-- description -->
+        ///   @brief Flushes the second level TLB entries of the requested
+        ///     vm_t on the current PP if they are stale. This must be called
+        ///     after the requested vm_t is set as active on the current PP,
+        ///     and before it is run.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param tls the tls_t to use
+        ///   @param mut_sys the bf_syscall_t to use
+        ///   @param intrinsic the intrinsic_t to use
+        ///   @param vmid the ID of the vm_t to flush
+        ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+        ///     and friends otherwise
+        ///
+        [[nodiscard]] constexpr auto
+        tlb_flush_if_stale(
+            tls_t const &tls,
+            syscall::bf_syscall_t &mut_sys,
+            intrinsic_t const &intrinsic,
+            bsl::safe_u16 const &vmid) noexcept -> bsl::errc_type
+        {
+            return this->get_vm(vmid)->tlb_flush_if_stale(tls, mut_sys, intrinsic);
+        }
+
         /// <!-- description -->
         ///   @brief Returns the system physical address of the second level
         ///     page tables used by the requested vm_t.
@@ -313,6 +347,145 @@ namespace microv
             return this->get_vm(vmid)->slpt_spa();
         }
 
+        /// <!-- description -->
+        ///   @brief Returns the system physical address of the IO
+        ///     permissions map used by the requested vm_t.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param vmid the ID of the vm_t to query
+        ///   @return Returns the system physical address of the IO
+        ///     permissions map used by the requested vm_t.
+        ///
+        [[nodiscard]] constexpr auto
+        iopm_spa(bsl::safe_u16 const &vmid) const noexcept -> bsl::safe_u64
+        {
+            return this->get_vm(vmid)->iopm_spa();
+        }
+
+        /// <!-- description -->
+        ///   @brief Sets the IO intercept type of every port from first to
+        ///     last (inclusive) for every VS assigned to the requested
+        ///     vm_t.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param vmid the ID of the vm_t to modify
+        ///   @param first the first port to modify
+        ///   @param last the last port to modify
+        ///   @param type the IO intercept type to use
+        ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+        ///     and friends otherwise
+        ///
+        [[nodiscard]] constexpr auto
+        io_intercept(
+            bsl::safe_u16 const &vmid,
+            bsl::safe_u64 const &first,
+            bsl::safe_u64 const &last,
+            bsl::safe_u64 const &type) noexcept -> bsl::errc_type
+        {
+            return this->get_vm(vmid)->io_intercept(first, last, type);
+        }
+
+        /// <!-- description -->
+        ///   @brief Returns true if an access of the provided number of
+        ///     bytes to the provided port is ignored by the requested
+        ///     vm_t. Returns false otherwise.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param vmid the ID of the vm_t to query
+        ///   @param port the port that was accessed
+        ///   @param bytes the number of bytes that were accessed
+        ///   @return Returns true if the access is ignored by the requested
+        ///     vm_t. Returns false otherwise.
+        ///
+        [[nodiscard]] constexpr auto
+        is_io_ignored(
+            bsl::safe_u16 const &vmid,
+            bsl::safe_u64 const &port,
+            bsl::safe_u64 const &bytes) const noexcept -> bool
+        {
+            return this->get_vm(vmid)->is_io_ignored(port, bytes);
+        }
+
+        /// <!-- description -->
+        ///   @brief Returns the system physical address of the MSR
+        ///     permissions map used by the requested vm_t.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param vmid the ID of the vm_t to query
+        ///   @return Returns the system physical address of the MSR
+        ///     permissions map used by the requested vm_t.
+        ///
+        [[nodiscard]] constexpr auto
+        msrpm_spa(bsl::safe_u16 const &vmid) const noexcept -> bsl::safe_u64
+        {
+            return this->get_vm(vmid)->msrpm_spa();
+        }
+
+        /// <!-- description -->
+        ///   @brief Intercepts the provided accesses to the provided MSR
+        ///     for every VS assigned to the requested vm_t and passes
+        ///     through the rest.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param vmid the ID of the vm_t to modify
+        ///   @param msr the MSR to modify
+        ///   @param perms the accesses to intercept
+        ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+        ///     and friends otherwise
+        ///
+        [[nodiscard]] constexpr auto
+        msr_intercept(
+            bsl::safe_u16 const &vmid,
+            bsl::safe_u32 const &msr,
+            bsl::safe_u64 const &perms) noexcept -> bsl::errc_type
+        {
+            return this->get_vm(vmid)->msr_intercept(msr, perms);
+        }
+
+        /// <!-- description -->
+        ///   @brief Filters the provided accesses to every MSR from first
+        ///     to last (inclusive) to software for every VS assigned to the
+        ///     requested vm_t.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param vmid the ID of the vm_t to modify
+        ///   @param first the first MSR to modify
+        ///   @param last the last MSR to modify
+        ///   @param perms the accesses to filter
+        ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+        ///     and friends otherwise
+        ///
+        [[nodiscard]] constexpr auto
+        msr_filter(
+            bsl::safe_u16 const &vmid,
+            bsl::safe_u32 const &first,
+            bsl::safe_u32 const &last,
+            bsl::safe_u64 const &perms) noexcept -> bsl::errc_type
+        {
+            return this->get_vm(vmid)->msr_filter(first, last, perms);
+        }
+
+        /// <!-- description -->
+        ///   @brief Returns true if the provided access to the provided MSR
+        ///     is filtered to software by the requested vm_t. Returns false
+        ///     otherwise.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param vmid the ID of the vm_t to query
+        ///   @param msr the MSR that was accessed
+        ///   @param perm the access (MV_PERM_READ or MV_PERM_WRITE)
+        ///   @return Returns true if the access is filtered to software by
+        ///     the requested vm_t. Returns false otherwise.
+        ///
+        [[nodiscard]] constexpr auto
+        is_msr_filtered(
+            bsl::safe_u16 const &vmid,
+            bsl::safe_u32 const &msr,
+            bsl::safe_u64 const &perm) const noexcept -> bool
+        {
+            return this->get_vm(vmid)->is_msr_filtered(msr, perm);
+        }
+
         /// <!-- description -->
         ///   @brief Maps memory into the requested vm_t using instructions
         ///     from the provided MDL.
@@ -345,6 +518,7 @@ namespace microv
         ///   @param tls the tls_t to use
         ///   @param mut_sys the bf_syscall_t to use
         ///   @param mut_page_pool the page_pool_t to use
+        ///   @param intrinsic the intrinsic_t to use
         ///   @param mdl the MDL containing the memory to map from the vm_t
         ///   @param vmid the ID of the vm_t to modify
         ///   @return Returns bsl::errc_success on success, bsl::errc_failure
@@ -355,10 +529,292 @@ namespace microv
             tls_t const &tls,
             syscall::bf_syscall_t &mut_sys,
             page_pool_t &mut_page_pool,
+            intrinsic_t const &intrinsic,
             hypercall::mv_mdl_t const &mdl,
             bsl::safe_u16 const &vmid) noexcept -> bsl::errc_type
         {
-            return this->get_vm(vmid)->mmio_unmap(tls, mut_sys, mut_page_pool, mdl);
+            return this->get_vm(vmid)->mmio_unmap(tls, mut_sys, mut_page_pool, intrinsic, mdl);
+        }
+
+        /// <!-- description -->
+        ///   @brief Shares the memory that the requested parent vm_t has
+        ///     mapped into the ranges described by the provided MDL with
+        ///     the requested vm_t, copy-on-write.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param tls the tls_t to use
+        ///   @param mut_sys the bf_syscall_t to use
+        ///   @param mut_page_pool the page_pool_t to use
+        ///   @param mdl the MDL describing the GPA ranges to share
+        ///   @param vmid the ID of the vm_t to modify
+        ///   @param parent_vmid the ID of the vm_t to share memory with
+        ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+        ///     and friends otherwise
+        ///
+        [[nodiscard]] constexpr auto
+        fork(
+            tls_t const &tls,
+            syscall::bf_syscall_t &mut_sys,
+            page_pool_t &mut_page_pool,
+            hypercall::mv_mdl_t const &mdl,
+            bsl::safe_u16 const &vmid,
+            bsl::safe_u16 const &parent_vmid) noexcept -> bsl::errc_type
+        {
+            auto const *const parent{this->get_vm(parent_vmid)};
+            return this->get_vm(vmid)->fork(tls, mut_sys, mut_page_pool, *parent, mdl);
+        }
+
+        /// <!-- description -->
+        ///   @brief Enables dirty logging on a slot of the requested vm_t
+        ///     using the region described by the provided MDL.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param tls the tls_t to use
+        ///   @param mut_sys the bf_syscall_t to use
+        ///   @param mut_page_pool the page_pool_t to use
+        ///   @param intrinsic the intrinsic_t to use
+        ///   @param mdl the MDL describing the memory to dirty log
+        ///   @param vmid the ID of the vm_t to modify
+        ///   @param slot the slot to enable dirty logging on
+        ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+        ///     and friends otherwise
+        ///
+        [[nodiscard]] constexpr auto
+        dirty_log_enable(
+            tls_t const &tls,
+            syscall::bf_syscall_t &mut_sys,
+            page_pool_t &mut_page_pool,
+            intrinsic_t const &intrinsic,
+            hypercall::mv_mdl_t const &mdl,
+            bsl::safe_u16 const &vmid,
+            bsl::safe_u64 const &slot) noexcept -> bsl::errc_type
+        {
+            auto *const pmut_vm{this->get_vm(vmid)};
+            auto const ret{
+                pmut_vm->dirty_log_enable(tls, mut_sys, mut_page_pool, intrinsic, mdl, slot)};
+
+            /// NOTE:
+            /// - The wait happens here, after the vm_t has released its
+            ///   dirty log lock, as a PP that is running the vm_t might
+            ///   need that lock to handle a write fault before it can stop
+            ///   running the vm_t (see vm_t::tlb_flush_wait).
+            ///
+
+            pmut_vm->tlb_flush_wait(tls, intrinsic);
+            return ret;
+        }
+
+        /// <!-- description -->
+        ///   @brief Disables dirty logging on a slot of the requested vm_t.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param tls the tls_t to use
+        ///   @param sys the bf_syscall_t to use
+        ///   @param mut_page_pool the page_pool_t to use
+        ///   @param vmid the ID of the vm_t to modify
+        ///   @param slot the slot to disable dirty logging on
+        ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+        ///     and friends otherwise
+        ///
+        [[nodiscard]] constexpr auto
+        dirty_log_disable(
+            tls_t const &tls,
+            syscall::bf_syscall_t const &sys,
+            page_pool_t &mut_page_pool,
+            bsl::safe_u16 const &vmid,
+            bsl::safe_u64 const &slot) noexcept -> bsl::errc_type
+        {
+            return this->get_vm(vmid)->dirty_log_disable(tls, sys, mut_page_pool, slot);
+        }
+
+        /// <!-- description -->
+        ///   @brief Copies the dirty log of a slot of the requested vm_t
+        ///     into the provided dirty bitmap.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param tls the tls_t to use
+        ///   @param vmid the ID of the vm_t to query
+        ///   @param slot the slot to query
+        ///   @param first_page the first page in the slot to copy
+        ///   @param mut_bitmap where to copy the dirty log to
+        ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+        ///     and friends otherwise
+        ///
+        [[nodiscard]] constexpr auto
+        dirty_log_get(
+            tls_t const &tls,
+            bsl::safe_u16 const &vmid,
+            bsl::safe_u64 const &slot,
+            bsl::safe_u64 const &first_page,
+            hypercall::mv_dirty_bitmap_t &mut_bitmap) noexcept -> bsl::errc_type
+        {
+            return this->get_vm(vmid)->dirty_log_get(tls, slot, first_page, mut_bitmap);
+        }
+
+        /// <!-- description -->
+        ///   @brief Clears the pages described by the provided dirty bitmap
+        ///     from the dirty log of a slot of the requested vm_t.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param tls the tls_t to use
+        ///   @param mut_sys the bf_syscall_t to use
+        ///   @param intrinsic the intrinsic_t to use
+        ///   @param vmid the ID of the vm_t to modify
+        ///   @param slot the slot to modify
+        ///   @param first_page the first page in the slot to clear
+        ///   @param bitmap the pages to clear
+        ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+        ///     and friends otherwise
+        ///
+        [[nodiscard]] constexpr auto
+        dirty_log_clear(
+            tls_t const &tls,
+            syscall::bf_syscall_t &mut_sys,
+            intrinsic_t const &intrinsic,
+            bsl::safe_u16 const &vmid,
+            bsl::safe_u64 const &slot,
+            bsl::safe_u64 const &first_page,
+            hypercall::mv_dirty_bitmap_t const &bitmap) noexcept -> bsl::errc_type
+        {
+            auto *const pmut_vm{this->get_vm(vmid)};
+            auto const ret{
+                pmut_vm->dirty_log_clear(tls, mut_sys, intrinsic, slot, first_page, bitmap)};
+
+            /// NOTE:
+            /// - The wait happens here, after the vm_t has released its
+            ///   dirty log lock, as a PP that is running the vm_t might
+            ///   need that lock to handle a write fault before it can stop
+            ///   running the vm_t (see vm_t::tlb_flush_wait).
+            ///
+
+            pmut_vm->tlb_flush_wait(tls, intrinsic);
+            return ret;
+        }
+
+        /// <!-- description -->
+        ///   @brief Clears the pages described by the provided dirty ring
+        ///     from the dirty log of the requested vm_t.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param tls the tls_t to use
+        ///   @param mut_sys the bf_syscall_t to use
+        ///   @param intrinsic the intrinsic_t to use
+        ///   @param vmid the ID of the vm_t to modify
+        ///   @param ring the pages to clear
+        ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+        ///     and friends otherwise
+        ///
+        [[nodiscard]] constexpr auto
+        dirty_ring_reset(
+            tls_t const &tls,
+            syscall::bf_syscall_t &mut_sys,
+            intrinsic_t const &intrinsic,
+            bsl::safe_u16 const &vmid,
+            hypercall::mv_dirty_ring_t const &ring) noexcept -> bsl::errc_type
+        {
+            auto *const pmut_vm{this->get_vm(vmid)};
+            auto const ret{pmut_vm->dirty_ring_reset(tls, mut_sys, intrinsic, ring)};
+
+            /// NOTE:
+            /// - The wait happens here, after the vm_t has released its
+            ///   dirty log lock, as a PP that is running the vm_t might
+            ///   need that lock to handle a write fault before it can stop
+            ///   running the vm_t (see vm_t::tlb_flush_wait).
+            ///
+
+            pmut_vm->tlb_flush_wait(tls, intrinsic);
+            return ret;
+        }
+
+        /// <!-- description -->
+        ///   @brief Handles a write to a page of the requested vm_t that
+        ///     was write protected by its dirty log.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param tls the tls_t to use
+        ///   @param sys the bf_syscall_t to use
+        ///   @param vmid the ID of the vm_t that performed the write
+        ///   @param gpa the GPA that was written to
+        ///   @param mut_gfn where to return the dirty gfn of the page
+        ///   @return Returns true if the write was the result of dirty
+        ///     logging and was handled, false otherwise.
+        ///
+        [[nodiscard]] constexpr auto
+        dirty_log_write_fault(
+            tls_t const &tls,
+            syscall::bf_syscall_t const &sys,
+            bsl::safe_u16 const &vmid,
+            bsl::safe_u64 const &gpa,
+            hypercall::mv_dirty_gfn_t &mut_gfn) noexcept -> bool
+        {
+            return this->get_vm(vmid)->dirty_log_write_fault(tls, sys, gpa, mut_gfn);
+        }
+
+        /// <!-- description -->
+        ///   @brief Returns the value of the requested vm_t's kvmclock (in
+        ///     ns) given the current value of the host clock (in ns).
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param host_ns the current value of the host clock in ns
+        ///   @param vmid the ID of the vm_t to query
+        ///   @return Returns the value of the requested vm_t's kvmclock
+        ///
+        [[nodiscard]] constexpr auto
+        clock_get(bsl::safe_u64 const &host_ns, bsl::safe_u16 const &vmid) const noexcept
+            -> bsl::safe_u64
+        {
+            return this->get_vm(vmid)->clock_get(host_ns);
+        }
+
+        /// <!-- description -->
+        ///   @brief Sets the requested vm_t's kvmclock so that it reads the
+        ///     provided value (in ns) at the provided host clock value (in
+        ///     ns). See vm_t::clock_set for more details.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param host_ns the current value of the host clock in ns
+        ///   @param clock the value the kvmclock should read in ns
+        ///   @param realtime the current wall clock time in ns since the
+        ///     epoch, or 0 if unknown.
+        ///   @param vmid the ID of the vm_t to set
+        ///
+        constexpr void
+        clock_set(
+            bsl::safe_u64 const &host_ns,
+            bsl::safe_u64 const &clock,
+            bsl::safe_u64 const &realtime,
+            bsl::safe_u16 const &vmid) noexcept
+        {
+            this->get_vm(vmid)->clock_set(host_ns, clock, realtime);
+        }
+
+        /// <!-- description -->
+        ///   @brief Returns the wall clock time (in ns since the epoch) at
+        ///     which the requested vm_t's kvmclock read 0.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param vmid the ID of the vm_t to query
+        ///   @return Returns the wall clock time (in ns since the epoch) at
+        ///     which the requested vm_t's kvmclock read 0.
+        ///
+        [[nodiscard]] constexpr auto
+        clock_epoch(bsl::safe_u16 const &vmid) const noexcept -> bsl::safe_u64
+        {
+            return this->get_vm(vmid)->clock_epoch();
+        }
+
+        /// <!-- description -->
+        ///   @brief Returns the generation of the requested vm_t's kvmclock,
+        ///     which is incremented each time the clock is set.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param vmid the ID of the vm_t to query
+        ///   @return Returns the generation of the requested vm_t's kvmclock
+        ///
+        [[nodiscard]] constexpr auto
+        clock_generation(bsl::safe_u16 const &vmid) const noexcept -> bsl::safe_u64
+        {
+            return this->get_vm(vmid)->clock_generation();
         }
 
         /// <!-- description -->
@@ -382,6 +838,30 @@ namespace microv
         {
             return this->get_vm(vmid)->gpa_to_spa(sys, gpa);
         }
+
+        /// <!-- description -->
+        ///   @brief Returns the system physical address that the provided
+        ///     GPA is mapped to in the requested vm_t. See
+        ///     vm_t::mapped_spa for more details.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param tls the tls_t to use
+        ///   @param sys the bf_syscall_t to use
+        ///   @param gpa the GPA to translate to a SPA
+        ///   @param vmid the ID of the vm_t to use to translate the GPA
+        ///   @return Returns the system physical address that the provided
+        ///     GPA is mapped to on success. Returns bsl::safe_u64::failure()
+        ///     if the GPA is not mapped, or is shared copy-on-write.
+        ///
+        [[nodiscard]] constexpr auto
+        mapped_spa(
+            tls_t const &tls,
+            syscall::bf_syscall_t const &sys,
+            bsl::safe_u64 const &gpa,
+            bsl::safe_u16 const &vmid) const noexcept -> bsl::safe_u64
+        {
+            return this->get_vm(vmid)->mapped_spa(tls, sys, gpa);
+        }
     };
 }
 
@@ -27,6 +27,7 @@
 
 #include <bf_syscall_t.hpp>
 #include <gs_t.hpp>
+#include <id_list_t.hpp>
 #include <intrinsic_t.hpp>
 #include <lock_guard_t.hpp>
 #include <page_pool_t.hpp>
@@ -54,7 +55,11 @@ namespace microv
     {
         /// @brief stores the pool of vp_t objects
         bsl::array<vp_t, HYPERVISOR_MAX_VPS.get()> m_pool{};
-        /// @brief safe guards operations on the pool.
+        /// @brief safe guards the allocation of each vp_t in the pool.
+        bsl::array<spinlock_t, HYPERVISOR_MAX_VPS.get()> m_locks{};
+        /// @brief stores which vp_t objects are assigned to which VM
+        id_list_t<HYPERVISOR_MAX_VMS.get(), HYPERVISOR_MAX_VPS.get()> m_assigned{};
+        /// @brief safe guards m_assigned.
         mutable spinlock_t m_lock{};
 
         /// <!-- description -->
@@ -154,15 +159,32 @@ namespace microv
             intrinsic_t const &intrinsic,
             bsl::safe_u16 const &vmid) noexcept -> bsl::safe_u16
         {
-            lock_guard_t mut_lock{tls, m_lock};
-
             auto const vpid{mut_sys.bf_vp_op_create_vp(vmid)};
             if (bsl::unlikely(vpid.is_invalid())) {
                 bsl::print<bsl::V>() << bsl::here();
                 return bsl::safe_u16::failure();
             }
 
-            return this->get_vp(vpid)->allocate(gs, tls, mut_sys, page_pool, intrinsic, vmid);
+            /// NOTE:
+            /// - The microkernel hands out unique IDs, so only the vp_t
+            ///   that was just created needs to be locked. The pool lock
+            ///   is only held long enough to update m_assigned.
+            ///
+
+            auto *const pmut_vp{this->get_vp(vpid)};
+            lock_guard_t mut_lock{tls, *m_locks.at_if(bsl::to_idx(vpid))};
+
+            auto const ret{pmut_vp->allocate(gs, tls, mut_sys, page_pool, intrinsic, vmid)};
+
+            if (bsl::unlikely(ret.is_invalid())) {
+                bsl::print<bsl::V>() << bsl::here();
+                return ret;
+            }
+
+            lock_guard_t mut_assigned_lock{tls, m_lock};
+            m_assigned.push(vmid, vpid);
+
+            return ret;
         }
 
         /// <!-- description -->
@@ -185,12 +207,17 @@ namespace microv
             intrinsic_t const &intrinsic,
             bsl::safe_u16 const &vpid) noexcept
         {
-            lock_guard_t mut_lock{tls, m_lock};
-
             auto *const pmut_vp{this->get_vp(vpid)};
+            lock_guard_t mut_lock{tls, *m_locks.at_if(bsl::to_idx(vpid))};
+
             if (pmut_vp->is_allocated()) {
+                auto const vmid{pmut_vp->assigned_vm()};
+
                 bsl::expects(mut_sys.bf_vp_op_destroy_vp(vpid));
                 pmut_vp->deallocate(gs, tls, mut_sys, page_pool, intrinsic);
+
+                lock_guard_t mut_assigned_lock{tls, m_lock};
+                m_assigned.remove(vmid, vpid);
             }
             else {
                 bsl::touch();
@@ -307,30 +334,25 @@ namespace microv
 
         /// <!-- description -->
         ///   @brief If the requested VM is assigned to a vp_t in the pool,
-        ///     the ID of the first vp_t found is returned. Otherwise, this
-        ///     function will return bsl::safe_u16::failure()
+        ///     the ID of the most recently allocated vp_t is returned.
+        ///     Otherwise, this function will return bsl::safe_u16::failure()
         ///
         /// <!-- inputs/outputs -->
+        ///   @param tls the tls_t to use
         ///   @param vmid the ID fo the VM to query
         ///   @return If the requested VM is assigned to a vp_t in the pool,
-        ///     the ID of the first vp_t found is returned. Otherwise, this
-        ///     function will return bsl::safe_u16::failure()
+        ///     the ID of the most recently allocated vp_t is returned.
+        ///     Otherwise, this function will return bsl::safe_u16::failure()
         ///
         [[nodiscard]] constexpr auto
-        vp_assigned_to_vm(bsl::safe_u16 const &vmid) const noexcept -> bsl::safe_u16
+        vp_assigned_to_vm(
+            tls_t const &tls, bsl::safe_u16 const &vmid) const noexcept -> bsl::safe_u16
         {
             bsl::expects(vmid.is_valid_and_checked());
             bsl::expects(vmid != syscall::BF_INVALID_ID);
 
-            for (auto const &vp : m_pool) {
-                if (vp.assigned_vm() == vmid) {
-                    return vp.id();
-                }
-
-                bsl::touch();
-            }
-
-            return bsl::safe_u16::failure();
+            lock_guard_t mut_assigned_lock{tls, m_lock};
+            return m_assigned.front(vmid);
         }
     };
 }
@@ -27,8 +27,12 @@
 
 #include <bf_syscall_t.hpp>
 #include <gs_t.hpp>
+#include <id_list_t.hpp>
 #include <intrinsic_t.hpp>
 #include <lock_guard_t.hpp>
+#include <mv_cdl_t.hpp>
+#include <mv_dirty_ring_t.hpp>
+#include <mv_exit_msr_t.hpp>
 #include <mv_exit_reason_t.hpp>
 #include <mv_run_t.hpp>
 #include <page_pool_t.hpp>
@@ -36,6 +40,7 @@
 #include <running_status_t.hpp>
 #include <spinlock_t.hpp>
 #include <tls_t.hpp>
+#include <vm_pool_t.hpp>
 #include <vs_t.hpp>
 
 #include <bsl/array.hpp>
@@ -58,7 +63,11 @@ namespace microv
     {
         /// @brief stores the pool of vs_t objects
         bsl::array<vs_t, HYPERVISOR_MAX_VSS.get()> m_pool{};
-        /// @brief safe guards operations on the pool.
+        /// @brief safe guards the allocation of each vs_t in the pool.
+        bsl::array<spinlock_t, HYPERVISOR_MAX_VSS.get()> m_locks{};
+        /// @brief stores which vs_t objects are assigned to which VP
+        id_list_t<HYPERVISOR_MAX_VPS.get(), HYPERVISOR_MAX_VSS.get()> m_assigned{};
+        /// @brief safe guards m_assigned.
         mutable spinlock_t m_lock{};
 
         /// <!-- description -->
@@ -150,6 +159,10 @@ namespace microv
         ///   @param ppid the ID of the PP to assign the newly created VS to
         ///   @param slpt_spa the system physical address of the second level
         ///     page tables to use.
+        ///   @param iopm_spa the system physical address of the IO
+        ///     permissions map to use.
+        ///   @param msrpm_spa the system physical address of the MSR
+        ///     permissions map to use.
         ///   @return Returns ID of the newly allocated vs_t. Returns
         ///     bsl::safe_u16::failure() on failure.
         ///
@@ -163,18 +176,47 @@ namespace microv
             bsl::safe_u16 const &vmid,
             bsl::safe_u16 const &vpid,
             bsl::safe_u16 const &ppid,
-            bsl::safe_u64 const &slpt_spa) noexcept -> bsl::safe_u16
+            bsl::safe_u64 const &slpt_spa,
+            bsl::safe_u64 const &iopm_spa,
+            bsl::safe_u64 const &msrpm_spa) noexcept -> bsl::safe_u16
         {
-            lock_guard_t mut_lock{tls, m_lock};
-
             auto const vsid{mut_sys.bf_vs_op_create_vs(vpid, ppid)};
             if (bsl::unlikely(vsid.is_invalid())) {
                 bsl::print<bsl::V>() << bsl::here();
                 return bsl::safe_u16::failure();
             }
 
-            return this->get_vs(vsid)->allocate(
-                gs, tls, mut_sys, mut_page_pool, intrinsic, vmid, vpid, ppid, slpt_spa);
+            /// NOTE:
+            /// - The microkernel hands out unique IDs, so only the vs_t
+            ///   that was just created needs to be locked. The pool lock
+            ///   is only held long enough to update m_assigned.
+            ///
+
+            auto *const pmut_vs{this->get_vs(vsid)};
+            lock_guard_t mut_lock{tls, *m_locks.at_if(bsl::to_idx(vsid))};
+
+            auto const ret{pmut_vs->allocate(
+                gs,
+                tls,
+                mut_sys,
+                mut_page_pool,
+                intrinsic,
+                vmid,
+                vpid,
+                ppid,
+                slpt_spa,
+                iopm_spa,
+                msrpm_spa)};
+
+            if (bsl::unlikely(ret.is_invalid())) {
+                bsl::print<bsl::V>() << bsl::here();
+                return ret;
+            }
+
+            lock_guard_t mut_assigned_lock{tls, m_lock};
+            m_assigned.push(vpid, vsid);
+
+            return ret;
         }
 
         /// <!-- description -->
@@ -197,12 +239,17 @@ namespace microv
             intrinsic_t const &intrinsic,
             bsl::safe_u16 const &vsid) noexcept
         {
-            lock_guard_t mut_lock{tls, m_lock};
-
             auto *const pmut_vs{this->get_vs(vsid)};
+            lock_guard_t mut_lock{tls, *m_locks.at_if(bsl::to_idx(vsid))};
+
             if (pmut_vs->is_allocated()) {
+                auto const vpid{pmut_vs->assigned_vp()};
+
                 bsl::expects(mut_sys.bf_vs_op_destroy_vs(vsid));
                 pmut_vs->deallocate(gs, tls, mut_sys, mut_page_pool, intrinsic);
+
+                lock_guard_t mut_assigned_lock{tls, m_lock};
+                m_assigned.remove(vpid, vsid);
             }
             else {
                 bsl::touch();
@@ -272,6 +319,69 @@ namespace microv
             this->get_vs(vsid)->set_inactive(mut_tls, intrinsic);
         }
 
+        /// <!-- description -->
+        ///   @brief Returns the state components the requested vs_t's
+        ///     guest can modify.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param vsid the ID of the vs_t to query
+        ///   @return Returns the state components the requested vs_t's
+        ///     guest can modify.
+        ///
+        [[nodiscard]] constexpr auto
+        xsave_mask(bsl::safe_u16 const &vsid) const noexcept -> bsl::safe_u64
+        {
+            return this->get_vs(vsid)->xsave_mask();
+        }
+
+        /// <!-- description -->
+        ///   @brief Emulates the guest's XSETBV of XCR0 for the requested
+        ///     vs_t, which must be the active vs_t. If the guest enables
+        ///     state components that were not switched when it was run,
+        ///     the parent VS's copies of them are still in the PP's
+        ///     registers. They are saved to the parent VS and replaced by
+        ///     the guest's copies, and mut_tls.xsave_mask is extended so
+        ///     that switch_to_root switches them back.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param mut_tls the current TLS block
+        ///   @param mut_sys the bf_syscall_t to use
+        ///   @param intrinsic the intrinsic_t to use
+        ///   @param val the value the guest is setting XCR0 to
+        ///   @param vsid the ID of the vs_t that executed XSETBV
+        ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+        ///     if the value would cause a #GP.
+        ///
+        [[nodiscard]] constexpr auto
+        xcr0_set(
+            tls_t &mut_tls,
+            syscall::bf_syscall_t &mut_sys,
+            intrinsic_t const &intrinsic,
+            bsl::safe_u64 const &val,
+            bsl::safe_u16 const &vsid) noexcept -> bsl::errc_type
+        {
+            bsl::expects(mut_tls.parent_vsid != syscall::BF_INVALID_ID);
+
+            auto *const pmut_vs{this->get_vs(vsid)};
+
+            auto const ret{pmut_vs->xcr0_set(mut_tls, mut_sys, val)};
+            if (bsl::unlikely(!ret)) {
+                bsl::print<bsl::V>() << bsl::here();
+                return ret;
+            }
+
+            auto const added{(pmut_vs->xsave_mask() & ~mut_tls.xsave_mask).checked()};
+            if (added.is_zero()) {
+                return bsl::errc_success;
+            }
+
+            this->get_vs(mut_tls.parent_vsid)->xsave_components(intrinsic, added);
+            pmut_vs->xrstr_components(intrinsic, added);
+
+            mut_tls.xsave_mask |= added;
+            return bsl::errc_success;
+        }
+
         /// <!-- description -->
         ///   @brief Returns the ID of the PP the requested vs_t is active on.
         ///     If the vs_t is not active, bsl::safe_u16::failure() is returned.
@@ -356,30 +466,25 @@ namespace microv
 
         /// <!-- description -->
         ///   @brief If the requested VP is assigned to a vs_t in the pool,
-        ///     the ID of the first vs_t found is returned. Otherwise, this
-        ///     function will return bsl::safe_u16::failure()
+        ///     the ID of the most recently allocated vs_t is returned.
+        ///     Otherwise, this function will return bsl::safe_u16::failure()
         ///
         /// <!-- inputs/outputs -->
+        ///   @param tls the tls_t to use
         ///   @param vpid the ID fo the VP to query
         ///   @return If the requested VP is assigned to a vs_t in the pool,
-        ///     the ID of the first vs_t found is returned. Otherwise, this
-        ///     function will return bsl::safe_u16::failure()
+        ///     the ID of the most recently allocated vs_t is returned.
+        ///     Otherwise, this function will return bsl::safe_u16::failure()
         ///
         [[nodiscard]] constexpr auto
-        vs_assigned_to_vp(bsl::safe_u16 const &vpid) const noexcept -> bsl::safe_u16
+        vs_assigned_to_vp(
+            tls_t const &tls, bsl::safe_u16 const &vpid) const noexcept -> bsl::safe_u16
         {
             bsl::expects(vpid.is_valid_and_checked());
             bsl::expects(vpid != syscall::BF_INVALID_ID);
 
-            for (auto const &vs : m_pool) {
-                if (vs.assigned_vp() == vpid) {
-                    return vs.id();
-                }
-
-                bsl::touch();
-            }
-
-            return bsl::safe_u16::failure();
+            lock_guard_t mut_assigned_lock{tls, m_lock};
+            return m_assigned.front(vpid);
         }
 
         /// <!-- description -->
@@ -417,7 +522,7 @@ namespace microv
             syscall::bf_syscall_t &mut_sys,
             pp_pool_t &mut_pp_pool,
             bsl::safe_u64 const &gla,
-            bsl::safe_u16 const &vsid) const noexcept -> hypercall::mv_translation_t
+            bsl::safe_u16 const &vsid) noexcept -> hypercall::mv_translation_t
         {
             return this->get_vs(vsid)->gla_to_gpa(mut_sys, mut_pp_pool, gla);
         }
@@ -442,6 +547,30 @@ namespace microv
             return this->get_vs(vsid)->cpuid_get(mut_sys, intrinsic);
         }
 
+        /// <!-- description -->
+        ///   @brief Sets the CPUID leaves of the requested vs_t given
+        ///     the provided CDL.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param tls the tls_t to use
+        ///   @param mut_sys the bf_syscall_t to use
+        ///   @param mut_page_pool the page_pool_t to use
+        ///   @param cdl the CDL to get the requested CPUID leaves from
+        ///   @param vsid the ID of the vs_t to set
+        ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+        ///     and friends otherwise
+        ///
+        [[nodiscard]] constexpr auto
+        cpuid_set_list(
+            tls_t const &tls,
+            syscall::bf_syscall_t &mut_sys,
+            page_pool_t &mut_page_pool,
+            hypercall::mv_cdl_t const &cdl,
+            bsl::safe_u16 const &vsid) noexcept -> bsl::errc_type
+        {
+            return this->get_vs(vsid)->cpuid_set_list(tls, mut_sys, mut_page_pool, cdl);
+        }
+
         /// <!-- description -->
         ///   @brief Returns the value of the requested register
         ///
@@ -455,7 +584,7 @@ namespace microv
         reg_get(
             syscall::bf_syscall_t const &sys,
             bsl::safe_u64 const &reg,
-            bsl::safe_u16 const &vsid) const noexcept -> bsl::safe_u64
+            bsl::safe_u16 const &vsid) noexcept -> bsl::safe_u64
         {
             return this->get_vs(vsid)->reg_get(sys, reg);
         }
@@ -496,7 +625,7 @@ namespace microv
         reg_get_list(
             syscall::bf_syscall_t const &sys,
             hypercall::mv_rdl_t &mut_rdl,
-            bsl::safe_u16 const &vsid) const noexcept -> bsl::errc_type
+            bsl::safe_u16 const &vsid) noexcept -> bsl::errc_type
         {
             return this->get_vs(vsid)->reg_get_list(sys, mut_rdl);
         }
@@ -521,6 +650,288 @@ namespace microv
             return this->get_vs(vsid)->reg_set_list(mut_sys, rdl);
         }
 
+        /// <!-- description -->
+        ///   @brief Returns the value of the requested MSR
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param sys the bf_syscall_t to use
+        ///   @param msr the MSR to get
+        ///   @param vsid the ID of the vs_t to query
+        ///   @return Returns the value of the requested MSR
+        ///
+        [[nodiscard]] constexpr auto
+        msr_get(
+            syscall::bf_syscall_t const &sys,
+            bsl::safe_u32 const &msr,
+            bsl::safe_u16 const &vsid) noexcept -> bsl::safe_u64
+        {
+            return this->get_vs(vsid)->msr_get(sys, msr);
+        }
+
+        /// <!-- description -->
+        ///   @brief Sets the value of the requested MSR
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param mut_sys the bf_syscall_t to use
+        ///   @param msr the MSR to set
+        ///   @param val the value to set the MSR to
+        ///   @param vsid the ID of the vs_t to set
+        ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+        ///     and friends otherwise
+        ///
+        [[nodiscard]] constexpr auto
+        msr_set(
+            syscall::bf_syscall_t &mut_sys,
+            bsl::safe_u32 const &msr,
+            bsl::safe_u64 const &val,
+            bsl::safe_u16 const &vsid) noexcept -> bsl::errc_type
+        {
+            return this->get_vs(vsid)->msr_set(mut_sys, msr, val);
+        }
+
+        /// <!-- description -->
+        ///   @brief Returns the value of the requested MSRs from
+        ///     the provided RDL.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param sys the bf_syscall_t to use
+        ///   @param mut_rdl the RDL to store the requested MSR values
+        ///   @param vsid the ID of the vs_t to query
+        ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+        ///     and friends otherwise
+        ///
+        [[nodiscard]] constexpr auto
+        msr_get_list(
+            syscall::bf_syscall_t const &sys,
+            hypercall::mv_rdl_t &mut_rdl,
+            bsl::safe_u16 const &vsid) noexcept -> bsl::errc_type
+        {
+            return this->get_vs(vsid)->msr_get_list(sys, mut_rdl);
+        }
+
+        /// <!-- description -->
+        ///   @brief Sets the value of the requested MSRs given
+        ///     the provided RDL.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param mut_sys the bf_syscall_t to use
+        ///   @param rdl the RDL to get the requested MSR values from
+        ///   @param vsid the ID of the vs_t to set
+        ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+        ///     and friends otherwise
+        ///
+        [[nodiscard]] constexpr auto
+        msr_set_list(
+            syscall::bf_syscall_t &mut_sys,
+            hypercall::mv_rdl_t const &rdl,
+            bsl::safe_u16 const &vsid) noexcept -> bsl::errc_type
+        {
+            return this->get_vs(vsid)->msr_set_list(mut_sys, rdl);
+        }
+
+        /// <!-- description -->
+        ///   @brief Returns the TSC frequency of the requested vs_t in KHz,
+        ///     or 0 if the frequency is unknown.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param vsid the ID of the vs_t to query
+        ///   @return Returns the TSC frequency of the requested vs_t in KHz,
+        ///     or 0 if the frequency is unknown.
+        ///
+        [[nodiscard]] constexpr auto
+        tsc_khz(bsl::safe_u16 const &vsid) const noexcept -> bsl::safe_u64
+        {
+            return this->get_vs(vsid)->tsc_khz();
+        }
+
+        /// <!-- description -->
+        ///   @brief Sets the TSC frequency of the requested vs_t in KHz
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param mut_sys the bf_syscall_t to use
+        ///   @param host_khz the TSC frequency of the PP in KHz
+        ///   @param khz the TSC frequency the vs_t should see in KHz
+        ///   @param vsid the ID of the vs_t to set
+        ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+        ///     and friends otherwise
+        ///
+        [[nodiscard]] constexpr auto
+        tsc_set_khz(
+            syscall::bf_syscall_t &mut_sys,
+            bsl::safe_u64 const &host_khz,
+            bsl::safe_u64 const &khz,
+            bsl::safe_u16 const &vsid) noexcept -> bsl::errc_type
+        {
+            return this->get_vs(vsid)->tsc_set_khz(mut_sys, host_khz, khz);
+        }
+
+        /// <!-- description -->
+        ///   @brief Sets the TSC offset of the requested vs_t
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param mut_sys the bf_syscall_t to use
+        ///   @param offset the TSC offset to use (two's complement)
+        ///   @param vsid the ID of the vs_t to set
+        ///
+        constexpr void
+        tsc_set_offset(
+            syscall::bf_syscall_t &mut_sys,
+            bsl::safe_u64 const &offset,
+            bsl::safe_u16 const &vsid) noexcept
+        {
+            this->get_vs(vsid)->tsc_set_offset(mut_sys, offset);
+        }
+
+        /// <!-- description -->
+        ///   @brief Writes the kvmclock structures of the requested vs_t if
+        ///     they are out of date. See vs_t::clock_update for more details.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param tls the tls_t to use
+        ///   @param mut_sys the bf_syscall_t to use
+        ///   @param mut_pp_pool the pp_pool_t to use
+        ///   @param vm_pool the vm_pool_t to use
+        ///   @param intrinsic the intrinsic_t to use
+        ///   @param vsid the ID of the vs_t to update
+        ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+        ///     and friends otherwise
+        ///
+        [[nodiscard]] constexpr auto
+        clock_update(
+            tls_t const &tls,
+            syscall::bf_syscall_t &mut_sys,
+            pp_pool_t &mut_pp_pool,
+            vm_pool_t const &vm_pool,
+            intrinsic_t const &intrinsic,
+            bsl::safe_u16 const &vsid) noexcept -> bsl::errc_type
+        {
+            return this->get_vs(vsid)->clock_update(tls, mut_sys, mut_pp_pool, vm_pool, intrinsic);
+        }
+
+        /// <!-- description -->
+        ///   @brief Tells the guest that the requested vs_t is preempted.
+        ///     See vs_t::steal_time_preempt for more details.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param tls the tls_t to use
+        ///   @param mut_sys the bf_syscall_t to use
+        ///   @param mut_pp_pool the pp_pool_t to use
+        ///   @param vm_pool the vm_pool_t to use
+        ///   @param intrinsic the intrinsic_t to use
+        ///   @param vsid the ID of the vs_t that is preempted
+        ///
+        constexpr void
+        steal_time_preempt(
+            tls_t const &tls,
+            syscall::bf_syscall_t &mut_sys,
+            pp_pool_t &mut_pp_pool,
+            vm_pool_t const &vm_pool,
+            intrinsic_t const &intrinsic,
+            bsl::safe_u16 const &vsid) noexcept
+        {
+            this->get_vs(vsid)->steal_time_preempt(tls, mut_sys, mut_pp_pool, vm_pool, intrinsic);
+        }
+
+        /// <!-- description -->
+        ///   @brief Clears the preempted flags of the requested vs_t before
+        ///     it is run. See vs_t::steal_time_sync for more details.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param tls the tls_t to use
+        ///   @param mut_sys the bf_syscall_t to use
+        ///   @param mut_pp_pool the pp_pool_t to use
+        ///   @param vm_pool the vm_pool_t to use
+        ///   @param intrinsic the intrinsic_t to use
+        ///   @param vsid the ID of the vs_t to sync
+        ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+        ///     and friends otherwise
+        ///
+        [[nodiscard]] constexpr auto
+        steal_time_sync(
+            tls_t const &tls,
+            syscall::bf_syscall_t &mut_sys,
+            pp_pool_t &mut_pp_pool,
+            vm_pool_t const &vm_pool,
+            intrinsic_t const &intrinsic,
+            bsl::safe_u16 const &vsid) noexcept -> bsl::errc_type
+        {
+            return this->get_vs(vsid)->steal_time_sync(
+                tls, mut_sys, mut_pp_pool, vm_pool, intrinsic);
+        }
+
+        /// <!-- description -->
+        ///   @brief Records an MSR access of the requested vs_t that was
+        ///     returned to software using mv_exit_reason_t_msr.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param sys the bf_syscall_t to use
+        ///   @param msr the MSR that was accessed
+        ///   @param type MV_EXIT_MSR_READ or MV_EXIT_MSR_WRITE
+        ///   @param vsid the ID of the vs_t that accessed the MSR
+        ///
+        constexpr void
+        msr_exit_begin(
+            syscall::bf_syscall_t const &sys,
+            bsl::safe_u32 const &msr,
+            bsl::safe_u64 const &type,
+            bsl::safe_u16 const &vsid) noexcept
+        {
+            this->get_vs(vsid)->msr_exit_begin(sys, msr, type);
+        }
+
+        /// <!-- description -->
+        ///   @brief Returns true if the requested vs_t has an MSR access
+        ///     that was returned to software and has not been completed
+        ///     yet. Returns false otherwise.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param vsid the ID of the vs_t to query
+        ///   @return Returns true if the requested vs_t has an MSR access
+        ///     that has not been completed yet. Returns false otherwise.
+        ///
+        [[nodiscard]] constexpr auto
+        msr_exit_pending(bsl::safe_u16 const &vsid) const noexcept -> bool
+        {
+            return this->get_vs(vsid)->msr_exit_pending();
+        }
+
+        /// <!-- description -->
+        ///   @brief Completes the MSR access of the requested vs_t that was
+        ///     returned to software using the provided mv_exit_msr_t.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param mut_sys the bf_syscall_t to use
+        ///   @param exit the mv_exit_msr_t provided by software
+        ///   @param vsid the ID of the vs_t to complete
+        ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+        ///     and friends otherwise
+        ///
+        [[nodiscard]] constexpr auto
+        msr_exit_complete(
+            syscall::bf_syscall_t &mut_sys,
+            hypercall::mv_exit_msr_t const &exit,
+            bsl::safe_u16 const &vsid) noexcept -> bsl::errc_type
+        {
+            return this->get_vs(vsid)->msr_exit_complete(mut_sys, exit);
+        }
+
+        /// <!-- description -->
+        ///   @brief Writes the registers that were set while the requested
+        ///     vs_t was not active back to the microkernel.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param mut_sys the bf_syscall_t to use
+        ///   @param vsid the ID of the vs_t to flush
+        ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+        ///     and friends otherwise
+        ///
+        [[nodiscard]] constexpr auto
+        reg_flush(syscall::bf_syscall_t &mut_sys, bsl::safe_u16 const &vsid) noexcept
+            -> bsl::errc_type
+        {
+            return this->get_vs(vsid)->reg_flush(mut_sys);
+        }
+
         /// <!-- description -->
         ///   @brief Returns the requested vs_t's FPU state in the provided
         ///     "page".
@@ -645,6 +1056,36 @@ namespace microv
         {
             return this->get_vs(vsid)->queue_interrupt(mut_sys, vector);
         }
+
+        /// <!-- description -->
+        ///   @brief Pushes a dirty gfn to the dirty ring of the requested
+        ///     vs_t. Returns true if the dirty ring is full after the push.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param gfn the dirty gfn to push
+        ///   @param vsid the ID of the vs_t to push the dirty gfn to
+        ///   @return Returns true if the dirty ring is full, false otherwise
+        ///
+        [[nodiscard]] constexpr auto
+        dirty_ring_push(hypercall::mv_dirty_gfn_t const &gfn, bsl::safe_u16 const &vsid) noexcept
+            -> bool
+        {
+            return this->get_vs(vsid)->dirty_ring_push(gfn);
+        }
+
+        /// <!-- description -->
+        ///   @brief Moves entries from the dirty ring of the requested vs_t
+        ///     into the provided mv_dirty_ring_t.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param mut_ring the mv_dirty_ring_t to move the entries into
+        ///   @param vsid the ID of the vs_t to query
+        ///
+        constexpr void
+        dirty_ring_get(hypercall::mv_dirty_ring_t &mut_ring, bsl::safe_u16 const &vsid) noexcept
+        {
+            this->get_vs(vsid)->dirty_ring_get(mut_ring);
+        }
     };
 }
 
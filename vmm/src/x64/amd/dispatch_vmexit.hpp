@@ -37,12 +37,14 @@
 #include <dispatch_vmexit_io.hpp>
 #include <dispatch_vmexit_mmio.hpp>
 #include <dispatch_vmexit_nmi.hpp>
+#include <dispatch_vmexit_pause.hpp>
 #include <dispatch_vmexit_rdmsr.hpp>
 #include <dispatch_vmexit_sipi.hpp>
 #include <dispatch_vmexit_triple_fault.hpp>
 #include <dispatch_vmexit_unknown.hpp>
 #include <dispatch_vmexit_vmcall.hpp>
 #include <dispatch_vmexit_wrmsr.hpp>
+#include <dispatch_vmexit_xsetbv.hpp>
 #include <errc_types.hpp>
 #include <gs_t.hpp>
 #include <intrinsic_t.hpp>
@@ -64,10 +66,20 @@ namespace microv
     constexpr auto EXIT_REASON_NMI{0x61_u64};
     /// @brief defines the CPUID exit reason code
     constexpr auto EXIT_REASON_CPUID{0x72_u64};
+    /// @brief defines the PAUSE exit reason code
+    constexpr auto EXIT_REASON_PAUSE{0x77_u64};
+    /// @brief defines the HLT exit reason code
+    constexpr auto EXIT_REASON_HLT{0x78_u64};
     /// @brief defines the IOIO exit reason code
     constexpr auto EXIT_REASON_IOIO{0x7B_u64};
+    /// @brief defines the MSR exit reason code
+    constexpr auto EXIT_REASON_MSR{0x7C_u64};
     /// @brief defines the VMCALL exit reason code
     constexpr auto EXIT_REASON_VMCALL{0x81_u64};
+    /// @brief defines the XSETBV exit reason code
+    constexpr auto EXIT_REASON_XSETBV{0x8D_u64};
+    /// @brief defines the nested page fault exit reason code
+    constexpr auto EXIT_REASON_NPF{0x400_u64};
 
     /// <!-- description -->
     ///   @brief Dispatches the VMExit.
@@ -149,6 +161,36 @@ namespace microv
                 break;
             }
 
+            case EXIT_REASON_HLT.get(): {
+                mut_ret = dispatch_vmexit_hlt(
+                    gs,
+                    mut_tls,
+                    mut_sys,
+                    mut_page_pool,
+                    intrinsic,
+                    mut_pp_pool,
+                    mut_vm_pool,
+                    mut_vp_pool,
+                    mut_vs_pool,
+                    vsid);
+                break;
+            }
+
+            case EXIT_REASON_PAUSE.get(): {
+                mut_ret = dispatch_vmexit_pause(
+                    gs,
+                    mut_tls,
+                    mut_sys,
+                    mut_page_pool,
+                    intrinsic,
+                    mut_pp_pool,
+                    mut_vm_pool,
+                    mut_vp_pool,
+                    mut_vs_pool,
+                    vsid);
+                break;
+            }
+
             case EXIT_REASON_IOIO.get(): {
                 mut_ret = dispatch_vmexit_io(
                     gs,
@@ -164,6 +206,56 @@ namespace microv
                 break;
             }
 
+            case EXIT_REASON_MSR.get(): {
+                auto const exitinfo1{
+                    mut_sys.bf_vs_op_read(vsid, syscall::bf_reg_t::bf_reg_t_exitinfo1)};
+                bsl::expects(exitinfo1.is_valid());
+
+                if (exitinfo1.is_zero()) {
+                    mut_ret = dispatch_vmexit_rdmsr(
+                        gs,
+                        mut_tls,
+                        mut_sys,
+                        mut_page_pool,
+                        intrinsic,
+                        mut_pp_pool,
+                        mut_vm_pool,
+                        mut_vp_pool,
+                        mut_vs_pool,
+                        vsid);
+                }
+                else {
+                    mut_ret = dispatch_vmexit_wrmsr(
+                        gs,
+                        mut_tls,
+                        mut_sys,
+                        mut_page_pool,
+                        intrinsic,
+                        mut_pp_pool,
+                        mut_vm_pool,
+                        mut_vp_pool,
+                        mut_vs_pool,
+                        vsid);
+                }
+
+                break;
+            }
+
+            case EXIT_REASON_NPF.get(): {
+                mut_ret = dispatch_vmexit_mmio(
+                    gs,
+                    mut_tls,
+                    mut_sys,
+                    mut_page_pool,
+                    intrinsic,
+                    mut_pp_pool,
+                    mut_vm_pool,
+                    mut_vp_pool,
+                    mut_vs_pool,
+                    vsid);
+                break;
+            }
+
             case EXIT_REASON_VMCALL.get(): {
                 mut_ret = dispatch_vmexit_vmcall(
                     gs,
@@ -179,6 +271,21 @@ namespace microv
                 break;
             }
 
+            case EXIT_REASON_XSETBV.get(): {
+                mut_ret = dispatch_vmexit_xsetbv(
+                    gs,
+                    mut_tls,
+                    mut_sys,
+                    mut_page_pool,
+                    intrinsic,
+                    mut_pp_pool,
+                    mut_vm_pool,
+                    mut_vp_pool,
+                    mut_vs_pool,
+                    vsid);
+                break;
+            }
+
             default: {
                 mut_ret = dispatch_vmexit_unknown(
                     gs,
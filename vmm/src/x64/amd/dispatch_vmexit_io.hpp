@@ -30,6 +30,7 @@
 #include <dispatch_vmcall_helpers.hpp>
 #include <gs_t.hpp>
 #include <intrinsic_t.hpp>
+#include <iopm_t.hpp>
 #include <mv_exit_io_t.hpp>
 #include <pp_pool_t.hpp>
 #include <tls_t.hpp>
@@ -95,23 +96,12 @@ namespace microv
         auto const rax{mut_sys.bf_tls_rax()};
         auto const rcx{mut_sys.bf_tls_rcx()};
 
-        // ---------------------------------------------------------------------
-        // Context: Change To Root VM
-        // ---------------------------------------------------------------------
-
-        switch_to_root(mut_tls, mut_sys, intrinsic, mut_vm_pool, mut_vp_pool, mut_vs_pool);
-
-        // ---------------------------------------------------------------------
-        // Context: Root VM
-        // ---------------------------------------------------------------------
-
-        auto mut_exit_io{mut_pp_pool.shared_page<hypercall::mv_exit_io_t>(mut_sys)};
-        bsl::expects(mut_exit_io.is_valid());
-
         constexpr auto port_mask{0xFFFF0000_u64};
         constexpr auto port_shft{16_u64};
         constexpr auto reps_mask{0x00000008_u64};
         constexpr auto reps_shft{3_u64};
+        constexpr auto strn_mask{0x00000004_u64};
+        constexpr auto strn_shft{2_u64};
         constexpr auto type_mask{0x00000001_u64};
         constexpr auto type_shft{0_u64};
 
@@ -121,6 +111,35 @@ namespace microv
         constexpr auto sz16_shft{5_u64};
         constexpr auto sz08_mask{0x00000010_u64};
         constexpr auto sz08_shft{4_u64};
+        constexpr auto size_mask{(sz32_mask | sz16_mask | sz08_mask).checked()};
+
+        auto const strn{((exitinfo1 & strn_mask) >> strn_shft).checked()};
+        auto const port{((exitinfo1 & port_mask) >> port_shft).checked()};
+        auto const bytes{((exitinfo1 & size_mask) >> sz08_shft).checked()};
+
+        if (strn.is_zero() && mut_vm_pool.is_io_ignored(mut_sys.bf_tls_vmid(), port, bytes)) {
+            if (((exitinfo1 & type_mask) >> type_shft).is_pos()) {
+                mut_sys.bf_tls_set_rax(iopm_ignored_read(rax, bytes));
+            }
+            else {
+                bsl::touch();
+            }
+
+            return vmexit_success_advance_ip_and_run;
+        }
+
+        // ---------------------------------------------------------------------
+        // Context: Change To Root VM
+        // ---------------------------------------------------------------------
+
+        switch_to_root(mut_tls, mut_sys, intrinsic, mut_vm_pool, mut_vp_pool, mut_vs_pool);
+
+        // ---------------------------------------------------------------------
+        // Context: Root VM
+        // ---------------------------------------------------------------------
+
+        auto mut_exit_io{mut_pp_pool.shared_page<hypercall::mv_exit_io_t>(mut_sys)};
+        bsl::expects(mut_exit_io.is_valid());
 
         mut_exit_io->addr = ((exitinfo1 & port_mask) >> port_shft).get();
 
@@ -28,6 +28,9 @@
 #include <bf_syscall_t.hpp>
 #include <gs_t.hpp>
 #include <intrinsic_t.hpp>
+#include <mv_dirty_ring_t.hpp>
+#include <mv_exit_mmio_t.hpp>
+#include <mv_exit_reason_t.hpp>
 #include <page_pool_t.hpp>
 #include <pp_pool_t.hpp>
 #include <tls_t.hpp>
@@ -39,22 +42,30 @@
 #include <bsl/debug.hpp>
 #include <bsl/discard.hpp>
 #include <bsl/errc_type.hpp>
+#include <bsl/safe_integral.hpp>
+#include <bsl/touch.hpp>
 
 namespace microv
 {
     /// <!-- description -->
-    ///   @brief Dispatches MMIO VMExits.
+    ///   @brief Dispatches MMIO VMExits (nested page faults). Write faults on pages
+    ///     that are being dirty logged are handled here by marking the
+    ///     page as dirty, restoring write access and adding the page to
+    ///     the dirty ring of the VS, after which the guest is resumed, or
+    ///     the root VM is told that the dirty ring is full. All other
+    ///     faults are returned to the root VM as MMIO exits, which is how
+    ///     guest memory is mapped on demand.
     ///
     /// <!-- inputs/outputs -->
     ///   @param gs the gs_t to use
-    ///   @param tls the tls_t to use
+    ///   @param mut_tls the tls_t to use
     ///   @param mut_sys the bf_syscall_t to use
     ///   @param page_pool the page_pool_t to use
     ///   @param intrinsic the intrinsic_t to use
-    ///   @param pp_pool the pp_pool_t to use
-    ///   @param vm_pool the vm_pool_t to use
-    ///   @param vp_pool the vp_pool_t to use
-    ///   @param vs_pool the vs_pool_t to use
+    ///   @param mut_pp_pool the pp_pool_t to use
+    ///   @param mut_vm_pool the vm_pool_t to use
+    ///   @param mut_vp_pool the vp_pool_t to use
+    ///   @param mut_vs_pool the vs_pool_t to use
     ///   @param vsid the ID of the VS that generated the VMExit
     ///   @return Returns bsl::errc_success on success, bsl::errc_failure
     ///     and friends otherwise
@@ -62,29 +73,121 @@ namespace microv
     [[nodiscard]] constexpr auto
     dispatch_vmexit_mmio(
         gs_t const &gs,
-        tls_t const &tls,
+        tls_t &mut_tls,
         syscall::bf_syscall_t &mut_sys,
         page_pool_t const &page_pool,
         intrinsic_t const &intrinsic,
-        pp_pool_t const &pp_pool,
-        vm_pool_t const &vm_pool,
-        vp_pool_t const &vp_pool,
-        vs_pool_t const &vs_pool,
+        pp_pool_t &mut_pp_pool,
+        vm_pool_t &mut_vm_pool,
+        vp_pool_t &mut_vp_pool,
+        vs_pool_t &mut_vs_pool,
         bsl::safe_u16 const &vsid) noexcept -> bsl::errc_type
     {
         bsl::discard(gs);
-        bsl::discard(tls);
-        bsl::discard(mut_sys);
         bsl::discard(page_pool);
-        bsl::discard(intrinsic);
-        bsl::discard(pp_pool);
-        bsl::discard(vm_pool);
-        bsl::discard(vp_pool);
-        bsl::discard(vs_pool);
-        bsl::discard(vsid);
-
-        bsl::error() << "dispatch_vmexit_mmio not implemented\n" << bsl::here();
-        return bsl::errc_failure;
+
+        // ---------------------------------------------------------------------
+        // Context: Guest VM
+        // ---------------------------------------------------------------------
+
+        auto const exitinfo1{mut_sys.bf_vs_op_read(vsid, syscall::bf_reg_t::bf_reg_t_exitinfo1)};
+        bsl::expects(exitinfo1.is_valid());
+
+        auto const gpa{mut_sys.bf_vs_op_read(vsid, syscall::bf_reg_t::bf_reg_t_exitinfo2)};
+        bsl::expects(gpa.is_valid());
+
+        /// NOTE:
+        /// - A write fault is reported in bit 1 and an instruction fetch
+        ///   in bit 4 of EXITINFO1. There is no read bit, so reads are
+        ///   always reported. If the VM is dirty logging the page, a write
+        ///   fault was caused by write protection, so we log it and let
+        ///   the guest retry.
+        ///
+
+        constexpr auto write_mask{0x00000002_u64};
+        constexpr auto exec_mask{0x00000010_u64};
+        auto const vmid{mut_sys.bf_tls_vmid()};
+        bool const write{!(exitinfo1 & write_mask).is_zero()};
+        bool const exec{!(exitinfo1 & exec_mask).is_zero()};
+
+        /// NOTE:
+        /// - Faults that are not the result of dirty logging are returned
+        ///   to the root VM as MMIO exits. Guest memory is only mapped
+        ///   once the guest touches it, so most of these are the first
+        ///   access to a page of guest RAM, which the root VM maps before
+        ///   running the VS again. The faulting instruction has not been
+        ///   executed, so the guest's IP is not advanced when switching to
+        ///   the root VM, and the guest simply retries it once resumed.
+        ///
+        /// - If the page was already dirty (i.e., another VS logged it
+        ///   first), there is nothing to add to the dirty ring. Otherwise
+        ///   the page is added to the dirty ring of this VS. Once the ring
+        ///   is full, we return to the root VM so that it can harvest the
+        ///   ring before this VS is allowed to run again. The write itself
+        ///   has not completed yet, so like an MMIO exit, the guest's IP
+        ///   is not advanced and the guest retries the write when resumed.
+        ///
+
+        auto mut_exit_reason{hypercall::EXIT_REASON_MMIO};
+
+        hypercall::mv_dirty_gfn_t mut_gfn{};
+        if (write && mut_vm_pool.dirty_log_write_fault(mut_tls, mut_sys, vmid, gpa, mut_gfn)) {
+            if (bsl::safe_u32{mut_gfn.flags}.is_zero()) {
+                return vmexit_success_run;
+            }
+
+            if (!mut_vs_pool.dirty_ring_push(mut_gfn, vsid)) {
+                return vmexit_success_run;
+            }
+
+            mut_exit_reason = hypercall::EXIT_REASON_DIRTY_RING_FULL;
+        }
+        else {
+            bsl::touch();
+        }
+
+        // ---------------------------------------------------------------------
+        // Context: Change To Root VM
+        // ---------------------------------------------------------------------
+
+        constexpr auto advance_ip{false};
+        switch_to_root(
+            mut_tls, mut_sys, intrinsic, mut_vm_pool, mut_vp_pool, mut_vs_pool, advance_ip);
+
+        // ---------------------------------------------------------------------
+        // Context: Root VM
+        // ---------------------------------------------------------------------
+
+        if (hypercall::EXIT_REASON_MMIO == mut_exit_reason) {
+            auto mut_exit_mmio{mut_pp_pool.shared_page<hypercall::mv_exit_mmio_t>(mut_sys)};
+            bsl::expects(mut_exit_mmio.is_valid());
+
+            bsl::safe_u64 mut_flags{hypercall::MV_EXIT_MMIO_READ};
+            if (write) {
+                mut_flags |= hypercall::MV_EXIT_MMIO_WRITE;
+            }
+            else {
+                bsl::touch();
+            }
+
+            if (exec) {
+                mut_flags |= hypercall::MV_EXIT_MMIO_EXECUTE;
+            }
+            else {
+                bsl::touch();
+            }
+
+            mut_exit_mmio->gpa = gpa.get();
+            mut_exit_mmio->flags = mut_flags.get();
+        }
+        else {
+            bsl::touch();
+        }
+
+        set_reg_return(mut_sys, hypercall::MV_STATUS_SUCCESS);
+        set_reg0(mut_sys, bsl::to_u64(mut_exit_reason));
+
+        return vmexit_success_advance_ip_and_run;
     }
 }
 
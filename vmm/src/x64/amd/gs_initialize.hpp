@@ -64,32 +64,12 @@ namespace microv
             return bsl::errc_failure;
         }
 
-        mut_gs.guest_iopm = alloc_bitmap(mut_sys, IOPM_SIZE, mut_gs.guest_iopm_spa);
-        if (bsl::unlikely(mut_gs.guest_iopm.is_invalid())) {
-            bsl::print<bsl::V>() << bsl::here();
-            return bsl::errc_failure;
-        }
-
         mut_gs.root_msrpm = alloc_bitmap(mut_sys, MSRPM_SIZE, mut_gs.root_msrpm_spa);
         if (bsl::unlikely(mut_gs.root_msrpm.is_invalid())) {
             bsl::print<bsl::V>() << bsl::here();
             return bsl::errc_failure;
         }
 
-        mut_gs.guest_msrpm = alloc_bitmap(mut_sys, MSRPM_SIZE, mut_gs.guest_msrpm_spa);
-        if (bsl::unlikely(mut_gs.guest_msrpm.is_invalid())) {
-            bsl::print<bsl::V>() << bsl::here();
-            return bsl::errc_failure;
-        }
-
-        for (auto &elem : mut_gs.guest_iopm) {
-            elem = bsl::safe_u8::max_value().get();
-        }
-
-        for (auto &elem : mut_gs.guest_msrpm) {
-            elem = bsl::safe_u8::max_value().get();
-        }
-
         return bsl::errc_success;
     }
 }
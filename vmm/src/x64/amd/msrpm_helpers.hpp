@@ -0,0 +1,117 @@
+/// @copyright
+/// Copyright (C) 2020 Assured Information Security, Inc.
+///
+/// @copyright
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// @copyright
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// @copyright
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+
+
+#ifndef MSRPM_HELPERS_HPP
+#define MSRPM_HELPERS_HPP
+
+#include <bsl/convert.hpp>
+#include <bsl/expects.hpp>
+#include <bsl/safe_integral.hpp>
+
+namespace microv
+{
+    /// @brief stores the number of MSRs covered by each range of the MSRPM
+    constexpr auto MSRPM_RANGE_SIZE{0x00002000_u32};
+    /// @brief stores the first MSR covered by the first range of the MSRPM
+    constexpr auto MSRPM_RANGE0_BASE{0x00000000_u32};
+    /// @brief stores the first MSR covered by the second range of the MSRPM
+    constexpr auto MSRPM_RANGE1_BASE{0xC0000000_u32};
+    /// @brief stores the first MSR covered by the third range of the MSRPM
+    constexpr auto MSRPM_RANGE2_BASE{0xC0010000_u32};
+    /// @brief stores the bit offset of the second range of the MSRPM
+    constexpr auto MSRPM_RANGE1_BIT{0x4000_u64};
+    /// @brief stores the bit offset of the third range of the MSRPM
+    constexpr auto MSRPM_RANGE2_BIT{0x8000_u64};
+
+    /// <!-- description -->
+    ///   @brief Returns the bit in the MSRPM that intercepts reads from the
+    ///     provided MSR. Each MSR is described by two bits in the MSRPM,
+    ///     with the even bit intercepting reads and the odd bit
+    ///     intercepting writes. If the MSR is not covered by the MSRPM,
+    ///     bsl::safe_u64::failure() is returned, in which case reads from
+    ///     the MSR are always intercepted.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param msr the MSR to query
+    ///   @return Returns the bit in the MSRPM that intercepts reads from
+    ///     the provided MSR, or bsl::safe_u64::failure() if the MSR is not
+    ///     covered by the MSRPM.
+    ///
+    [[nodiscard]] constexpr auto
+    msrpm_read_bit(bsl::safe_u32 const &msr) noexcept -> bsl::safe_u64
+    {
+        bsl::expects(msr.is_valid_and_checked());
+
+        if (msr < (MSRPM_RANGE0_BASE + MSRPM_RANGE_SIZE).checked()) {
+            auto const idx{bsl::to_u64((msr - MSRPM_RANGE0_BASE).checked())};
+            return (idx * bsl::safe_u64::magic_2()).checked();
+        }
+
+        if (msr < MSRPM_RANGE1_BASE) {
+            return bsl::safe_u64::failure();
+        }
+
+        if (msr < (MSRPM_RANGE1_BASE + MSRPM_RANGE_SIZE).checked()) {
+            auto const idx{bsl::to_u64((msr - MSRPM_RANGE1_BASE).checked())};
+            return (MSRPM_RANGE1_BIT + (idx * bsl::safe_u64::magic_2())).checked();
+        }
+
+        if (msr < MSRPM_RANGE2_BASE) {
+            return bsl::safe_u64::failure();
+        }
+
+        if (msr < (MSRPM_RANGE2_BASE + MSRPM_RANGE_SIZE).checked()) {
+            auto const idx{bsl::to_u64((msr - MSRPM_RANGE2_BASE).checked())};
+            return (MSRPM_RANGE2_BIT + (idx * bsl::safe_u64::magic_2())).checked();
+        }
+
+        return bsl::safe_u64::failure();
+    }
+
+    /// <!-- description -->
+    ///   @brief Returns the bit in the MSRPM that intercepts writes to the
+    ///     provided MSR. If the MSR is not covered by the MSRPM,
+    ///     bsl::safe_u64::failure() is returned, in which case writes to
+    ///     the MSR are always intercepted.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param msr the MSR to query
+    ///   @return Returns the bit in the MSRPM that intercepts writes to
+    ///     the provided MSR, or bsl::safe_u64::failure() if the MSR is not
+    ///     covered by the MSRPM.
+    ///
+    [[nodiscard]] constexpr auto
+    msrpm_write_bit(bsl::safe_u32 const &msr) noexcept -> bsl::safe_u64
+    {
+        auto const bit{msrpm_read_bit(msr)};
+        if (bit.is_invalid()) {
+            return bsl::safe_u64::failure();
+        }
+
+        return (bit + bsl::safe_u64::magic_1()).checked();
+    }
+}
+
+#endif
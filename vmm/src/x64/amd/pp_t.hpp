@@ -27,9 +27,11 @@
 
 #include <allocated_status_t.hpp>
 #include <bf_syscall_t.hpp>
+#include <clock_scale_t.hpp>
 #include <get_tsc_freq.hpp>
 #include <gs_t.hpp>
 #include <intrinsic_t.hpp>
+#include <mv_cdl_t.hpp>
 #include <pp_cpuid_t.hpp>
 #include <pp_lapic_t.hpp>
 #include <pp_mmio_t.hpp>
@@ -38,10 +40,12 @@
 #include <pp_reg_t.hpp>
 #include <tls_t.hpp>
 
+#include <bsl/debug.hpp>
 #include <bsl/discard.hpp>
 #include <bsl/ensures.hpp>
 #include <bsl/expects.hpp>
 #include <bsl/safe_integral.hpp>
+#include <bsl/unlikely.hpp>
 
 namespace microv
 {
@@ -68,8 +72,10 @@ namespace microv
         /// @brief stores this pp_t's pp_reg_t
         pp_reg_t m_pp_reg{};
 
-        /// @brief stores the TSC frequency of this physical processor
+        /// @brief stores the TSC frequency of this physical processor in KHz
         bsl::safe_u64 m_tsc_freq{};
+        /// @brief stores the clock_scale_t that converts TSC ticks into ns
+        clock_scale_t m_tsc_to_ns{};
 
     public:
         /// <!-- description -->
@@ -158,43 +164,101 @@ namespace microv
             tls_t const &tls,
             syscall::bf_syscall_t const &sys,
             page_pool_t const &page_pool,
-            intrinsic_t const &intrinsic) const noexcept -> bsl::safe_u16
+            intrinsic_t const &intrinsic) noexcept -> bsl::safe_u16
         {
             bsl::expects(this->id() != syscall::BF_INVALID_ID);
 
-            bsl::discard(gs);
-            bsl::discard(tls);
-            bsl::discard(sys);
             bsl::discard(page_pool);
-            bsl::discard(intrinsic);
 
-            // m_tsc_freq = get_tsc_freq(intrinsic);
-            // if (bsl::unlikely(m_tsc_freq.is_invalid())) {
-            //     bsl::error() << "System not supported because the TSC is not invariant" << bsl::endl
-            //                  << bsl::here();
+            m_pp_cpuid.allocate(gs, tls, sys, intrinsic);
 
-            //     return bsl::safe_u16::failure();
-            // }
+            /// NOTE:
+            /// - The TSC frequency is read once here and cached so that
+            ///   the rest of MicroV never has to execute CPUID to get it.
+            ///   If the frequency cannot be determined, it is set to 0,
+            ///   and any attempt to use it (like TSC scaling or reporting
+            ///   it to a guest) will fail instead of the entire PP.
+            ///
 
-            // /// TODO:
-            // /// - We need to detect all of the features that we need
-            // ///   support for here and error out if the CPU does not
-            // ///   support the features that we need. This includes
-            // ///
-            // ///   - CPUID
-            // ///   - MSRs
-            // ///
+            m_tsc_freq = get_tsc_freq(intrinsic);
+            if (bsl::unlikely(m_tsc_freq.is_invalid())) {
+                bsl::print<bsl::V>() << "unable to determine the tsc frequency on pp "    // --
+                                     << bsl::hex(this->id())                              // --
+                                     << bsl::endl;                                        // --
 
-            // bsl::debug<bsl::V>()                                   // --
-            //     << "tsc frequency on pp "                          // --
-            //     << bsl::cyn << bsl::hex(this->id()) << bsl::rst    // --
-            //     << " is "                                          // --
-            //     << bsl::grn << m_tsc_freq << "khz" << bsl::rst     // --
-            //     << bsl::endl;                                      // --
+                m_tsc_freq = {};
+                return this->id();
+            }
+
+            m_tsc_to_ns = make_clock_scale((m_tsc_freq * HZ_PER_KHZ).checked(), NSEC_PER_SEC);
+
+            bsl::debug<bsl::V>()                                   // --
+                << "tsc frequency on pp "                          // --
+                << bsl::cyn << bsl::hex(this->id()) << bsl::rst    // --
+                << " is "                                          // --
+                << bsl::grn << m_tsc_freq << "khz" << bsl::rst     // --
+                << bsl::endl;                                      // --
 
             return this->id();
         }
 
+        /// <!-- description -->
+        ///   @brief Returns the TSC frequency of this pp_t in KHz. The
+        ///     frequency is measured once when the pp_t is allocated. If
+        ///     the frequency could not be determined, 0 is returned.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @return Returns the TSC frequency of this pp_t in KHz, or 0
+        ///     if the frequency is unknown.
+        ///
+        [[nodiscard]] constexpr auto
+        tsc_khz() const noexcept -> bsl::safe_u64
+        {
+            bsl::ensures(m_tsc_freq.is_valid_and_checked());
+            return m_tsc_freq;
+        }
+
+        /// <!-- description -->
+        ///   @brief Converts the provided TSC value of this pp_t into
+        ///     nanoseconds using the cached TSC frequency. If the frequency
+        ///     could not be determined, bsl::safe_u64::failure() is returned.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param tsc the TSC value to convert
+        ///   @return Returns the provided TSC value in nanoseconds, or
+        ///     bsl::safe_u64::failure() if the frequency is unknown.
+        ///
+        [[nodiscard]] constexpr auto
+        tsc_to_ns(bsl::safe_u64 const &tsc) const noexcept -> bsl::safe_u64
+        {
+            if (bsl::unlikely(m_tsc_freq.is_zero())) {
+                bsl::error() << "the tsc frequency of pp "    // --
+                             << bsl::hex(this->id())          // --
+                             << " is unknown"                 // --
+                             << bsl::endl                     // --
+                             << bsl::here();                  // --
+
+                return bsl::safe_u64::failure();
+            }
+
+            return scale_clock(tsc, m_tsc_to_ns);
+        }
+
+        /// <!-- description -->
+        ///   @brief Fills in the provided CDL using the CPUID leaves
+        ///     supported by this pp_t. See pp_cpuid_t::supported_list
+        ///     for more details.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param mut_cdl the CDL to fill in
+        ///
+        constexpr void
+        cpuid_get_supported_list(hypercall::mv_cdl_t &mut_cdl) const noexcept
+        {
+            bsl::expects(this->id() != syscall::BF_INVALID_ID);
+            m_pp_cpuid.supported_list(mut_cdl);
+        }
+
         /// <!-- description -->
         ///   @brief Returns a pp_unique_map_t<T> given an SPA to map. If an
         ///     error occurs, an invalid pp_unique_map_t<T> is returned.
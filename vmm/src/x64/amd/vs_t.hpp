@@ -28,6 +28,8 @@
 #include <allocated_status_t.hpp>
 #include <bf_constants.hpp>
 #include <bf_syscall_t.hpp>
+#include <clock_scale_t.hpp>
+#include <emulated_clock_t.hpp>
 #include <emulated_cpuid_t.hpp>
 #include <emulated_cr_t.hpp>
 #include <emulated_decoder_t.hpp>
@@ -35,9 +37,14 @@
 #include <emulated_io_t.hpp>
 #include <emulated_lapic_t.hpp>
 #include <emulated_msr_t.hpp>
+#include <emulated_steal_time_t.hpp>
 #include <emulated_tlb_t.hpp>
 #include <gs_t.hpp>
 #include <intrinsic_t.hpp>
+#include <msr_constants.hpp>
+#include <mv_cdl_t.hpp>
+#include <mv_dirty_ring_t.hpp>
+#include <mv_exit_msr_t.hpp>
 #include <mv_exit_reason_t.hpp>
 #include <mv_rdl_t.hpp>
 #include <mv_reg_t.hpp>
@@ -49,11 +56,16 @@
 #include <queue.hpp>
 #include <running_status_t.hpp>
 #include <tls_t.hpp>
+#include <vm_pool_t.hpp>
+#include <xsave_t.hpp>
 
+#include <bsl/array.hpp>
+#include <bsl/builtin_memset.hpp>
 #include <bsl/cstring.hpp>
 #include <bsl/discard.hpp>
 #include <bsl/errc_type.hpp>
 #include <bsl/finally.hpp>
+#include <bsl/safe_idx.hpp>
 #include <bsl/safe_integral.hpp>
 #include <bsl/span.hpp>
 #include <bsl/touch.hpp>
@@ -61,6 +73,41 @@
 
 namespace microv
 {
+    /// @brief defines the first slot of a vs_t's register cache used by MSRs
+    constexpr auto VS_MSR_CACHE_BASE{
+        bsl::safe_umx{static_cast<bsl::uintmx>(hypercall::MV_MAX_REG_T.get())}};
+
+    /// @brief defines the MSRs held by a vs_t's register cache (other than FS/GS base)
+    constexpr bsl::array VS_MSR_CACHE_MSRS{
+        MSR_EFER,
+        MSR_STAR,
+        MSR_LSTAR,
+        MSR_CSTAR,
+        MSR_FMASK,
+        MSR_KERNEL_GS_BASE,
+        MSR_SYSENTER_CS,
+        MSR_SYSENTER_ESP,
+        MSR_SYSENTER_EIP,
+        MSR_PAT,
+    };
+
+    /// @brief defines the microkernel register of each entry in VS_MSR_CACHE_MSRS
+    constexpr bsl::array VS_MSR_CACHE_REGS{
+        syscall::bf_reg_t::bf_reg_t_efer,
+        syscall::bf_reg_t::bf_reg_t_star,
+        syscall::bf_reg_t::bf_reg_t_lstar,
+        syscall::bf_reg_t::bf_reg_t_cstar,
+        syscall::bf_reg_t::bf_reg_t_fmask,
+        syscall::bf_reg_t::bf_reg_t_kernel_gs_base,
+        syscall::bf_reg_t::bf_reg_t_sysenter_cs,
+        syscall::bf_reg_t::bf_reg_t_sysenter_esp,
+        syscall::bf_reg_t::bf_reg_t_sysenter_eip,
+        syscall::bf_reg_t::bf_reg_t_pat,
+    };
+
+    /// @brief defines the number of registers held by a vs_t's register cache
+    constexpr auto VS_REG_CACHE_SIZE{(VS_MSR_CACHE_BASE + VS_MSR_CACHE_MSRS.size()).checked()};
+
     /// @class microv::vs_t
     ///
     /// <!-- description -->
@@ -83,6 +130,8 @@ namespace microv
         /// @brief stores the ID of the PP this vs_t is active on
         bsl::safe_u16 m_active_ppid{};
 
+        /// @brief stores this vs_t's emulated_clock_t
+        emulated_clock_t m_emulated_clock{};
         /// @brief stores this vs_t's emulated_cpuid_t
         emulated_cpuid_t m_emulated_cpuid{};
         /// @brief stores this vs_t's emulated_cr_t
@@ -97,14 +146,35 @@ namespace microv
         emulated_lapic_t m_emulated_lapic{};
         /// @brief stores this vs_t's emulated_msr_t
         emulated_msr_t m_emulated_msr{};
+        /// @brief stores this vs_t's emulated_steal_time_t
+        emulated_steal_time_t m_emulated_steal_time{};
         /// @brief stores this vs_t's emulated_tlb_t
         emulated_tlb_t m_emulated_tlb{};
 
         /// @brief stores the xsave region for this vs_t
-        page_4k_t *m_xsave{};
+        xsave_t *m_xsave{};
+        /// @brief stores the state components this vs_t's guest can modify
+        bsl::safe_u64 m_xsave_mask{};
+        /// @brief stores the MSR exit software has not completed yet (flags == 0 if none)
+        hypercall::mv_exit_msr_t m_msr_exit{};
+        /// @brief stores the RIP of the instruction that caused m_msr_exit
+        bsl::safe_u64 m_msr_exit_rip{};
+        /// @brief stores the TSC frequency of this vs_t in KHz, or 0 if unknown
+        bsl::safe_u64 m_tsc_khz{};
 
         /// @brief stores a queue of interrupts that need to be injected
         queue<bsl::safe_u64, MICROV_INTERRUPT_QUEUE_SIZE.get()> m_interrupt_queue{};
+        /// @brief stores the dirty gfns that have not been harvested yet
+        queue<hypercall::mv_dirty_gfn_t, MICROV_DIRTY_RING_SIZE.get()> m_dirty_ring{};
+
+        /// @brief stores the pending register writes, indexed by mv_reg_t and then MSR
+        bsl::array<bsl::safe_u64, VS_REG_CACHE_SIZE.get()> m_reg_vals{};
+        /// @brief stores the microkernel register each pending write maps to
+        bsl::array<syscall::bf_reg_t, VS_REG_CACHE_SIZE.get()> m_reg_idxs{};
+        /// @brief stores whether or not a register has a pending write
+        bsl::array<bool, VS_REG_CACHE_SIZE.get()> m_reg_dirty{};
+        /// @brief stores whether or not any register has a pending write
+        bool m_reg_any_dirty{};
 
         /// <!-- description -->
         ///   @brief Initializes the VS to start as a 16bit guest.
@@ -117,6 +187,7 @@ namespace microv
         {
             auto const vsid{this->id()};
             using mk = syscall::bf_reg_t;
+            using mv = hypercall::mv_reg_t;
 
             // -----------------------------------------------------------------
             // General Purpose Registers
@@ -125,30 +196,31 @@ namespace microv
             constexpr auto rip_val{0x0000FFF0_u64};
             constexpr auto rdx_val{0x00000600_u64};
 
-            bsl::expects(mut_sys.bf_vs_op_write(vsid, mk::bf_reg_t_rax, {}));
-            bsl::expects(mut_sys.bf_vs_op_write(vsid, mk::bf_reg_t_rbx, {}));
-            bsl::expects(mut_sys.bf_vs_op_write(vsid, mk::bf_reg_t_rcx, {}));
-            bsl::expects(mut_sys.bf_vs_op_write(vsid, mk::bf_reg_t_rdx, rdx_val));
-            bsl::expects(mut_sys.bf_vs_op_write(vsid, mk::bf_reg_t_rbp, {}));
-            bsl::expects(mut_sys.bf_vs_op_write(vsid, mk::bf_reg_t_rsi, {}));
-            bsl::expects(mut_sys.bf_vs_op_write(vsid, mk::bf_reg_t_rdi, {}));
-            bsl::expects(mut_sys.bf_vs_op_write(vsid, mk::bf_reg_t_r8, {}));
-            bsl::expects(mut_sys.bf_vs_op_write(vsid, mk::bf_reg_t_r9, {}));
-            bsl::expects(mut_sys.bf_vs_op_write(vsid, mk::bf_reg_t_r10, {}));
-            bsl::expects(mut_sys.bf_vs_op_write(vsid, mk::bf_reg_t_r11, {}));
-            bsl::expects(mut_sys.bf_vs_op_write(vsid, mk::bf_reg_t_r12, {}));
-            bsl::expects(mut_sys.bf_vs_op_write(vsid, mk::bf_reg_t_r13, {}));
-            bsl::expects(mut_sys.bf_vs_op_write(vsid, mk::bf_reg_t_r14, {}));
-            bsl::expects(mut_sys.bf_vs_op_write(vsid, mk::bf_reg_t_r15, {}));
-            bsl::expects(mut_sys.bf_vs_op_write(vsid, mk::bf_reg_t_rip, rip_val));
-            bsl::expects(mut_sys.bf_vs_op_write(vsid, mk::bf_reg_t_rsp, {}));
+            bsl::expects(this->reg_write(mut_sys, mv::mv_reg_t_rax, mk::bf_reg_t_rax, {}));
+            bsl::expects(this->reg_write(mut_sys, mv::mv_reg_t_rbx, mk::bf_reg_t_rbx, {}));
+            bsl::expects(this->reg_write(mut_sys, mv::mv_reg_t_rcx, mk::bf_reg_t_rcx, {}));
+            bsl::expects(this->reg_write(mut_sys, mv::mv_reg_t_rdx, mk::bf_reg_t_rdx, rdx_val));
+            bsl::expects(this->reg_write(mut_sys, mv::mv_reg_t_rbp, mk::bf_reg_t_rbp, {}));
+            bsl::expects(this->reg_write(mut_sys, mv::mv_reg_t_rsi, mk::bf_reg_t_rsi, {}));
+            bsl::expects(this->reg_write(mut_sys, mv::mv_reg_t_rdi, mk::bf_reg_t_rdi, {}));
+            bsl::expects(this->reg_write(mut_sys, mv::mv_reg_t_r8, mk::bf_reg_t_r8, {}));
+            bsl::expects(this->reg_write(mut_sys, mv::mv_reg_t_r9, mk::bf_reg_t_r9, {}));
+            bsl::expects(this->reg_write(mut_sys, mv::mv_reg_t_r10, mk::bf_reg_t_r10, {}));
+            bsl::expects(this->reg_write(mut_sys, mv::mv_reg_t_r11, mk::bf_reg_t_r11, {}));
+            bsl::expects(this->reg_write(mut_sys, mv::mv_reg_t_r12, mk::bf_reg_t_r12, {}));
+            bsl::expects(this->reg_write(mut_sys, mv::mv_reg_t_r13, mk::bf_reg_t_r13, {}));
+            bsl::expects(this->reg_write(mut_sys, mv::mv_reg_t_r14, mk::bf_reg_t_r14, {}));
+            bsl::expects(this->reg_write(mut_sys, mv::mv_reg_t_r15, mk::bf_reg_t_r15, {}));
+            bsl::expects(this->reg_write(mut_sys, mv::mv_reg_t_rip, mk::bf_reg_t_rip, rip_val));
+            bsl::expects(this->reg_write(mut_sys, mv::mv_reg_t_rsp, mk::bf_reg_t_rsp, {}));
 
             // -----------------------------------------------------------------
             // General Purpose Registers
             // -----------------------------------------------------------------
 
             constexpr auto rflags_val{0x00000002_u64};
-            bsl::expects(mut_sys.bf_vs_op_write(vsid, mk::bf_reg_t_rflags, rflags_val));
+            bsl::expects(this->reg_write(
+                mut_sys, mv::mv_reg_t_rflags, mk::bf_reg_t_rflags, rflags_val));
 
             // -----------------------------------------------------------------
             // ES
@@ -156,19 +228,22 @@ namespace microv
 
             constexpr auto es_selector_val{0x0_u64};
             constexpr auto es_selector_idx{mk::bf_reg_t_es_selector};
-            bsl::expects(mut_sys.bf_vs_op_write(vsid, es_selector_idx, es_selector_val));
+            bsl::expects(this->reg_write(
+                mut_sys, mv::mv_reg_t_es_selector, es_selector_idx, es_selector_val));
 
             constexpr auto es_base_val{0x0_u64};
             constexpr auto es_base_idx{mk::bf_reg_t_es_base};
-            bsl::expects(mut_sys.bf_vs_op_write(vsid, es_base_idx, es_base_val));
+            bsl::expects(this->reg_write(mut_sys, mv::mv_reg_t_es_base, es_base_idx, es_base_val));
 
             constexpr auto es_limit_val{0xFFFF_u64};
             constexpr auto es_limit_idx{mk::bf_reg_t_es_limit};
-            bsl::expects(mut_sys.bf_vs_op_write(vsid, es_limit_idx, es_limit_val));
+            bsl::expects(this->reg_write(
+                mut_sys, mv::mv_reg_t_es_limit, es_limit_idx, es_limit_val));
 
             constexpr auto es_attrib_val{0x93_u64};
             constexpr auto es_attrib_idx{mk::bf_reg_t_es_attrib};
-            bsl::expects(mut_sys.bf_vs_op_write(vsid, es_attrib_idx, es_attrib_val));
+            bsl::expects(this->reg_write(
+                mut_sys, mv::mv_reg_t_es_attrib, es_attrib_idx, es_attrib_val));
 
             // -----------------------------------------------------------------
             // CS
@@ -176,19 +251,22 @@ namespace microv
 
             constexpr auto cs_selector_val{0xF000_u64};
             constexpr auto cs_selector_idx{mk::bf_reg_t_cs_selector};
-            bsl::expects(mut_sys.bf_vs_op_write(vsid, cs_selector_idx, cs_selector_val));
+            bsl::expects(this->reg_write(
+                mut_sys, mv::mv_reg_t_cs_selector, cs_selector_idx, cs_selector_val));
 
             constexpr auto cs_base_val{0xFFFF0000_u64};
             constexpr auto cs_base_idx{mk::bf_reg_t_cs_base};
-            bsl::expects(mut_sys.bf_vs_op_write(vsid, cs_base_idx, cs_base_val));
+            bsl::expects(this->reg_write(mut_sys, mv::mv_reg_t_cs_base, cs_base_idx, cs_base_val));
 
             constexpr auto cs_limit_val{0xFFFF_u64};
             constexpr auto cs_limit_idx{mk::bf_reg_t_cs_limit};
-            bsl::expects(mut_sys.bf_vs_op_write(vsid, cs_limit_idx, cs_limit_val));
+            bsl::expects(this->reg_write(
+                mut_sys, mv::mv_reg_t_cs_limit, cs_limit_idx, cs_limit_val));
 
             constexpr auto cs_attrib_val{0x9B_u64};
             constexpr auto cs_attrib_idx{mk::bf_reg_t_cs_attrib};
-            bsl::expects(mut_sys.bf_vs_op_write(vsid, cs_attrib_idx, cs_attrib_val));
+            bsl::expects(this->reg_write(
+                mut_sys, mv::mv_reg_t_cs_attrib, cs_attrib_idx, cs_attrib_val));
 
             // -----------------------------------------------------------------
             // SS
@@ -196,19 +274,22 @@ namespace microv
 
             constexpr auto ss_selector_val{0x0_u64};
             constexpr auto ss_selector_idx{mk::bf_reg_t_ss_selector};
-            bsl::expects(mut_sys.bf_vs_op_write(vsid, ss_selector_idx, ss_selector_val));
+            bsl::expects(this->reg_write(
+                mut_sys, mv::mv_reg_t_ss_selector, ss_selector_idx, ss_selector_val));
 
             constexpr auto ss_base_val{0x0_u64};
             constexpr auto ss_base_idx{mk::bf_reg_t_ss_base};
-            bsl::expects(mut_sys.bf_vs_op_write(vsid, ss_base_idx, ss_base_val));
+            bsl::expects(this->reg_write(mut_sys, mv::mv_reg_t_ss_base, ss_base_idx, ss_base_val));
 
             constexpr auto ss_limit_val{0xFFFF_u64};
             constexpr auto ss_limit_idx{mk::bf_reg_t_ss_limit};
-            bsl::expects(mut_sys.bf_vs_op_write(vsid, ss_limit_idx, ss_limit_val));
+            bsl::expects(this->reg_write(
+                mut_sys, mv::mv_reg_t_ss_limit, ss_limit_idx, ss_limit_val));
 
             constexpr auto ss_attrib_val{0x93_u64};
             constexpr auto ss_attrib_idx{mk::bf_reg_t_ss_attrib};
-            bsl::expects(mut_sys.bf_vs_op_write(vsid, ss_attrib_idx, ss_attrib_val));
+            bsl::expects(this->reg_write(
+                mut_sys, mv::mv_reg_t_ss_attrib, ss_attrib_idx, ss_attrib_val));
 
             // -----------------------------------------------------------------
             // DS
@@ -216,19 +297,22 @@ namespace microv
 
             constexpr auto ds_selector_val{0x0_u64};
             constexpr auto ds_selector_idx{mk::bf_reg_t_ds_selector};
-            bsl::expects(mut_sys.bf_vs_op_write(vsid, ds_selector_idx, ds_selector_val));
+            bsl::expects(this->reg_write(
+                mut_sys, mv::mv_reg_t_ds_selector, ds_selector_idx, ds_selector_val));
 
             constexpr auto ds_base_val{0x0_u64};
             constexpr auto ds_base_idx{mk::bf_reg_t_ds_base};
-            bsl::expects(mut_sys.bf_vs_op_write(vsid, ds_base_idx, ds_base_val));
+            bsl::expects(this->reg_write(mut_sys, mv::mv_reg_t_ds_base, ds_base_idx, ds_base_val));
 
             constexpr auto ds_limit_val{0xFFFF_u64};
             constexpr auto ds_limit_idx{mk::bf_reg_t_ds_limit};
-            bsl::expects(mut_sys.bf_vs_op_write(vsid, ds_limit_idx, ds_limit_val));
+            bsl::expects(this->reg_write(
+                mut_sys, mv::mv_reg_t_ds_limit, ds_limit_idx, ds_limit_val));
 
             constexpr auto ds_attrib_val{0x93_u64};
             constexpr auto ds_attrib_idx{mk::bf_reg_t_ds_attrib};
-            bsl::expects(mut_sys.bf_vs_op_write(vsid, ds_attrib_idx, ds_attrib_val));
+            bsl::expects(this->reg_write(
+                mut_sys, mv::mv_reg_t_ds_attrib, ds_attrib_idx, ds_attrib_val));
 
             // -----------------------------------------------------------------
             // FS
@@ -236,19 +320,22 @@ namespace microv
 
             constexpr auto fs_selector_val{0x0_u64};
             constexpr auto fs_selector_idx{mk::bf_reg_t_fs_selector};
-            bsl::expects(mut_sys.bf_vs_op_write(vsid, fs_selector_idx, fs_selector_val));
+            bsl::expects(this->reg_write(
+                mut_sys, mv::mv_reg_t_fs_selector, fs_selector_idx, fs_selector_val));
 
             constexpr auto fs_base_val{0x0_u64};
             constexpr auto fs_base_idx{mk::bf_reg_t_fs_base};
-            bsl::expects(mut_sys.bf_vs_op_write(vsid, fs_base_idx, fs_base_val));
+            bsl::expects(this->reg_write(mut_sys, mv::mv_reg_t_fs_base, fs_base_idx, fs_base_val));
 
             constexpr auto fs_limit_val{0xFFFF_u64};
             constexpr auto fs_limit_idx{mk::bf_reg_t_fs_limit};
-            bsl::expects(mut_sys.bf_vs_op_write(vsid, fs_limit_idx, fs_limit_val));
+            bsl::expects(this->reg_write(
+                mut_sys, mv::mv_reg_t_fs_limit, fs_limit_idx, fs_limit_val));
 
             constexpr auto fs_attrib_val{0x93_u64};
             constexpr auto fs_attrib_idx{mk::bf_reg_t_fs_attrib};
-            bsl::expects(mut_sys.bf_vs_op_write(vsid, fs_attrib_idx, fs_attrib_val));
+            bsl::expects(this->reg_write(
+                mut_sys, mv::mv_reg_t_fs_attrib, fs_attrib_idx, fs_attrib_val));
 
             // -----------------------------------------------------------------
             // GS
@@ -256,19 +343,22 @@ namespace microv
 
             constexpr auto gs_selector_val{0x0_u64};
             constexpr auto gs_selector_idx{mk::bf_reg_t_gs_selector};
-            bsl::expects(mut_sys.bf_vs_op_write(vsid, gs_selector_idx, gs_selector_val));
+            bsl::expects(this->reg_write(
+                mut_sys, mv::mv_reg_t_gs_selector, gs_selector_idx, gs_selector_val));
 
             constexpr auto gs_base_val{0x0_u64};
             constexpr auto gs_base_idx{mk::bf_reg_t_gs_base};
-            bsl::expects(mut_sys.bf_vs_op_write(vsid, gs_base_idx, gs_base_val));
+            bsl::expects(this->reg_write(mut_sys, mv::mv_reg_t_gs_base, gs_base_idx, gs_base_val));
 
             constexpr auto gs_limit_val{0xFFFF_u64};
             constexpr auto gs_limit_idx{mk::bf_reg_t_gs_limit};
-            bsl::expects(mut_sys.bf_vs_op_write(vsid, gs_limit_idx, gs_limit_val));
+            bsl::expects(this->reg_write(
+                mut_sys, mv::mv_reg_t_gs_limit, gs_limit_idx, gs_limit_val));
 
             constexpr auto gs_attrib_val{0x93_u64};
             constexpr auto gs_attrib_idx{mk::bf_reg_t_gs_attrib};
-            bsl::expects(mut_sys.bf_vs_op_write(vsid, gs_attrib_idx, gs_attrib_val));
+            bsl::expects(this->reg_write(
+                mut_sys, mv::mv_reg_t_gs_attrib, gs_attrib_idx, gs_attrib_val));
 
             // -----------------------------------------------------------------
             // LDTR
@@ -276,19 +366,23 @@ namespace microv
 
             constexpr auto ldtr_selector_val{0x0_u64};
             constexpr auto ldtr_selector_idx{mk::bf_reg_t_ldtr_selector};
-            bsl::expects(mut_sys.bf_vs_op_write(vsid, ldtr_selector_idx, ldtr_selector_val));
+            bsl::expects(this->reg_write(
+                mut_sys, mv::mv_reg_t_ldtr_selector, ldtr_selector_idx, ldtr_selector_val));
 
             constexpr auto ldtr_base_val{0x0_u64};
             constexpr auto ldtr_base_idx{mk::bf_reg_t_ldtr_base};
-            bsl::expects(mut_sys.bf_vs_op_write(vsid, ldtr_base_idx, ldtr_base_val));
+            bsl::expects(this->reg_write(
+                mut_sys, mv::mv_reg_t_ldtr_base, ldtr_base_idx, ldtr_base_val));
 
             constexpr auto ldtr_limit_val{0xFFFF_u64};
             constexpr auto ldtr_limit_idx{mk::bf_reg_t_ldtr_limit};
-            bsl::expects(mut_sys.bf_vs_op_write(vsid, ldtr_limit_idx, ldtr_limit_val));
+            bsl::expects(this->reg_write(
+                mut_sys, mv::mv_reg_t_ldtr_limit, ldtr_limit_idx, ldtr_limit_val));
 
             constexpr auto ldtr_attrib_val{0x82_u64};
             constexpr auto ldtr_attrib_idx{mk::bf_reg_t_ldtr_attrib};
-            bsl::expects(mut_sys.bf_vs_op_write(vsid, ldtr_attrib_idx, ldtr_attrib_val));
+            bsl::expects(this->reg_write(
+                mut_sys, mv::mv_reg_t_ldtr_attrib, ldtr_attrib_idx, ldtr_attrib_val));
 
             // -----------------------------------------------------------------
             // TR
@@ -296,19 +390,22 @@ namespace microv
 
             constexpr auto tr_selector_val{0x0_u64};
             constexpr auto tr_selector_idx{mk::bf_reg_t_tr_selector};
-            bsl::expects(mut_sys.bf_vs_op_write(vsid, tr_selector_idx, tr_selector_val));
+            bsl::expects(this->reg_write(
+                mut_sys, mv::mv_reg_t_tr_selector, tr_selector_idx, tr_selector_val));
 
             constexpr auto tr_base_val{0x0_u64};
             constexpr auto tr_base_idx{mk::bf_reg_t_tr_base};
-            bsl::expects(mut_sys.bf_vs_op_write(vsid, tr_base_idx, tr_base_val));
+            bsl::expects(this->reg_write(mut_sys, mv::mv_reg_t_tr_base, tr_base_idx, tr_base_val));
 
             constexpr auto tr_limit_val{0xFFFF_u64};
             constexpr auto tr_limit_idx{mk::bf_reg_t_tr_limit};
-            bsl::expects(mut_sys.bf_vs_op_write(vsid, tr_limit_idx, tr_limit_val));
+            bsl::expects(this->reg_write(
+                mut_sys, mv::mv_reg_t_tr_limit, tr_limit_idx, tr_limit_val));
 
             constexpr auto tr_attrib_val{0x8B_u64};
             constexpr auto tr_attrib_idx{mk::bf_reg_t_tr_attrib};
-            bsl::expects(mut_sys.bf_vs_op_write(vsid, tr_attrib_idx, tr_attrib_val));
+            bsl::expects(this->reg_write(
+                mut_sys, mv::mv_reg_t_tr_attrib, tr_attrib_idx, tr_attrib_val));
 
             // -----------------------------------------------------------------
             // GDTR
@@ -316,11 +413,13 @@ namespace microv
 
             constexpr auto gdtr_base_val{0x0_u64};
             constexpr auto gdtr_base_idx{mk::bf_reg_t_gdtr_base};
-            bsl::expects(mut_sys.bf_vs_op_write(vsid, gdtr_base_idx, gdtr_base_val));
+            bsl::expects(this->reg_write(
+                mut_sys, mv::mv_reg_t_gdtr_base, gdtr_base_idx, gdtr_base_val));
 
             constexpr auto gdtr_limit_val{0xFFFF_u64};
             constexpr auto gdtr_limit_idx{mk::bf_reg_t_gdtr_limit};
-            bsl::expects(mut_sys.bf_vs_op_write(vsid, gdtr_limit_idx, gdtr_limit_val));
+            bsl::expects(this->reg_write(
+                mut_sys, mv::mv_reg_t_gdtr_limit, gdtr_limit_idx, gdtr_limit_val));
 
             // -----------------------------------------------------------------
             // IDTR
@@ -330,13 +429,15 @@ namespace microv
             constexpr auto idtr_base_val{0x0_u64};
             // NOLINTNEXTLINE(bsl-identifier-typographically-unambiguous)
             constexpr auto idtr_base_idx{mk::bf_reg_t_idtr_base};
-            bsl::expects(mut_sys.bf_vs_op_write(vsid, idtr_base_idx, idtr_base_val));
+            bsl::expects(this->reg_write(
+                mut_sys, mv::mv_reg_t_idtr_base, idtr_base_idx, idtr_base_val));
 
             // NOLINTNEXTLINE(bsl-identifier-typographically-unambiguous)
             constexpr auto idtr_limit_val{0xFFFF_u64};
             // NOLINTNEXTLINE(bsl-identifier-typographically-unambiguous)
             constexpr auto idtr_limit_idx{mk::bf_reg_t_idtr_limit};
-            bsl::expects(mut_sys.bf_vs_op_write(vsid, idtr_limit_idx, idtr_limit_val));
+            bsl::expects(this->reg_write(
+                mut_sys, mv::mv_reg_t_idtr_limit, idtr_limit_idx, idtr_limit_val));
 
             // -----------------------------------------------------------------
             // Control Registers
@@ -344,12 +445,12 @@ namespace microv
 
             constexpr auto cr0_val{0x60000010_u64};
 
-            bsl::expects(mut_sys.bf_vs_op_write(vsid, mk::bf_reg_t_cr0, cr0_val));
-            bsl::expects(mut_sys.bf_vs_op_write(vsid, mk::bf_reg_t_cr2, {}));
-            bsl::expects(mut_sys.bf_vs_op_write(vsid, mk::bf_reg_t_cr3, {}));
-            bsl::expects(mut_sys.bf_vs_op_write(vsid, mk::bf_reg_t_cr4, {}));
-            bsl::expects(mut_sys.bf_vs_op_write(vsid, mk::bf_reg_t_cr8, {}));
-            bsl::expects(mut_sys.bf_vs_op_write(vsid, mk::bf_reg_t_xcr0, {}));
+            bsl::expects(this->reg_write(mut_sys, mv::mv_reg_t_cr0, mk::bf_reg_t_cr0, cr0_val));
+            bsl::expects(this->reg_write(mut_sys, mv::mv_reg_t_cr2, mk::bf_reg_t_cr2, {}));
+            bsl::expects(this->reg_write(mut_sys, mv::mv_reg_t_cr3, mk::bf_reg_t_cr3, {}));
+            bsl::expects(this->reg_write(mut_sys, mv::mv_reg_t_cr4, mk::bf_reg_t_cr4, {}));
+            bsl::expects(this->reg_write(mut_sys, mv::mv_reg_t_cr8, mk::bf_reg_t_cr8, {}));
+            bsl::expects(this->reg_write(mut_sys, mv::mv_reg_t_xcr0, mk::bf_reg_t_xcr0, {}));
 
             // -----------------------------------------------------------------
             // Debug Registers
@@ -357,25 +458,237 @@ namespace microv
 
             constexpr auto dr7_val{0x00000400_u64};
 
-            bsl::expects(mut_sys.bf_vs_op_write(vsid, mk::bf_reg_t_dr0, {}));
-            bsl::expects(mut_sys.bf_vs_op_write(vsid, mk::bf_reg_t_dr1, {}));
-            bsl::expects(mut_sys.bf_vs_op_write(vsid, mk::bf_reg_t_dr2, {}));
-            bsl::expects(mut_sys.bf_vs_op_write(vsid, mk::bf_reg_t_dr3, {}));
-            bsl::expects(mut_sys.bf_vs_op_write(vsid, mk::bf_reg_t_dr6, {}));
-            bsl::expects(mut_sys.bf_vs_op_write(vsid, mk::bf_reg_t_dr7, dr7_val));
+            bsl::expects(this->reg_write(mut_sys, mv::mv_reg_t_dr0, mk::bf_reg_t_dr0, {}));
+            bsl::expects(this->reg_write(mut_sys, mv::mv_reg_t_dr1, mk::bf_reg_t_dr1, {}));
+            bsl::expects(this->reg_write(mut_sys, mv::mv_reg_t_dr2, mk::bf_reg_t_dr2, {}));
+            bsl::expects(this->reg_write(mut_sys, mv::mv_reg_t_dr3, mk::bf_reg_t_dr3, {}));
+            bsl::expects(this->reg_write(mut_sys, mv::mv_reg_t_dr6, mk::bf_reg_t_dr6, {}));
+            bsl::expects(this->reg_write(mut_sys, mv::mv_reg_t_dr7, mk::bf_reg_t_dr7, dr7_val));
 
             // -----------------------------------------------------------------
             // MSRs
             // -----------------------------------------------------------------
 
             bsl::expects(mut_sys.bf_vs_op_write(vsid, mk::bf_reg_t_efer, {}));
-            bsl::expects(mut_sys.bf_vs_op_write(vsid, mk::bf_reg_t_fs_base, {}));
-            bsl::expects(mut_sys.bf_vs_op_write(vsid, mk::bf_reg_t_gs_base, {}));
+            bsl::expects(this->reg_write(mut_sys, mv::mv_reg_t_fs_base, mk::bf_reg_t_fs_base, {}));
+            bsl::expects(this->reg_write(mut_sys, mv::mv_reg_t_gs_base, mk::bf_reg_t_gs_base, {}));
 
             constexpr auto apic_base{0xFEE00900_u64};
             m_emulated_lapic.set_apic_base(apic_base);
         }
 
+        /// <!-- description -->
+        ///   @brief Returns true if register writes to this vs_t should
+        ///     be deferred in the register cache. The cache is only used
+        ///     for guest VSs that are not active. Once a VS is active, its
+        ///     state is owned by the microkernel and must be accessed
+        ///     directly.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param sys the bf_syscall_t to use
+        ///   @return Returns true if the register cache should be used
+        ///
+        [[nodiscard]] constexpr auto
+        uses_reg_cache(syscall::bf_syscall_t const &sys) const noexcept -> bool
+        {
+            if (sys.is_vs_a_root_vs(this->id())) {
+                return false;
+            }
+
+            return this->is_active().is_invalid();
+        }
+
+        /// <!-- description -->
+        ///   @brief Returns the value of the register held by the provided
+        ///     slot of the register cache. If the register has a pending
+        ///     write, the pending value is returned. Otherwise the register
+        ///     is read from the microkernel. Reads are not cached: the cache
+        ///     is emptied every time this vs_t runs, so userspace reads
+        ///     (e.g. KVM_GET_REGS) would only ever miss.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param sys the bf_syscall_t to use
+        ///   @param slot the slot of the register cache to read
+        ///   @param bf_reg the bf_reg_t of the register to read
+        ///   @return Returns the value of the requested register
+        ///
+        [[nodiscard]] constexpr auto
+        cache_read(
+            syscall::bf_syscall_t const &sys,
+            bsl::safe_idx const &slot,
+            syscall::bf_reg_t const bf_reg) noexcept -> bsl::safe_u64
+        {
+            if (this->uses_reg_cache(sys)) {
+                if (*m_reg_dirty.at_if(slot)) {
+                    return *m_reg_vals.at_if(slot);
+                }
+
+                bsl::touch();
+            }
+            else {
+                bsl::touch();
+            }
+
+            return sys.bf_vs_op_read(this->id(), bf_reg);
+        }
+
+        /// <!-- description -->
+        ///   @brief Sets the value of the register held by the provided
+        ///     slot of the register cache. If the register cache is in use,
+        ///     the write is deferred until reg_flush is called, which
+        ///     coalesces repeated writes to the same register into a single
+        ///     microkernel write.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param mut_sys the bf_syscall_t to use
+        ///   @param slot the slot of the register cache to write
+        ///   @param bf_reg the bf_reg_t of the register to write
+        ///   @param val the value to set the register to
+        ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+        ///     and friends otherwise
+        ///
+        [[nodiscard]] constexpr auto
+        cache_write(
+            syscall::bf_syscall_t &mut_sys,
+            bsl::safe_idx const &slot,
+            syscall::bf_reg_t const bf_reg,
+            bsl::safe_u64 const &val) noexcept -> bsl::errc_type
+        {
+            if (!this->uses_reg_cache(mut_sys)) {
+                return mut_sys.bf_vs_op_write(this->id(), bf_reg, val);
+            }
+
+            *m_reg_vals.at_if(slot) = val;
+            *m_reg_idxs.at_if(slot) = bf_reg;
+            *m_reg_dirty.at_if(slot) = true;
+            m_reg_any_dirty = true;
+
+            return bsl::errc_success;
+        }
+
+        /// <!-- description -->
+        ///   @brief Returns the value of the requested register (see
+        ///     cache_read).
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param sys the bf_syscall_t to use
+        ///   @param reg the mv_reg_t of the register to read
+        ///   @param bf_reg the bf_reg_t of the register to read
+        ///   @return Returns the value of the requested register
+        ///
+        [[nodiscard]] constexpr auto
+        reg_read(
+            syscall::bf_syscall_t const &sys,
+            hypercall::mv_reg_t const reg,
+            syscall::bf_reg_t const bf_reg) noexcept -> bsl::safe_u64
+        {
+            return this->cache_read(sys, bsl::safe_idx{static_cast<bsl::uintmx>(reg)}, bf_reg);
+        }
+
+        /// <!-- description -->
+        ///   @brief Sets the value of the requested register (see
+        ///     cache_write).
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param mut_sys the bf_syscall_t to use
+        ///   @param reg the mv_reg_t of the register to write
+        ///   @param bf_reg the bf_reg_t of the register to write
+        ///   @param val the value to set the register to
+        ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+        ///     and friends otherwise
+        ///
+        [[nodiscard]] constexpr auto
+        reg_write(
+            syscall::bf_syscall_t &mut_sys,
+            hypercall::mv_reg_t const reg,
+            syscall::bf_reg_t const bf_reg,
+            bsl::safe_u64 const &val) noexcept -> bsl::errc_type
+        {
+            if (hypercall::mv_reg_t::mv_reg_t_xcr0 == reg) {
+                m_xsave_mask = (val | XSAVE_LEGACY);
+            }
+            else {
+                bsl::touch();
+            }
+
+            return this->cache_write(
+                mut_sys, bsl::safe_idx{static_cast<bsl::uintmx>(reg)}, bf_reg, val);
+        }
+
+        /// <!-- description -->
+        ///   @brief Returns the slot of the register cache that holds the
+        ///     provided MSR and stores the microkernel register that holds
+        ///     the MSR in mut_bf_reg. If the MSR is not context switched by
+        ///     the microkernel, bsl::safe_idx::failure() is returned.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param msr the MSR to look up
+        ///   @param mut_bf_reg returns the bf_reg_t of the MSR
+        ///   @return Returns the slot of the register cache that holds the
+        ///     provided MSR, or bsl::safe_idx::failure() on failure.
+        ///
+        [[nodiscard]] static constexpr auto
+        msr_to_slot(bsl::safe_u32 const &msr, syscall::bf_reg_t &mut_bf_reg) noexcept
+            -> bsl::safe_idx
+        {
+            using mv = hypercall::mv_reg_t;
+
+            /// NOTE:
+            /// - FS and GS base are also mv_reg_t registers, so they share
+            ///   the mv_reg_t slot to keep both views of them coherent.
+            ///
+
+            if (MSR_FS_BASE == msr) {
+                mut_bf_reg = syscall::bf_reg_t::bf_reg_t_fs_base;
+                return bsl::safe_idx{static_cast<bsl::uintmx>(mv::mv_reg_t_fs_base)};
+            }
+
+            if (MSR_GS_BASE == msr) {
+                mut_bf_reg = syscall::bf_reg_t::bf_reg_t_gs_base;
+                return bsl::safe_idx{static_cast<bsl::uintmx>(mv::mv_reg_t_gs_base)};
+            }
+
+            for (bsl::safe_idx mut_i{}; mut_i < VS_MSR_CACHE_MSRS.size(); ++mut_i) {
+                if (*VS_MSR_CACHE_MSRS.at_if(mut_i) == msr) {
+                    mut_bf_reg = *VS_MSR_CACHE_REGS.at_if(mut_i);
+                    auto const slot{(VS_MSR_CACHE_BASE + bsl::safe_umx{mut_i.get()}).checked()};
+                    return bsl::safe_idx{slot.get()};
+                }
+
+                bsl::touch();
+            }
+
+            return bsl::safe_idx::failure();
+        }
+
+        /// <!-- description -->
+        ///   @brief Returns the TSC the VS sees when the PP reads the
+        ///     provided TSC value, which is the TSC of the PP plus the TSC
+        ///     offset of this vs_t.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param sys the bf_syscall_t to use
+        ///   @param host_tsc the TSC of the PP
+        ///   @return Returns the TSC the VS sees when the PP reads the
+        ///     provided TSC value.
+        ///
+        [[nodiscard]] constexpr auto
+        guest_tsc(syscall::bf_syscall_t const &sys, bsl::safe_u64 const &host_tsc) const noexcept
+            -> bsl::safe_u64
+        {
+            constexpr auto offset_idx{syscall::bf_reg_t::bf_reg_t_tsc_offset};
+
+            auto const offset{sys.bf_vs_op_read(this->id(), offset_idx)};
+            bsl::expects(offset.is_valid());
+
+            /// NOTE:
+            /// - The TSC offset is two's complement, so this addition is
+            ///   expected to wrap, just like it does in hardware.
+            ///
+
+            return bsl::safe_u64{host_tsc.get() + offset.get()};
+        }
+
     public:
         /// <!-- description -->
         ///   @brief Initializes this vs_t
@@ -400,6 +713,7 @@ namespace microv
             bsl::expects(i.is_valid_and_checked());
             bsl::expects(i != syscall::BF_INVALID_ID);
 
+            m_emulated_clock.initialize(gs, tls, sys, intrinsic, i);
             m_emulated_cpuid.initialize(gs, tls, sys, intrinsic, i);
             m_emulated_cr.initialize(gs, tls, sys, intrinsic, i);
             m_emulated_decoder.initialize(gs, tls, sys, intrinsic, i);
@@ -407,6 +721,7 @@ namespace microv
             m_emulated_io.initialize(gs, tls, sys, intrinsic, i);
             m_emulated_lapic.initialize(gs, tls, sys, intrinsic, i);
             m_emulated_msr.initialize(gs, tls, sys, intrinsic, i);
+            m_emulated_steal_time.initialize(gs, tls, sys, intrinsic, i);
             m_emulated_tlb.initialize(gs, tls, sys, intrinsic, i);
 
             m_id = ~i;
@@ -433,6 +748,7 @@ namespace microv
             this->deallocate(gs, tls, sys, mut_page_pool, intrinsic);
 
             m_emulated_tlb.release(gs, tls, sys, intrinsic);
+            m_emulated_steal_time.release(gs, tls, sys, intrinsic);
             m_emulated_msr.release(gs, tls, sys, intrinsic);
             m_emulated_lapic.release(gs, tls, sys, intrinsic);
             m_emulated_io.release(gs, tls, sys, intrinsic);
@@ -440,6 +756,7 @@ namespace microv
             m_emulated_decoder.release(gs, tls, sys, intrinsic);
             m_emulated_cr.release(gs, tls, sys, intrinsic);
             m_emulated_cpuid.release(gs, tls, sys, intrinsic);
+            m_emulated_clock.release(gs, tls, sys, intrinsic);
 
             m_id = {};
         }
@@ -471,6 +788,10 @@ namespace microv
         ///   @param ppid the ID of the PP to assign the vs_t to
         ///   @param slpt_spa the system physical address of the second level
         ///     page tables to use.
+        ///   @param iopm_spa the system physical address of the IO
+        ///     permissions map to use.
+        ///   @param msrpm_spa the system physical address of the MSR
+        ///     permissions map to use.
         ///   @return Returns ID of this vs_t
         ///
         [[maybe_unused]] constexpr auto
@@ -483,7 +804,9 @@ namespace microv
             bsl::safe_u16 const &vmid,
             bsl::safe_u16 const &vpid,
             bsl::safe_u16 const &ppid,
-            bsl::safe_u64 const &slpt_spa) noexcept -> bsl::safe_u16
+            bsl::safe_u64 const &slpt_spa,
+            bsl::safe_u64 const &iopm_spa,
+            bsl::safe_u64 const &msrpm_spa) noexcept -> bsl::safe_u16
         {
             auto const vsid{this->id()};
 
@@ -502,7 +825,7 @@ namespace microv
             bsl::discard(tls);
             bsl::discard(intrinsic);
 
-            m_xsave = mut_page_pool.allocate<page_4k_t>(tls, mut_sys);
+            m_xsave = mut_page_pool.allocate<xsave_t>(tls, mut_sys);
             if (bsl::unlikely(nullptr == m_xsave)) {
                 bsl::print<bsl::V>() << bsl::here();
                 return bsl::safe_u16::failure();
@@ -527,7 +850,7 @@ namespace microv
                 constexpr auto msrpm_base_pa_idx{syscall::bf_reg_t::bf_reg_t_msrpm_base_pa};
                 bsl::expects(mut_sys.bf_vs_op_write(vsid, msrpm_base_pa_idx, gs.root_msrpm_spa));
 
-                intrinsic.xsave(m_xsave);
+                intrinsic.xsave(m_xsave, XSAVE_ALL);
                 bsl::expects(mut_sys.bf_vs_op_init_as_root(vsid));
             }
             else {
@@ -547,11 +870,19 @@ namespace microv
                 constexpr auto intercept_drw_idx{syscall::bf_reg_t::bf_reg_t_intercept_dr_write};
                 bsl::expects(mut_sys.bf_vs_op_write(vsid, intercept_drw_idx, intercept_drw_val));
 
-                constexpr auto intercept1_val{0x9F24003B_u64};
+                constexpr auto intercept1_val{0x9FA4003B_u64};
                 constexpr auto intercept1_idx{syscall::bf_reg_t::bf_reg_t_intercept_instruction1};
                 bsl::expects(mut_sys.bf_vs_op_write(vsid, intercept1_idx, intercept1_val));
 
-                constexpr auto intercept2_val{0x0000007F_u64};
+                constexpr auto pause_cnt_val{MICROV_PAUSE_FILTER_COUNT};
+                constexpr auto pause_cnt_idx{syscall::bf_reg_t::bf_reg_t_pause_filter_count};
+                bsl::expects(mut_sys.bf_vs_op_write(vsid, pause_cnt_idx, pause_cnt_val));
+
+                constexpr auto pause_thr_val{MICROV_PAUSE_FILTER_THRESHOLD};
+                constexpr auto pause_thr_idx{syscall::bf_reg_t::bf_reg_t_pause_filter_threshold};
+                bsl::expects(mut_sys.bf_vs_op_write(vsid, pause_thr_idx, pause_thr_val));
+
+                constexpr auto intercept2_val{0x0000207F_u64};
                 constexpr auto intercept2_idx{syscall::bf_reg_t::bf_reg_t_intercept_instruction2};
                 bsl::expects(mut_sys.bf_vs_op_write(vsid, intercept2_idx, intercept2_val));
 
@@ -567,10 +898,10 @@ namespace microv
                 bsl::expects(mut_sys.bf_vs_op_write(vsid, n_cr3_idx, slpt_spa));
 
                 constexpr auto iopm_base_pa_idx{syscall::bf_reg_t::bf_reg_t_iopm_base_pa};
-                bsl::expects(mut_sys.bf_vs_op_write(vsid, iopm_base_pa_idx, gs.guest_iopm_spa));
+                bsl::expects(mut_sys.bf_vs_op_write(vsid, iopm_base_pa_idx, iopm_spa));
 
                 constexpr auto msrpm_base_pa_idx{syscall::bf_reg_t::bf_reg_t_msrpm_base_pa};
-                bsl::expects(mut_sys.bf_vs_op_write(vsid, msrpm_base_pa_idx, gs.guest_msrpm_spa));
+                bsl::expects(mut_sys.bf_vs_op_write(vsid, msrpm_base_pa_idx, msrpm_spa));
 
                 this->init_as_16bit_guest(mut_sys);
             }
@@ -620,7 +951,20 @@ namespace microv
             bsl::discard(intrinsic);
 
             mut_page_pool.deallocate(tls, m_xsave);
-
+            m_emulated_cpuid.deallocate(tls, mut_page_pool);
+
+            m_dirty_ring = {};
+            m_xsave_mask = {};
+            m_emulated_clock.reset();
+            m_emulated_msr.reset();
+            m_emulated_steal_time.reset();
+            m_msr_exit = {};
+            m_msr_exit_rip = {};
+            m_tsc_khz = {};
+            m_reg_vals = {};
+            m_reg_idxs = {};
+            m_reg_dirty = {};
+            m_reg_any_dirty = {};
             m_assigned_ppid = {};
             m_assigned_vpid = {};
             m_assigned_vmid = {};
@@ -664,7 +1008,9 @@ namespace microv
         }
 
         /// <!-- description -->
-        ///   @brief Sets this vs_t as active.
+        ///   @brief Sets this vs_t as active. Only the state components
+        ///     selected by mut_tls.xsave_mask are restored. The rest are
+        ///     left untouched in the PP's registers (see run_guest).
         ///
         /// <!-- inputs/outputs -->
         ///   @param mut_tls the current TLS block
@@ -677,14 +1023,18 @@ namespace microv
             bsl::expects(running_status_t::running != m_status);
             bsl::expects(syscall::BF_INVALID_ID == mut_tls.active_vsid);
 
-            intrinsic.xrstr(m_xsave);
+            intrinsic.xrstr(m_xsave, mut_tls.xsave_mask);
 
             m_active_ppid = ~bsl::to_u16(mut_tls.ppid);
             mut_tls.active_vsid = this->id();
         }
 
         /// <!-- description -->
-        ///   @brief Sets this vs_t as inactive.
+        ///   @brief Sets this vs_t as inactive. Only the state components
+        ///     selected by mut_tls.xsave_mask are saved, and if supported,
+        ///     XSAVEOPT is used so that components that are in their init
+        ///     state or were not modified since they were restored are not
+        ///     written back at all.
         ///
         /// <!-- inputs/outputs -->
         ///   @param mut_tls the current TLS block
@@ -697,12 +1047,133 @@ namespace microv
             bsl::expects(running_status_t::running != m_status);
             bsl::expects(this->id() == mut_tls.active_vsid);
 
-            intrinsic.xsave(m_xsave);
+            if (mut_tls.xsaveopt_supported) {
+                intrinsic.xsaveopt(m_xsave, mut_tls.xsave_mask);
+            }
+            else {
+                intrinsic.xsave(m_xsave, mut_tls.xsave_mask);
+            }
 
             m_active_ppid = {};
             mut_tls.active_vsid = syscall::BF_INVALID_ID;
         }
 
+        /// <!-- description -->
+        ///   @brief Returns the state components this vs_t's guest can
+        ///     modify (i.e., its XCR0 plus the x87 and SSE components).
+        ///     State components outside of this mask cannot be touched by
+        ///     the guest, so they do not need to be switched when the
+        ///     guest is run. The mask follows both the XCR0 set by the
+        ///     root VM (see reg_write) and the guest's XSETBV (see xcr0_set).
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @return Returns the state components this vs_t's guest can
+        ///     modify.
+        ///
+        [[nodiscard]] constexpr auto
+        xsave_mask() const noexcept -> bsl::safe_u64
+        {
+            bsl::ensures(m_xsave_mask.is_valid_and_checked());
+            return m_xsave_mask;
+        }
+
+        /// <!-- description -->
+        ///   @brief Emulates the guest's XSETBV of XCR0. The new value is
+        ///     validated the same way the CPU validates it (see the SDM,
+        ///     XSETBV) against the components this PP supports, written to
+        ///     the VS, and this vs_t's xsave_mask is updated to match. This
+        ///     vs_t must be the active vs_t.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param tls the current TLS block
+        ///   @param mut_sys the bf_syscall_t to use
+        ///   @param val the value the guest is setting XCR0 to
+        ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+        ///     if the value would cause a #GP.
+        ///
+        [[nodiscard]] constexpr auto
+        xcr0_set(
+            tls_t const &tls,
+            syscall::bf_syscall_t &mut_sys,
+            bsl::safe_u64 const &val) noexcept -> bsl::errc_type
+        {
+            bsl::expects(allocated_status_t::allocated == m_allocated);
+            bsl::expects(this->id() == tls.active_vsid);
+            bsl::expects(val.is_valid_and_checked());
+
+            bool mut_valid{true};
+
+            if ((val & ~tls.xcr0_supported).is_pos()) {
+                mut_valid = false;
+            }
+            else if ((val & XSAVE_X87).is_zero()) {
+                mut_valid = false;
+            }
+            else if ((val & XSAVE_AVX).is_pos() && (val & XSAVE_SSE).is_zero()) {
+                mut_valid = false;
+            }
+            else if (((val & XSAVE_MPX) != XSAVE_MPX) && (val & XSAVE_MPX).is_pos()) {
+                mut_valid = false;
+            }
+            else if ((val & XSAVE_AVX512).is_pos()) {
+                mut_valid = ((val & XSAVE_AVX512) == XSAVE_AVX512) && (val & XSAVE_AVX).is_pos();
+            }
+            else {
+                bsl::touch();
+            }
+
+            if (bsl::unlikely(!mut_valid)) {
+                bsl::error() << "invalid xcr0 "    // --
+                             << bsl::hex(val)      // --
+                             << bsl::endl          // --
+                             << bsl::here();       // --
+
+                return bsl::errc_failure;
+            }
+
+            constexpr auto xcr0_idx{syscall::bf_reg_t::bf_reg_t_xcr0};
+            auto const ret{mut_sys.bf_vs_op_write(this->id(), xcr0_idx, val)};
+            if (bsl::unlikely(!ret)) {
+                bsl::print<bsl::V>() << bsl::here();
+                return ret;
+            }
+
+            m_xsave_mask = (val | XSAVE_LEGACY);
+            return bsl::errc_success;
+        }
+
+        /// <!-- description -->
+        ///   @brief Saves the requested state components from the PP's
+        ///     registers to this vs_t, whether or not this vs_t is active.
+        ///     This is used when a guest enables state components that
+        ///     were not switched when it was run (see vs_pool_t::xcr0_set).
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param intrinsic the intrinsic_t to use
+        ///   @param mask the state components to save
+        ///
+        constexpr void
+        xsave_components(intrinsic_t const &intrinsic, bsl::safe_u64 const &mask) noexcept
+        {
+            bsl::expects(allocated_status_t::allocated == m_allocated);
+            intrinsic.xsave(m_xsave, mask);
+        }
+
+        /// <!-- description -->
+        ///   @brief Restores the requested state components of this vs_t
+        ///     into the PP's registers (see xsave_components).
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param intrinsic the intrinsic_t to use
+        ///   @param mask the state components to restore
+        ///
+        constexpr void
+        xrstr_components(intrinsic_t const &intrinsic, bsl::safe_u64 const &mask) noexcept
+        {
+            bsl::expects(allocated_status_t::allocated == m_allocated);
+            intrinsic.xrstr(m_xsave, mask);
+        }
+
         /// <!-- description -->
         ///   @brief Returns the ID of the PP this vs_t is active on. If the
         ///     vs_t is not active, bsl::safe_u16::failure() is returned.
@@ -848,15 +1319,16 @@ namespace microv
         ///
         [[nodiscard]] constexpr auto
         gla_to_gpa(syscall::bf_syscall_t &mut_sys, pp_pool_t &mut_pp_pool, bsl::safe_u64 const &gla)
-            const noexcept -> hypercall::mv_translation_t
+            noexcept -> hypercall::mv_translation_t
         {
-            auto const vsid{this->id()};
+            using mk = syscall::bf_reg_t;
+            using mv = hypercall::mv_reg_t;
 
             bsl::expects(allocated_status_t::allocated == m_allocated);
             bsl::expects(running_status_t::running != m_status);
             bsl::expects(mut_sys.bf_tls_ppid() == this->assigned_pp());
 
-            auto const cr0{mut_sys.bf_vs_op_read(vsid, syscall::bf_reg_t::bf_reg_t_cr0)};
+            auto const cr0{this->reg_read(mut_sys, mv::mv_reg_t_cr0, mk::bf_reg_t_cr0)};
             bsl::expects(cr0.is_valid_and_checked());
 
             if (bsl::unlikely(cr0.is_zero())) {
@@ -870,7 +1342,7 @@ namespace microv
                 return {};
             }
 
-            auto const cr3{mut_sys.bf_vs_op_read(vsid, syscall::bf_reg_t::bf_reg_t_cr3)};
+            auto const cr3{this->reg_read(mut_sys, mv::mv_reg_t_cr3, mk::bf_reg_t_cr3)};
             bsl::expects(cr3.is_valid_and_checked());
 
             if (bsl::unlikely(cr3.is_zero())) {
@@ -884,7 +1356,7 @@ namespace microv
                 return {};
             }
 
-            auto const cr4{mut_sys.bf_vs_op_read(vsid, syscall::bf_reg_t::bf_reg_t_cr4)};
+            auto const cr4{this->reg_read(mut_sys, mv::mv_reg_t_cr4, mk::bf_reg_t_cr4)};
             bsl::expects(cr4.is_valid_and_checked());
 
             if (bsl::unlikely(cr4.is_zero())) {
@@ -926,6 +1398,31 @@ namespace microv
             return m_emulated_cpuid.get(mut_sys, intrinsic);
         }
 
+        /// <!-- description -->
+        ///   @brief Sets the CPUID leaves of this vs_t given the
+        ///     provided CDL.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param tls the tls_t to use
+        ///   @param mut_sys the bf_syscall_t to use
+        ///   @param mut_page_pool the page_pool_t to use
+        ///   @param cdl the CDL to get the requested CPUID leaves from
+        ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+        ///     and friends otherwise
+        ///
+        [[nodiscard]] constexpr auto
+        cpuid_set_list(
+            tls_t const &tls,
+            syscall::bf_syscall_t &mut_sys,
+            page_pool_t &mut_page_pool,
+            hypercall::mv_cdl_t const &cdl) noexcept -> bsl::errc_type
+        {
+            bsl::expects(allocated_status_t::allocated == m_allocated);
+            bsl::expects(running_status_t::running != m_status);
+
+            return m_emulated_cpuid.set_list(tls, mut_sys, mut_page_pool, cdl);
+        }
+
         /// <!-- description -->
         ///   @brief Returns the value of the requested register
         ///
@@ -935,7 +1432,7 @@ namespace microv
         ///   @return Returns the value of the requested register
         ///
         [[nodiscard]] constexpr auto
-        reg_get(syscall::bf_syscall_t const &sys, bsl::safe_u64 const &reg) const noexcept
+        reg_get(syscall::bf_syscall_t const &sys, bsl::safe_u64 const &reg) noexcept
             -> bsl::safe_u64
         {
             bsl::expects(allocated_status_t::allocated == m_allocated);
@@ -947,209 +1444,211 @@ namespace microv
             using mk = syscall::bf_reg_t;
             using mv = hypercall::mv_reg_t;
 
-            switch (static_cast<hypercall::mv_reg_t>(reg.get())) {
+            auto const mvreg{static_cast<mv>(reg.get())};
+
+            switch (mvreg) {
                 case mv::mv_reg_t_unsupported: {
                     break;
                 }
 
                 case mv::mv_reg_t_rax: {
-                    return sys.bf_vs_op_read(this->id(), mk::bf_reg_t_rax);
+                    return this->reg_read(sys, mvreg, mk::bf_reg_t_rax);
                 }
 
                 case mv::mv_reg_t_rbx: {
-                    return sys.bf_vs_op_read(this->id(), mk::bf_reg_t_rbx);
+                    return this->reg_read(sys, mvreg, mk::bf_reg_t_rbx);
                 }
 
                 case mv::mv_reg_t_rcx: {
-                    return sys.bf_vs_op_read(this->id(), mk::bf_reg_t_rcx);
+                    return this->reg_read(sys, mvreg, mk::bf_reg_t_rcx);
                 }
 
                 case mv::mv_reg_t_rdx: {
-                    return sys.bf_vs_op_read(this->id(), mk::bf_reg_t_rdx);
+                    return this->reg_read(sys, mvreg, mk::bf_reg_t_rdx);
                 }
 
                 case mv::mv_reg_t_rbp: {
-                    return sys.bf_vs_op_read(this->id(), mk::bf_reg_t_rbp);
+                    return this->reg_read(sys, mvreg, mk::bf_reg_t_rbp);
                 }
 
                 case mv::mv_reg_t_rsi: {
-                    return sys.bf_vs_op_read(this->id(), mk::bf_reg_t_rsi);
+                    return this->reg_read(sys, mvreg, mk::bf_reg_t_rsi);
                 }
 
                 case mv::mv_reg_t_rdi: {
-                    return sys.bf_vs_op_read(this->id(), mk::bf_reg_t_rdi);
+                    return this->reg_read(sys, mvreg, mk::bf_reg_t_rdi);
                 }
 
                 case mv::mv_reg_t_r8: {
-                    return sys.bf_vs_op_read(this->id(), mk::bf_reg_t_r8);
+                    return this->reg_read(sys, mvreg, mk::bf_reg_t_r8);
                 }
 
                 case mv::mv_reg_t_r9: {
-                    return sys.bf_vs_op_read(this->id(), mk::bf_reg_t_r9);
+                    return this->reg_read(sys, mvreg, mk::bf_reg_t_r9);
                 }
 
                 case mv::mv_reg_t_r10: {
-                    return sys.bf_vs_op_read(this->id(), mk::bf_reg_t_r10);
+                    return this->reg_read(sys, mvreg, mk::bf_reg_t_r10);
                 }
 
                 case mv::mv_reg_t_r11: {
-                    return sys.bf_vs_op_read(this->id(), mk::bf_reg_t_r11);
+                    return this->reg_read(sys, mvreg, mk::bf_reg_t_r11);
                 }
 
                 case mv::mv_reg_t_r12: {
-                    return sys.bf_vs_op_read(this->id(), mk::bf_reg_t_r12);
+                    return this->reg_read(sys, mvreg, mk::bf_reg_t_r12);
                 }
 
                 case mv::mv_reg_t_r13: {
-                    return sys.bf_vs_op_read(this->id(), mk::bf_reg_t_r13);
+                    return this->reg_read(sys, mvreg, mk::bf_reg_t_r13);
                 }
 
                 case mv::mv_reg_t_r14: {
-                    return sys.bf_vs_op_read(this->id(), mk::bf_reg_t_r14);
+                    return this->reg_read(sys, mvreg, mk::bf_reg_t_r14);
                 }
 
                 case mv::mv_reg_t_r15: {
-                    return sys.bf_vs_op_read(this->id(), mk::bf_reg_t_r15);
+                    return this->reg_read(sys, mvreg, mk::bf_reg_t_r15);
                 }
 
                 case mv::mv_reg_t_rsp: {
-                    return sys.bf_vs_op_read(this->id(), mk::bf_reg_t_rsp);
+                    return this->reg_read(sys, mvreg, mk::bf_reg_t_rsp);
                 }
 
                 case mv::mv_reg_t_rip: {
-                    return sys.bf_vs_op_read(this->id(), mk::bf_reg_t_rip);
+                    return this->reg_read(sys, mvreg, mk::bf_reg_t_rip);
                 }
 
                 case mv::mv_reg_t_rflags: {
-                    return sys.bf_vs_op_read(this->id(), mk::bf_reg_t_rflags);
+                    return this->reg_read(sys, mvreg, mk::bf_reg_t_rflags);
                 }
 
                 case mv::mv_reg_t_es_selector: {
-                    return sys.bf_vs_op_read(this->id(), mk::bf_reg_t_es_selector);
+                    return this->reg_read(sys, mvreg, mk::bf_reg_t_es_selector);
                 }
 
                 case mv::mv_reg_t_es_attrib: {
-                    return sys.bf_vs_op_read(this->id(), mk::bf_reg_t_es_attrib);
+                    return this->reg_read(sys, mvreg, mk::bf_reg_t_es_attrib);
                 }
 
                 case mv::mv_reg_t_es_limit: {
-                    return sys.bf_vs_op_read(this->id(), mk::bf_reg_t_es_limit);
+                    return this->reg_read(sys, mvreg, mk::bf_reg_t_es_limit);
                 }
 
                 case mv::mv_reg_t_es_base: {
-                    return sys.bf_vs_op_read(this->id(), mk::bf_reg_t_es_base);
+                    return this->reg_read(sys, mvreg, mk::bf_reg_t_es_base);
                 }
 
                 case mv::mv_reg_t_cs_selector: {
-                    return sys.bf_vs_op_read(this->id(), mk::bf_reg_t_cs_selector);
+                    return this->reg_read(sys, mvreg, mk::bf_reg_t_cs_selector);
                 }
 
                 case mv::mv_reg_t_cs_attrib: {
-                    return sys.bf_vs_op_read(this->id(), mk::bf_reg_t_cs_attrib);
+                    return this->reg_read(sys, mvreg, mk::bf_reg_t_cs_attrib);
                 }
 
                 case mv::mv_reg_t_cs_limit: {
-                    return sys.bf_vs_op_read(this->id(), mk::bf_reg_t_cs_limit);
+                    return this->reg_read(sys, mvreg, mk::bf_reg_t_cs_limit);
                 }
 
                 case mv::mv_reg_t_cs_base: {
-                    return sys.bf_vs_op_read(this->id(), mk::bf_reg_t_cs_base);
+                    return this->reg_read(sys, mvreg, mk::bf_reg_t_cs_base);
                 }
 
                 case mv::mv_reg_t_ss_selector: {
-                    return sys.bf_vs_op_read(this->id(), mk::bf_reg_t_ss_selector);
+                    return this->reg_read(sys, mvreg, mk::bf_reg_t_ss_selector);
                 }
 
                 case mv::mv_reg_t_ss_attrib: {
-                    return sys.bf_vs_op_read(this->id(), mk::bf_reg_t_ss_attrib);
+                    return this->reg_read(sys, mvreg, mk::bf_reg_t_ss_attrib);
                 }
 
                 case mv::mv_reg_t_ss_limit: {
-                    return sys.bf_vs_op_read(this->id(), mk::bf_reg_t_ss_limit);
+                    return this->reg_read(sys, mvreg, mk::bf_reg_t_ss_limit);
                 }
 
                 case mv::mv_reg_t_ss_base: {
-                    return sys.bf_vs_op_read(this->id(), mk::bf_reg_t_ss_base);
+                    return this->reg_read(sys, mvreg, mk::bf_reg_t_ss_base);
                 }
 
                 case mv::mv_reg_t_ds_selector: {
-                    return sys.bf_vs_op_read(this->id(), mk::bf_reg_t_ds_selector);
+                    return this->reg_read(sys, mvreg, mk::bf_reg_t_ds_selector);
                 }
 
                 case mv::mv_reg_t_ds_attrib: {
-                    return sys.bf_vs_op_read(this->id(), mk::bf_reg_t_ds_attrib);
+                    return this->reg_read(sys, mvreg, mk::bf_reg_t_ds_attrib);
                 }
 
                 case mv::mv_reg_t_ds_limit: {
-                    return sys.bf_vs_op_read(this->id(), mk::bf_reg_t_ds_limit);
+                    return this->reg_read(sys, mvreg, mk::bf_reg_t_ds_limit);
                 }
 
                 case mv::mv_reg_t_ds_base: {
-                    return sys.bf_vs_op_read(this->id(), mk::bf_reg_t_ds_base);
+                    return this->reg_read(sys, mvreg, mk::bf_reg_t_ds_base);
                 }
 
                 case mv::mv_reg_t_fs_selector: {
-                    return sys.bf_vs_op_read(this->id(), mk::bf_reg_t_fs_selector);
+                    return this->reg_read(sys, mvreg, mk::bf_reg_t_fs_selector);
                 }
 
                 case mv::mv_reg_t_fs_attrib: {
-                    return sys.bf_vs_op_read(this->id(), mk::bf_reg_t_fs_attrib);
+                    return this->reg_read(sys, mvreg, mk::bf_reg_t_fs_attrib);
                 }
 
                 case mv::mv_reg_t_fs_limit: {
-                    return sys.bf_vs_op_read(this->id(), mk::bf_reg_t_fs_limit);
+                    return this->reg_read(sys, mvreg, mk::bf_reg_t_fs_limit);
                 }
 
                 case mv::mv_reg_t_fs_base: {
-                    return sys.bf_vs_op_read(this->id(), mk::bf_reg_t_fs_base);
+                    return this->reg_read(sys, mvreg, mk::bf_reg_t_fs_base);
                 }
 
                 case mv::mv_reg_t_gs_selector: {
-                    return sys.bf_vs_op_read(this->id(), mk::bf_reg_t_gs_selector);
+                    return this->reg_read(sys, mvreg, mk::bf_reg_t_gs_selector);
                 }
 
                 case mv::mv_reg_t_gs_attrib: {
-                    return sys.bf_vs_op_read(this->id(), mk::bf_reg_t_gs_attrib);
+                    return this->reg_read(sys, mvreg, mk::bf_reg_t_gs_attrib);
                 }
 
                 case mv::mv_reg_t_gs_limit: {
-                    return sys.bf_vs_op_read(this->id(), mk::bf_reg_t_gs_limit);
+                    return this->reg_read(sys, mvreg, mk::bf_reg_t_gs_limit);
                 }
 
                 case mv::mv_reg_t_gs_base: {
-                    return sys.bf_vs_op_read(this->id(), mk::bf_reg_t_gs_base);
+                    return this->reg_read(sys, mvreg, mk::bf_reg_t_gs_base);
                 }
 
                 case mv::mv_reg_t_ldtr_selector: {
-                    return sys.bf_vs_op_read(this->id(), mk::bf_reg_t_ldtr_selector);
+                    return this->reg_read(sys, mvreg, mk::bf_reg_t_ldtr_selector);
                 }
 
                 case mv::mv_reg_t_ldtr_attrib: {
-                    return sys.bf_vs_op_read(this->id(), mk::bf_reg_t_ldtr_attrib);
+                    return this->reg_read(sys, mvreg, mk::bf_reg_t_ldtr_attrib);
                 }
 
                 case mv::mv_reg_t_ldtr_limit: {
-                    return sys.bf_vs_op_read(this->id(), mk::bf_reg_t_ldtr_limit);
+                    return this->reg_read(sys, mvreg, mk::bf_reg_t_ldtr_limit);
                 }
 
                 case mv::mv_reg_t_ldtr_base: {
-                    return sys.bf_vs_op_read(this->id(), mk::bf_reg_t_ldtr_base);
+                    return this->reg_read(sys, mvreg, mk::bf_reg_t_ldtr_base);
                 }
 
                 case mv::mv_reg_t_tr_selector: {
-                    return sys.bf_vs_op_read(this->id(), mk::bf_reg_t_tr_selector);
+                    return this->reg_read(sys, mvreg, mk::bf_reg_t_tr_selector);
                 }
 
                 case mv::mv_reg_t_tr_attrib: {
-                    return sys.bf_vs_op_read(this->id(), mk::bf_reg_t_tr_attrib);
+                    return this->reg_read(sys, mvreg, mk::bf_reg_t_tr_attrib);
                 }
 
                 case mv::mv_reg_t_tr_limit: {
-                    return sys.bf_vs_op_read(this->id(), mk::bf_reg_t_tr_limit);
+                    return this->reg_read(sys, mvreg, mk::bf_reg_t_tr_limit);
                 }
 
                 case mv::mv_reg_t_tr_base: {
-                    return sys.bf_vs_op_read(this->id(), mk::bf_reg_t_tr_base);
+                    return this->reg_read(sys, mvreg, mk::bf_reg_t_tr_base);
                 }
 
                 case mv::mv_reg_t_gdtr_selector: {
@@ -1161,11 +1660,11 @@ namespace microv
                 }
 
                 case mv::mv_reg_t_gdtr_limit: {
-                    return sys.bf_vs_op_read(this->id(), mk::bf_reg_t_gdtr_limit);
+                    return this->reg_read(sys, mvreg, mk::bf_reg_t_gdtr_limit);
                 }
 
                 case mv::mv_reg_t_gdtr_base: {
-                    return sys.bf_vs_op_read(this->id(), mk::bf_reg_t_gdtr_base);
+                    return this->reg_read(sys, mvreg, mk::bf_reg_t_gdtr_base);
                 }
 
                 case mv::mv_reg_t_idtr_selector: {
@@ -1177,59 +1676,59 @@ namespace microv
                 }
 
                 case mv::mv_reg_t_idtr_limit: {
-                    return sys.bf_vs_op_read(this->id(), mk::bf_reg_t_idtr_limit);
+                    return this->reg_read(sys, mvreg, mk::bf_reg_t_idtr_limit);
                 }
 
                 case mv::mv_reg_t_idtr_base: {
-                    return sys.bf_vs_op_read(this->id(), mk::bf_reg_t_idtr_base);
+                    return this->reg_read(sys, mvreg, mk::bf_reg_t_idtr_base);
                 }
 
                 case mv::mv_reg_t_dr0: {
-                    return sys.bf_vs_op_read(this->id(), mk::bf_reg_t_dr0);
+                    return this->reg_read(sys, mvreg, mk::bf_reg_t_dr0);
                 }
 
                 case mv::mv_reg_t_dr1: {
-                    return sys.bf_vs_op_read(this->id(), mk::bf_reg_t_dr1);
+                    return this->reg_read(sys, mvreg, mk::bf_reg_t_dr1);
                 }
 
                 case mv::mv_reg_t_dr2: {
-                    return sys.bf_vs_op_read(this->id(), mk::bf_reg_t_dr2);
+                    return this->reg_read(sys, mvreg, mk::bf_reg_t_dr2);
                 }
 
                 case mv::mv_reg_t_dr3: {
-                    return sys.bf_vs_op_read(this->id(), mk::bf_reg_t_dr3);
+                    return this->reg_read(sys, mvreg, mk::bf_reg_t_dr3);
                 }
 
                 case mv::mv_reg_t_dr6: {
-                    return sys.bf_vs_op_read(this->id(), mk::bf_reg_t_dr6);
+                    return this->reg_read(sys, mvreg, mk::bf_reg_t_dr6);
                 }
 
                 case mv::mv_reg_t_dr7: {
-                    return sys.bf_vs_op_read(this->id(), mk::bf_reg_t_dr7);
+                    return this->reg_read(sys, mvreg, mk::bf_reg_t_dr7);
                 }
 
                 case mv::mv_reg_t_cr0: {
-                    return sys.bf_vs_op_read(this->id(), mk::bf_reg_t_cr0);
+                    return this->reg_read(sys, mvreg, mk::bf_reg_t_cr0);
                 }
 
                 case mv::mv_reg_t_cr2: {
-                    return sys.bf_vs_op_read(this->id(), mk::bf_reg_t_cr2);
+                    return this->reg_read(sys, mvreg, mk::bf_reg_t_cr2);
                 }
 
                 case mv::mv_reg_t_cr3: {
-                    return sys.bf_vs_op_read(this->id(), mk::bf_reg_t_cr3);
+                    return this->reg_read(sys, mvreg, mk::bf_reg_t_cr3);
                 }
 
                 case mv::mv_reg_t_cr4: {
-                    return sys.bf_vs_op_read(this->id(), mk::bf_reg_t_cr4);
+                    return this->reg_read(sys, mvreg, mk::bf_reg_t_cr4);
                 }
 
                 case mv::mv_reg_t_cr8: {
-                    return sys.bf_vs_op_read(this->id(), mk::bf_reg_t_cr8);
+                    return this->reg_read(sys, mvreg, mk::bf_reg_t_cr8);
                 }
 
                 case mv::mv_reg_t_xcr0: {
-                    return sys.bf_vs_op_read(this->id(), mk::bf_reg_t_xcr0);
+                    return this->reg_read(sys, mvreg, mk::bf_reg_t_xcr0);
                     break;
                 }
 
@@ -1275,209 +1774,211 @@ namespace microv
             using mk = syscall::bf_reg_t;
             using mv = hypercall::mv_reg_t;
 
-            switch (static_cast<hypercall::mv_reg_t>(reg.get())) {
+            auto const mvreg{static_cast<mv>(reg.get())};
+
+            switch (mvreg) {
                 case mv::mv_reg_t_unsupported: {
                     break;
                 }
 
                 case mv::mv_reg_t_rax: {
-                    return mut_sys.bf_vs_op_write(this->id(), mk::bf_reg_t_rax, val);
+                    return this->reg_write(mut_sys, mvreg, mk::bf_reg_t_rax, val);
                 }
 
                 case mv::mv_reg_t_rbx: {
-                    return mut_sys.bf_vs_op_write(this->id(), mk::bf_reg_t_rbx, val);
+                    return this->reg_write(mut_sys, mvreg, mk::bf_reg_t_rbx, val);
                 }
 
                 case mv::mv_reg_t_rcx: {
-                    return mut_sys.bf_vs_op_write(this->id(), mk::bf_reg_t_rcx, val);
+                    return this->reg_write(mut_sys, mvreg, mk::bf_reg_t_rcx, val);
                 }
 
                 case mv::mv_reg_t_rdx: {
-                    return mut_sys.bf_vs_op_write(this->id(), mk::bf_reg_t_rdx, val);
+                    return this->reg_write(mut_sys, mvreg, mk::bf_reg_t_rdx, val);
                 }
 
                 case mv::mv_reg_t_rbp: {
-                    return mut_sys.bf_vs_op_write(this->id(), mk::bf_reg_t_rbp, val);
+                    return this->reg_write(mut_sys, mvreg, mk::bf_reg_t_rbp, val);
                 }
 
                 case mv::mv_reg_t_rsi: {
-                    return mut_sys.bf_vs_op_write(this->id(), mk::bf_reg_t_rsi, val);
+                    return this->reg_write(mut_sys, mvreg, mk::bf_reg_t_rsi, val);
                 }
 
                 case mv::mv_reg_t_rdi: {
-                    return mut_sys.bf_vs_op_write(this->id(), mk::bf_reg_t_rdi, val);
+                    return this->reg_write(mut_sys, mvreg, mk::bf_reg_t_rdi, val);
                 }
 
                 case mv::mv_reg_t_r8: {
-                    return mut_sys.bf_vs_op_write(this->id(), mk::bf_reg_t_r8, val);
+                    return this->reg_write(mut_sys, mvreg, mk::bf_reg_t_r8, val);
                 }
 
                 case mv::mv_reg_t_r9: {
-                    return mut_sys.bf_vs_op_write(this->id(), mk::bf_reg_t_r9, val);
+                    return this->reg_write(mut_sys, mvreg, mk::bf_reg_t_r9, val);
                 }
 
                 case mv::mv_reg_t_r10: {
-                    return mut_sys.bf_vs_op_write(this->id(), mk::bf_reg_t_r10, val);
+                    return this->reg_write(mut_sys, mvreg, mk::bf_reg_t_r10, val);
                 }
 
                 case mv::mv_reg_t_r11: {
-                    return mut_sys.bf_vs_op_write(this->id(), mk::bf_reg_t_r11, val);
+                    return this->reg_write(mut_sys, mvreg, mk::bf_reg_t_r11, val);
                 }
 
                 case mv::mv_reg_t_r12: {
-                    return mut_sys.bf_vs_op_write(this->id(), mk::bf_reg_t_r12, val);
+                    return this->reg_write(mut_sys, mvreg, mk::bf_reg_t_r12, val);
                 }
 
                 case mv::mv_reg_t_r13: {
-                    return mut_sys.bf_vs_op_write(this->id(), mk::bf_reg_t_r13, val);
+                    return this->reg_write(mut_sys, mvreg, mk::bf_reg_t_r13, val);
                 }
 
                 case mv::mv_reg_t_r14: {
-                    return mut_sys.bf_vs_op_write(this->id(), mk::bf_reg_t_r14, val);
+                    return this->reg_write(mut_sys, mvreg, mk::bf_reg_t_r14, val);
                 }
 
                 case mv::mv_reg_t_r15: {
-                    return mut_sys.bf_vs_op_write(this->id(), mk::bf_reg_t_r15, val);
+                    return this->reg_write(mut_sys, mvreg, mk::bf_reg_t_r15, val);
                 }
 
                 case mv::mv_reg_t_rsp: {
-                    return mut_sys.bf_vs_op_write(this->id(), mk::bf_reg_t_rsp, val);
+                    return this->reg_write(mut_sys, mvreg, mk::bf_reg_t_rsp, val);
                 }
 
                 case mv::mv_reg_t_rip: {
-                    return mut_sys.bf_vs_op_write(this->id(), mk::bf_reg_t_rip, val);
+                    return this->reg_write(mut_sys, mvreg, mk::bf_reg_t_rip, val);
                 }
 
                 case mv::mv_reg_t_rflags: {
-                    return mut_sys.bf_vs_op_write(this->id(), mk::bf_reg_t_rflags, val);
+                    return this->reg_write(mut_sys, mvreg, mk::bf_reg_t_rflags, val);
                 }
 
                 case mv::mv_reg_t_es_selector: {
-                    return mut_sys.bf_vs_op_write(this->id(), mk::bf_reg_t_es_selector, val);
+                    return this->reg_write(mut_sys, mvreg, mk::bf_reg_t_es_selector, val);
                 }
 
                 case mv::mv_reg_t_es_attrib: {
-                    return mut_sys.bf_vs_op_write(this->id(), mk::bf_reg_t_es_attrib, val);
+                    return this->reg_write(mut_sys, mvreg, mk::bf_reg_t_es_attrib, val);
                 }
 
                 case mv::mv_reg_t_es_limit: {
-                    return mut_sys.bf_vs_op_write(this->id(), mk::bf_reg_t_es_limit, val);
+                    return this->reg_write(mut_sys, mvreg, mk::bf_reg_t_es_limit, val);
                 }
 
                 case mv::mv_reg_t_es_base: {
-                    return mut_sys.bf_vs_op_write(this->id(), mk::bf_reg_t_es_base, val);
+                    return this->reg_write(mut_sys, mvreg, mk::bf_reg_t_es_base, val);
                 }
 
                 case mv::mv_reg_t_cs_selector: {
-                    return mut_sys.bf_vs_op_write(this->id(), mk::bf_reg_t_cs_selector, val);
+                    return this->reg_write(mut_sys, mvreg, mk::bf_reg_t_cs_selector, val);
                 }
 
                 case mv::mv_reg_t_cs_attrib: {
-                    return mut_sys.bf_vs_op_write(this->id(), mk::bf_reg_t_cs_attrib, val);
+                    return this->reg_write(mut_sys, mvreg, mk::bf_reg_t_cs_attrib, val);
                 }
 
                 case mv::mv_reg_t_cs_limit: {
-                    return mut_sys.bf_vs_op_write(this->id(), mk::bf_reg_t_cs_limit, val);
+                    return this->reg_write(mut_sys, mvreg, mk::bf_reg_t_cs_limit, val);
                 }
 
                 case mv::mv_reg_t_cs_base: {
-                    return mut_sys.bf_vs_op_write(this->id(), mk::bf_reg_t_cs_base, val);
+                    return this->reg_write(mut_sys, mvreg, mk::bf_reg_t_cs_base, val);
                 }
 
                 case mv::mv_reg_t_ss_selector: {
-                    return mut_sys.bf_vs_op_write(this->id(), mk::bf_reg_t_ss_selector, val);
+                    return this->reg_write(mut_sys, mvreg, mk::bf_reg_t_ss_selector, val);
                 }
 
                 case mv::mv_reg_t_ss_attrib: {
-                    return mut_sys.bf_vs_op_write(this->id(), mk::bf_reg_t_ss_attrib, val);
+                    return this->reg_write(mut_sys, mvreg, mk::bf_reg_t_ss_attrib, val);
                 }
 
                 case mv::mv_reg_t_ss_limit: {
-                    return mut_sys.bf_vs_op_write(this->id(), mk::bf_reg_t_ss_limit, val);
+                    return this->reg_write(mut_sys, mvreg, mk::bf_reg_t_ss_limit, val);
                 }
 
                 case mv::mv_reg_t_ss_base: {
-                    return mut_sys.bf_vs_op_write(this->id(), mk::bf_reg_t_ss_base, val);
+                    return this->reg_write(mut_sys, mvreg, mk::bf_reg_t_ss_base, val);
                 }
 
                 case mv::mv_reg_t_ds_selector: {
-                    return mut_sys.bf_vs_op_write(this->id(), mk::bf_reg_t_ds_selector, val);
+                    return this->reg_write(mut_sys, mvreg, mk::bf_reg_t_ds_selector, val);
                 }
 
                 case mv::mv_reg_t_ds_attrib: {
-                    return mut_sys.bf_vs_op_write(this->id(), mk::bf_reg_t_ds_attrib, val);
+                    return this->reg_write(mut_sys, mvreg, mk::bf_reg_t_ds_attrib, val);
                 }
 
                 case mv::mv_reg_t_ds_limit: {
-                    return mut_sys.bf_vs_op_write(this->id(), mk::bf_reg_t_ds_limit, val);
+                    return this->reg_write(mut_sys, mvreg, mk::bf_reg_t_ds_limit, val);
                 }
 
                 case mv::mv_reg_t_ds_base: {
-                    return mut_sys.bf_vs_op_write(this->id(), mk::bf_reg_t_ds_base, val);
+                    return this->reg_write(mut_sys, mvreg, mk::bf_reg_t_ds_base, val);
                 }
 
                 case mv::mv_reg_t_fs_selector: {
-                    return mut_sys.bf_vs_op_write(this->id(), mk::bf_reg_t_fs_selector, val);
+                    return this->reg_write(mut_sys, mvreg, mk::bf_reg_t_fs_selector, val);
                 }
 
                 case mv::mv_reg_t_fs_attrib: {
-                    return mut_sys.bf_vs_op_write(this->id(), mk::bf_reg_t_fs_attrib, val);
+                    return this->reg_write(mut_sys, mvreg, mk::bf_reg_t_fs_attrib, val);
                 }
 
                 case mv::mv_reg_t_fs_limit: {
-                    return mut_sys.bf_vs_op_write(this->id(), mk::bf_reg_t_fs_limit, val);
+                    return this->reg_write(mut_sys, mvreg, mk::bf_reg_t_fs_limit, val);
                 }
 
                 case mv::mv_reg_t_fs_base: {
-                    return mut_sys.bf_vs_op_write(this->id(), mk::bf_reg_t_fs_base, val);
+                    return this->reg_write(mut_sys, mvreg, mk::bf_reg_t_fs_base, val);
                 }
 
                 case mv::mv_reg_t_gs_selector: {
-                    return mut_sys.bf_vs_op_write(this->id(), mk::bf_reg_t_gs_selector, val);
+                    return this->reg_write(mut_sys, mvreg, mk::bf_reg_t_gs_selector, val);
                 }
 
                 case mv::mv_reg_t_gs_attrib: {
-                    return mut_sys.bf_vs_op_write(this->id(), mk::bf_reg_t_gs_attrib, val);
+                    return this->reg_write(mut_sys, mvreg, mk::bf_reg_t_gs_attrib, val);
                 }
 
                 case mv::mv_reg_t_gs_limit: {
-                    return mut_sys.bf_vs_op_write(this->id(), mk::bf_reg_t_gs_limit, val);
+                    return this->reg_write(mut_sys, mvreg, mk::bf_reg_t_gs_limit, val);
                 }
 
                 case mv::mv_reg_t_gs_base: {
-                    return mut_sys.bf_vs_op_write(this->id(), mk::bf_reg_t_gs_base, val);
+                    return this->reg_write(mut_sys, mvreg, mk::bf_reg_t_gs_base, val);
                 }
 
                 case mv::mv_reg_t_ldtr_selector: {
-                    return mut_sys.bf_vs_op_write(this->id(), mk::bf_reg_t_ldtr_selector, val);
+                    return this->reg_write(mut_sys, mvreg, mk::bf_reg_t_ldtr_selector, val);
                 }
 
                 case mv::mv_reg_t_ldtr_attrib: {
-                    return mut_sys.bf_vs_op_write(this->id(), mk::bf_reg_t_ldtr_attrib, val);
+                    return this->reg_write(mut_sys, mvreg, mk::bf_reg_t_ldtr_attrib, val);
                 }
 
                 case mv::mv_reg_t_ldtr_limit: {
-                    return mut_sys.bf_vs_op_write(this->id(), mk::bf_reg_t_ldtr_limit, val);
+                    return this->reg_write(mut_sys, mvreg, mk::bf_reg_t_ldtr_limit, val);
                 }
 
                 case mv::mv_reg_t_ldtr_base: {
-                    return mut_sys.bf_vs_op_write(this->id(), mk::bf_reg_t_ldtr_base, val);
+                    return this->reg_write(mut_sys, mvreg, mk::bf_reg_t_ldtr_base, val);
                 }
 
                 case mv::mv_reg_t_tr_selector: {
-                    return mut_sys.bf_vs_op_write(this->id(), mk::bf_reg_t_tr_selector, val);
+                    return this->reg_write(mut_sys, mvreg, mk::bf_reg_t_tr_selector, val);
                 }
 
                 case mv::mv_reg_t_tr_attrib: {
-                    return mut_sys.bf_vs_op_write(this->id(), mk::bf_reg_t_tr_attrib, val);
+                    return this->reg_write(mut_sys, mvreg, mk::bf_reg_t_tr_attrib, val);
                 }
 
                 case mv::mv_reg_t_tr_limit: {
-                    return mut_sys.bf_vs_op_write(this->id(), mk::bf_reg_t_tr_limit, val);
+                    return this->reg_write(mut_sys, mvreg, mk::bf_reg_t_tr_limit, val);
                 }
 
                 case mv::mv_reg_t_tr_base: {
-                    return mut_sys.bf_vs_op_write(this->id(), mk::bf_reg_t_tr_base, val);
+                    return this->reg_write(mut_sys, mvreg, mk::bf_reg_t_tr_base, val);
                 }
 
                 case mv::mv_reg_t_gdtr_selector: {
@@ -1489,11 +1990,11 @@ namespace microv
                 }
 
                 case mv::mv_reg_t_gdtr_limit: {
-                    return mut_sys.bf_vs_op_write(this->id(), mk::bf_reg_t_gdtr_limit, val);
+                    return this->reg_write(mut_sys, mvreg, mk::bf_reg_t_gdtr_limit, val);
                 }
 
                 case mv::mv_reg_t_gdtr_base: {
-                    return mut_sys.bf_vs_op_write(this->id(), mk::bf_reg_t_gdtr_base, val);
+                    return this->reg_write(mut_sys, mvreg, mk::bf_reg_t_gdtr_base, val);
                 }
 
                 case mv::mv_reg_t_idtr_selector: {
@@ -1505,59 +2006,59 @@ namespace microv
                 }
 
                 case mv::mv_reg_t_idtr_limit: {
-                    return mut_sys.bf_vs_op_write(this->id(), mk::bf_reg_t_idtr_limit, val);
+                    return this->reg_write(mut_sys, mvreg, mk::bf_reg_t_idtr_limit, val);
                 }
 
                 case mv::mv_reg_t_idtr_base: {
-                    return mut_sys.bf_vs_op_write(this->id(), mk::bf_reg_t_idtr_base, val);
+                    return this->reg_write(mut_sys, mvreg, mk::bf_reg_t_idtr_base, val);
                 }
 
                 case mv::mv_reg_t_dr0: {
-                    return mut_sys.bf_vs_op_write(this->id(), mk::bf_reg_t_dr0, val);
+                    return this->reg_write(mut_sys, mvreg, mk::bf_reg_t_dr0, val);
                 }
 
                 case mv::mv_reg_t_dr1: {
-                    return mut_sys.bf_vs_op_write(this->id(), mk::bf_reg_t_dr1, val);
+                    return this->reg_write(mut_sys, mvreg, mk::bf_reg_t_dr1, val);
                 }
 
                 case mv::mv_reg_t_dr2: {
-                    return mut_sys.bf_vs_op_write(this->id(), mk::bf_reg_t_dr2, val);
+                    return this->reg_write(mut_sys, mvreg, mk::bf_reg_t_dr2, val);
                 }
 
                 case mv::mv_reg_t_dr3: {
-                    return mut_sys.bf_vs_op_write(this->id(), mk::bf_reg_t_dr3, val);
+                    return this->reg_write(mut_sys, mvreg, mk::bf_reg_t_dr3, val);
                 }
 
                 case mv::mv_reg_t_dr6: {
-                    return mut_sys.bf_vs_op_write(this->id(), mk::bf_reg_t_dr6, val);
+                    return this->reg_write(mut_sys, mvreg, mk::bf_reg_t_dr6, val);
                 }
 
                 case mv::mv_reg_t_dr7: {
-                    return mut_sys.bf_vs_op_write(this->id(), mk::bf_reg_t_dr7, val);
+                    return this->reg_write(mut_sys, mvreg, mk::bf_reg_t_dr7, val);
                 }
 
                 case mv::mv_reg_t_cr0: {
-                    return mut_sys.bf_vs_op_write(this->id(), mk::bf_reg_t_cr0, val);
+                    return this->reg_write(mut_sys, mvreg, mk::bf_reg_t_cr0, val);
                 }
 
                 case mv::mv_reg_t_cr2: {
-                    return mut_sys.bf_vs_op_write(this->id(), mk::bf_reg_t_cr2, val);
+                    return this->reg_write(mut_sys, mvreg, mk::bf_reg_t_cr2, val);
                 }
 
                 case mv::mv_reg_t_cr3: {
-                    return mut_sys.bf_vs_op_write(this->id(), mk::bf_reg_t_cr3, val);
+                    return this->reg_write(mut_sys, mvreg, mk::bf_reg_t_cr3, val);
                 }
 
                 case mv::mv_reg_t_cr4: {
-                    return mut_sys.bf_vs_op_write(this->id(), mk::bf_reg_t_cr4, val);
+                    return this->reg_write(mut_sys, mvreg, mk::bf_reg_t_cr4, val);
                 }
 
                 case mv::mv_reg_t_cr8: {
-                    return mut_sys.bf_vs_op_write(this->id(), mk::bf_reg_t_cr8, val);
+                    return this->reg_write(mut_sys, mvreg, mk::bf_reg_t_cr8, val);
                 }
 
                 case mv::mv_reg_t_xcr0: {
-                    return mut_sys.bf_vs_op_write(this->id(), mk::bf_reg_t_xcr0, val);
+                    return this->reg_write(mut_sys, mvreg, mk::bf_reg_t_xcr0, val);
                     break;
                 }
 
@@ -1588,7 +2089,7 @@ namespace microv
         ///     and friends otherwise
         ///
         [[nodiscard]] constexpr auto
-        reg_get_list(syscall::bf_syscall_t const &sys, hypercall::mv_rdl_t &mut_rdl) const noexcept
+        reg_get_list(syscall::bf_syscall_t const &sys, hypercall::mv_rdl_t &mut_rdl) noexcept
             -> bsl::errc_type
         {
             bsl::expects(allocated_status_t::allocated == m_allocated);
@@ -1646,62 +2147,607 @@ namespace microv
         }
 
         /// <!-- description -->
-        ///   @brief Returns this vs_t's FPU state in the provided "page".
+        ///   @brief Returns the value of the requested MSR. The MSRs that
+        ///     are context switched by the microkernel are read through
+        ///     the register cache (see cache_read), IA32_APIC_BASE is stored by the
+        ///     emulated LAPIC, and the rest are emulated by emulated_msr_t.
         ///
         /// <!-- inputs/outputs -->
         ///   @param sys the bf_syscall_t to use
-        ///   @param mut_page the shared page to store the FPU state.
+        ///   @param msr the MSR to get
+        ///   @return Returns the value of the requested MSR
         ///
-        constexpr void
-        fpu_get_all(syscall::bf_syscall_t const &sys, page_4k_t &mut_page) const noexcept
+        [[nodiscard]] constexpr auto
+        msr_get(syscall::bf_syscall_t const &sys, bsl::safe_u32 const &msr) noexcept
+            -> bsl::safe_u64
         {
             bsl::expects(allocated_status_t::allocated == m_allocated);
             bsl::expects(running_status_t::running != m_status);
             bsl::expects(sys.bf_tls_ppid() == this->assigned_pp());
 
-            constexpr auto fpu_size{512_umx};
-            bsl::builtin_memcpy(&mut_page, m_xsave, fpu_size);
-        }
+            bsl::expects(msr.is_valid_and_checked());
 
-        /// <!-- description -->
-        ///   @brief Sets this vs_t's FPU state to the provided
-        ///     contents stored in "page".
-        ///
-        /// <!-- inputs/outputs -->
-        ///   @param sys the bf_syscall_t to use
-        ///   @param page the shared page containing the state to set this
-        ///     vs_t's FPU state to.
-        ///
-        constexpr void
-        fpu_set_all(syscall::bf_syscall_t const &sys, page_4k_t const &page) noexcept
-        {
-            bsl::expects(allocated_status_t::allocated == m_allocated);
-            bsl::expects(running_status_t::running != m_status);
-            bsl::expects(sys.bf_tls_ppid() == this->assigned_pp());
+            if (MSR_APIC_BASE == msr) {
+                return m_emulated_lapic.get_apic_base();
+            }
+
+            if (MSR_KVM_STEAL_TIME == msr) {
+                return m_emulated_steal_time.get();
+            }
+
+            if (emulated_clock_t::is_clock_msr(msr)) {
+                return m_emulated_clock.get(msr);
+            }
+
+            syscall::bf_reg_t mut_bf_reg{};
+            auto const slot{msr_to_slot(msr, mut_bf_reg)};
+            if (slot.is_invalid()) {
+                return m_emulated_msr.get(msr);
+            }
 
-            constexpr auto fpu_size{512_umx};
-            bsl::builtin_memcpy(m_xsave, &page, fpu_size);
+            return this->cache_read(sys, slot, mut_bf_reg);
         }
 
         /// <!-- description -->
-        ///   @brief Injects an exception into the vs_t. Unlike interrupts,
-        ///     exceptions cannot be masked, and therefore, the exception is
-        ///     immediately injected.
+        ///   @brief Sets the value of the requested MSR. Like registers,
+        ///     writes to MSRs that are context switched by the microkernel
+        ///     are deferred until this vs_t is run (see reg_flush).
         ///
         /// <!-- inputs/outputs -->
         ///   @param mut_sys the bf_syscall_t to use
-        ///   @param vector the vector to inject
-        ///   @param ec the error code to inject
+        ///   @param msr the MSR to set
+        ///   @param val the value to set the MSR to
         ///   @return Returns bsl::errc_success on success, bsl::errc_failure
-        ///     and friends otherwise.
+        ///     and friends otherwise
         ///
         [[nodiscard]] constexpr auto
-        inject_exception(
+        msr_set(
             syscall::bf_syscall_t &mut_sys,
-            bsl::safe_u64 const &vector,
-            bsl::safe_u64 const &ec) noexcept -> bsl::errc_type
+            bsl::safe_u32 const &msr,
+            bsl::safe_u64 const &val) noexcept -> bsl::errc_type
         {
-            constexpr auto idx{syscall::bf_reg_t::bf_reg_t_eventinj};
+            bsl::expects(allocated_status_t::allocated == m_allocated);
+            bsl::expects(running_status_t::running != m_status);
+            bsl::expects(mut_sys.bf_tls_ppid() == this->assigned_pp());
+
+            bsl::expects(msr.is_valid_and_checked());
+            bsl::expects(val.is_valid_and_checked());
+
+            if (MSR_APIC_BASE == msr) {
+                m_emulated_lapic.set_apic_base(val);
+                return bsl::errc_success;
+            }
+
+            if (MSR_KVM_STEAL_TIME == msr) {
+                return m_emulated_steal_time.set(val);
+            }
+
+            if (emulated_clock_t::is_clock_msr(msr)) {
+                return m_emulated_clock.set(msr, val);
+            }
+
+            syscall::bf_reg_t mut_bf_reg{};
+            auto const slot{msr_to_slot(msr, mut_bf_reg)};
+            if (slot.is_invalid()) {
+                return m_emulated_msr.set(msr, val);
+            }
+
+            return this->cache_write(mut_sys, slot, mut_bf_reg, val);
+        }
+
+        /// <!-- description -->
+        ///   @brief Returns the value of the requested MSRs from
+        ///     the provided RDL.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param sys the bf_syscall_t to use
+        ///   @param mut_rdl the RDL to store the requested MSR values
+        ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+        ///     and friends otherwise
+        ///
+        [[nodiscard]] constexpr auto
+        msr_get_list(syscall::bf_syscall_t const &sys, hypercall::mv_rdl_t &mut_rdl) noexcept
+            -> bsl::errc_type
+        {
+            bsl::expects(allocated_status_t::allocated == m_allocated);
+            bsl::expects(running_status_t::running != m_status);
+            bsl::expects(sys.bf_tls_ppid() == this->assigned_pp());
+            bsl::expects(mut_rdl.num_entries <= mut_rdl.entries.size());
+
+            for (bsl::safe_idx mut_i{}; mut_i < mut_rdl.num_entries; ++mut_i) {
+                auto const msr{bsl::to_u32_unsafe(bsl::to_u64(mut_rdl.entries.at_if(mut_i)->reg))};
+                auto const val{this->msr_get(sys, msr)};
+                if (bsl::unlikely(val.is_invalid())) {
+                    bsl::print<bsl::V>() << bsl::here();
+                    return bsl::errc_failure;
+                }
+
+                mut_rdl.entries.at_if(mut_i)->val = val.get();
+            }
+
+            return bsl::errc_success;
+        }
+
+        /// <!-- description -->
+        ///   @brief Sets the value of the requested MSRs given
+        ///     the provided RDL.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param mut_sys the bf_syscall_t to use
+        ///   @param rdl the RDL to get the requested MSR values from
+        ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+        ///     and friends otherwise
+        ///
+        [[nodiscard]] constexpr auto
+        msr_set_list(syscall::bf_syscall_t &mut_sys, hypercall::mv_rdl_t const &rdl) noexcept
+            -> bsl::errc_type
+        {
+            bsl::expects(allocated_status_t::allocated == m_allocated);
+            bsl::expects(running_status_t::running != m_status);
+            bsl::expects(mut_sys.bf_tls_ppid() == this->assigned_pp());
+            bsl::expects(rdl.num_entries <= rdl.entries.size());
+
+            for (bsl::safe_idx mut_i{}; mut_i < rdl.num_entries; ++mut_i) {
+                auto const msr{bsl::to_u32_unsafe(bsl::to_u64(rdl.entries.at_if(mut_i)->reg))};
+                auto const val{bsl::to_u64(rdl.entries.at_if(mut_i)->val)};
+
+                auto const ret{this->msr_set(mut_sys, msr, val)};
+                if (bsl::unlikely(!ret)) {
+                    bsl::print<bsl::V>() << bsl::here();
+                    return ret;
+                }
+
+                bsl::touch();
+            }
+
+            return bsl::errc_success;
+        }
+
+        /// <!-- description -->
+        ///   @brief Returns the TSC frequency of this vs_t in KHz, or 0 if
+        ///     the frequency is unknown.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @return Returns the TSC frequency of this vs_t in KHz, or 0 if
+        ///     the frequency is unknown.
+        ///
+        [[nodiscard]] constexpr auto
+        tsc_khz() const noexcept -> bsl::safe_u64
+        {
+            bsl::ensures(m_tsc_khz.is_valid_and_checked());
+            return m_tsc_khz;
+        }
+
+        /// <!-- description -->
+        ///   @brief Sets the TSC frequency of this vs_t in KHz. On AMD, the
+        ///     TSC ratio is set using the TSC_RATIO MSR, which is not part
+        ///     of the VMCB and is not context switched by the microkernel,
+        ///     so only the frequency of the PP is supported.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param mut_sys the bf_syscall_t to use
+        ///   @param host_khz the TSC frequency of the PP in KHz
+        ///   @param khz the TSC frequency the VS should see in KHz
+        ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+        ///     and friends otherwise
+        ///
+        [[nodiscard]] constexpr auto
+        tsc_set_khz(
+            syscall::bf_syscall_t &mut_sys,
+            bsl::safe_u64 const &host_khz,
+            bsl::safe_u64 const &khz) noexcept -> bsl::errc_type
+        {
+            bsl::expects(allocated_status_t::allocated == m_allocated);
+            bsl::expects(running_status_t::running != m_status);
+            bsl::expects(mut_sys.bf_tls_ppid() == this->assigned_pp());
+
+            bsl::expects(host_khz.is_valid_and_checked());
+            bsl::expects(host_khz.is_pos());
+            bsl::expects(khz.is_valid_and_checked());
+            bsl::expects(khz.is_pos());
+
+            if (bsl::unlikely(host_khz != khz)) {
+                bsl::error() << "unable to set the tsc frequency of vs "    // --
+                             << bsl::hex(this->id())                        // --
+                             << " to "                                      // --
+                             << khz                                         // --
+                             << "khz as tsc scaling is not supported"       // --
+                             << bsl::endl                                   // --
+                             << bsl::here();                                // --
+
+                return bsl::errc_unsupported;
+            }
+
+            m_tsc_khz = khz;
+            m_emulated_cpuid.set_tsc_khz(khz);
+            m_emulated_clock.invalidate();
+            return bsl::errc_success;
+        }
+
+        /// <!-- description -->
+        ///   @brief Sets the TSC offset of this vs_t. The VS sees the TSC
+        ///     of the PP plus this offset when it executes RDTSC/RDTSCP,
+        ///     without a VMExit.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param mut_sys the bf_syscall_t to use
+        ///   @param offset the TSC offset to use (two's complement)
+        ///
+        constexpr void
+        tsc_set_offset(syscall::bf_syscall_t &mut_sys, bsl::safe_u64 const &offset) noexcept
+        {
+            bsl::expects(allocated_status_t::allocated == m_allocated);
+            bsl::expects(running_status_t::running != m_status);
+            bsl::expects(mut_sys.bf_tls_ppid() == this->assigned_pp());
+            bsl::expects(offset.is_valid_and_checked());
+
+            constexpr auto offset_idx{syscall::bf_reg_t::bf_reg_t_tsc_offset};
+            bsl::expects(mut_sys.bf_vs_op_write(this->id(), offset_idx, offset));
+
+            m_emulated_clock.invalidate();
+        }
+
+        /// <!-- description -->
+        ///   @brief Writes the kvmclock structures of this vs_t if they are
+        ///     out of date (see emulated_clock_t::is_stale). This must be
+        ///     called on the PP this vs_t is assigned to before it is run,
+        ///     and after the guest writes to one of the kvmclock MSRs.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param tls the tls_t to use
+        ///   @param mut_sys the bf_syscall_t to use
+        ///   @param mut_pp_pool the pp_pool_t to use
+        ///   @param vm_pool the vm_pool_t to use
+        ///   @param intrinsic the intrinsic_t to use
+        ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+        ///     and friends otherwise
+        ///
+        [[nodiscard]] constexpr auto
+        clock_update(
+            tls_t const &tls,
+            syscall::bf_syscall_t &mut_sys,
+            pp_pool_t &mut_pp_pool,
+            vm_pool_t const &vm_pool,
+            intrinsic_t const &intrinsic) noexcept -> bsl::errc_type
+        {
+            bsl::expects(allocated_status_t::allocated == m_allocated);
+            bsl::expects(running_status_t::running != m_status);
+            bsl::expects(mut_sys.bf_tls_ppid() == this->assigned_pp());
+
+            auto const vmid{this->assigned_vm()};
+            if (!m_emulated_clock.is_stale(mut_sys, vm_pool, vmid)) {
+                return bsl::errc_success;
+            }
+
+            auto const host_tsc{intrinsic.rdtsc()};
+            auto const guest_tsc{this->guest_tsc(mut_sys, host_tsc)};
+
+            return m_emulated_clock.update(
+                tls, mut_sys, mut_pp_pool, vm_pool, vmid, host_tsc, guest_tsc, m_tsc_khz);
+        }
+
+        /// <!-- description -->
+        ///   @brief Tells the guest that this vs_t is preempted (see
+        ///     emulated_steal_time_t::preempt). This must be called on the
+        ///     PP this vs_t is assigned to before returning to the root VM
+        ///     in a way that allows the root VM to schedule something else.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param tls the tls_t to use
+        ///   @param mut_sys the bf_syscall_t to use
+        ///   @param mut_pp_pool the pp_pool_t to use
+        ///   @param vm_pool the vm_pool_t to use
+        ///   @param intrinsic the intrinsic_t to use
+        ///
+        constexpr void
+        steal_time_preempt(
+            tls_t const &tls,
+            syscall::bf_syscall_t &mut_sys,
+            pp_pool_t &mut_pp_pool,
+            vm_pool_t const &vm_pool,
+            intrinsic_t const &intrinsic) noexcept
+        {
+            bsl::expects(allocated_status_t::allocated == m_allocated);
+            bsl::expects(mut_sys.bf_tls_ppid() == this->assigned_pp());
+
+            bsl::discard(m_emulated_steal_time.preempt(
+                tls, mut_sys, mut_pp_pool, vm_pool, intrinsic, this->assigned_vm()));
+        }
+
+        /// <!-- description -->
+        ///   @brief Clears the preempted flags of the guest, flushing the
+        ///     TLB if the guest asked for it while this vs_t was preempted
+        ///     (see emulated_steal_time_t::sync). This must be called on
+        ///     the PP this vs_t is assigned to before it is run.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param tls the tls_t to use
+        ///   @param mut_sys the bf_syscall_t to use
+        ///   @param mut_pp_pool the pp_pool_t to use
+        ///   @param vm_pool the vm_pool_t to use
+        ///   @param intrinsic the intrinsic_t to use
+        ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+        ///     and friends otherwise
+        ///
+        [[nodiscard]] constexpr auto
+        steal_time_sync(
+            tls_t const &tls,
+            syscall::bf_syscall_t &mut_sys,
+            pp_pool_t &mut_pp_pool,
+            vm_pool_t const &vm_pool,
+            intrinsic_t const &intrinsic) noexcept -> bsl::errc_type
+        {
+            bsl::expects(allocated_status_t::allocated == m_allocated);
+            bsl::expects(running_status_t::running != m_status);
+            bsl::expects(mut_sys.bf_tls_ppid() == this->assigned_pp());
+
+            return m_emulated_steal_time.sync(
+                tls, mut_sys, mut_pp_pool, vm_pool, intrinsic, this->assigned_vm());
+        }
+
+        /// <!-- description -->
+        ///   @brief Records an MSR access that was returned to software
+        ///     using mv_exit_reason_t_msr. The access is completed the next
+        ///     time this vs_t is run (see msr_exit_complete). This must be
+        ///     called while this vs_t is still active so that the RIP of
+        ///     the RDMSR/WRMSR can be recorded.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param sys the bf_syscall_t to use
+        ///   @param msr the MSR that was accessed
+        ///   @param type MV_EXIT_MSR_READ or MV_EXIT_MSR_WRITE
+        ///
+        constexpr void
+        msr_exit_begin(
+            syscall::bf_syscall_t const &sys,
+            bsl::safe_u32 const &msr,
+            bsl::safe_u64 const &type) noexcept
+        {
+            bsl::expects(allocated_status_t::allocated == m_allocated);
+            bsl::expects(msr.is_valid_and_checked());
+            bsl::expects(type.is_valid_and_checked());
+
+            auto const rip{sys.bf_vs_op_read(this->id(), syscall::bf_reg_t::bf_reg_t_rip)};
+            bsl::expects(rip.is_valid());
+
+            m_msr_exit.msr.reg = bsl::to_u64(msr).get();
+            m_msr_exit.msr.val = {};
+            m_msr_exit.flags = type.get();
+            m_msr_exit_rip = rip;
+        }
+
+        /// <!-- description -->
+        ///   @brief Returns true if an MSR access was returned to software
+        ///     and has not been completed yet. Returns false otherwise.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @return Returns true if an MSR access was returned to software
+        ///     and has not been completed yet. Returns false otherwise.
+        ///
+        [[nodiscard]] constexpr auto
+        msr_exit_pending() const noexcept -> bool
+        {
+            return bsl::to_u64(m_msr_exit.flags).is_pos();
+        }
+
+        /// <!-- description -->
+        ///   @brief Completes the MSR access recorded by msr_exit_begin
+        ///     using the mv_exit_msr_t that software provided to
+        ///     mv_vs_op_run. The result of a read is stored in RDX:RAX. If
+        ///     software set MV_EXIT_MSR_ERROR, the RIP of the RDMSR/WRMSR is
+        ///     restored and a #GP is injected instead.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param mut_sys the bf_syscall_t to use
+        ///   @param exit the mv_exit_msr_t provided by software
+        ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+        ///     and friends otherwise
+        ///
+        [[nodiscard]] constexpr auto
+        msr_exit_complete(
+            syscall::bf_syscall_t &mut_sys, hypercall::mv_exit_msr_t const &exit) noexcept
+            -> bsl::errc_type
+        {
+            using mk = syscall::bf_reg_t;
+            using mv = hypercall::mv_reg_t;
+
+            constexpr auto lo_mask{0x00000000FFFFFFFF_u64};
+            constexpr auto hi_shft{32_u64};
+
+            bsl::expects(allocated_status_t::allocated == m_allocated);
+            bsl::expects(running_status_t::running != m_status);
+            bsl::expects(mut_sys.bf_tls_ppid() == this->assigned_pp());
+            bsl::expects(this->msr_exit_pending());
+
+            if (bsl::unlikely(exit.msr.reg != m_msr_exit.msr.reg)) {
+                bsl::error() << "MSR "                                         // --
+                             << bsl::hex(bsl::to_u64(exit.msr.reg))            // --
+                             << " does not match the pending MSR exit for "    // --
+                             << bsl::hex(bsl::to_u64(m_msr_exit.msr.reg))      // --
+                             << bsl::endl                                      // --
+                             << bsl::here();                                   // --
+
+                return bsl::errc_failure;
+            }
+
+            auto const type{bsl::to_u64(m_msr_exit.flags)};
+            m_msr_exit = {};
+
+            if ((bsl::to_u64(exit.flags) & hypercall::MV_EXIT_MSR_ERROR).is_pos()) {
+                auto const ret{
+                    this->reg_write(mut_sys, mv::mv_reg_t_rip, mk::bf_reg_t_rip, m_msr_exit_rip)};
+                if (bsl::unlikely(!ret)) {
+                    bsl::print<bsl::V>() << bsl::here();
+                    return ret;
+                }
+
+                return this->inject_gpf(mut_sys);
+            }
+
+            if (hypercall::MV_EXIT_MSR_WRITE == type) {
+                return bsl::errc_success;
+            }
+
+            auto const val{bsl::to_u64(exit.msr.val)};
+            auto const rax{(val & lo_mask).checked()};
+            auto const rdx{(val >> hi_shft).checked()};
+
+            auto const ret{this->reg_write(mut_sys, mv::mv_reg_t_rax, mk::bf_reg_t_rax, rax)};
+            if (bsl::unlikely(!ret)) {
+                bsl::print<bsl::V>() << bsl::here();
+                return ret;
+            }
+
+            return this->reg_write(mut_sys, mv::mv_reg_t_rdx, mk::bf_reg_t_rdx, rdx);
+        }
+
+        /// <!-- description -->
+        ///   @brief Writes all of the registers that were set while this
+        ///     vs_t was not active back to the microkernel and empties the
+        ///     register cache. This must be called before this vs_t is
+        ///     run. Each register is written once no matter how many times
+        ///     it was set, which is what saves the writes made by
+        ///     init_as_16bit_guest that userspace overwrites with
+        ///     KVM_SET_REGS/KVM_SET_SREGS/KVM_SET_MSRS before the first run.
+        ///     There is no batched microkernel write, so the remaining
+        ///     writes are still one bf_vs_op_write each.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param mut_sys the bf_syscall_t to use
+        ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+        ///     and friends otherwise
+        ///
+        [[nodiscard]] constexpr auto
+        reg_flush(syscall::bf_syscall_t &mut_sys) noexcept -> bsl::errc_type
+        {
+            bsl::expects(allocated_status_t::allocated == m_allocated);
+            bsl::expects(running_status_t::running != m_status);
+            bsl::expects(mut_sys.bf_tls_ppid() == this->assigned_pp());
+
+            if (!m_reg_any_dirty) {
+                return bsl::errc_success;
+            }
+
+            for (bsl::safe_idx mut_i{}; mut_i < m_reg_dirty.size(); ++mut_i) {
+                if (*m_reg_dirty.at_if(mut_i)) {
+                    auto const bf_reg{*m_reg_idxs.at_if(mut_i)};
+                    auto const val{*m_reg_vals.at_if(mut_i)};
+
+                    auto const ret{mut_sys.bf_vs_op_write(this->id(), bf_reg, val)};
+                    if (bsl::unlikely(!ret)) {
+                        bsl::print<bsl::V>() << bsl::here();
+                        return ret;
+                    }
+
+                    bsl::touch();
+                }
+                else {
+                    bsl::touch();
+                }
+            }
+
+            m_reg_vals = {};
+            m_reg_idxs = {};
+            m_reg_dirty = {};
+            m_reg_any_dirty = {};
+
+            return bsl::errc_success;
+        }
+
+        /// <!-- description -->
+        ///   @brief Returns this vs_t's FPU state in the provided "page".
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param sys the bf_syscall_t to use
+        ///   @param mut_page the shared page to store the FPU state.
+        ///
+        constexpr void
+        fpu_get_all(syscall::bf_syscall_t const &sys, page_4k_t &mut_page) const noexcept
+        {
+            bsl::expects(allocated_status_t::allocated == m_allocated);
+            bsl::expects(running_status_t::running != m_status);
+            bsl::expects(sys.bf_tls_ppid() == this->assigned_pp());
+
+            auto mut_legacy{m_xsave->legacy};
+            auto const xstate_bv{bsl::to_u64(m_xsave->xstate_bv)};
+
+            /// NOTE:
+            /// - XSAVEOPT does not write state components that are in their
+            ///   init state. Instead, their XSTATE_BV bit is cleared, which
+            ///   means the legacy region might be stale for these, and the
+            ///   init state has to be reported instead.
+            ///
+
+            if ((xstate_bv & XSAVE_X87).is_zero()) {
+                auto *const pmut_fcw{mut_legacy.at_if(bsl::to_idx(XSAVE_FCW_OFFSET))};
+                auto *const pmut_env{mut_legacy.at_if(bsl::to_idx(XSAVE_X87_ENV_OFFSET))};
+                auto *const pmut_st{mut_legacy.at_if(bsl::to_idx(XSAVE_ST_OFFSET))};
+
+                bsl::builtin_memcpy(pmut_fcw, XSAVE_FCW_INIT.data(), XSAVE_FCW_SIZE);
+                bsl::builtin_memset(pmut_env, '\0', XSAVE_X87_ENV_SIZE);
+                bsl::builtin_memset(pmut_st, '\0', XSAVE_ST_SIZE);
+            }
+            else {
+                bsl::touch();
+            }
+
+            if ((xstate_bv & XSAVE_SSE).is_zero()) {
+                auto *const pmut_xmm{mut_legacy.at_if(bsl::to_idx(XSAVE_XMM_OFFSET))};
+                bsl::builtin_memset(pmut_xmm, '\0', XSAVE_XMM_SIZE);
+            }
+            else {
+                bsl::touch();
+            }
+
+            bsl::builtin_memcpy(&mut_page, mut_legacy.data(), XSAVE_LEGACY_SIZE);
+        }
+
+        /// <!-- description -->
+        ///   @brief Sets this vs_t's FPU state to the provided
+        ///     contents stored in "page".
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param sys the bf_syscall_t to use
+        ///   @param page the shared page containing the state to set this
+        ///     vs_t's FPU state to.
+        ///
+        constexpr void
+        fpu_set_all(syscall::bf_syscall_t const &sys, page_4k_t const &page) noexcept
+        {
+            bsl::expects(allocated_status_t::allocated == m_allocated);
+            bsl::expects(running_status_t::running != m_status);
+            bsl::expects(sys.bf_tls_ppid() == this->assigned_pp());
+
+            bsl::builtin_memcpy(m_xsave->legacy.data(), &page, XSAVE_LEGACY_SIZE);
+
+            /// NOTE:
+            /// - XRSTOR puts any state component whose XSTATE_BV bit is
+            ///   clear into its init state, ignoring what is in the legacy
+            ///   region, so the x87 and SSE bits have to be set.
+            ///
+
+            m_xsave->xstate_bv |= XSAVE_LEGACY.get();
+        }
+
+        /// <!-- description -->
+        ///   @brief Injects an exception into the vs_t. Unlike interrupts,
+        ///     exceptions cannot be masked, and therefore, the exception is
+        ///     immediately injected.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param mut_sys the bf_syscall_t to use
+        ///   @param vector the vector to inject
+        ///   @param ec the error code to inject
+        ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+        ///     and friends otherwise.
+        ///
+        [[nodiscard]] constexpr auto
+        inject_exception(
+            syscall::bf_syscall_t &mut_sys,
+            bsl::safe_u64 const &vector,
+            bsl::safe_u64 const &ec) noexcept -> bsl::errc_type
+        {
+            constexpr auto idx{syscall::bf_reg_t::bf_reg_t_eventinj};
 
             constexpr auto vector_mask{0xFF_u64};
             constexpr auto divide_by_zero_error{0x80000300_u64};
@@ -1928,6 +2974,61 @@ namespace microv
 
             return m_interrupt_queue.push(vector);
         }
+
+        /// <!-- description -->
+        ///   @brief Pushes a dirty gfn to the dirty ring of this vs_t. This
+        ///     should only be called from the PP this vs_t is running on,
+        ///     while handling a write to a dirty logged page. Returns true
+        ///     if the dirty ring is full after the push, in which case the
+        ///     caller must return to software so that the dirty ring can be
+        ///     harvested before the vs_t is allowed to run again.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param gfn the dirty gfn to push
+        ///   @return Returns true if the dirty ring is full, false otherwise
+        ///
+        [[nodiscard]] constexpr auto
+        dirty_ring_push(hypercall::mv_dirty_gfn_t const &gfn) noexcept -> bool
+        {
+            bsl::expects(allocated_status_t::allocated == m_allocated);
+
+            /// NOTE:
+            /// - The dirty ring is never allowed to overflow as the caller
+            ///   exits to software once it is full, and the vs_t cannot run
+            ///   again until it has been drained.
+            ///
+
+            bsl::expects(m_dirty_ring.push(gfn));
+            return m_dirty_ring.full();
+        }
+
+        /// <!-- description -->
+        ///   @brief Moves entries from the dirty ring of this vs_t into the
+        ///     provided mv_dirty_ring_t. On input, num_entries is the max
+        ///     number of entries to move. On output, num_entries is the
+        ///     number of entries that were moved.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param mut_ring the mv_dirty_ring_t to move the entries into
+        ///
+        constexpr void
+        dirty_ring_get(hypercall::mv_dirty_ring_t &mut_ring) noexcept
+        {
+            bsl::expects(allocated_status_t::allocated == m_allocated);
+            bsl::expects(running_status_t::running != m_status);
+            bsl::expects(mut_ring.num_entries <= mut_ring.entries.size());
+
+            bsl::safe_idx mut_i{};
+            for (; mut_i < mut_ring.num_entries; ++mut_i) {
+                if (m_dirty_ring.empty()) {
+                    break;
+                }
+
+                bsl::expects(m_dirty_ring.pop(*mut_ring.entries.at_if(mut_i)));
+            }
+
+            mut_ring.num_entries = mut_i.get();
+        }
     };
 }
 
@@ -0,0 +1,181 @@
+/// @copyright
+/// Copyright (C) 2020 Assured Information Security, Inc.
+///
+/// @copyright
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// @copyright
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// @copyright
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+
+
+#ifndef CLOCK_SCALE_T_HPP
+#define CLOCK_SCALE_T_HPP
+
+#include <bsl/convert.hpp>
+#include <bsl/cstdint.hpp>
+#include <bsl/expects.hpp>
+#include <bsl/safe_integral.hpp>
+#include <bsl/touch.hpp>
+
+namespace microv
+{
+    /// @brief defines the number of nanoseconds in a second
+    constexpr auto NSEC_PER_SEC{1000000000_u64};
+    /// @brief defines the number of hertz in a kilohertz
+    constexpr auto HZ_PER_KHZ{1000_u64};
+
+    /// @struct microv::clock_scale_t
+    ///
+    /// <!-- description -->
+    ///   @brief Stores the multiplier and shift used to convert ticks
+    ///     of one clock into ticks of another clock. This uses the same
+    ///     format as the pvclock ABI (tsc_to_system_mul/tsc_shift), so
+    ///     the guest performs the exact same conversion that we do.
+    ///
+    struct clock_scale_t final
+    {
+        /// @brief stores the 0.32 fixed point multiplier
+        bsl::uint32 mul;
+        /// @brief stores the power of 2 applied to the ticks before the multiply
+        bsl::int8 shift;
+    };
+
+    /// <!-- description -->
+    ///   @brief Returns (a * b) >> shft, using a 128 bit intermediate
+    ///     so that the multiply cannot overflow. The result is truncated
+    ///     to 64 bits.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param a the first value to multiply
+    ///   @param b the second value to multiply
+    ///   @param shft the number of bits to shift the product right by.
+    ///     Must be between 1 and 63.
+    ///   @return Returns (a * b) >> shft
+    ///
+    [[nodiscard]] constexpr auto
+    mul_shr(bsl::safe_u64 const &a, bsl::safe_u64 const &b, bsl::safe_u64 const &shft) noexcept
+        -> bsl::safe_u64
+    {
+        constexpr auto bits{64_u64};
+        constexpr auto half{32_u64};
+        constexpr auto mask{0x00000000FFFFFFFF_u64};
+
+        bsl::expects(shft.is_pos());
+        bsl::expects(shft < bits);
+
+        auto const a_lo{(a & mask).checked()};
+        auto const a_hi{(a >> half).checked()};
+        auto const b_lo{(b & mask).checked()};
+        auto const b_hi{(b >> half).checked()};
+
+        /// NOTE:
+        /// - Each partial product is a 32x32 multiply, which cannot
+        ///   overflow a 64 bit integer, and neither can the sum of the
+        ///   middle terms below, as each is at most 32 bits.
+        ///
+
+        auto const ll{(a_lo * b_lo).checked()};
+        auto const lh{(a_lo * b_hi).checked()};
+        auto const hl{(a_hi * b_lo).checked()};
+        auto const hh{(a_hi * b_hi).checked()};
+
+        auto const mid{((ll >> half) + (lh & mask) + (hl & mask)).checked()};
+        auto const lo{((ll & mask) | ((mid & mask) << half)).checked()};
+        auto const hi{(hh + (lh >> half) + (hl >> half) + (mid >> half)).checked()};
+
+        return ((lo >> shft) | (hi << (bits - shft))).checked();
+    }
+
+    /// <!-- description -->
+    ///   @brief Returns the clock_scale_t that converts ticks of a clock
+    ///     running at base_hz into ticks of a clock running at scaled_hz.
+    ///     This is the same algorithm that KVM uses to fill in the pvclock
+    ///     structure, which normalizes base_hz into a 32 bit value that
+    ///     is larger than scaled_hz so that the resulting multiplier is
+    ///     a 0.32 fixed point fraction.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param base_hz the frequency of the clock being converted from
+    ///   @param scaled_hz the frequency of the clock being converted to
+    ///   @return Returns the resulting clock_scale_t
+    ///
+    [[nodiscard]] constexpr auto
+    make_clock_scale(bsl::safe_u64 const &base_hz, bsl::safe_u64 const &scaled_hz) noexcept
+        -> clock_scale_t
+    {
+        constexpr auto half{32_u64};
+        constexpr auto upper{0xFFFFFFFF00000000_u64};
+        constexpr auto top{0x0000000080000000_u64};
+
+        bsl::expects(base_hz.is_pos());
+        bsl::expects(scaled_hz.is_pos());
+        bsl::expects(scaled_hz < (upper >> bsl::safe_u64::magic_1()).checked());
+
+        auto mut_base{base_hz};
+        auto mut_scaled{scaled_hz};
+        bsl::safe_i32 mut_shift{};
+
+        while (mut_base > (mut_scaled << bsl::safe_u64::magic_1()) || (mut_base & upper).is_pos()) {
+            mut_base >>= bsl::safe_u64::magic_1();
+            --mut_shift;
+        }
+
+        while (mut_base <= mut_scaled || (mut_scaled & upper).is_pos()) {
+            if ((mut_scaled & upper).is_pos() || (mut_base & top).is_pos()) {
+                mut_scaled >>= bsl::safe_u64::magic_1();
+            }
+            else {
+                mut_base <<= bsl::safe_u64::magic_1();
+            }
+
+            ++mut_shift;
+        }
+
+        auto const mul{((mut_scaled << half) / mut_base).checked()};
+        return {bsl::to_u32_unsafe(mul).get(), static_cast<bsl::int8>(mut_shift.checked().get())};
+    }
+
+    /// <!-- description -->
+    ///   @brief Converts the provided ticks using the provided
+    ///     clock_scale_t (see make_clock_scale). This matches the
+    ///     conversion that the guest performs (pvclock_scale_delta).
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param ticks the ticks to convert
+    ///   @param scale the clock_scale_t to convert the ticks with
+    ///   @return Returns the converted ticks
+    ///
+    [[nodiscard]] constexpr auto
+    scale_clock(bsl::safe_u64 const &ticks, clock_scale_t const &scale) noexcept -> bsl::safe_u64
+    {
+        constexpr auto half{32_u64};
+        constexpr bsl::int8 zero{};
+
+        auto mut_ticks{ticks};
+        if (scale.shift < zero) {
+            mut_ticks >>= bsl::safe_u64{static_cast<bsl::uint64>(-scale.shift)};
+        }
+        else {
+            mut_ticks <<= bsl::safe_u64{static_cast<bsl::uint64>(scale.shift)};
+        }
+
+        return mul_shr(mut_ticks, bsl::to_u64(scale.mul), half);
+    }
+}
+
+#endif
@@ -28,6 +28,7 @@
 #include <bf_syscall_t.hpp>
 #include <gs_t.hpp>
 #include <intrinsic_t.hpp>
+#include <mv_exit_reason_t.hpp>
 #include <page_pool_t.hpp>
 #include <pp_pool_t.hpp>
 #include <tls_t.hpp>
@@ -36,25 +37,29 @@
 #include <vs_pool_t.hpp>
 
 #include <bsl/convert.hpp>
-#include <bsl/debug.hpp>
 #include <bsl/discard.hpp>
 #include <bsl/errc_type.hpp>
+#include <bsl/expects.hpp>
+#include <bsl/safe_integral.hpp>
 
 namespace microv
 {
     /// <!-- description -->
-    ///   @brief Dispatches HLT VMExits.
+    ///   @brief Dispatches HLT VMExits. The guest has nothing to do, which
+    ///     makes this a good time to add a page to the PP's pre-zeroed
+    ///     pages before returning to the root VM, so that later allocations
+    ///     (for example while creating a VM) do not have to zero them.
     ///
     /// <!-- inputs/outputs -->
     ///   @param gs the gs_t to use
-    ///   @param tls the tls_t to use
+    ///   @param mut_tls the tls_t to use
     ///   @param mut_sys the bf_syscall_t to use
-    ///   @param page_pool the page_pool_t to use
+    ///   @param mut_page_pool the page_pool_t to use
     ///   @param intrinsic the intrinsic_t to use
-    ///   @param pp_pool the pp_pool_t to use
-    ///   @param vm_pool the vm_pool_t to use
-    ///   @param vp_pool the vp_pool_t to use
-    ///   @param vs_pool the vs_pool_t to use
+    ///   @param mut_pp_pool the pp_pool_t to use
+    ///   @param mut_vm_pool the vm_pool_t to use
+    ///   @param mut_vp_pool the vp_pool_t to use
+    ///   @param mut_vs_pool the vs_pool_t to use
     ///   @param vsid the ID of the VS that generated the VMExit
     ///   @return Returns bsl::errc_success on success, bsl::errc_failure
     ///     and friends otherwise
@@ -62,29 +67,49 @@ namespace microv
     [[nodiscard]] constexpr auto
     dispatch_vmexit_hlt(
         gs_t const &gs,
-        tls_t const &tls,
+        tls_t &mut_tls,
         syscall::bf_syscall_t &mut_sys,
-        page_pool_t const &page_pool,
+        page_pool_t &mut_page_pool,
         intrinsic_t const &intrinsic,
-        pp_pool_t const &pp_pool,
-        vm_pool_t const &vm_pool,
-        vp_pool_t const &vp_pool,
-        vs_pool_t const &vs_pool,
+        pp_pool_t &mut_pp_pool,
+        vm_pool_t &mut_vm_pool,
+        vp_pool_t &mut_vp_pool,
+        vs_pool_t &mut_vs_pool,
         bsl::safe_u16 const &vsid) noexcept -> bsl::errc_type
     {
         bsl::discard(gs);
-        bsl::discard(tls);
-        bsl::discard(mut_sys);
-        bsl::discard(page_pool);
-        bsl::discard(intrinsic);
-        bsl::discard(pp_pool);
-        bsl::discard(vm_pool);
-        bsl::discard(vp_pool);
-        bsl::discard(vs_pool);
-        bsl::discard(vsid);
 
-        bsl::error() << "dispatch_vmexit_hlt not implemented\n" << bsl::here();
-        return bsl::errc_failure;
+        bsl::expects(!mut_sys.is_the_active_vm_the_root_vm());
+
+        // ---------------------------------------------------------------------
+        // Context: Guest VM
+        // ---------------------------------------------------------------------
+
+        mut_page_pool.prezero(mut_tls, mut_sys);
+
+        /// NOTE:
+        /// - The root VM will not run this VS again until it is woken up,
+        ///   so the guest is told that the VS is preempted. This lets the
+        ///   guest skip TLB shootdown IPIs to the VS, which would only
+        ///   wake it up (see emulated_steal_time_t).
+        ///
+
+        mut_vs_pool.steal_time_preempt(mut_tls, mut_sys, mut_pp_pool, mut_vm_pool, intrinsic, vsid);
+
+        // ---------------------------------------------------------------------
+        // Context: Change To Root VM
+        // ---------------------------------------------------------------------
+
+        switch_to_root(mut_tls, mut_sys, intrinsic, mut_vm_pool, mut_vp_pool, mut_vs_pool);
+
+        // ---------------------------------------------------------------------
+        // Context: Root VM
+        // ---------------------------------------------------------------------
+
+        set_reg_return(mut_sys, hypercall::MV_STATUS_SUCCESS);
+        set_reg0(mut_sys, bsl::to_u64(hypercall::EXIT_REASON_HLT));
+
+        return vmexit_success_advance_ip_and_run;
     }
 }
 
@@ -52,7 +52,7 @@ namespace microv
     ///   @param mut_sys the bf_syscall_t to use
     ///   @param page_pool the page_pool_t to use
     ///   @param intrinsic the intrinsic_t to use
-    ///   @param pp_pool the pp_pool_t to use
+    ///   @param mut_pp_pool the pp_pool_t to use
     ///   @param mut_vm_pool the vm_pool_t to use
     ///   @param mut_vp_pool the vp_pool_t to use
     ///   @param mut_vs_pool the vs_pool_t to use
@@ -67,7 +67,7 @@ namespace microv
         syscall::bf_syscall_t &mut_sys,
         page_pool_t const &page_pool,
         intrinsic_t const &intrinsic,
-        pp_pool_t const &pp_pool,
+        pp_pool_t &mut_pp_pool,
         vm_pool_t &mut_vm_pool,
         vp_pool_t &mut_vp_pool,
         vs_pool_t &mut_vs_pool,
@@ -75,8 +75,6 @@ namespace microv
     {
         bsl::discard(gs);
         bsl::discard(page_pool);
-        bsl::discard(pp_pool);
-        bsl::discard(vsid);
 
         bsl::expects(!mut_sys.is_the_active_vm_the_root_vm());
 
@@ -100,8 +98,14 @@ namespace microv
         ///   into the root VM. If ack on exit is disabled, the AMD approach
         ///   works, allowing us to simply return to the root VM and let it
         ///   handle the interrupt the same way AMD would.
+        /// - Once the root VM has the PP, it is free to schedule something
+        ///   other than this VS, so the guest is told that the VS is
+        ///   preempted. This lets the guest skip TLB shootdown IPIs to
+        ///   the VS (see emulated_steal_time_t).
         ///
 
+        mut_vs_pool.steal_time_preempt(mut_tls, mut_sys, mut_pp_pool, mut_vm_pool, intrinsic, vsid);
+
         // ---------------------------------------------------------------------
         // Context: Change To Root VM
         // ---------------------------------------------------------------------
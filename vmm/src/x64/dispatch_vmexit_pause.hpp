@@ -0,0 +1,124 @@
+/// @copyright
+/// Copyright (C) 2020 Assured Information Security, Inc.
+///
+/// @copyright
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// @copyright
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// @copyright
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+
+
+#ifndef DISPATCH_VMEXIT_PAUSE_HPP
+#define DISPATCH_VMEXIT_PAUSE_HPP
+
+#include <bf_syscall_t.hpp>
+#include <gs_t.hpp>
+#include <intrinsic_t.hpp>
+#include <mv_exit_reason_t.hpp>
+#include <page_pool_t.hpp>
+#include <pp_pool_t.hpp>
+#include <tls_t.hpp>
+#include <vm_pool_t.hpp>
+#include <vp_pool_t.hpp>
+#include <vs_pool_t.hpp>
+
+#include <bsl/convert.hpp>
+#include <bsl/discard.hpp>
+#include <bsl/errc_type.hpp>
+#include <bsl/expects.hpp>
+#include <bsl/safe_integral.hpp>
+
+namespace microv
+{
+    /// <!-- description -->
+    ///   @brief Dispatches PAUSE VMExits. These only occur once the guest
+    ///     has been spinning in a PAUSE loop for longer than allowed (see
+    ///     MICROV_PLE_WINDOW and MICROV_PAUSE_FILTER_COUNT), which usually
+    ///     means that it is waiting on a lock held by a VS of the same VM
+    ///     that is not running. Spinning any longer would only waste the
+    ///     rest of the time slice, so the root VM is told to give it to
+    ///     someone else.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param gs the gs_t to use
+    ///   @param mut_tls the tls_t to use
+    ///   @param mut_sys the bf_syscall_t to use
+    ///   @param page_pool the page_pool_t to use
+    ///   @param intrinsic the intrinsic_t to use
+    ///   @param mut_pp_pool the pp_pool_t to use
+    ///   @param mut_vm_pool the vm_pool_t to use
+    ///   @param mut_vp_pool the vp_pool_t to use
+    ///   @param mut_vs_pool the vs_pool_t to use
+    ///   @param vsid the ID of the VS that generated the VMExit
+    ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+    ///     and friends otherwise
+    ///
+    [[nodiscard]] constexpr auto
+    dispatch_vmexit_pause(
+        gs_t const &gs,
+        tls_t &mut_tls,
+        syscall::bf_syscall_t &mut_sys,
+        page_pool_t const &page_pool,
+        intrinsic_t const &intrinsic,
+        pp_pool_t &mut_pp_pool,
+        vm_pool_t &mut_vm_pool,
+        vp_pool_t &mut_vp_pool,
+        vs_pool_t &mut_vs_pool,
+        bsl::safe_u16 const &vsid) noexcept -> bsl::errc_type
+    {
+        bsl::discard(gs);
+        bsl::discard(page_pool);
+
+        bsl::expects(!mut_sys.is_the_active_vm_the_root_vm());
+
+        // ---------------------------------------------------------------------
+        // Context: Guest VM
+        // ---------------------------------------------------------------------
+
+        /// NOTE:
+        /// - A PAUSE loop exit happens in the middle of a spin loop, not
+        ///   after a completed instruction, so the guest's IP is not
+        ///   advanced. When the VS is run again, the guest simply executes
+        ///   the PAUSE again and keeps spinning.
+        /// - The root VM is about to give this VS's time slice away, so
+        ///   the guest is told that the VS is preempted (see
+        ///   emulated_steal_time_t).
+        ///
+
+        mut_vs_pool.steal_time_preempt(mut_tls, mut_sys, mut_pp_pool, mut_vm_pool, intrinsic, vsid);
+
+        // ---------------------------------------------------------------------
+        // Context: Change To Root VM
+        // ---------------------------------------------------------------------
+
+        constexpr auto advance_ip{false};
+        switch_to_root(
+            mut_tls, mut_sys, intrinsic, mut_vm_pool, mut_vp_pool, mut_vs_pool, advance_ip);
+
+        // ---------------------------------------------------------------------
+        // Context: Root VM
+        // ---------------------------------------------------------------------
+
+        set_reg_return(mut_sys, hypercall::MV_STATUS_SUCCESS);
+        set_reg0(mut_sys, bsl::to_u64(hypercall::EXIT_REASON_PAUSE));
+
+        return vmexit_success_advance_ip_and_run;
+    }
+}
+
+#endif
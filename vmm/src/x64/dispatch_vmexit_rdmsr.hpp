@@ -26,8 +26,13 @@
 #define DISPATCH_VMEXIT_RDMSR_HPP
 
 #include <bf_syscall_t.hpp>
+#include <dispatch_abi_helpers.hpp>
+#include <errc_types.hpp>
 #include <gs_t.hpp>
 #include <intrinsic_t.hpp>
+#include <mv_constants.hpp>
+#include <mv_exit_msr_t.hpp>
+#include <mv_exit_reason_t.hpp>
 #include <page_pool_t.hpp>
 #include <pp_pool_t.hpp>
 #include <tls_t.hpp>
@@ -39,22 +44,27 @@
 #include <bsl/debug.hpp>
 #include <bsl/discard.hpp>
 #include <bsl/errc_type.hpp>
+#include <bsl/unlikely.hpp>
 
 namespace microv
 {
     /// <!-- description -->
-    ///   @brief Dispatches RDMSR VMExits.
+    ///   @brief Dispatches RDMSR VMExits. If the guest VM filters reads
+    ///     of the MSR (see mv_vm_op_msr_filter), the access is returned to
+    ///     software using mv_exit_reason_t_msr, otherwise it is handled
+    ///     using the MSR state of the VS (see emulated_msr_t). Accesses the
+    ///     VS cannot perform (e.g., to an unknown MSR) inject a GPF.
     ///
     /// <!-- inputs/outputs -->
     ///   @param gs the gs_t to use
-    ///   @param tls the tls_t to use
+    ///   @param mut_tls the tls_t to use
     ///   @param mut_sys the bf_syscall_t to use
     ///   @param page_pool the page_pool_t to use
     ///   @param intrinsic the intrinsic_t to use
-    ///   @param pp_pool the pp_pool_t to use
-    ///   @param vm_pool the vm_pool_t to use
-    ///   @param vp_pool the vp_pool_t to use
-    ///   @param vs_pool the vs_pool_t to use
+    ///   @param mut_pp_pool the pp_pool_t to use
+    ///   @param mut_vm_pool the vm_pool_t to use
+    ///   @param mut_vp_pool the vp_pool_t to use
+    ///   @param mut_vs_pool the vs_pool_t to use
     ///   @param vsid the ID of the VS that generated the VMExit
     ///   @return Returns bsl::errc_success on success, bsl::errc_failure
     ///     and friends otherwise
@@ -62,29 +72,77 @@ namespace microv
     [[nodiscard]] constexpr auto
     dispatch_vmexit_rdmsr(
         gs_t const &gs,
-        tls_t const &tls,
+        tls_t &mut_tls,
         syscall::bf_syscall_t &mut_sys,
         page_pool_t const &page_pool,
         intrinsic_t const &intrinsic,
-        pp_pool_t const &pp_pool,
-        vm_pool_t const &vm_pool,
-        vp_pool_t const &vp_pool,
-        vs_pool_t const &vs_pool,
+        pp_pool_t &mut_pp_pool,
+        vm_pool_t &mut_vm_pool,
+        vp_pool_t &mut_vp_pool,
+        vs_pool_t &mut_vs_pool,
         bsl::safe_u16 const &vsid) noexcept -> bsl::errc_type
     {
         bsl::discard(gs);
-        bsl::discard(tls);
-        bsl::discard(mut_sys);
         bsl::discard(page_pool);
-        bsl::discard(intrinsic);
-        bsl::discard(pp_pool);
-        bsl::discard(vm_pool);
-        bsl::discard(vp_pool);
-        bsl::discard(vs_pool);
-        bsl::discard(vsid);
-
-        bsl::error() << "dispatch_vmexit_rdmsr not implemented\n" << bsl::here();
-        return bsl::errc_failure;
+
+        if (bsl::unlikely(mut_sys.is_the_active_vm_the_root_vm())) {
+            bsl::error() << "dispatch_vmexit_rdmsr not implemented for the root VM\n"
+                         << bsl::here();
+            return bsl::errc_failure;
+        }
+
+        // ---------------------------------------------------------------------
+        // Context: Guest VM
+        // ---------------------------------------------------------------------
+
+        constexpr auto msr_mask{0x00000000FFFFFFFF_u64};
+        constexpr auto msr_shft{32_u64};
+
+        auto const msr{bsl::to_u32_unsafe(mut_sys.bf_tls_rcx() & msr_mask)};
+
+        if (mut_vm_pool.is_msr_filtered(mut_sys.bf_tls_vmid(), msr, hypercall::MV_PERM_READ)) {
+            mut_vs_pool.msr_exit_begin(mut_sys, msr, hypercall::MV_EXIT_MSR_READ, vsid);
+
+            // -----------------------------------------------------------------
+            // Context: Change To Root VM
+            // -----------------------------------------------------------------
+
+            switch_to_root(mut_tls, mut_sys, intrinsic, mut_vm_pool, mut_vp_pool, mut_vs_pool);
+
+            // -----------------------------------------------------------------
+            // Context: Root VM
+            // -----------------------------------------------------------------
+
+            auto mut_exit_msr{mut_pp_pool.shared_page<hypercall::mv_exit_msr_t>(mut_sys)};
+            bsl::expects(mut_exit_msr.is_valid());
+
+            mut_exit_msr->msr.reg = bsl::to_u64(msr).get();
+            mut_exit_msr->msr.val = {};
+            mut_exit_msr->flags = hypercall::MV_EXIT_MSR_READ.get();
+
+            set_reg_return(mut_sys, hypercall::MV_STATUS_SUCCESS);
+            set_reg0(mut_sys, bsl::to_u64(hypercall::EXIT_REASON_MSR));
+
+            return vmexit_success_advance_ip_and_run;
+        }
+
+        auto const val{mut_vs_pool.msr_get(mut_sys, msr, vsid)};
+        if (bsl::unlikely(val.is_invalid())) {
+            bsl::print<bsl::V>() << bsl::here();
+
+            auto const gpf_ret{mut_vs_pool.inject_gpf(mut_sys, vsid)};
+            if (bsl::unlikely(!gpf_ret)) {
+                bsl::print<bsl::V>() << bsl::here();
+                return bsl::errc_failure;
+            }
+
+            return vmexit_success_run;
+        }
+
+        mut_sys.bf_tls_set_rax(val & msr_mask);
+        mut_sys.bf_tls_set_rdx(val >> msr_shft);
+
+        return vmexit_success_advance_ip_and_run;
     }
 }
 
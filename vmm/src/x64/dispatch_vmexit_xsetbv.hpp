@@ -0,0 +1,132 @@
+/// @copyright
+/// Copyright (C) 2020 Assured Information Security, Inc.
+///
+/// @copyright
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// @copyright
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// @copyright
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+
+#ifndef DISPATCH_VMEXIT_XSETBV_HPP
+#define DISPATCH_VMEXIT_XSETBV_HPP
+
+#include <bf_syscall_t.hpp>
+#include <errc_types.hpp>
+#include <gs_t.hpp>
+#include <intrinsic_t.hpp>
+#include <page_pool_t.hpp>
+#include <pp_pool_t.hpp>
+#include <tls_t.hpp>
+#include <vm_pool_t.hpp>
+#include <vp_pool_t.hpp>
+#include <vs_pool_t.hpp>
+
+#include <bsl/convert.hpp>
+#include <bsl/debug.hpp>
+#include <bsl/discard.hpp>
+#include <bsl/errc_type.hpp>
+#include <bsl/touch.hpp>
+#include <bsl/unlikely.hpp>
+
+namespace microv
+{
+    /// <!-- description -->
+    ///   @brief Dispatches XSETBV VMExits. The guest's XCR0 decides which
+    ///     state components are switched between the root VS and the
+    ///     guest VS (see run_guest), so every change to it has to be seen
+    ///     by MicroV instead of going straight to the hardware. Writes the
+    ///     CPU would reject inject a GPF.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param gs the gs_t to use
+    ///   @param mut_tls the tls_t to use
+    ///   @param mut_sys the bf_syscall_t to use
+    ///   @param page_pool the page_pool_t to use
+    ///   @param intrinsic the intrinsic_t to use
+    ///   @param pp_pool the pp_pool_t to use
+    ///   @param vm_pool the vm_pool_t to use
+    ///   @param vp_pool the vp_pool_t to use
+    ///   @param mut_vs_pool the vs_pool_t to use
+    ///   @param vsid the ID of the VS that generated the VMExit
+    ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+    ///     and friends otherwise
+    ///
+    [[nodiscard]] constexpr auto
+    dispatch_vmexit_xsetbv(
+        gs_t const &gs,
+        tls_t &mut_tls,
+        syscall::bf_syscall_t &mut_sys,
+        page_pool_t const &page_pool,
+        intrinsic_t const &intrinsic,
+        pp_pool_t const &pp_pool,
+        vm_pool_t const &vm_pool,
+        vp_pool_t const &vp_pool,
+        vs_pool_t &mut_vs_pool,
+        bsl::safe_u16 const &vsid) noexcept -> bsl::errc_type
+    {
+        bsl::discard(gs);
+        bsl::discard(page_pool);
+        bsl::discard(pp_pool);
+        bsl::discard(vm_pool);
+        bsl::discard(vp_pool);
+
+        if (bsl::unlikely(mut_sys.is_the_active_vm_the_root_vm())) {
+            bsl::error() << "dispatch_vmexit_xsetbv not implemented for the root VM\n"
+                         << bsl::here();
+            return bsl::errc_failure;
+        }
+
+        // ---------------------------------------------------------------------
+        // Context: Guest VM
+        // ---------------------------------------------------------------------
+
+        constexpr auto xcr_mask{0x00000000FFFFFFFF_u64};
+        constexpr auto xcr_shft{32_u64};
+
+        auto const xcr{mut_sys.bf_tls_rcx() & xcr_mask};
+        auto const val{
+            ((mut_sys.bf_tls_rdx() << xcr_shft) | (mut_sys.bf_tls_rax() & xcr_mask)).checked()};
+
+        /// NOTE:
+        /// - XCR0 is the only XCR that can be written, anything else is a
+        ///   GPF, just like an invalid XCR0.
+        ///
+
+        bsl::errc_type mut_ret{bsl::errc_failure};
+        if (xcr.is_zero()) {
+            mut_ret = mut_vs_pool.xcr0_set(mut_tls, mut_sys, intrinsic, val, vsid);
+        }
+        else {
+            bsl::touch();
+        }
+
+        if (bsl::unlikely(!mut_ret)) {
+            auto const gpf_ret{mut_vs_pool.inject_gpf(mut_sys, vsid)};
+            if (bsl::unlikely(!gpf_ret)) {
+                bsl::print<bsl::V>() << bsl::here();
+                return bsl::errc_failure;
+            }
+
+            return vmexit_success_run;
+        }
+
+        return vmexit_success_advance_ip_and_run;
+    }
+}
+
+#endif
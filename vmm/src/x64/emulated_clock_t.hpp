@@ -0,0 +1,558 @@
+/// @copyright
+/// Copyright (C) 2020 Assured Information Security, Inc.
+///
+/// @copyright
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// @copyright
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// @copyright
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+
+
+#ifndef EMULATED_CLOCK_T_HPP
+#define EMULATED_CLOCK_T_HPP
+
+#include <bf_syscall_t.hpp>
+#include <clock_scale_t.hpp>
+#include <gs_t.hpp>
+#include <intrinsic_t.hpp>
+#include <msr_constants.hpp>
+#include <page_4k_t.hpp>
+#include <pp_pool_t.hpp>
+#include <tls_t.hpp>
+#include <vm_pool_t.hpp>
+
+#include <bsl/array.hpp>
+#include <bsl/convert.hpp>
+#include <bsl/cstdint.hpp>
+#include <bsl/debug.hpp>
+#include <bsl/discard.hpp>
+#include <bsl/errc_type.hpp>
+#include <bsl/safe_integral.hpp>
+#include <bsl/touch.hpp>
+#include <bsl/unlikely.hpp>
+
+namespace microv
+{
+    /// @brief defines the enable bit of MSR_KVM_SYSTEM_TIME_NEW
+    constexpr auto PVCLOCK_SYSTEM_TIME_ENABLE{0x0000000000000001_u64};
+    /// @brief defines the bits of MSR_KVM_SYSTEM_TIME_NEW that must be 0
+    constexpr auto PVCLOCK_SYSTEM_TIME_RSVD{0x000000000000001E_u64};
+    /// @brief defines the bits of MSR_KVM_WALL_CLOCK_NEW that must be 0
+    constexpr auto PVCLOCK_WALL_CLOCK_RSVD{0x0000000000000003_u64};
+    /// @brief tells the guest that the TSC is stable across all VSs
+    constexpr auto PVCLOCK_TSC_STABLE_BIT{0x01_u8};
+
+    /// @brief defines the number of pvclock_vcpu_time_info_t in a page
+    constexpr auto PVCLOCK_ENTRIES_PER_PAGE{128_umx};
+    /// @brief defines the number of 32 bit words in a page
+    constexpr auto PVCLOCK_WORDS_PER_PAGE{1024_umx};
+
+#pragma pack(push, 1)
+
+    /// @struct microv::pvclock_vcpu_time_info_t
+    ///
+    /// <!-- description -->
+    ///   @brief Defines the structure that MSR_KVM_SYSTEM_TIME_NEW points
+    ///     to. The guest computes the current value of the kvmclock as
+    ///     system_time + scale(rdtsc() - tsc_timestamp), using version to
+    ///     detect that an update occurred while it was being read.
+    ///
+    struct pvclock_vcpu_time_info_t final
+    {
+        /// @brief stores the version (odd while an update is in progress)
+        bsl::uint32 version;
+        /// @brief reserved
+        bsl::uint32 pad0;
+        /// @brief stores the guest TSC at the time of the update
+        bsl::uint64 tsc_timestamp;
+        /// @brief stores the kvmclock (in ns) at the time of the update
+        bsl::uint64 system_time;
+        /// @brief stores the multiplier that converts TSC ticks into ns
+        bsl::uint32 tsc_to_system_mul;
+        /// @brief stores the shift that converts TSC ticks into ns
+        bsl::int8 tsc_shift;
+        /// @brief stores the PVCLOCK flags
+        bsl::uint8 flags;
+        /// @brief reserved
+        bsl::array<bsl::uint8, 2_umx.get()> pad1;
+    };
+
+    /// @struct microv::pvclock_page_t
+    ///
+    /// <!-- description -->
+    ///   @brief Defines a page of pvclock_vcpu_time_info_t structures.
+    ///     The guest is free to place its structure anywhere in a page (so
+    ///     long as it is aligned), so we map the entire page and then
+    ///     index into it.
+    ///
+    struct pvclock_page_t final
+    {
+        /// @brief stores the pvclock_vcpu_time_info_t entries
+        bsl::array<pvclock_vcpu_time_info_t, PVCLOCK_ENTRIES_PER_PAGE.get()> entries;
+    };
+
+    /// @struct microv::pvclock_wall_clock_page_t
+    ///
+    /// <!-- description -->
+    ///   @brief Defines a page that contains the structure that
+    ///     MSR_KVM_WALL_CLOCK_NEW points to. The structure is made up of
+    ///     3 32 bit words (version, sec and nsec) and is only required to
+    ///     be 4 byte aligned, so it is accessed as a page of words.
+    ///
+    struct pvclock_wall_clock_page_t final
+    {
+        /// @brief stores the words in the page
+        bsl::array<bsl::uint32, PVCLOCK_WORDS_PER_PAGE.get()> words;
+    };
+
+#pragma pack(pop)
+
+    static_assert(sizeof(pvclock_page_t) == HYPERVISOR_PAGE_SIZE);
+    static_assert(sizeof(pvclock_wall_clock_page_t) == HYPERVISOR_PAGE_SIZE);
+
+    /// @class microv::emulated_clock_t
+    ///
+    /// <!-- description -->
+    ///   @brief Defines MicroV's emulated kvmclock handler.
+    ///
+    ///   @note IMPORTANT: This class is a per-VS class, and handles the
+    ///     MSR_KVM_SYSTEM_TIME_NEW and MSR_KVM_WALL_CLOCK_NEW MSRs. The
+    ///     pvclock structure is written by MicroV when the MSR is written,
+    ///     and then again before the VS is run whenever the structure is
+    ///     out of date, which happens when the VS is run on a different
+    ///     PP, the TSC of the VS is changed, or the VM's kvmclock is set.
+    ///     Between these events, the guest can read the kvmclock without
+    ///     causing a VMExit, which is what allows the guest's vDSO to
+    ///     implement clock_gettime() without a system call.
+    ///
+    class emulated_clock_t final
+    {
+        /// @brief stores the ID of the VS associated with this emulated_clock_t
+        bsl::safe_u16 m_assigned_vsid{};
+
+        /// @brief stores the value of MSR_KVM_SYSTEM_TIME_NEW
+        bsl::safe_u64 m_system_time{};
+        /// @brief stores the value of MSR_KVM_WALL_CLOCK_NEW
+        bsl::safe_u64 m_wall_clock{};
+        /// @brief stores the version last written to the pvclock structure
+        bsl::safe_u32 m_version{};
+        /// @brief stores true if the pvclock structure must be updated
+        bool m_stale{};
+        /// @brief stores true if the wall clock structure must be written
+        bool m_wall_clock_pending{};
+        /// @brief stores the ID of the PP the pvclock structure was updated on
+        bsl::safe_u16 m_updated_ppid{};
+        /// @brief stores the VM's clock generation when the pvclock was updated
+        bsl::safe_u64 m_updated_generation{};
+
+        /// <!-- description -->
+        ///   @brief Writes the wall clock structure. This tells the guest
+        ///     what the wall clock time was when the kvmclock read 0.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param tls the tls_t to use
+        ///   @param mut_sys the bf_syscall_t to use
+        ///   @param mut_pp_pool the pp_pool_t to use
+        ///   @param vm_pool the vm_pool_t to use
+        ///   @param vmid the ID of the VM this emulated_clock_t's VS belongs to
+        ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+        ///     and friends otherwise
+        ///
+        [[nodiscard]] constexpr auto
+        write_wall_clock(
+            tls_t const &tls,
+            syscall::bf_syscall_t &mut_sys,
+            pp_pool_t &mut_pp_pool,
+            vm_pool_t const &vm_pool,
+            bsl::safe_u16 const &vmid) const noexcept -> bsl::errc_type
+        {
+            constexpr auto word_size{4_u64};
+            constexpr auto num_words{3_u64};
+
+            auto const spa{vm_pool.mapped_spa(tls, mut_sys, m_wall_clock, vmid)};
+            if (bsl::unlikely(spa.is_invalid())) {
+                bsl::print<bsl::V>() << bsl::here();
+                return bsl::errc_failure;
+            }
+
+            auto const page_spa{hypercall::mv_page_aligned(spa)};
+            auto const word{((spa - page_spa) / word_size).checked()};
+            if (bsl::unlikely((word + num_words).checked() > PVCLOCK_WORDS_PER_PAGE)) {
+                bsl::error() << "the wall clock structure at "    // --
+                             << bsl::hex(m_wall_clock)            // --
+                             << " crosses a page boundary"        // --
+                             << bsl::endl                         // --
+                             << bsl::here();                      // --
+
+                return bsl::errc_failure;
+            }
+
+            auto mut_page{mut_pp_pool.map<pvclock_wall_clock_page_t>(mut_sys, page_spa)};
+            if (bsl::unlikely(mut_page.is_invalid())) {
+                bsl::print<bsl::V>() << bsl::here();
+                return bsl::errc_failure;
+            }
+
+            auto const epoch{vm_pool.clock_epoch(vmid)};
+            auto const sec{bsl::to_u32_unsafe((epoch / NSEC_PER_SEC).checked())};
+            auto const nsec{bsl::to_u32_unsafe((epoch % NSEC_PER_SEC).checked())};
+
+            auto const idx{bsl::to_idx(word)};
+            *mut_page->words.at_if(idx) = (m_version + bsl::safe_u32::magic_1()).checked().get();
+            *mut_page->words.at_if(idx + bsl::safe_idx::magic_1()) = sec.get();
+            *mut_page->words.at_if(idx + bsl::safe_idx::magic_2()) = nsec.get();
+            *mut_page->words.at_if(idx) = (m_version + bsl::safe_u32::magic_2()).checked().get();
+
+            return bsl::errc_success;
+        }
+
+    public:
+        /// <!-- description -->
+        ///   @brief Initializes this emulated_clock_t.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param gs the gs_t to use
+        ///   @param tls the tls_t to use
+        ///   @param sys the bf_syscall_t to use
+        ///   @param intrinsic the intrinsic_t to use
+        ///   @param vsid the ID of the VS associated with this emulated_clock_t
+        ///
+        constexpr void
+        initialize(
+            gs_t const &gs,
+            tls_t const &tls,
+            syscall::bf_syscall_t const &sys,
+            intrinsic_t const &intrinsic,
+            bsl::safe_u16 const &vsid) noexcept
+        {
+            bsl::expects(this->assigned_vsid() == syscall::BF_INVALID_ID);
+
+            bsl::discard(gs);
+            bsl::discard(tls);
+            bsl::discard(sys);
+            bsl::discard(intrinsic);
+
+            m_assigned_vsid = ~vsid;
+        }
+
+        /// <!-- description -->
+        ///   @brief Release the emulated_clock_t.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param gs the gs_t to use
+        ///   @param tls the tls_t to use
+        ///   @param sys the bf_syscall_t to use
+        ///   @param intrinsic the intrinsic_t to use
+        ///
+        constexpr void
+        release(
+            gs_t const &gs,
+            tls_t const &tls,
+            syscall::bf_syscall_t const &sys,
+            intrinsic_t const &intrinsic) noexcept
+        {
+            bsl::discard(gs);
+            bsl::discard(tls);
+            bsl::discard(sys);
+            bsl::discard(intrinsic);
+
+            this->reset();
+            m_assigned_vsid = {};
+        }
+
+        /// <!-- description -->
+        ///   @brief Returns the ID of the VS associated with this
+        ///     emulated_clock_t
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @return Returns the ID of the VS associated with this
+        ///     emulated_clock_t
+        ///
+        [[nodiscard]] constexpr auto
+        assigned_vsid() const noexcept -> bsl::safe_u16
+        {
+            bsl::ensures(m_assigned_vsid.is_valid_and_checked());
+            return ~m_assigned_vsid;
+        }
+
+        /// <!-- description -->
+        ///   @brief Disables the kvmclock, returning this emulated_clock_t
+        ///     to the state it was in when the VS was created.
+        ///
+        constexpr void
+        reset() noexcept
+        {
+            m_system_time = {};
+            m_wall_clock = {};
+            m_version = {};
+            m_stale = {};
+            m_wall_clock_pending = {};
+            m_updated_ppid = {};
+            m_updated_generation = {};
+        }
+
+        /// <!-- description -->
+        ///   @brief Returns true if the provided MSR is handled by this
+        ///     emulated_clock_t, false otherwise.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param msr the MSR to query
+        ///   @return Returns true if the provided MSR is handled by this
+        ///     emulated_clock_t, false otherwise.
+        ///
+        [[nodiscard]] static constexpr auto
+        is_clock_msr(bsl::safe_u32 const &msr) noexcept -> bool
+        {
+            return MSR_KVM_SYSTEM_TIME_NEW == msr || MSR_KVM_WALL_CLOCK_NEW == msr;
+        }
+
+        /// <!-- description -->
+        ///   @brief Returns the value of the requested kvmclock MSR.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param msr the MSR to get (see is_clock_msr)
+        ///   @return Returns the value of the requested kvmclock MSR.
+        ///
+        [[nodiscard]] constexpr auto
+        get(bsl::safe_u32 const &msr) const noexcept -> bsl::safe_u64
+        {
+            bsl::expects(is_clock_msr(msr));
+
+            if (MSR_KVM_SYSTEM_TIME_NEW == msr) {
+                return m_system_time;
+            }
+
+            return m_wall_clock;
+        }
+
+        /// <!-- description -->
+        ///   @brief Sets the value of the requested kvmclock MSR. The
+        ///     structures the MSRs point to are not written here as they
+        ///     live in guest memory (see update).
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param msr the MSR to set (see is_clock_msr)
+        ///   @param val the value to set the MSR to
+        ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+        ///     if the value is not properly aligned.
+        ///
+        [[nodiscard]] constexpr auto
+        set(bsl::safe_u32 const &msr, bsl::safe_u64 const &val) noexcept -> bsl::errc_type
+        {
+            bsl::expects(is_clock_msr(msr));
+
+            if (MSR_KVM_SYSTEM_TIME_NEW == msr) {
+                if (bsl::unlikely((val & PVCLOCK_SYSTEM_TIME_RSVD).is_pos())) {
+                    bsl::error() << "the pvclock structure "     // --
+                                 << bsl::hex(val)                // --
+                                 << " is not 32 byte aligned"    // --
+                                 << bsl::endl                    // --
+                                 << bsl::here();                 // --
+
+                    return bsl::errc_failure;
+                }
+
+                m_system_time = val;
+                m_stale = true;
+                return bsl::errc_success;
+            }
+
+            if (bsl::unlikely((val & PVCLOCK_WALL_CLOCK_RSVD).is_pos())) {
+                bsl::error() << "the wall clock structure "    // --
+                             << bsl::hex(val)                  // --
+                             << " is not 4 byte aligned"       // --
+                             << bsl::endl                      // --
+                             << bsl::here();                   // --
+
+                return bsl::errc_failure;
+            }
+
+            m_wall_clock = val;
+            m_wall_clock_pending = true;
+            return bsl::errc_success;
+        }
+
+        /// <!-- description -->
+        ///   @brief Tells this emulated_clock_t that the pvclock structure
+        ///     must be updated before the VS is run again. This should be
+        ///     called whenever the TSC of the VS is changed.
+        ///
+        constexpr void
+        invalidate() noexcept
+        {
+            m_stale = true;
+        }
+
+        /// <!-- description -->
+        ///   @brief Returns true if the structures the kvmclock MSRs point
+        ///     to must be written before the VS is run on the current PP,
+        ///     false otherwise.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param sys the bf_syscall_t to use
+        ///   @param vm_pool the vm_pool_t to use
+        ///   @param vmid the ID of the VM this emulated_clock_t's VS belongs to
+        ///   @return Returns true if the structures the kvmclock MSRs point
+        ///     to must be written, false otherwise.
+        ///
+        [[nodiscard]] constexpr auto
+        is_stale(
+            syscall::bf_syscall_t const &sys,
+            vm_pool_t const &vm_pool,
+            bsl::safe_u16 const &vmid) const noexcept -> bool
+        {
+            if (m_wall_clock_pending) {
+                return true;
+            }
+
+            if ((m_system_time & PVCLOCK_SYSTEM_TIME_ENABLE).is_zero()) {
+                return false;
+            }
+
+            if (m_stale) {
+                return true;
+            }
+
+            if (sys.bf_tls_ppid() != m_updated_ppid) {
+                return true;
+            }
+
+            return vm_pool.clock_generation(vmid) != m_updated_generation;
+        }
+
+        /// <!-- description -->
+        ///   @brief Writes the structures the kvmclock MSRs point to. The
+        ///     pvclock structure is written using the version protocol
+        ///     (odd while the update is in progress) so that a reader on
+        ///     another VS (like the vDSO) never sees a partial update.
+        ///
+        ///   @note If the guest points the MSRs at memory that is not
+        ///     mapped (or that MicroV is not allowed to write to), the
+        ///     update is dropped (like KVM), but the VS keeps running.
+        ///     The clock is only marked as updated once the pvclock
+        ///     structure has been written, so a dropped update is tried
+        ///     again on the next entry.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param tls the tls_t to use
+        ///   @param mut_sys the bf_syscall_t to use
+        ///   @param mut_pp_pool the pp_pool_t to use
+        ///   @param vm_pool the vm_pool_t to use
+        ///   @param vmid the ID of the VM this emulated_clock_t's VS belongs to
+        ///   @param host_tsc the TSC of the current PP the update is based on
+        ///   @param guest_tsc the TSC the VS sees when the PP reads host_tsc
+        ///   @param guest_khz the frequency of the TSC the VS sees in KHz
+        ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+        ///     and friends otherwise
+        ///
+        [[nodiscard]] constexpr auto
+        update(
+            tls_t const &tls,
+            syscall::bf_syscall_t &mut_sys,
+            pp_pool_t &mut_pp_pool,
+            vm_pool_t const &vm_pool,
+            bsl::safe_u16 const &vmid,
+            bsl::safe_u64 const &host_tsc,
+            bsl::safe_u64 const &guest_tsc,
+            bsl::safe_u64 const &guest_khz) noexcept -> bsl::errc_type
+        {
+            constexpr auto entry_size{32_u64};
+
+            if (m_wall_clock_pending) {
+                m_wall_clock_pending = {};
+
+                auto const ret{this->write_wall_clock(tls, mut_sys, mut_pp_pool, vm_pool, vmid)};
+                if (bsl::unlikely(!ret)) {
+                    bsl::print<bsl::V>() << bsl::here();
+                }
+                else {
+                    bsl::touch();
+                }
+            }
+            else {
+                bsl::touch();
+            }
+
+            if ((m_system_time & PVCLOCK_SYSTEM_TIME_ENABLE).is_zero()) {
+                return bsl::errc_success;
+            }
+
+            /// NOTE:
+            /// - The generation is read before the clock is, so that if
+            ///   the VM's clock is set while this update is in flight, the
+            ///   next entry sees a newer generation and writes it again.
+            ///
+
+            auto const generation{vm_pool.clock_generation(vmid)};
+
+            if (bsl::unlikely(guest_khz.is_zero())) {
+                bsl::error() << "the tsc frequency of vs "         // --
+                             << bsl::hex(this->assigned_vsid())    // --
+                             << " is unknown"                      // --
+                             << bsl::endl                          // --
+                             << bsl::here();                       // --
+
+                return bsl::errc_failure;
+            }
+
+            auto const host_ns{mut_pp_pool.tsc_to_ns(host_tsc, mut_sys.bf_tls_ppid())};
+            if (bsl::unlikely(host_ns.is_invalid())) {
+                bsl::print<bsl::V>() << bsl::here();
+                return bsl::errc_failure;
+            }
+
+            auto const gpa{(m_system_time & ~PVCLOCK_SYSTEM_TIME_ENABLE).checked()};
+            auto const spa{vm_pool.mapped_spa(tls, mut_sys, gpa, vmid)};
+            if (bsl::unlikely(spa.is_invalid())) {
+                bsl::print<bsl::V>() << bsl::here();
+                return bsl::errc_success;
+            }
+
+            auto const page_spa{hypercall::mv_page_aligned(spa)};
+            auto mut_page{mut_pp_pool.map<pvclock_page_t>(mut_sys, page_spa)};
+            if (bsl::unlikely(mut_page.is_invalid())) {
+                bsl::print<bsl::V>() << bsl::here();
+                return bsl::errc_failure;
+            }
+
+            auto const scale{make_clock_scale((guest_khz * HZ_PER_KHZ).checked(), NSEC_PER_SEC)};
+            auto const idx{bsl::to_idx(((spa - page_spa) / entry_size).checked())};
+            auto *const pmut_info{mut_page->entries.at_if(idx)};
+
+            m_version += bsl::safe_u32::magic_1();
+            pmut_info->version = m_version.checked().get();
+
+            pmut_info->tsc_timestamp = guest_tsc.get();
+            pmut_info->system_time = vm_pool.clock_get(host_ns, vmid).get();
+            pmut_info->tsc_to_system_mul = scale.mul;
+            pmut_info->tsc_shift = scale.shift;
+            pmut_info->flags = PVCLOCK_TSC_STABLE_BIT.get();
+
+            m_version += bsl::safe_u32::magic_1();
+            pmut_info->version = m_version.checked().get();
+
+            m_stale = {};
+            m_updated_ppid = mut_sys.bf_tls_ppid();
+            m_updated_generation = generation;
+
+            return bsl::errc_success;
+        }
+    };
+}
+
+#endif
@@ -29,16 +29,119 @@
 #include <cpuid_commands.hpp>
 #include <errc_types.hpp>
 #include <gs_t.hpp>
+#include <mv_cdl_t.hpp>
+#include <mv_cpuid_flag_t.hpp>
 #include <page_pool_t.hpp>
 #include <tls_t.hpp>
 
+#include <bsl/array.hpp>
+#include <bsl/convert.hpp>
 #include <bsl/debug.hpp>
 #include <bsl/discard.hpp>
+#include <bsl/ensures.hpp>
 #include <bsl/errc_type.hpp>
+#include <bsl/expects.hpp>
+#include <bsl/safe_idx.hpp>
+#include <bsl/safe_integral.hpp>
+#include <bsl/touch.hpp>
 #include <bsl/unlikely.hpp>
 
 namespace microv
 {
+    /// @brief defines the number of basic CPUID leaves that are looked up directly
+    constexpr auto CPUID_BASIC_LEAVES{0x20_u32};
+    /// @brief defines the number of subleaves of each basic leaf that are looked up directly
+    constexpr auto CPUID_BASIC_SUBLEAVES{0x4_u32};
+    /// @brief defines the first hypervisor CPUID leaf
+    constexpr auto CPUID_HYPERVISOR_BASE{0x40000000_u32};
+    /// @brief defines the number of hypervisor CPUID leaves that are looked up directly
+    constexpr auto CPUID_HYPERVISOR_LEAVES{0x10_u32};
+    /// @brief defines the first extended CPUID leaf
+    constexpr auto CPUID_EXTENDED_BASE{0x80000000_u32};
+    /// @brief defines the number of extended CPUID leaves that are looked up directly
+    constexpr auto CPUID_EXTENDED_LEAVES{0x20_u32};
+
+    /// @brief defines the number of CPUID leaves that are looked up directly
+    constexpr auto CPUID_DIRECT_LEAVES{
+        (CPUID_BASIC_LEAVES + CPUID_HYPERVISOR_LEAVES + CPUID_EXTENDED_LEAVES).checked()};
+    /// @brief defines the number of entries that are looked up directly
+    constexpr auto CPUID_DIRECT_ENTRIES{
+        ((CPUID_BASIC_LEAVES * CPUID_BASIC_SUBLEAVES) + CPUID_HYPERVISOR_LEAVES +
+         CPUID_EXTENDED_LEAVES)
+            .checked()};
+    /// @brief defines the number of entries that are not looked up directly
+    constexpr auto CPUID_SPARSE_ENTRIES{0x28_u32};
+
+    /// @brief defines the CPUID leaf that reports the hypervisor bit
+    constexpr auto CPUID_FEATURE_LEAF{0x00000001_u32};
+    /// @brief defines the hypervisor bit in CPUID.01H:ECX
+    constexpr auto CPUID_HYPERVISOR_BIT{0x80000000_u32};
+    /// @brief defines the CPUID leaf that reports the TSC/crystal clock ratio
+    constexpr auto CPUID_TSC_LEAF{0x00000015_u32};
+    /// @brief defines the hypervisor CPUID leaf that reports the TSC frequency in KHz
+    constexpr auto CPUID_HYPERVISOR_TSC_LEAF{0x40000010_u32};
+
+    /// @struct microv::cpuid_leaf_t
+    ///
+    /// <!-- description -->
+    ///   @brief Defines the values a VS sees when it executes CPUID for
+    ///     a given leaf/subleaf.
+    ///
+    struct cpuid_leaf_t final
+    {
+        /// @brief stores the CPUID eax output
+        bsl::uint32 eax;
+        /// @brief stores the CPUID ebx output
+        bsl::uint32 ebx;
+        /// @brief stores the CPUID ecx output
+        bsl::uint32 ecx;
+        /// @brief stores the CPUID edx output
+        bsl::uint32 edx;
+    };
+
+    /// @struct microv::cpuid_sparse_leaf_t
+    ///
+    /// <!-- description -->
+    ///   @brief Defines a CPUID leaf/subleaf that does not fit in the
+    ///     directly indexed part of a cpuid_table_t.
+    ///
+    struct cpuid_sparse_leaf_t final
+    {
+        /// @brief stores the CPUID function input
+        bsl::uint32 fun;
+        /// @brief stores the CPUID index input
+        bsl::uint32 idx;
+        /// @brief stores true if idx must match the CPUID index input
+        bool significant;
+        /// @brief stores the values the VS sees for this leaf/subleaf
+        cpuid_leaf_t leaf;
+    };
+
+    /// @struct microv::cpuid_table_t
+    ///
+    /// <!-- description -->
+    ///   @brief Defines the CPUID leaves of a VS. The basic, hypervisor and
+    ///     extended leaves that are executed most often are stored in a
+    ///     single array indexed by leaf/subleaf so that a CPUID VMExit is
+    ///     a single array lookup. Everything else (e.g., the XSAVE
+    ///     subleaves of leaf 0xD) is stored in a small list that is
+    ///     searched instead.
+    ///
+    struct cpuid_table_t final
+    {
+        /// @brief stores the leaves that are looked up directly
+        bsl::array<cpuid_leaf_t, bsl::to_umx(CPUID_DIRECT_ENTRIES).get()> direct;
+        /// @brief stores true if the subleaf of a direct leaf is significant
+        bsl::array<bool, bsl::to_umx(CPUID_DIRECT_LEAVES).get()> significant;
+        /// @brief stores the leaves that are not looked up directly
+        bsl::array<cpuid_sparse_leaf_t, bsl::to_umx(CPUID_SPARSE_ENTRIES).get()> sparse;
+        /// @brief stores the number of leaves in sparse
+        bsl::uint64 num_sparse;
+    };
+
+    /// @brief make sure the cpuid_table_t fits in a page
+    static_assert(!(sizeof(cpuid_table_t) > HYPERVISOR_PAGE_SIZE));
+
     /// @class microv::emulated_cpuid_t
     ///
     /// <!-- description -->
@@ -51,6 +154,294 @@ namespace microv
     {
         /// @brief stores the ID of the VS associated with this emulated_cpuid_t
         bsl::safe_u16 m_assigned_vsid{};
+        /// @brief stores the CPUID leaves of the VS, or a nullptr if not set
+        cpuid_table_t *m_table{};
+        /// @brief stores the TSC frequency the VS sees in KHz, or 0 if unknown
+        bsl::safe_u64 m_tsc_khz{};
+
+        /// <!-- description -->
+        ///   @brief If the TSC frequency of the VS is known, CPUID leaves
+        ///     0x15 and 0x40000010 are synthesized so that the VS can get
+        ///     its TSC frequency without calibrating it. Leaf 0x15 reports
+        ///     a crystal clock that runs at the TSC frequency (i.e., a
+        ///     ratio of 1/1) and leaf 0x40000010 reports the frequency in
+        ///     KHz, like VMWare does. Returns true if the requested leaf was
+        ///     synthesized, false otherwise.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param mut_sys the bf_syscall_t to use
+        ///   @param fun the CPUID function to synthesize
+        ///   @return Returns true if the requested leaf was synthesized,
+        ///     false otherwise.
+        ///
+        [[nodiscard]] constexpr auto
+        get_tsc_leaf(syscall::bf_syscall_t &mut_sys, bsl::safe_u32 const &fun) const noexcept
+            -> bool
+        {
+            constexpr auto hz_per_khz{1000_u64};
+            constexpr auto max_hz{0x00000000FFFFFFFF_u64};
+
+            if (m_tsc_khz.is_zero()) {
+                return false;
+            }
+
+            if (CPUID_HYPERVISOR_TSC_LEAF == fun) {
+                mut_sys.bf_tls_set_rax(m_tsc_khz);
+                mut_sys.bf_tls_set_rbx({});
+                mut_sys.bf_tls_set_rcx({});
+                mut_sys.bf_tls_set_rdx({});
+                return true;
+            }
+
+            if (CPUID_TSC_LEAF != fun) {
+                return false;
+            }
+
+            auto const hz{(m_tsc_khz * hz_per_khz).checked()};
+            if (hz > max_hz) {
+                return false;
+            }
+
+            mut_sys.bf_tls_set_rax(bsl::safe_u64::magic_1());
+            mut_sys.bf_tls_set_rbx(bsl::safe_u64::magic_1());
+            mut_sys.bf_tls_set_rcx(hz);
+            mut_sys.bf_tls_set_rdx({});
+            return true;
+        }
+
+        /// <!-- description -->
+        ///   @brief Returns the position of the provided leaf in
+        ///     cpuid_table_t::significant, or bsl::safe_u32::failure() if
+        ///     the leaf is not looked up directly.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param fun the CPUID function to look up
+        ///   @return Returns the position of the provided leaf in
+        ///     cpuid_table_t::significant, or bsl::safe_u32::failure() if
+        ///     the leaf is not looked up directly.
+        ///
+        [[nodiscard]] static constexpr auto
+        direct_leaf(bsl::safe_u32 const &fun) noexcept -> bsl::safe_u32
+        {
+            if (fun < CPUID_BASIC_LEAVES) {
+                return fun;
+            }
+
+            if (fun >= CPUID_EXTENDED_BASE) {
+                auto const off{(fun - CPUID_EXTENDED_BASE).checked()};
+                if (off < CPUID_EXTENDED_LEAVES) {
+                    return (CPUID_BASIC_LEAVES + CPUID_HYPERVISOR_LEAVES + off).checked();
+                }
+
+                return bsl::safe_u32::failure();
+            }
+
+            if (fun >= CPUID_HYPERVISOR_BASE) {
+                auto const off{(fun - CPUID_HYPERVISOR_BASE).checked()};
+                if (off < CPUID_HYPERVISOR_LEAVES) {
+                    return (CPUID_BASIC_LEAVES + off).checked();
+                }
+
+                return bsl::safe_u32::failure();
+            }
+
+            return bsl::safe_u32::failure();
+        }
+
+        /// <!-- description -->
+        ///   @brief Returns the position of the provided leaf/subleaf in
+        ///     cpuid_table_t::direct, or bsl::safe_u32::failure() if the
+        ///     subleaf is not looked up directly. Only basic leaves have
+        ///     more than one subleaf that is looked up directly.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param leaf the position returned by direct_leaf()
+        ///   @param sub the CPUID subleaf to look up
+        ///   @return Returns the position of the provided leaf/subleaf in
+        ///     cpuid_table_t::direct, or bsl::safe_u32::failure() if the
+        ///     subleaf is not looked up directly.
+        ///
+        [[nodiscard]] static constexpr auto
+        direct_entry(bsl::safe_u32 const &leaf, bsl::safe_u32 const &sub) noexcept
+            -> bsl::safe_u32
+        {
+            constexpr auto basic_entries{CPUID_BASIC_LEAVES * CPUID_BASIC_SUBLEAVES};
+
+            if (leaf < CPUID_BASIC_LEAVES) {
+                if (sub < CPUID_BASIC_SUBLEAVES) {
+                    return ((leaf * CPUID_BASIC_SUBLEAVES) + sub).checked();
+                }
+
+                return bsl::safe_u32::failure();
+            }
+
+            if (sub.is_zero()) {
+                return (basic_entries + (leaf - CPUID_BASIC_LEAVES)).checked();
+            }
+
+            return bsl::safe_u32::failure();
+        }
+
+        /// <!-- description -->
+        ///   @brief Returns the values the VS sees when it executes CPUID
+        ///     with the provided function and index. Leaves that were not
+        ///     set read as 0.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param fun the CPUID function to look up
+        ///   @param idx the CPUID index to look up
+        ///   @return Returns the values the VS sees when it executes CPUID
+        ///     with the provided function and index.
+        ///
+        [[nodiscard]] constexpr auto
+        lookup(bsl::safe_u32 const &fun, bsl::safe_u32 const &idx) const noexcept
+            -> cpuid_leaf_t
+        {
+            bsl::expects(nullptr != m_table);
+
+            auto const leaf{direct_leaf(fun)};
+            if (leaf.is_valid()) {
+                auto mut_sub{idx};
+                if (!*m_table->significant.at_if(bsl::to_idx(leaf))) {
+                    mut_sub = {};
+                }
+                else {
+                    bsl::touch();
+                }
+
+                auto const entry{direct_entry(leaf, mut_sub)};
+                if (entry.is_valid()) {
+                    return *m_table->direct.at_if(bsl::to_idx(entry));
+                }
+
+                bsl::touch();
+            }
+            else {
+                bsl::touch();
+            }
+
+            for (bsl::safe_idx mut_i{}; mut_i < m_table->num_sparse; ++mut_i) {
+                auto const *const sparse{m_table->sparse.at_if(mut_i)};
+                if (fun != sparse->fun) {
+                    bsl::touch();
+                }
+                else if (sparse->significant && (idx != sparse->idx)) {
+                    bsl::touch();
+                }
+                else {
+                    return sparse->leaf;
+                }
+            }
+
+            return {};
+        }
+
+        /// <!-- description -->
+        ///   @brief Adds the provided CDL entry to the CPUID leaves of the
+        ///     VS, replacing the leaf/subleaf if it was already set.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param entry the CDL entry to add
+        ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+        ///     and friends otherwise
+        ///
+        [[nodiscard]] constexpr auto
+        set_entry(hypercall::mv_cdl_entry_t const &entry) noexcept -> bsl::errc_type
+        {
+            bsl::expects(nullptr != m_table);
+
+            bool mut_significant{};
+            switch (entry.flags) {
+                case hypercall::mv_cpuid_flag_t::mv_cpuid_flag_t_reserved: {
+                    mut_significant = false;
+                    break;
+                }
+
+                case hypercall::mv_cpuid_flag_t::mv_cpuid_flag_t_significant_index: {
+                    mut_significant = true;
+                    break;
+                }
+
+                default: {
+                    bsl::error() << "invalid cpuid flags "                      // --
+                                 << bsl::hex(hypercall::to_i32(entry.flags))    // --
+                                 << bsl::endl                                   // --
+                                 << bsl::here();                                // --
+
+                    return bsl::errc_failure;
+                }
+            }
+
+            auto const fun{bsl::to_u32(entry.fun)};
+            auto mut_idx{bsl::to_u32(entry.idx)};
+            if (!mut_significant) {
+                mut_idx = {};
+            }
+            else {
+                bsl::touch();
+            }
+
+            cpuid_leaf_t mut_leaf{entry.eax, entry.ebx, entry.ecx, entry.edx};
+            if (CPUID_FEATURE_LEAF == fun) {
+                mut_leaf.ecx |= CPUID_HYPERVISOR_BIT.get();
+            }
+            else {
+                bsl::touch();
+            }
+
+            auto const leaf{direct_leaf(fun)};
+            if (leaf.is_valid()) {
+                *m_table->significant.at_if(bsl::to_idx(leaf)) = mut_significant;
+
+                auto const direct{direct_entry(leaf, mut_idx)};
+                if (direct.is_valid()) {
+                    *m_table->direct.at_if(bsl::to_idx(direct)) = mut_leaf;
+                    return bsl::errc_success;
+                }
+
+                bsl::touch();
+            }
+            else {
+                bsl::touch();
+            }
+
+            bsl::safe_idx mut_i{};
+            for (; mut_i < m_table->num_sparse; ++mut_i) {
+                auto const *const sparse{m_table->sparse.at_if(mut_i)};
+                if ((fun == sparse->fun) && (mut_idx == sparse->idx)) {
+                    break;
+                }
+
+                bsl::touch();
+            }
+
+            auto *const pmut_sparse{m_table->sparse.at_if(mut_i)};
+            if (bsl::unlikely(nullptr == pmut_sparse)) {
+                bsl::error() << "unable to set cpuid leaf "      // --
+                             << bsl::hex(fun)                    // --
+                             << ":"                              // --
+                             << bsl::hex(mut_idx)                // --
+                             << " as the cpuid table is full"    // --
+                             << bsl::endl                        // --
+                             << bsl::here();                     // --
+
+                return bsl::errc_failure;
+            }
+
+            pmut_sparse->fun = fun.get();
+            pmut_sparse->idx = mut_idx.get();
+            pmut_sparse->significant = mut_significant;
+            pmut_sparse->leaf = mut_leaf;
+
+            if (mut_i == m_table->num_sparse) {
+                ++m_table->num_sparse;
+            }
+            else {
+                bsl::touch();
+            }
+
+            return bsl::errc_success;
+        }
 
     public:
         /// <!-- description -->
@@ -97,6 +488,8 @@ namespace microv
             syscall::bf_syscall_t const &sys,
             intrinsic_t const &intrinsic) noexcept
         {
+            bsl::expects(nullptr == m_table);
+
             bsl::discard(gs);
             bsl::discard(tls);
             bsl::discard(sys);
@@ -105,6 +498,24 @@ namespace microv
             m_assigned_vsid = {};
         }
 
+        /// <!-- description -->
+        ///   @brief Returns the CPUID leaves of the VS to the page pool and
+        ///     clears its TSC frequency. Once this is called, the VS sees the
+        ///     CPUID leaves reported by hardware until set_list() is called
+        ///     again.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param tls the tls_t to use
+        ///   @param mut_page_pool the page_pool_t to use
+        ///
+        constexpr void
+        deallocate(tls_t const &tls, page_pool_t &mut_page_pool) noexcept
+        {
+            mut_page_pool.deallocate(tls, m_table);
+            m_table = {};
+            m_tsc_khz = {};
+        }
+
         /// <!-- description -->
         ///   @brief Returns the ID of the PP associated with this
         ///     emulated_cpuid_t
@@ -214,59 +625,125 @@ namespace microv
         }
 
         /// <!-- description -->
-        ///   @brief Reads CPUID on the physical processor using the values
-        ///     stored in the eax, ebx, ecx, and edx registers provided by the
-        ///     syscall layer and stores the results in the same registers.
+        ///   @brief Answers CPUID for a guest VS using the values stored in
+        ///     the eax and ecx registers provided by the syscall layer and
+        ///     stores the results in the eax, ebx, ecx and edx registers.
+        ///     If set_list() has not been called, the leaves reported by
+        ///     hardware are returned with the hypervisor bit set.
         ///
         /// <!-- inputs/outputs -->
-        ///   @param sys the bf_syscall_t to use
+        ///   @param mut_sys the bf_syscall_t to use
         ///   @param intrinsic the intrinsic_t to use
         ///   @return Returns bsl::errc_success on success, bsl::errc_failure
-        ///     and friends otherwise. If the PP was asked to promote the VS,
-        ///     vmexit_success_promote is returned.
+        ///     and friends otherwise.
         ///
-        [[nodiscard]] static constexpr auto
-        get(syscall::bf_syscall_t const &sys, intrinsic_t const &intrinsic) noexcept
+        [[nodiscard]] constexpr auto
+        get(syscall::bf_syscall_t &mut_sys, intrinsic_t const &intrinsic) const noexcept
             -> bsl::errc_type
         {
-            bsl::discard(sys);
-            bsl::discard(intrinsic);
+            auto const fun{bsl::to_u32_unsafe(mut_sys.bf_tls_rax())};
+            auto const idx{bsl::to_u32_unsafe(mut_sys.bf_tls_rcx())};
 
-            /// NOTE:
-            /// - Create an array: mv_cpuid_leaf_t[max_functions][max_indexes].
-            ///   The reason that this is 2-d is that some require
-            /// - CPUID is actually in the hotpath, so yes, this takes up
-            ///   a bunch of memory that will be wasted, but it is really
-            ///   fast because you can just use a simple array lookup.
-            /// - Initialize this array in the initialize function.
-            ///
-            /// - For get(), you simply return what is in the array.
-            /// - For set(), you change what is in the array, but you are
-            ///   only allowed to reduce capabilities, meaning once the
-            ///   array is initialized, set can only zero out a feature,
-            ///   it cannot add a 1. Set also cannot change certain
-            ///   cpuid leaves. For now, we should only support the
-            ///   ability to set features. Everything else should throw
-            ///   an error. This might be an issue with the APIC topology
-            ///   stuff, but address that if it happens. Keep it simple
-            ///   unless QEMU requires more.
-            ///
+            if (this->get_tsc_leaf(mut_sys, fun)) {
+                return bsl::errc_success;
+            }
 
-            /// NOTE:
-            /// - For supported(), permissable() and emulated(), that code
-            ///   belongs in the PP, but, it needs to be in sync with this
-            ///   code, so any changes that change these functions needs
-            ///   to be keep in sync.
-            ///
+            if (nullptr == m_table) {
+                auto mut_rax{bsl::to_u64(fun)};
+                auto mut_rbx{mut_sys.bf_tls_rbx()};
+                auto mut_rcx{bsl::to_u64(idx)};
+                auto mut_rdx{mut_sys.bf_tls_rdx()};
+                intrinsic.cpuid(mut_rax, mut_rbx, mut_rcx, mut_rdx);
 
-            /// NOTE:
-            /// - Don't forget about the hypervisor bit. See root code for
-            ///   example. The hypervisor bit should be initialized, meaning
-            ///   don't calculate it like we do with the root.
-            ///
+                if (CPUID_FEATURE_LEAF == fun) {
+                    mut_rcx |= bsl::to_u64(CPUID_HYPERVISOR_BIT);
+                }
+                else {
+                    bsl::touch();
+                }
+
+                mut_sys.bf_tls_set_rax(mut_rax);
+                mut_sys.bf_tls_set_rbx(mut_rbx);
+                mut_sys.bf_tls_set_rcx(mut_rcx);
+                mut_sys.bf_tls_set_rdx(mut_rdx);
 
-            bsl::error() << "get not implemented\n" << bsl::here();
-            return bsl::errc_failure;
+                return bsl::errc_success;
+            }
+
+            auto const leaf{this->lookup(fun, idx)};
+
+            mut_sys.bf_tls_set_rax(bsl::to_u64(leaf.eax));
+            mut_sys.bf_tls_set_rbx(bsl::to_u64(leaf.ebx));
+            mut_sys.bf_tls_set_rcx(bsl::to_u64(leaf.ecx));
+            mut_sys.bf_tls_set_rdx(bsl::to_u64(leaf.edx));
+
+            return bsl::errc_success;
+        }
+
+        /// <!-- description -->
+        ///   @brief Sets the TSC frequency the VS sees in KHz. Once set,
+        ///     CPUID leaves 0x15 and 0x40000010 report this frequency (see
+        ///     get_tsc_leaf), regardless of what set_list() was given.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param khz the TSC frequency the VS sees in KHz
+        ///
+        constexpr void
+        set_tsc_khz(bsl::safe_u64 const &khz) noexcept
+        {
+            bsl::expects(khz.is_valid_and_checked());
+            m_tsc_khz = khz;
+        }
+
+        /// <!-- description -->
+        ///   @brief Sets the CPUID leaves of the VS using the provided CDL.
+        ///     If cdl.reg0 is 0, any leaves that were previously set are
+        ///     cleared first, otherwise the entries are added to them.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param tls the tls_t to use
+        ///   @param mut_sys the bf_syscall_t to use
+        ///   @param mut_page_pool the page_pool_t to use
+        ///   @param cdl the CDL to get the requested CPUID leaves from
+        ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+        ///     and friends otherwise
+        ///
+        [[nodiscard]] constexpr auto
+        set_list(
+            tls_t const &tls,
+            syscall::bf_syscall_t &mut_sys,
+            page_pool_t &mut_page_pool,
+            hypercall::mv_cdl_t const &cdl) noexcept -> bsl::errc_type
+        {
+            bsl::expects(cdl.num_entries <= cdl.entries.size());
+
+            if (nullptr == m_table) {
+                m_table = mut_page_pool.allocate<cpuid_table_t>(tls, mut_sys);
+                if (bsl::unlikely(nullptr == m_table)) {
+                    bsl::print<bsl::V>() << bsl::here();
+                    return bsl::errc_failure;
+                }
+
+                bsl::touch();
+            }
+            else if (bsl::safe_u64::magic_0() == cdl.reg0) {
+                *m_table = {};
+            }
+            else {
+                bsl::touch();
+            }
+
+            for (bsl::safe_idx mut_i{}; mut_i < cdl.num_entries; ++mut_i) {
+                auto const ret{this->set_entry(*cdl.entries.at_if(mut_i))};
+                if (bsl::unlikely(!ret)) {
+                    bsl::print<bsl::V>() << bsl::here();
+                    return ret;
+                }
+
+                bsl::touch();
+            }
+
+            return bsl::errc_success;
         }
     };
 }
@@ -26,13 +26,17 @@
 #define EMULATED_MMIO_T_HPP
 
 #include <bf_syscall_t.hpp>
+#include <dirty_log_t.hpp>
 #include <gs_t.hpp>
 #include <intrinsic_t.hpp>
 #include <l1e_t.hpp>
 #include <map_page_flags.hpp>
+#include <mv_constants.hpp>
 #include <mv_mdl_t.hpp>
 #include <mv_translation_t.hpp>
 #include <page_2m_t.hpp>
+#include <page_4k_t.hpp>
+#include <second_level_page_table_helpers.hpp>
 #include <second_level_page_table_t.hpp>
 #include <tls_t.hpp>
 
@@ -223,12 +227,17 @@ namespace microv
 
         /// <!-- description -->
         ///   @brief Maps memory into this VM using instructions from the
-        ///     provided MDL.
+        ///     provided MDL. Pages that are dirty logged by the provided
+        ///     dirty_log_t and that are not already dirty are mapped
+        ///     without write access, so that no PP can ever cache a
+        ///     writable translation for them before their first write is
+        ///     logged.
         ///
         /// <!-- inputs/outputs -->
         ///   @param tls the tls_t to use
         ///   @param mut_sys the bf_syscall_t to use
         ///   @param mut_page_pool the page_pool_t to use
+        ///   @param mut_dirty_log the dirty_log_t of the VM
         ///   @param mdl the MDL containing the memory to map into the VM
         ///   @return Returns bsl::errc_success on success, bsl::errc_failure
         ///     and friends otherwise
@@ -237,6 +246,7 @@ namespace microv
         map(tls_t const &tls,
             syscall::bf_syscall_t &mut_sys,
             page_pool_t &mut_page_pool,
+            dirty_log_t &mut_dirty_log,
             hypercall::mv_mdl_t const &mdl) noexcept -> bsl::errc_type
         {
             bsl::expects(mut_sys.is_the_active_vm_the_root_vm());
@@ -252,14 +262,22 @@ namespace microv
                 /// - Add support for entries that have a size greater than
                 ///   4k. For now we only support 4k pages.
                 /// - Add support for the flags field. For now, everything
-                ///   is mapped as RWE.
+                ///   is mapped as RWE (or RE while dirty logged).
                 /// - We need to undo the any maps that succeeded on failure.
                 ///   Right now, we do not do that, which is an issue
                 ///   because guest software will not attempt to undo a
                 ///   failed map operation.
                 ///
+                auto mut_flags{MAP_PAGE_RWE};
+                if (mut_dirty_log.clean(gpa)) {
+                    mut_flags = MAP_PAGE_RE;
+                }
+                else {
+                    bsl::touch();
+                }
+
                 auto const ret{
-                    m_slpt.map_page(tls, mut_page_pool, gpa, spa, MAP_PAGE_RWE, false, mut_sys)};
+                    m_slpt.map_page(tls, mut_page_pool, gpa, spa, mut_flags, false, mut_sys)};
 
                 if (bsl::unlikely(ret == bsl::errc_already_exists)) {
                     bsl::error() << "mdl entry "                   // --
@@ -288,6 +306,10 @@ namespace microv
         ///   @brief Unmaps memory from this VM using instructions from the
         ///     provided MDL.
         ///
+        ///   @note This does not flush the TLB. The caller is responsible
+        ///     for flushing the TLB on any PP that has run this VM
+        ///     (see vm_t::tlb_flush).
+        ///
         /// <!-- inputs/outputs -->
         ///   @param tls the tls_t to use
         ///   @param mut_sys the bf_syscall_t to use
@@ -322,18 +344,217 @@ namespace microv
                     return ret;
                 }
 
-                /// TODO:
-                /// - We need to flush the TLB. Once SMP support is added,
-                ///   we will have to perform a remote TLB flush. For now,
-                ///   a local TLB flush is fine.
-                ///
-
                 bsl::touch();
             }
 
             return bsl::errc_success;
         }
 
+        /// <!-- description -->
+        ///   @brief Returns true if the 4k page that contains the provided
+        ///     GPA is mapped into this VM, false otherwise.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param tls the tls_t to use
+        ///   @param sys the bf_syscall_t to use
+        ///   @param gpa the GPA to query
+        ///   @return Returns true if the 4k page that contains the provided
+        ///     GPA is mapped into this VM, false otherwise.
+        ///
+        [[nodiscard]] constexpr auto
+        is_mapped(
+            tls_t const &tls,
+            syscall::bf_syscall_t const &sys,
+            bsl::safe_u64 const &gpa) const noexcept -> bool
+        {
+            return nullptr != m_slpt.entries(tls, sys, gpa).l0e;
+        }
+
+        /// <!-- description -->
+        ///   @brief Returns the system physical address that the provided
+        ///     GPA is mapped to using the second level page tables of this
+        ///     VM. Unlike gpa_to_spa, this performs an actual translation,
+        ///     so it can be used with guest VMs.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param tls the tls_t to use
+        ///   @param sys the bf_syscall_t to use
+        ///   @param gpa the GPA to translate to a SPA
+        ///   @return Returns the system physical address that the provided
+        ///     GPA is mapped to on success. Returns bsl::safe_u64::failure()
+        ///     if the 4k page that contains the GPA is not mapped.
+        ///
+        [[nodiscard]] constexpr auto
+        mapped_spa(
+            tls_t const &tls,
+            syscall::bf_syscall_t const &sys,
+            bsl::safe_u64 const &gpa) const noexcept -> bsl::safe_u64
+        {
+            auto const *const l0e{m_slpt.entries(tls, sys, gpa).l0e};
+            if (bsl::unlikely(nullptr == l0e)) {
+                bsl::error() << "gpa "                           // --
+                             << bsl::hex(gpa)                    // --
+                             << " is not mapped as a 4k page"    // --
+                             << bsl::endl                        // --
+                             << bsl::here();                     // --
+
+                return bsl::safe_u64::failure();
+            }
+
+            auto const spa{(bsl::to_u64(l0e->phys) << PAGE_4K_T_SHFT).checked()};
+            return (spa + (gpa - hypercall::mv_page_aligned(gpa))).checked();
+        }
+
+        /// <!-- description -->
+        ///   @brief Grants or revokes write access to the 4k page that
+        ///     contains the provided GPA. The page must already be mapped
+        ///     into this VM.
+        ///
+        ///   @note This does not flush the TLB. When write access is
+        ///     revoked, the caller is responsible for flushing the TLB on
+        ///     any PP that has run this VM (see vm_t::tlb_flush).
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param tls the tls_t to use
+        ///   @param sys the bf_syscall_t to use
+        ///   @param gpa the GPA of the page to modify
+        ///   @param allow true to grant write access, false to revoke it
+        ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+        ///     and friends otherwise
+        ///
+        [[nodiscard]] constexpr auto
+        write_access(
+            tls_t const &tls,
+            syscall::bf_syscall_t const &sys,
+            bsl::safe_u64 const &gpa,
+            bool const allow) noexcept -> bsl::errc_type
+        {
+            bsl::expects(!sys.is_vm_the_root_vm(this->assigned_vmid()));
+
+            auto const entries{m_slpt.entries(tls, sys, gpa)};
+            if (bsl::unlikely(nullptr == entries.l0e)) {
+                bsl::error() << "gpa "                           // --
+                             << bsl::hex(gpa)                    // --
+                             << " is not mapped as a 4k page"    // --
+                             << bsl::endl                        // --
+                             << bsl::here();                     // --
+
+                return bsl::errc_failure;
+            }
+
+            /// NOTE:
+            /// - Pages that are shared copy-on-write with another VM are
+            ///   never made writable. Writes to these pages must go to the
+            ///   root VM so that the page can be copied (see share).
+            ///
+
+            if (allow && bsl::safe_u64::magic_1() == entries.l0e->cow) {
+                return bsl::errc_success;
+            }
+
+            helpers::configure_entry_write_access(entries.l0e, allow);
+            return bsl::errc_success;
+        }
+
+        /// <!-- description -->
+        ///   @brief Returns true if the 4k page that contains the provided
+        ///     GPA is mapped into this VM and is shared copy-on-write with
+        ///     another VM (see share), false otherwise.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param tls the tls_t to use
+        ///   @param sys the bf_syscall_t to use
+        ///   @param gpa the GPA to query
+        ///   @return Returns true if the 4k page that contains the provided
+        ///     GPA is mapped into this VM and is shared copy-on-write with
+        ///     another VM, false otherwise.
+        ///
+        [[nodiscard]] constexpr auto
+        is_cow(
+            tls_t const &tls,
+            syscall::bf_syscall_t const &sys,
+            bsl::safe_u64 const &gpa) const noexcept -> bool
+        {
+            auto const entries{m_slpt.entries(tls, sys, gpa)};
+            if (nullptr == entries.l0e) {
+                return false;
+            }
+
+            return bsl::safe_u64::magic_1() == entries.l0e->cow;
+        }
+
+        /// <!-- description -->
+        ///   @brief Maps the memory that the provided emulated_mmio_t has
+        ///     mapped into the ranges described by the provided MDL into
+        ///     this VM at the same GPAs. Each page is mapped read/execute
+        ///     only and is marked as copy-on-write, which means that both
+        ///     VMs share the same system physical pages until this VM
+        ///     writes to them. Pages that are not mapped by the provided
+        ///     emulated_mmio_t are skipped, so the cost of this function
+        ///     is proportional to the number of pages the other VM has
+        ///     touched and not the size of its memory.
+        ///
+        ///   @note The write fault generated by the first write to a
+        ///     shared page is returned to the root VM, which is expected
+        ///     to unmap the shared page and map a private copy in its place.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param tls the tls_t to use
+        ///   @param mut_sys the bf_syscall_t to use
+        ///   @param mut_page_pool the page_pool_t to use
+        ///   @param parent the emulated_mmio_t to share memory with
+        ///   @param mdl the MDL describing the GPA ranges to share. The dst
+        ///     and bytes fields of each entry describe a range. The src and
+        ///     flags fields are ignored.
+        ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+        ///     and friends otherwise
+        ///
+        [[nodiscard]] constexpr auto
+        share(
+            tls_t const &tls,
+            syscall::bf_syscall_t &mut_sys,
+            page_pool_t &mut_page_pool,
+            emulated_mmio_t const &parent,
+            hypercall::mv_mdl_t const &mdl) noexcept -> bsl::errc_type
+        {
+            bsl::expects(mut_sys.is_the_active_vm_the_root_vm());
+            bsl::expects(!mut_sys.is_vm_the_root_vm(this->assigned_vmid()));
+            bsl::expects(!mut_sys.is_vm_the_root_vm(parent.assigned_vmid()));
+
+            for (bsl::safe_idx mut_i{}; mut_i < mdl.num_entries; ++mut_i) {
+                auto const *const entry{mdl.entries.at_if(mut_i)};
+
+                auto const gpa{bsl::to_u64(entry->dst)};
+                auto const num_pages{(bsl::to_u64(entry->bytes) >> PAGE_4K_T_SHFT).checked()};
+
+                for (bsl::safe_idx mut_j{}; mut_j < num_pages; ++mut_j) {
+                    auto const page_gpa{(gpa + (bsl::to_u64(mut_j) << PAGE_4K_T_SHFT)).checked()};
+
+                    auto const *const parent_l0e{parent.m_slpt.entries(tls, mut_sys, page_gpa).l0e};
+                    if (nullptr == parent_l0e) {
+                        bsl::touch();
+                    }
+                    else {
+                        auto const spa{(bsl::to_u64(parent_l0e->phys) << PAGE_4K_T_SHFT).checked()};
+
+                        auto const ret{m_slpt.map_page(
+                            tls, mut_page_pool, page_gpa, spa, MAP_PAGE_RE, false, mut_sys)};
+                        if (bsl::unlikely(!ret)) {
+                            bsl::print<bsl::V>() << bsl::here();
+                            return ret;
+                        }
+
+                        auto *const pmut_l0e{m_slpt.entries(tls, mut_sys, page_gpa).l0e};
+                        bsl::expects(nullptr != pmut_l0e);
+
+                        pmut_l0e->cow = bsl::safe_u64::magic_1().get();
+                    }
+                }
+            }
+
+            return bsl::errc_success;
+        }
+
         /// <!-- description -->
         ///   @brief Returns a system physical address given a guest physical
         ///     address using MMIO second level paging from this VM to
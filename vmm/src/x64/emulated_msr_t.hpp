@@ -28,21 +28,174 @@
 #include <bf_syscall_t.hpp>
 #include <gs_t.hpp>
 #include <intrinsic_t.hpp>
+#include <msr_constants.hpp>
 #include <tls_t.hpp>
 
+#include <bsl/array.hpp>
+#include <bsl/convert.hpp>
 #include <bsl/debug.hpp>
 #include <bsl/discard.hpp>
+#include <bsl/ensures.hpp>
 #include <bsl/errc_type.hpp>
+#include <bsl/expects.hpp>
+#include <bsl/safe_idx.hpp>
+#include <bsl/safe_integral.hpp>
+#include <bsl/touch.hpp>
 #include <bsl/unlikely.hpp>
 
 namespace microv
 {
+    /// @brief stores true if accesses to unknown MSRs are ignored instead of injecting a GPF
+    constexpr auto EMULATED_MSR_IGNORE_UNKNOWN{MICROV_IGNORE_UNKNOWN_MSRS};
+
+    /// @enum microv::emulated_msr_type_t
+    ///
+    /// <!-- description -->
+    ///   @brief Defines how an emulated MSR handles reads and writes.
+    ///
+    enum class emulated_msr_type_t : bsl::uint8
+    {
+        /// @brief reads return the stored value, writes store the value
+        read_write = 0,
+        /// @brief reads return the stored value, writes inject a GPF
+        read_only = 1,
+        /// @brief reads return the stored value, writes are discarded
+        write_ignored = 2,
+    };
+
+    /// @struct microv::emulated_msr_desc_t
+    ///
+    /// <!-- description -->
+    ///   @brief Describes a range of MSRs that is emulated by an
+    ///     emulated_msr_t. Each MSR in the range has its own storage
+    ///     that starts at the provided slot.
+    ///
+    struct emulated_msr_desc_t final
+    {
+        /// @brief stores the first MSR in the range
+        bsl::uint32 first;
+        /// @brief stores the number of MSRs in the range
+        bsl::uint32 num;
+        /// @brief stores the storage slot of the first MSR in the range
+        bsl::uint32 slot;
+        /// @brief stores how the MSRs in the range are emulated
+        emulated_msr_type_t type;
+        /// @brief stores the value of the MSRs in the range on reset
+        bsl::uint64 reset;
+        /// @brief stores the bits that can be written, others inject a GPF
+        bsl::uint64 mask;
+    };
+
+    /// @brief defines the IA32_FEATURE_CONTROL value a VS sees (locked, no VMX)
+    constexpr auto EMULATED_MSR_FEATURE_CONTROL{0x0000000000000001_u64};
+    /// @brief defines the IA32_MTRRCAP value a VS sees (8 variable, fixed and WC)
+    constexpr auto EMULATED_MSR_MTRRCAP{0x0000000000000508_u64};
+    /// @brief defines the IA32_MISC_ENABLE value a VS sees on reset
+    constexpr auto EMULATED_MSR_MISC_ENABLE{0x0000000000001801_u64};
+    /// @brief defines the number of variable range MTRRs (base and mask MSRs)
+    constexpr auto EMULATED_MSR_MTRR_VAR_MSRS{16_u32};
+    /// @brief defines the bits of an IA32_MTRR_PHYSBASE/PHYSMASK that can be written
+    constexpr auto EMULATED_MSR_MTRR_VAR_MASK{0x000FFFFFFFFFF8FF_u64};
+    /// @brief defines the bits of IA32_MTRR_DEF_TYPE that can be written
+    constexpr auto EMULATED_MSR_MTRR_DEF_TYPE_MASK{0x0000000000000CFF_u64};
+    /// @brief defines the bits of IA32_TSC_AUX that can be written
+    constexpr auto EMULATED_MSR_TSC_AUX_MASK{0x00000000FFFFFFFF_u64};
+    /// @brief defines a mask where every bit can be written
+    constexpr auto EMULATED_MSR_ALL_BITS{0xFFFFFFFFFFFFFFFF_u64};
+
+    /// @brief defines the MSRs emulated by an emulated_msr_t, sorted by MSR
+    constexpr bsl::array EMULATED_MSRS{
+        emulated_msr_desc_t{
+            MSR_PLATFORM_ID.get(), 1U, 0U, emulated_msr_type_t::read_only, {}, {}},
+        emulated_msr_desc_t{
+            MSR_FEATURE_CONTROL.get(),
+            1U,
+            1U,
+            emulated_msr_type_t::read_only,
+            EMULATED_MSR_FEATURE_CONTROL.get(),
+            {}},
+        emulated_msr_desc_t{
+            MSR_BIOS_SIGN_ID.get(), 1U, 2U, emulated_msr_type_t::write_ignored, {}, {}},
+        emulated_msr_desc_t{
+            MSR_MTRRCAP.get(),
+            1U,
+            3U,
+            emulated_msr_type_t::read_only,
+            EMULATED_MSR_MTRRCAP.get(),
+            {}},
+        emulated_msr_desc_t{MSR_MCG_CAP.get(), 1U, 4U, emulated_msr_type_t::read_only, {}, {}},
+        emulated_msr_desc_t{
+            MSR_MCG_STATUS.get(), 1U, 5U, emulated_msr_type_t::read_write, {}, {}},
+        emulated_msr_desc_t{
+            MSR_MISC_ENABLE.get(),
+            1U,
+            6U,
+            emulated_msr_type_t::read_write,
+            EMULATED_MSR_MISC_ENABLE.get(),
+            EMULATED_MSR_ALL_BITS.get()},
+        emulated_msr_desc_t{
+            MSR_MTRR_PHYSBASE0.get(),
+            EMULATED_MSR_MTRR_VAR_MSRS.get(),
+            7U,
+            emulated_msr_type_t::read_write,
+            {},
+            EMULATED_MSR_MTRR_VAR_MASK.get()},
+        emulated_msr_desc_t{
+            MSR_MTRR_FIX64K_00000.get(),
+            1U,
+            23U,
+            emulated_msr_type_t::read_write,
+            {},
+            EMULATED_MSR_ALL_BITS.get()},
+        emulated_msr_desc_t{
+            MSR_MTRR_FIX16K_80000.get(),
+            2U,
+            24U,
+            emulated_msr_type_t::read_write,
+            {},
+            EMULATED_MSR_ALL_BITS.get()},
+        emulated_msr_desc_t{
+            MSR_MTRR_FIX4K_C0000.get(),
+            8U,
+            26U,
+            emulated_msr_type_t::read_write,
+            {},
+            EMULATED_MSR_ALL_BITS.get()},
+        emulated_msr_desc_t{
+            MSR_MTRR_DEF_TYPE.get(),
+            1U,
+            34U,
+            emulated_msr_type_t::read_write,
+            {},
+            EMULATED_MSR_MTRR_DEF_TYPE_MASK.get()},
+        emulated_msr_desc_t{
+            MSR_TSC_DEADLINE.get(),
+            1U,
+            35U,
+            emulated_msr_type_t::read_write,
+            {},
+            EMULATED_MSR_ALL_BITS.get()},
+        emulated_msr_desc_t{
+            MSR_TSC_AUX.get(),
+            1U,
+            36U,
+            emulated_msr_type_t::read_write,
+            {},
+            EMULATED_MSR_TSC_AUX_MASK.get()},
+    };
+
+    /// @brief defines the number of MSR values stored by an emulated_msr_t
+    constexpr auto EMULATED_MSR_SLOTS{37_umx};
+
     /// @class microv::emulated_msr_t
     ///
     /// <!-- description -->
     ///   @brief Defines MicroV's emulated MSR handler. Emulated resources
     ///     are owned by guest VSs and provide an emulated interface for
-    ///     guest VMs.
+    ///     guest VMs. MSRs that only need a per-VS value (e.g., the
+    ///     MTRRs and IA32_MISC_ENABLE) are described by EMULATED_MSRS,
+    ///     which is sorted so that an MSR is found with a binary search
+    ///     instead of walking every entry.
     ///
     ///   @note IMPORTANT: This class is a per-VS class, and all accesses
     ///     to CPUID from a VM (root or guest) must come from this class.
@@ -51,6 +204,59 @@ namespace microv
     {
         /// @brief stores the ID of the VS associated with this emulated_msr_t
         bsl::safe_u16 m_assigned_vsid{};
+        /// @brief stores the value of each emulated MSR
+        bsl::array<bsl::safe_u64, EMULATED_MSR_SLOTS.get()> m_vals{};
+
+        /// <!-- description -->
+        ///   @brief Returns the descriptor of the range that contains the
+        ///     provided MSR, or a nullptr if the MSR is not emulated.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param msr the MSR to look up
+        ///   @return Returns the descriptor of the range that contains the
+        ///     provided MSR, or a nullptr if the MSR is not emulated.
+        ///
+        [[nodiscard]] static constexpr auto
+        find(bsl::safe_u32 const &msr) noexcept -> emulated_msr_desc_t const *
+        {
+            bsl::safe_umx mut_lo{};
+            bsl::safe_umx mut_hi{EMULATED_MSRS.size()};
+
+            while (mut_lo < mut_hi) {
+                auto const mid{(mut_lo + ((mut_hi - mut_lo) >> 1_umx)).checked()};
+                auto const *const desc{EMULATED_MSRS.at_if(bsl::to_idx(mid))};
+                auto const first{bsl::to_u32(desc->first)};
+
+                if (msr < first) {
+                    mut_hi = mid;
+                }
+                else if ((msr - first).checked() >= bsl::to_u32(desc->num)) {
+                    mut_lo = (mid + bsl::safe_umx::magic_1()).checked();
+                }
+                else {
+                    return desc;
+                }
+            }
+
+            return nullptr;
+        }
+
+        /// <!-- description -->
+        ///   @brief Returns the storage slot of the provided MSR given
+        ///     the descriptor of the range that contains it.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param desc the descriptor of the range that contains msr
+        ///   @param msr the MSR to get the storage slot for
+        ///   @return Returns the storage slot of the provided MSR
+        ///
+        [[nodiscard]] static constexpr auto
+        slot(emulated_msr_desc_t const *const desc, bsl::safe_u32 const &msr) noexcept
+            -> bsl::safe_idx
+        {
+            auto const off{(msr - bsl::to_u32(desc->first)).checked()};
+            return bsl::to_idx((bsl::to_umx(desc->slot) + bsl::to_umx(off)).checked());
+        }
 
     public:
         /// <!-- description -->
@@ -79,13 +285,14 @@ namespace microv
             bsl::discard(intrinsic);
 
             /// NOTE:
-            /// - Since the MSR permissions map is a global resource due to
-            ///   the limited amount of physically contiguous memory that
-            ///   is required, the initialization of the MSR permission maps
-            ///   is done in gs_initialize. Any MSR ports that need to be
-            ///   trapped, or passed through should be done there.
+            /// - The MSR permissions map of a guest VS is owned by the VM
+            ///   it is assigned to (see msrpm_t), while the root VM uses
+            ///   the MSR permissions map initialized in gs_initialize. Any
+            ///   MSRs that need to be trapped, or passed through by
+            ///   default should be done there.
             ///
 
+            this->reset();
             m_assigned_vsid = ~vsid;
         }
 
@@ -110,6 +317,7 @@ namespace microv
             bsl::discard(sys);
             bsl::discard(intrinsic);
 
+            m_vals = {};
             m_assigned_vsid = {};
         }
 
@@ -127,7 +335,130 @@ namespace microv
             bsl::ensures(m_assigned_vsid.is_valid_and_checked());
             return ~m_assigned_vsid;
         }
+
+        /// <!-- description -->
+        ///   @brief Sets every emulated MSR to its reset value.
+        ///
+        constexpr void
+        reset() noexcept
+        {
+            for (bsl::safe_idx mut_i{}; mut_i < EMULATED_MSRS.size(); ++mut_i) {
+                auto const *const desc{EMULATED_MSRS.at_if(mut_i)};
+                auto const first{bsl::to_u32(desc->first)};
+
+                for (bsl::safe_u32 mut_j{}; mut_j < bsl::to_u32(desc->num); ++mut_j) {
+                    *m_vals.at_if(slot(desc, (first + mut_j).checked())) = desc->reset;
+                }
+            }
+        }
+
+        /// <!-- description -->
+        ///   @brief Returns the value of the requested MSR. If the MSR is
+        ///     not emulated, bsl::safe_u64::failure() is returned, unless
+        ///     MicroV is configured to ignore unknown MSRs, in which case
+        ///     0 is returned.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param msr the MSR to get
+        ///   @return Returns the value of the requested MSR
+        ///
+        [[nodiscard]] constexpr auto
+        get(bsl::safe_u32 const &msr) const noexcept -> bsl::safe_u64
+        {
+            bsl::expects(msr.is_valid_and_checked());
+
+            auto const *const desc{find(msr)};
+            if (bsl::unlikely(nullptr == desc)) {
+                if (EMULATED_MSR_IGNORE_UNKNOWN) {
+                    bsl::debug<bsl::V>() << "ignoring read from unknown MSR "    // --
+                                         << bsl::hex(msr)                        // --
+                                         << bsl::endl;
+                    return bsl::safe_u64::magic_0();
+                }
+
+                bsl::error() << "MSR "           // --
+                             << bsl::hex(msr)    // --
+                             << " is not supported"
+                             << bsl::endl       // --
+                             << bsl::here();    // --
+
+                return bsl::safe_u64::failure();
+            }
+
+            return *m_vals.at_if(slot(desc, msr));
+        }
+
+        /// <!-- description -->
+        ///   @brief Sets the value of the requested MSR. Writes to
+        ///     read-only MSRs and writes that set bits that cannot be
+        ///     written fail. If the MSR is not emulated, the write fails,
+        ///     unless MicroV is configured to ignore unknown MSRs, in which
+        ///     case the write is discarded.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param msr the MSR to set
+        ///   @param val the value to set the MSR to
+        ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+        ///     and friends otherwise
+        ///
+        [[nodiscard]] constexpr auto
+        set(bsl::safe_u32 const &msr, bsl::safe_u64 const &val) noexcept -> bsl::errc_type
+        {
+            bsl::expects(msr.is_valid_and_checked());
+            bsl::expects(val.is_valid_and_checked());
+
+            auto const *const desc{find(msr)};
+            if (bsl::unlikely(nullptr == desc)) {
+                if (EMULATED_MSR_IGNORE_UNKNOWN) {
+                    bsl::debug<bsl::V>() << "ignoring write to unknown MSR "    // --
+                                         << bsl::hex(msr)                       // --
+                                         << bsl::endl;
+                    return bsl::errc_success;
+                }
+
+                bsl::error() << "MSR "           // --
+                             << bsl::hex(msr)    // --
+                             << " is not supported"
+                             << bsl::endl       // --
+                             << bsl::here();    // --
+
+                return bsl::errc_failure;
+            }
+
+            if (emulated_msr_type_t::write_ignored == desc->type) {
+                return bsl::errc_success;
+            }
+
+            if (bsl::unlikely(emulated_msr_type_t::read_only == desc->type)) {
+                bsl::error() << "MSR "           // --
+                             << bsl::hex(msr)    // --
+                             << " is read-only"
+                             << bsl::endl       // --
+                             << bsl::here();    // --
+
+                return bsl::errc_failure;
+            }
+
+            if (bsl::unlikely((val & ~bsl::to_u64(desc->mask)).is_pos())) {
+                bsl::error() << "invalid value "    // --
+                             << bsl::hex(val)       // --
+                             << " for MSR "         // --
+                             << bsl::hex(msr)       // --
+                             << bsl::endl           // --
+                             << bsl::here();        // --
+
+                return bsl::errc_failure;
+            }
+
+            *m_vals.at_if(slot(desc, msr)) = val;
+            return bsl::errc_success;
+        }
     };
+
+    /// @brief make sure EMULATED_MSR_SLOTS covers every range in EMULATED_MSRS
+    static_assert(
+        (bsl::to_umx(EMULATED_MSRS.back().slot) + bsl::to_umx(EMULATED_MSRS.back().num)) ==
+        EMULATED_MSR_SLOTS);
 }
 
 #endif
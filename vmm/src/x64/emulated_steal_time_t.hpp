@@ -0,0 +1,414 @@
+/// @copyright
+/// Copyright (C) 2020 Assured Information Security, Inc.
+///
+/// @copyright
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// @copyright
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// @copyright
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+
+
+#ifndef EMULATED_STEAL_TIME_T_HPP
+#define EMULATED_STEAL_TIME_T_HPP
+
+#include <bf_syscall_t.hpp>
+#include <gs_t.hpp>
+#include <intrinsic_t.hpp>
+#include <msr_constants.hpp>
+#include <page_4k_t.hpp>
+#include <pp_pool_t.hpp>
+#include <tls_t.hpp>
+#include <vm_pool_t.hpp>
+
+#include <bsl/array.hpp>
+#include <bsl/convert.hpp>
+#include <bsl/cstdint.hpp>
+#include <bsl/debug.hpp>
+#include <bsl/discard.hpp>
+#include <bsl/errc_type.hpp>
+#include <bsl/safe_integral.hpp>
+#include <bsl/touch.hpp>
+#include <bsl/unlikely.hpp>
+
+namespace microv
+{
+    /// @brief defines the enable bit of MSR_KVM_STEAL_TIME
+    constexpr auto STEAL_TIME_ENABLE{0x0000000000000001_u64};
+    /// @brief defines the bits of MSR_KVM_STEAL_TIME that must be 0
+    constexpr auto STEAL_TIME_RSVD{0x000000000000003E_u64};
+    /// @brief tells the guest that the VS is not running (KVM_VCPU_PREEMPTED)
+    constexpr auto STEAL_TIME_PREEMPTED{0x01_u8};
+    /// @brief set by the guest to request a TLB flush (KVM_VCPU_FLUSH_TLB)
+    constexpr auto STEAL_TIME_FLUSH_TLB{0x02_u8};
+
+    /// @brief defines the number of steal_time_t in a page
+    constexpr auto STEAL_TIME_ENTRIES_PER_PAGE{64_umx};
+
+#pragma pack(push, 1)
+
+    /// @struct microv::steal_time_t
+    ///
+    /// <!-- description -->
+    ///   @brief Defines the structure that MSR_KVM_STEAL_TIME points to
+    ///     (struct kvm_steal_time).
+    ///
+    struct steal_time_t final
+    {
+        /// @brief stores the time (in ns) the VS was runnable but not run
+        bsl::uint64 steal;
+        /// @brief stores the version (odd while an update is in progress)
+        bsl::uint32 version;
+        /// @brief reserved
+        bsl::uint32 flags;
+        /// @brief stores STEAL_TIME_PREEMPTED and STEAL_TIME_FLUSH_TLB
+        bsl::uint8 preempted;
+        /// @brief reserved
+        bsl::array<bsl::uint8, 3_umx.get()> pad0;
+        /// @brief reserved
+        bsl::array<bsl::uint32, 11_umx.get()> pad1;
+    };
+
+    /// @struct microv::steal_time_page_t
+    ///
+    /// <!-- description -->
+    ///   @brief Defines a page of steal_time_t structures. The guest is
+    ///     free to place its structure anywhere in a page (so long as it
+    ///     is 64 byte aligned), so we map the entire page and then index
+    ///     into it.
+    ///
+    struct steal_time_page_t final
+    {
+        /// @brief stores the steal_time_t entries
+        bsl::array<steal_time_t, STEAL_TIME_ENTRIES_PER_PAGE.get()> entries;
+    };
+
+#pragma pack(pop)
+
+    static_assert(sizeof(steal_time_t) == 64_umx);
+    static_assert(sizeof(steal_time_page_t) == HYPERVISOR_PAGE_SIZE);
+
+    /// @class microv::emulated_steal_time_t
+    ///
+    /// <!-- description -->
+    ///   @brief Defines MicroV's emulated steal time handler.
+    ///
+    ///   @note IMPORTANT: This class is a per-VS class, and handles the
+    ///     MSR_KVM_STEAL_TIME MSR. MicroV does not know when the root VM
+    ///     deschedules the thread that runs a VS, so steal is always
+    ///     reported as 0. What this class does provide is the preempted
+    ///     flag, which is set whenever the VS leaves the guest for long
+    ///     enough that the root VM might schedule something else, and
+    ///     cleared before the VS is run again. This is what allows the
+    ///     guest to use KVM_FEATURE_PV_TLB_FLUSH. Instead of sending a TLB
+    ///     shootdown IPI to a preempted VS (which would not be answered
+    ///     until the VS is run again), the guest sets the flush flag, and
+    ///     MicroV flushes the TLB of the VS before running it.
+    ///
+    class emulated_steal_time_t final
+    {
+        /// @brief stores the ID of the VS associated with this emulated_steal_time_t
+        bsl::safe_u16 m_assigned_vsid{};
+
+        /// @brief stores the value of MSR_KVM_STEAL_TIME
+        bsl::safe_u64 m_steal_time{};
+        /// @brief stores true if the guest was told the VS is preempted
+        bool m_preempted{};
+
+        /// <!-- description -->
+        ///   @brief Atomically replaces the preempted flags of the guest's
+        ///     steal_time_t with the provided value and returns the flags
+        ///     that were replaced. The exchange must be atomic as other
+        ///     VSs in the same VM set the flush flag using cmpxchg. If an
+        ///     error occurs, bsl::safe_u8::failure() is returned.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param tls the tls_t to use
+        ///   @param mut_sys the bf_syscall_t to use
+        ///   @param mut_pp_pool the pp_pool_t to use
+        ///   @param vm_pool the vm_pool_t to use
+        ///   @param intrinsic the intrinsic_t to use
+        ///   @param vmid the ID of the VM this emulated_steal_time_t belongs to
+        ///   @param val the flags to store
+        ///   @return Returns the flags that were replaced, or
+        ///     bsl::safe_u8::failure() on failure.
+        ///
+        [[nodiscard]] constexpr auto
+        xchg_preempted(
+            tls_t const &tls,
+            syscall::bf_syscall_t &mut_sys,
+            pp_pool_t &mut_pp_pool,
+            vm_pool_t const &vm_pool,
+            intrinsic_t const &intrinsic,
+            bsl::safe_u16 const &vmid,
+            bsl::safe_u8 const &val) const noexcept -> bsl::safe_u8
+        {
+            constexpr auto entry_size{64_u64};
+
+            auto const gpa{(m_steal_time & ~STEAL_TIME_ENABLE).checked()};
+            auto const spa{vm_pool.mapped_spa(tls, mut_sys, gpa, vmid)};
+            if (bsl::unlikely(spa.is_invalid())) {
+                bsl::print<bsl::V>() << bsl::here();
+                return bsl::safe_u8::failure();
+            }
+
+            auto const page_spa{hypercall::mv_page_aligned(spa)};
+            auto mut_page{mut_pp_pool.map<steal_time_page_t>(mut_sys, page_spa)};
+            if (bsl::unlikely(mut_page.is_invalid())) {
+                bsl::print<bsl::V>() << bsl::here();
+                return bsl::safe_u8::failure();
+            }
+
+            auto const idx{bsl::to_idx(((spa - page_spa) / entry_size).checked())};
+            return intrinsic.xchg_u8(&mut_page->entries.at_if(idx)->preempted, val);
+        }
+
+    public:
+        /// <!-- description -->
+        ///   @brief Initializes this emulated_steal_time_t.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param gs the gs_t to use
+        ///   @param tls the tls_t to use
+        ///   @param sys the bf_syscall_t to use
+        ///   @param intrinsic the intrinsic_t to use
+        ///   @param vsid the ID of the VS associated with this emulated_steal_time_t
+        ///
+        constexpr void
+        initialize(
+            gs_t const &gs,
+            tls_t const &tls,
+            syscall::bf_syscall_t const &sys,
+            intrinsic_t const &intrinsic,
+            bsl::safe_u16 const &vsid) noexcept
+        {
+            bsl::expects(this->assigned_vsid() == syscall::BF_INVALID_ID);
+
+            bsl::discard(gs);
+            bsl::discard(tls);
+            bsl::discard(sys);
+            bsl::discard(intrinsic);
+
+            m_assigned_vsid = ~vsid;
+        }
+
+        /// <!-- description -->
+        ///   @brief Release the emulated_steal_time_t.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param gs the gs_t to use
+        ///   @param tls the tls_t to use
+        ///   @param sys the bf_syscall_t to use
+        ///   @param intrinsic the intrinsic_t to use
+        ///
+        constexpr void
+        release(
+            gs_t const &gs,
+            tls_t const &tls,
+            syscall::bf_syscall_t const &sys,
+            intrinsic_t const &intrinsic) noexcept
+        {
+            bsl::discard(gs);
+            bsl::discard(tls);
+            bsl::discard(sys);
+            bsl::discard(intrinsic);
+
+            this->reset();
+            m_assigned_vsid = {};
+        }
+
+        /// <!-- description -->
+        ///   @brief Returns the ID of the VS associated with this
+        ///     emulated_steal_time_t
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @return Returns the ID of the VS associated with this
+        ///     emulated_steal_time_t
+        ///
+        [[nodiscard]] constexpr auto
+        assigned_vsid() const noexcept -> bsl::safe_u16
+        {
+            bsl::ensures(m_assigned_vsid.is_valid_and_checked());
+            return ~m_assigned_vsid;
+        }
+
+        /// <!-- description -->
+        ///   @brief Disables steal time, returning this
+        ///     emulated_steal_time_t to the state it was in when the VS
+        ///     was created.
+        ///
+        constexpr void
+        reset() noexcept
+        {
+            m_steal_time = {};
+            m_preempted = {};
+        }
+
+        /// <!-- description -->
+        ///   @brief Returns the emulated value of MSR_KVM_STEAL_TIME
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @return Returns the emulated value of MSR_KVM_STEAL_TIME
+        ///
+        [[nodiscard]] constexpr auto
+        get() const noexcept -> bsl::safe_u64 const &
+        {
+            bsl::ensures(m_steal_time.is_valid_and_checked());
+            return m_steal_time;
+        }
+
+        /// <!-- description -->
+        ///   @brief Sets the value of the emulated MSR_KVM_STEAL_TIME. Like
+        ///     KVM, the steal_time_t must be 64 byte aligned, otherwise this
+        ///     fails and the caller injects a #GP.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param val the value to set MSR_KVM_STEAL_TIME to
+        ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+        ///     and friends otherwise
+        ///
+        [[nodiscard]] constexpr auto
+        set(bsl::safe_u64 const &val) noexcept -> bsl::errc_type
+        {
+            bsl::expects(val.is_valid_and_checked());
+
+            if (bsl::unlikely((val & STEAL_TIME_RSVD).is_pos())) {
+                bsl::error() << "the steal time structure "    // --
+                             << bsl::hex(val)                  // --
+                             << " is not 64 byte aligned"      // --
+                             << bsl::endl                      // --
+                             << bsl::here();                   // --
+
+                return bsl::errc_failure;
+            }
+
+            m_steal_time = val;
+            m_preempted = {};
+
+            return bsl::errc_success;
+        }
+
+        /// <!-- description -->
+        ///   @brief Tells the guest that the VS is preempted. This should be
+        ///     called when the VS leaves the guest for the root VM in a way
+        ///     that allows the root VM to schedule something else (e.g., an
+        ///     interrupt or a HLT). From this point on, the guest may set
+        ///     the flush flag instead of sending the VS a TLB shootdown IPI.
+        ///
+        ///   @note Like KVM, if the guest points the MSR at memory that is
+        ///     not mapped, the VS is simply never reported as preempted.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param tls the tls_t to use
+        ///   @param mut_sys the bf_syscall_t to use
+        ///   @param mut_pp_pool the pp_pool_t to use
+        ///   @param vm_pool the vm_pool_t to use
+        ///   @param intrinsic the intrinsic_t to use
+        ///   @param vmid the ID of the VM this emulated_steal_time_t belongs to
+        ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+        ///     and friends otherwise
+        ///
+        [[nodiscard]] constexpr auto
+        preempt(
+            tls_t const &tls,
+            syscall::bf_syscall_t &mut_sys,
+            pp_pool_t &mut_pp_pool,
+            vm_pool_t const &vm_pool,
+            intrinsic_t const &intrinsic,
+            bsl::safe_u16 const &vmid) noexcept -> bsl::errc_type
+        {
+            if ((m_steal_time & STEAL_TIME_ENABLE).is_zero()) {
+                return bsl::errc_success;
+            }
+
+            if (m_preempted) {
+                return bsl::errc_success;
+            }
+
+            auto const flags{this->xchg_preempted(
+                tls, mut_sys, mut_pp_pool, vm_pool, intrinsic, vmid, STEAL_TIME_PREEMPTED)};
+            if (bsl::unlikely(flags.is_invalid())) {
+                bsl::print<bsl::V>() << bsl::here();
+                return bsl::errc_failure;
+            }
+
+            m_preempted = true;
+            return bsl::errc_success;
+        }
+
+        /// <!-- description -->
+        ///   @brief Clears the preempted flags of the guest if the VS was
+        ///     reported as preempted (see preempt). If another VS of the
+        ///     guest asked for a TLB flush while this VS was preempted, the
+        ///     TLB of the VM is flushed on the current PP, which is the PP
+        ///     the VS is about to run on. This must be called before the VS
+        ///     is run.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param tls the tls_t to use
+        ///   @param mut_sys the bf_syscall_t to use
+        ///   @param mut_pp_pool the pp_pool_t to use
+        ///   @param vm_pool the vm_pool_t to use
+        ///   @param intrinsic the intrinsic_t to use
+        ///   @param vmid the ID of the VM this emulated_steal_time_t belongs to
+        ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+        ///     and friends otherwise
+        ///
+        [[nodiscard]] constexpr auto
+        sync(
+            tls_t const &tls,
+            syscall::bf_syscall_t &mut_sys,
+            pp_pool_t &mut_pp_pool,
+            vm_pool_t const &vm_pool,
+            intrinsic_t const &intrinsic,
+            bsl::safe_u16 const &vmid) noexcept -> bsl::errc_type
+        {
+            if (!m_preempted) {
+                return bsl::errc_success;
+            }
+
+            m_preempted = {};
+
+            /// NOTE:
+            /// - If the flags cannot be read, a flush might have been asked
+            ///   for, so the TLB is flushed anyway.
+            ///
+
+            auto const flags{this->xchg_preempted(
+                tls, mut_sys, mut_pp_pool, vm_pool, intrinsic, vmid, bsl::safe_u8{})};
+            if (bsl::unlikely(flags.is_invalid())) {
+                bsl::print<bsl::V>() << bsl::here();
+            }
+            else if ((flags & STEAL_TIME_FLUSH_TLB).is_zero()) {
+                return bsl::errc_success;
+            }
+            else {
+                bsl::touch();
+            }
+
+            auto const ret{mut_sys.bf_vm_op_tlb_flush(vmid)};
+            if (bsl::unlikely(!ret)) {
+                bsl::print<bsl::V>() << bsl::here();
+                return ret;
+            }
+
+            return bsl::errc_success;
+        }
+    };
+}
+
+#endif
@@ -29,19 +29,23 @@
 
 #include <bsl/convert.hpp>
 #include <bsl/safe_integral.hpp>
+#include <bsl/touch.hpp>
+#include <bsl/unlikely.hpp>
 
 namespace microv
 {
     /// <!-- description -->
     ///   @brief Returns the invariant (not stable) TSC frequency of the
-    ///     CPU. By invariant, we mean fixed frequency. By stable, we mean
-    ///     consistent between each core, which is more rare, and likely
-    ///     not a thing with BIG.little.
+    ///     CPU in KHz. By invariant, we mean fixed frequency. By stable, we
+    ///     mean consistent between each core, which is more rare, and likely
+    ///     not a thing with BIG.little. This executes CPUID, so it should
+    ///     only be called once per PP (see pp_t::allocate), and the result
+    ///     should be cached.
     ///
     /// <!-- inputs/outputs -->
     ///   @param intrinsic the intrinsic_t to use
     ///   @return Returns the invariant (not stable) TSC frequency of the
-    ///     CPU on success. Returns bsl::safe_u64::failure() on failure.
+    ///     CPU in KHz on success. Returns bsl::safe_u64::failure() on failure.
     ///
     [[nodiscard]] constexpr auto
     get_tsc_freq(intrinsic_t const &intrinsic) noexcept -> bsl::safe_u64
@@ -53,19 +57,50 @@ namespace microv
         bsl::safe_u64 mut_rdx{};
 
         /// NOTE:
-        /// - If we are on VMWare, 0x40000010 can be used to get the
-        ///   invariant TSC information.
+        /// - If we are running under a hypervisor (like VMWare or MicroV
+        ///   itself), 0x40000010 can be used to get the invariant TSC
+        ///   frequency in KHz. This leaf is only valid if the hypervisor
+        ///   bit is set and the hypervisor reports that the leaf exists,
+        ///   otherwise, Intel returns the highest basic leaf instead.
         ///
 
+        constexpr auto feature_leaf{0x00000001_u64};
+        constexpr auto hypervisor_bit{0x80000000_u64};
+        constexpr auto hypervisor_leaf{0x40000000_u64};
         constexpr auto vmware_tsc_leaf{0x40000010_u64};
-        mut_rax = vmware_tsc_leaf;
+
+        mut_rax = feature_leaf;
         mut_rbx = {};
         mut_rcx = {};
         mut_rdx = {};
         intrinsic.cpuid(mut_rax, mut_rbx, mut_rcx, mut_rdx);
 
-        if (mut_rax.is_pos()) {
-            return (mut_rax / khz).checked();
+        if ((mut_rcx & hypervisor_bit).is_pos()) {
+            mut_rax = hypervisor_leaf;
+            mut_rbx = {};
+            mut_rcx = {};
+            mut_rdx = {};
+            intrinsic.cpuid(mut_rax, mut_rbx, mut_rcx, mut_rdx);
+
+            if (mut_rax >= vmware_tsc_leaf) {
+                mut_rax = vmware_tsc_leaf;
+                mut_rbx = {};
+                mut_rcx = {};
+                mut_rdx = {};
+                intrinsic.cpuid(mut_rax, mut_rbx, mut_rcx, mut_rdx);
+            }
+            else {
+                mut_rax = {};
+            }
+
+            if (mut_rax.is_pos()) {
+                return mut_rax;
+            }
+
+            bsl::touch();
+        }
+        else {
+            bsl::touch();
         }
 
         /// NOTE:
@@ -38,12 +38,14 @@
 #include <dispatch_vmexit_mmio.hpp>
 #include <dispatch_vmexit_nmi.hpp>
 #include <dispatch_vmexit_nmi_window.hpp>
+#include <dispatch_vmexit_pause.hpp>
 #include <dispatch_vmexit_rdmsr.hpp>
 #include <dispatch_vmexit_sipi.hpp>
 #include <dispatch_vmexit_triple_fault.hpp>
 #include <dispatch_vmexit_unknown.hpp>
 #include <dispatch_vmexit_vmcall.hpp>
 #include <dispatch_vmexit_wrmsr.hpp>
+#include <dispatch_vmexit_xsetbv.hpp>
 #include <errc_types.hpp>
 #include <gs_t.hpp>
 #include <intrinsic_t.hpp>
@@ -67,10 +69,22 @@ namespace microv
     constexpr auto EXIT_REASON_INTR{1_u64};
     /// @brief defines the CPUID exit reason code
     constexpr auto EXIT_REASON_CPUID{10_u64};
+    /// @brief defines the HLT exit reason code
+    constexpr auto EXIT_REASON_HLT{12_u64};
     /// @brief defines the VMCALL exit reason code
     constexpr auto EXIT_REASON_VMCALL{18_u64};
     /// @brief defines the IOIO exit reason code
     constexpr auto EXIT_REASON_IOIO{30_u64};
+    /// @brief defines the RDMSR exit reason code
+    constexpr auto EXIT_REASON_RDMSR{31_u64};
+    /// @brief defines the WRMSR exit reason code
+    constexpr auto EXIT_REASON_WRMSR{32_u64};
+    /// @brief defines the PAUSE exit reason code
+    constexpr auto EXIT_REASON_PAUSE{40_u64};
+    /// @brief defines the EPT violation exit reason code
+    constexpr auto EXIT_REASON_EPT_VIOLATION{48_u64};
+    /// @brief defines the XSETBV exit reason code
+    constexpr auto EXIT_REASON_XSETBV{55_u64};
 
     /// <!-- description -->
     ///   @brief Dispatches the VMExit.
@@ -167,6 +181,36 @@ namespace microv
                 break;
             }
 
+            case EXIT_REASON_HLT.get(): {
+                mut_ret = dispatch_vmexit_hlt(
+                    gs,
+                    mut_tls,
+                    mut_sys,
+                    mut_page_pool,
+                    intrinsic,
+                    mut_pp_pool,
+                    mut_vm_pool,
+                    mut_vp_pool,
+                    mut_vs_pool,
+                    vsid);
+                break;
+            }
+
+            case EXIT_REASON_PAUSE.get(): {
+                mut_ret = dispatch_vmexit_pause(
+                    gs,
+                    mut_tls,
+                    mut_sys,
+                    mut_page_pool,
+                    intrinsic,
+                    mut_pp_pool,
+                    mut_vm_pool,
+                    mut_vp_pool,
+                    mut_vs_pool,
+                    vsid);
+                break;
+            }
+
             case EXIT_REASON_IOIO.get(): {
                 mut_ret = dispatch_vmexit_io(
                     gs,
@@ -182,6 +226,51 @@ namespace microv
                 break;
             }
 
+            case EXIT_REASON_RDMSR.get(): {
+                mut_ret = dispatch_vmexit_rdmsr(
+                    gs,
+                    mut_tls,
+                    mut_sys,
+                    mut_page_pool,
+                    intrinsic,
+                    mut_pp_pool,
+                    mut_vm_pool,
+                    mut_vp_pool,
+                    mut_vs_pool,
+                    vsid);
+                break;
+            }
+
+            case EXIT_REASON_WRMSR.get(): {
+                mut_ret = dispatch_vmexit_wrmsr(
+                    gs,
+                    mut_tls,
+                    mut_sys,
+                    mut_page_pool,
+                    intrinsic,
+                    mut_pp_pool,
+                    mut_vm_pool,
+                    mut_vp_pool,
+                    mut_vs_pool,
+                    vsid);
+                break;
+            }
+
+            case EXIT_REASON_EPT_VIOLATION.get(): {
+                mut_ret = dispatch_vmexit_mmio(
+                    gs,
+                    mut_tls,
+                    mut_sys,
+                    mut_page_pool,
+                    intrinsic,
+                    mut_pp_pool,
+                    mut_vm_pool,
+                    mut_vp_pool,
+                    mut_vs_pool,
+                    vsid);
+                break;
+            }
+
             case EXIT_REASON_VMCALL.get(): {
                 mut_ret = dispatch_vmexit_vmcall(
                     gs,
@@ -197,6 +286,21 @@ namespace microv
                 break;
             }
 
+            case EXIT_REASON_XSETBV.get(): {
+                mut_ret = dispatch_vmexit_xsetbv(
+                    gs,
+                    mut_tls,
+                    mut_sys,
+                    mut_page_pool,
+                    intrinsic,
+                    mut_pp_pool,
+                    mut_vm_pool,
+                    mut_vp_pool,
+                    mut_vs_pool,
+                    vsid);
+                break;
+            }
+
             default: {
                 mut_ret = dispatch_vmexit_unknown(
                     gs,
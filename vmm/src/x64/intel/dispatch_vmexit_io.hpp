@@ -29,6 +29,7 @@
 #include <dispatch_abi_helpers.hpp>
 #include <gs_t.hpp>
 #include <intrinsic_t.hpp>
+#include <iopm_t.hpp>
 #include <mv_exit_io_t.hpp>
 #include <pp_pool_t.hpp>
 #include <tls_t.hpp>
@@ -96,6 +97,34 @@ namespace microv
         auto const rcx{mut_sys.bf_tls_rcx()};
         auto const rdx{mut_sys.bf_tls_rdx()};
 
+        constexpr auto size_mask{0x00000007_u64};
+        constexpr auto size_shft{0_u64};
+        constexpr auto type_mask{0x00000008_u64};
+        constexpr auto type_shft{3_u64};
+        constexpr auto strn_mask{0x00000010_u64};
+        constexpr auto strn_shft{4_u64};
+        constexpr auto reps_mask{0x00000020_u64};
+        constexpr auto reps_shft{5_u64};
+        constexpr auto oper_mask{0x00000040_u64};
+        constexpr auto oper_shft{6_u64};
+        constexpr auto port_mask{0xFFFF0000_u64};
+        constexpr auto port_shft{16_u64};
+
+        auto const strn{((exitqual & strn_mask) >> strn_shft).checked()};
+        auto const port{((exitqual & port_mask) >> port_shft).checked()};
+        auto const bytes{(((exitqual & size_mask) >> size_shft) + 1_u64).checked()};
+
+        if (strn.is_zero() && mut_vm_pool.is_io_ignored(mut_sys.bf_tls_vmid(), port, bytes)) {
+            if (((exitqual & type_mask) >> type_shft).is_pos()) {
+                mut_sys.bf_tls_set_rax(iopm_ignored_read(rax, bytes));
+            }
+            else {
+                bsl::touch();
+            }
+
+            return vmexit_success_advance_ip_and_run;
+        }
+
         // ---------------------------------------------------------------------
         // Context: Change To Root VM
         // ---------------------------------------------------------------------
@@ -109,17 +138,6 @@ namespace microv
         auto mut_exit_io{mut_pp_pool.shared_page<hypercall::mv_exit_io_t>(mut_sys)};
         bsl::expects(mut_exit_io.is_valid());
 
-        constexpr auto size_mask{0x00000007_u64};
-        constexpr auto size_shft{0_u64};
-        constexpr auto type_mask{0x00000008_u64};
-        constexpr auto type_shft{3_u64};
-        constexpr auto reps_mask{0x00000020_u64};
-        constexpr auto reps_shft{5_u64};
-        constexpr auto oper_mask{0x00000040_u64};
-        constexpr auto oper_shft{6_u64};
-        constexpr auto port_mask{0xFFFF0000_u64};
-        constexpr auto port_shft{16_u64};
-
         if (((exitqual & oper_mask) >> oper_shft).is_zero()) {
             constexpr auto addr_mask{0x000000000000FFFF_u64};
             mut_exit_io->addr = (addr_mask & rdx).get();
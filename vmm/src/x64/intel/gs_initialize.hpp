@@ -72,42 +72,12 @@ namespace microv
             return bsl::errc_failure;
         }
 
-        mut_gs.guest_iopm_a = alloc_bitmap(mut_sys, HYPERVISOR_PAGE_SIZE, mut_gs.guest_iopm_a_spa);
-        if (bsl::unlikely(mut_gs.guest_iopm_a.is_invalid())) {
-            bsl::print<bsl::V>() << bsl::here();
-            return bsl::errc_failure;
-        }
-
-        mut_gs.guest_iopm_b = alloc_bitmap(mut_sys, HYPERVISOR_PAGE_SIZE, mut_gs.guest_iopm_b_spa);
-        if (bsl::unlikely(mut_gs.guest_iopm_b.is_invalid())) {
-            bsl::print<bsl::V>() << bsl::here();
-            return bsl::errc_failure;
-        }
-
-        mut_gs.root_msrpm = alloc_bitmap(mut_sys, HYPERVISOR_PAGE_SIZE, mut_gs.root_msrpm_spa);
+        mut_gs.root_msrpm = alloc_bitmap(mut_sys, MSRPM_SIZE, mut_gs.root_msrpm_spa);
         if (bsl::unlikely(mut_gs.root_msrpm.is_invalid())) {
             bsl::print<bsl::V>() << bsl::here();
             return bsl::errc_failure;
         }
 
-        mut_gs.guest_msrpm = alloc_bitmap(mut_sys, HYPERVISOR_PAGE_SIZE, mut_gs.guest_msrpm_spa);
-        if (bsl::unlikely(mut_gs.guest_msrpm.is_invalid())) {
-            bsl::print<bsl::V>() << bsl::here();
-            return bsl::errc_failure;
-        }
-
-        for (auto &elem : mut_gs.guest_iopm_a) {
-            elem = bsl::safe_u8::max_value().get();
-        }
-
-        for (auto &elem : mut_gs.guest_iopm_b) {
-            elem = bsl::safe_u8::max_value().get();
-        }
-
-        for (auto &elem : mut_gs.guest_msrpm) {
-            elem = bsl::safe_u8::max_value().get();
-        }
-
         return bsl::errc_success;
     }
 }
@@ -126,6 +126,30 @@ namespace helpers
         pmut_entry->w = bsl::safe_u64::magic_1().get();
         pmut_entry->e = bsl::safe_u64::magic_1().get();
     }
+
+    /// <!-- description -->
+    ///   @brief Grants or revokes write access to the memory mapped by
+    ///     the provided entry. All other fields of the entry are left
+    ///     untouched.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @tparam E the type of entry to configure
+    ///   @param pmut_entry the entry to configure
+    ///   @param allow true to grant write access, false to revoke it
+    ///
+    template<typename E>
+    constexpr void
+    configure_entry_write_access(E *const pmut_entry, bool const allow) noexcept
+    {
+        bsl::expects(nullptr != pmut_entry);
+
+        if (allow) {
+            pmut_entry->w = bsl::safe_u64::magic_1().get();
+        }
+        else {
+            pmut_entry->w = bsl::safe_u64::magic_0().get();
+        }
+    }
 }
 
 #endif
@@ -27,12 +27,18 @@
 
 #include <gs_t.hpp>
 #include <intrinsic_cpuid_impl.hpp>
+#include <intrinsic_rdtsc_impl.hpp>
+#include <intrinsic_xadd_u64_impl.hpp>
+#include <intrinsic_xchg_u8_impl.hpp>
 #include <intrinsic_xrstr_impl.hpp>
 #include <intrinsic_xsave_impl.hpp>
+#include <intrinsic_xsaveopt_impl.hpp>
 #include <tls_t.hpp>
 
+#include <bsl/cstdint.hpp>
 #include <bsl/discard.hpp>
 #include <bsl/errc_type.hpp>
+#include <bsl/expects.hpp>
 #include <bsl/safe_integral.hpp>
 
 namespace microv
@@ -65,17 +71,84 @@ namespace microv
             intrinsic_cpuid_impl(mut_rax.data(), mut_rbx.data(), mut_rcx.data(), mut_rdx.data());
         }
 
+        /// <!-- description -->
+        ///   @brief Executes the RDTSC instruction and returns the result.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @return Returns the current value of the TSC
+        ///
+        [[nodiscard]] static constexpr auto
+        rdtsc() noexcept -> bsl::safe_u64
+        {
+            return bsl::safe_u64{intrinsic_rdtsc_impl()};
+        }
+
+        /// <!-- description -->
+        ///   @brief Atomically adds the provided value to the 64bit integer
+        ///     at the provided address and returns the integer's previous
+        ///     value. The LOCK prefix also makes this a full memory barrier,
+        ///     so adding 0 can be used to read an integer that other PPs
+        ///     update, ordered with respect to any previous stores.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param pmut_ptr a pointer to the integer to add to
+        ///   @param val the value to add
+        ///   @return Returns the previous value of the integer
+        ///
+        [[nodiscard]] static constexpr auto
+        xadd_u64(bsl::uint64 *const pmut_ptr, bsl::safe_u64 const &val) noexcept -> bsl::safe_u64
+        {
+            bsl::expects(nullptr != pmut_ptr);
+            return bsl::safe_u64{intrinsic_xadd_u64_impl(pmut_ptr, val.get())};
+        }
+
+        /// <!-- description -->
+        ///   @brief Atomically exchanges the byte at the provided address
+        ///     with the provided value and returns the byte's previous
+        ///     value. This is needed when the byte lives in memory that a
+        ///     guest might be modifying at the same time.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param pmut_ptr a pointer to the byte to exchange
+        ///   @param val the value to store
+        ///   @return Returns the previous value of the byte
+        ///
+        [[nodiscard]] static constexpr auto
+        xchg_u8(bsl::uint8 *const pmut_ptr, bsl::safe_u8 const &val) noexcept -> bsl::safe_u8
+        {
+            bsl::expects(nullptr != pmut_ptr);
+            return bsl::safe_u8{intrinsic_xchg_u8_impl(pmut_ptr, val.get())};
+        }
+
         /// <!-- description -->
         ///   @brief Executes the XSAVE instruction given the provided address
         ///     to the xsave region.
         ///
         /// <!-- inputs/outputs -->
         ///   @param pmut_xsave a pointer to the xsave region to use
+        ///   @param rfbm the state components to save
+        ///
+        static constexpr void
+        xsave(void *const pmut_xsave, bsl::safe_u64 const &rfbm) noexcept
+        {
+            intrinsic_xsave_impl(pmut_xsave, rfbm.get());
+        }
+
+        /// <!-- description -->
+        ///   @brief Executes the XSAVEOPT instruction given the provided
+        ///     address to the xsave region. Unlike XSAVE, state components
+        ///     that are in their initial configuration, or that have not
+        ///     been modified since the last XRSTOR from the same region,
+        ///     are not written.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param pmut_xsave a pointer to the xsave region to use
+        ///   @param rfbm the state components to save
         ///
         static constexpr void
-        xsave(void *const pmut_xsave) noexcept
+        xsaveopt(void *const pmut_xsave, bsl::safe_u64 const &rfbm) noexcept
         {
-            intrinsic_xsave_impl(pmut_xsave);
+            intrinsic_xsaveopt_impl(pmut_xsave, rfbm.get());
         }
 
         /// <!-- description -->
@@ -84,11 +157,12 @@ namespace microv
         ///
         /// <!-- inputs/outputs -->
         ///   @param pmut_xsave a pointer to the xsave region to use
+        ///   @param rfbm the state components to restore
         ///
         static constexpr void
-        xrstr(void *const pmut_xsave) noexcept
+        xrstr(void *const pmut_xsave, bsl::safe_u64 const &rfbm) noexcept
         {
-            intrinsic_xrstr_impl(pmut_xsave);
+            intrinsic_xrstr_impl(pmut_xsave, rfbm.get());
         }
     };
 }
@@ -0,0 +1,48 @@
+/// @copyright
+/// Copyright (C) 2020 Assured Information Security, Inc.
+///
+/// @copyright
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// @copyright
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// @copyright
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+
+
+#ifndef INTRINSIC_XADD_U64_IMPL_HPP
+#define INTRINSIC_XADD_U64_IMPL_HPP
+
+#include <bsl/cstdint.hpp>
+
+namespace microv
+{
+    /// <!-- description -->
+    ///   @brief Atomically adds the provided value to the 64bit integer at
+    ///     the provided address using the LOCK XADD instruction and returns
+    ///     the integer's previous value.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param pmut_ptr a pointer to the integer to add to
+    ///   @param val the value to add
+    ///   @return Returns the previous value of the integer
+    ///
+    extern "C" [[nodiscard]] auto
+    intrinsic_xadd_u64_impl(bsl::uint64 *const pmut_ptr, bsl::uint64 const val) noexcept
+        -> bsl::uint64;
+}
+
+#endif
@@ -35,8 +35,9 @@ namespace microv
     ///
     /// <!-- inputs/outputs -->
     ///   @param pmut_xsave a pointer to the xsave region to use
+    ///   @param rfbm the requested-feature bitmap (loaded into EDX:EAX)
     ///
-    extern "C" void intrinsic_xsave_impl(void *const pmut_xsave) noexcept;
+    extern "C" void intrinsic_xsave_impl(void *const pmut_xsave, bsl::uint64 const rfbm) noexcept;
 }
 
 #endif
@@ -0,0 +1,44 @@
+/// @copyright
+/// Copyright (C) 2020 Assured Information Security, Inc.
+///
+/// @copyright
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// @copyright
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// @copyright
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+
+#ifndef INTRINSIC_XSAVEOPT_IMPL_HPP
+#define INTRINSIC_XSAVEOPT_IMPL_HPP
+
+#include <bsl/cstdint.hpp>
+
+namespace microv
+{
+    /// <!-- description -->
+    ///   @brief Executes the XSAVEOPT instruction given the provided address to
+    ///     the xsave region.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param pmut_xsave a pointer to the xsave region to use
+    ///   @param rfbm the requested-feature bitmap (loaded into EDX:EAX)
+    ///
+    extern "C" void intrinsic_xsaveopt_impl(
+        void *const pmut_xsave, bsl::uint64 const rfbm) noexcept;
+}
+
+#endif
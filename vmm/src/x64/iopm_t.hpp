@@ -0,0 +1,323 @@
+/// @copyright
+/// Copyright (C) 2020 Assured Information Security, Inc.
+///
+/// @copyright
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// @copyright
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// @copyright
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+
+
+#ifndef IOPM_T_HPP
+#define IOPM_T_HPP
+
+#include <alloc_bitmap.hpp>
+#include <bf_syscall_t.hpp>
+#include <gs_t.hpp>
+#include <mv_constants.hpp>
+
+#include <bsl/convert.hpp>
+#include <bsl/debug.hpp>
+#include <bsl/ensures.hpp>
+#include <bsl/errc_type.hpp>
+#include <bsl/expects.hpp>
+#include <bsl/safe_idx.hpp>
+#include <bsl/safe_integral.hpp>
+#include <bsl/span.hpp>
+#include <bsl/touch.hpp>
+#include <bsl/unlikely.hpp>
+
+namespace microv
+{
+    /// @brief defines the total number of ports
+    constexpr auto IOPM_NUM_PORTS{0x10000_u64};
+    /// @brief defines the size of the map of ignored ports
+    constexpr auto IOPM_IGNORED_SIZE{0x2000_umx};
+    /// @brief defines the POST code port, which is also used as an IO delay
+    constexpr auto IOPM_POST_PORT{0x80_u64};
+    /// @brief defines the number of bits in a byte of the IO permissions map
+    constexpr auto IOPM_BITS_PER_BYTE{8_u64};
+
+    /// <!-- description -->
+    ///   @brief Returns the value of RAX after an ignored port read of the
+    ///     provided number of bytes. Like hardware with nothing behind the
+    ///     port, the read returns all 1s. A 4 byte read also clears the
+    ///     upper half of RAX.
+    ///
+    /// <!-- inputs/outputs -->
+    ///   @param rax the value of RAX before the read
+    ///   @param bytes the number of bytes read (1, 2 or 4)
+    ///   @return Returns the value of RAX after the read.
+    ///
+    [[nodiscard]] constexpr auto
+    iopm_ignored_read(bsl::safe_u64 const &rax, bsl::safe_u64 const &bytes) noexcept
+        -> bsl::safe_u64
+    {
+        constexpr auto bytes4{4_u64};
+        auto const mask{((1_u64 << (bytes * IOPM_BITS_PER_BYTE)) - 1_u64).checked()};
+
+        if (bytes4 == bytes) {
+            return mask;
+        }
+
+        return (rax | mask).checked();
+    }
+
+    /// @class microv::iopm_t
+    ///
+    /// <!-- description -->
+    ///   @brief Defines the IO permissions map of a guest VM. Each port
+    ///     has an IO intercept type (MV_IO_INTERCEPT_xxx). Ports that exit
+    ///     or that are ignored are intercepted by the hardware map, and a
+    ///     second map records which of the intercepted ports MicroV
+    ///     handles itself so that they never exit to software. By default,
+    ///     every port exits except for the POST code port, which is
+    ///     ignored. Only the POST code port can be passed through.
+    ///
+    ///   @note IMPORTANT: This class is a per-VM class. Both maps are
+    ///     allocated the first time the VM is allocated and are reused by
+    ///     the VM after that as the microkernel does not provide a way to
+    ///     free physically contiguous memory.
+    ///
+    class iopm_t final
+    {
+        /// @brief stores the IO permissions map used by hardware
+        bsl::span<bsl::uint8> m_iopm{};
+        /// @brief stores the SPA of the IO permissions map
+        bsl::safe_u64 m_iopm_spa{};
+        /// @brief stores which ports are ignored by MicroV
+        bsl::span<bsl::uint8> m_ignored{};
+        /// @brief stores the SPA of the map of ignored ports (not used by hardware)
+        bsl::safe_u64 m_ignored_spa{};
+
+        /// <!-- description -->
+        ///   @brief Sets or clears the bit for the provided port in the
+        ///     provided map.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param mut_map the map to modify
+        ///   @param port the port to modify
+        ///   @param set if true, the bit is set, otherwise it is cleared
+        ///
+        static constexpr void
+        set_bit(bsl::span<bsl::uint8> &mut_map, bsl::safe_u64 const &port, bool const set) noexcept
+        {
+            auto const idx{bsl::to_idx((port / IOPM_BITS_PER_BYTE).checked())};
+            auto const mask{bsl::to_u8(1_u64 << (port % IOPM_BITS_PER_BYTE).checked())};
+
+            auto *const pmut_byte{mut_map.at_if(idx)};
+            bsl::expects(nullptr != pmut_byte);
+
+            if (set) {
+                *pmut_byte = (bsl::safe_u8{*pmut_byte} | mask).get();
+            }
+            else {
+                *pmut_byte = (bsl::safe_u8{*pmut_byte} & ~mask).get();
+            }
+        }
+
+        /// <!-- description -->
+        ///   @brief Returns true if the provided port is ignored by
+        ///     MicroV. Returns false otherwise.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param port the port to query
+        ///   @return Returns true if the provided port is ignored by
+        ///     MicroV. Returns false otherwise.
+        ///
+        [[nodiscard]] constexpr auto
+        is_port_ignored(bsl::safe_u64 const &port) const noexcept -> bool
+        {
+            auto const idx{bsl::to_idx((port / IOPM_BITS_PER_BYTE).checked())};
+            auto const mask{bsl::to_u8(1_u64 << (port % IOPM_BITS_PER_BYTE).checked())};
+
+            auto const *const byte{m_ignored.at_if(idx)};
+            bsl::expects(nullptr != byte);
+
+            return (bsl::safe_u8{*byte} & mask).is_pos();
+        }
+
+    public:
+        /// <!-- description -->
+        ///   @brief Allocates the IO permissions map if needed and resets
+        ///     it to its default state.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param mut_sys the bf_syscall_t to use
+        ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+        ///     and friends otherwise
+        ///
+        [[nodiscard]] constexpr auto
+        allocate(syscall::bf_syscall_t &mut_sys) noexcept -> bsl::errc_type
+        {
+            if (m_iopm.is_invalid()) {
+                m_iopm = alloc_bitmap(mut_sys, IOPM_SIZE, m_iopm_spa);
+                if (bsl::unlikely(m_iopm.is_invalid())) {
+                    bsl::print<bsl::V>() << bsl::here();
+                    return bsl::errc_failure;
+                }
+            }
+            else {
+                bsl::touch();
+            }
+
+            if (m_ignored.is_invalid()) {
+                m_ignored = alloc_bitmap(mut_sys, IOPM_IGNORED_SIZE, m_ignored_spa);
+                if (bsl::unlikely(m_ignored.is_invalid())) {
+                    bsl::print<bsl::V>() << bsl::here();
+                    return bsl::errc_failure;
+                }
+            }
+            else {
+                bsl::touch();
+            }
+
+            for (auto &elem : m_iopm) {
+                elem = bsl::safe_u8::max_value().get();
+            }
+
+            for (auto &elem : m_ignored) {
+                elem = {};
+            }
+
+            auto const ret{
+                this->intercept(IOPM_POST_PORT, IOPM_POST_PORT, hypercall::MV_IO_INTERCEPT_IGNORE)};
+            bsl::expects(ret);
+
+            return bsl::errc_success;
+        }
+
+        /// <!-- description -->
+        ///   @brief Returns the SPA of the IO permissions map.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @return Returns the SPA of the IO permissions map.
+        ///
+        [[nodiscard]] constexpr auto
+        spa() const noexcept -> bsl::safe_u64
+        {
+            bsl::ensures(m_iopm_spa.is_valid_and_checked());
+            return m_iopm_spa;
+        }
+
+        /// <!-- description -->
+        ///   @brief Sets the IO intercept type (MV_IO_INTERCEPT_xxx) of
+        ///     every port from first to last (inclusive). If a port cannot
+        ///     be passed through, this function fails and the IO
+        ///     permissions map is left unchanged.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param first the first port to modify
+        ///   @param last the last port to modify
+        ///   @param type the IO intercept type to use
+        ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+        ///     and friends otherwise
+        ///
+        [[nodiscard]] constexpr auto
+        intercept(
+            bsl::safe_u64 const &first,
+            bsl::safe_u64 const &last,
+            bsl::safe_u64 const &type) noexcept -> bsl::errc_type
+        {
+            bsl::expects(first.is_valid_and_checked());
+            bsl::expects(last.is_valid_and_checked());
+            bsl::expects(type.is_valid_and_checked());
+            bsl::expects(m_iopm.is_valid());
+
+            if (bsl::unlikely(first > last || last >= IOPM_NUM_PORTS)) {
+                bsl::error() << "invalid port range "    // --
+                             << bsl::hex(first)          // --
+                             << "-"                      // --
+                             << bsl::hex(last)           // --
+                             << bsl::endl                // --
+                             << bsl::here();             // --
+
+                return bsl::errc_failure;
+            }
+
+            if (bsl::unlikely(type > hypercall::MV_IO_INTERCEPT_PASSTHROUGH)) {
+                bsl::error() << "invalid io intercept type "    // --
+                             << bsl::hex(type)                  // --
+                             << bsl::endl                       // --
+                             << bsl::here();                    // --
+
+                return bsl::errc_failure;
+            }
+
+            bool const passthrough{hypercall::MV_IO_INTERCEPT_PASSTHROUGH == type};
+            bool const post{IOPM_POST_PORT == first && IOPM_POST_PORT == last};
+            if (bsl::unlikely(passthrough && !post)) {
+                bsl::error() << "port range "                  // --
+                             << bsl::hex(first)                // --
+                             << "-"                            // --
+                             << bsl::hex(last)                 // --
+                             << " cannot be passed through"    // --
+                             << bsl::endl                      // --
+                             << bsl::here();                   // --
+
+                return bsl::errc_failure;
+            }
+
+            bool const ignored{hypercall::MV_IO_INTERCEPT_IGNORE == type};
+
+            for (auto mut_port{first}; mut_port <= last; ++mut_port) {
+                set_bit(m_iopm, mut_port, !passthrough);
+                set_bit(m_ignored, mut_port, ignored);
+            }
+
+            return bsl::errc_success;
+        }
+
+        /// <!-- description -->
+        ///   @brief Returns true if every port touched by an access of the
+        ///     provided number of bytes to the provided port is ignored by
+        ///     MicroV. Returns false otherwise.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param port the port that was accessed
+        ///   @param bytes the number of bytes that were accessed
+        ///   @return Returns true if every port touched by the access is
+        ///     ignored by MicroV. Returns false otherwise.
+        ///
+        [[nodiscard]] constexpr auto
+        is_ignored(bsl::safe_u64 const &port, bsl::safe_u64 const &bytes) const noexcept -> bool
+        {
+            bsl::expects(port.is_valid_and_checked());
+            bsl::expects(bytes.is_valid_and_checked());
+
+            if (m_ignored.is_invalid()) {
+                return false;
+            }
+
+            for (bsl::safe_u64 mut_i{}; mut_i < bytes; ++mut_i) {
+                auto const next{(port + mut_i).checked()};
+                if (next >= IOPM_NUM_PORTS) {
+                    return false;
+                }
+
+                if (!this->is_port_ignored(next)) {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,96 @@
+/// @copyright
+/// Copyright (C) 2020 Assured Information Security, Inc.
+///
+/// @copyright
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// @copyright
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// @copyright
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+
+#ifndef MSR_CONSTANTS_HPP
+#define MSR_CONSTANTS_HPP
+
+#include <bsl/safe_integral.hpp>
+
+namespace microv
+{
+    /// @brief defines the IA32_PLATFORM_ID MSR
+    constexpr auto MSR_PLATFORM_ID{0x00000017_u32};
+    /// @brief defines the IA32_APIC_BASE MSR
+    constexpr auto MSR_APIC_BASE{0x0000001B_u32};
+    /// @brief defines the IA32_FEATURE_CONTROL MSR
+    constexpr auto MSR_FEATURE_CONTROL{0x0000003A_u32};
+    /// @brief defines the IA32_PRED_CMD MSR
+    constexpr auto MSR_PRED_CMD{0x00000049_u32};
+    /// @brief defines the IA32_BIOS_SIGN_ID MSR
+    constexpr auto MSR_BIOS_SIGN_ID{0x0000008B_u32};
+    /// @brief defines the IA32_MTRRCAP MSR
+    constexpr auto MSR_MTRRCAP{0x000000FE_u32};
+    /// @brief defines the IA32_SYSENTER_CS MSR
+    constexpr auto MSR_SYSENTER_CS{0x00000174_u32};
+    /// @brief defines the IA32_SYSENTER_ESP MSR
+    constexpr auto MSR_SYSENTER_ESP{0x00000175_u32};
+    /// @brief defines the IA32_SYSENTER_EIP MSR
+    constexpr auto MSR_SYSENTER_EIP{0x00000176_u32};
+    /// @brief defines the IA32_MCG_CAP MSR
+    constexpr auto MSR_MCG_CAP{0x00000179_u32};
+    /// @brief defines the IA32_MCG_STATUS MSR
+    constexpr auto MSR_MCG_STATUS{0x0000017A_u32};
+    /// @brief defines the IA32_MISC_ENABLE MSR
+    constexpr auto MSR_MISC_ENABLE{0x000001A0_u32};
+    /// @brief defines the IA32_MTRR_PHYSBASE0 MSR
+    constexpr auto MSR_MTRR_PHYSBASE0{0x00000200_u32};
+    /// @brief defines the IA32_MTRR_FIX64K_00000 MSR
+    constexpr auto MSR_MTRR_FIX64K_00000{0x00000250_u32};
+    /// @brief defines the IA32_MTRR_FIX16K_80000 MSR
+    constexpr auto MSR_MTRR_FIX16K_80000{0x00000258_u32};
+    /// @brief defines the IA32_MTRR_FIX4K_C0000 MSR
+    constexpr auto MSR_MTRR_FIX4K_C0000{0x00000268_u32};
+    /// @brief defines the IA32_PAT MSR
+    constexpr auto MSR_PAT{0x00000277_u32};
+    /// @brief defines the IA32_MTRR_DEF_TYPE MSR
+    constexpr auto MSR_MTRR_DEF_TYPE{0x000002FF_u32};
+    /// @brief defines the IA32_TSC_DEADLINE MSR
+    constexpr auto MSR_TSC_DEADLINE{0x000006E0_u32};
+    /// @brief defines the MSR_KVM_WALL_CLOCK_NEW MSR
+    constexpr auto MSR_KVM_WALL_CLOCK_NEW{0x4B564D00_u32};
+    /// @brief defines the MSR_KVM_SYSTEM_TIME_NEW MSR
+    constexpr auto MSR_KVM_SYSTEM_TIME_NEW{0x4B564D01_u32};
+    /// @brief defines the MSR_KVM_STEAL_TIME MSR
+    constexpr auto MSR_KVM_STEAL_TIME{0x4B564D03_u32};
+    /// @brief defines the IA32_EFER MSR
+    constexpr auto MSR_EFER{0xC0000080_u32};
+    /// @brief defines the IA32_STAR MSR
+    constexpr auto MSR_STAR{0xC0000081_u32};
+    /// @brief defines the IA32_LSTAR MSR
+    constexpr auto MSR_LSTAR{0xC0000082_u32};
+    /// @brief defines the IA32_CSTAR MSR
+    constexpr auto MSR_CSTAR{0xC0000083_u32};
+    /// @brief defines the IA32_FMASK MSR
+    constexpr auto MSR_FMASK{0xC0000084_u32};
+    /// @brief defines the IA32_FS_BASE MSR
+    constexpr auto MSR_FS_BASE{0xC0000100_u32};
+    /// @brief defines the IA32_GS_BASE MSR
+    constexpr auto MSR_GS_BASE{0xC0000101_u32};
+    /// @brief defines the IA32_KERNEL_GS_BASE MSR
+    constexpr auto MSR_KERNEL_GS_BASE{0xC0000102_u32};
+    /// @brief defines the IA32_TSC_AUX MSR
+    constexpr auto MSR_TSC_AUX{0xC0000103_u32};
+}
+
+#endif
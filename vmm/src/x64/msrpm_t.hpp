@@ -0,0 +1,439 @@
+/// @copyright
+/// Copyright (C) 2020 Assured Information Security, Inc.
+///
+/// @copyright
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// @copyright
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// @copyright
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+
+
+#ifndef MSRPM_T_HPP
+#define MSRPM_T_HPP
+
+#include <alloc_bitmap.hpp>
+#include <bf_syscall_t.hpp>
+#include <gs_t.hpp>
+#include <msr_constants.hpp>
+#include <msrpm_helpers.hpp>
+#include <mv_constants.hpp>
+
+#include <bsl/convert.hpp>
+#include <bsl/debug.hpp>
+#include <bsl/ensures.hpp>
+#include <bsl/errc_type.hpp>
+#include <bsl/expects.hpp>
+#include <bsl/safe_idx.hpp>
+#include <bsl/safe_integral.hpp>
+#include <bsl/span.hpp>
+#include <bsl/touch.hpp>
+#include <bsl/unlikely.hpp>
+
+namespace microv
+{
+    /// @class microv::msrpm_t
+    ///
+    /// <!-- description -->
+    ///   @brief Defines the MSR permissions map of a guest VM. By default,
+    ///     every MSR access is intercepted except for the MSRs that are
+    ///     context switched with the VS, either by the VMCS/VMCB or by the
+    ///     microkernel, which are passed through. Software can intercept
+    ///     any MSR, but can only pass through MSRs that are safe to pass
+    ///     through (see passthrough_mask). A second map, with the same
+    ///     layout, records the accesses that software asked to handle
+    ///     itself (see filter). These are always intercepted.
+    ///
+    ///   @note IMPORTANT: This class is a per-VM class. Both maps are
+    ///     allocated the first time the VM is allocated and are reused by
+    ///     the VM after that as the microkernel does not provide a way to
+    ///     free physically contiguous memory.
+    ///
+    class msrpm_t final
+    {
+        /// @brief stores the MSR permissions map
+        bsl::span<bsl::uint8> m_msrpm{};
+        /// @brief stores the SPA of the MSR permissions map
+        bsl::safe_u64 m_msrpm_spa{};
+        /// @brief stores which accesses are filtered to software
+        bsl::span<bsl::uint8> m_filter{};
+        /// @brief stores the SPA of the filter map (not used by hardware)
+        bsl::safe_u64 m_filter_spa{};
+
+        /// <!-- description -->
+        ///   @brief Returns the accesses to the provided MSR that can be
+        ///     passed through as a combination of MV_PERM_READ and
+        ///     MV_PERM_WRITE. All other accesses must be intercepted.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param msr the MSR to query
+        ///   @return Returns the accesses to the provided MSR that can be
+        ///     passed through.
+        ///
+        [[nodiscard]] static constexpr auto
+        passthrough_mask(bsl::safe_u32 const &msr) noexcept -> bsl::safe_u64
+        {
+            constexpr auto all{(hypercall::MV_PERM_READ | hypercall::MV_PERM_WRITE).checked()};
+
+            switch (msr.get()) {
+                case MSR_SYSENTER_CS.get():
+                    [[fallthrough]];
+                case MSR_SYSENTER_ESP.get():
+                    [[fallthrough]];
+                case MSR_SYSENTER_EIP.get():
+                    [[fallthrough]];
+                case MSR_STAR.get():
+                    [[fallthrough]];
+                case MSR_LSTAR.get():
+                    [[fallthrough]];
+                case MSR_CSTAR.get():
+                    [[fallthrough]];
+                case MSR_FMASK.get():
+                    [[fallthrough]];
+                case MSR_FS_BASE.get():
+                    [[fallthrough]];
+                case MSR_GS_BASE.get():
+                    [[fallthrough]];
+                case MSR_KERNEL_GS_BASE.get(): {
+                    return all;
+                }
+
+                case MSR_PRED_CMD.get(): {
+                    return hypercall::MV_PERM_WRITE;
+                }
+
+                default: {
+                    break;
+                }
+            }
+
+            return {};
+        }
+
+        /// <!-- description -->
+        ///   @brief Sets or clears the provided bit in the provided map.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param mut_map the map to modify
+        ///   @param bit the bit to set or clear
+        ///   @param set if true, the bit is set, otherwise it is cleared
+        ///
+        static constexpr void
+        set_bit(bsl::span<bsl::uint8> &mut_map, bsl::safe_u64 const &bit, bool const set) noexcept
+        {
+            constexpr auto bits_per_byte{8_u64};
+
+            auto const idx{bsl::to_idx((bit / bits_per_byte).checked())};
+            auto const mask{bsl::to_u8(1_u64 << (bit % bits_per_byte).checked())};
+
+            auto *const pmut_byte{mut_map.at_if(idx)};
+            bsl::expects(nullptr != pmut_byte);
+
+            if (set) {
+                *pmut_byte = (bsl::safe_u8{*pmut_byte} | mask).get();
+            }
+            else {
+                *pmut_byte = (bsl::safe_u8{*pmut_byte} & ~mask).get();
+            }
+        }
+
+        /// <!-- description -->
+        ///   @brief Returns true if the provided bit is set in the provided
+        ///     map. Returns false otherwise.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param map the map to query
+        ///   @param bit the bit to query
+        ///   @return Returns true if the provided bit is set in the provided
+        ///     map. Returns false otherwise.
+        ///
+        [[nodiscard]] static constexpr auto
+        is_bit_set(bsl::span<bsl::uint8> const &map, bsl::safe_u64 const &bit) noexcept -> bool
+        {
+            constexpr auto bits_per_byte{8_u64};
+
+            auto const idx{bsl::to_idx((bit / bits_per_byte).checked())};
+            auto const mask{bsl::to_u8(1_u64 << (bit % bits_per_byte).checked())};
+
+            auto const *const byte{map.at_if(idx)};
+            bsl::expects(nullptr != byte);
+
+            return (bsl::safe_u8{*byte} & mask).is_pos();
+        }
+
+        /// <!-- description -->
+        ///   @brief Passes through the accesses to the provided MSR that
+        ///     are safe to pass through, intercepting all others.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param msr the MSR to pass through
+        ///
+        constexpr void
+        passthrough(bsl::safe_u32 const &msr) noexcept
+        {
+            constexpr auto all{(hypercall::MV_PERM_READ | hypercall::MV_PERM_WRITE).checked()};
+            bsl::expects(this->intercept(msr, (all & ~passthrough_mask(msr)).checked()));
+        }
+
+    public:
+        /// <!-- description -->
+        ///   @brief Allocates the MSR permissions map if needed and resets
+        ///     it to its default state.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param mut_sys the bf_syscall_t to use
+        ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+        ///     and friends otherwise
+        ///
+        [[nodiscard]] constexpr auto
+        allocate(syscall::bf_syscall_t &mut_sys) noexcept -> bsl::errc_type
+        {
+            if (m_msrpm.is_invalid()) {
+                m_msrpm = alloc_bitmap(mut_sys, MSRPM_SIZE, m_msrpm_spa);
+                if (bsl::unlikely(m_msrpm.is_invalid())) {
+                    bsl::print<bsl::V>() << bsl::here();
+                    return bsl::errc_failure;
+                }
+            }
+            else {
+                bsl::touch();
+            }
+
+            if (m_filter.is_invalid()) {
+                m_filter = alloc_bitmap(mut_sys, MSRPM_SIZE, m_filter_spa);
+                if (bsl::unlikely(m_filter.is_invalid())) {
+                    bsl::print<bsl::V>() << bsl::here();
+                    return bsl::errc_failure;
+                }
+            }
+            else {
+                bsl::touch();
+            }
+
+            for (auto &elem : m_msrpm) {
+                elem = bsl::safe_u8::max_value().get();
+            }
+
+            for (auto &elem : m_filter) {
+                elem = {};
+            }
+
+            this->passthrough(MSR_SYSENTER_CS);
+            this->passthrough(MSR_SYSENTER_ESP);
+            this->passthrough(MSR_SYSENTER_EIP);
+            this->passthrough(MSR_PRED_CMD);
+            this->passthrough(MSR_STAR);
+            this->passthrough(MSR_LSTAR);
+            this->passthrough(MSR_CSTAR);
+            this->passthrough(MSR_FMASK);
+            this->passthrough(MSR_FS_BASE);
+            this->passthrough(MSR_GS_BASE);
+            this->passthrough(MSR_KERNEL_GS_BASE);
+
+            return bsl::errc_success;
+        }
+
+        /// <!-- description -->
+        ///   @brief Returns the SPA of the MSR permissions map.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @return Returns the SPA of the MSR permissions map.
+        ///
+        [[nodiscard]] constexpr auto
+        spa() const noexcept -> bsl::safe_u64
+        {
+            bsl::ensures(m_msrpm_spa.is_valid_and_checked());
+            return m_msrpm_spa;
+        }
+
+        /// <!-- description -->
+        ///   @brief Intercepts the provided accesses to the provided MSR
+        ///     and passes through the rest. Accesses are described using
+        ///     MV_PERM_READ and MV_PERM_WRITE. If an access that is not safe
+        ///     to pass through is not intercepted, or the MSR cannot be
+        ///     passed through, this function fails and the MSR permissions
+        ///     map is left unchanged. Accesses that are filtered (see
+        ///     filter) stay intercepted.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param msr the MSR to modify
+        ///   @param perms the accesses to intercept
+        ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+        ///     and friends otherwise
+        ///
+        [[nodiscard]] constexpr auto
+        intercept(bsl::safe_u32 const &msr, bsl::safe_u64 const &perms) noexcept
+            -> bsl::errc_type
+        {
+            constexpr auto all{(hypercall::MV_PERM_READ | hypercall::MV_PERM_WRITE).checked()};
+
+            bsl::expects(msr.is_valid_and_checked());
+            bsl::expects(perms.is_valid_and_checked());
+            bsl::expects(m_msrpm.is_valid());
+
+            auto const passed{(all & ~perms).checked()};
+            if (bsl::unlikely((passed & ~passthrough_mask(msr)).is_pos())) {
+                bsl::error() << "msr "                               // --
+                             << bsl::hex(msr)                        // --
+                             << " cannot be passed through with "    // --
+                             << bsl::hex(perms)                      // --
+                             << bsl::endl                            // --
+                             << bsl::here();                         // --
+
+                return bsl::errc_failure;
+            }
+
+            auto const read_bit{msrpm_read_bit(msr)};
+            auto const write_bit{msrpm_write_bit(msr)};
+
+            if (read_bit.is_invalid()) {
+                return bsl::errc_success;
+            }
+
+            bool const read{(perms & hypercall::MV_PERM_READ).is_pos()};
+            bool const write{(perms & hypercall::MV_PERM_WRITE).is_pos()};
+
+            set_bit(m_msrpm, read_bit, read || is_bit_set(m_filter, read_bit));
+            set_bit(m_msrpm, write_bit, write || is_bit_set(m_filter, write_bit));
+
+            return bsl::errc_success;
+        }
+
+        /// <!-- description -->
+        ///   @brief Filters the provided accesses to every MSR from first
+        ///     to last (inclusive) to software and removes the rest from
+        ///     the filter. Accesses are described using MV_PERM_READ and
+        ///     MV_PERM_WRITE. Filtered accesses are intercepted. Removing
+        ///     an access from the filter does not pass it through again.
+        ///     Every MSR in the range must be covered by the MSR
+        ///     permissions map, otherwise this function fails and both
+        ///     maps are left unchanged.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param first the first MSR to modify
+        ///   @param last the last MSR to modify
+        ///   @param perms the accesses to filter
+        ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+        ///     and friends otherwise
+        ///
+        [[nodiscard]] constexpr auto
+        filter(
+            bsl::safe_u32 const &first,
+            bsl::safe_u32 const &last,
+            bsl::safe_u64 const &perms) noexcept -> bsl::errc_type
+        {
+            constexpr auto all{(hypercall::MV_PERM_READ | hypercall::MV_PERM_WRITE).checked()};
+
+            bsl::expects(first.is_valid_and_checked());
+            bsl::expects(last.is_valid_and_checked());
+            bsl::expects(perms.is_valid_and_checked());
+            bsl::expects(m_msrpm.is_valid());
+
+            /// NOTE:
+            /// - The ranges covered by the map are far apart, so if both
+            ///   ends of a range that is smaller than one of them are
+            ///   covered, every MSR in between is covered as well.
+            ///
+
+            bool const covered{msrpm_read_bit(first).is_valid() && msrpm_read_bit(last).is_valid()};
+            if (bsl::unlikely(
+                    !covered || first > last || (last - first).checked() >= MSRPM_RANGE_SIZE)) {
+                bsl::error() << "msr range "             // --
+                             << bsl::hex(first)          // --
+                             << "-"                      // --
+                             << bsl::hex(last)           // --
+                             << " cannot be filtered"    // --
+                             << bsl::endl                // --
+                             << bsl::here();             // --
+
+                return bsl::errc_failure;
+            }
+
+            if (bsl::unlikely((perms & ~all).is_pos())) {
+                bsl::error() << "invalid msr filter permissions "    // --
+                             << bsl::hex(perms)                      // --
+                             << bsl::endl                            // --
+                             << bsl::here();                         // --
+
+                return bsl::errc_failure;
+            }
+
+            bool const read{(perms & hypercall::MV_PERM_READ).is_pos()};
+            bool const write{(perms & hypercall::MV_PERM_WRITE).is_pos()};
+
+            for (auto mut_msr{first}; mut_msr <= last; ++mut_msr) {
+                auto const read_bit{msrpm_read_bit(mut_msr)};
+                auto const write_bit{msrpm_write_bit(mut_msr)};
+
+                set_bit(m_filter, read_bit, read);
+                set_bit(m_filter, write_bit, write);
+
+                if (read) {
+                    set_bit(m_msrpm, read_bit, true);
+                }
+                else {
+                    bsl::touch();
+                }
+
+                if (write) {
+                    set_bit(m_msrpm, write_bit, true);
+                }
+                else {
+                    bsl::touch();
+                }
+            }
+
+            return bsl::errc_success;
+        }
+
+        /// <!-- description -->
+        ///   @brief Returns true if the provided access to the provided MSR
+        ///     is filtered to software. Returns false otherwise.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param msr the MSR that was accessed
+        ///   @param perm the access (MV_PERM_READ or MV_PERM_WRITE)
+        ///   @return Returns true if the provided access to the provided
+        ///     MSR is filtered to software. Returns false otherwise.
+        ///
+        [[nodiscard]] constexpr auto
+        is_filtered(bsl::safe_u32 const &msr, bsl::safe_u64 const &perm) const noexcept -> bool
+        {
+            bsl::expects(msr.is_valid_and_checked());
+
+            if (m_filter.is_invalid()) {
+                return false;
+            }
+
+            bsl::safe_u64 mut_bit{};
+            if (hypercall::MV_PERM_READ == perm) {
+                mut_bit = msrpm_read_bit(msr);
+            }
+            else {
+                mut_bit = msrpm_write_bit(msr);
+            }
+
+            if (mut_bit.is_invalid()) {
+                return false;
+            }
+
+            return is_bit_set(m_filter, mut_bit);
+        }
+    };
+}
+
+#endif
@@ -22,30 +22,405 @@
 /// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 /// SOFTWARE.
 
+
 #ifndef PP_CPUID_T_HPP
 #define PP_CPUID_T_HPP
 
 #include <bf_syscall_t.hpp>
 #include <gs_t.hpp>
 #include <intrinsic_t.hpp>
+#include <mv_cdl_t.hpp>
+#include <mv_cpuid_flag_t.hpp>
 #include <tls_t.hpp>
 
+#include <bsl/array.hpp>
+#include <bsl/convert.hpp>
 #include <bsl/debug.hpp>
 #include <bsl/discard.hpp>
+#include <bsl/ensures.hpp>
 #include <bsl/errc_type.hpp>
+#include <bsl/expects.hpp>
+#include <bsl/safe_idx.hpp>
+#include <bsl/safe_integral.hpp>
+#include <bsl/touch.hpp>
 #include <bsl/unlikely.hpp>
 
 namespace microv
 {
+    /// @brief defines the max number of CPUID leaves cached by a pp_cpuid_t
+    constexpr auto PP_CPUID_MAX_ENTRIES{hypercall::MV_CDL_MAX_ENTRIES};
+    /// @brief defines the last basic CPUID leaf cached by a pp_cpuid_t
+    constexpr auto PP_CPUID_BASIC_MAX{0x0000001F_u32};
+    /// @brief defines the first extended CPUID leaf
+    constexpr auto PP_CPUID_EXTENDED_BASE{0x80000000_u32};
+    /// @brief defines the last extended CPUID leaf cached by a pp_cpuid_t
+    constexpr auto PP_CPUID_EXTENDED_MAX{0x80000021_u32};
+    /// @brief defines the max number of subleaves cached for a single leaf
+    constexpr auto PP_CPUID_MAX_SUBLEAVES{0x40_u32};
+
+    /// @brief defines CPUID.01H, which reports the basic feature bits
+    constexpr auto PP_CPUID_FEATURE_LEAF{0x00000001_u32};
+    /// @brief defines CPUID.04H, which reports the deterministic cache parameters
+    constexpr auto PP_CPUID_CACHE_LEAF{0x00000004_u32};
+    /// @brief defines CPUID.07H, which reports the structured extended feature bits
+    constexpr auto PP_CPUID_EXTENDED_FEATURE_LEAF{0x00000007_u32};
+    /// @brief defines CPUID.0BH, which reports the extended topology
+    constexpr auto PP_CPUID_TOPOLOGY_LEAF{0x0000000B_u32};
+    /// @brief defines CPUID.0DH, which reports the XSAVE features
+    constexpr auto PP_CPUID_XSAVE_LEAF{0x0000000D_u32};
+    /// @brief defines CPUID.14H, which reports the processor trace features
+    constexpr auto PP_CPUID_TRACE_LEAF{0x00000014_u32};
+    /// @brief defines CPUID.1FH, which reports the V2 extended topology
+    constexpr auto PP_CPUID_TOPOLOGY_V2_LEAF{0x0000001F_u32};
+    /// @brief defines CPUID.80000001H, which reports the extended feature bits
+    constexpr auto PP_CPUID_EXTENDED_FEATURE_FUN{0x80000001_u32};
+
+    /// @brief defines CPUID.01H:EBX[31:24], the initial APIC ID of the PP
+    constexpr auto PP_CPUID_APIC_ID_MASK{0xFF000000_u32};
+    /// @brief defines CPUID.01H:ECX[5], VMX, which MicroV does not support
+    constexpr auto PP_CPUID_VMX_BIT{0x00000020_u32};
+    /// @brief defines CPUID.01H:ECX[6], SMX, which MicroV does not support
+    constexpr auto PP_CPUID_SMX_BIT{0x00000040_u32};
+    /// @brief defines CPUID.01H:ECX[31], the hypervisor bit
+    constexpr auto PP_CPUID_HYPERVISOR_BIT{0x80000000_u32};
+    /// @brief defines CPUID.80000001H:ECX[2], SVM, which MicroV does not support
+    constexpr auto PP_CPUID_SVM_BIT{0x00000004_u32};
+    /// @brief defines CPUID.04H:EAX[4:0], the cache type (0 means no more caches)
+    constexpr auto PP_CPUID_CACHE_TYPE_MASK{0x0000001F_u32};
+    /// @brief defines CPUID.0BH:ECX[15:8], the level type (0 means invalid)
+    constexpr auto PP_CPUID_LEVEL_TYPE_MASK{0x0000FF00_u32};
+    /// @brief defines the first XSAVE subleaf that describes a state component
+    constexpr auto PP_CPUID_XSAVE_FIRST_COMPONENT{0x00000002_u32};
+
+    /// @brief defines the KVM signature leaf (returns "KVMKVMKVM")
+    constexpr auto PP_CPUID_KVM_SIGNATURE_LEAF{0x40000000_u32};
+    /// @brief defines the KVM features leaf
+    constexpr auto PP_CPUID_KVM_FEATURES_LEAF{0x40000001_u32};
+    /// @brief defines the "KVMK" part of the KVM signature
+    constexpr auto PP_CPUID_KVM_SIGNATURE_EBX{0x4B4D564B_u32};
+    /// @brief defines the "VMKV" part of the KVM signature
+    constexpr auto PP_CPUID_KVM_SIGNATURE_ECX{0x564B4D56_u32};
+    /// @brief defines the "M" part of the KVM signature
+    constexpr auto PP_CPUID_KVM_SIGNATURE_EDX{0x0000004D_u32};
+    /// @brief defines KVM_FEATURE_CLOCKSOURCE2 (MSR_KVM_SYSTEM_TIME_NEW)
+    constexpr auto PP_CPUID_KVM_FEATURE_CLOCKSOURCE2{0x00000008_u32};
+    /// @brief defines KVM_FEATURE_CLOCKSOURCE_STABLE_BIT (PVCLOCK_TSC_STABLE_BIT)
+    constexpr auto PP_CPUID_KVM_FEATURE_CLOCKSOURCE_STABLE_BIT{0x01000000_u32};
+    /// @brief defines KVM_FEATURE_PV_UNHALT (KVM_HC_KICK_CPU)
+    constexpr auto PP_CPUID_KVM_FEATURE_PV_UNHALT{0x00000080_u32};
+    /// @brief defines KVM_FEATURE_STEAL_TIME (MSR_KVM_STEAL_TIME)
+    constexpr auto PP_CPUID_KVM_FEATURE_STEAL_TIME{0x00000020_u32};
+    /// @brief defines KVM_FEATURE_PV_TLB_FLUSH (STEAL_TIME_FLUSH_TLB)
+    constexpr auto PP_CPUID_KVM_FEATURE_PV_TLB_FLUSH{0x00000200_u32};
+    /// @brief defines the paravirtual features MicroV supports
+    constexpr auto PP_CPUID_KVM_FEATURES{
+        PP_CPUID_KVM_FEATURE_CLOCKSOURCE2 | PP_CPUID_KVM_FEATURE_STEAL_TIME |
+        PP_CPUID_KVM_FEATURE_PV_UNHALT | PP_CPUID_KVM_FEATURE_PV_TLB_FLUSH |
+        PP_CPUID_KVM_FEATURE_CLOCKSOURCE_STABLE_BIT};
+
     /// @class microv::pp_cpuid_t
     ///
     /// <!-- description -->
-    ///   @brief Defines MicroV's physical processor CPUID handler.
+    ///   @brief Defines MicroV's physical processor CPUID handler. When
+    ///     the PP is allocated, the CPUID leaves of the PP are executed
+    ///     once, filtered down to what MicroV supports and cached, so
+    ///     that the list of supported leaves can be returned without
+    ///     having to execute CPUID again.
     ///
     class pp_cpuid_t final
     {
         /// @brief stores the ID of the PP associated with this pp_cpuid_t
         bsl::safe_u16 m_assigned_ppid{};
+        /// @brief stores the supported CPUID leaves of this PP
+        bsl::array<hypercall::mv_cdl_entry_t, PP_CPUID_MAX_ENTRIES.get()> m_supported{};
+        /// @brief stores the number of entries in m_supported
+        bsl::safe_idx m_num_supported{};
+
+        /// <!-- description -->
+        ///   @brief Executes CPUID and returns the result as a
+        ///     mv_cdl_entry_t.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param intrinsic the intrinsic_t to use
+        ///   @param fun the CPUID function to execute
+        ///   @param idx the CPUID index to execute
+        ///   @param flags the flags to store in the resulting entry
+        ///   @return Returns the result of executing CPUID
+        ///
+        [[nodiscard]] static constexpr auto
+        read(
+            intrinsic_t const &intrinsic,
+            bsl::safe_u32 const &fun,
+            bsl::safe_u32 const &idx,
+            hypercall::mv_cpuid_flag_t const flags) noexcept -> hypercall::mv_cdl_entry_t
+        {
+            auto mut_rax{bsl::to_u64(fun)};
+            bsl::safe_u64 mut_rbx{};
+            auto mut_rcx{bsl::to_u64(idx)};
+            bsl::safe_u64 mut_rdx{};
+            intrinsic.cpuid(mut_rax, mut_rbx, mut_rcx, mut_rdx);
+
+            return {
+                fun.get(),
+                idx.get(),
+                flags,
+                bsl::to_u32_unsafe(mut_rax).get(),
+                bsl::to_u32_unsafe(mut_rbx).get(),
+                bsl::to_u32_unsafe(mut_rcx).get(),
+                bsl::to_u32_unsafe(mut_rdx).get(),
+                {}};
+        }
+
+        /// <!-- description -->
+        ///   @brief Removes the features that MicroV does not allow a
+        ///     guest to use from the provided entry, and sets the
+        ///     hypervisor bit.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param mut_entry the entry to filter
+        ///
+        static constexpr void
+        filter(hypercall::mv_cdl_entry_t &mut_entry) noexcept
+        {
+            if (PP_CPUID_FEATURE_LEAF == mut_entry.fun) {
+                mut_entry.ebx &= (~PP_CPUID_APIC_ID_MASK).get();
+                mut_entry.ecx &= (~(PP_CPUID_VMX_BIT | PP_CPUID_SMX_BIT)).get();
+                mut_entry.ecx |= PP_CPUID_HYPERVISOR_BIT.get();
+                return;
+            }
+
+            if (PP_CPUID_EXTENDED_FEATURE_FUN == mut_entry.fun) {
+                mut_entry.ecx &= (~PP_CPUID_SVM_BIT).get();
+                return;
+            }
+
+            bsl::touch();
+        }
+
+        /// <!-- description -->
+        ///   @brief Returns true if the provided leaf has subleaves that
+        ///     are selected using the CPUID index. Returns false otherwise.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param fun the CPUID function to query
+        ///   @return Returns true if the provided leaf has subleaves that
+        ///     are selected using the CPUID index. Returns false otherwise.
+        ///
+        [[nodiscard]] static constexpr auto
+        has_subleaves(bsl::safe_u32 const &fun) noexcept -> bool
+        {
+            switch (fun.get()) {
+                case PP_CPUID_CACHE_LEAF.get():
+                case PP_CPUID_EXTENDED_FEATURE_LEAF.get():
+                case PP_CPUID_TOPOLOGY_LEAF.get():
+                case PP_CPUID_XSAVE_LEAF.get():
+                case PP_CPUID_TRACE_LEAF.get():
+                case PP_CPUID_TOPOLOGY_V2_LEAF.get(): {
+                    return true;
+                }
+
+                default: {
+                    break;
+                }
+            }
+
+            return false;
+        }
+
+        /// <!-- description -->
+        ///   @brief Returns true if the provided subleaf is reported by
+        ///     the PP and should be cached. Returns false otherwise.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param sub0 the result of executing CPUID with an index of 0
+        ///   @param entry the subleaf to check
+        ///   @return Returns true if the provided subleaf is reported by
+        ///     the PP and should be cached. Returns false otherwise.
+        ///
+        [[nodiscard]] static constexpr auto
+        is_subleaf_present(
+            hypercall::mv_cdl_entry_t const &sub0, hypercall::mv_cdl_entry_t const &entry) noexcept
+            -> bool
+        {
+            switch (entry.fun) {
+                case PP_CPUID_CACHE_LEAF.get(): {
+                    return (entry.eax & PP_CPUID_CACHE_TYPE_MASK.get()) != 0U;
+                }
+
+                case PP_CPUID_TOPOLOGY_LEAF.get():
+                case PP_CPUID_TOPOLOGY_V2_LEAF.get(): {
+                    return (entry.ecx & PP_CPUID_LEVEL_TYPE_MASK.get()) != 0U;
+                }
+
+                case PP_CPUID_XSAVE_LEAF.get(): {
+                    if (entry.idx < PP_CPUID_XSAVE_FIRST_COMPONENT.get()) {
+                        return true;
+                    }
+
+                    return 0U != entry.eax;
+                }
+
+                default: {
+                    break;
+                }
+            }
+
+            return !(entry.idx > sub0.eax);
+        }
+
+        /// <!-- description -->
+        ///   @brief Filters and adds the provided entry to the list of
+        ///     supported CPUID leaves.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param entry the entry to add
+        ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+        ///     if the list of supported CPUID leaves is full.
+        ///
+        [[nodiscard]] constexpr auto
+        push(hypercall::mv_cdl_entry_t const &entry) noexcept -> bsl::errc_type
+        {
+            auto *const pmut_entry{m_supported.at_if(m_num_supported)};
+            if (bsl::unlikely(nullptr == pmut_entry)) {
+                bsl::error() << "unable to cache cpuid leaf "      // --
+                             << bsl::hex(entry.fun)                // --
+                             << ":"                                // --
+                             << bsl::hex(entry.idx)                // --
+                             << " on pp "                          // --
+                             << bsl::hex(this->assigned_ppid())    // --
+                             << " as the cache is full"            // --
+                             << bsl::endl                          // --
+                             << bsl::here();                       // --
+
+                return bsl::errc_failure;
+            }
+
+            *pmut_entry = entry;
+            filter(*pmut_entry);
+
+            ++m_num_supported;
+            return bsl::errc_success;
+        }
+
+        /// <!-- description -->
+        ///   @brief Executes CPUID for the provided leaf, including all of
+        ///     its subleaves, and adds the results to the list of
+        ///     supported CPUID leaves.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param intrinsic the intrinsic_t to use
+        ///   @param fun the CPUID function to add
+        ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+        ///     if the list of supported CPUID leaves is full.
+        ///
+        [[nodiscard]] constexpr auto
+        push_leaf(intrinsic_t const &intrinsic, bsl::safe_u32 const &fun) noexcept
+            -> bsl::errc_type
+        {
+            constexpr auto reserved{hypercall::mv_cpuid_flag_t::mv_cpuid_flag_t_reserved};
+            constexpr auto significant{
+                hypercall::mv_cpuid_flag_t::mv_cpuid_flag_t_significant_index};
+
+            if (!has_subleaves(fun)) {
+                return this->push(read(intrinsic, fun, {}, reserved));
+            }
+
+            auto const sub0{read(intrinsic, fun, {}, significant)};
+            for (auto mut_idx{bsl::safe_u32::magic_0()}; mut_idx < PP_CPUID_MAX_SUBLEAVES;
+                 ++mut_idx) {
+                auto const entry{read(intrinsic, fun, mut_idx, significant)};
+                if (is_subleaf_present(sub0, entry)) {
+                    auto const ret{this->push(entry)};
+                    if (bsl::unlikely(!ret)) {
+                        bsl::print<bsl::V>() << bsl::here();
+                        return ret;
+                    }
+
+                    bsl::touch();
+                }
+                else {
+                    bsl::touch();
+                }
+            }
+
+            return bsl::errc_success;
+        }
+
+        /// <!-- description -->
+        ///   @brief Adds the KVM paravirtual leaves to the list of supported
+        ///     CPUID leaves. These are not executed on the PP as they
+        ///     describe the paravirtual features that MicroV provides
+        ///     (like the kvmclock) and not the PP itself.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+        ///     if the list of supported CPUID leaves is full.
+        ///
+        [[nodiscard]] constexpr auto
+        push_kvm_leaves() noexcept -> bsl::errc_type
+        {
+            constexpr auto reserved{hypercall::mv_cpuid_flag_t::mv_cpuid_flag_t_reserved};
+
+            auto const ret{this->push(
+                {PP_CPUID_KVM_SIGNATURE_LEAF.get(),
+                 {},
+                 reserved,
+                 PP_CPUID_KVM_FEATURES_LEAF.get(),
+                 PP_CPUID_KVM_SIGNATURE_EBX.get(),
+                 PP_CPUID_KVM_SIGNATURE_ECX.get(),
+                 PP_CPUID_KVM_SIGNATURE_EDX.get(),
+                 {}})};
+
+            if (bsl::unlikely(!ret)) {
+                bsl::print<bsl::V>() << bsl::here();
+                return ret;
+            }
+
+            return this->push(
+                {PP_CPUID_KVM_FEATURES_LEAF.get(),
+                 {},
+                 reserved,
+                 PP_CPUID_KVM_FEATURES.get(),
+                 {},
+                 {},
+                 {},
+                 {}});
+        }
+
+        /// <!-- description -->
+        ///   @brief Returns a pointer to the cached entry for the provided
+        ///     CPUID leaf. If the leaf is not supported, a nullptr is
+        ///     returned.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param fun the CPUID function to look up
+        ///   @param idx the CPUID index to look up
+        ///   @return Returns a pointer to the cached entry for the provided
+        ///     CPUID leaf. If the leaf is not supported, a nullptr is
+        ///     returned.
+        ///
+        [[nodiscard]] constexpr auto
+        find(bsl::uint32 const fun, bsl::uint32 const idx) const noexcept
+            -> hypercall::mv_cdl_entry_t const *
+        {
+            constexpr auto significant{
+                hypercall::mv_cpuid_flag_t::mv_cpuid_flag_t_significant_index};
+
+            for (bsl::safe_idx mut_i{}; mut_i < m_num_supported; ++mut_i) {
+                auto const *const entry{m_supported.at_if(mut_i)};
+                if (fun != entry->fun) {
+                    bsl::touch();
+                }
+                else if ((significant == entry->flags) && (idx != entry->idx)) {
+                    bsl::touch();
+                }
+                else {
+                    return entry;
+                }
+            }
+
+            return nullptr;
+        }
 
     public:
         /// <!-- description -->
@@ -97,9 +472,85 @@ namespace microv
             bsl::discard(sys);
             bsl::discard(intrinsic);
 
+            m_supported = {};
+            m_num_supported = {};
             m_assigned_ppid = {};
         }
 
+        /// <!-- description -->
+        ///   @brief Caches the CPUID leaves supported by this PP. This
+        ///     must be executed on the PP this pp_cpuid_t is assigned to.
+        ///     If the PP reports more leaves than can be cached, the
+        ///     remaining leaves are reported as unsupported.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param gs the gs_t to use
+        ///   @param tls the tls_t to use
+        ///   @param sys the bf_syscall_t to use
+        ///   @param intrinsic the intrinsic_t to use
+        ///
+        constexpr void
+        allocate(
+            gs_t const &gs,
+            tls_t const &tls,
+            syscall::bf_syscall_t const &sys,
+            intrinsic_t const &intrinsic) noexcept
+        {
+            constexpr auto reserved{hypercall::mv_cpuid_flag_t::mv_cpuid_flag_t_reserved};
+
+            bsl::expects(this->assigned_ppid() == sys.bf_tls_ppid());
+
+            bsl::discard(gs);
+            bsl::discard(tls);
+
+            m_supported = {};
+            m_num_supported = {};
+
+            auto mut_max{bsl::to_u32(read(intrinsic, {}, {}, reserved).eax)};
+            if (mut_max > PP_CPUID_BASIC_MAX) {
+                mut_max = PP_CPUID_BASIC_MAX;
+            }
+            else {
+                bsl::touch();
+            }
+
+            for (auto mut_fun{bsl::safe_u32::magic_0()}; !(mut_fun > mut_max); ++mut_fun) {
+                auto const ret{this->push_leaf(intrinsic, mut_fun)};
+                if (bsl::unlikely(!ret)) {
+                    bsl::print<bsl::V>() << bsl::here();
+                    return;
+                }
+
+                bsl::touch();
+            }
+
+            mut_max = bsl::to_u32(read(intrinsic, PP_CPUID_EXTENDED_BASE, {}, reserved).eax);
+            if (mut_max > PP_CPUID_EXTENDED_MAX) {
+                mut_max = PP_CPUID_EXTENDED_MAX;
+            }
+            else {
+                bsl::touch();
+            }
+
+            for (auto mut_fun{PP_CPUID_EXTENDED_BASE}; !(mut_fun > mut_max); ++mut_fun) {
+                auto const ret{this->push_leaf(intrinsic, mut_fun)};
+                if (bsl::unlikely(!ret)) {
+                    bsl::print<bsl::V>() << bsl::here();
+                    return;
+                }
+
+                bsl::touch();
+            }
+
+            auto const ret{this->push_kvm_leaves()};
+            if (bsl::unlikely(!ret)) {
+                bsl::print<bsl::V>() << bsl::here();
+            }
+            else {
+                bsl::touch();
+            }
+        }
+
         /// <!-- description -->
         ///   @brief Returns the ID of the PP associated with this
         ///     pp_cpuid_t
@@ -115,15 +566,48 @@ namespace microv
             return ~m_assigned_ppid;
         }
 
-        /// NOTE:
-        /// - supported(): Given a function (EAX) and index (ECX)
-        ///   returns a mv_cpuid_entry_t. Any feature that is supported
-        ///   is enabled in the resulting values of eax, ebx, ecx and
-        ///   edx. Any non-feature bits should be returned as 0. By
-        ///   "supported", we mean that the hardware HAS this feature,
-        ///   and MicroV allows the guest to use this feature. When
-        ///   the guest calls CPUID, MicroV will return supported.
+        /// <!-- description -->
+        ///   @brief Fills in the provided CDL using the cached CPUID leaves
+        ///     supported by this PP. If cdl.num_entries is 0, every
+        ///     supported leaf is returned. Otherwise, the eax, ebx, ecx and
+        ///     edx fields of each entry are set using the leaf that the
+        ///     entry's fun and idx fields refer to, or 0 if the leaf is not
+        ///     supported.
         ///
+        /// <!-- inputs/outputs -->
+        ///   @param mut_cdl the CDL to fill in
+        ///
+        constexpr void
+        supported_list(hypercall::mv_cdl_t &mut_cdl) const noexcept
+        {
+            bsl::expects(mut_cdl.num_entries <= mut_cdl.entries.size());
+
+            if (bsl::safe_u64::magic_0() == mut_cdl.num_entries) {
+                for (bsl::safe_idx mut_i{}; mut_i < m_num_supported; ++mut_i) {
+                    *mut_cdl.entries.at_if(mut_i) = *m_supported.at_if(mut_i);
+                }
+
+                mut_cdl.num_entries = bsl::to_u64(m_num_supported).get();
+                return;
+            }
+
+            for (bsl::safe_idx mut_i{}; mut_i < mut_cdl.num_entries; ++mut_i) {
+                auto *const pmut_entry{mut_cdl.entries.at_if(mut_i)};
+                auto const *const cached{this->find(pmut_entry->fun, pmut_entry->idx)};
+                if (nullptr == cached) {
+                    pmut_entry->eax = {};
+                    pmut_entry->ebx = {};
+                    pmut_entry->ecx = {};
+                    pmut_entry->edx = {};
+                }
+                else {
+                    pmut_entry->eax = cached->eax;
+                    pmut_entry->ebx = cached->ebx;
+                    pmut_entry->ecx = cached->ecx;
+                    pmut_entry->edx = cached->edx;
+                }
+            }
+        }
 
         /// NOTE:
         /// - emulated(): Given a function (EAX) and index (ECX)
@@ -27,20 +27,35 @@
 
 #include <allocated_status_t.hpp>
 #include <bf_syscall_t.hpp>
+#include <dirty_log_t.hpp>
 #include <emulated_ioapic_t.hpp>
 #include <emulated_mmio_t.hpp>
 #include <emulated_pic_t.hpp>
 #include <emulated_pit_t.hpp>
 #include <gs_t.hpp>
 #include <intrinsic_t.hpp>
+#include <iopm_t.hpp>
+#include <lock_guard_t.hpp>
+#include <mv_dirty_bitmap_t.hpp>
+#include <mv_dirty_ring_t.hpp>
+#include <mv_mdl_t.hpp>
+#include <msrpm_t.hpp>
 #include <mv_translation_t.hpp>
+#include <page_4k_t.hpp>
 #include <page_pool_t.hpp>
+#include <pause.hpp>
+#include <spinlock_t.hpp>
 #include <tls_t.hpp>
 
+#include <bsl/array.hpp>
 #include <bsl/discard.hpp>
 #include <bsl/ensures.hpp>
+#include <bsl/errc_type.hpp>
 #include <bsl/expects.hpp>
+#include <bsl/safe_idx.hpp>
 #include <bsl/safe_integral.hpp>
+#include <bsl/touch.hpp>
+#include <bsl/unlikely.hpp>
 
 namespace microv
 {
@@ -55,8 +70,27 @@ namespace microv
         bsl::safe_u16 m_id{};
         /// @brief stores whether or not this vm_t is allocated.
         allocated_status_t m_allocated{};
-        /// @brief stores whether or not this vm_t is active.
-        bsl::array<bool, HYPERVISOR_MAX_PPS.get()> m_active{};
+        /// @brief stores 1 for each PP this vm_t is active on (read by other PPs using xadd_u64)
+        bsl::array<bsl::safe_u64, HYPERVISOR_MAX_PPS.get()> m_active{};
+
+        /// @brief stores the current TLB flush generation (only accessed using xadd_u64)
+        bsl::safe_u64 m_tlb_generation{};
+        /// @brief stores the TLB flush generation each PP last synced with
+        bsl::array<bsl::safe_u64, HYPERVISOR_MAX_PPS.get()> m_tlb_synced{};
+        /// @brief stores whether each PP has run this vm_t since its last flush
+        bsl::array<bool, HYPERVISOR_MAX_PPS.get()> m_tlb_dirty{};
+
+        /// @brief stores the value added to the host clock to get this vm_t's kvmclock
+        bsl::safe_u64 m_clock_offset{};
+        /// @brief stores the wall clock time (in ns) when this vm_t's kvmclock was 0
+        bsl::safe_u64 m_clock_epoch{};
+        /// @brief stores the generation of this vm_t's kvmclock (see clock_set)
+        bsl::safe_u64 m_clock_generation{};
+
+        /// @brief stores the dirty log of this vm_t
+        dirty_log_t m_dirty_log{};
+        /// @brief safe guards the dirty log and the write access it controls
+        mutable spinlock_t m_dirty_log_lock{};
 
         /// @brief stores this vs_t's emulated_ioapic_t
         emulated_ioapic_t m_emulated_ioapic{};
@@ -66,6 +100,204 @@ namespace microv
         emulated_pic_t m_emulated_pic{};
         /// @brief stores this vs_t's emulated_pit_t
         emulated_pit_t m_emulated_pit{};
+        /// @brief stores this vm_t's IO permissions map
+        iopm_t m_iopm{};
+        /// @brief stores this vm_t's MSR permissions map
+        msrpm_t m_msrpm{};
+
+        /// <!-- description -->
+        ///   @brief Returns the number of dirty log entries needed to
+        ///     describe the provided number of pages.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param num_pages the number of pages to describe
+        ///   @return Returns the number of dirty log entries needed to
+        ///     describe the provided number of pages.
+        ///
+        [[nodiscard]] static constexpr auto
+        to_dirty_log_entries(bsl::safe_u64 const &num_pages) noexcept -> bsl::safe_u64
+        {
+            constexpr auto per_entry{DIRTY_LOG_PAGES_PER_ENTRY};
+            return ((num_pages + (per_entry - bsl::safe_u64::magic_1())) / per_entry).checked();
+        }
+
+        /// <!-- description -->
+        ///   @brief Returns the index of the first page in a slot that is
+        ///     described by the provided dirty log entry index, relative to
+        ///     first_page.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param first_page the page described by dirty log entry 0
+        ///   @param idx the index of the dirty log entry
+        ///   @return Returns the index of the first page in a slot that is
+        ///     described by the provided dirty log entry index.
+        ///
+        [[nodiscard]] static constexpr auto
+        to_dirty_log_page(bsl::safe_u64 const &first_page, bsl::safe_idx const &idx) noexcept
+            -> bsl::safe_u64
+        {
+            return (first_page + (bsl::to_u64(idx) * DIRTY_LOG_PAGES_PER_ENTRY)).checked();
+        }
+
+        /// <!-- description -->
+        ///   @brief Validates a dirty log range and returns the number of
+        ///     pages in the provided slot, starting with first_page, that a
+        ///     single hypercall::mv_dirty_bitmap_t describes. If the range
+        ///     is invalid, bsl::safe_u64::failure() is returned.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param slot the slot to query
+        ///   @param first_page the first page in the slot
+        ///   @return Returns the number of pages in the range, or
+        ///     bsl::safe_u64::failure() if the range is invalid.
+        ///
+        [[nodiscard]] constexpr auto
+        dirty_log_range(bsl::safe_u64 const &slot, bsl::safe_u64 const &first_page) const noexcept
+            -> bsl::safe_u64
+        {
+            auto const num_pages{m_dirty_log.num_pages(slot)};
+            if (bsl::unlikely(num_pages.is_invalid())) {
+                bsl::print<bsl::V>() << bsl::here();
+                return bsl::safe_u64::failure();
+            }
+
+            bool const aligned{(first_page % DIRTY_LOG_PAGES_PER_ENTRY).is_zero()};
+            if (bsl::unlikely(!aligned || first_page >= num_pages)) {
+                bsl::error() << "first page "              // --
+                             << bsl::hex(first_page)       // --
+                             << " is invalid for slot "    // --
+                             << bsl::hex(slot)             // --
+                             << bsl::endl                  // --
+                             << bsl::here();               // --
+
+                return bsl::safe_u64::failure();
+            }
+
+            auto const remaining{(num_pages - first_page).checked()};
+            if (remaining > hypercall::MV_DIRTY_BITMAP_MAX_PAGES) {
+                return hypercall::MV_DIRTY_BITMAP_MAX_PAGES;
+            }
+
+            return remaining;
+        }
+
+        /// <!-- description -->
+        ///   @brief Revokes write access to each page described by the
+        ///     provided dirty log entry value. Pages that are not mapped
+        ///     are ignored as they will be write protected when they are
+        ///     mapped (see mmio_map).
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param tls the tls_t to use
+        ///   @param sys the bf_syscall_t to use
+        ///   @param gpa the GPA of the first page in the slot
+        ///   @param page the page described by bit 0 of the provided value
+        ///   @param val the dirty log entry value describing the pages
+        ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+        ///     and friends otherwise
+        ///
+        [[nodiscard]] constexpr auto
+        dirty_log_protect(
+            tls_t const &tls,
+            syscall::bf_syscall_t const &sys,
+            bsl::safe_u64 const &gpa,
+            bsl::safe_u64 const &page,
+            bsl::safe_u64 const &val) noexcept -> bsl::errc_type
+        {
+            for (bsl::safe_idx mut_i{}; mut_i < DIRTY_LOG_PAGES_PER_ENTRY; ++mut_i) {
+                auto const bit{bsl::to_u64(mut_i)};
+                if (((val >> bit) & bsl::safe_u64::magic_1()).is_pos()) {
+                    auto const pg{(page + bit).checked()};
+                    auto const page_gpa{(gpa + (pg << PAGE_4K_T_SHFT)).checked()};
+
+                    if (m_emulated_mmio.is_mapped(tls, sys, page_gpa)) {
+                        auto const ret{m_emulated_mmio.write_access(tls, sys, page_gpa, false)};
+                        if (bsl::unlikely(!ret)) {
+                            bsl::print<bsl::V>() << bsl::here();
+                            return ret;
+                        }
+
+                        bsl::touch();
+                    }
+                    else {
+                        bsl::touch();
+                    }
+                }
+                else {
+                    bsl::touch();
+                }
+            }
+
+            return bsl::errc_success;
+        }
+
+        /// <!-- description -->
+        ///   @brief Restores write access to the provided number of pages,
+        ///     starting with the provided GPA. Pages that are not mapped
+        ///     are ignored.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param tls the tls_t to use
+        ///   @param sys the bf_syscall_t to use
+        ///   @param gpa the GPA of the first page to modify
+        ///   @param num_pages the number of pages to modify
+        ///
+        constexpr void
+        dirty_log_unprotect(
+            tls_t const &tls,
+            syscall::bf_syscall_t const &sys,
+            bsl::safe_u64 const &gpa,
+            bsl::safe_u64 const &num_pages) noexcept
+        {
+            for (bsl::safe_idx mut_i{}; mut_i < num_pages; ++mut_i) {
+                auto const page_gpa{(gpa + (bsl::to_u64(mut_i) << PAGE_4K_T_SHFT)).checked()};
+                bsl::discard(m_emulated_mmio.write_access(tls, sys, page_gpa, true));
+            }
+        }
+
+        /// <!-- description -->
+        ///   @brief Clears the provided page from the dirty log of the
+        ///     provided slot and revokes write access to it. If the page is
+        ///     not dirty, or is not in a slot with dirty logging enabled,
+        ///     this function does nothing. mut_flush is set to true if the
+        ///     page was cleared.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param tls the tls_t to use
+        ///   @param sys the bf_syscall_t to use
+        ///   @param slot the slot the page belongs to
+        ///   @param page the index of the page in the slot
+        ///   @param mut_flush set to true if the TLB needs to be flushed
+        ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+        ///     and friends otherwise
+        ///
+        [[nodiscard]] constexpr auto
+        dirty_log_clear_page(
+            tls_t const &tls,
+            syscall::bf_syscall_t const &sys,
+            bsl::safe_u64 const &slot,
+            bsl::safe_u64 const &page,
+            bool &mut_flush) noexcept -> bsl::errc_type
+        {
+            auto const num_pages{m_dirty_log.num_pages(slot)};
+            if (bsl::unlikely(num_pages.is_invalid() || page >= num_pages)) {
+                bsl::print<bsl::V>() << bsl::here();
+                return bsl::errc_success;
+            }
+
+            auto const mask{1_u64 << (page % DIRTY_LOG_PAGES_PER_ENTRY).checked()};
+            auto *const pmut_entry{m_dirty_log.entry(slot, page)};
+
+            auto const dirty{bsl::safe_u64{*pmut_entry}};
+            if ((dirty & mask).is_zero()) {
+                return bsl::errc_success;
+            }
+
+            *pmut_entry = (dirty & ~mask).get();
+            mut_flush = true;
+
+            return this->dirty_log_protect(tls, sys, m_dirty_log.gpa(slot), page, 1_u64);
+        }
 
     public:
         /// <!-- description -->
@@ -162,6 +394,23 @@ namespace microv
             bsl::expects(this->id() != syscall::BF_INVALID_ID);
             bsl::expects(allocated_status_t::deallocated == m_allocated);
 
+            if (!mut_sys.is_vm_the_root_vm(this->id())) {
+                if (bsl::unlikely(!m_iopm.allocate(mut_sys))) {
+                    bsl::print<bsl::V>() << bsl::here();
+                    return bsl::safe_u16::failure();
+                }
+
+                if (bsl::unlikely(!m_msrpm.allocate(mut_sys))) {
+                    bsl::print<bsl::V>() << bsl::here();
+                    return bsl::safe_u16::failure();
+                }
+
+                bsl::touch();
+            }
+            else {
+                bsl::touch();
+            }
+
             auto const ret{m_emulated_mmio.allocate(gs, tls, mut_sys, mut_page_pool, intrinsic)};
             if (bsl::unlikely(!ret)) {
                 bsl::print<bsl::V>() << bsl::here();
@@ -204,14 +453,28 @@ namespace microv
         {
             bsl::expects(this->is_active(tls).is_invalid());
 
+            m_dirty_log.release(tls, mut_page_pool);
             m_emulated_mmio.deallocate(gs, tls, sys, mut_page_pool, intrinsic);
+
+            m_clock_offset = {};
+            m_clock_epoch = {};
+            m_clock_generation = {};
+
+            m_tlb_generation = {};
+            for (bsl::safe_idx mut_i{}; mut_i < m_tlb_synced.size(); ++mut_i) {
+                *m_tlb_synced.at_if(mut_i) = {};
+                *m_tlb_dirty.at_if(mut_i) = false;
+            }
+
             m_allocated = allocated_status_t::deallocated;
 
             if (!sys.is_vm_the_root_vm(this->id())) {
                 bsl::debug<bsl::V>()                                   // --
                     << "vm "                                           // --
                     << bsl::red << bsl::hex(this->id()) << bsl::rst    // --
-                    << " was destroyed"                                // --
+                    << " was destroyed ("                              // --
+                    << mut_page_pool.zeroed_misses()                   // --
+                    << " pre-zeroed page misses)"                      // --
                     << bsl::endl;                                      // --
             }
             else {
@@ -258,7 +521,7 @@ namespace microv
             bsl::expects(syscall::BF_INVALID_ID == mut_tls.active_vmid);
             bsl::expects(ppid < m_active.size());
 
-            *m_active.at_if(ppid) = true;
+            *m_active.at_if(ppid) = bsl::safe_u64::magic_1();
             mut_tls.active_vmid = this->id();
         }
 
@@ -277,7 +540,7 @@ namespace microv
             bsl::expects(this->id() == mut_tls.active_vmid);
             bsl::expects(ppid < m_active.size());
 
-            *m_active.at_if(ppid) = false;
+            *m_active.at_if(ppid) = {};
             mut_tls.active_vmid = syscall::BF_INVALID_ID;
         }
 
@@ -299,7 +562,7 @@ namespace microv
             bsl::expects(online_pps <= m_active.size());
 
             for (bsl::safe_idx mut_i{}; mut_i < online_pps; ++mut_i) {
-                if (*m_active.at_if(mut_i)) {
+                if (m_active.at_if(mut_i)->is_pos()) {
                     return bsl::to_u16(mut_i);
                 }
 
@@ -322,7 +585,240 @@ namespace microv
         is_active_on_this_pp(tls_t const &tls) const noexcept -> bool
         {
             bsl::expects(bsl::to_umx(tls.ppid) < m_active.size());
-            return *m_active.at_if(bsl::to_idx(tls.ppid));
+            return m_active.at_if(bsl::to_idx(tls.ppid))->is_pos();
+        }
+
+        /// <!-- description -->
+        ///   @brief Invalidates any second level TLB entries associated
+        ///     with this vm_t. This must be called any time a second level
+        ///     page table entry is removed or its permissions are reduced.
+        ///
+        ///   @note Only PPs that have run this vm_t since their last flush
+        ///     can have stale TLB entries. If the current PP is one of them,
+        ///     it is flushed right away. All other PPs are not interrupted.
+        ///     Instead, the flush generation is incremented, and each PP
+        ///     flushes itself (if needed) the next time it runs this vm_t
+        ///     (see tlb_flush_if_stale). PPs that are running this vm_t
+        ///     right now keep their stale entries until they stop, so if
+        ///     the removed memory can be reused, tlb_flush_wait must be
+        ///     called before it is.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param tls the tls_t to use
+        ///   @param mut_sys the bf_syscall_t to use
+        ///   @param intrinsic the intrinsic_t to use
+        ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+        ///     and friends otherwise
+        ///
+        [[nodiscard]] constexpr auto
+        tlb_flush(
+            tls_t const &tls,
+            syscall::bf_syscall_t &mut_sys,
+            intrinsic_t const &intrinsic) noexcept -> bsl::errc_type
+        {
+            bsl::expects(allocated_status_t::allocated == m_allocated);
+
+            bsl::discard(intrinsic.xadd_u64(m_tlb_generation.data(), bsl::safe_u64::magic_1()));
+            return this->tlb_flush_if_stale(tls, mut_sys, intrinsic);
+        }
+
+        /// <!-- description -->
+        ///   @brief Flushes the second level TLB entries of this vm_t on
+        ///     the current PP if the current PP has run this vm_t since its
+        ///     last flush and the flush generation has changed since then.
+        ///     This must be called after this vm_t is set as active on the
+        ///     current PP, and before it is run.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param tls the tls_t to use
+        ///   @param mut_sys the bf_syscall_t to use
+        ///   @param intrinsic the intrinsic_t to use
+        ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+        ///     and friends otherwise
+        ///
+        [[nodiscard]] constexpr auto
+        tlb_flush_if_stale(
+            tls_t const &tls,
+            syscall::bf_syscall_t &mut_sys,
+            intrinsic_t const &intrinsic) noexcept -> bsl::errc_type
+        {
+            auto const ppid{bsl::to_idx(tls.ppid)};
+
+            bsl::expects(allocated_status_t::allocated == m_allocated);
+            bsl::expects(ppid < m_tlb_synced.size());
+
+            /// NOTE:
+            /// - The generation is read using a locked instruction. This
+            ///   orders the read after the store that set this vm_t as
+            ///   active, so either this PP sees a new generation, or the
+            ///   PP that created it sees this PP as active and waits for
+            ///   it in tlb_flush_wait.
+            ///
+
+            auto const generation{intrinsic.xadd_u64(m_tlb_generation.data(), {})};
+
+            auto *const pmut_synced{m_tlb_synced.at_if(ppid)};
+            auto *const pmut_dirty{m_tlb_dirty.at_if(ppid)};
+
+            if (generation != *pmut_synced) {
+                if (*pmut_dirty) {
+                    auto const ret{mut_sys.bf_vm_op_tlb_flush(this->id())};
+                    if (bsl::unlikely(!ret)) {
+                        bsl::print<bsl::V>() << bsl::here();
+                        return ret;
+                    }
+
+                    *pmut_dirty = false;
+                }
+                else {
+                    bsl::touch();
+                }
+
+                *pmut_synced = generation;
+            }
+            else {
+                bsl::touch();
+            }
+
+            if (this->is_active_on_this_pp(tls)) {
+                *pmut_dirty = true;
+            }
+            else {
+                bsl::touch();
+            }
+
+            return bsl::errc_success;
+        }
+
+        /// <!-- description -->
+        ///   @brief Waits until no PP other than the current PP can still
+        ///     use a TLB entry that was invalidated by a previous call to
+        ///     tlb_flush. A PP that is running this vm_t with an old flush
+        ///     generation is waited on until it stops running this vm_t
+        ///     (i.e., the next time it returns to the root VM, which at the
+        ///     latest happens on its next host interrupt). The caller must
+        ///     not hold a lock that a PP running this vm_t might need.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param tls the tls_t to use
+        ///   @param intrinsic the intrinsic_t to use
+        ///
+        constexpr void
+        tlb_flush_wait(tls_t const &tls, intrinsic_t const &intrinsic) noexcept
+        {
+            auto const online_pps{bsl::to_umx(tls.online_pps)};
+
+            bsl::expects(allocated_status_t::allocated == m_allocated);
+            bsl::expects(online_pps <= m_active.size());
+
+            /// NOTE:
+            /// - The other PPs write m_active and m_tlb_synced while this
+            ///   loop spins, so both are read using xadd_u64 (like the
+            ///   generation). Plain loads could be hoisted out of the loop
+            ///   by the compiler, which would then spin forever.
+            ///
+
+            auto const generation{intrinsic.xadd_u64(m_tlb_generation.data(), {})};
+            for (bsl::safe_idx mut_i{}; mut_i < online_pps; ++mut_i) {
+                if (bsl::to_idx(tls.ppid) == mut_i) {
+                    bsl::touch();
+                }
+                else {
+                    auto *const pmut_active{m_active.at_if(mut_i)};
+                    auto *const pmut_synced{m_tlb_synced.at_if(mut_i)};
+
+                    while (intrinsic.xadd_u64(pmut_active->data(), {}).is_pos() &&
+                           intrinsic.xadd_u64(pmut_synced->data(), {}) < generation) {
+                        pause();
+                    }
+                }
+            }
+        }
+
+        /// <!-- description -->
+        ///   @brief Returns the value of this vm_t's kvmclock (in ns) given
+        ///     the current value of the host clock (in ns).
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param host_ns the current value of the host clock in ns
+        ///   @return Returns the value of this vm_t's kvmclock (in ns)
+        ///
+        [[nodiscard]] constexpr auto
+        clock_get(bsl::safe_u64 const &host_ns) const noexcept -> bsl::safe_u64
+        {
+            bsl::expects(allocated_status_t::allocated == m_allocated);
+
+            /// NOTE:
+            /// - The offset is stored in two's complement form as the
+            ///   kvmclock can be set to a value that is behind the host
+            ///   clock, so this addition is expected to wrap.
+            ///
+
+            return bsl::safe_u64{host_ns.get() + m_clock_offset.get()};
+        }
+
+        /// <!-- description -->
+        ///   @brief Sets this vm_t's kvmclock so that it reads the
+        ///     provided value (in ns) at the provided host clock value
+        ///     (in ns). The wall clock time at which the kvmclock was 0 is
+        ///     also recorded so that it can be reported to the guest using
+        ///     MSR_KVM_WALL_CLOCK_NEW. Each time the clock is set, the
+        ///     clock generation is incremented, which tells each VS that
+        ///     its pvclock structure is out of date.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param host_ns the current value of the host clock in ns
+        ///   @param clock the value this vm_t's kvmclock should read in ns
+        ///   @param realtime the current wall clock time in ns since the
+        ///     epoch, or 0 if unknown.
+        ///
+        constexpr void
+        clock_set(
+            bsl::safe_u64 const &host_ns,
+            bsl::safe_u64 const &clock,
+            bsl::safe_u64 const &realtime) noexcept
+        {
+            bsl::expects(allocated_status_t::allocated == m_allocated);
+
+            m_clock_offset = bsl::safe_u64{clock.get() - host_ns.get()};
+
+            if (realtime > clock) {
+                m_clock_epoch = (realtime - clock).checked();
+            }
+            else {
+                m_clock_epoch = {};
+            }
+
+            ++m_clock_generation;
+        }
+
+        /// <!-- description -->
+        ///   @brief Returns the wall clock time (in ns since the epoch) at
+        ///     which this vm_t's kvmclock read 0.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @return Returns the wall clock time (in ns since the epoch) at
+        ///     which this vm_t's kvmclock read 0.
+        ///
+        [[nodiscard]] constexpr auto
+        clock_epoch() const noexcept -> bsl::safe_u64
+        {
+            bsl::ensures(m_clock_epoch.is_valid_and_checked());
+            return m_clock_epoch;
+        }
+
+        /// <!-- description -->
+        ///   @brief Returns the generation of this vm_t's kvmclock, which
+        ///     is incremented each time the clock is set.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @return Returns the generation of this vm_t's kvmclock
+        ///
+        [[nodiscard]] constexpr auto
+        clock_generation() const noexcept -> bsl::safe_u64
+        {
+            bsl::ensures(m_clock_generation.is_valid_and_checked());
+            return m_clock_generation;
         }
 
         /// <!-- description -->
@@ -339,9 +835,141 @@ namespace microv
             return m_emulated_mmio.slpt_spa();
         }
 
+        /// <!-- description -->
+        ///   @brief Returns the system physical address of the IO
+        ///     permissions map used by this vm_t. The root VM uses the IO
+        ///     permissions map in the gs_t instead, in which case 0 is
+        ///     returned.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @return Returns the system physical address of the IO
+        ///     permissions map used by this vm_t.
+        ///
+        [[nodiscard]] constexpr auto
+        iopm_spa() const noexcept -> bsl::safe_u64
+        {
+            return m_iopm.spa();
+        }
+
+        /// <!-- description -->
+        ///   @brief Sets the IO intercept type of every port from first to
+        ///     last (inclusive) for every VS assigned to this vm_t (see
+        ///     iopm_t::intercept).
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param first the first port to modify
+        ///   @param last the last port to modify
+        ///   @param type the IO intercept type to use
+        ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+        ///     and friends otherwise
+        ///
+        [[nodiscard]] constexpr auto
+        io_intercept(
+            bsl::safe_u64 const &first,
+            bsl::safe_u64 const &last,
+            bsl::safe_u64 const &type) noexcept -> bsl::errc_type
+        {
+            return m_iopm.intercept(first, last, type);
+        }
+
+        /// <!-- description -->
+        ///   @brief Returns true if an access of the provided number of
+        ///     bytes to the provided port is ignored by this vm_t. Returns
+        ///     false otherwise.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param port the port that was accessed
+        ///   @param bytes the number of bytes that were accessed
+        ///   @return Returns true if the access is ignored by this vm_t.
+        ///     Returns false otherwise.
+        ///
+        [[nodiscard]] constexpr auto
+        is_io_ignored(bsl::safe_u64 const &port, bsl::safe_u64 const &bytes) const noexcept
+            -> bool
+        {
+            return m_iopm.is_ignored(port, bytes);
+        }
+
+        /// <!-- description -->
+        ///   @brief Returns the system physical address of the MSR
+        ///     permissions map used by this vm_t. The root VM uses the
+        ///     MSR permissions map in the gs_t instead, in which case 0 is
+        ///     returned.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @return Returns the system physical address of the MSR
+        ///     permissions map used by this vm_t.
+        ///
+        [[nodiscard]] constexpr auto
+        msrpm_spa() const noexcept -> bsl::safe_u64
+        {
+            return m_msrpm.spa();
+        }
+
+        /// <!-- description -->
+        ///   @brief Intercepts the provided accesses to the provided MSR
+        ///     for every VS assigned to this vm_t and passes through the
+        ///     rest (see msrpm_t::intercept).
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param msr the MSR to modify
+        ///   @param perms the accesses to intercept
+        ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+        ///     and friends otherwise
+        ///
+        [[nodiscard]] constexpr auto
+        msr_intercept(bsl::safe_u32 const &msr, bsl::safe_u64 const &perms) noexcept
+            -> bsl::errc_type
+        {
+            return m_msrpm.intercept(msr, perms);
+        }
+
+        /// <!-- description -->
+        ///   @brief Filters the provided accesses to every MSR from first
+        ///     to last (inclusive) to software for every VS assigned to
+        ///     this vm_t (see msrpm_t::filter).
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param first the first MSR to modify
+        ///   @param last the last MSR to modify
+        ///   @param perms the accesses to filter
+        ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+        ///     and friends otherwise
+        ///
+        [[nodiscard]] constexpr auto
+        msr_filter(
+            bsl::safe_u32 const &first,
+            bsl::safe_u32 const &last,
+            bsl::safe_u64 const &perms) noexcept -> bsl::errc_type
+        {
+            return m_msrpm.filter(first, last, perms);
+        }
+
+        /// <!-- description -->
+        ///   @brief Returns true if the provided access to the provided MSR
+        ///     is filtered to software by this vm_t. Returns false
+        ///     otherwise.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param msr the MSR that was accessed
+        ///   @param perm the access (MV_PERM_READ or MV_PERM_WRITE)
+        ///   @return Returns true if the access is filtered to software by
+        ///     this vm_t. Returns false otherwise.
+        ///
+        [[nodiscard]] constexpr auto
+        is_msr_filtered(bsl::safe_u32 const &msr, bsl::safe_u64 const &perm) const noexcept
+            -> bool
+        {
+            return m_msrpm.is_filtered(msr, perm);
+        }
+
         /// <!-- description -->
         ///   @brief Maps memory into this vm_t using instructions from the
-        ///     provided MDL.
+        ///     provided MDL. Pages that are mapped into a slot that is being
+        ///     dirty logged and that are not already dirty are mapped
+        ///     without write access so that the first write to them is
+        ///     logged (see dirty_log_write_fault). They are never writable,
+        ///     even briefly, so no TLB flush is needed.
         ///
         /// <!-- inputs/outputs -->
         ///   @param tls the tls_t to use
@@ -358,7 +986,8 @@ namespace microv
             page_pool_t &mut_page_pool,
             hypercall::mv_mdl_t const &mdl) noexcept -> bsl::errc_type
         {
-            return m_emulated_mmio.map(tls, mut_sys, mut_page_pool, mdl);
+            lock_guard_t mut_lock{tls, m_dirty_log_lock};
+            return m_emulated_mmio.map(tls, mut_sys, mut_page_pool, m_dirty_log, mdl);
         }
 
         /// <!-- description -->
@@ -369,6 +998,7 @@ namespace microv
         ///   @param tls the tls_t to use
         ///   @param mut_sys the bf_syscall_t to use
         ///   @param mut_page_pool the page_pool_t to use
+        ///   @param intrinsic the intrinsic_t to use
         ///   @param mdl the MDL containing the memory to map from the vm_t
         ///   @return Returns bsl::errc_success on success, bsl::errc_failure
         ///     and friends otherwise
@@ -378,9 +1008,394 @@ namespace microv
             tls_t const &tls,
             syscall::bf_syscall_t &mut_sys,
             page_pool_t &mut_page_pool,
+            intrinsic_t const &intrinsic,
+            hypercall::mv_mdl_t const &mdl) noexcept -> bsl::errc_type
+        {
+            auto const ret{m_emulated_mmio.unmap(tls, mut_sys, mut_page_pool, mdl)};
+
+            /// NOTE:
+            /// - Even if the unmap failed, some of the entries in the MDL
+            ///   might have been removed, so the flush is always performed.
+            ///
+
+            auto const flush_ret{this->tlb_flush(tls, mut_sys, intrinsic)};
+            if (bsl::unlikely(!flush_ret)) {
+                bsl::print<bsl::V>() << bsl::here();
+                return flush_ret;
+            }
+
+            /// NOTE:
+            /// - Once this returns, the root VM is free to reuse the memory
+            ///   that was unmapped, so no PP can be left running this vm_t
+            ///   with a TLB entry that still points to it.
+            ///
+
+            this->tlb_flush_wait(tls, intrinsic);
+            return ret;
+        }
+
+        /// <!-- description -->
+        ///   @brief Shares the memory that the provided parent vm_t has
+        ///     mapped into the ranges described by the provided MDL with
+        ///     this vm_t, copy-on-write (see emulated_mmio_t::share). The
+        ///     parent must not run or modify its mappings while this is
+        ///     in progress. This vm_t also inherits the parent's kvmclock
+        ///     so that time does not go backwards in the fork.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param tls the tls_t to use
+        ///   @param mut_sys the bf_syscall_t to use
+        ///   @param mut_page_pool the page_pool_t to use
+        ///   @param parent the vm_t to share memory with
+        ///   @param mdl the MDL describing the GPA ranges to share
+        ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+        ///     and friends otherwise
+        ///
+        [[nodiscard]] constexpr auto
+        fork(
+            tls_t const &tls,
+            syscall::bf_syscall_t &mut_sys,
+            page_pool_t &mut_page_pool,
+            vm_t const &parent,
             hypercall::mv_mdl_t const &mdl) noexcept -> bsl::errc_type
         {
-            return m_emulated_mmio.unmap(tls, mut_sys, mut_page_pool, mdl);
+            bsl::expects(allocated_status_t::allocated == m_allocated);
+            bsl::expects(allocated_status_t::allocated == parent.m_allocated);
+            lock_guard_t mut_lock{tls, m_dirty_log_lock};
+
+            m_clock_offset = parent.m_clock_offset;
+            m_clock_epoch = parent.m_clock_epoch;
+
+            return m_emulated_mmio.share(tls, mut_sys, mut_page_pool, parent.m_emulated_mmio, mdl);
+        }
+
+        /// <!-- description -->
+        ///   @brief Enables dirty logging on the provided slot. The MDL must
+        ///     contain a single entry whose dst field is the GPA of the slot
+        ///     and whose bytes field is the size of the slot. Every page in
+        ///     the slot that is mapped is write protected so that the first
+        ///     write to each page can be logged (see dirty_log_write_fault).
+        ///     Pages that are not mapped yet are write protected when they
+        ///     are mapped (see mmio_map).
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param tls the tls_t to use
+        ///   @param mut_sys the bf_syscall_t to use
+        ///   @param mut_page_pool the page_pool_t to use
+        ///   @param intrinsic the intrinsic_t to use
+        ///   @param mdl the MDL describing the memory to dirty log
+        ///   @param slot the slot to enable dirty logging on
+        ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+        ///     and friends otherwise
+        ///
+        [[nodiscard]] constexpr auto
+        dirty_log_enable(
+            tls_t const &tls,
+            syscall::bf_syscall_t &mut_sys,
+            page_pool_t &mut_page_pool,
+            intrinsic_t const &intrinsic,
+            hypercall::mv_mdl_t const &mdl,
+            bsl::safe_u64 const &slot) noexcept -> bsl::errc_type
+        {
+            bsl::expects(allocated_status_t::allocated == m_allocated);
+            lock_guard_t mut_lock{tls, m_dirty_log_lock};
+
+            if (bsl::unlikely(bsl::safe_u64::magic_1() != mdl.num_entries)) {
+                bsl::error() << "the mdl must contain a single entry "    // --
+                             << bsl::endl                                 // --
+                             << bsl::here();                              // --
+
+                return bsl::errc_failure;
+            }
+
+            auto const *const entry{mdl.entries.front_if()};
+            auto const gpa{bsl::to_u64(entry->dst)};
+            auto const num_pages{(bsl::to_u64(entry->bytes) >> PAGE_4K_T_SHFT).checked()};
+
+            auto const ret{m_dirty_log.enable(tls, mut_sys, mut_page_pool, slot, gpa, num_pages)};
+            if (bsl::unlikely(!ret)) {
+                bsl::print<bsl::V>() << bsl::here();
+                return ret;
+            }
+
+            for (bsl::safe_idx mut_i{}; mut_i < num_pages; ++mut_i) {
+                auto const page_gpa{(gpa + (bsl::to_u64(mut_i) << PAGE_4K_T_SHFT)).checked()};
+                if (!m_emulated_mmio.is_mapped(tls, mut_sys, page_gpa)) {
+                    bsl::touch();
+                }
+                else {
+                    auto const wa_ret{m_emulated_mmio.write_access(tls, mut_sys, page_gpa, false)};
+                    if (bsl::unlikely(!wa_ret)) {
+                        bsl::print<bsl::V>() << bsl::here();
+                        this->dirty_log_unprotect(tls, mut_sys, gpa, bsl::to_u64(mut_i));
+                        m_dirty_log.disable(tls, mut_page_pool, slot);
+                        return wa_ret;
+                    }
+
+                    bsl::touch();
+                }
+            }
+
+            return this->tlb_flush(tls, mut_sys, intrinsic);
+        }
+
+        /// <!-- description -->
+        ///   @brief Disables dirty logging on the provided slot, restoring
+        ///     write access to every page in the slot.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param tls the tls_t to use
+        ///   @param sys the bf_syscall_t to use
+        ///   @param mut_page_pool the page_pool_t to use
+        ///   @param slot the slot to disable dirty logging on
+        ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+        ///     and friends otherwise
+        ///
+        [[nodiscard]] constexpr auto
+        dirty_log_disable(
+            tls_t const &tls,
+            syscall::bf_syscall_t const &sys,
+            page_pool_t &mut_page_pool,
+            bsl::safe_u64 const &slot) noexcept -> bsl::errc_type
+        {
+            bsl::expects(allocated_status_t::allocated == m_allocated);
+            lock_guard_t mut_lock{tls, m_dirty_log_lock};
+
+            auto const gpa{m_dirty_log.gpa(slot)};
+            if (bsl::unlikely(gpa.is_invalid())) {
+                bsl::print<bsl::V>() << bsl::here();
+                return bsl::errc_failure;
+            }
+
+            this->dirty_log_unprotect(tls, sys, gpa, m_dirty_log.num_pages(slot));
+            m_dirty_log.disable(tls, mut_page_pool, slot);
+
+            return bsl::errc_success;
+        }
+
+        /// <!-- description -->
+        ///   @brief Copies the dirty log of the provided slot, starting with
+        ///     first_page, into the provided dirty bitmap. The dirty log is
+        ///     not modified.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param tls the tls_t to use
+        ///   @param slot the slot to query
+        ///   @param first_page the first page in the slot to copy
+        ///   @param mut_bitmap where to copy the dirty log to
+        ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+        ///     and friends otherwise
+        ///
+        [[nodiscard]] constexpr auto
+        dirty_log_get(
+            tls_t const &tls,
+            bsl::safe_u64 const &slot,
+            bsl::safe_u64 const &first_page,
+            hypercall::mv_dirty_bitmap_t &mut_bitmap) noexcept -> bsl::errc_type
+        {
+            bsl::expects(allocated_status_t::allocated == m_allocated);
+            lock_guard_t mut_lock{tls, m_dirty_log_lock};
+
+            auto const num_pages{this->dirty_log_range(slot, first_page)};
+            if (bsl::unlikely(num_pages.is_invalid())) {
+                bsl::print<bsl::V>() << bsl::here();
+                return bsl::errc_failure;
+            }
+
+            for (auto &mut_elem : mut_bitmap.entries) {
+                mut_elem = {};
+            }
+
+            auto const num_entries{to_dirty_log_entries(num_pages)};
+            for (bsl::safe_idx mut_i{}; mut_i < num_entries; ++mut_i) {
+                auto const page{to_dirty_log_page(first_page, mut_i)};
+                *mut_bitmap.entries.at_if(mut_i) = *m_dirty_log.entry(slot, page);
+            }
+
+            return bsl::errc_success;
+        }
+
+        /// <!-- description -->
+        ///   @brief Clears the pages described by the provided dirty bitmap,
+        ///     starting with first_page, from the dirty log of the provided
+        ///     slot. Only the pages that were actually dirty are write
+        ///     protected again, and the TLB is flushed at most once.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param tls the tls_t to use
+        ///   @param mut_sys the bf_syscall_t to use
+        ///   @param intrinsic the intrinsic_t to use
+        ///   @param slot the slot to modify
+        ///   @param first_page the first page in the slot to clear
+        ///   @param bitmap the pages to clear
+        ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+        ///     and friends otherwise
+        ///
+        [[nodiscard]] constexpr auto
+        dirty_log_clear(
+            tls_t const &tls,
+            syscall::bf_syscall_t &mut_sys,
+            intrinsic_t const &intrinsic,
+            bsl::safe_u64 const &slot,
+            bsl::safe_u64 const &first_page,
+            hypercall::mv_dirty_bitmap_t const &bitmap) noexcept -> bsl::errc_type
+        {
+            bsl::expects(allocated_status_t::allocated == m_allocated);
+            lock_guard_t mut_lock{tls, m_dirty_log_lock};
+
+            auto const num_pages{this->dirty_log_range(slot, first_page)};
+            if (bsl::unlikely(num_pages.is_invalid())) {
+                bsl::print<bsl::V>() << bsl::here();
+                return bsl::errc_failure;
+            }
+
+            auto const gpa{m_dirty_log.gpa(slot)};
+            bool mut_flush{};
+
+            auto const num_entries{to_dirty_log_entries(num_pages)};
+            for (bsl::safe_idx mut_i{}; mut_i < num_entries; ++mut_i) {
+                auto const page{to_dirty_log_page(first_page, mut_i)};
+                auto *const pmut_entry{m_dirty_log.entry(slot, page)};
+
+                auto const dirty{bsl::safe_u64{*pmut_entry}};
+                auto const cleared{(dirty & bsl::safe_u64{*bitmap.entries.at_if(mut_i)}).checked()};
+                if (cleared.is_pos()) {
+                    *pmut_entry = (dirty & ~cleared).get();
+                    mut_flush = true;
+
+                    auto const ret{this->dirty_log_protect(tls, mut_sys, gpa, page, cleared)};
+                    if (bsl::unlikely(!ret)) {
+                        bsl::print<bsl::V>() << bsl::here();
+                        bsl::discard(this->tlb_flush(tls, mut_sys, intrinsic));
+                        return ret;
+                    }
+
+                    bsl::touch();
+                }
+                else {
+                    bsl::touch();
+                }
+            }
+
+            if (!mut_flush) {
+                return bsl::errc_success;
+            }
+
+            return this->tlb_flush(tls, mut_sys, intrinsic);
+        }
+
+        /// <!-- description -->
+        ///   @brief Clears the pages described by the provided dirty ring
+        ///     from the dirty log. Only the pages that were actually dirty
+        ///     are write protected again, and the TLB is flushed at most
+        ///     once. Entries that do not refer to a page in a slot with
+        ///     dirty logging enabled are ignored.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param tls the tls_t to use
+        ///   @param mut_sys the bf_syscall_t to use
+        ///   @param intrinsic the intrinsic_t to use
+        ///   @param ring the pages to clear
+        ///   @return Returns bsl::errc_success on success, bsl::errc_failure
+        ///     and friends otherwise
+        ///
+        [[nodiscard]] constexpr auto
+        dirty_ring_reset(
+            tls_t const &tls,
+            syscall::bf_syscall_t &mut_sys,
+            intrinsic_t const &intrinsic,
+            hypercall::mv_dirty_ring_t const &ring) noexcept -> bsl::errc_type
+        {
+            bsl::expects(allocated_status_t::allocated == m_allocated);
+            bsl::expects(ring.num_entries <= ring.entries.size());
+
+            lock_guard_t mut_lock{tls, m_dirty_log_lock};
+            bool mut_flush{};
+
+            for (bsl::safe_idx mut_i{}; mut_i < ring.num_entries; ++mut_i) {
+                auto const *const gfn{ring.entries.at_if(mut_i)};
+                auto const slot{bsl::to_u64(gfn->slot)};
+                auto const page{bsl::to_u64(gfn->offset)};
+
+                auto const ret{this->dirty_log_clear_page(tls, mut_sys, slot, page, mut_flush)};
+                if (bsl::unlikely(!ret)) {
+                    bsl::print<bsl::V>() << bsl::here();
+                    bsl::discard(this->tlb_flush(tls, mut_sys, intrinsic));
+                    return ret;
+                }
+
+                bsl::touch();
+            }
+
+            if (!mut_flush) {
+                return bsl::errc_success;
+            }
+
+            return this->tlb_flush(tls, mut_sys, intrinsic);
+        }
+
+        /// <!-- description -->
+        ///   @brief Handles a write to a page that was write protected by
+        ///     the dirty log. If the provided GPA is in a slot that has
+        ///     dirty logging enabled, its page is marked as dirty and write
+        ///     access is restored so that future writes to the page do not
+        ///     generate a VMExit until the page is cleared. If the page was
+        ///     not already dirty, the provided dirty gfn is filled in so
+        ///     that it can be added to the dirty ring of the faulting VS.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param tls the tls_t to use
+        ///   @param sys the bf_syscall_t to use
+        ///   @param gpa the GPA that was written to
+        ///   @param mut_gfn where to return the dirty gfn of the page
+        ///   @return Returns true if the write was the result of dirty
+        ///     logging and was handled, false otherwise.
+        ///
+        [[nodiscard]] constexpr auto
+        dirty_log_write_fault(
+            tls_t const &tls,
+            syscall::bf_syscall_t const &sys,
+            bsl::safe_u64 const &gpa,
+            hypercall::mv_dirty_gfn_t &mut_gfn) noexcept -> bool
+        {
+            bsl::expects(allocated_status_t::allocated == m_allocated);
+            lock_guard_t mut_lock{tls, m_dirty_log_lock};
+
+            /// NOTE:
+            /// - Faults on pages that are not mapped yet are not the result
+            ///   of dirty logging. These are handed to the root VM so that
+            ///   the page can be mapped, at which point it will be write
+            ///   protected if needed (see mmio_map).
+            ///
+
+            if (!m_emulated_mmio.is_mapped(tls, sys, gpa)) {
+                return false;
+            }
+
+            /// NOTE:
+            /// - Pages that are shared copy-on-write are not marked here
+            ///   as write access cannot be restored until the root VM has
+            ///   given this VM its own copy of the page. The copy is mapped
+            ///   write protected if the page is clean (see mmio_map), so
+            ///   the write is logged when the guest retries it.
+            ///
+
+            if (m_emulated_mmio.is_cow(tls, sys, gpa)) {
+                return false;
+            }
+
+            if (!m_dirty_log.mark(gpa, mut_gfn)) {
+                return false;
+            }
+
+            auto const page_gpa{(gpa & ~(PAGE_4K_T_SIZE - bsl::safe_u64::magic_1())).checked()};
+            auto const ret{m_emulated_mmio.write_access(tls, sys, page_gpa, true)};
+            if (bsl::unlikely(!ret)) {
+                bsl::print<bsl::V>() << bsl::here();
+                return false;
+            }
+
+            return true;
         }
 
         /// <!-- description -->
@@ -402,6 +1417,45 @@ namespace microv
             bsl::expects(allocated_status_t::allocated == m_allocated);
             return m_emulated_mmio.gpa_to_spa(sys, gpa);
         }
+
+        /// <!-- description -->
+        ///   @brief Returns the system physical address that the provided
+        ///     GPA is mapped to in this vm_t. Unlike gpa_to_spa, this
+        ///     performs the translation using the second level page tables
+        ///     of this vm_t, so it can be used with guest VMs. This is used
+        ///     by MicroV to write to guest memory on behalf of the guest, so
+        ///     pages that are shared copy-on-write with another VM are
+        ///     rejected, as writing to them would modify the other VM too.
+        ///
+        /// <!-- inputs/outputs -->
+        ///   @param tls the tls_t to use
+        ///   @param sys the bf_syscall_t to use
+        ///   @param gpa the GPA to translate to a SPA
+        ///   @return Returns the system physical address that the provided
+        ///     GPA is mapped to on success. Returns bsl::safe_u64::failure()
+        ///     if the GPA is not mapped, or is shared copy-on-write.
+        ///
+        [[nodiscard]] constexpr auto
+        mapped_spa(
+            tls_t const &tls,
+            syscall::bf_syscall_t const &sys,
+            bsl::safe_u64 const &gpa) const noexcept -> bsl::safe_u64
+        {
+            bsl::expects(allocated_status_t::allocated == m_allocated);
+
+            if (bsl::unlikely(m_emulated_mmio.is_cow(tls, sys, gpa))) {
+                bsl::error() << "gpa "                                   // --
+                             << bsl::hex(gpa)                            // --
+                             << " is shared copy-on-write and cannot"    // --
+                             << " be written by MicroV"                  // --
+                             << bsl::endl                                // --
+                             << bsl::here();                             // --
+
+                return bsl::safe_u64::failure();
+            }
+
+            return m_emulated_mmio.mapped_spa(tls, sys, gpa);
+        }
     };
 }
 